@@ -321,6 +321,7 @@ public:
     // OpenGL / OpenCL Function calls:
     virtual bool gaGetAmountOfCurrentFrameFunctionCalls(const apContextID& contextID, int& amountOfFunctionCalls);
     virtual bool gaGetCurrentFrameFunctionCall(const apContextID& contextID, int callIndex, gtAutoPtr<apFunctionCall>& aptrFunctionCall);
+    virtual bool gaGetCurrentFrameFunctionCalls(const apContextID& contextID, int firstCallIndex, int callsAmount, gtPtrVector<apFunctionCall*>& functionCalls);
     virtual bool gaGetLastFunctionCall(const apContextID& contextID, gtAutoPtr<apFunctionCall>& aptrFunctionCall);
     virtual bool gaFindCurrentFrameFunctionCall(const apContextID& contextID, apSearchDirection searchDirection, int searchStartIndex, const gtString& searchedString, bool isCaseSensitiveSearch, int& foundIndex);
     virtual bool gaClearFunctionCallsStatistics();
@@ -569,6 +570,7 @@ protected:
     // Helper functions should be accessible to subclasses:
     int ProcessDebuggerThreadIndexToUserThreadIndex(int pdThreadIndex);
     int UserThreadIndexToProcessDebuggerThreadIndex(int userThreadIndex);
+    bool fetchFunctionCallsPage(const apContextID& contextID, int pageIndex);
 
 private:
     static void deleteInstance();
@@ -754,6 +756,7 @@ GA_API bool gaGetDisplayListObjectDetails(int contextID, GLuint displayListName,
 // OpenGL / OpenCL Function calls:
 GA_API bool gaGetAmountOfCurrentFrameFunctionCalls(const apContextID& contextID, int& amountOfFunctionCalls);
 GA_API bool gaGetCurrentFrameFunctionCall(const apContextID& contextID, int callIndex, gtAutoPtr<apFunctionCall>& aptrFunctionCall);
+GA_API bool gaGetCurrentFrameFunctionCalls(const apContextID& contextID, int firstCallIndex, int callsAmount, gtPtrVector<apFunctionCall*>& functionCalls);
 GA_API bool gaGetLastFunctionCall(const apContextID& contextID, gtAutoPtr<apFunctionCall>& aptrFunctionCall);
 GA_API bool gaFindCurrentFrameFunctionCall(const apContextID& contextID, apSearchDirection searchDirection, int searchStartIndex, const gtString& searchedString, bool isCaseSensitiveSearch, int& foundIndex);
 GA_API bool gaClearFunctionCallsStatistics();
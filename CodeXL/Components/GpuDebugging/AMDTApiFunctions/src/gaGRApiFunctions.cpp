@@ -6646,6 +6646,8 @@ bool gaGRApiFunctions::gaGetAmountOfCurrentFrameFunctionCalls(const apContextID&
 // Description:
 //   Returns the details of a function call, made in a given context at its
 //   current rendering frame.
+//   The calls are fetched from the spy in pages of GA_FUNCTION_CALLS_CACHE_PAGE_SIZE
+//   contiguous calls, and cached until the debugged process is resumed.
 //
 // Arguments:   contextId - The id of the context that this function queries.
 //              callIndex - The call index (in this context current frame).
@@ -6660,53 +6662,150 @@ bool gaGRApiFunctions::gaGetCurrentFrameFunctionCall(const apContextID& contextI
     bool rc = false;
 
     // Arguments check:
-    if (contextID.isValid())
+    if (contextID.isValid() && (0 <= callIndex))
     {
         gaPersistentDataManager& thePersistentDataMgr = gaPersistentDataManager::instance();
 
+        // Fetch the page that holds the call, if it was not fetched since the last break:
+        int pageIndex = callIndex / GA_FUNCTION_CALLS_CACHE_PAGE_SIZE;
+
+        if (!thePersistentDataMgr.isFunctionCallsPageCached(contextID, pageIndex))
+        {
+            fetchFunctionCallsPage(contextID, pageIndex);
+        }
+
         rc = thePersistentDataMgr.getCachedFunctionCall(contextID, callIndex, aptrFunctionCall);
+    }
+
+    return rc;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gaGRApiFunctions::gaGetCurrentFrameFunctionCalls
+// Description:
+//   Returns the details of a contiguous range of function calls, made in a
+//   given context at its current rendering frame.
+//   The pages that hold the range, and were not fetched since the last break,
+//   are fetched from the spy (a single reply per page), so views can call this
+//   function to prefetch the calls they are about to display.
+//
+// Arguments:   contextId - The id of the context that this function queries.
+//              firstCallIndex - The index of the first returned call.
+//              callsAmount - The maximal amount of returned calls. Less calls are
+//                            returned when the range exceeds the logged calls.
+//              functionCalls - Will get the function calls.
+//
+// Return Val:  bool - Success / failure.
+// ---------------------------------------------------------------------------
+bool gaGRApiFunctions::gaGetCurrentFrameFunctionCalls(const apContextID& contextID, int firstCallIndex, int callsAmount, gtPtrVector<apFunctionCall*>& functionCalls)
+{
+    bool rc = false;
 
-        if (!rc)
+    // Arguments check:
+    if (contextID.isValid() && (0 <= firstCallIndex) && (0 < callsAmount))
+    {
+        gaPersistentDataManager& thePersistentDataMgr = gaPersistentDataManager::instance();
+
+        // Fetch the pages that hold the range:
+        int endCallIndex = firstCallIndex + callsAmount;
+        int firstPageIndex = firstCallIndex / GA_FUNCTION_CALLS_CACHE_PAGE_SIZE;
+        int lastPageIndex = (endCallIndex - 1) / GA_FUNCTION_CALLS_CACHE_PAGE_SIZE;
+
+        for (int pageIndex = firstPageIndex; pageIndex <= lastPageIndex; pageIndex++)
+        {
+            if (!thePersistentDataMgr.isFunctionCallsPageCached(contextID, pageIndex))
+            {
+                fetchFunctionCallsPage(contextID, pageIndex);
+            }
+        }
+
+        // Return the cached calls, up to the end of the log:
+        for (int i = firstCallIndex; i < endCallIndex; i++)
         {
-            // Get the right function ID according to context type, and connected APIs:
-            apAPIConnectionType apiConnectionType;
-            apAPIFunctionId functionId = gaFindMultipleAPIsFunctionID(GA_FID_gaGetCurrentFrameFunctionCall, contextID._contextType, apiConnectionType);
+            gtAutoPtr<apFunctionCall> aptrFunctionCall;
 
-            if (gaIsAPIConnectionActiveAndDebuggedProcessSuspended(apiConnectionType))
+            if (!thePersistentDataMgr.getCachedFunctionCall(contextID, i, aptrFunctionCall))
             {
-                // Get the Spy connecting socket:
-                osSocket& spyConnectionSocket = gaSpiesAPISocket();
+                break;
+            }
 
-                // Send the function Id:
-                spyConnectionSocket << (gtInt32) functionId;
+            functionCalls.push_back(aptrFunctionCall.releasePointedObjectOwnership());
+        }
 
-                // Send the context id:
-                spyConnectionSocket << (gtInt32)contextID._contextId;
+        rc = !functionCalls.empty();
+    }
+
+    return rc;
+}
 
-                // Send the call index:
-                spyConnectionSocket << (gtInt32)callIndex;
+// ---------------------------------------------------------------------------
+// Name:        gaGRApiFunctions::fetchFunctionCallsPage
+// Description:
+//   Fetches a page of GA_FUNCTION_CALLS_CACHE_PAGE_SIZE contiguous function calls
+//   from the spy, in a single reply, and caches it in the persistent data manager.
+//   A page that could not be fetched is cached as an empty page, so that it is
+//   not requested again until the next break.
+//   The OpenGL and OpenCL spies serve GA_FID_gaGetCurrentFrameFunctionCall and
+//   GA_FID_gaGetOpenCLFunctionCall requests for a range of calls.
+//
+// Arguments:   contextId - The id of the context that this function queries.
+//              pageIndex - The page index.
+//
+// Return Val:  bool - Success / failure.
+// ---------------------------------------------------------------------------
+bool gaGRApiFunctions::fetchFunctionCallsPage(const apContextID& contextID, int pageIndex)
+{
+    bool rc = false;
 
-                // Perform after API call actions:
-                pdProcessDebugger::instance().afterAPICallIssued();
+    gtPtrVector<apFunctionCall*> pageFunctionCalls;
 
-                // Receive success value:
-                spyConnectionSocket >> rc;
+    // Get the right function ID according to context type, and connected APIs:
+    apAPIConnectionType apiConnectionType;
+    apAPIFunctionId functionId = gaFindMultipleAPIsFunctionID(GA_FID_gaGetCurrentFrameFunctionCall, contextID._contextType, apiConnectionType);
+
+    if (gaIsAPIConnectionActiveAndDebuggedProcessSuspended(apiConnectionType))
+    {
+        // Get the Spy connecting socket:
+        osSocket& spyConnectionSocket = gaSpiesAPISocket();
+
+        // Send the function Id:
+        spyConnectionSocket << (gtInt32) functionId;
+
+        // Send the context id:
+        spyConnectionSocket << (gtInt32)contextID._contextId;
+
+        // Send the calls range:
+        spyConnectionSocket << (gtInt32)(pageIndex * GA_FUNCTION_CALLS_CACHE_PAGE_SIZE);
+        spyConnectionSocket << (gtInt32)GA_FUNCTION_CALLS_CACHE_PAGE_SIZE;
+
+        // Perform after API call actions:
+        pdProcessDebugger::instance().afterAPICallIssued();
+
+        // Receive success value:
+        spyConnectionSocket >> rc;
+
+        if (rc)
+        {
+            // Read the function calls details from the channel:
+            gtInt32 returnedCallsAmount = 0;
+            spyConnectionSocket >> returnedCallsAmount;
+
+            for (gtInt32 i = 0; rc && (i < returnedCallsAmount); i++)
+            {
+                gtAutoPtr<apFunctionCall> aptrFunctionCall;
+                rc = osReadTransferableObjectFromChannel<apFunctionCall>(spyConnectionSocket, aptrFunctionCall);
 
                 if (rc)
                 {
-                    // Read the function call details from the channel:
-                    rc = osReadTransferableObjectFromChannel<apFunctionCall>(spyConnectionSocket, aptrFunctionCall);
+                    pageFunctionCalls.push_back(aptrFunctionCall.releasePointedObjectOwnership());
                 }
             }
-
-            if (rc)
-            {
-                // If we succeeded, cache the result in the persistent data manager:
-                thePersistentDataMgr.cacheFunctionCall(contextID, callIndex, aptrFunctionCall);
-            }
         }
     }
 
+    // Cache the page. The cache takes ownership of the calls:
+    gaPersistentDataManager::instance().cacheFunctionCallsPage(contextID, pageIndex, pageFunctionCalls);
+
     return rc;
 }
 
@@ -12405,6 +12504,7 @@ GA_CONNECT_API_FUNCTION_WRAPPER_TO_GRAPIFUNCTIONS(gaGetDisplayListObjectDetails,
 // OpenGL / OpenCL Function calls:
 GA_CONNECT_API_FUNCTION_WRAPPER_TO_GRAPIFUNCTIONS(gaGetAmountOfCurrentFrameFunctionCalls, bool, (const apContextID& contextID, int& amountOfFunctionCalls), (contextID, amountOfFunctionCalls));
 GA_CONNECT_API_FUNCTION_WRAPPER_TO_GRAPIFUNCTIONS(gaGetCurrentFrameFunctionCall, bool, (const apContextID& contextID, int callIndex, gtAutoPtr<apFunctionCall>& aptrFunctionCall), (contextID, callIndex, aptrFunctionCall));
+GA_CONNECT_API_FUNCTION_WRAPPER_TO_GRAPIFUNCTIONS(gaGetCurrentFrameFunctionCalls, bool, (const apContextID& contextID, int firstCallIndex, int callsAmount, gtPtrVector<apFunctionCall*>& functionCalls), (contextID, firstCallIndex, callsAmount, functionCalls));
 GA_CONNECT_API_FUNCTION_WRAPPER_TO_GRAPIFUNCTIONS(gaGetLastFunctionCall, bool, (const apContextID& contextID, gtAutoPtr<apFunctionCall>& aptrFunctionCall), (contextID, aptrFunctionCall));
 GA_CONNECT_API_FUNCTION_WRAPPER_TO_GRAPIFUNCTIONS(gaFindCurrentFrameFunctionCall, bool, (const apContextID& contextID, apSearchDirection searchDirection, int searchStartIndex, const gtString& searchedString, bool isCaseSensitiveSearch, int& foundIndex), (contextID, searchDirection, searchStartIndex, searchedString, isCaseSensitiveSearch, foundIndex));
 GA_CONNECT_API_FUNCTION_WRAPPER_TO_GRAPIFUNCTIONS(gaClearFunctionCallsStatistics, bool, (), ());
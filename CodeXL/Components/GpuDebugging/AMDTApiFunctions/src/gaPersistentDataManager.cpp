@@ -39,6 +39,7 @@
 #include <AMDTAPIClasses/Include/Events/apRenderContextDeletedEvent.h>
 #include <AMDTAPIClasses/Include/apBasicParameters.h>
 #include <AMDTProcessDebugger/Include/pdProcessDebugger.h>
+#include <AMDTServerUtilities/Include/suStringConstants.h>
 // #include <AMDTPerformanceCounters/Include/pcPerformanceCountersManager.h>
 
 // Local:
@@ -87,6 +88,7 @@ gaPersistentDataManager::gaPersistentDataManager()
       _breakOnNextFrame(false),
       _breakInMonitoredFunctionCall(false),
       _deleteLogFilesWhenDebuggedProcessTerminates(true),
+      m_localDebuggedProcessId(0),
       _isHTMLLogFileRecordingOn(false),
       _wasOpenGLRecorderOn(false),
       _slowMotionDelayTimeUnits(0),
@@ -436,6 +438,16 @@ void gaPersistentDataManager::onProcessCreatedEvent()
 
     // Mark all the contexts as not updated:
     clearIsContextDataSnapshotUpdatedVec();
+
+    // Remember the process id of a local debugged process, to remove its tmpfs raw data files staging directory when it terminates:
+    pdProcessDebugger& theProcessDebugger = pdProcessDebugger::instance();
+    const apDebugProjectSettings* pProcessCreationData = theProcessDebugger.debuggedProcessCreationData();
+    m_localDebuggedProcessId = 0;
+
+    if ((pProcessCreationData != NULL) && !pProcessCreationData->isRemoteTarget())
+    {
+        m_localDebuggedProcessId = theProcessDebugger.debuggedProcessId();
+    }
 }
 
 
@@ -458,6 +470,10 @@ void gaPersistentDataManager::onProcessTerminatedEvent()
     // Delete the current debug session log files sub directory:
     deleteCurrentDebugSessionLogFilesSubDirectory();
 
+    // The spies remove their tmpfs raw data files staging directory only when the debugged process exits normally.
+    // Remove it here as well, so that a crashed or killed process does not keep holding the memory:
+    deleteRawDataTmpfsStagingDirectory();
+
     // Initialize relevant members:
     _isAPIConnectionEstablished = false;
     _isSpiesUtilitiesModuleLoaded = false;
@@ -1474,7 +1490,7 @@ bool gaPersistentDataManager::clearAllStepFlags()
 // ---------------------------------------------------------------------------
 // Name:        gaPersistentDataManager::getCachedFunctionCall
 // Description: Tries to get a function call from the cache. Fails if the
-//              call was not cached since the last break.
+//              call's page was not cached since the last break.
 // Return Val:  bool - Success / failure.
 // Author:      Uri Shomroni
 // Date:        3/10/2013
@@ -1483,23 +1499,22 @@ bool gaPersistentDataManager::getCachedFunctionCall(const apContextID& contextID
 {
     bool retVal = false;
 
-    // Create the call full index:
-    FunctionCallIndex callFullIndex;
-    callFullIndex.m_context = contextID;
-    callFullIndex.m_indexInContext = callIndex;
-
-    // Try and find the call in our cache:
-    gtMap<FunctionCallIndex, gtAutoPtr<apFunctionCall> >::const_iterator findIter = m_functionCallsCache.find(callFullIndex);
-    gtMap<FunctionCallIndex, gtAutoPtr<apFunctionCall> >::const_iterator endIter = m_functionCallsCache.end();
+    // Try and find the context pages in our cache:
+    gtMap<apContextID, std::vector<FunctionCallsPage> >::const_iterator findIter = m_functionCallsCache.find(contextID);
+    gtMap<apContextID, std::vector<FunctionCallsPage> >::const_iterator endIter = m_functionCallsCache.end();
 
-    if (findIter != endIter)
+    if ((findIter != endIter) && (0 <= callIndex))
     {
-        // Sanity check:
-        const gtAutoPtr<apFunctionCall>& raptrCachedFunctionCall = findIter->second;
-        GT_IF_WITH_ASSERT(NULL != raptrCachedFunctionCall.pointedObject())
+        // Get the call page:
+        const std::vector<FunctionCallsPage>& contextPages = findIter->second;
+        int pageIndex = callIndex / GA_FUNCTION_CALLS_CACHE_PAGE_SIZE;
+        int indexInPage = callIndex % GA_FUNCTION_CALLS_CACHE_PAGE_SIZE;
+
+        // The last page of the log holds less calls:
+        if ((pageIndex < (int)contextPages.size()) && (indexInPage < (int)contextPages[pageIndex].m_calls.size()))
         {
             // Clone the function call:
-            osTransferableObject* pCallClone = raptrCachedFunctionCall->clone();
+            osTransferableObject* pCallClone = contextPages[pageIndex].m_calls[indexInPage]->clone();
             GT_IF_WITH_ASSERT(NULL != pCallClone)
             {
                 // Output it into the auto pointer:
@@ -1513,33 +1528,68 @@ bool gaPersistentDataManager::getCachedFunctionCall(const apContextID& contextID
 }
 
 // ---------------------------------------------------------------------------
-// Name:        gaPersistentDataManager::cacheFunctionCall
-// Description: Adds a function call to the function call cache
-// Author:      Uri Shomroni
-// Date:        3/10/2013
+// Name:        gaPersistentDataManager::isFunctionCallsPageCached
+// Description: Returns true iff a function calls page was fetched since the
+//              last break (even if the page turned out to be empty).
 // ---------------------------------------------------------------------------
-void gaPersistentDataManager::cacheFunctionCall(const apContextID& contextID, int callIndex, const gtAutoPtr<apFunctionCall>& aptrFunctionCall)
+bool gaPersistentDataManager::isFunctionCallsPageCached(const apContextID& contextID, int pageIndex) const
 {
-    // Sanity check:
-    GT_IF_WITH_ASSERT(NULL != aptrFunctionCall.pointedObject())
+    bool retVal = false;
+
+    gtMap<apContextID, std::vector<FunctionCallsPage> >::const_iterator findIter = m_functionCallsCache.find(contextID);
+    gtMap<apContextID, std::vector<FunctionCallsPage> >::const_iterator endIter = m_functionCallsCache.end();
+
+    if (findIter != endIter)
+    {
+        const std::vector<FunctionCallsPage>& contextPages = findIter->second;
+        retVal = (0 <= pageIndex) && (pageIndex < (int)contextPages.size()) && contextPages[pageIndex].m_isFetched;
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gaPersistentDataManager::cacheFunctionCallsPage
+// Description: Adds a page of function calls to the function calls cache.
+// Arguments:   contextID - The context in which the calls were made.
+//              pageIndex - The page index. The page holds the calls that start at
+//                          index pageIndex * GA_FUNCTION_CALLS_CACHE_PAGE_SIZE.
+//              pageFunctionCalls - The page calls. The cache takes ownership of
+//                                  the calls, and the vector is emptied.
+// ---------------------------------------------------------------------------
+void gaPersistentDataManager::cacheFunctionCallsPage(const apContextID& contextID, int pageIndex, gtPtrVector<apFunctionCall*>& pageFunctionCalls)
+{
+    GT_IF_WITH_ASSERT((0 <= pageIndex) && ((int)pageFunctionCalls.size() <= GA_FUNCTION_CALLS_CACHE_PAGE_SIZE))
     {
-        // Create the call full index:
-        FunctionCallIndex callFullIndex;
-        callFullIndex.m_context = contextID;
-        callFullIndex.m_indexInContext = callIndex;
+        std::vector<FunctionCallsPage>& contextPages = m_functionCallsCache[contextID];
 
-        // We do not expect the same function to be cached twice, this method should only be called from
-        // gaGetCurrentFrameFunctionCall itself, and only after cache resolution failed:
-        gtMap<FunctionCallIndex, gtAutoPtr<apFunctionCall> >::const_iterator findIter = m_functionCallsCache.find(callFullIndex);
-        gtMap<FunctionCallIndex, gtAutoPtr<apFunctionCall> >::const_iterator endIter = m_functionCallsCache.end();
+        if ((int)contextPages.size() <= pageIndex)
+        {
+            contextPages.resize(pageIndex + 1);
+        }
 
-        GT_IF_WITH_ASSERT(findIter == endIter)
+        // We do not expect the same page to be cached twice, this method should only be called from
+        // gaGetCurrentFrameFunctionCall(s) itself, and only after cache resolution failed:
+        FunctionCallsPage& callsPage = contextPages[pageIndex];
+
+        GT_IF_WITH_ASSERT(!callsPage.m_isFetched)
         {
-            // Clone this function call into the cache, to avoid distrupting the auto pointer:
-            gtAutoPtr<apFunctionCall> aptrFunctionCallClone = (apFunctionCall*)aptrFunctionCall->clone();
-            m_functionCallsCache[callFullIndex] = aptrFunctionCallClone;
+            // Move the calls into the cache:
+            int amountOfCalls = (int)pageFunctionCalls.size();
+            callsPage.m_calls.reserve(amountOfCalls);
+
+            for (int i = 0; i < amountOfCalls; i++)
+            {
+                callsPage.m_calls.push_back(std::unique_ptr<apFunctionCall>(pageFunctionCalls[i]));
+            }
+
+            pageFunctionCalls.clear();
+            callsPage.m_isFetched = true;
         }
     }
+
+    // Delete the calls that were not moved into the cache:
+    pageFunctionCalls.deleteElementsAndClear();
 }
 
 // ---------------------------------------------------------------------------
@@ -3926,6 +3976,41 @@ void gaPersistentDataManager::deleteCurrentDebugSessionLogFilesSubDirectory()
 }
 
 
+// ---------------------------------------------------------------------------
+// Name:        gaPersistentDataManager::deleteRawDataTmpfsStagingDirectory
+// Description:
+//   Deletes the tmpfs staging directory into which the spies of a local debugged
+//   process wrote the textures and buffers raw data files (Linux only).
+// ---------------------------------------------------------------------------
+void gaPersistentDataManager::deleteRawDataTmpfsStagingDirectory()
+{
+#if ((AMDT_BUILD_TARGET == AMDT_LINUX_OS) && (AMDT_LINUX_VARIANT == AMDT_GENERIC_LINUX_VARIANT))
+
+    if (m_localDebuggedProcessId != 0)
+    {
+        gtString directoryPathAsString;
+        directoryPathAsString.appendFormattedString(SU_STR_rawDataTmpfsStagingDirectoryPath, (unsigned int)m_localDebuggedProcessId);
+
+        osFilePath directoryPath;
+        directoryPath.setPath(directoryPathAsString);
+        directoryPath.reinterpretAsDirectory();
+
+        // The directory is not created when the spies did not write raw data files to tmpfs:
+        osDirectory rawDataDirectory(directoryPath);
+
+        if (rawDataDirectory.exists())
+        {
+            bool rc = rawDataDirectory.deleteRecursively();
+            GT_ASSERT(rc);
+        }
+    }
+
+#endif
+
+    m_localDebuggedProcessId = 0;
+}
+
+
 // ---------------------------------------------------------------------------
 // Name:        gaPersistentDataManager::resumeDebuggedProcessMainThreadRun
 // Description: Resumed the run of the debugged process main thread.
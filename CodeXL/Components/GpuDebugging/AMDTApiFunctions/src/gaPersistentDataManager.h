@@ -23,7 +23,9 @@ class apContextDataSnapshotWasUpdatedEvent;
 // Infra:
 #include <AMDTBaseTools/Include/gtAutoPtr.h>
 #include <AMDTBaseTools/Include/gtMap.h>
+#include <AMDTBaseTools/Include/gtPtrVector.h>
 #include <AMDTBaseTools/Include/gtVector.h>
+#include <AMDTOSWrappers/Include/osOSDefinitions.h>
 #include <AMDTAPIClasses/Include/Events/apIEventsObserver.h>
 #include <AMDTAPIClasses/Include/apGLDebugOutput.h>
 #include <AMDTAPIClasses/Include/apApiFunctionsInitializationData.h>
@@ -38,9 +40,14 @@ class apContextDataSnapshotWasUpdatedEvent;
 #include <AMDTAPIClasses/Include/apRasterMode.h>
 
 // std
+#include <memory>
 #include <mutex>
+#include <vector>
 
 
+// The amount of contiguous function calls that are fetched from the spy, and cached, together:
+#define GA_FUNCTION_CALLS_CACHE_PAGE_SIZE 256
+
 // ----------------------------------------------------------------------------------
 // Class Name:           gaPersistentDataManager : public apIEventsObserver
 // General Description:
@@ -109,9 +116,10 @@ public:
     void deleteLogFilesWhenDebuggedProcessTerminates(bool deleteLogFiles) { _deleteLogFilesWhenDebuggedProcessTerminates = deleteLogFiles; };
     const osFilePath& currentDebugSessionLogFilesSubDirectory() const {return _apiInitData.logFilesDirectoryPath();};
 
-    // Function call caching:
+    // Function call caching. The calls are fetched and cached in pages of GA_FUNCTION_CALLS_CACHE_PAGE_SIZE contiguous calls:
     bool getCachedFunctionCall(const apContextID& contextID, int callIndex, gtAutoPtr<apFunctionCall>& aptrFunctionCall) const;
-    void cacheFunctionCall(const apContextID& contextID, int callIndex, const gtAutoPtr<apFunctionCall>& aptrFunctionCall);
+    bool isFunctionCallsPageCached(const apContextID& contextID, int pageIndex) const;
+    void cacheFunctionCallsPage(const apContextID& contextID, int pageIndex, gtPtrVector<apFunctionCall*>& pageFunctionCalls);
 
     // OpenCL handle caching:
     bool getCacheOpenCLObjectID(oaCLHandle hOpenCLObject, apCLObjectID& o_objectId) const;
@@ -229,18 +237,14 @@ private:
         GA_CONTEXT_DATA_UPDATED_AND_DELETED     // The data was updated successfully, and the context was deleted.
     };
 
-    // An index identifying a function call, for caching:
-    struct FunctionCallIndex
+    // A page of cached function calls. The last page of the log holds less calls:
+    struct FunctionCallsPage
     {
-    public:
-        // Needed for being the key for a map:
-        bool operator<(const FunctionCallIndex& other) const
-        {
-            return (m_context < other.m_context) || ((m_context == other.m_context) && (m_indexInContext < other.m_indexInContext));
-        };
-
-        apContextID m_context;
-        int m_indexInContext;
+        FunctionCallsPage() : m_isFetched(false) {};
+
+        // True iff the page was fetched since the last break (even if it turned out to be empty):
+        bool m_isFetched;
+        std::vector<std::unique_ptr<apFunctionCall> > m_calls;
     };
 
     // The singletons deleter should be able to delete me:
@@ -306,6 +310,7 @@ private:
     bool setSpyGLDebugOutputSeverityEnabled(apGLDebugOutputSeverity severity, bool enabled);
     void createCurrentDebugSessionLogFilesSubDirectory();
     void deleteCurrentDebugSessionLogFilesSubDirectory();
+    void deleteRawDataTmpfsStagingDirectory();
     bool resumeDebuggedProcessMainThreadRun();
     void bindSourceCodeBreakpoints(const osFilePath& programFilePath);
     bool setSpyKernelDebuggingEnable();
@@ -344,6 +349,10 @@ private:
     // Contains the current debug session log files sub directory:
     osFilePath _currentDebugSessionLogFilesSubDirPath;
 
+    // The id of the debugged process, when it runs on this machine (0 otherwise).
+    // Identifies the tmpfs raw data files staging directory of the debugged process:
+    osProcessId m_localDebuggedProcessId;
+
     // Contains true iff HTML log file recording is on:
     bool _isHTMLLogFileRecordingOn;
 
@@ -431,8 +440,8 @@ private:
     // (For the current debugged application suspension)
     gtMap<apContextID, ContextDataUpdateStatus> _isContextDataSnapshotUpdatedMap;
 
-    // Mapping a context id x function call id to the function call data:
-    gtMap<FunctionCallIndex, gtAutoPtr<apFunctionCall> > m_functionCallsCache;
+    // Mapping a context id to its cached function calls pages, by page index:
+    gtMap<apContextID, std::vector<FunctionCallsPage> > m_functionCallsCache;
 
     // Mapping a OpenCL handle x object id:
     gtMap<oaCLHandle, apCLObjectID> m_openCLHandlesCache;
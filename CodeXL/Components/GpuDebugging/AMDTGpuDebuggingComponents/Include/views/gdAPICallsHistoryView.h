@@ -137,6 +137,7 @@ protected slots:
     virtual void onAddBreakpoints();
     virtual void onEnableAllBreakpoints();
     virtual void onAboutToShowContextMenu();
+    virtual void onVerticalScrollBarValueChanged(int value);
 
 protected:
     virtual void initializeListIcons();
@@ -186,6 +187,13 @@ protected:
     /// True iff the data is updated from server for the current process suspension
     bool m_isDataUpdated;
 
+    /// The rows which were prefetched ahead of the scroll position since the list was updated: [m_prefetchedFirstRow, m_prefetchedEndRow)
+    int m_prefetchedFirstRow;
+    int m_prefetchedEndRow;
+
+    /// The vertical scroll bar previous value, used for prefetching rows in the scrolling direction
+    int m_lastVerticalScrollBarValue;
+
     apContextID _processRunSuspendedInContext;
 
     // Contains true iff we are during second chance exception handling:
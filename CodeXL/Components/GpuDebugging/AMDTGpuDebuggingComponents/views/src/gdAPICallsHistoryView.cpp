@@ -49,6 +49,9 @@
 #include <AMDTGpuDebuggingComponents/Include/dialogs/gdBreakpointsDialog.h>
 #include <AMDTGpuDebuggingComponents/Include/gdHTMLProperties.h>
 
+// The amount of rows fetched ahead of the displayed rows, when the list is scrolled:
+#define GD_CALLS_HISTORY_PREFETCHED_ROWS_AMOUNT 256
+
 // ---------------------------------------------------------------------------
 // Name:        gdAPICallsHistoryView::gdAPICallsHistoryView
 // Description: Constructor
@@ -61,7 +64,7 @@
 gdAPICallsHistoryView::gdAPICallsHistoryView(afProgressBarWrapper* pProgressBar, QWidget* pParent, bool isGlobal, bool shouldSetCaption)
     : acVirtualListCtrl(pParent, NULL), afBaseView(pProgressBar), _pBreakOnAction(NULL), _pEnableDisaleAllBreakpointsAction(NULL), _pAddRemoveBreakpointsAction(NULL),
       _pTableModel(NULL), m_isGlobal(isGlobal), _previousRowCount(0),
-      _amountOfFunctionCalls(0), m_isDataUpdated(false), _processRunSuspendedInContext(AP_OPENGL_CONTEXT, 0), _isDuringSecondChanceExceptionHandling(false),
+      _amountOfFunctionCalls(0), m_isDataUpdated(false), m_prefetchedFirstRow(0), m_prefetchedEndRow(0), m_lastVerticalScrollBarValue(0), _processRunSuspendedInContext(AP_OPENGL_CONTEXT, 0), _isDuringSecondChanceExceptionHandling(false),
       _isDebuggedProcessSuspended(false), _activeContextId(AP_OPENGL_CONTEXT, 0), _executionMode(AP_DEBUGGING_MODE),
       _GLCallIconIndex(-1), _CLCallIconIndex(-1), _GLExtCallIconIndex(-1), _osSpecificAPICallIconIndex(-1), _osSpecificExtensionAPICallIconIndex(-1), _stringMarkerIconIndex(-1),
       _textureIconIndex(-1), _glBufferIconIndex(-1), _clBufferIconIndex(-1), _queueIconIndex(-1), _nextFunctionCallIconIndex(-1),
@@ -93,6 +96,9 @@ gdAPICallsHistoryView::gdAPICallsHistoryView(afProgressBarWrapper* pProgressBar,
     bool rcConnect = connect(this, SIGNAL(clicked(const QModelIndex&)), this, SLOT(onCallsHistoryItemClicked(const QModelIndex&)));
     GT_ASSERT(rcConnect);
 
+    rcConnect = connect(verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(onVerticalScrollBarValueChanged(int)));
+    GT_ASSERT(rcConnect);
+
     // Allow only single selection:
     setSelectionMode(QAbstractItemView::SingleSelection);
     setSelectionBehavior(QAbstractItemView::SelectRows);
@@ -509,6 +515,10 @@ void gdAPICallsHistoryView::updateList(apContextID contextId)
         // The data is now updated from server
         m_isDataUpdated = true;
 
+        // No rows were prefetched for the new data:
+        m_prefetchedFirstRow = 0;
+        m_prefetchedEndRow = 0;
+
 
         if (_amountOfFunctionCalls > 0)
         {
@@ -806,6 +816,60 @@ void gdAPICallsHistoryView::onCallsHistoryItemClicked(const QModelIndex& index)
     updatePropertiesAndStatusBar(index.row());
 }
 
+// ---------------------------------------------------------------------------
+// Name:        gdAPICallsHistoryView::onVerticalScrollBarValueChanged
+// Description: Prefetches the function calls that follow the displayed rows (or
+//              precede them, when scrolling up), so that the calls are fetched from
+//              the spy in a few large replies instead of row by row as they are displayed.
+// Arguments:   value - the scroll bar value
+// ---------------------------------------------------------------------------
+void gdAPICallsHistoryView::onVerticalScrollBarValueChanged(int value)
+{
+    bool isScrollingDown = (m_lastVerticalScrollBarValue <= value);
+    m_lastVerticalScrollBarValue = value;
+
+    // Only call API calls when debugged process is suspended:
+    if (_isDebuggedProcessSuspended && (_executionMode != AP_PROFILING_MODE) && m_isDataUpdated)
+    {
+        int firstDisplayedRow = rowAt(0);
+        int lastDisplayedRow = rowAt(viewport()->height() - 1);
+
+        if (lastDisplayedRow < 0)
+        {
+            lastDisplayedRow = _amountOfFunctionCalls - 1;
+        }
+
+        if (0 <= firstDisplayedRow)
+        {
+            int prefetchFirstRow = isScrollingDown ? (lastDisplayedRow + 1) : std::max(firstDisplayedRow - GD_CALLS_HISTORY_PREFETCHED_ROWS_AMOUNT, 0);
+            int prefetchEndRow = isScrollingDown ? std::min(lastDisplayedRow + 1 + GD_CALLS_HISTORY_PREFETCHED_ROWS_AMOUNT, _amountOfFunctionCalls) : firstDisplayedRow;
+
+            // Do not prefetch the same rows again:
+            bool isPrefetched = (m_prefetchedFirstRow <= prefetchFirstRow) && (prefetchEndRow <= m_prefetchedEndRow);
+
+            if ((prefetchFirstRow < prefetchEndRow) && !isPrefetched)
+            {
+                // The calls are cached by the API functions, the returned copies are not needed here:
+                gtPtrVector<apFunctionCall*> prefetchedFunctionCalls;
+                gaGetCurrentFrameFunctionCalls(_activeContextId, prefetchFirstRow, prefetchEndRow - prefetchFirstRow, prefetchedFunctionCalls);
+                prefetchedFunctionCalls.deleteElementsAndClear();
+
+                // Extend the prefetched rows range, or replace it if the list jumped away from it:
+                if ((prefetchEndRow < m_prefetchedFirstRow) || (m_prefetchedEndRow < prefetchFirstRow))
+                {
+                    m_prefetchedFirstRow = prefetchFirstRow;
+                    m_prefetchedEndRow = prefetchEndRow;
+                }
+                else
+                {
+                    m_prefetchedFirstRow = std::min(m_prefetchedFirstRow, prefetchFirstRow);
+                    m_prefetchedEndRow = std::max(m_prefetchedEndRow, prefetchEndRow);
+                }
+            }
+        }
+    }
+}
+
 // ---------------------------------------------------------------------------
 // Name:        gdAPICallsHistoryView::onTreeItemSelection
 // Description:
@@ -111,6 +111,64 @@ bool gaGetOpenCLFunctionCallImpl(int contextId, int callIndex, gtAutoPtr<apFunct
 }
 
 
+// ---------------------------------------------------------------------------
+// Name:        gaGetOpenCLFunctionCallsImpl
+// Description:
+//   Implementation of gaGetOpenCLFunctionCall() for a range of calls.
+//   Returns a contiguous range of the context logged function calls.
+// Arguments:   contextId - The queried context id.
+//              firstCallIndex - The index of the first returned call.
+//              callsAmount - The maximal amount of returned calls. Less calls are returned
+//                            when the range exceeds the logged calls.
+//              functionCalls - Will get the function calls.
+// Return Val:  bool - Success / failure.
+// ---------------------------------------------------------------------------
+bool gaGetOpenCLFunctionCallsImpl(int contextId, int firstCallIndex, int callsAmount, gtPtrVector<apFunctionCall*>& functionCalls)
+{
+    bool retVal = false;
+
+    // Get the appropriate context monitor:
+    const suContextMonitor* pContextMonitor = csOpenCLMonitor::instance().contextMonitor(contextId);
+
+    if (pContextMonitor != NULL)
+    {
+        // Get its monitored functions calls logger:
+        const suCallsHistoryLogger* pCallsHistoryLogger = pContextMonitor->callsHistoryLogger();
+        GT_IF_WITH_ASSERT(pCallsHistoryLogger != NULL)
+        {
+            // Get the amount of function calls:
+            int amountOfFunctionCalls = pCallsHistoryLogger->amountOfFunctionCalls();
+
+            // Verify that the first queried call is in the right range:
+            if ((0 <= firstCallIndex) && (firstCallIndex < amountOfFunctionCalls) && (0 < callsAmount))
+            {
+                // Clip the range to the logged calls:
+                int endCallIndex = ((callsAmount < (amountOfFunctionCalls - firstCallIndex)) ? (firstCallIndex + callsAmount) : amountOfFunctionCalls);
+                retVal = true;
+
+                for (int i = firstCallIndex; i < endCallIndex; i++)
+                {
+                    // Get the current function call:
+                    gtAutoPtr<apFunctionCall> aptrFunctionCall;
+                    bool rcCall = pCallsHistoryLogger->getFunctionCall(i, aptrFunctionCall);
+
+                    if (!rcCall)
+                    {
+                        // Return the calls read so far:
+                        retVal = !functionCalls.empty();
+                        break;
+                    }
+
+                    functionCalls.push_back(aptrFunctionCall.releasePointedObjectOwnership());
+                }
+            }
+        }
+    }
+
+    return retVal;
+}
+
+
 // ---------------------------------------------------------------------------
 // Name:        gaGetLastOpenCLFunctionCallImpl
 // Description: Implementation of gaGetLastOpenCLFunctionCallImpl()
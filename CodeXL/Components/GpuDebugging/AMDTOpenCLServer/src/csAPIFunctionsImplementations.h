@@ -31,6 +31,7 @@ class apKernelSourceCodeBreakpoint;
 class apStatistics;
 
 // Infra:
+#include <AMDTBaseTools/Include/gtPtrVector.h>
 #include <AMDTOSWrappers/Include/osOSDefinitions.h>
 #include <AMDTOSAPIWrappers/Include/oaOpenCLIncludes.h>
 #include <AMDTOSAPIWrappers/Include/oaTexelDataFormat.h>
@@ -43,6 +44,7 @@ class apStatistics;
 // Function calls:
 bool gaGetAmountOfOpenCLFunctionCallsImpl(int contextId, int& amountOfFunctionCalls);
 bool gaGetOpenCLFunctionCallImpl(int contextId, int callIndex, gtAutoPtr<apFunctionCall>& aptrFunctionCall);
+bool gaGetOpenCLFunctionCallsImpl(int contextId, int firstCallIndex, int callsAmount, gtPtrVector<apFunctionCall*>& functionCalls);
 bool gaGetLastOpenCLFunctionCallImpl(int contextId, gtAutoPtr<apFunctionCall>& aptrFunctionCall);
 bool gaFindOpenCLFunctionCallImpl(int contextId, apSearchDirection searchDirection, int searchStartIndex, const gtString& searchedString, bool isCaseSensitiveSearch, int& foundIndex);
 bool gaGetOpenCLHandleObjectDetailsImpl(oaCLHandle handle, const apCLObjectID*& pCLOjbectIDDetails);
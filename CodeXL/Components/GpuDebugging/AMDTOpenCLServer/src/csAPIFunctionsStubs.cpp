@@ -201,7 +201,8 @@ void gaGetAmountOfOpenCLFunctionCallsStub(osSocket& apiSocket)
 
 // ---------------------------------------------------------------------------
 // Name:        gaGetOpenCLFunctionCallStub
-// Description: Stub function for gaGetOpenCLFunctionCall
+// Description: Stub function for gaGetOpenCLFunctionCall. The request holds a range
+//              of calls, which are returned in a single reply.
 // Arguments: osSocket& apiSocket
 // Return Val: void
 // Author:      Sigal Algranaty
@@ -213,22 +214,33 @@ void gaGetOpenCLFunctionCallStub(osSocket& apiSocket)
     gtInt32 contextIdAsInt32 = -1;
     apiSocket >> contextIdAsInt32;
 
-    gtInt32 callIndexAsInt32 = -1;
-    apiSocket >> callIndexAsInt32;
+    gtInt32 firstCallIndexAsInt32 = -1;
+    apiSocket >> firstCallIndexAsInt32;
+
+    gtInt32 callsAmountAsInt32 = 0;
+    apiSocket >> callsAmountAsInt32;
 
     // Call the function implementation:
-    gtAutoPtr<apFunctionCall> aptrFunctionCall;
-    bool rc = gaGetOpenCLFunctionCallImpl((int)contextIdAsInt32, (int)callIndexAsInt32, aptrFunctionCall);
+    gtPtrVector<apFunctionCall*> functionCalls;
+    bool rc = gaGetOpenCLFunctionCallsImpl((int)contextIdAsInt32, (int)firstCallIndexAsInt32, (int)callsAmountAsInt32, functionCalls);
 
     // Return the return value:
     apiSocket << rc;
 
     if (rc)
     {
-        // Return the arguments that should be returned:
-        osTransferableObject* pFunctionCallAsTransferableObj = aptrFunctionCall.pointedObject();
-        apiSocket << *pFunctionCallAsTransferableObj;
+        // Return the function calls, in a single reply:
+        size_t returnedCallsAmount = functionCalls.size();
+        apiSocket << (gtInt32)returnedCallsAmount;
+
+        for (size_t i = 0; i < returnedCallsAmount; i++)
+        {
+            osTransferableObject* pFunctionCallAsTransferableObj = functionCalls[i];
+            apiSocket << *pFunctionCallAsTransferableObj;
+        }
     }
+
+    functionCalls.deleteElementsAndClear();
 }
 
 // ---------------------------------------------------------------------------
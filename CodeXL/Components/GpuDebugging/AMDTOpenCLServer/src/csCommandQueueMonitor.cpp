@@ -894,21 +894,10 @@ void csCommandQueueMonitor::addEventToQueue(oaCLEventHandle eventHandle, bool re
             if (numberOfEventsInQueue < CS_MAX_EVENTS_PER_QUEUE)
             {
                 // Is this a new event?
-                bool newEvent = true;
-
-                for (int i = 0; i < numberOfEventsInQueue; i++)
-                {
-                    if (_commandQueueEvents[i] == eventHandle)
-                    {
-                        newEvent = false;
-                        break;
-                    }
-                }
+                bool newEvent = _commandQueueEvents.insert(eventHandle).second;
 
                 GT_IF_WITH_ASSERT(newEvent)
                 {
-                    _commandQueueEvents.push_back(eventHandle);
-
                     // If this is the last event we will be adding:
                     if (numberOfEventsInQueue == (CS_MAX_EVENTS_PER_QUEUE - 1))
                     {
@@ -935,7 +924,7 @@ void csCommandQueueMonitor::addEventToQueue(oaCLEventHandle eventHandle, bool re
 
 // ---------------------------------------------------------------------------
 // Name:        csCommandQueueMonitor::removeEventFromQueue
-// Description: Removes an event handle from our vector:
+// Description: Removes an event handle from our set:
 // Author:      Uri Shomroni
 // Date:        24/10/2013
 // ---------------------------------------------------------------------------
@@ -947,29 +936,9 @@ void csCommandQueueMonitor::removeEventFromQueue(oaCLEventHandle eventHandle)
         {
             lockAccessToEnqueuedCommands();
 
-            int numberOfEventsInQueue = (int)_commandQueueEvents.size();
-            bool foundEvent = false;
-
-            for (int i = 0; i < numberOfEventsInQueue; i++)
-            {
-                if (foundEvent)
-                {
-                    // This can only be called starting with the second iteration - so we can access i - 1:
-                    _commandQueueEvents[i - 1] = _commandQueueEvents[i];
-                }
-                else // !foundEvent
-                {
-                    // Check the current event:
-                    foundEvent = (eventHandle == _commandQueueEvents[i]);
-                }
-            }
-
-            // The last handle we now have is either the found event or a duplicate we created.
-            GT_IF_WITH_ASSERT(foundEvent)
-            {
-                // Remove it:
-                _commandQueueEvents.pop_back();
-            }
+            // Remove the event:
+            bool foundEvent = (0 < _commandQueueEvents.erase(eventHandle));
+            GT_ASSERT(foundEvent);
 
             unlockAccessToEnqueuedCommands();
         }
@@ -11,6 +11,9 @@
 #ifndef __CSCOMMANDQUEUEMONITOR_H
 #define __CSCOMMANDQUEUEMONITOR_H
 
+// C++:
+#include <unordered_set>
+
 // Infra:
 #include <AMDTBaseTools/Include/gtPtrVector.h>
 #include <AMDTOSWrappers/Include/osCriticalSection.h>
@@ -125,9 +128,9 @@ private:
     gtPtrVector<apCLEnqueuedCommand*> _enqueuedCommands;
     osCriticalSection _enqueuedCommandsAccessCS;
 
-    // A vector holding the command queue's events:
+    // A set holding the command queue's events:
     bool m_logQueueEvents;
-    gtVector<oaCLEventHandle> _commandQueueEvents;
+    std::unordered_set<oaCLEventHandle> _commandQueueEvents;
 
     // The maximal numbers of commands we will hold in a queue until we clear it:
     unsigned int _maxCommandsPerQueue;
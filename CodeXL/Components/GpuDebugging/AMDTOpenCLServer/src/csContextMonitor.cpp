@@ -269,6 +269,9 @@ void csContextMonitor::onDebuggedProcessSuspended()
 {
     // Notify the queues monitor:
     _commandQueuesMonitor.onDebuggedProcessSuspended();
+
+    // Notify the events monitor:
+    m_eventsMonitor.onDebuggedProcessSuspended();
 }
 // ---------------------------------------------------------------------------
 // Name:        csContextMonitor::onDebuggedProcessResumed
@@ -8,17 +8,24 @@
 
 //------------------------------ csDWARFParser.cpp ------------------------------
 
+// Standard C++:
+#include <algorithm>
+
 // Infra:
 #include <AMDTBaseTools/Include/AMDTDefinitions.h>
 #include <AMDTBaseTools/Include/gtAssert.h>
 #include <AMDTBaseTools/Include/gtQueue.h>
 #include <AMDTBaseTools/Include/gtStringTokenizer.h>
+#include <AMDTOSWrappers/Include/osDebugLog.h>
+#include <AMDTOSWrappers/Include/osDirectory.h>
+#include <AMDTOSWrappers/Include/osFile.h>
 #include <AMDTOSWrappers/Include/osFilePath.h>
 #include <AMDTOSAPIWrappers/Include/oaDataType.h>
 #include <AMDTOSAPIWrappers/Include/oaTexelDataFormat.h>
 
 // Local:
 #include <src/csDWARFParser.h>
+#include <src/csStringConstants.h>
 
 // GRLibDWARF:
 #include <libelf.h>
@@ -43,6 +50,14 @@
 #define DW_AT_AMDIL_address_space 0x3ff1
 #define DW_AT_AMDIL_resource 0x3ff2
 
+// Debug information cache file format. Change the version whenever the cached data layout changes:
+#define CS_DWARF_CACHE_FILE_MAGIC 0x57445343
+#define CS_DWARF_CACHE_FILE_VERSION 1
+
+// FNV-1a 64 bit hash parameters, used to key the cache by the binary contents:
+#define CS_DWARF_CACHE_FNV_OFFSET_BASIS 0xCBF29CE484222325ULL
+#define CS_DWARF_CACHE_FNV_PRIME 0x100000001B3ULL
+
 // Define this as a macro rather than a function to have the GT_ASSERT show the correct file / line:
 #define CS_DW_REPORT_ERROR(dwErr, cond)             \
     {                                                   \
@@ -557,12 +572,36 @@ bool csDWARFParser::initializeWithBinary(const void* binaryData, gtSize_t binary
     bool retVal = false;
 
     // We do not currently support parsing two binaries:
-    if (!_isInitialized)
+    bool shouldParseBinary = !_isInitialized;
+    osFilePath cacheFilePath;
+    bool isCacheAvailable = false;
+
+    if (shouldParseBinary)
     {
         // Copy the data pointer:
         _binaryData = binaryData;
         _binarySize = binarySize;
 
+        // If this binary was already parsed, load its debug information from the cache instead of parsing it again:
+        isCacheAvailable = getCacheFilePath(cacheFilePath);
+
+        if (isCacheAvailable)
+        {
+            if (loadFromCacheFile(cacheFilePath))
+            {
+                retVal = true;
+                _isInitialized = true;
+                shouldParseBinary = false;
+
+                gtString logMsg = L"Loaded kernel debug information from cache: ";
+                logMsg.append(cacheFilePath.asString());
+                OS_OUTPUT_DEBUG_LOG(logMsg.asCharArray(), OS_DEBUG_LOG_DEBUG);
+            }
+        }
+    }
+
+    if (shouldParseBinary)
+    {
         // Initialize an Elf object with this memory:
         GT_ASSERT(_pElf == NULL);
         elf_version(EV_CURRENT);
@@ -603,11 +642,17 @@ bool csDWARFParser::initializeWithBinary(const void* binaryData, gtSize_t binary
                         _pCUProgram->_programScopeType = csDWARFProgram::CS_COMPILATION_UNIT_SCOPE;
                         fillProgramWithInformationFromDIE(*_pCUProgram, NULL, cuDIE);
 
+                        // Flatten the scope tree into an address index:
+                        buildAddressScopeIndex();
+
                         // Use the CU DIE to get the line number information. This needs to happen after the programs are
                         // initialized, since each entry must be associated with a program:
                         bool rcLn = initializeLineNumberInformation(cuDIE);
                         GT_ASSERT(rcLn);
 
+                        // Flatten the line information into an address index:
+                        buildAddressLineIndex();
+
                         // Release the CU DIE:
                         dwarf_dealloc(_pDwarf, (Dwarf_Ptr)cuDIE, DW_DLA_DIE);
                     }
@@ -620,6 +665,13 @@ bool csDWARFParser::initializeWithBinary(const void* binaryData, gtSize_t binary
                 {
                     m_dwarfAddressSize = (int)ptrSz;
                 }
+
+                // Cache the parsed information, so that debugging this binary again will not require parsing it:
+                if (isCacheAvailable && (_pCUProgram != NULL))
+                {
+                    bool rcCache = storeInCacheFile(cacheFilePath);
+                    GT_ASSERT(rcCache);
+                }
             }
             else
             {
@@ -642,6 +694,7 @@ bool csDWARFParser::initializeWithBinary(const void* binaryData, gtSize_t binary
 
             int rcDF = dwarf_finish(_pDwarf, &finishErr);
             GT_ASSERT(DW_DLV_OK == rcDF);
+            _pDwarf = NULL;
         }
 
         if (_pElf != NULL)
@@ -680,16 +733,18 @@ bool csDWARFParser::terminate()
         clearLineInformation();
 
         // Delete the program / variable tree (the destructors should clear the hierarchy):
+        _addressScopeIndex.clear();
         delete _pCUProgram;
         _pCUProgram = NULL;
 
-        // Finish the DWARF session:
+        // Finish the DWARF session. Note that there is no session if the information was loaded from the cache:
         if (_pDwarf != NULL)
         {
             Dwarf_Error finishErr;
             memset((void*)&finishErr, 0, sizeof(Dwarf_Error));
             int rcDF = dwarf_finish(_pDwarf, &finishErr);
             GT_ASSERT(rcDF == DW_DLV_OK);
+            _pDwarf = NULL;
         }
 
         // End the ELF session:
@@ -739,15 +794,17 @@ bool csDWARFParser::lineNumberFromAddress(csDwarfAddressType addr, csDWARFCodeLo
     codeLoc._lineNumber = -1;
 
     // Find the address:
-    gtMap<csDwarfAddressType, csDWARFCodeLocation>::const_iterator findIter = _programCounterToCodeLocation.find(addr);
-    gtMap<csDwarfAddressType, csDWARFCodeLocation>::const_iterator endIter = _programCounterToCodeLocation.end();
+    gtVector<AddressLine>::const_iterator beginIter = _addressLineIndex.begin();
+    gtVector<AddressLine>::const_iterator endIter = _addressLineIndex.end();
+    gtVector<AddressLine>::const_iterator findIter = std::lower_bound(beginIter, endIter, addr,
+    [](const AddressLine & addressLine, csDwarfAddressType address) { return addressLine._programCounter < address; });
 
-    if (findIter != endIter)
+    if ((findIter != endIter) && ((*findIter)._programCounter == addr))
     {
         retVal = true;
 
         // Return the line number:
-        codeLoc = (*findIter).second;
+        codeLoc = (*findIter)._codeLocation;
     }
 
     return retVal;
@@ -998,7 +1055,8 @@ bool csDWARFParser::listVariableRegisterLocations(gtVector<gtUInt64>& variableLo
 
 // ---------------------------------------------------------------------------
 // Name:        csDWARFParser::findAddressScope
-// Description: Finds the smallest scope that contains addr
+// Description: Finds the smallest scope that contains addr, using the address
+//              scope index.
 // Author:      Uri Shomroni
 // Date:        20/12/2010
 // ---------------------------------------------------------------------------
@@ -1006,6 +1064,37 @@ const csDWARFProgram* csDWARFParser::findAddressScope(csDwarfAddressType addr)
 {
     const csDWARFProgram* retVal = NULL;
 
+    // Find the last range that starts at or before the address:
+    gtVector<AddressScopeRange>::const_iterator beginIter = _addressScopeIndex.begin();
+    gtVector<AddressScopeRange>::const_iterator endIter = _addressScopeIndex.end();
+    gtVector<AddressScopeRange>::const_iterator findIter = std::upper_bound(beginIter, endIter, addr,
+    [](csDwarfAddressType address, const AddressScopeRange & scopeRange) { return address < scopeRange._startPC; });
+
+    if (findIter != beginIter)
+    {
+        // The ranges are disjoint, so only this range may contain the address:
+        --findIter;
+
+        if (addr < (*findIter)._endPC)
+        {
+            retVal = (*findIter)._pScope;
+        }
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        csDWARFParser::findAddressScopeInProgramTree
+// Description: Finds the smallest scope that contains addr by walking the
+//              program tree. Used to build the address scope index.
+// Author:      Uri Shomroni
+// Date:        20/12/2010
+// ---------------------------------------------------------------------------
+const csDWARFProgram* csDWARFParser::findAddressScopeInProgramTree(csDwarfAddressType addr) const
+{
+    const csDWARFProgram* retVal = NULL;
+
     // Start from the entire program:
     bool goOn = true;
     const csDWARFProgram* pCurrentScope = _pCUProgram;
@@ -2956,6 +3045,7 @@ void csDWARFParser::clearLineInformation()
     _programCounterToCodeLocation.clear();
     _codeLocationToProgramCounters.clear();
     _programCountersMappedToLineNumbers.clear();
+    _addressLineIndex.clear();
 }
 
 // ---------------------------------------------------------------------------
@@ -3022,3 +3112,628 @@ void csDWARFParser::addLeafMembersToVector(const csDWARFVariable& variableData,
     }
 }
 
+// ---------------------------------------------------------------------------
+// Name:        csDWARFParser::buildAddressScopeIndex
+// Description: Flattens the program tree into a sorted vector of disjoint address
+//              ranges, each mapped to the smallest scope containing it, so that
+//              findAddressScope does not need to walk the tree.
+// ---------------------------------------------------------------------------
+void csDWARFParser::buildAddressScopeIndex()
+{
+    _addressScopeIndex.clear();
+
+    // Collect the boundaries of all the scope ranges. The smallest scope containing an address
+    // can only change at one of these boundaries:
+    gtVector<const csDWARFProgram*> programs;
+    listProgramsInPreorder(programs);
+    gtVector<csDwarfAddressType> rangeBoundaries;
+    int numberOfPrograms = (int)programs.size();
+
+    for (int i = 0; i < numberOfPrograms; i++)
+    {
+        const gtVector<csDWARFProgram::ProgramPCRange>& programPCRanges = programs[i]->_programPCRanges;
+        int numberOfPCRanges = (int)programPCRanges.size();
+
+        for (int j = 0; j < numberOfPCRanges; j++)
+        {
+            rangeBoundaries.push_back(programPCRanges[j]._startPC);
+            rangeBoundaries.push_back(programPCRanges[j]._endPC);
+        }
+    }
+
+    std::sort(rangeBoundaries.begin(), rangeBoundaries.end());
+    rangeBoundaries.erase(std::unique(rangeBoundaries.begin(), rangeBoundaries.end()), rangeBoundaries.end());
+
+    // Resolve the scope of each range between two consecutive boundaries once, merging adjacent ranges of the same scope:
+    int numberOfBoundaries = (int)rangeBoundaries.size();
+
+    for (int i = 0; i + 1 < numberOfBoundaries; i++)
+    {
+        const csDWARFProgram* pRangeScope = findAddressScopeInProgramTree(rangeBoundaries[i]);
+
+        if (pRangeScope != NULL)
+        {
+            if ((!_addressScopeIndex.empty()) && (_addressScopeIndex.back()._pScope == pRangeScope) && (_addressScopeIndex.back()._endPC == rangeBoundaries[i]))
+            {
+                _addressScopeIndex.back()._endPC = rangeBoundaries[i + 1];
+            }
+            else
+            {
+                AddressScopeRange scopeRange;
+                scopeRange._startPC = rangeBoundaries[i];
+                scopeRange._endPC = rangeBoundaries[i + 1];
+                scopeRange._pScope = pRangeScope;
+                _addressScopeIndex.push_back(scopeRange);
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        csDWARFParser::buildAddressLineIndex
+// Description: Moves the address to line number map into a sorted vector, which
+//              is searched by lineNumberFromAddress.
+// ---------------------------------------------------------------------------
+void csDWARFParser::buildAddressLineIndex()
+{
+    _addressLineIndex.clear();
+    _addressLineIndex.reserve(_programCounterToCodeLocation.size());
+
+    // The map is sorted by address, so the vector will be as well:
+    gtMap<csDwarfAddressType, csDWARFCodeLocation>::const_iterator endIter = _programCounterToCodeLocation.end();
+
+    for (gtMap<csDwarfAddressType, csDWARFCodeLocation>::const_iterator iter = _programCounterToCodeLocation.begin(); iter != endIter; ++iter)
+    {
+        AddressLine addressLine;
+        addressLine._programCounter = (*iter).first;
+        addressLine._codeLocation = (*iter).second;
+        _addressLineIndex.push_back(addressLine);
+    }
+
+    // The map is only needed while the line information is parsed:
+    _programCounterToCodeLocation.clear();
+}
+
+// ---------------------------------------------------------------------------
+// Name:        csDWARFParser::listProgramsInPreorder
+// Description: Lists all the programs in the tree, each program before its children.
+// ---------------------------------------------------------------------------
+void csDWARFParser::listProgramsInPreorder(gtVector<const csDWARFProgram*>& programs) const
+{
+    programs.clear();
+
+    gtVector<const csDWARFProgram*> programsToVisit;
+
+    if (_pCUProgram != NULL)
+    {
+        programsToVisit.push_back(_pCUProgram);
+    }
+
+    while (!programsToVisit.empty())
+    {
+        const csDWARFProgram* pCurrentProgram = programsToVisit.back();
+        programsToVisit.pop_back();
+        programs.push_back(pCurrentProgram);
+
+        // Push the children in reverse, so that they are visited in order:
+        const gtPtrVector<csDWARFProgram*>& childPrograms = pCurrentProgram->_childPrograms;
+
+        for (int i = (int)childPrograms.size() - 1; i >= 0; i--)
+        {
+            GT_IF_WITH_ASSERT(childPrograms[i] != NULL)
+            {
+                programsToVisit.push_back(childPrograms[i]);
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        csDWARFParser::getCacheFilePath
+// Description: Gets the path of the debug information cache file of the current
+//              binary. The file name is a hash of the binary and the kernel
+//              source path, which is part of the cached information.
+// Return Val:  bool - Success / failure.
+// ---------------------------------------------------------------------------
+bool csDWARFParser::getCacheFilePath(osFilePath& cacheFilePath) const
+{
+    bool retVal = false;
+
+    if ((_binaryData != NULL) && (_binarySize > 0))
+    {
+        // Hash the binary and the source path:
+        gtUInt64 binaryHash = CS_DWARF_CACHE_FNV_OFFSET_BASIS;
+        const gtUByte* pBinaryBytes = (const gtUByte*)_binaryData;
+
+        for (gtSize_t i = 0; i < _binarySize; i++)
+        {
+            binaryHash = (binaryHash ^ pBinaryBytes[i]) * CS_DWARF_CACHE_FNV_PRIME;
+        }
+
+        const wchar_t* pSourcePath = _firstSourceFileRealPath.asCharArray();
+        int sourcePathLength = _firstSourceFileRealPath.length();
+
+        for (int i = 0; i < sourcePathLength; i++)
+        {
+            binaryHash = (binaryHash ^ (gtUInt64)pSourcePath[i]) * CS_DWARF_CACHE_FNV_PRIME;
+        }
+
+        gtString cacheFileName;
+        cacheFileName.appendFormattedString(L"%016llx_%llx", (unsigned long long)binaryHash, (unsigned long long)_binarySize);
+
+        // Make sure the cache directory exists:
+        cacheFilePath.setPath(osFilePath::OS_TEMP_DIRECTORY);
+        cacheFilePath.appendSubDirectory(CS_STR_DWARFCacheDirectoryName);
+        osDirectory cacheDirectory(cacheFilePath);
+        retVal = cacheDirectory.exists() || cacheDirectory.create();
+
+        cacheFilePath.setFileName(cacheFileName);
+        cacheFilePath.setFileExtension(CS_STR_DWARFCacheFileExtension);
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        csDWARFParser::loadFromCacheFile
+// Description: Loads the program tree, the line information and the address
+//              indices from a cache file written by storeInCacheFile.
+// Return Val:  bool - Success / failure. On failure, no information is loaded.
+// ---------------------------------------------------------------------------
+bool csDWARFParser::loadFromCacheFile(const osFilePath& cacheFilePath)
+{
+    bool retVal = false;
+
+    osFile cacheFile;
+
+    if (cacheFilePath.exists() && cacheFile.open(cacheFilePath, osChannel::OS_BINARY_CHANNEL, osFile::OS_OPEN_TO_READ))
+    {
+        // Every cached item takes at least one byte, so the file size bounds the amount of items in each vector:
+        unsigned long cacheFileSize = 0;
+        bool rcSz = cacheFile.getSize(cacheFileSize);
+        gtUInt32 maxItemsCount = (gtUInt32)cacheFileSize;
+
+        gtUInt32 fileMagic = 0;
+        gtUInt32 fileVersion = 0;
+
+        if (rcSz)
+        {
+            cacheFile >> fileMagic;
+            cacheFile >> fileVersion;
+        }
+
+        if ((CS_DWARF_CACHE_FILE_MAGIC == fileMagic) && (CS_DWARF_CACHE_FILE_VERSION == fileVersion))
+        {
+            gtInt32 dwarfAddressSize = -1;
+            cacheFile >> dwarfAddressSize;
+
+            // Read the program tree:
+            GT_ASSERT(_pCUProgram == NULL);
+            _pCUProgram = new csDWARFProgram;
+            bool goOn = readProgramFromChannel(cacheFile, *_pCUProgram, NULL, maxItemsCount);
+
+            // Read the address scope index. The scopes are identified by their index in the tree preorder:
+            gtVector<const csDWARFProgram*> programs;
+            listProgramsInPreorder(programs);
+            gtUInt32 numberOfScopeRanges = 0;
+            cacheFile >> numberOfScopeRanges;
+            goOn = goOn && (numberOfScopeRanges <= maxItemsCount);
+
+            for (gtUInt32 i = 0; goOn && (i < numberOfScopeRanges); i++)
+            {
+                AddressScopeRange scopeRange;
+                gtUInt32 scopeIndex = 0;
+                cacheFile >> scopeRange._startPC;
+                cacheFile >> scopeRange._endPC;
+                cacheFile >> scopeIndex;
+                goOn = (scopeIndex < (gtUInt32)programs.size());
+
+                if (goOn)
+                {
+                    scopeRange._pScope = programs[scopeIndex];
+                    _addressScopeIndex.push_back(scopeRange);
+                }
+            }
+
+            // Read the address to line index:
+            gtUInt32 numberOfAddressLines = 0;
+            cacheFile >> numberOfAddressLines;
+            goOn = goOn && (numberOfAddressLines <= maxItemsCount);
+
+            for (gtUInt32 i = 0; goOn && (i < numberOfAddressLines); i++)
+            {
+                AddressLine addressLine;
+                gtInt32 lineNumber = -1;
+                cacheFile >> addressLine._programCounter;
+                cacheFile >> addressLine._codeLocation._sourceFileFullPath;
+                cacheFile >> lineNumber;
+                addressLine._codeLocation._lineNumber = (int)lineNumber;
+                _addressLineIndex.push_back(addressLine);
+            }
+
+            // Read the line to addresses map:
+            gtUInt32 numberOfCodeLocations = 0;
+            cacheFile >> numberOfCodeLocations;
+            goOn = goOn && (numberOfCodeLocations <= maxItemsCount);
+
+            for (gtUInt32 i = 0; goOn && (i < numberOfCodeLocations); i++)
+            {
+                csDWARFCodeLocation codeLocation;
+                gtInt32 lineNumber = -1;
+                gtUInt32 numberOfPCs = 0;
+                cacheFile >> codeLocation._sourceFileFullPath;
+                cacheFile >> lineNumber;
+                cacheFile >> numberOfPCs;
+                codeLocation._lineNumber = (int)lineNumber;
+                goOn = (numberOfPCs <= maxItemsCount);
+
+                if (goOn)
+                {
+                    gtVector<csDwarfAddressType>& programCounters = _codeLocationToProgramCounters[codeLocation];
+
+                    for (gtUInt32 j = 0; j < numberOfPCs; j++)
+                    {
+                        csDwarfAddressType programCounter = 0;
+                        cacheFile >> programCounter;
+                        programCounters.push_back(programCounter);
+                    }
+                }
+            }
+
+            // Read the mapped addresses:
+            gtUInt32 numberOfMappedPCs = 0;
+            cacheFile >> numberOfMappedPCs;
+            goOn = goOn && (numberOfMappedPCs <= maxItemsCount);
+
+            for (gtUInt32 i = 0; goOn && (i < numberOfMappedPCs); i++)
+            {
+                csDwarfAddressType programCounter = 0;
+                cacheFile >> programCounter;
+                _programCountersMappedToLineNumbers.push_back(programCounter);
+            }
+
+            // A file that was not completely written will not end with the magic number:
+            gtUInt32 fileEndMagic = 0;
+
+            if (goOn)
+            {
+                cacheFile >> fileEndMagic;
+            }
+
+            retVal = (CS_DWARF_CACHE_FILE_MAGIC == fileEndMagic);
+
+            if (retVal)
+            {
+                m_dwarfAddressSize = (int)dwarfAddressSize;
+            }
+            else
+            {
+                // Discard any partially loaded information:
+                clearLineInformation();
+                _addressScopeIndex.clear();
+                delete _pCUProgram;
+                _pCUProgram = NULL;
+            }
+        }
+
+        cacheFile.close();
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        csDWARFParser::storeInCacheFile
+// Description: Writes the program tree, the line information and the address
+//              indices to a cache file, to be loaded by loadFromCacheFile.
+// Return Val:  bool - Success / failure.
+// ---------------------------------------------------------------------------
+bool csDWARFParser::storeInCacheFile(const osFilePath& cacheFilePath) const
+{
+    bool retVal = false;
+
+    osFile cacheFile;
+    GT_IF_WITH_ASSERT(_pCUProgram != NULL)
+    {
+        retVal = cacheFile.open(cacheFilePath, osChannel::OS_BINARY_CHANNEL, osFile::OS_OPEN_TO_WRITE);
+    }
+
+    if (retVal)
+    {
+        cacheFile << (gtUInt32)CS_DWARF_CACHE_FILE_MAGIC;
+        cacheFile << (gtUInt32)CS_DWARF_CACHE_FILE_VERSION;
+        cacheFile << (gtInt32)m_dwarfAddressSize;
+
+        // Write the program tree:
+        writeProgramToChannel(cacheFile, *_pCUProgram);
+
+        // Write the address scope index, identifying the scopes by their index in the tree preorder:
+        gtVector<const csDWARFProgram*> programs;
+        listProgramsInPreorder(programs);
+        gtMap<const csDWARFProgram*, gtUInt32> programIndices;
+        gtUInt32 numberOfPrograms = (gtUInt32)programs.size();
+
+        for (gtUInt32 i = 0; i < numberOfPrograms; i++)
+        {
+            programIndices[programs[i]] = i;
+        }
+
+        gtUInt32 numberOfScopeRanges = (gtUInt32)_addressScopeIndex.size();
+        cacheFile << numberOfScopeRanges;
+
+        for (gtUInt32 i = 0; i < numberOfScopeRanges; i++)
+        {
+            const AddressScopeRange& scopeRange = _addressScopeIndex[i];
+            cacheFile << scopeRange._startPC;
+            cacheFile << scopeRange._endPC;
+            cacheFile << programIndices[scopeRange._pScope];
+        }
+
+        // Write the address to line index:
+        gtUInt32 numberOfAddressLines = (gtUInt32)_addressLineIndex.size();
+        cacheFile << numberOfAddressLines;
+
+        for (gtUInt32 i = 0; i < numberOfAddressLines; i++)
+        {
+            const AddressLine& addressLine = _addressLineIndex[i];
+            cacheFile << addressLine._programCounter;
+            cacheFile << addressLine._codeLocation._sourceFileFullPath;
+            cacheFile << (gtInt32)addressLine._codeLocation._lineNumber;
+        }
+
+        // Write the line to addresses map:
+        cacheFile << (gtUInt32)_codeLocationToProgramCounters.size();
+        gtMap<csDWARFCodeLocation, gtVector<csDwarfAddressType> >::const_iterator endIter = _codeLocationToProgramCounters.end();
+
+        for (gtMap<csDWARFCodeLocation, gtVector<csDwarfAddressType> >::const_iterator iter = _codeLocationToProgramCounters.begin(); iter != endIter; ++iter)
+        {
+            const gtVector<csDwarfAddressType>& programCounters = (*iter).second;
+            gtUInt32 numberOfPCs = (gtUInt32)programCounters.size();
+            cacheFile << (*iter).first._sourceFileFullPath;
+            cacheFile << (gtInt32)(*iter).first._lineNumber;
+            cacheFile << numberOfPCs;
+
+            for (gtUInt32 j = 0; j < numberOfPCs; j++)
+            {
+                cacheFile << programCounters[j];
+            }
+        }
+
+        // Write the mapped addresses:
+        gtUInt32 numberOfMappedPCs = (gtUInt32)_programCountersMappedToLineNumbers.size();
+        cacheFile << numberOfMappedPCs;
+
+        for (gtUInt32 i = 0; i < numberOfMappedPCs; i++)
+        {
+            cacheFile << _programCountersMappedToLineNumbers[i];
+        }
+
+        // Mark the file as complete:
+        cacheFile << (gtUInt32)CS_DWARF_CACHE_FILE_MAGIC;
+
+        cacheFile.close();
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        csDWARFParser::writeProgramToChannel
+// Description: Recursively writes a program, its variables and its children
+// ---------------------------------------------------------------------------
+void csDWARFParser::writeProgramToChannel(osChannel& cacheChannel, const csDWARFProgram& programData)
+{
+    cacheChannel << programData._programName;
+    cacheChannel << (gtInt32)programData._programScopeType;
+    cacheChannel << programData._framePointerRegister;
+
+    gtUInt32 numberOfPCRanges = (gtUInt32)programData._programPCRanges.size();
+    cacheChannel << numberOfPCRanges;
+
+    for (gtUInt32 i = 0; i < numberOfPCRanges; i++)
+    {
+        cacheChannel << programData._programPCRanges[i]._startPC;
+        cacheChannel << programData._programPCRanges[i]._endPC;
+    }
+
+    gtUInt32 numberOfMappedPCs = (gtUInt32)programData._programMappedPCs.size();
+    cacheChannel << numberOfMappedPCs;
+
+    for (gtUInt32 i = 0; i < numberOfMappedPCs; i++)
+    {
+        cacheChannel << programData._programMappedPCs[i];
+    }
+
+    cacheChannel << programData._inlinedFunctionName;
+    cacheChannel << programData._inlinedFunctionCodeLocation._sourceFileFullPath;
+    cacheChannel << (gtInt32)programData._inlinedFunctionCodeLocation._lineNumber;
+
+    gtUInt32 numberOfVariables = (gtUInt32)programData._programVariables.size();
+    cacheChannel << numberOfVariables;
+
+    for (gtUInt32 i = 0; i < numberOfVariables; i++)
+    {
+        writeVariableToChannel(cacheChannel, *programData._programVariables[i]);
+    }
+
+    gtUInt32 numberOfChildren = (gtUInt32)programData._childPrograms.size();
+    cacheChannel << numberOfChildren;
+
+    for (gtUInt32 i = 0; i < numberOfChildren; i++)
+    {
+        writeProgramToChannel(cacheChannel, *programData._childPrograms[i]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        csDWARFParser::readProgramFromChannel
+// Description: Recursively reads a program written by writeProgramToChannel
+// Return Val:  bool - Success / failure.
+// ---------------------------------------------------------------------------
+bool csDWARFParser::readProgramFromChannel(osChannel& cacheChannel, csDWARFProgram& programData, csDWARFProgram* pParentProgram, gtUInt32 maxItemsCount)
+{
+    programData._pParentProgram = pParentProgram;
+
+    gtInt32 scopeType = (gtInt32)csDWARFProgram::CS_UNKNOWN_SCOPE;
+    cacheChannel >> programData._programName;
+    cacheChannel >> scopeType;
+    cacheChannel >> programData._framePointerRegister;
+    programData._programScopeType = (csDWARFProgram::ScopeType)scopeType;
+
+    gtUInt32 numberOfPCRanges = 0;
+    cacheChannel >> numberOfPCRanges;
+    bool retVal = (numberOfPCRanges <= maxItemsCount);
+
+    for (gtUInt32 i = 0; retVal && (i < numberOfPCRanges); i++)
+    {
+        csDWARFProgram::ProgramPCRange pcRange;
+        cacheChannel >> pcRange._startPC;
+        cacheChannel >> pcRange._endPC;
+        programData._programPCRanges.push_back(pcRange);
+    }
+
+    gtUInt32 numberOfMappedPCs = 0;
+
+    if (retVal)
+    {
+        cacheChannel >> numberOfMappedPCs;
+        retVal = (numberOfMappedPCs <= maxItemsCount);
+    }
+
+    for (gtUInt32 i = 0; retVal && (i < numberOfMappedPCs); i++)
+    {
+        csDwarfAddressType programCounter = 0;
+        cacheChannel >> programCounter;
+        programData._programMappedPCs.push_back(programCounter);
+    }
+
+    gtUInt32 numberOfVariables = 0;
+
+    if (retVal)
+    {
+        gtInt32 lineNumber = -1;
+        cacheChannel >> programData._inlinedFunctionName;
+        cacheChannel >> programData._inlinedFunctionCodeLocation._sourceFileFullPath;
+        cacheChannel >> lineNumber;
+        programData._inlinedFunctionCodeLocation._lineNumber = (int)lineNumber;
+
+        cacheChannel >> numberOfVariables;
+        retVal = (numberOfVariables <= maxItemsCount);
+    }
+
+    for (gtUInt32 i = 0; retVal && (i < numberOfVariables); i++)
+    {
+        csDWARFVariable* pVariable = new csDWARFVariable;
+        programData._programVariables.push_back(pVariable);
+        retVal = readVariableFromChannel(cacheChannel, *pVariable, maxItemsCount);
+    }
+
+    gtUInt32 numberOfChildren = 0;
+
+    if (retVal)
+    {
+        cacheChannel >> numberOfChildren;
+        retVal = (numberOfChildren <= maxItemsCount);
+    }
+
+    for (gtUInt32 i = 0; retVal && (i < numberOfChildren); i++)
+    {
+        csDWARFProgram* pChildProgram = new csDWARFProgram;
+        programData._childPrograms.push_back(pChildProgram);
+        retVal = readProgramFromChannel(cacheChannel, *pChildProgram, &programData, maxItemsCount);
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        csDWARFParser::writeVariableToChannel
+// Description: Recursively writes a variable and its members
+// ---------------------------------------------------------------------------
+void csDWARFParser::writeVariableToChannel(osChannel& cacheChannel, const csDWARFVariable& variableData)
+{
+    cacheChannel << variableData._variableName;
+    cacheChannel << (gtInt32)variableData._valueType;
+    cacheChannel << variableData._variableType;
+    cacheChannel << variableData._variableConstantValue;
+    cacheChannel << variableData._variableConstantValueExists;
+    cacheChannel << variableData._valueSize;
+
+    const csDWARFVariable::csDWARFVariableLocation& variableLocation = variableData._variableLocation;
+    cacheChannel << variableLocation._variableLocation;
+    cacheChannel << (gtInt32)variableLocation._variableLocationType;
+    cacheChannel << variableLocation._variableLocationOffset;
+    cacheChannel << variableLocation._variableLocationAccumulatedOffset;
+    cacheChannel << variableLocation._variableLocationResource;
+    cacheChannel << variableLocation._variableLowestPC;
+    cacheChannel << variableLocation._variableHighestPCValid;
+    cacheChannel << variableLocation._variableHighestPC;
+
+    cacheChannel << (gtInt32)variableData._valueEncoding;
+    cacheChannel << variableData._valueIsPointer;
+    cacheChannel << (gtInt32)variableData._valuePointerAddressSpace;
+    cacheChannel << variableData._valueIsArray;
+
+    gtUInt32 numberOfMembers = (gtUInt32)variableData._variableMembers.size();
+    cacheChannel << numberOfMembers;
+
+    for (gtUInt32 i = 0; i < numberOfMembers; i++)
+    {
+        writeVariableToChannel(cacheChannel, variableData._variableMembers[i]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        csDWARFParser::readVariableFromChannel
+// Description: Recursively reads a variable written by writeVariableToChannel
+// Return Val:  bool - Success / failure.
+// ---------------------------------------------------------------------------
+bool csDWARFParser::readVariableFromChannel(osChannel& cacheChannel, csDWARFVariable& variableData, gtUInt32 maxItemsCount)
+{
+    gtInt32 valueType = (gtInt32)csDWARFVariable::CS_UNKNOWN_VARIABLE_VALUE;
+    cacheChannel >> variableData._variableName;
+    cacheChannel >> valueType;
+    cacheChannel >> variableData._variableType;
+    cacheChannel >> variableData._variableConstantValue;
+    cacheChannel >> variableData._variableConstantValueExists;
+    cacheChannel >> variableData._valueSize;
+    variableData._valueType = (csDWARFVariable::ValueType)valueType;
+
+    csDWARFVariable::csDWARFVariableLocation& variableLocation = variableData._variableLocation;
+    gtInt32 locationType = (gtInt32)csDWARFVariable::CS_UNKNOWN_VARIABLE_LOCATION;
+    cacheChannel >> variableLocation._variableLocation;
+    cacheChannel >> locationType;
+    cacheChannel >> variableLocation._variableLocationOffset;
+    cacheChannel >> variableLocation._variableLocationAccumulatedOffset;
+    cacheChannel >> variableLocation._variableLocationResource;
+    cacheChannel >> variableLocation._variableLowestPC;
+    cacheChannel >> variableLocation._variableHighestPCValid;
+    cacheChannel >> variableLocation._variableHighestPC;
+    variableLocation._variableLocationType = (csDWARFVariable::ValueLocationType)locationType;
+
+    gtInt32 valueEncoding = (gtInt32)csDWARFVariable::CS_UNKNOWN_ENCODING;
+    gtInt32 pointerAddressSpace = (gtInt32)csDWARFVariable::CS_NOT_A_POINTER;
+    cacheChannel >> valueEncoding;
+    cacheChannel >> variableData._valueIsPointer;
+    cacheChannel >> pointerAddressSpace;
+    cacheChannel >> variableData._valueIsArray;
+    variableData._valueEncoding = (csDWARFVariable::ValueEncoding)valueEncoding;
+    variableData._valuePointerAddressSpace = (csDWARFVariable::PointerAddressSpace)pointerAddressSpace;
+
+    gtUInt32 numberOfMembers = 0;
+    cacheChannel >> numberOfMembers;
+    bool retVal = (numberOfMembers <= maxItemsCount);
+
+    if (retVal)
+    {
+        variableData._variableMembers.resize(numberOfMembers);
+
+        for (gtUInt32 i = 0; retVal && (i < numberOfMembers); i++)
+        {
+            retVal = readVariableFromChannel(cacheChannel, variableData._variableMembers[i], maxItemsCount);
+        }
+    }
+
+    return retVal;
+}
+
@@ -17,6 +17,8 @@ typedef struct _Dwarf_Debug* Dwarf_Debug;
 typedef struct _Dwarf_Die* Dwarf_Die;
 enum oaTexelDataFormat;
 enum oaDataType;
+class osChannel;
+class osFilePath;
 
 // Infra:
 #include <AMDTBaseTools/Include/AMDTDefinitions.h>
@@ -233,21 +235,53 @@ private:
     void typeNameAndDetailsFromTypeDIE(gtString& typeName, gtUInt32& typeSize, csDWARFVariable::ValueEncoding& typeEncoding, bool& isPointerType, bool& isArrayType, gtVector<csDWARFVariable>& typeMembers, bool expandIndirectMembers, gtUInt64 membersLocation, csDWARFVariable::ValueLocationType membersLocationType, gtUInt64 membersLocationResource, gtUInt32 membersAccumulatedOffset, Dwarf_Die typeDIE, bool isRegisterParamter);
     void clearLineInformation();
     csDWARFProgram* getAddressScope(csDwarfAddressType addr);
+    const csDWARFProgram* findAddressScopeInProgramTree(csDwarfAddressType addr) const;
+    void buildAddressScopeIndex();
+    void buildAddressLineIndex();
+    void listProgramsInPreorder(gtVector<const csDWARFProgram*>& programs) const;
 
     void addLeafMembersToVector(const csDWARFVariable& variableData, gtVector<gtString>& variableNames, gtString& namesBase);
 
+    // Debug information cache:
+    bool getCacheFilePath(osFilePath& cacheFilePath) const;
+    bool loadFromCacheFile(const osFilePath& cacheFilePath);
+    bool storeInCacheFile(const osFilePath& cacheFilePath) const;
+    static void writeProgramToChannel(osChannel& cacheChannel, const csDWARFProgram& programData);
+    static bool readProgramFromChannel(osChannel& cacheChannel, csDWARFProgram& programData, csDWARFProgram* pParentProgram, gtUInt32 maxItemsCount);
+    static void writeVariableToChannel(osChannel& cacheChannel, const csDWARFVariable& variableData);
+    static bool readVariableFromChannel(osChannel& cacheChannel, csDWARFVariable& variableData, gtUInt32 maxItemsCount);
+
 private:
+    // A range of addresses [_startPC, _endPC) whose smallest containing scope is _pScope:
+    struct AddressScopeRange
+    {
+        csDwarfAddressType _startPC;
+        csDwarfAddressType _endPC;
+        const csDWARFProgram* _pScope;
+    };
+
+    // An address mapped to a source line:
+    struct AddressLine
+    {
+        csDwarfAddressType _programCounter;
+        csDWARFCodeLocation _codeLocation;
+    };
+
     bool _isInitialized;
     const void* _binaryData;
     gtSize_t _binarySize;
     Elf* _pElf;
     Dwarf_Debug _pDwarf;
     gtString _firstSourceFileRealPath;
-    gtMap<csDwarfAddressType, csDWARFCodeLocation> _programCounterToCodeLocation;
+    gtMap<csDwarfAddressType, csDWARFCodeLocation> _programCounterToCodeLocation; // Only used while parsing, see _addressLineIndex
     gtMap<csDWARFCodeLocation, gtVector<csDwarfAddressType> > _codeLocationToProgramCounters;
     gtVector<csDwarfAddressType> _programCountersMappedToLineNumbers;
     csDWARFProgram* _pCUProgram;
     int m_dwarfAddressSize;
+
+    // Flattened lookup tables, sorted by address, which are built once per binary:
+    gtVector<AddressScopeRange> _addressScopeIndex;
+    gtVector<AddressLine> _addressLineIndex;
 };
 
 #endif //__CSDWARFPARSER_H
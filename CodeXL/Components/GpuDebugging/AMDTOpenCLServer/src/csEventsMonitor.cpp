@@ -29,7 +29,7 @@
 // Date:        22/8/2013
 // ---------------------------------------------------------------------------
 csEventsMonitor::csEventsMonitor(int controllingContextId)
-    : m_context(controllingContextId)
+    : m_context(controllingContextId), m_amountOfReleasedEvents(0)
 {
 
 }
@@ -44,6 +44,8 @@ csEventsMonitor::~csEventsMonitor()
 {
     osCriticalSectionLocker vectorAccessCSLocker(m_eventsVectorAccessCS);
     m_events.deleteElementsAndClear();
+    m_eventIndicesByHandle.clear();
+    m_amountOfReleasedEvents = 0;
 }
 
 // ---------------------------------------------------------------------------
@@ -97,6 +99,7 @@ void csEventsMonitor::onEventCreated(oaCLEventHandle hEvent, oaCLCommandQueueHan
 
             // Add it to the vector:
             m_events.push_back(pNewEvent);
+            m_eventIndicesByHandle[hEvent] = newEventIndex;
 
             // Register the event handle:
             csOpenCLHandleMonitor& handlesMonitor = cs_stat_openCLMonitorInstance.openCLHandleMonitor();
@@ -160,59 +163,29 @@ void csEventsMonitor::onEventMarkedForDeletion(oaCLEventHandle hEvent)
     osCriticalSectionLocker vectorAccessCSLocker(m_eventsVectorAccessCS);
 
     // Find the event in our vector:
-    int numberOfEvents = (int)m_events.size();
     csOpenCLHandleMonitor& handlesMonitor = cs_stat_openCLMonitorInstance.openCLHandleMonitor();
 
     apCLEvent* pFoundEvent = NULL;
+    int foundEventIndex = -1;
+    std::unordered_map<oaCLEventHandle, int>::iterator findIter = m_eventIndicesByHandle.find(hEvent);
 
-    for (int i = 0; i < numberOfEvents; i++)
+    if (m_eventIndicesByHandle.end() != findIter)
     {
-        if (NULL == pFoundEvent)
-        {
-            // Get the current event object:
-            apCLEvent* pCurrentEvent = m_events[i];
-            GT_IF_WITH_ASSERT(NULL != pCurrentEvent)
-            {
-                // If this is the event we're looking for:
-                if (hEvent == pCurrentEvent->eventHandle())
-                {
-                    // Mark that we found it:
-                    pFoundEvent = pCurrentEvent;
-                    m_events[i] = NULL;
-                }
-            }
-        }
-        else // NULL != pFoundEvent
-        {
-            // We already found the event, so i must be >= 1. Shift the current
-            // pointer one place back (so we can pop_back at the end):
-            m_events[i - 1] = m_events[i];
-
-            // Notify the handles monitor of this change:
-            oaCLEventHandle movedEventHandle = OA_CL_NULL_HANDLE;
-            int eventContextID = -1;
-            int queueIndex = -1;
-            apCLEvent* pMovedEvent = m_events[i - 1];
-            GT_IF_WITH_ASSERT(NULL != pMovedEvent)
-            {
-                movedEventHandle = pMovedEvent->eventHandle();
-                apCLObjectID* pEventHandleDetails = handlesMonitor.getCLHandleObjectDetails(movedEventHandle);
-                GT_IF_WITH_ASSERT(NULL != pEventHandleDetails)
-                {
-                    GT_IF_WITH_ASSERT(OS_TOBJ_ID_CL_EVENT == pEventHandleDetails->_objectType)
-                    {
-                        eventContextID = pEventHandleDetails->_contextId;
-                        queueIndex = pEventHandleDetails->_ownerObjectId;
-                    }
-                }
-            }
+        foundEventIndex = findIter->second;
+        m_eventIndicesByHandle.erase(findIter);
 
-            handlesMonitor.registerOpenCLHandle(movedEventHandle, eventContextID, i - 1, OS_TOBJ_ID_CL_EVENT, queueIndex, i);
+        GT_IF_WITH_ASSERT((-1 < foundEventIndex) && ((int)m_events.size() > foundEventIndex))
+        {
+            pFoundEvent = m_events[foundEventIndex];
         }
     }
 
     GT_IF_WITH_ASSERT(NULL != pFoundEvent)
     {
+        // Leave an empty slot in the event's place, so the other events keep their order and indices:
+        m_events[foundEventIndex] = NULL;
+        m_amountOfReleasedEvents++;
+
         // Notify the handles monitor of this change:
         oaCLEventHandle removedEventHandle = OA_CL_NULL_HANDLE;
         int eventContextID = -1;
@@ -251,9 +224,82 @@ void csEventsMonitor::onEventMarkedForDeletion(oaCLEventHandle hEvent)
             }
         }
 
-        // The last item in the vector will now be the found event or a duplicate pointer.
-        // Remove it either way:
-        m_events.pop_back();
+        // Remove the empty slots once they outnumber the events, so that each release costs
+        // a constant amount of moves on average:
+        if (m_amountOfReleasedEvents > amountOfEvents())
+        {
+            compactReleasedEvents();
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        csEventsMonitor::onDebuggedProcessSuspended
+// Description: Called before the debugged process is suspended. Removes the empty slots
+//              of released events, so that the events are queried by their indices.
+// ---------------------------------------------------------------------------
+void csEventsMonitor::onDebuggedProcessSuspended()
+{
+    osCriticalSectionLocker vectorAccessCSLocker(m_eventsVectorAccessCS);
+    compactReleasedEvents();
+}
+
+// ---------------------------------------------------------------------------
+// Name:        csEventsMonitor::compactReleasedEvents
+// Description: Removes the empty slots left by released events. The remaining events keep
+//              their order, and their handles are registered with their new indices.
+//              Should be called with m_eventsVectorAccessCS locked.
+// ---------------------------------------------------------------------------
+void csEventsMonitor::compactReleasedEvents()
+{
+    if (0 < m_amountOfReleasedEvents)
+    {
+        csOpenCLHandleMonitor& handlesMonitor = cs_stat_openCLMonitorInstance.openCLHandleMonitor();
+        int numberOfEvents = (int)m_events.size();
+        int nextEventIndex = 0;
+
+        for (int i = 0; i < numberOfEvents; i++)
+        {
+            apCLEvent* pCurrentEvent = m_events[i];
+
+            if (NULL != pCurrentEvent)
+            {
+                if (nextEventIndex < i)
+                {
+                    // Shift the current event back into the first empty slot:
+                    m_events[nextEventIndex] = pCurrentEvent;
+                    m_events[i] = NULL;
+
+                    // Notify the handles monitor of this change:
+                    oaCLEventHandle movedEventHandle = pCurrentEvent->eventHandle();
+                    int eventContextID = -1;
+                    int queueIndex = -1;
+                    m_eventIndicesByHandle[movedEventHandle] = nextEventIndex;
+
+                    apCLObjectID* pEventHandleDetails = handlesMonitor.getCLHandleObjectDetails(movedEventHandle);
+                    GT_IF_WITH_ASSERT(NULL != pEventHandleDetails)
+                    {
+                        GT_IF_WITH_ASSERT(OS_TOBJ_ID_CL_EVENT == pEventHandleDetails->_objectType)
+                        {
+                            eventContextID = pEventHandleDetails->_contextId;
+                            queueIndex = pEventHandleDetails->_ownerObjectId;
+                        }
+                    }
+
+                    handlesMonitor.registerOpenCLHandle(movedEventHandle, eventContextID, nextEventIndex, OS_TOBJ_ID_CL_EVENT, queueIndex, nextEventIndex + 1);
+                }
+
+                nextEventIndex++;
+            }
+        }
+
+        // The empty slots are now at the end of the vector:
+        while ((int)m_events.size() > nextEventIndex)
+        {
+            m_events.pop_back();
+        }
+
+        m_amountOfReleasedEvents = 0;
     }
 }
 
@@ -272,8 +318,10 @@ void csEventsMonitor::checkForReleasedEvents()
 
     for (int i = 0; i < numberOfEvents; i++)
     {
+        // Skip the empty slots of released events:
         const apCLEvent* pEvent = m_events[i];
-        GT_IF_WITH_ASSERT(NULL != pEvent)
+
+        if (NULL != pEvent)
         {
             eventHandles.push_back(pEvent->eventHandle());
         }
@@ -305,21 +353,13 @@ const apCLEvent* csEventsMonitor::eventDetails(oaCLEventHandle hEvent) const
     const apCLEvent* retVal = NULL;
 
     // Find the event in our vector:
-    int numberOfEvents = (int)m_events.size();
+    std::unordered_map<oaCLEventHandle, int>::const_iterator findIter = m_eventIndicesByHandle.find(hEvent);
 
-    for (int i = 0; i < numberOfEvents; i++)
+    if (m_eventIndicesByHandle.end() != findIter)
     {
-        // Get the current event object:
-        const apCLEvent* pCurrentEvent = m_events[i];
-        GT_IF_WITH_ASSERT(NULL != pCurrentEvent)
+        GT_IF_WITH_ASSERT((-1 < findIter->second) && ((int)m_events.size() > findIter->second))
         {
-            // If this is the event we're looking for:
-            if (hEvent == pCurrentEvent->eventHandle())
-            {
-                // Return it:
-                retVal = pCurrentEvent;
-                break;
-            }
+            retVal = m_events[findIter->second];
         }
     }
 
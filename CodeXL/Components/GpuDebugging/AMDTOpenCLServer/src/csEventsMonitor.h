@@ -15,6 +15,9 @@
 class apCLEnqueuedCommand;
 class csContextMonitor;
 
+// C++:
+#include <unordered_map>
+
 // Infra:
 #include <AMDTBaseTools/Include/gtAutoPtr.h>
 #include <AMDTBaseTools/Include/gtPtrVector.h>
@@ -43,17 +46,28 @@ public:
     // Reference count checking:
     void checkForReleasedEvents();
 
+    // Debugged process suspension:
+    void onDebuggedProcessSuspended();
+
     // Event info queries:
-    int amountOfEvents() const {return (int)m_events.size();};
+    int amountOfEvents() const {return (int)m_events.size() - m_amountOfReleasedEvents;};
     const apCLEvent* eventDetails(oaCLEventHandle hEvent) const;
     const apCLEvent* eventDetailsByIndex(int eventIndex) const;
 
+private:
+    void compactReleasedEvents();
+
 private:
     int m_context;
 
-    // The events monitored:
+    // The events monitored, in creation order. Released events leave NULL slots, which are
+    // removed (keeping the order) when they outnumber the events, and when the debugged process is suspended:
     gtPtrVector<apCLEvent*> m_events;
+    int m_amountOfReleasedEvents;
     osCriticalSection m_eventsVectorAccessCS;
+
+    // Maps each monitored event handle to its index in m_events:
+    std::unordered_map<oaCLEventHandle, int> m_eventIndicesByHandle;
 };
 
 
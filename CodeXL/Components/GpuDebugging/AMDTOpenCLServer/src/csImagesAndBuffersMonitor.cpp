@@ -35,6 +35,30 @@ typedef bool (* GSSHAREGLTEXTUREWITHCLIMAGEPROC)(int clImageIndex, int clImageNa
 typedef bool (* GSSHAREGLRENDERBUFFERWITHCLIMAGEPROC)(int clImageIndex, int clImageName, int clSpyID, int glSpyID, GLuint glRenderBufferName, gtString& detectedErrorStr);
 typedef bool (* GSSHAREGLVBOWITHCLBUFFERPROC)(int clBufferIndex, int bufferName, int clSpyID, int glSpyID, GLuint glVBOName, gtString& detectedErrorStr);
 
+// ---------------------------------------------------------------------------
+// Name:        csMemObjectVectorIndex
+// Description: Returns the index of a mem object in a monitors vector, or -1 if
+//              the vector does not contain it.
+// ---------------------------------------------------------------------------
+template <typename MemObjectType>
+static int csMemObjectVectorIndex(const gtPtrVector<MemObjectType*>& memObjectMonitors, const apCLMemObject* pMemObject)
+{
+    int retVal = -1;
+
+    int numberOfMemObjects = (int)memObjectMonitors.size();
+
+    for (int i = 0; i < numberOfMemObjects; i++)
+    {
+        if (pMemObject == memObjectMonitors[i])
+        {
+            retVal = i;
+            break;
+        }
+    }
+
+    return retVal;
+}
+
 // ---------------------------------------------------------------------------
 // Name:        csImagesAndBuffersMonitor::csImagesAndBuffersMonitor
 // Description: Constructor.
@@ -83,6 +107,7 @@ void csImagesAndBuffersMonitor::onBufferCreation(cl_mem bufferMemoryHandle, cl_m
 
     // Add the monitor to the vector of buffers:
     _bufferMonitors.push_back(pBufferObject);
+    m_memObjectsByHandle[pBufferObject->memObjectHandle()] = pBufferObject;
 
     // Get the handles monitor:
     csOpenCLHandleMonitor& handlesMonitor = cs_stat_openCLMonitorInstance.openCLHandleMonitor();
@@ -177,6 +202,7 @@ void csImagesAndBuffersMonitor::onSubBufferCreation(cl_mem subBufferMemoryHandle
 
         // Add the monitor to the vector of sub buffers:
         _subBufferMonitors.push_back(pSubBufferObject);
+        m_memObjectsByHandle[pSubBufferObject->memObjectHandle()] = pSubBufferObject;
 
         // Get the handles monitor:
         csOpenCLHandleMonitor& handlesMonitor = cs_stat_openCLMonitorInstance.openCLHandleMonitor();
@@ -230,6 +256,7 @@ void csImagesAndBuffersMonitor::onBufferCreationFromGLVBO(cl_mem bufferMemoryHan
 
     // Add the monitor to the vector of buffers:
     _bufferMonitors.push_back(pBufferObject);
+    m_memObjectsByHandle[pBufferObject->memObjectHandle()] = pBufferObject;
 
     // Get the handles monitor:
     csOpenCLHandleMonitor& handlesMonitor = cs_stat_openCLMonitorInstance.openCLHandleMonitor();
@@ -289,6 +316,7 @@ void csImagesAndBuffersMonitor::onBufferCreationFromDirectX(cl_mem bufferMemoryH
 
     // Add the monitor to the vector of buffers:
     _bufferMonitors.push_back(pBufferObject);
+    m_memObjectsByHandle[pBufferObject->memObjectHandle()] = pBufferObject;
 
     // Get the handles monitor:
     csOpenCLHandleMonitor& handlesMonitor = cs_stat_openCLMonitorInstance.openCLHandleMonitor();
@@ -328,6 +356,7 @@ void csImagesAndBuffersMonitor::onPipeCreation(cl_mem pipeMemoryHandle, cl_mem_f
 
     // Add the monitor to the vector of pipes:
     m_pipeMonitors.push_back(pPipeObject);
+    m_memObjectsByHandle[pPipeObject->memObjectHandle()] = pPipeObject;
 
     // Get the handles monitor:
     csOpenCLHandleMonitor& handlesMonitor = cs_stat_openCLMonitorInstance.openCLHandleMonitor();
@@ -472,7 +501,7 @@ bool csImagesAndBuffersMonitor::updateBufferRawData(int bufferIndex)
         {
             // Generate the buffer file name:
             osFilePath bufferFilePath;
-            generateRawDataFilePath(bufferIndex, bufferFilePath, true);
+            generateRawDataFilePath(bufferIndex, bufferFilePath, true, (gtUInt64)pBufferDetails->bufferSize());
 
             // Set the buffer file path:
             pBufferDetails->setBufferFilePath(bufferFilePath);
@@ -523,7 +552,8 @@ bool csImagesAndBuffersMonitor::updateSubBufferRawData(int subBufferId)
             {
                 // Generate the buffer file name:
                 osFilePath subBufferFilePath;
-                generateRawDataFilePath(subBufferId, subBufferFilePath, true);
+                // The sub-buffer is not larger than its owner buffer:
+                generateRawDataFilePath(subBufferId, subBufferFilePath, true, (gtUInt64)pBufferDetails->bufferSize());
 
                 // Set the buffer file path:
                 pSubBufferDetails->setSubBufferFilePath(subBufferFilePath);
@@ -623,113 +653,17 @@ const apCLMemObject* csImagesAndBuffersMonitor::getMemObjectDetails(oaCLMemHandl
 {
     const apCLMemObject* retVal = NULL;
 
-    bool foundLiving = false;
-
-    // Try to find this object in the buffers vector:
-    int numberOfBuffers = (int)_bufferMonitors.size();
-
-    for (int i = 0; i < numberOfBuffers; i++)
-    {
-        // Get the current buffer:
-        const apCLBuffer* pCurrentBuffer = _bufferMonitors[i];
-        GT_IF_WITH_ASSERT(pCurrentBuffer != NULL)
-        {
-            // If this is the requested mem object:
-            if (memObjHandle == pCurrentBuffer->memObjectHandle())
-            {
-                retVal = pCurrentBuffer;
-
-                if (!pCurrentBuffer->wasMarkedForDeletion())
-                {
-                    foundLiving = true;
-                    break;
-                }
-            }
-        }
-    }
+    // Find the object by its handle:
+    std::unordered_map<oaCLMemHandle, apCLMemObject*>::const_iterator findIter = m_memObjectsByHandle.find(memObjHandle);
 
-    if (!foundLiving)
+    if (m_memObjectsByHandle.end() != findIter)
     {
-        // Try to find this object in the sub buffers vector:
-        int numberOfSubBuffers = (int)_subBufferMonitors.size();
-
-        for (int i = 0; i < numberOfSubBuffers; i++)
-        {
-            // Get the current buffer:
-            const apCLSubBuffer* pCurrentSubBuffer = _subBufferMonitors[i];
-            GT_IF_WITH_ASSERT(pCurrentSubBuffer != NULL)
-            {
-                // If this is the requested mem object:
-                if (memObjHandle == pCurrentSubBuffer->memObjectHandle())
-                {
-                    retVal = pCurrentSubBuffer;
-
-                    if (!pCurrentSubBuffer->wasMarkedForDeletion())
-                    {
-                        foundLiving = true;
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
-    // If the object is not a buffer:
-    if (!foundLiving)
-    {
-        // Try to find this object in the textures vector:
-        int numberOfTextures = (int)_imagesMonitors.size();
-
-        for (int i = 0; i < numberOfTextures; i++)
-        {
-            // Get the current texture:
-            const apCLImage* pCurrentTexture = _imagesMonitors[i];
-            GT_IF_WITH_ASSERT(pCurrentTexture != NULL)
-            {
-                // If this is the requested mem object:
-                if (memObjHandle == pCurrentTexture->memObjectHandle())
-                {
-                    retVal = pCurrentTexture;
-
-                    if (!pCurrentTexture->wasMarkedForDeletion())
-                    {
-                        foundLiving = true;
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
-    // If the object is not a buffer nor an image:
-    if (!foundLiving)
-    {
-        // Try to find this object in the pipes vector:
-        int numberOfPipes = (int)m_pipeMonitors.size();
-
-        for (int i = 0; i < numberOfPipes; i++)
-        {
-            // Get the current pipe:
-            const apCLPipe* pCurrentPipe = m_pipeMonitors[i];
-            GT_IF_WITH_ASSERT(pCurrentPipe != NULL)
-            {
-                // If this is the requested mem object:
-                if (memObjHandle == pCurrentPipe->memObjectHandle())
-                {
-                    retVal = pCurrentPipe;
-
-                    if (!pCurrentPipe->wasMarkedForDeletion())
-                    {
-                        foundLiving = true;
-                        break;
-                    }
-                }
-            }
-        }
+        retVal = findIter->second;
     }
 
     return retVal;
 }
+
 // ---------------------------------------------------------------------------
 // Name:        csImagesAndBuffersMonitor::getMemObjectDetails
 // Description: Gets a mem object's mutable details by its handle. The returned
@@ -741,109 +675,12 @@ apCLMemObject* csImagesAndBuffersMonitor::getMemObjectDetails(oaCLMemHandle memO
 {
     apCLMemObject* retVal = NULL;
 
-    bool foundLiving = false;
-
-    // Try to find this object in the buffers vector:
-    int numberOfBuffers = (int)_bufferMonitors.size();
-
-    for (int i = 0; i < numberOfBuffers; i++)
-    {
-        // Get the current buffer:
-        apCLBuffer* pCurrentBuffer = _bufferMonitors[i];
-        GT_IF_WITH_ASSERT(pCurrentBuffer != NULL)
-        {
-            // If this is the requested mem object:
-            if (memObjHandle == pCurrentBuffer->memObjectHandle())
-            {
-                retVal = pCurrentBuffer;
-
-                if (!pCurrentBuffer->wasMarkedForDeletion())
-                {
-                    foundLiving = true;
-                    break;
-                }
-            }
-        }
-    }
-
-    if (!foundLiving)
-    {
-        // Try to find this object in the sub buffers vector:
-        int numberOfSubBuffers = (int)_subBufferMonitors.size();
-
-        for (int i = 0; i < numberOfSubBuffers; i++)
-        {
-            // Get the current buffer:
-            apCLSubBuffer* pCurrentSubBuffer = _subBufferMonitors[i];
-            GT_IF_WITH_ASSERT(pCurrentSubBuffer != NULL)
-            {
-                // If this is the requested mem object:
-                if (memObjHandle == pCurrentSubBuffer->memObjectHandle())
-                {
-                    retVal = pCurrentSubBuffer;
-
-                    if (!pCurrentSubBuffer->wasMarkedForDeletion())
-                    {
-                        foundLiving = true;
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
-    // If the object is not a buffer:
-    if (!foundLiving)
-    {
-        // Try to find this object in the textures vector:
-        int numberOfTextures = (int)_imagesMonitors.size();
-
-        for (int i = 0; i < numberOfTextures; i++)
-        {
-            // Get the current texture:
-            apCLImage* pCurrentTexture = _imagesMonitors[i];
-            GT_IF_WITH_ASSERT(pCurrentTexture != NULL)
-            {
-                // If this is the requested mem object:
-                if (memObjHandle == pCurrentTexture->memObjectHandle())
-                {
-                    retVal = pCurrentTexture;
-
-                    if (!pCurrentTexture->wasMarkedForDeletion())
-                    {
-                        foundLiving = true;
-                        break;
-                    }
-                }
-            }
-        }
-    }
+    // Find the object by its handle:
+    std::unordered_map<oaCLMemHandle, apCLMemObject*>::const_iterator findIter = m_memObjectsByHandle.find(memObjHandle);
 
-    // If the object is not a buffer nor an image:
-    if (!foundLiving)
+    if (m_memObjectsByHandle.end() != findIter)
     {
-        // Try to find this object in the pipes vector:
-        int numberOfPipes = (int)m_pipeMonitors.size();
-
-        for (int i = 0; i < numberOfPipes; i++)
-        {
-            // Get the current pipe:
-            apCLPipe* pCurrentPipe = m_pipeMonitors[i];
-            GT_IF_WITH_ASSERT(pCurrentPipe != NULL)
-            {
-                // If this is the requested mem object:
-                if (memObjHandle == pCurrentPipe->memObjectHandle())
-                {
-                    retVal = pCurrentPipe;
-
-                    if (!pCurrentPipe->wasMarkedForDeletion())
-                    {
-                        foundLiving = true;
-                        break;
-                    }
-                }
-            }
-        }
+        retVal = findIter->second;
     }
 
     return retVal;
@@ -861,113 +698,41 @@ apCLMemObject* csImagesAndBuffersMonitor::getMemObjectDetails(oaCLMemHandle memO
 {
     apCLMemObject* retVal = NULL;
 
-    bool foundLiving = false;
-
     memoryObjectIndex = -1;
-    // Try to find this object in the buffers vector:
-    int numberOfBuffers = (int)_bufferMonitors.size();
 
-    for (int i = 0; i < numberOfBuffers; i++)
-    {
-        // Get the current buffer:
-        apCLBuffer* pCurrentBuffer = _bufferMonitors[i];
-        GT_IF_WITH_ASSERT(pCurrentBuffer != NULL)
-        {
-            // If this is the requested mem object:
-            if (memObjHandle == pCurrentBuffer->memObjectHandle())
-            {
-                retVal = pCurrentBuffer;
-                memoryObjectIndex = i;
+    // Find the object by its handle:
+    std::unordered_map<oaCLMemHandle, apCLMemObject*>::const_iterator findIter = m_memObjectsByHandle.find(memObjHandle);
 
-                if (!pCurrentBuffer->wasMarkedForDeletion())
-                {
-                    foundLiving = true;
-                    break;
-                }
-            }
-        }
-    }
-
-    if (!foundLiving)
+    if (m_memObjectsByHandle.end() != findIter)
     {
-        // Try to find this object in the sub buffers vector:
-        int numberOfSubBuffers = (int)_subBufferMonitors.size();
-
-        for (int i = 0; i < numberOfSubBuffers; i++)
+        retVal = findIter->second;
+        GT_IF_WITH_ASSERT(NULL != retVal)
         {
-            // Get the current buffer:
-            apCLSubBuffer* pCurrentSubBuffer = _subBufferMonitors[i];
-            GT_IF_WITH_ASSERT(pCurrentSubBuffer != NULL)
+            // Find the object's index in the container matching its type:
+            switch (retVal->type())
             {
-                // If this is the requested mem object:
-                if (memObjHandle == pCurrentSubBuffer->memObjectHandle())
-                {
-                    retVal = pCurrentSubBuffer;
-                    memoryObjectIndex = i;
+                case OS_TOBJ_ID_CL_BUFFER:
+                    memoryObjectIndex = csMemObjectVectorIndex(_bufferMonitors, retVal);
+                    break;
 
-                    if (!pCurrentSubBuffer->wasMarkedForDeletion())
-                    {
-                        foundLiving = true;
-                        break;
-                    }
-                }
-            }
-        }
-    }
+                case OS_TOBJ_ID_CL_SUB_BUFFER:
+                    memoryObjectIndex = csMemObjectVectorIndex(_subBufferMonitors, retVal);
+                    break;
 
-    // If the object is not a buffer:
-    if (!foundLiving)
-    {
-        // Try to find this object in the textures vector:
-        int numberOfTextures = (int)_imagesMonitors.size();
+                case OS_TOBJ_ID_CL_IMAGE:
+                    memoryObjectIndex = csMemObjectVectorIndex(_imagesMonitors, retVal);
+                    break;
 
-        for (int i = 0; i < numberOfTextures; i++)
-        {
-            // Get the current texture:
-            apCLImage* pCurrentTexture = _imagesMonitors[i];
-            GT_IF_WITH_ASSERT(pCurrentTexture != NULL)
-            {
-                // If this is the requested mem object:
-                if (memObjHandle == pCurrentTexture->memObjectHandle())
-                {
-                    retVal = pCurrentTexture;
-                    memoryObjectIndex = i;
+                case OS_TOBJ_ID_CL_PIPE:
+                    memoryObjectIndex = csMemObjectVectorIndex(m_pipeMonitors, retVal);
+                    break;
 
-                    if (!pCurrentTexture->wasMarkedForDeletion())
-                    {
-                        foundLiving = true;
-                        break;
-                    }
-                }
+                default:
+                    GT_ASSERT(false);
+                    break;
             }
-        }
-    }
-
-    // If the object is not a buffer nor an image:
-    if (!foundLiving)
-    {
-        // Try to find this object in the pipes vector:
-        int numberOfPipes = (int)m_pipeMonitors.size();
 
-        for (int i = 0; i < numberOfPipes; i++)
-        {
-            // Get the current pipe:
-            apCLPipe* pCurrentPipe = m_pipeMonitors[i];
-            GT_IF_WITH_ASSERT(pCurrentPipe != NULL)
-            {
-                // If this is the requested mem object:
-                if (memObjHandle == pCurrentPipe->memObjectHandle())
-                {
-                    retVal = pCurrentPipe;
-                    memoryObjectIndex = i;
-
-                    if (!pCurrentPipe->wasMarkedForDeletion())
-                    {
-                        foundLiving = true;
-                        break;
-                    }
-                }
-            }
+            GT_ASSERT(-1 < memoryObjectIndex);
         }
     }
 
@@ -980,11 +745,12 @@ apCLMemObject* csImagesAndBuffersMonitor::getMemObjectDetails(oaCLMemHandle memO
 // Arguments: int bufferId
 //            osFilePath& bufferFilePath
 //            bool isBuffer - buffer / texture
+//            gtUInt64 rawDataFileSize - the size of the file about to be written (0 if unknown)
 // Return Val: void
 // Author:      Sigal Algranaty
 // Date:        2/12/2009
 // ---------------------------------------------------------------------------
-void csImagesAndBuffersMonitor::generateRawDataFilePath(int objectId, osFilePath& bufferFilePath, bool isBuffer) const
+void csImagesAndBuffersMonitor::generateRawDataFilePath(int objectId, osFilePath& bufferFilePath, bool isBuffer, gtUInt64 rawDataFileSize) const
 {
     // Build the log file name:
     gtString logFileName;
@@ -999,7 +765,7 @@ void csImagesAndBuffersMonitor::generateRawDataFilePath(int objectId, osFilePath
     }
 
     // Set the log file path:
-    bufferFilePath = suCurrentSessionLogFilesDirectory();
+    bufferFilePath = suCurrentSessionRawDataFilesDirectory(rawDataFileSize);
     bufferFilePath.setFileName(logFileName);
 
     // Set the log file extension:
@@ -1136,6 +902,7 @@ void csImagesAndBuffersMonitor::onImageCreation(cl_mem imageHandle, const cl_ima
 
     // Add the texture object:
     _imagesMonitors.push_back(pImageObject);
+    m_memObjectsByHandle[pImageObject->memObjectHandle()] = pImageObject;
 
     // Add the command queue handle:
     csOpenCLHandleMonitor& handlesMonitor = cs_stat_openCLMonitorInstance.openCLHandleMonitor();
@@ -1220,6 +987,7 @@ void csImagesAndBuffersMonitor::onImageCreation(cl_mem imageHandle, const cl_ima
 
             // Add the texture object:
             _imagesMonitors.push_back(pImageObject);
+            m_memObjectsByHandle[pImageObject->memObjectHandle()] = pImageObject;
 
             // Add the command queue handle:
             csOpenCLHandleMonitor& handlesMonitor = cs_stat_openCLMonitorInstance.openCLHandleMonitor();
@@ -1290,6 +1058,7 @@ void csImagesAndBuffersMonitor::onImageCreationFromGLTexture(cl_mem imageHandle,
 
     // Add the texture object:
     _imagesMonitors.push_back(pImageObject);
+    m_memObjectsByHandle[pImageObject->memObjectHandle()] = pImageObject;
 
     // Add the command queue handle:
     csOpenCLHandleMonitor& handlesMonitor = cs_stat_openCLMonitorInstance.openCLHandleMonitor();
@@ -1354,6 +1123,7 @@ void csImagesAndBuffersMonitor::onImageCreationFromGL2DTexture(cl_mem imageHandl
 
     // Add the texture object:
     _imagesMonitors.push_back(pImageObject);
+    m_memObjectsByHandle[pImageObject->memObjectHandle()] = pImageObject;
 
     // Add the command queue handle:
     csOpenCLHandleMonitor& handlesMonitor = cs_stat_openCLMonitorInstance.openCLHandleMonitor();
@@ -1420,6 +1190,7 @@ void csImagesAndBuffersMonitor::onTextureCreationFromGL3DTexture(cl_mem textureH
 
     // Add the texture object:
     _imagesMonitors.push_back(pImageObject);
+    m_memObjectsByHandle[pImageObject->memObjectHandle()] = pImageObject;
 
     // Add the command queue handle:
     csOpenCLHandleMonitor& handlesMonitor = cs_stat_openCLMonitorInstance.openCLHandleMonitor();
@@ -1485,6 +1256,7 @@ void csImagesAndBuffersMonitor::onTextureCreationFromGLRenderbuffer(cl_mem image
 
     // Add the image object:
     _imagesMonitors.push_back(pImageObject);
+    m_memObjectsByHandle[pImageObject->memObjectHandle()] = pImageObject;
 
     // Add the command queue handle:
     csOpenCLHandleMonitor& handlesMonitor = cs_stat_openCLMonitorInstance.openCLHandleMonitor();
@@ -1558,6 +1330,7 @@ void csImagesAndBuffersMonitor::onImageCreationFromDirectX(cl_mem textureHandle,
 
     // Add the texture object:
     _imagesMonitors.push_back(pImageObject);
+    m_memObjectsByHandle[pImageObject->memObjectHandle()] = pImageObject;
 
     // Add the command queue handle:
     csOpenCLHandleMonitor& handlesMonitor = cs_stat_openCLMonitorInstance.openCLHandleMonitor();
@@ -1597,6 +1370,9 @@ void csImagesAndBuffersMonitor::onMemObjectMarkedForDeletion(cl_mem memobj)
         // Mark it as deleted:
         pMemObj->onMemObjectMarkedForDeletion();
 
+        // The object is removed from its vector below, so stop mapping its handle:
+        m_memObjectsByHandle.erase(pMemObj->memObjectHandle());
+
         osTransferableObjectType memObjType = pMemObj->type();
 
         // If the object is a buffer:
@@ -2237,6 +2013,9 @@ bool csImagesAndBuffersMonitor::onMemoryObjectDeletion(cl_mem memobj)
     // mechanism (in OpenCL1.0 we simply count the object reference count) so the object might have been destructed already:
     if (pMemoryObject != NULL)
     {
+        // The object is removed from its vector below, so stop mapping its handle:
+        m_memObjectsByHandle.erase(pMemoryObject->memObjectHandle());
+
         // Get the memory object type:
         osTransferableObjectType memObjType = pMemoryObject->type();
 
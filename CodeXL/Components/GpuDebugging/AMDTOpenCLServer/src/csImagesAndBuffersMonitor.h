@@ -11,6 +11,9 @@
 #ifndef __CSIMAGESANDBUFFERSMONITOR_H
 #define __CSIMAGESANDBUFFERSMONITOR_H
 
+// C++:
+#include <unordered_map>
+
 // Infra:
 #include <AMDTBaseTools/Include/gtPtrVector.h>
 #include <AMDTOSWrappers/Include/osCriticalSection.h>
@@ -109,7 +112,7 @@ public:
 
 private:
     // Raw data file path:
-    void generateRawDataFilePath(int bufferId, osFilePath& bufferFilePath, bool isBuffer) const;
+    void generateRawDataFilePath(int bufferId, osFilePath& bufferFilePath, bool isBuffer, gtUInt64 rawDataFileSize = 0) const;
 
     // Command Queue:
     bool initializeCommandQueue();
@@ -158,6 +161,9 @@ private:
     // Maps pipe name to the pipe vector index:
     gtMap<int, int> m_pipeNameToIndexMap;
 
+    // Maps the handle of each monitored buffer, sub buffer, image and pipe to its object:
+    std::unordered_map<oaCLMemHandle, apCLMemObject*> m_memObjectsByHandle;
+
     // Get a command queue handle that is used for buffer reading:
     oaCLCommandQueueHandle _commandQueue;
 };
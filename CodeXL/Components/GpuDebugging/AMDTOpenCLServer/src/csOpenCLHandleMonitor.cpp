@@ -17,6 +17,9 @@
 // Local:
 #include <src/csOpenCLHandleMonitor.h>
 
+// The maximal amount of released objects kept in the handles map:
+#define CS_MAX_RELEASED_HANDLES_AMOUNT 16384
+
 
 // ---------------------------------------------------------------------------
 // Name:        csOpenCLHandleMonitor::csOpenCLHandleMonitor
@@ -40,8 +43,8 @@ csOpenCLHandleMonitor::~csOpenCLHandleMonitor()
     osCriticalSectionLocker mapCSLocker(m_clHandleObjectsMapAccessCS);
 
     // Clear the object IDs:
-    gtMap<oaCLHandle, apCLObjectID*>::iterator iter = _clHandleObjectsMap.begin();
-    gtMap<oaCLHandle, apCLObjectID*>::iterator endIter = _clHandleObjectsMap.end();
+    std::unordered_map<oaCLHandle, apCLObjectID*>::iterator iter = _clHandleObjectsMap.begin();
+    std::unordered_map<oaCLHandle, apCLObjectID*>::iterator endIter = _clHandleObjectsMap.end();
 
     for (; endIter != iter; iter++)
     {
@@ -68,7 +71,7 @@ apCLObjectID* csOpenCLHandleMonitor::getCLHandleObjectDetails(oaCLHandle ptr) co
     if (((osCriticalSection&)m_clHandleObjectsMapAccessCS).tryEntering())
     {
         // Find the handle within the map:
-        gtMap<oaCLHandle, apCLObjectID*>::const_iterator iterFind = _clHandleObjectsMap.find(ptr);
+        std::unordered_map<oaCLHandle, apCLObjectID*>::const_iterator iterFind = _clHandleObjectsMap.find(ptr);
 
         if (iterFind != _clHandleObjectsMap.end())
         {
@@ -101,6 +104,7 @@ void csOpenCLHandleMonitor::registerOpenCLHandle(oaCLHandle ptr, int contextId,
     osCriticalSectionLocker mapCSLocker(m_clHandleObjectsMapAccessCS);
 
     apCLObjectID* pNewObj = getCLHandleObjectDetails(ptr);
+    bool wasReleased = false;
 
     if (pNewObj == NULL)
     {
@@ -109,6 +113,10 @@ void csOpenCLHandleMonitor::registerOpenCLHandle(oaCLHandle ptr, int contextId,
         // Insert the new object to the map:
         _clHandleObjectsMap[ptr] = pNewObj;
     }
+    else
+    {
+        wasReleased = (pNewObj->_objectId == -1);
+    }
 
     // Set the object details:
     pNewObj->_contextId = contextId;
@@ -116,6 +124,27 @@ void csOpenCLHandleMonitor::registerOpenCLHandle(oaCLHandle ptr, int contextId,
     pNewObj->_objectType = objectType;
     pNewObj->_ownerObjectId = ownerObjectId;
     pNewObj->_objectDisplayName = objectDisplayId;
+
+    // If the object was released, forget the oldest released objects:
+    if ((objectId == -1) && !wasReleased)
+    {
+        m_releasedHandles.push(ptr);
+
+        while ((int)m_releasedHandles.size() > CS_MAX_RELEASED_HANDLES_AMOUNT)
+        {
+            oaCLHandle oldestReleasedHandle = m_releasedHandles.front();
+            m_releasedHandles.pop();
+
+            // The handle might have been reused by a living object since it was released:
+            std::unordered_map<oaCLHandle, apCLObjectID*>::iterator findIter = _clHandleObjectsMap.find(oldestReleasedHandle);
+
+            if ((findIter != _clHandleObjectsMap.end()) && (findIter->second->_objectId == -1))
+            {
+                delete findIter->second;
+                _clHandleObjectsMap.erase(findIter);
+            }
+        }
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -129,7 +158,7 @@ void csOpenCLHandleMonitor::nameHandledObject(oaCLHandle handle, const gtString&
 {
     osCriticalSectionLocker mapCSLocker(m_clHandleObjectsMapAccessCS);
 
-    gtMap<oaCLHandle, apCLObjectID*>::iterator findIter = _clHandleObjectsMap.find(handle);
+    std::unordered_map<oaCLHandle, apCLObjectID*>::iterator findIter = _clHandleObjectsMap.find(handle);
 
     if (findIter != _clHandleObjectsMap.end())
     {
@@ -11,8 +11,11 @@
 #ifndef __CSOPENCLHANDLEMONITOR_H
 #define __CSOPENCLHANDLEMONITOR_H
 
+// C++:
+#include <unordered_map>
+
 // Infra:
-#include <AMDTBaseTools/Include/gtMap.h>
+#include <AMDTBaseTools/Include/gtQueue.h>
 #include <AMDTOSWrappers/Include/osCriticalSection.h>
 #include <AMDTOSAPIWrappers/Include/oaOSAPIDefinitions.h>
 #include <AMDTAPIClasses/Include/apCLObjectID.h>
@@ -44,9 +47,14 @@ private:
     csOpenCLHandleMonitor(const csOpenCLHandleMonitor& otherMonitor) = delete;
     csOpenCLHandleMonitor(csOpenCLHandleMonitor&& otherMonitor) = delete;
 
-    // A vector containing devices objects:
-    gtMap<oaCLHandle, apCLObjectID*> _clHandleObjectsMap;
+    // Maps each OpenCL handle to its object details. This is looked up on every intercepted call,
+    // so we use a hash table rather than a sorted map:
+    std::unordered_map<oaCLHandle, apCLObjectID*> _clHandleObjectsMap;
     osCriticalSection m_clHandleObjectsMapAccessCS;
+
+    // The handles of released objects, oldest first. Released objects are kept in the map, so that calls made
+    // with their handles are still displayed with the objects names, but only the most recent ones are kept:
+    gtQueue<oaCLHandle> m_releasedHandles;
 };
 
 
@@ -61,6 +61,10 @@
 // Kernel debugging errors:
 #define CS_STR_CouldNotDebugKernelInvalidArgsDetails L"Tried to enqueue a kernel that uses unsupported argument types.\nDebugging kernels that use the following argument types is not supported:\n- SVM buffers (using clSetKernelArgSVMPointer)\n- SVM pointers (using clSetKernelExecInfo with CL_KERNEL_EXEC_INFO_SVM_PTRS)\n- Fine-grained system SVM (using clSetKernelExecInfo with CL_KERNEL_EXEC_INFO_SVM_FINE_GRAIN_SYSTEM)"
 
+// Kernel debugging information cache:
+#define CS_STR_DWARFCacheDirectoryName L"CodeXLKernelDebugInfoCache"
+#define CS_STR_DWARFCacheFileExtension L"cxldbg"
+
 // Other:
 #define CS_STR_OpenCLServerInitializedSuccessfully L"CodeXL OpenCL Server was initialized"
 #define CS_STR_OpenCLServerInitializationFailureMessage L"Error: CodeXL's OpenCL Server failed to initialize\nThe debugged application (%ls) will now exit"
@@ -3530,6 +3530,64 @@ bool gaGetCurrentFrameFunctionCallImpl(int contextId, int callIndex, gtAutoPtr<a
 }
 
 
+// ---------------------------------------------------------------------------
+// Name:        gaGetCurrentFrameFunctionCallsImpl
+// Description:
+//   Implementation of gaGetCurrentFrameFunctionCalls()
+//   Returns a contiguous range of the context logged function calls.
+// Arguments:   contextId - The queried context id.
+//              firstCallIndex - The index of the first returned call.
+//              callsAmount - The maximal amount of returned calls. Less calls are returned
+//                            when the range exceeds the logged calls.
+//              functionCalls - Will get the function calls.
+// Return Val:  bool - Success / failure.
+// ---------------------------------------------------------------------------
+bool gaGetCurrentFrameFunctionCallsImpl(int contextId, int firstCallIndex, int callsAmount, gtPtrVector<apFunctionCall*>& functionCalls)
+{
+    bool retVal = false;
+
+    // Get the appropriate context monitor:
+    const suContextMonitor* pContextMonitor = gsOpenGLMonitor::instance().contextMonitor(contextId);
+
+    if (pContextMonitor != NULL)
+    {
+        // Get its monitored functions calls logger:
+        const suCallsHistoryLogger* pCallsLogger = pContextMonitor->callsHistoryLogger();
+        GT_IF_WITH_ASSERT(pCallsLogger != NULL)
+        {
+            // Get the amount of function calls:
+            int amountOfFuncCalls = pCallsLogger->amountOfFunctionCalls();
+
+            // Verify that the first queried call is in the right range:
+            if ((0 <= firstCallIndex) && (firstCallIndex < amountOfFuncCalls) && (0 < callsAmount))
+            {
+                // Clip the range to the logged calls:
+                int endCallIndex = ((callsAmount < (amountOfFuncCalls - firstCallIndex)) ? (firstCallIndex + callsAmount) : amountOfFuncCalls);
+                retVal = true;
+
+                for (int i = firstCallIndex; i < endCallIndex; i++)
+                {
+                    // Get the current function call:
+                    gtAutoPtr<apFunctionCall> aptrFunctionCall;
+                    bool rcCall = pCallsLogger->getFunctionCall(i, aptrFunctionCall);
+
+                    if (!rcCall)
+                    {
+                        // Return the calls read so far:
+                        retVal = !functionCalls.empty();
+                        break;
+                    }
+
+                    functionCalls.push_back(aptrFunctionCall.releasePointedObjectOwnership());
+                }
+            }
+        }
+    }
+
+    return retVal;
+}
+
+
 // ---------------------------------------------------------------------------
 // Name:        gaGetCurrentFrameFunctionCallImpl
 // Description:
@@ -175,6 +175,7 @@ bool gaGetDisplayListObjectDetailsImpl(int contextId, GLuint displayListName, co
 // Monitored function calls logging:
 bool gaGetAmountOfCurrentFrameFunctionCallsImpl(int contextId, int& amountOfFunctionCalls);
 bool gaGetCurrentFrameFunctionCallImpl(int contextId, int callIndex, gtAutoPtr<apFunctionCall>& aptrFunctionCall);
+bool gaGetCurrentFrameFunctionCallsImpl(int contextId, int firstCallIndex, int callsAmount, gtPtrVector<apFunctionCall*>& functionCalls);
 bool gaGetCurrentFrameFunctionCallDeprecationDetailsImpl(int contextId, int callIndex, apFunctionDeprecation& functionCallDeprecation);
 bool gaGetLastFunctionCallImpl(int contextId, gtAutoPtr<apFunctionCall>& aptrFunctionCall);
 bool gaFindCurrentFrameFunctionCallImpl(int contextId, apSearchDirection searchDirection, int searchStartIndex, const gtString& searchedString, bool isCaseSensitiveSearch, int& foundIndex);
@@ -3532,7 +3532,8 @@ void gaGetAmountOfCurrentFrameFunctionCallsStub(osSocket& apiSocket)
 
 // ---------------------------------------------------------------------------
 // Name:        gaGetCurrentFrameFunctionCallStub
-// Description: Stub for gaGetAmountOfCurrentFrameFunctionCalls()
+// Description: Stub for gaGetCurrentFrameFunctionCall() and gaGetCurrentFrameFunctionCalls().
+//              The request holds a range of calls, which are returned in a single reply.
 // Author:      Yaki Tebeka
 // Date:        26/4/2004
 // ---------------------------------------------------------------------------
@@ -3542,22 +3543,33 @@ void gaGetCurrentFrameFunctionCallStub(osSocket& apiSocket)
     gtInt32 contextIdAsInt32 = -1;
     apiSocket >> contextIdAsInt32;
 
-    gtInt32 callIndexAsInt32 = -1;
-    apiSocket >> callIndexAsInt32;
+    gtInt32 firstCallIndexAsInt32 = -1;
+    apiSocket >> firstCallIndexAsInt32;
+
+    gtInt32 callsAmountAsInt32 = 0;
+    apiSocket >> callsAmountAsInt32;
 
     // Call the function implementation:
-    gtAutoPtr<apFunctionCall> aptrFunctionCall;
-    bool rc = gaGetCurrentFrameFunctionCallImpl((int)contextIdAsInt32, (int)callIndexAsInt32, aptrFunctionCall);
+    gtPtrVector<apFunctionCall*> functionCalls;
+    bool rc = gaGetCurrentFrameFunctionCallsImpl((int)contextIdAsInt32, (int)firstCallIndexAsInt32, (int)callsAmountAsInt32, functionCalls);
 
     // Return the return value:
     apiSocket << rc;
 
     if (rc)
     {
-        // Return the arguments that should be returned:
-        osTransferableObject* pFunctionCallAsTransferableObj = aptrFunctionCall.pointedObject();
-        apiSocket << *pFunctionCallAsTransferableObj;
+        // Return the function calls, in a single reply:
+        size_t returnedCallsAmount = functionCalls.size();
+        apiSocket << (gtInt32)returnedCallsAmount;
+
+        for (size_t i = 0; i < returnedCallsAmount; i++)
+        {
+            osTransferableObject* pFunctionCallAsTransferableObj = functionCalls[i];
+            apiSocket << *pFunctionCallAsTransferableObj;
+        }
     }
+
+    functionCalls.deleteElementsAndClear();
 }
 
 // ---------------------------------------------------------------------------
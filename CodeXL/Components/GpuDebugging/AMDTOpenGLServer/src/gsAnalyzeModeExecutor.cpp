@@ -25,8 +25,10 @@
 // Local:
 #include <src/gsAnalyzeModeExecutor.h>
 #include <src/gsGlobalVariables.h>
+#include <src/gsMonitoredFunctionPointers.h>
 #include <src/gsOpenGLMonitor.h>
 #include <src/gsStateChangeExecutor.h>
+#include <src/gsWrappersCommon.h>
 
 // Static vector initialization:
 bool* gsAnalyzeModeExecutor::_isFunctionSupportedInBeginEndBlock = NULL;
@@ -43,6 +45,10 @@ gsAnalyzeModeExecutor::gsAnalyzeModeExecutor()
       _pStateVaraiblesValues1(NULL),
       _pStateVaraiblesValues2(NULL),
       _lastComputedRedundancyStatus(AP_REDUNDANCY_UNKNOWN),
+      _isRedundancyStatusFromShadowState(false),
+      _isShadowStateResetRequested(false),
+      _hasUncheckedShadowStateChanges(false),
+      _nestedFunctionsEnteredCount(0),
       _wasCalledBeforeFunction(false)
 {
 }
@@ -495,12 +501,44 @@ void gsAnalyzeModeExecutor::addFunctionCall(apMonitoredFunctionId calledFunction
     {
         // Note that we were called before a function:
         _wasCalledBeforeFunction = true;
+        _isRedundancyStatusFromShadowState = false;
 
         // Make sure that we have a valid pointer to a render context monitor:
         GT_IF_WITH_ASSERT(_pRenderContextMonitor != NULL)
         {
-            // Initialize analyze mode settings:
-            startStateVariablesAnalyzeLogging(calledFunctionId);
+            // Try computing the redundancy status from the function arguments and the shadow state:
+            if (!_pRenderContextMonitor->isInOpenGLBeginEndBlock())
+            {
+                resetShadowStateIfNeeded();
+
+                // Before a draw call, make sure that the shadow state matches the state the draw call uses:
+                bool isDrawFunction = ((apMonitoredFunctionsManager::instance().monitoredFunctionType(calledFunctionId) & AP_DRAW_FUNC) != 0);
+
+                if (isDrawFunction)
+                {
+                    checkShadowStateOpenGLErrors();
+                }
+
+                apFunctionRedundancyStatus shadowStateRedundancyStatus = AP_REDUNDANCY_UNKNOWN;
+                _isRedundancyStatusFromShadowState = _shadowStateTracker.applyStateChange(calledFunctionId, argumentsAmount, pArgumentList, shadowStateRedundancyStatus);
+
+                if (_isRedundancyStatusFromShadowState)
+                {
+                    _lastComputedRedundancyStatus = shadowStateRedundancyStatus;
+                }
+
+                // A redundant function call does not change the shadow state, even if OpenGL ignores it:
+                if (shadowStateRedundancyStatus != AP_REDUNDANCY_REDUNDANT)
+                {
+                    _hasUncheckedShadowStateChanges = true;
+                }
+            }
+
+            // Initialize analyze mode settings (only needed when the shadow state could not be used):
+            if (!_isRedundancyStatusFromShadowState)
+            {
+                startStateVariablesAnalyzeLogging(calledFunctionId);
+            }
 
             // Get a snapshot of state variables that are relevant for function within begin-end block:
             if (calledFunctionId == ap_glBegin)
@@ -519,6 +557,128 @@ void gsAnalyzeModeExecutor::addFunctionCall(apMonitoredFunctionId calledFunction
             getRedundancyStatusWithinBeginEndBlock(calledFunctionId, argumentsAmount, pArgumentList);
         }
     }
+    else
+    {
+        // Function calls made outside analyze mode are not tracked, so the shadow state is no longer valid:
+        _shadowStateTracker.clear();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsAnalyzeModeExecutor::onDebuggedProcessExecutionModeChanged
+// Description: Is called when the debugged process execution mode is changed.
+//              Function calls are not reported to the executor outside analyze mode
+//              (and not at all in profile mode), so the shadow state has to be forgotten.
+//              This function is called from the API thread, so the shadow state is
+//              forgotten by the render context thread, on its next function call.
+// Return Val: void
+// ---------------------------------------------------------------------------
+void gsAnalyzeModeExecutor::onDebuggedProcessExecutionModeChanged()
+{
+    _isShadowStateResetRequested = true;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsAnalyzeModeExecutor::onUnloggedFunctionCall
+// Description: Is called for function calls that are not logged, since they are made
+//              while the context data snapshot is updated. Applies their state change
+//              on the shadow state, without computing a redundancy status.
+// Arguments: apMonitoredFunctionId calledFunctionId - the function call id
+//            int argumentsAmount - argument amount
+//            va_list& pArgumentList - the arguments list
+// Return Val: void
+// ---------------------------------------------------------------------------
+void gsAnalyzeModeExecutor::onUnloggedFunctionCall(apMonitoredFunctionId calledFunctionId, int argumentsAmount, va_list& pArgumentList)
+{
+    apExecutionMode executionMode = suDebuggedProcessExecutionMode();
+
+    if (executionMode == AP_ANALYZE_MODE)
+    {
+        resetShadowStateIfNeeded();
+
+        apFunctionRedundancyStatus ignoredRedundancyStatus = AP_REDUNDANCY_UNKNOWN;
+        _shadowStateTracker.applyStateChange(calledFunctionId, argumentsAmount, pArgumentList, ignoredRedundancyStatus);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsAnalyzeModeExecutor::resetShadowStateIfNeeded
+// Description: Forgets the shadow state if the execution mode was changed, or if
+//              nested functions (whose API calls are not reported) were entered since
+//              the shadow state was last used.
+// Return Val: void
+// ---------------------------------------------------------------------------
+void gsAnalyzeModeExecutor::resetShadowStateIfNeeded()
+{
+    unsigned int nestedFunctionsEnteredCount = su_stat_interoperabilityHelper.nestedFunctionsEnteredCount();
+
+    if (_isShadowStateResetRequested || (nestedFunctionsEnteredCount != _nestedFunctionsEnteredCount))
+    {
+        _shadowStateTracker.clear();
+        _isShadowStateResetRequested = false;
+        _nestedFunctionsEnteredCount = nestedFunctionsEnteredCount;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsAnalyzeModeExecutor::onFrameTerminatorCall
+// Description: Is called when a frame terminator function is called. Checks the
+//              function calls of the frame for OpenGL errors.
+// Return Val: void
+// ---------------------------------------------------------------------------
+void gsAnalyzeModeExecutor::onFrameTerminatorCall()
+{
+    apExecutionMode executionMode = suDebuggedProcessExecutionMode();
+
+    if (executionMode == AP_ANALYZE_MODE)
+    {
+        // Frame terminators are never called in a begin-end block:
+        checkShadowStateOpenGLErrors();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsAnalyzeModeExecutor::onOpenGLErrorRead
+// Description: Is called when an OpenGL error is read from OpenGL (by the spy or by the
+//              debugged application). An OpenGL error means that one of the function
+//              calls made since the last check was ignored by OpenGL (or that the state is
+//              undefined, after GL_OUT_OF_MEMORY). Since we do not know which function call
+//              raised the error, the shadow state is forgotten.
+// Arguments: GLenum openGLError - the read error, or GL_NO_ERROR.
+// Return Val: void
+// ---------------------------------------------------------------------------
+void gsAnalyzeModeExecutor::onOpenGLErrorRead(GLenum openGLError)
+{
+    if (_hasUncheckedShadowStateChanges && (openGLError != GL_NO_ERROR))
+    {
+        _shadowStateTracker.clear();
+    }
+
+    _hasUncheckedShadowStateChanges = false;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsAnalyzeModeExecutor::checkShadowStateOpenGLErrors
+// Description: Checks the function calls that set shadow values since the last check for
+//              OpenGL errors, with a single glGetError call. The error is kept, and is
+//              reported to the debugged application by its next glGetError call.
+//              Must not be called inside a begin-end block.
+// Return Val: void
+// ---------------------------------------------------------------------------
+void gsAnalyzeModeExecutor::checkShadowStateOpenGLErrors()
+{
+    if (_hasUncheckedShadowStateChanges)
+    {
+        GT_IF_WITH_ASSERT(_pRenderContextMonitor != NULL)
+        {
+            SU_BEFORE_EXECUTING_REAL_FUNCTION(ap_glGetError);
+            GLenum openGLError = gs_stat_realFunctionPointers.glGetError();
+            SU_AFTER_EXECUTING_REAL_FUNCTION(ap_glGetError);
+
+            _pRenderContextMonitor->addPendingOpenGLError(openGLError);
+            onOpenGLErrorRead(openGLError);
+        }
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -725,7 +885,13 @@ void gsAnalyzeModeExecutor::afterMonitoredFunctionExecutionActions(apMonitoredFu
                     isInBeginEndBlock = pCallsHistoryLogger->isInOpenGLBeginEndBlock();
                 }
 
-                if (!isInBeginEndBlock)
+                if (_isRedundancyStatusFromShadowState)
+                {
+                    // The redundancy status was computed from the shadow state before the function call (at addFunctionCall()).
+                    // OpenGL errors are checked later (see checkShadowStateOpenGLErrors()):
+                    redundancyStatus = _lastComputedRedundancyStatus;
+                }
+                else if (!isInBeginEndBlock)
                 {
                     // Take another snapshot after the function call;
                     bool rc = takeStateVariablesSnapshotForStateChangeFunctionCall(calledFunctionId, false);
@@ -779,6 +945,7 @@ void gsAnalyzeModeExecutor::afterMonitoredFunctionExecutionActions(apMonitoredFu
 
     // Mark that we were called after a function:
     _wasCalledBeforeFunction = false;
+    _isRedundancyStatusFromShadowState = false;
 }
 
 
@@ -13,12 +13,16 @@
 
 class gsRenderContextMonitor;
 
+// Standard C++:
+#include <atomic>
+
 // Infra:
 // Forward declaration;
 #include <AMDTAPIClasses/Include/apMonitoredFunctionId.h>
 #include <AMDTAPIClasses/Include/apFunctionType.h>
 
 // Local:
+#include <src/gsShadowStateTracker.h>
 #include <src/gsStateVariablesSnapshot.h>
 
 // ----------------------------------------------------------------------------------
@@ -40,8 +44,14 @@ public:
     bool initialize(gsRenderContextMonitor* pRenderContextMonitor);
     void onFirstTimeContextMadeCurrent();
     void afterMonitoredFunctionExecutionActions(apMonitoredFunctionId calledFunctionId);
+    void onDebuggedProcessExecutionModeChanged();
+    void onUnloggedFunctionCall(apMonitoredFunctionId calledFunctionId, int argumentsAmount, va_list& pArgumentList);
+    void onFrameTerminatorCall();
+    void onOpenGLErrorRead(GLenum openGLError);
 
 private:
+    void resetShadowStateIfNeeded();
+    void checkShadowStateOpenGLErrors();
     bool takeStateVariablesSnapshotForStateChangeFunctionCall(apMonitoredFunctionId calledFunctionId, bool beforeFunctionCall);
     void startStateVariablesAnalyzeLogging(apMonitoredFunctionId calledFunctionId);
 
@@ -95,9 +105,27 @@ private:
     // relevant state variables for function supported in begin-end block;
     gsStateVariablesSnapshot _glBeginStateVariableSnapShot;
 
+    // Shadow copy of the commonly changed state variables, used to compute the redundancy status of
+    // state change function calls without taking state variables snapshots:
+    gsShadowStateTracker _shadowStateTracker;
+
     // Redundancy status is computed inside begin end block before the function call, and used later after the function call:
     apFunctionRedundancyStatus _lastComputedRedundancyStatus;
 
+    // Contains true iff the redundancy status of the current function call was computed from the shadow state (before the function call):
+    bool _isRedundancyStatusFromShadowState;
+
+    // Contains true iff the shadow state should be forgotten before the next function call.
+    // (Set by the API thread when the execution mode is changed, and handled by the render context thread):
+    std::atomic<bool> _isShadowStateResetRequested;
+
+    // Contains true iff shadow values were set by function calls that were not checked for OpenGL errors yet.
+    // (OpenGL errors are checked once per draw call or frame, and not after every function call):
+    bool _hasUncheckedShadowStateChanges;
+
+    // The nested functions count (see suInteroperabilityHelper) when the shadow state was last used:
+    unsigned int _nestedFunctionsEnteredCount;
+
     // Used to avoid a bug where switching modes causes the first function to always be flagged as redundant:
     bool _wasCalledBeforeFunction;
 };
@@ -265,17 +265,20 @@ void gsOpenGLMonitor::afterBreakpointException(bool isInOpenGLBeginEndBlock)
 // ---------------------------------------------------------------------------
 void gsOpenGLMonitor::onDebuggedProcessExecutionModeChanged(apExecutionMode newExecutionMode)
 {
-    if (newExecutionMode == AP_PROFILING_MODE)
+    int amountOfContexts = (int)_contextsMonitors.size();
+
+    for (int i = 0; i < amountOfContexts; i++)
     {
-        // We just changed to Profile Mode, clear the calls statistics:
-        int amountOfContexts = (int)_contextsMonitors.size();
+        gsRenderContextMonitor* pContextMonitor = renderContextMonitor(i);
 
-        for (int i = 0; i < amountOfContexts; i++)
+        if (pContextMonitor != NULL)
         {
-            gsRenderContextMonitor* pContextMonitor = renderContextMonitor(i);
+            // Function calls are not analyzed outside analyze mode, so the analyzed state has to be forgotten:
+            pContextMonitor->onDebuggedProcessExecutionModeChanged();
 
-            if (pContextMonitor != NULL)
+            if (newExecutionMode == AP_PROFILING_MODE)
             {
+                // We just changed to Profile Mode, clear the calls statistics:
                 pContextMonitor->callsStatisticsLogger().clearFunctionCallsStatistics();
             }
         }
@@ -1165,6 +1168,19 @@ void gsOpenGLMonitor::addFunctionCall(apMonitoredFunctionId calledFunctionId, in
                 // Free the arguments list:
                 va_end(pCurrentArgument);
             }
+            else
+            {
+                // The function call is not logged, but it might still change the analyzed state:
+                gsRenderContextMonitor* pCurrentThreadRenderContextMonitor = currentThreadRenderContextMonitor();
+
+                if (pCurrentThreadRenderContextMonitor != NULL)
+                {
+                    va_list pCurrentArgument;
+                    va_start(pCurrentArgument, argumentsAmount);
+                    pCurrentThreadRenderContextMonitor->onUnloggedFunctionCall(calledFunctionId, argumentsAmount, pCurrentArgument);
+                    va_end(pCurrentArgument);
+                }
+            }
         }
     }
 
@@ -1809,7 +1825,7 @@ void gsOpenGLMonitor::testAndTriggerAfterFuncExecutionBreakpoints(apMonitoredFun
 
         if (currentContextId != AP_NULL_CONTEXT_ID)
         {
-            const gsRenderContextMonitor* pRenderContextMonitor = renderContextMonitor(currentContextId);
+            gsRenderContextMonitor* pRenderContextMonitor = renderContextMonitor(currentContextId);
             GT_IF_WITH_ASSERT(pRenderContextMonitor != NULL)
             {
                 // If the mode was just turned on, we need to wait for one more function call, so that the context won't
@@ -1833,10 +1849,8 @@ void gsOpenGLMonitor::testAndTriggerAfterFuncExecutionBreakpoints(apMonitoredFun
                     // (We are not allowed to call glGetError inside a glBegin glEnd block)
                     if (!isInOpenGLBeginEndBlock)
                     {
-                        // If there is an OpenGL error:
-                        SU_BEFORE_EXECUTING_REAL_FUNCTION(ap_glGetError);
-                        GLenum openGLError = gs_stat_realFunctionPointers.glGetError();
-                        SU_AFTER_EXECUTING_REAL_FUNCTION(ap_glGetError);
+                        // If there is an OpenGL error (including an error the analyze mode already read):
+                        GLenum openGLError = pRenderContextMonitor->getOpenGLError();
 
                         if (openGLError != GL_NO_ERROR)
                         {
@@ -2258,8 +2258,18 @@ GLenum APIENTRY glGetError(void)
         gs_stat_openGLMonitorInstance.addFunctionCall(ap_glGetError, 0);
     }
 
-    // Call the real function:
-    retVal = gs_stat_realFunctionPointers.glGetError();
+    // Get the error from the render context monitor, which also holds errors that were already read by the spy:
+    gsRenderContextMonitor* pCurrentThreadRenderContextMonitor = gs_stat_openGLMonitorInstance.currentThreadRenderContextMonitor();
+
+    if (pCurrentThreadRenderContextMonitor != NULL)
+    {
+        retVal = pCurrentThreadRenderContextMonitor->getOpenGLError();
+    }
+    else
+    {
+        // Call the real function:
+        retVal = gs_stat_realFunctionPointers.glGetError();
+    }
 
     SU_END_FUNCTION_WRAPPER(ap_glGetError);
 
@@ -139,7 +139,7 @@ bool gsPBuffer::generateBufferFilePath(apDisplayBuffer bufferType, osFilePath& b
         logFileName.appendFormattedString(GS_STR_pbufferFilePath, _pbufferRenderContextSpyId, _pbufferID, bufferNameCode.asCharArray());
 
         // Set the log file path:
-        bufferFilePath = suCurrentSessionLogFilesDirectory();
+        bufferFilePath = suCurrentSessionRawDataFilesDirectory();
 
         // Set the file name
         bufferFilePath.setFileName(logFileName);
@@ -0,0 +1,405 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file gsPixelsOrderReverser.cpp
+///
+//==================================================================================
+
+//------------------------------ gsPixelsOrderReverser.cpp ------------------------------
+
+// Standard C:
+#include <string.h>
+
+// SSE2 is used when it is available at compile time:
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define GS_PIXELS_ORDER_REVERSER_USE_SSE2
+    #include <emmintrin.h>
+#endif
+
+// AVX2 is compiled on x86 compilers that allow AVX2 functions in a non-AVX2 build, and is only used when the CPU supports it:
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)) && (_MSC_VER >= 1800)
+    #define GS_PIXELS_ORDER_REVERSER_USE_AVX2
+    #define GS_AVX2_FUNCTION
+    #include <intrin.h>
+    #include <immintrin.h>
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || (__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))
+    #define GS_PIXELS_ORDER_REVERSER_USE_AVX2
+    #define GS_AVX2_FUNCTION __attribute__((target("avx2")))
+    #include <immintrin.h>
+#endif
+
+// Infra:
+#include <AMDTBaseTools/Include/gtAssert.h>
+
+// Local:
+#include <src/gsPixelsOrderReverser.h>
+
+
+// A pixel of a size that has no matching integer type (e.g. RGB8, RGB32F or RGBA32F):
+template <int PixelSize>
+struct gsPixelBytes
+{
+    gtByte _bytes[PixelSize];
+};
+
+// ---------------------------------------------------------------------------
+// Name:        gsReversePixelsOrderOfType
+// Description: Reverses the order of pixels, in place, where the pixel size
+//              is the size of PixelType.
+//              The pixels are swapped from both ends of the buffer towards its middle,
+//              so both ends are read and written sequentially.
+// Arguments:   pPixels - The pixels buffer. Does not have to be aligned.
+//              amountOfPixels - The amount of pixels in the buffer.
+// ---------------------------------------------------------------------------
+template <typename PixelType>
+static void gsReversePixelsOrderOfType(gtByte* pPixels, size_t amountOfPixels)
+{
+    if (amountOfPixels > 1)
+    {
+        gtByte* pFront = pPixels;
+        gtByte* pBack = pPixels + ((amountOfPixels - 1) * sizeof(PixelType));
+
+        while (pFront < pBack)
+        {
+            PixelType frontPixel;
+            PixelType backPixel;
+            memcpy(&frontPixel, pFront, sizeof(PixelType));
+            memcpy(&backPixel, pBack, sizeof(PixelType));
+            memcpy(pFront, &backPixel, sizeof(PixelType));
+            memcpy(pBack, &frontPixel, sizeof(PixelType));
+
+            pFront += sizeof(PixelType);
+            pBack -= sizeof(PixelType);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsReversePixelsOrderGeneric
+// Description: Reverses the order of pixels of any size, in place.
+// Arguments:   pPixels - The pixels buffer.
+//              amountOfPixels - The amount of pixels in the buffer.
+//              pixelSize - The size of a pixel, in bytes.
+// ---------------------------------------------------------------------------
+static void gsReversePixelsOrderGeneric(gtByte* pPixels, size_t amountOfPixels, size_t pixelSize)
+{
+    if (amountOfPixels > 1)
+    {
+        gtByte* pFront = pPixels;
+        gtByte* pBack = pPixels + ((amountOfPixels - 1) * pixelSize);
+
+        while (pFront < pBack)
+        {
+            for (size_t i = 0; i < pixelSize; i++)
+            {
+                gtByte frontByte = pFront[i];
+                pFront[i] = pBack[i];
+                pBack[i] = frontByte;
+            }
+
+            pFront += pixelSize;
+            pBack -= pixelSize;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsReversePixelsOrderScalar
+// Description: Reverses the order of pixels, in place, without vector instructions.
+// Arguments:   pPixels - The pixels buffer.
+//              amountOfPixels - The amount of pixels in the buffer.
+//              pixelSize - The size of a pixel, in bytes.
+// ---------------------------------------------------------------------------
+static void gsReversePixelsOrderScalar(gtByte* pPixels, size_t amountOfPixels, size_t pixelSize)
+{
+    switch (pixelSize)
+    {
+        case 1:
+            gsReversePixelsOrderOfType<gtUByte>(pPixels, amountOfPixels);
+            break;
+
+        case 2:
+            gsReversePixelsOrderOfType<gtUInt16>(pPixels, amountOfPixels);
+            break;
+
+        case 3:
+            gsReversePixelsOrderOfType< gsPixelBytes<3> >(pPixels, amountOfPixels);
+            break;
+
+        case 4:
+            gsReversePixelsOrderOfType<gtUInt32>(pPixels, amountOfPixels);
+            break;
+
+        case 6:
+            gsReversePixelsOrderOfType< gsPixelBytes<6> >(pPixels, amountOfPixels);
+            break;
+
+        case 8:
+            gsReversePixelsOrderOfType<gtUInt64>(pPixels, amountOfPixels);
+            break;
+
+        case 12:
+            gsReversePixelsOrderOfType< gsPixelBytes<12> >(pPixels, amountOfPixels);
+            break;
+
+        case 16:
+            gsReversePixelsOrderOfType< gsPixelBytes<16> >(pPixels, amountOfPixels);
+            break;
+
+        default:
+            gsReversePixelsOrderGeneric(pPixels, amountOfPixels, pixelSize);
+            break;
+    }
+}
+
+#ifdef GS_PIXELS_ORDER_REVERSER_USE_SSE2
+// ---------------------------------------------------------------------------
+// Name:        gsReversePixelsOrderSSE2
+// Description: Reverses the order of 32 bit or 64 bit pixels, in place, 16 bytes at a time.
+//              The pixels left in the middle of the buffer are reversed by the scalar code.
+// Arguments:   pPixels - The pixels buffer. Does not have to be aligned.
+//              amountOfPixels - The amount of pixels in the buffer.
+// ---------------------------------------------------------------------------
+template <typename PixelType>
+static void gsReversePixelsOrderSSE2(gtByte* pPixels, size_t amountOfPixels)
+{
+    // The amount of pixels in a 16 bytes vector:
+    const size_t vectorPixels = 16 / sizeof(PixelType);
+
+    size_t front = 0;
+    size_t back = amountOfPixels;
+
+    while ((back - front) >= (2 * vectorPixels))
+    {
+        gtByte* pFront = pPixels + (front * sizeof(PixelType));
+        gtByte* pBack = pPixels + ((back - vectorPixels) * sizeof(PixelType));
+
+        __m128i frontVector = _mm_loadu_si128((const __m128i*)pFront);
+        __m128i backVector = _mm_loadu_si128((const __m128i*)pBack);
+
+        // Reverse the pixels inside each vector (0x1B reverses 4 dwords, 0x4E swaps 2 qwords):
+        if (sizeof(PixelType) == 4)
+        {
+            frontVector = _mm_shuffle_epi32(frontVector, 0x1B);
+            backVector = _mm_shuffle_epi32(backVector, 0x1B);
+        }
+        else
+        {
+            frontVector = _mm_shuffle_epi32(frontVector, 0x4E);
+            backVector = _mm_shuffle_epi32(backVector, 0x4E);
+        }
+
+        _mm_storeu_si128((__m128i*)pFront, backVector);
+        _mm_storeu_si128((__m128i*)pBack, frontVector);
+
+        front += vectorPixels;
+        back -= vectorPixels;
+    }
+
+    gsReversePixelsOrderOfType<PixelType>(pPixels + (front * sizeof(PixelType)), back - front);
+}
+#endif
+
+#ifdef GS_PIXELS_ORDER_REVERSER_USE_AVX2
+// ---------------------------------------------------------------------------
+// Name:        gsReversePixelsOrderAVX2
+// Description: Reverses the order of 32 bit or 64 bit pixels, in place, 32 bytes at a time.
+//              The pixels left in the middle of the buffer are reversed by the scalar code.
+//              Must only be called when the CPU supports AVX2.
+// Arguments:   pPixels - The pixels buffer. Does not have to be aligned.
+//              amountOfPixels - The amount of pixels in the buffer.
+//              pixelSize - 4 or 8.
+// ---------------------------------------------------------------------------
+GS_AVX2_FUNCTION static void gsReversePixelsOrderAVX2(gtByte* pPixels, size_t amountOfPixels, size_t pixelSize)
+{
+    // The amount of pixels in a 32 bytes vector:
+    const size_t vectorPixels = 32 / pixelSize;
+    const __m256i reversedDwordsIndices = _mm256_set_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    size_t front = 0;
+    size_t back = amountOfPixels;
+
+    while ((back - front) >= (2 * vectorPixels))
+    {
+        gtByte* pFront = pPixels + (front * pixelSize);
+        gtByte* pBack = pPixels + ((back - vectorPixels) * pixelSize);
+
+        __m256i frontVector = _mm256_loadu_si256((const __m256i*)pFront);
+        __m256i backVector = _mm256_loadu_si256((const __m256i*)pBack);
+
+        // Reverse the pixels inside each vector (across the two 128 bit lanes):
+        if (pixelSize == 4)
+        {
+            frontVector = _mm256_permutevar8x32_epi32(frontVector, reversedDwordsIndices);
+            backVector = _mm256_permutevar8x32_epi32(backVector, reversedDwordsIndices);
+        }
+        else
+        {
+            frontVector = _mm256_permute4x64_epi64(frontVector, 0x1B);
+            backVector = _mm256_permute4x64_epi64(backVector, 0x1B);
+        }
+
+        _mm256_storeu_si256((__m256i*)pFront, backVector);
+        _mm256_storeu_si256((__m256i*)pBack, frontVector);
+
+        front += vectorPixels;
+        back -= vectorPixels;
+    }
+
+    gsReversePixelsOrderScalar(pPixels + (front * pixelSize), back - front, pixelSize);
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsIsAVX2Supported
+// Description: Checks if the CPU and the operating system support AVX2.
+// Return Val:  bool - true iff AVX2 instructions can be executed.
+// ---------------------------------------------------------------------------
+static bool gsIsAVX2Supported()
+{
+    bool retVal = false;
+
+#if defined(_MSC_VER)
+    int cpuInfo[4] = { 0 };
+    __cpuid(cpuInfo, 0);
+
+    if (cpuInfo[0] >= 7)
+    {
+        // The OS must save the AVX registers (OSXSAVE and AVX bits, and the XMM and YMM state in XCR0):
+        __cpuid(cpuInfo, 1);
+        bool isAVXEnabled = ((cpuInfo[2] & (1 << 27)) != 0) && ((cpuInfo[2] & (1 << 28)) != 0) && ((_xgetbv(0) & 0x6) == 0x6);
+
+        __cpuidex(cpuInfo, 7, 0);
+        retVal = isAVXEnabled && ((cpuInfo[1] & (1 << 5)) != 0);
+    }
+
+#else
+    __builtin_cpu_init();
+    retVal = (__builtin_cpu_supports("avx2") != 0);
+#endif
+
+    return retVal;
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Name:        gsPixelsOrderReverser::reversePixelsOrder
+// Description: Reverses the order of pixels, in place, using the fastest
+//              implementation available for the pixel size.
+// Arguments:   pPixels - The pixels buffer.
+//              amountOfPixels - The amount of pixels in the buffer.
+//              pixelSize - The size of a pixel, in bytes.
+// ---------------------------------------------------------------------------
+void gsPixelsOrderReverser::reversePixelsOrder(gtByte* pPixels, size_t amountOfPixels, size_t pixelSize)
+{
+    static const Implementation stat_bestImplementation = bestImplementation();
+
+    bool rc = reversePixelsOrder(pPixels, amountOfPixels, pixelSize, stat_bestImplementation);
+    GT_ASSERT(rc);
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsPixelsOrderReverser::reversePixelsOrder
+// Description: Reverses the order of pixels, in place, using a given implementation.
+//              The vector implementations handle 32 and 64 bit pixels, and use the
+//              scalar implementation for other pixel sizes.
+// Arguments:   pPixels - The pixels buffer.
+//              amountOfPixels - The amount of pixels in the buffer.
+//              pixelSize - The size of a pixel, in bytes.
+//              implementation - The implementation to use.
+// Return Val:  bool - false iff the implementation is not available.
+// ---------------------------------------------------------------------------
+bool gsPixelsOrderReverser::reversePixelsOrder(gtByte* pPixels, size_t amountOfPixels, size_t pixelSize, Implementation implementation)
+{
+    bool retVal = isImplementationAvailable(implementation);
+
+    if (retVal)
+    {
+        bool isVectorPixelSize = ((pixelSize == 4) || (pixelSize == 8));
+
+        if (!isVectorPixelSize || (implementation == GS_PIXELS_REVERSAL_SCALAR))
+        {
+            gsReversePixelsOrderScalar(pPixels, amountOfPixels, pixelSize);
+        }
+
+#ifdef GS_PIXELS_ORDER_REVERSER_USE_AVX2
+        else if (implementation == GS_PIXELS_REVERSAL_AVX2)
+        {
+            gsReversePixelsOrderAVX2(pPixels, amountOfPixels, pixelSize);
+        }
+
+#endif
+#ifdef GS_PIXELS_ORDER_REVERSER_USE_SSE2
+        else if (pixelSize == 4)
+        {
+            gsReversePixelsOrderSSE2<gtUInt32>(pPixels, amountOfPixels);
+        }
+        else
+        {
+            gsReversePixelsOrderSSE2<gtUInt64>(pPixels, amountOfPixels);
+        }
+
+#endif
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsPixelsOrderReverser::isImplementationAvailable
+// Description: Checks if an implementation was compiled, and can run on this CPU.
+// Arguments:   implementation - The checked implementation.
+// Return Val:  bool - true iff the implementation can be used.
+// ---------------------------------------------------------------------------
+bool gsPixelsOrderReverser::isImplementationAvailable(Implementation implementation)
+{
+    bool retVal = false;
+
+    switch (implementation)
+    {
+        case GS_PIXELS_REVERSAL_SCALAR:
+            retVal = true;
+            break;
+
+        case GS_PIXELS_REVERSAL_SSE2:
+#ifdef GS_PIXELS_ORDER_REVERSER_USE_SSE2
+            retVal = true;
+#endif
+            break;
+
+        case GS_PIXELS_REVERSAL_AVX2:
+        {
+#ifdef GS_PIXELS_ORDER_REVERSER_USE_AVX2
+            static const bool stat_isAVX2Supported = gsIsAVX2Supported();
+            retVal = stat_isAVX2Supported;
+#endif
+        }
+        break;
+
+        default:
+            GT_ASSERT(false);
+            break;
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsPixelsOrderReverser::bestImplementation
+// Description: Returns the fastest implementation available on this CPU.
+// ---------------------------------------------------------------------------
+gsPixelsOrderReverser::Implementation gsPixelsOrderReverser::bestImplementation()
+{
+    Implementation retVal = GS_PIXELS_REVERSAL_SCALAR;
+
+    if (isImplementationAvailable(GS_PIXELS_REVERSAL_AVX2))
+    {
+        retVal = GS_PIXELS_REVERSAL_AVX2;
+    }
+    else if (isImplementationAvailable(GS_PIXELS_REVERSAL_SSE2))
+    {
+        retVal = GS_PIXELS_REVERSAL_SSE2;
+    }
+
+    return retVal;
+}
@@ -0,0 +1,48 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file gsPixelsOrderReverser.h
+///
+//==================================================================================
+
+//------------------------------ gsPixelsOrderReverser.h ------------------------------
+
+#ifndef __GSPIXELSORDERREVERSER_H
+#define __GSPIXELSORDERREVERSER_H
+
+// Standard C:
+#include <stddef.h>
+
+// Infra:
+#include <AMDTBaseTools/Include/AMDTDefinitions.h>
+
+// ----------------------------------------------------------------------------------
+// Class Name:           gsPixelsOrderReverser
+// General Description: Reverses the order of the pixels of a buffer, in place (used for
+//                      mirror flipping texture pages).
+//                      32 and 64 bit pixels are reversed with AVX2 when the CPU supports it
+//                      (checked at runtime), and with SSE2 when it is available at compile time.
+//                      Other pixel sizes are reversed by scalar code.
+// ----------------------------------------------------------------------------------
+class gsPixelsOrderReverser
+{
+public:
+    // The implementations of the pixels reversal:
+    enum Implementation
+    {
+        GS_PIXELS_REVERSAL_SCALAR,
+        GS_PIXELS_REVERSAL_SSE2,
+        GS_PIXELS_REVERSAL_AVX2
+    };
+
+    static void reversePixelsOrder(gtByte* pPixels, size_t amountOfPixels, size_t pixelSize);
+    static bool reversePixelsOrder(gtByte* pPixels, size_t amountOfPixels, size_t pixelSize, Implementation implementation);
+    static bool isImplementationAvailable(Implementation implementation);
+
+private:
+    static Implementation bestImplementation();
+};
+
+
+#endif //__GSPIXELSORDERREVERSER_H
@@ -432,7 +432,7 @@ void gsRenderBuffersMonitor::generateRenderBufferFilePath(GLuint bufferName, osF
     logFileName.appendFormattedString(GS_STR_renderBufferFilePath, _spyContextId, bufferName);
 
     // Set the log file path:
-    bufferFilePath = suCurrentSessionLogFilesDirectory();
+    bufferFilePath = suCurrentSessionRawDataFilesDirectory();
     bufferFilePath.setFileName(logFileName);
 
     // Set the log file extension:
@@ -633,6 +633,7 @@ void gsRenderContextMonitor::onFrameTerminatorCall()
     }
 
     _forcedModesManager.onFrameTerminatorCall();
+    _analyzeModeExecutor.onFrameTerminatorCall();
 
     // Some monitors are not relevant in Profile mode:
     apExecutionMode currentExecMode = suDebuggedProcessExecutionMode();
@@ -2165,9 +2166,7 @@ bool gsRenderContextMonitor::onProgramUsed(GLuint programName)
 void gsRenderContextMonitor::checkForOpenGLErrorAfterModeChange()
 {
     // If OpenGL recorded an error before we turned on the "Break on OpenGL errors" mode:
-    SU_BEFORE_EXECUTING_REAL_FUNCTION(ap_glGetError);
-    GLenum openGLError = gs_stat_realFunctionPointers.glGetError();
-    SU_AFTER_EXECUTING_REAL_FUNCTION(ap_glGetError);
+    GLenum openGLError = getOpenGLError();
 
     if (openGLError != GL_NO_ERROR)
     {
@@ -2179,6 +2178,61 @@ void gsRenderContextMonitor::checkForOpenGLErrorAfterModeChange()
     _shouldTestForOpenGLErrorsAtNextFunctionCall = false;
 }
 
+// ---------------------------------------------------------------------------
+// Name:        gsRenderContextMonitor::addPendingOpenGLError
+// Description: Keeps an OpenGL error that the spy read (and so cleared from OpenGL),
+//              to be reported by the next getOpenGLError() call.
+// Arguments: GLenum openGLError - the error, or GL_NO_ERROR.
+// ---------------------------------------------------------------------------
+void gsRenderContextMonitor::addPendingOpenGLError(GLenum openGLError)
+{
+    if (openGLError != GL_NO_ERROR)
+    {
+        // OpenGL records each error code once until it is read:
+        bool isPending = false;
+        int amountOfPendingErrors = (int)_pendingOpenGLErrors.size();
+
+        for (int i = 0; (i < amountOfPendingErrors) && !isPending; i++)
+        {
+            isPending = (_pendingOpenGLErrors[i] == openGLError);
+        }
+
+        if (!isPending)
+        {
+            _pendingOpenGLErrors.push_back(openGLError);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsRenderContextMonitor::getOpenGLError
+// Description: Reads the next OpenGL error: an error kept by addPendingOpenGLError()
+//              if there is one, and otherwise an error recorded by OpenGL.
+//              This function assumes the context is the current context.
+// Return Val: GLenum - the error, or GL_NO_ERROR.
+// ---------------------------------------------------------------------------
+GLenum gsRenderContextMonitor::getOpenGLError()
+{
+    GLenum retVal = GL_NO_ERROR;
+
+    if (!_pendingOpenGLErrors.empty())
+    {
+        retVal = _pendingOpenGLErrors[0];
+        _pendingOpenGLErrors.erase(_pendingOpenGLErrors.begin());
+    }
+    else
+    {
+        SU_BEFORE_EXECUTING_REAL_FUNCTION(ap_glGetError);
+        retVal = gs_stat_realFunctionPointers.glGetError();
+        SU_AFTER_EXECUTING_REAL_FUNCTION(ap_glGetError);
+
+        // Let the analyze mode know about errors it did not read itself:
+        _analyzeModeExecutor.onOpenGLErrorRead(retVal);
+    }
+
+    return retVal;
+}
+
 // ---------------------------------------------------------------------------
 // Name:        gsRenderContextMonitor::afterProgramRestoredFromStubFS
 // Description:
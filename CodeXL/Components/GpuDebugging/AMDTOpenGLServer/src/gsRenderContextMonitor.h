@@ -125,6 +125,10 @@ public:
     void onBreakOnOpenGLErrorModeChanged(bool breakOnGLErrors) { _shouldTestForOpenGLErrorsAtNextFunctionCall = breakOnGLErrors; };
     bool isOpenGLErrorCheckNeededOnModeTurnedOn() const { return _shouldTestForOpenGLErrorsAtNextFunctionCall; };
     void checkForOpenGLErrorAfterModeChange();
+    void addPendingOpenGLError(GLenum openGLError);
+    GLenum getOpenGLError();
+    void onDebuggedProcessExecutionModeChanged() { _analyzeModeExecutor.onDebuggedProcessExecutionModeChanged(); };
+    void onUnloggedFunctionCall(apMonitoredFunctionId calledFunctionId, int argumentsAmount, va_list& pArgumentList) { _analyzeModeExecutor.onUnloggedFunctionCall(calledFunctionId, argumentsAmount, pArgumentList); };
     bool afterProgramRestoredFromStubFS(GLuint programName);
     int openCLSharedContextID() const { return m_contextInfo.openCLSpyID(); };
     void setOpenCLSharedContextID(int clID) { m_contextInfo.setOpenCLSpyID(clID); };
@@ -460,6 +464,9 @@ private:
     // Contains true if we need to check for OpenGL errors that existed before turning on "Break on OpenGL Errors" mode:
     bool _shouldTestForOpenGLErrorsAtNextFunctionCall;
 
+    // OpenGL errors that were read by the spy, and were not reported to the debugged application yet:
+    gtVector<GLenum> _pendingOpenGLErrors;
+
     // Extension function pointer:
     PFNGLGETINTEGER64VPROC _glGetInteger64v;
 
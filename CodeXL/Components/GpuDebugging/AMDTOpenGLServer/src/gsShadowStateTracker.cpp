@@ -0,0 +1,664 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file gsShadowStateTracker.cpp
+///
+//==================================================================================
+
+//------------------------------ gsShadowStateTracker.cpp ------------------------------
+
+// Standard C:
+#include <stdarg.h>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtAssert.h>
+#include <AMDTAPIClasses/Include/apOpenGLParameters.h>
+
+// Local:
+#include <src/gsShadowStateTracker.h>
+
+// ---------------------------------------------------------------------------
+// Name:        gsShadowStateTracker::gsShadowStateTracker
+// Description: Constructor
+// ---------------------------------------------------------------------------
+gsShadowStateTracker::gsShadowStateTracker()
+    : _isCompilingDisplayList(false)
+{
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsShadowStateTracker::~gsShadowStateTracker
+// Description: Destructor
+// ---------------------------------------------------------------------------
+gsShadowStateTracker::~gsShadowStateTracker()
+{
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsShadowStateTracker::applyStateChange
+// Description: Is called before a function call is executed. Applies the state change
+//              of the function call on the shadow state, and computes its redundancy status
+//              by comparing the function arguments to the shadow values.
+//              Should be called for every function call, so that function calls that change
+//              the shadowed state indirectly would make it forget the relevant values.
+// Arguments: apMonitoredFunctionId calledFunctionId - the function id
+//            int argumentsAmount - the argument amount
+//            va_list& pArgumentList - the list of argument
+//            apFunctionRedundancyStatus& redundancyStatus - the function call redundancy status.
+// Return Val: bool  - true iff the redundancy status was computed. When false is returned, the caller
+//                     should compute the redundancy status by querying OpenGL.
+// ---------------------------------------------------------------------------
+bool gsShadowStateTracker::applyStateChange(apMonitoredFunctionId calledFunctionId, int argumentsAmount, va_list& pArgumentList, apFunctionRedundancyStatus& redundancyStatus)
+{
+    bool retVal = false;
+    redundancyStatus = AP_REDUNDANCY_UNKNOWN;
+
+    gtUInt64 changedKeys[GS_SHADOW_MAX_CHANGED_VALUES];
+    GLuint changedValues[GS_SHADOW_MAX_CHANGED_VALUES];
+    int changedValuesAmount = 0;
+
+    if (_isCompilingDisplayList)
+    {
+        // Function calls are compiled into the display list, and do not change the state:
+        if (calledFunctionId == ap_glEndList)
+        {
+            _isCompilingDisplayList = false;
+        }
+    }
+    else if (getStateChangeValues(calledFunctionId, argumentsAmount, pArgumentList, changedKeys, changedValues, changedValuesAmount))
+    {
+        // The function call is redundant iff all the values it sets are known, and equal to the set values:
+        bool areAllValuesKnown = true;
+        bool areValuesEqual = true;
+
+        for (int i = 0; i < changedValuesAmount; i++)
+        {
+            gtMap<gtUInt64, GLuint>::iterator findIter = _shadowValues.find(changedKeys[i]);
+
+            if (findIter != _shadowValues.end())
+            {
+                areValuesEqual = areValuesEqual && ((*findIter).second == changedValues[i]);
+                (*findIter).second = changedValues[i];
+            }
+            else
+            {
+                areAllValuesKnown = false;
+                _shadowValues[changedKeys[i]] = changedValues[i];
+            }
+        }
+
+        if (areAllValuesKnown)
+        {
+            redundancyStatus = areValuesEqual ? AP_REDUNDANCY_REDUNDANT : AP_REDUNDANCY_NOT_REDUNDANT;
+            retVal = true;
+        }
+
+        // The element array buffer binding is a part of the vertex array object state:
+        bool isVertexArrayBinding = ((calledFunctionId == ap_glBindVertexArray) || (calledFunctionId == ap_glBindVertexArrayAPPLE));
+
+        if (isVertexArrayBinding && (redundancyStatus != AP_REDUNDANCY_REDUNDANT))
+        {
+            _shadowValues.erase(stateKey(GS_SHADOW_BUFFER_BINDING, GL_ELEMENT_ARRAY_BUFFER));
+        }
+    }
+    else
+    {
+        onNonModeledFunctionCall(calledFunctionId, argumentsAmount, pArgumentList);
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsShadowStateTracker::clear
+// Description: Forgets all the shadow values. Should be called when function calls
+//              stop being reported (e.g. when leaving analyze mode).
+// ---------------------------------------------------------------------------
+void gsShadowStateTracker::clear()
+{
+    if (!_shadowValues.empty())
+    {
+        _shadowValues.clear();
+    }
+
+    _isCompilingDisplayList = false;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsShadowStateTracker::getStateChangeValues
+// Description: Translates a modeled state change function call into the state values it sets.
+// Arguments: apMonitoredFunctionId calledFunctionId - the function id
+//            int argumentsAmount - the argument amount
+//            va_list& pArgumentList - the list of argument
+//            gtUInt64* changedKeys - output - the keys of the set values
+//            GLuint* changedValues - output - the set values
+//            int& changedValuesAmount - output - the amount of set values
+// Return Val: bool  - true iff the function call is modeled.
+// ---------------------------------------------------------------------------
+bool gsShadowStateTracker::getStateChangeValues(apMonitoredFunctionId calledFunctionId, int argumentsAmount, va_list& pArgumentList, gtUInt64* changedKeys, GLuint* changedValues, int& changedValuesAmount)
+{
+    bool retVal = false;
+    changedValuesAmount = 0;
+
+    // Iterate on the argument list:
+    va_list pCurrentArgument;
+    va_copy(pCurrentArgument, pArgumentList);
+
+    switch (calledFunctionId)
+    {
+        case ap_glEnable:
+        case ap_glDisable:
+        {
+            GLenum capability = GL_NONE;
+
+            if ((argumentsAmount == 1) && readEnumArgument(pCurrentArgument, capability))
+            {
+                // Texturing capabilities are per texture unit:
+                if (isTextureUnitCapability(capability))
+                {
+                    retVal = getTextureUnitKey(GS_SHADOW_CAPABILITY, capability, changedKeys[0]);
+                }
+                else
+                {
+                    changedKeys[0] = stateKey(GS_SHADOW_CAPABILITY, capability);
+                    retVal = true;
+                }
+
+                changedValues[0] = (calledFunctionId == ap_glEnable) ? 1 : 0;
+                changedValuesAmount = 1;
+            }
+
+            break;
+        }
+
+        case ap_glBlendFunc:
+        {
+            GLenum sourceFactor = GL_NONE;
+            GLenum destinationFactor = GL_NONE;
+
+            if ((argumentsAmount == 2) && readEnumArgument(pCurrentArgument, sourceFactor) && readEnumArgument(pCurrentArgument, destinationFactor))
+            {
+                // glBlendFunc sets both the RGB and the alpha factors:
+                for (GLuint i = 0; i < 4; i++)
+                {
+                    changedKeys[i] = stateKey(GS_SHADOW_BLEND_FUNC, i);
+                    changedValues[i] = ((i % 2) == 0) ? sourceFactor : destinationFactor;
+                }
+
+                changedValuesAmount = 4;
+                retVal = true;
+            }
+
+            break;
+        }
+
+        case ap_glBlendFuncSeparate:
+        {
+            retVal = (argumentsAmount == 4);
+
+            for (GLuint i = 0; retVal && (i < 4); i++)
+            {
+                GLenum factor = GL_NONE;
+                retVal = readEnumArgument(pCurrentArgument, factor);
+                changedKeys[i] = stateKey(GS_SHADOW_BLEND_FUNC, i);
+                changedValues[i] = factor;
+            }
+
+            changedValuesAmount = 4;
+            break;
+        }
+
+        case ap_glBlendEquation:
+        case ap_glBlendEquationEXT:
+        {
+            GLenum mode = GL_NONE;
+
+            if ((argumentsAmount == 1) && readEnumArgument(pCurrentArgument, mode))
+            {
+                // glBlendEquation sets both the RGB and the alpha equations:
+                for (GLuint i = 0; i < 2; i++)
+                {
+                    changedKeys[i] = stateKey(GS_SHADOW_BLEND_EQUATION, i);
+                    changedValues[i] = mode;
+                }
+
+                changedValuesAmount = 2;
+                retVal = true;
+            }
+
+            break;
+        }
+
+        case ap_glBlendEquationSeparate:
+        {
+            retVal = (argumentsAmount == 2);
+
+            for (GLuint i = 0; retVal && (i < 2); i++)
+            {
+                GLenum mode = GL_NONE;
+                retVal = readEnumArgument(pCurrentArgument, mode);
+                changedKeys[i] = stateKey(GS_SHADOW_BLEND_EQUATION, i);
+                changedValues[i] = mode;
+            }
+
+            changedValuesAmount = 2;
+            break;
+        }
+
+        case ap_glDepthFunc:
+        case ap_glCullFace:
+        case ap_glFrontFace:
+        case ap_glShadeModel:
+        case ap_glActiveTexture:
+        case ap_glActiveTextureARB:
+        {
+            GLenum value = GL_NONE;
+
+            if ((argumentsAmount == 1) && readEnumArgument(pCurrentArgument, value))
+            {
+                gsShadowStateKind kind = GS_SHADOW_ACTIVE_TEXTURE;
+
+                switch (calledFunctionId)
+                {
+                    case ap_glDepthFunc: kind = GS_SHADOW_DEPTH_FUNC; break;
+
+                    case ap_glCullFace: kind = GS_SHADOW_CULL_FACE_MODE; break;
+
+                    case ap_glFrontFace: kind = GS_SHADOW_FRONT_FACE; break;
+
+                    case ap_glShadeModel: kind = GS_SHADOW_SHADE_MODEL; break;
+
+                    default: break;
+                }
+
+                changedKeys[0] = stateKey(kind, 0);
+                changedValues[0] = value;
+                changedValuesAmount = 1;
+
+                // An invalid texture unit does not change the active texture unit:
+                retVal = (kind != GS_SHADOW_ACTIVE_TEXTURE) || ((GL_TEXTURE0 <= value) && (value <= GL_TEXTURE0 + 0xFFFF));
+            }
+
+            break;
+        }
+
+        case ap_glDepthMask:
+        {
+            GLuint flag = 0;
+
+            if ((argumentsAmount == 1) && readBooleanArgument(pCurrentArgument, flag))
+            {
+                changedKeys[0] = stateKey(GS_SHADOW_DEPTH_MASK, 0);
+                changedValues[0] = flag;
+                changedValuesAmount = 1;
+                retVal = true;
+            }
+
+            break;
+        }
+
+        case ap_glBindTexture:
+        {
+            // Note that glBindTexture has a third pseudo parameter, holding the associated texture names:
+            GLenum target = GL_NONE;
+            GLuint texture = 0;
+
+            if ((argumentsAmount == 3) && readEnumArgument(pCurrentArgument, target) && readUIntArgument(pCurrentArgument, texture))
+            {
+                // Texture bindings are per texture unit:
+                retVal = getTextureUnitKey(GS_SHADOW_TEXTURE_BINDING, target, changedKeys[0]);
+                changedValues[0] = texture;
+                changedValuesAmount = 1;
+            }
+
+            break;
+        }
+
+        case ap_glUseProgram:
+        {
+            // Note that glUseProgram has a second pseudo parameter, holding the associated program name:
+            GLuint program = 0;
+
+            if ((argumentsAmount == 2) && readUIntArgument(pCurrentArgument, program))
+            {
+                changedKeys[0] = stateKey(GS_SHADOW_PROGRAM_BINDING, 0);
+                changedValues[0] = program;
+                changedValuesAmount = 1;
+                retVal = true;
+            }
+
+            break;
+        }
+
+        case ap_glBindBuffer:
+        case ap_glBindBufferARB:
+        {
+            GLenum target = GL_NONE;
+            GLuint buffer = 0;
+
+            if ((argumentsAmount == 2) && readEnumArgument(pCurrentArgument, target) && readUIntArgument(pCurrentArgument, buffer))
+            {
+                changedKeys[0] = stateKey(GS_SHADOW_BUFFER_BINDING, target);
+                changedValues[0] = buffer;
+                changedValuesAmount = 1;
+                retVal = true;
+            }
+
+            break;
+        }
+
+        case ap_glBindFramebuffer:
+        case ap_glBindFramebufferEXT:
+        {
+            GLenum target = GL_NONE;
+            GLuint framebuffer = 0;
+
+            if ((argumentsAmount == 2) && readEnumArgument(pCurrentArgument, target) && readUIntArgument(pCurrentArgument, framebuffer))
+            {
+                // GL_FRAMEBUFFER binds both the draw and the read framebuffers:
+                if ((target == GL_FRAMEBUFFER) || (target == GL_DRAW_FRAMEBUFFER))
+                {
+                    changedKeys[changedValuesAmount] = stateKey(GS_SHADOW_FRAMEBUFFER_BINDING, GL_DRAW_FRAMEBUFFER);
+                    changedValues[changedValuesAmount] = framebuffer;
+                    changedValuesAmount++;
+                }
+
+                if ((target == GL_FRAMEBUFFER) || (target == GL_READ_FRAMEBUFFER))
+                {
+                    changedKeys[changedValuesAmount] = stateKey(GS_SHADOW_FRAMEBUFFER_BINDING, GL_READ_FRAMEBUFFER);
+                    changedValues[changedValuesAmount] = framebuffer;
+                    changedValuesAmount++;
+                }
+
+                retVal = (changedValuesAmount > 0);
+            }
+
+            break;
+        }
+
+        case ap_glBindVertexArray:
+        case ap_glBindVertexArrayAPPLE:
+        {
+            GLuint vertexArray = 0;
+
+            if ((argumentsAmount == 1) && readUIntArgument(pCurrentArgument, vertexArray))
+            {
+                changedKeys[0] = stateKey(GS_SHADOW_VERTEX_ARRAY_BINDING, 0);
+                changedValues[0] = vertexArray;
+                changedValuesAmount = 1;
+                retVal = true;
+            }
+
+            break;
+        }
+
+        default:
+        {
+            // This function is not modeled:
+            retVal = false;
+            break;
+        }
+    }
+
+    // Free the arguments pointer:
+    va_end(pCurrentArgument);
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsShadowStateTracker::onNonModeledFunctionCall
+// Description: Forgets the shadow values that a non-modeled function call might change.
+// Arguments: apMonitoredFunctionId calledFunctionId - the function id
+//            int argumentsAmount - the argument amount
+//            va_list& pArgumentList - the list of argument
+// ---------------------------------------------------------------------------
+void gsShadowStateTracker::onNonModeledFunctionCall(apMonitoredFunctionId calledFunctionId, int argumentsAmount, va_list& pArgumentList)
+{
+    // Iterate on the argument list:
+    va_list pCurrentArgument;
+    va_copy(pCurrentArgument, pArgumentList);
+
+    switch (calledFunctionId)
+    {
+        case ap_glPopAttrib:
+        case ap_glPopClientAttrib:
+        case ap_glCallList:
+        case ap_glCallLists:
+        {
+            // These functions may change any part of the state:
+            clear();
+            break;
+        }
+
+        case ap_glNewList:
+        {
+            GLuint list = 0;
+            GLenum mode = GL_NONE;
+
+            if ((argumentsAmount == 2) && readUIntArgument(pCurrentArgument, list) && readEnumArgument(pCurrentArgument, mode))
+            {
+                // In GL_COMPILE_AND_EXECUTE mode, the function calls are also executed:
+                _isCompilingDisplayList = (mode == GL_COMPILE);
+            }
+
+            break;
+        }
+
+        case ap_glActiveTexture:
+        case ap_glActiveTextureARB:
+        {
+            // An invalid texture unit was set. The values of the texture units themselves are still valid:
+            _shadowValues.erase(stateKey(GS_SHADOW_ACTIVE_TEXTURE, 0));
+            break;
+        }
+
+        case ap_glEnablei:
+        case ap_glDisablei:
+        {
+            // Indexed capabilities are not modeled, but they change the non-indexed value:
+            GLenum capability = GL_NONE;
+
+            if (readEnumArgument(pCurrentArgument, capability))
+            {
+                _shadowValues.erase(stateKey(GS_SHADOW_CAPABILITY, capability));
+            }
+
+            break;
+        }
+
+        case ap_glBlendFunci:
+        case ap_glBlendFuncSeparatei:
+        {
+            forgetStateValues(GS_SHADOW_BLEND_FUNC);
+            break;
+        }
+
+        case ap_glBlendEquationi:
+        case ap_glBlendEquationSeparatei:
+        {
+            forgetStateValues(GS_SHADOW_BLEND_EQUATION);
+            break;
+        }
+
+        case ap_glDeleteTextures:
+        case ap_glBindTextures:
+        case ap_glBindTextureUnit:
+        case ap_glBindMultiTextureEXT:
+        {
+            // Deleting a bound texture reverts its binding to 0. The other functions bind textures to explicit units:
+            forgetStateValues(GS_SHADOW_TEXTURE_BINDING);
+            break;
+        }
+
+        case ap_glDeleteBuffers:
+        case ap_glDeleteBuffersARB:
+        case ap_glBindBufferBase:
+        case ap_glBindBufferRange:
+        case ap_glBindBuffersBase:
+        case ap_glBindBuffersRange:
+        {
+            // Deleting a bound buffer reverts its binding to 0. The other functions also change the generic buffer binding:
+            forgetStateValues(GS_SHADOW_BUFFER_BINDING);
+            break;
+        }
+
+        case ap_glDeleteFramebuffers:
+        case ap_glDeleteFramebuffersEXT:
+        {
+            forgetStateValues(GS_SHADOW_FRAMEBUFFER_BINDING);
+            break;
+        }
+
+        case ap_glDeleteVertexArrays:
+        {
+            forgetStateValues(GS_SHADOW_VERTEX_ARRAY_BINDING);
+            _shadowValues.erase(stateKey(GS_SHADOW_BUFFER_BINDING, GL_ELEMENT_ARRAY_BUFFER));
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    // Free the arguments pointer:
+    va_end(pCurrentArgument);
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsShadowStateTracker::getTextureUnitKey
+// Description: Gets the key of a state value of the active texture unit.
+// Arguments: gsShadowStateKind kind - the state value kind
+//            GLuint subKey - the state value sub key
+//            gtUInt64& key - output - the state value key
+// Return Val: bool  - true iff the active texture unit is known.
+// ---------------------------------------------------------------------------
+bool gsShadowStateTracker::getTextureUnitKey(gsShadowStateKind kind, GLuint subKey, gtUInt64& key) const
+{
+    bool retVal = false;
+
+    gtMap<gtUInt64, GLuint>::const_iterator findIter = _shadowValues.find(stateKey(GS_SHADOW_ACTIVE_TEXTURE, 0));
+
+    if (findIter != _shadowValues.end())
+    {
+        key = stateKey(kind, subKey, (*findIter).second - GL_TEXTURE0);
+        retVal = true;
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsShadowStateTracker::forgetStateValues
+// Description: Forgets all the shadow values of a given kind.
+// Arguments: gsShadowStateKind kind - the state value kind
+// ---------------------------------------------------------------------------
+void gsShadowStateTracker::forgetStateValues(gsShadowStateKind kind)
+{
+    // The keys of each kind are adjacent in the map:
+    gtMap<gtUInt64, GLuint>::iterator beginIter = _shadowValues.lower_bound(stateKey(kind, 0));
+    gtMap<gtUInt64, GLuint>::iterator endIter = _shadowValues.lower_bound(stateKey((gsShadowStateKind)(kind + 1), 0));
+    _shadowValues.erase(beginIter, endIter);
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsShadowStateTracker::stateKey
+// Description: Builds the key of a shadowed state value.
+// Arguments: gsShadowStateKind kind - the state value kind
+//            GLuint subKey - the state value sub key (e.g. the capability or the binding target)
+//            GLuint textureUnit - the texture unit, for per texture unit state values
+// Return Val: gtUInt64  - The key.
+// ---------------------------------------------------------------------------
+gtUInt64 gsShadowStateTracker::stateKey(gsShadowStateKind kind, GLuint subKey, GLuint textureUnit)
+{
+    return ((gtUInt64)kind << 48) | ((gtUInt64)(textureUnit & 0xFFFF) << 32) | (gtUInt64)subKey;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsShadowStateTracker::isTextureUnitCapability
+// Description: Returns true iff the input capability is a per texture unit capability.
+// ---------------------------------------------------------------------------
+bool gsShadowStateTracker::isTextureUnitCapability(GLenum capability)
+{
+    bool retVal = false;
+
+    switch (capability)
+    {
+        case GL_TEXTURE_1D:
+        case GL_TEXTURE_2D:
+        case GL_TEXTURE_3D:
+        case GL_TEXTURE_CUBE_MAP:
+        case GL_TEXTURE_RECTANGLE_ARB:
+        case GL_TEXTURE_GEN_S:
+        case GL_TEXTURE_GEN_T:
+        case GL_TEXTURE_GEN_R:
+        case GL_TEXTURE_GEN_Q:
+            retVal = true;
+            break;
+
+        default:
+            retVal = false;
+            break;
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsShadowStateTracker::readEnumArgument
+// Description: Reads a GLenum argument from the arguments list.
+// Return Val: bool  - Success / failure.
+// ---------------------------------------------------------------------------
+bool gsShadowStateTracker::readEnumArgument(va_list& pCurrentArgument, GLenum& argumentValue)
+{
+    bool retVal = false;
+
+    osTransferableObjectType argumentType = (osTransferableObjectType)(va_arg(pCurrentArgument , int));
+    GT_IF_WITH_ASSERT(argumentType == OS_TOBJ_ID_GL_ENUM_PARAMETER)
+    {
+        argumentValue = (GLenum)(va_arg(pCurrentArgument , unsigned long));
+        retVal = true;
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsShadowStateTracker::readUIntArgument
+// Description: Reads a GLuint argument from the arguments list.
+// Return Val: bool  - Success / failure.
+// ---------------------------------------------------------------------------
+bool gsShadowStateTracker::readUIntArgument(va_list& pCurrentArgument, GLuint& argumentValue)
+{
+    bool retVal = false;
+
+    osTransferableObjectType argumentType = (osTransferableObjectType)(va_arg(pCurrentArgument , int));
+    GT_IF_WITH_ASSERT(argumentType == OS_TOBJ_ID_GL_UINT_PARAMETER)
+    {
+        argumentValue = (GLuint)(va_arg(pCurrentArgument , unsigned long));
+        retVal = true;
+    }
+
+    return retVal;
+}
+
+// ---------------------------------------------------------------------------
+// Name:        gsShadowStateTracker::readBooleanArgument
+// Description: Reads a GLboolean argument from the arguments list.
+// Return Val: bool  - Success / failure.
+// ---------------------------------------------------------------------------
+bool gsShadowStateTracker::readBooleanArgument(va_list& pCurrentArgument, GLuint& argumentValue)
+{
+    bool retVal = false;
+
+    osTransferableObjectType argumentType = (osTransferableObjectType)(va_arg(pCurrentArgument , int));
+    GT_IF_WITH_ASSERT(argumentType == OS_TOBJ_ID_GL_BOOL_PARAMETER)
+    {
+        // GLboolean arguments are promoted to int:
+        argumentValue = (va_arg(pCurrentArgument , int) != 0) ? 1 : 0;
+        retVal = true;
+    }
+
+    return retVal;
+}
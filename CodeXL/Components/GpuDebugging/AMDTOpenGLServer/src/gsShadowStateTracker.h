@@ -0,0 +1,80 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file gsShadowStateTracker.h
+///
+//==================================================================================
+
+//------------------------------ gsShadowStateTracker.h ------------------------------
+
+#ifndef __GSSHADOWSTATETRACKER
+#define __GSSHADOWSTATETRACKER
+
+// Infra:
+#include <AMDTBaseTools/Include/gtMap.h>
+#include <AMDTOSAPIWrappers/Include/oaOpenGLIncludes.h>
+#include <AMDTAPIClasses/Include/apFunctionType.h>
+#include <AMDTAPIClasses/Include/apMonitoredFunctionId.h>
+
+// ----------------------------------------------------------------------------------
+// Class Name:           gsShadowStateTracker
+// General Description: Holds a shadow copy of the commonly changed OpenGL state variables of a render context.
+//                      The shadow values are updated from the arguments of the state change function calls,
+//                      which allows deciding the redundancy status of these calls without querying OpenGL.
+//                      A shadow value is known only after a function call that sets it was seen, and is forgotten
+//                      when a function call changes it in a way that is not modeled (e.g. glPopAttrib).
+// ----------------------------------------------------------------------------------
+class gsShadowStateTracker
+{
+public:
+    gsShadowStateTracker();
+    virtual ~gsShadowStateTracker();
+
+    bool applyStateChange(apMonitoredFunctionId calledFunctionId, int argumentsAmount, va_list& pArgumentList, apFunctionRedundancyStatus& redundancyStatus);
+    void clear();
+
+private:
+    // The kinds of the shadowed state values:
+    enum gsShadowStateKind
+    {
+        GS_SHADOW_CAPABILITY,               // glEnable / glDisable. Sub key: the capability.
+        GS_SHADOW_BLEND_FUNC,               // Sub key: 0 - source RGB, 1 - destination RGB, 2 - source alpha, 3 - destination alpha.
+        GS_SHADOW_BLEND_EQUATION,           // Sub key: 0 - RGB, 1 - alpha.
+        GS_SHADOW_DEPTH_FUNC,
+        GS_SHADOW_DEPTH_MASK,
+        GS_SHADOW_CULL_FACE_MODE,
+        GS_SHADOW_FRONT_FACE,
+        GS_SHADOW_SHADE_MODEL,
+        GS_SHADOW_ACTIVE_TEXTURE,
+        GS_SHADOW_TEXTURE_BINDING,          // Sub key: the texture target.
+        GS_SHADOW_PROGRAM_BINDING,
+        GS_SHADOW_BUFFER_BINDING,           // Sub key: the buffer target.
+        GS_SHADOW_FRAMEBUFFER_BINDING,      // Sub key: GL_DRAW_FRAMEBUFFER / GL_READ_FRAMEBUFFER.
+        GS_SHADOW_VERTEX_ARRAY_BINDING
+    };
+
+    // The maximal amount of state values a single function call sets:
+    enum { GS_SHADOW_MAX_CHANGED_VALUES = 4 };
+
+    bool getStateChangeValues(apMonitoredFunctionId calledFunctionId, int argumentsAmount, va_list& pArgumentList, gtUInt64* changedKeys, GLuint* changedValues, int& changedValuesAmount);
+    bool getTextureUnitKey(gsShadowStateKind kind, GLuint subKey, gtUInt64& key) const;
+    void forgetStateValues(gsShadowStateKind kind);
+    void onNonModeledFunctionCall(apMonitoredFunctionId calledFunctionId, int argumentsAmount, va_list& pArgumentList);
+
+    static gtUInt64 stateKey(gsShadowStateKind kind, GLuint subKey, GLuint textureUnit = 0);
+    static bool isTextureUnitCapability(GLenum capability);
+    static bool readEnumArgument(va_list& pCurrentArgument, GLenum& argumentValue);
+    static bool readUIntArgument(va_list& pCurrentArgument, GLuint& argumentValue);
+    static bool readBooleanArgument(va_list& pCurrentArgument, GLuint& argumentValue);
+
+private:
+    // Maps a state key (see stateKey()) to its known shadow value:
+    gtMap<gtUInt64, GLuint> _shadowValues;
+
+    // Contains true iff we are inside a glNewList(GL_COMPILE) - glEndList block, where function calls do not change the state:
+    bool _isCompilingDisplayList;
+};
+
+
+#endif  // __GSSHADOWSTATETRACKER
@@ -175,7 +175,7 @@ bool gsStaticBuffersMonitor::generateBufferFilePath(apDisplayBuffer bufferType,
         logFileName.appendFormattedString(GS_STR_staticBufferFilePath, _spyContextId, bufferNameCode.asCharArray());
 
         // Set the log file path:
-        bufferFilePath = suCurrentSessionLogFilesDirectory();
+        bufferFilePath = suCurrentSessionRawDataFilesDirectory();
 
         // Set the file name
         bufferFilePath.setFileName(logFileName);
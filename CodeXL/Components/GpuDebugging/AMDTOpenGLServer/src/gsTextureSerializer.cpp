@@ -27,6 +27,7 @@
 // Local:
 #include <src/gsStringConstants.h>
 #include <src/gsMonitoredFunctionPointers.h>
+#include <src/gsPixelsOrderReverser.h>
 #include <src/gsWrappersCommon.h>
 #include <src/gsTextureSerializer.h>
 #include <src/gsOpenGLMonitor.h>
@@ -238,11 +239,16 @@ bool gsTextureSerializer::saveRawDataToFile(const gsGLTexture* pTextureObj, cons
                     // This is the data that will be used in the raw file seralizer
                     gtByte* pRawData = pGLTextureRawData;
 
-                    // If texture type is cube map texture, we need to "mirror-flip" it's contents
+                    // If texture type is cube map texture, we need to "mirror-flip" it's contents (in place):
                     if ((AP_CUBE_MAP_TEXTURE == _textureType) || (AP_CUBE_MAP_ARRAY_TEXTURE == _textureType))
                     {
-                        pRawData = mirrorFlipTexture(pGLTextureRawData, dataFormat, componentDataType);
-                        free(pGLTextureRawData);
+                        bool rcFlip = mirrorFlipTexture(pGLTextureRawData, dataFormat, componentDataType);
+
+                        if (!rcFlip)
+                        {
+                            free(pGLTextureRawData);
+                            pRawData = NULL;
+                        }
                     }
 
                     GT_IF_WITH_ASSERT(pRawData != NULL)
@@ -383,25 +389,26 @@ void gsTextureSerializer::getTextureParameters()
 
 // ---------------------------------------------------------------------------
 // Name:        gsTextureSerializer::mirrorFlipTexture
-// Description: Mirror flips the texture raw data
-// Arguments:   pBitmap - The bitmap that we need to mirror flip
+// Description: Mirror flips the texture raw data, in place.
+//              Each page is flipped by reversing the order of its pixels.
+// Arguments:   pRawData - The bitmap that we need to mirror flip
 //              dataFormat - The format of the raw data (for example OS_BGRA).
 //              componentDataType - The data type of the raw data
 //              (for example OA_UNSIGNED_BYTE)
-// Return Val:  The mirror flipped raw data
+// Return Val:  bool - Success / failure.
 // Author:      Eran Zinman
 // Date:        28/12/2007
 // ---------------------------------------------------------------------------
-gtByte* gsTextureSerializer::mirrorFlipTexture(const gtByte* pRawData, oaTexelDataFormat dataFormat, oaDataType componentDataType)
+bool gsTextureSerializer::mirrorFlipTexture(gtByte* pRawData, oaTexelDataFormat dataFormat, oaDataType componentDataType)
 {
-    gtByte* pDest = NULL;
+    bool retVal = false;
 
     // Sanity check:
     GT_IF_WITH_ASSERT(pRawData != NULL)
     {
         // Calculate raw data pixel size
         int rawDataPixelSize = oaCalculatePixelUnitByteSize(dataFormat, componentDataType);
-        GT_IF_WITH_ASSERT(rawDataPixelSize != -1)
+        GT_IF_WITH_ASSERT(rawDataPixelSize > 0)
         {
             // Retrieve image size
             GLsizei width = 0;
@@ -421,39 +428,21 @@ gtByte* gsTextureSerializer::mirrorFlipTexture(const gtByte* pRawData, oaTexelDa
 
             GT_IF_WITH_ASSERT(validDepth)
             {
-                // Calculate the raw data container size
-                size_t slicePitch = width * height * rawDataPixelSize;
-                size_t bufferSize = slicePitch * usedDepth;
+                // Calculate the page size:
+                size_t amountOfPagePixels = (size_t)width * (size_t)height;
+                size_t slicePitch = amountOfPagePixels * rawDataPixelSize;
 
-                // Allocate output raw data buffer
-                pDest = (gtByte*)malloc(bufferSize);
-                GT_IF_WITH_ASSERT(pDest != NULL)
+                for (int z = 0; z < usedDepth; ++z)
                 {
-                    for (int z = 0; z < usedDepth; ++z)
-                    {
-                        // Calculate input read position and output read position
-                        const gtByte* pReadPos = pRawData + (z * slicePitch);
-                        gtByte* pWritePos = pDest + ((z + 1) * slicePitch) - rawDataPixelSize;
-
-                        for (int y = 0; y < height; y++)
-                        {
-                            for (int x = 0; x < width; x++)
-                            {
-                                // Copy data from source to destination
-                                memcpy(pWritePos, pReadPos, rawDataPixelSize);
-
-                                // Advance to next pixel
-                                pReadPos += rawDataPixelSize;
-                                pWritePos -= rawDataPixelSize;
-                            }
-                        }
-                    }
+                    gsPixelsOrderReverser::reversePixelsOrder(pRawData + (z * slicePitch), amountOfPagePixels, rawDataPixelSize);
                 }
+
+                retVal = true;
             }
         }
     }
 
-    return pDest;
+    return retVal;
 }
 
 // ---------------------------------------------------------------------------
@@ -50,7 +50,7 @@ private:
     bool copyOpenGLTextureToBitmap(void* pBitmap, const gsGLTexture* pTextureObj, oaTexelDataFormat dataFormat = OA_TEXEL_FORMAT_BGRA, oaDataType componentDataType = OA_UNSIGNED_BYTE);
     bool allocateOpenGL3DImageCopy();
     gsRetrievedDataFormat retrievedTextureDataFormat();
-    gtByte* mirrorFlipTexture(const gtByte* pRawData, oaTexelDataFormat dataFormat, oaDataType componentDataType);
+    bool mirrorFlipTexture(gtByte* pRawData, oaTexelDataFormat dataFormat, oaDataType componentDataType);
     bool readTextureViaFBO(GLenum pixelFormat, GLenum texelsType, void* pBitmap);
     bool readTextureAttachedToFBO(GLenum pixelFormat, GLenum texelsType, void* pBitmap, const apGLTexture* pTextureObj);
 
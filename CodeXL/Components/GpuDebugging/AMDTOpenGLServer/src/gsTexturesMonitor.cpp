@@ -1077,9 +1077,13 @@ bool gsTexturesMonitor::updateTextureRawData(apGLTextureMipLevelID textureId)
                     // Bind the texture before update:
                     bindTextureForUpdate(textureName, _currentlyBoundTarget);
 
-                    // Generate the texture file name:
+                    // Generate the texture file name. The raw data file holds at most 4 channels of 32 bits per texel:
+                    GLsizei width = 0; GLsizei height = 0; GLsizei depth = 0; GLsizei border = 0;
+                    pTextureObj->getDimensions(width, height, depth, border, textureId._textureMipLevel);
+                    gtUInt64 rawDataFileMaxSize = (gtUInt64)amountOfTextureImageTexels(width, height, depth, border) * 16;
+
                     osFilePath textureFilePath;
-                    generateTextureMiplevelFilePath(textureId, queryDataTarget, textureFilePath);
+                    generateTextureMiplevelFilePath(textureId, queryDataTarget, textureFilePath, rawDataFileMaxSize);
 
                     // Save the texture raw data to a file:
                     gsTextureSerializer textureSerializer(queryDataTarget, textureId._textureMipLevel);
@@ -1235,7 +1239,7 @@ gsGLTexture* gsTexturesMonitor::getCurrentlyBoundTextureObjectDetails(GLenum tar
 // Author:      Yaki Tebeka
 // Date:        27/12/2004
 // ---------------------------------------------------------------------------
-void gsTexturesMonitor::generateTextureMiplevelFilePath(apGLTextureMipLevelID textureMipLevelId, GLenum textureBindTarget, osFilePath& textureFilePath) const
+void gsTexturesMonitor::generateTextureMiplevelFilePath(apGLTextureMipLevelID textureMipLevelId, GLenum textureBindTarget, osFilePath& textureFilePath, gtUInt64 rawDataFileSize) const
 {
     // Get the bind target as string:
     gtString bindTargetAsString;
@@ -1246,7 +1250,7 @@ void gsTexturesMonitor::generateTextureMiplevelFilePath(apGLTextureMipLevelID te
     logFileName.appendFormattedString(GS_STR_textureFilePath, _spyContextId, textureMipLevelId._textureName, textureMipLevelId._textureMipLevel, bindTargetAsString.asCharArray());
 
     // Set the log file path:
-    textureFilePath = suCurrentSessionLogFilesDirectory();
+    textureFilePath = suCurrentSessionRawDataFilesDirectory(rawDataFileSize);
     textureFilePath.setFileName(logFileName);
 
     // Set the log file extension:
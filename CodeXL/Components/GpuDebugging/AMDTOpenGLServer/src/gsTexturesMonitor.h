@@ -103,7 +103,7 @@ private:
     void restoreOpenGLPixelUnPackParameters();
 
     void setStubTextureParameters(GLenum bindTarget);
-    void generateTextureMiplevelFilePath(apGLTextureMipLevelID textureMipLevelId, GLenum textureBindTarget, osFilePath& textureFilePath) const;
+    void generateTextureMiplevelFilePath(apGLTextureMipLevelID textureMipLevelId, GLenum textureBindTarget, osFilePath& textureFilePath, gtUInt64 rawDataFileSize = 0) const;
 
     void textureBindTargetToString(GLenum textureBindTarget, gtString& bindTargetAsString) const;
     GLuint getCurrentlyBoundTexture(GLenum bindTarget) const;
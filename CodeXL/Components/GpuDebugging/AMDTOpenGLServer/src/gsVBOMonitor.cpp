@@ -903,7 +903,7 @@ bool gsVBOMonitor::updateVBORawData(apGLVBO* pVBO, oaTexelDataFormat dataFormat)
                     {
                         // Generate the texture file name:pgd
                         osFilePath bufferFilePath;
-                        generateVBOFilePath(vboName, bufferFilePath);
+                        generateVBOFilePath(vboName, bufferFilePath, (gtUInt64)pVBO->size());
 
                         // Set the buffer file path:
                         pVBO->setBufferFilePath(bufferFilePath);
@@ -962,17 +962,18 @@ bool gsVBOMonitor::updateVBORawData(apGLVBO* pVBO, oaTexelDataFormat dataFormat)
 // Description: Generates a VBO file path.
 // Arguments:   bufferName - The VBO OpenGL name.
 //              bufferFilePath - The output texture file path.
+//              rawDataFileSize - The size of the file about to be written (0 if unknown).
 // Author:      Sigal Algranaty
 // Date:        6/4/2009
 // ---------------------------------------------------------------------------
-void gsVBOMonitor::generateVBOFilePath(GLuint vboName, osFilePath& bufferFilePath) const
+void gsVBOMonitor::generateVBOFilePath(GLuint vboName, osFilePath& bufferFilePath, gtUInt64 rawDataFileSize) const
 {
     // Build the log file name:
     gtString logFileName;
     logFileName.appendFormattedString(GS_STR_vboFilePath, _spyContextId, vboName);
 
     // Set the log file path:
-    bufferFilePath = suCurrentSessionLogFilesDirectory();
+    bufferFilePath = suCurrentSessionRawDataFilesDirectory(rawDataFileSize);
     bufferFilePath.setFileName(logFileName);
 
     // Set the log file extension:
@@ -70,7 +70,7 @@ private:
     apGLVBO* addNewVBO(GLuint vboName);
 
     size_t getVBOIndex(GLuint vboName) const;
-    void generateVBOFilePath(GLuint vboName, osFilePath& bufferFilePath) const;
+    void generateVBOFilePath(GLuint vboName, osFilePath& bufferFilePath, gtUInt64 rawDataFileSize = 0) const;
     apGLVBO* getBoundVBO(GLenum target);
 
     // Bind VBO for reading:
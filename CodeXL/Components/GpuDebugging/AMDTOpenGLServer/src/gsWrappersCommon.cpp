@@ -27,6 +27,10 @@
 // (See gsEnableInitializationFunctionsLogging for more details)
 static bool stat_areInitializationFunctionsLogged = true;
 
+// Contains true iff the wrapper functions were connected to the real functions, and the connection result:
+static bool stat_wereWrapperFunctionsInitialized = false;
+static bool stat_wrapperFunctionsInitializationResult = false;
+
 // TLS currently only supported on Linux:
 #if AMDT_BUILD_TARGET == AMDT_LINUX_OS
 #define GS_EXPORT_SERVER_TLS_VARIABLES 1
@@ -399,13 +403,10 @@ bool gsConnectCGLWrappers(osModuleHandle hSystemOpenGLFramework)
 // ---------------------------------------------------------------------------
 bool gsInitializeWrapperFunctions()
 {
-    static bool s_retVal = false;
-    static bool s_isFirstCall = true;
-
     // If this is the first call to this function:
-    if (s_isFirstCall)
+    if (!stat_wereWrapperFunctionsInitialized)
     {
-        s_isFirstCall = false;
+        stat_wereWrapperFunctionsInitialized = true;
 
         // Load the system's OpenGL module:
         osModuleHandle hSystemOpenGLModule = gsLoadSystemsOpenGLModule();
@@ -413,7 +414,7 @@ bool gsInitializeWrapperFunctions()
         {
             // Connect the OpenGL wrapper functions to the system's OpenGL functions:
             bool rc1 = gsConnectOpenGLWrappers(hSystemOpenGLModule);
-            s_retVal = rc1;
+            stat_wrapperFunctionsInitializationResult = rc1;
 
             // Also connect the driver-internal functions. Since these are driver-dependant,
             // there is no return value:
@@ -427,7 +428,7 @@ bool gsInitializeWrapperFunctions()
             // Uri, 11/6/09: EAGL wrappers are found in the same library as the normal OpenGL ES ones.
 #else
 
-            if (s_retVal)
+            if (stat_wrapperFunctionsInitializationResult)
             {
                 bool CGLWrappersConnected = false;
 
@@ -438,7 +439,7 @@ bool gsInitializeWrapperFunctions()
                     CGLWrappersConnected = true;
                 }
 
-                s_retVal = CGLWrappersConnected;
+                stat_wrapperFunctionsInitializationResult = CGLWrappersConnected;
             }
 
 #endif
@@ -446,7 +447,35 @@ bool gsInitializeWrapperFunctions()
 #endif // Mac OS X only
     }
 
-    return s_retVal;
+    return stat_wrapperFunctionsInitializationResult;
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        gsInitializeWrapperFunctionsWithStubs
+// Description: Connects the OpenGL wrapper functions to the given functions instead of
+//              the system's OpenGL module functions. The spies benchmark uses this to run
+//              the wrappers and the OpenGL monitor on a machine without an OpenGL
+//              implementation. Must be called before the OpenGL Server is initialized.
+// Arguments:   stubFunctionPointers - The functions the wrappers will call, by monitored function id.
+// Return Val:  bool - Success / failure (the wrappers were already connected).
+// ---------------------------------------------------------------------------
+bool gsInitializeWrapperFunctionsWithStubs(const gsMonitoredFunctionPointers& stubFunctionPointers)
+{
+    bool retVal = false;
+
+    GT_IF_WITH_ASSERT(!stat_wereWrapperFunctionsInitialized)
+    {
+        stat_wereWrapperFunctionsInitialized = true;
+
+        // There is no system OpenGL module, so the driver-internal function pointers stay NULL:
+        gs_stat_realFunctionPointers = stubFunctionPointers;
+
+        stat_wrapperFunctionsInitializationResult = true;
+        retVal = true;
+    }
+
+    return retVal;
 }
 
 
@@ -28,6 +28,7 @@
 // --------------------------------------------------------
 
 bool gsInitializeWrapperFunctions();
+bool gsInitializeWrapperFunctionsWithStubs(const gsMonitoredFunctionPointers& stubFunctionPointers);
 bool gsTerminateWrapperFunctions();
 osProcedureAddress gsGetSystemsOGLModuleProcAddress(const char* procname);
 const char* gsTextureCoordinateString(GLenum coord);
@@ -9,6 +9,7 @@
 //------------------------------ pdGDBOutputReader.cpp ------------------------------
 
 // Standard C:
+#include <string.h>
 #include <unistd.h>
 
 // std
@@ -54,6 +55,9 @@
 // The length of the gdb printouts aid buffer:
 #define PD_GDB_PRINTOUTS_BUFF_LENGTH 4098
 
+// The size of the chunks read into the gdb output read buffer:
+#define PD_GDB_OUTPUT_READ_BUFFER_SIZE 65536
+
 // GDB strings:
 static const gtASCIIString s_gdbPromtStr = "(gdb)";
 static const gtASCIIString s_gdbOperationSuccessStr = "^done";
@@ -83,6 +87,9 @@ pdGDBOutputReader::pdGDBOutputReader()
       _executedGDBCommandRequiresFlush(false),
       _pGDBDriver(NULL),
       _pGDBCommunicationPipe(NULL),
+      m_gdbOutputReadBufferStart(0),
+      m_gdbOutputReadBufferEnd(0),
+      m_pGDBOutputReadBufferPipe(NULL),
       _wasDebuggedProcessSuspended(false),
       m_didDebuggedProcessReceiveFatalSignal(false),
       _wasDebuggedProcessTerminated(false),
@@ -98,6 +105,9 @@ pdGDBOutputReader::pdGDBOutputReader()
       _debuggedExecutableArchitecture(OS_UNKNOWN_ARCHITECTURE),
       _amountOfGDBStringPrintouts(0)
 {
+    // Leave room for a null terminator after a full chunk:
+    m_gdbOutputReadBuffer.resize(PD_GDB_OUTPUT_READ_BUFFER_SIZE + 1);
+
     initMembers();
 }
 
@@ -153,6 +163,13 @@ bool pdGDBOutputReader::readGDBOutput(osPipeSocket& gdbCommunicationPipe, pdGDBD
     // Log GDB's communication pipe:
     _pGDBCommunicationPipe = &gdbCommunicationPipe;
 
+    // Buffered output belongs to the pipe it was read from:
+    if (m_pGDBOutputReadBufferPipe != _pGDBCommunicationPipe)
+    {
+        discardGDBOutputReadBuffer();
+        m_pGDBOutputReadBufferPipe = _pGDBCommunicationPipe;
+    }
+
     // Read the gdb output:
     gtASCIIString gdbOutput;
     bool rc3 = readGDBOutput(gdbOutput);
@@ -244,9 +261,9 @@ bool pdGDBOutputReader::readSynchronousCommandGDBOutput(gtASCIIString& gdbOutput
     while (goOn)
     {
         // Read printouts chunk from gdb's output stream:
-        static char buff[PD_GDB_PRINTOUTS_BUFF_LENGTH];
+        static char buff[PD_GDB_PRINTOUTS_BUFF_LENGTH + 1];
         gtSize_t bytesRead = 0;
-        bool rc1 = _pGDBCommunicationPipe->readAvailableData(buff, PD_GDB_PRINTOUTS_BUFF_LENGTH, bytesRead);
+        bool rc1 = readGDBOutputChunk(buff, PD_GDB_PRINTOUTS_BUFF_LENGTH, bytesRead);
 
         if (!rc1)
         {
@@ -332,8 +349,7 @@ bool pdGDBOutputReader::readSynchronousCommandGDBOutput(gtASCIIString& gdbOutput
         }
     }
 
-    GetStoppedThreadGDBId(gdbOutputString);
-    GetRunningThreadGDBId(gdbOutputString);
+    updateThreadsStateFromGDBOutput(gdbOutputString);
 
     GT_RETURN_WITH_ASSERT(retVal);
 }
@@ -418,13 +434,8 @@ bool pdGDBOutputReader::readGDBOutputLine(gtASCIIString& gdbOutputLine)
 
     while (goOn)
     {
-        // A null terminated buffer that will receive the read chars:
-        static char buff[2];
-        buff[1] = 0;
-
-        // Read one char from GDB's current output:
-        gtSize_t bytesRead = 0;
-        bool rc1 = _pGDBCommunicationPipe->readAvailableData(buff, 1, bytesRead);
+        // If all the buffered output was consumed, read the next chunk from GDB's output:
+        bool rc1 = (m_gdbOutputReadBufferStart < m_gdbOutputReadBufferEnd) || fillGDBOutputReadBuffer();
 
         if (!rc1)
         {
@@ -433,16 +444,28 @@ bool pdGDBOutputReader::readGDBOutputLine(gtASCIIString& gdbOutputLine)
         }
         else
         {
-            // If we finished reading an entire GDB output line (terminated by a new line):
-            if (buff[0] == '\n')
+            char* pBufferedData = &(m_gdbOutputReadBuffer[m_gdbOutputReadBufferStart]);
+            gtSize_t bufferedDataSize = m_gdbOutputReadBufferEnd - m_gdbOutputReadBufferStart;
+            char* pLineEnd = (char*)::memchr(pBufferedData, '\n', bufferedDataSize);
+
+            if (pLineEnd != NULL)
             {
+                // We finished reading an entire GDB output line (terminated by a new line).
+                // Replace the new line with a null terminator, and add the line remainder to the output string:
+                *pLineEnd = 0;
+                gdbOutputLine += pBufferedData;
+                m_gdbOutputReadBufferStart += (pLineEnd - pBufferedData) + 1;
+
                 retVal = true;
                 goOn = false;
             }
             else
             {
-                // Add the read char into the output string:
-                gdbOutputLine += buff;
+                // The line continues in the next chunk - add all the buffered data to the output string
+                // (the buffer has room for the null terminator past its end):
+                m_gdbOutputReadBuffer[m_gdbOutputReadBufferEnd] = 0;
+                gdbOutputLine += pBufferedData;
+                m_gdbOutputReadBufferStart = m_gdbOutputReadBufferEnd;
 
                 // Go on for another read loop:
                 goOn = true;
@@ -450,16 +473,245 @@ bool pdGDBOutputReader::readGDBOutputLine(gtASCIIString& gdbOutputLine)
         }
     }
 
-    // Check if some thread exited or stopped
-    GetStoppedThreadGDBId(gdbOutputLine);
-
-    // Check if some thread created or start running
-    GetRunningThreadGDBId(gdbOutputLine);
+    // Check if some thread exited, stopped, was created or started running:
+    updateThreadsStateFromGDBOutput(gdbOutputLine);
 
     GT_RETURN_WITH_ASSERT(retVal);
 }
 
 
+// ---------------------------------------------------------------------------
+// Name:        pdGDBOutputReader::readGDBOutputChunk
+// Description: Reads a chunk of GDB output. Output that was already buffered
+//              by readGDBOutputLine is returned first, so that no output is lost
+//              when mixing line reads and chunk reads.
+// Arguments:   pBuff - Will get the read output.
+//              buffSize - The size of pBuff.
+//              bytesRead - Will get the amount of read bytes.
+// Return Val: bool  - Success / failure.
+// ---------------------------------------------------------------------------
+bool pdGDBOutputReader::readGDBOutputChunk(char* pBuff, gtSize_t buffSize, gtSize_t& bytesRead)
+{
+    bool retVal = false;
+    bytesRead = 0;
+
+    gtSize_t bufferedDataSize = m_gdbOutputReadBufferEnd - m_gdbOutputReadBufferStart;
+
+    if (0 < bufferedDataSize)
+    {
+        // Drain the buffered output:
+        bytesRead = (bufferedDataSize < buffSize) ? bufferedDataSize : buffSize;
+        ::memcpy(pBuff, &(m_gdbOutputReadBuffer[m_gdbOutputReadBufferStart]), bytesRead);
+        m_gdbOutputReadBufferStart += bytesRead;
+
+        retVal = true;
+    }
+    else
+    {
+        // Nothing is buffered, read directly into the caller's buffer:
+        retVal = _pGDBCommunicationPipe->readAvailableData(pBuff, buffSize, bytesRead);
+    }
+
+    return retVal;
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        pdGDBOutputReader::fillGDBOutputReadBuffer
+// Description: Reads the currently available GDB output into the (empty) output
+//              read buffer. Blocks until some output is available.
+// Return Val: bool  - Success / failure.
+// ---------------------------------------------------------------------------
+bool pdGDBOutputReader::fillGDBOutputReadBuffer()
+{
+    bool retVal = false;
+
+    // The buffer is only refilled after it was fully consumed:
+    discardGDBOutputReadBuffer();
+
+    gtSize_t bytesRead = 0;
+    bool rc1 = _pGDBCommunicationPipe->readAvailableData(&(m_gdbOutputReadBuffer[0]), PD_GDB_OUTPUT_READ_BUFFER_SIZE, bytesRead);
+
+    if (rc1 && (0 < bytesRead))
+    {
+        m_gdbOutputReadBufferEnd = bytesRead;
+        retVal = true;
+    }
+
+    return retVal;
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        pdGDBOutputReader::discardGDBOutputReadBuffer
+// Description: Discards the buffered GDB output.
+// ---------------------------------------------------------------------------
+void pdGDBOutputReader::discardGDBOutputReadBuffer()
+{
+    m_gdbOutputReadBufferStart = 0;
+    m_gdbOutputReadBufferEnd = 0;
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        pdGDBOutputReader::classifyGDBOutputRecord
+// Description: Classifies a GDB/MI output line by its record prefix, skipping
+//              the optional numeric command token.
+// Arguments:   pLine - The line start.
+//              pLineEnd - The line end (exclusive).
+// Return Val:  pdGDBOutputRecordKind - The record kind.
+// ---------------------------------------------------------------------------
+pdGDBOutputReader::pdGDBOutputRecordKind pdGDBOutputReader::classifyGDBOutputRecord(const char* pLine, const char* pLineEnd)
+{
+    pdGDBOutputRecordKind retVal = PD_GDB_UNKNOWN_RECORD;
+
+    // Skip the command token:
+    const char* pCurrent = pLine;
+
+    while ((pCurrent < pLineEnd) && ('0' <= *pCurrent) && (*pCurrent <= '9'))
+    {
+        pCurrent++;
+    }
+
+    gtSize_t remainingLength = pLineEnd - pCurrent;
+
+    if ((pCurrent == pLineEnd) || (*pCurrent == '\r'))
+    {
+        retVal = (pCurrent == pLine) ? PD_GDB_STREAM_OR_RESULT_RECORD : PD_GDB_UNKNOWN_RECORD;
+    }
+    else
+    {
+        switch (*pCurrent)
+        {
+            case '~':
+            case '@':
+            case '&':
+            case '^':
+                retVal = PD_GDB_STREAM_OR_RESULT_RECORD;
+                break;
+
+            case '(':
+            {
+                // Only a line that holds nothing but the prompt can be skipped:
+                static const gtSize_t promptLength = s_gdbPromtStr.length();
+                bool isPrompt = (promptLength <= remainingLength) && (::memcmp(pCurrent, s_gdbPromtStr.asCharArray(), promptLength) == 0);
+
+                for (const char* pTrailing = pCurrent + promptLength; isPrompt && (pTrailing < pLineEnd); pTrailing++)
+                {
+                    isPrompt = (*pTrailing == ' ') || (*pTrailing == '\r');
+                }
+
+                retVal = isPrompt ? PD_GDB_STREAM_OR_RESULT_RECORD : PD_GDB_UNKNOWN_RECORD;
+            }
+            break;
+
+            case '*':
+            {
+                static const char s_stoppedClass[] = "*stopped";
+                static const char s_runningClass[] = "*running";
+
+                if ((sizeof(s_stoppedClass) - 1 <= remainingLength) && (::memcmp(pCurrent, s_stoppedClass, sizeof(s_stoppedClass) - 1) == 0))
+                {
+                    retVal = PD_GDB_STOPPED_RECORD;
+                }
+                else if ((sizeof(s_runningClass) - 1 <= remainingLength) && (::memcmp(pCurrent, s_runningClass, sizeof(s_runningClass) - 1) == 0))
+                {
+                    retVal = PD_GDB_RUNNING_RECORD;
+                }
+                else
+                {
+                    retVal = PD_GDB_OTHER_ASYNC_RECORD;
+                }
+            }
+            break;
+
+            case '=':
+            {
+                static const gtSize_t exitingThreadLength = s_exitingThread.length();
+
+                if ((exitingThreadLength <= remainingLength) && (::memcmp(pCurrent, s_exitingThread.asCharArray(), exitingThreadLength) == 0))
+                {
+                    retVal = PD_GDB_THREAD_EXITED_RECORD;
+                }
+                else
+                {
+                    retVal = PD_GDB_OTHER_ASYNC_RECORD;
+                }
+            }
+            break;
+
+            default:
+                retVal = PD_GDB_UNKNOWN_RECORD;
+                break;
+        }
+    }
+
+    return retVal;
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        pdGDBOutputReader::updateThreadsStateFromGDBOutput
+// Description: Updates the threads state from GDB output. The output lines are
+//              classified in a single pass, and the (relatively expensive) threads
+//              state parsers are only called when a line may hold threads state.
+// Arguments:   gdbOutputString - GDB's output, containing one or more lines.
+// ---------------------------------------------------------------------------
+void pdGDBOutputReader::updateThreadsStateFromGDBOutput(const gtASCIIString& gdbOutputString)
+{
+    bool checkStoppedThreads = false;
+    bool checkRunningThreads = false;
+
+    const char* pCurrentLine = gdbOutputString.asCharArray();
+    const char* pOutputEnd = pCurrentLine + gdbOutputString.length();
+
+    while ((pCurrentLine < pOutputEnd) && !(checkStoppedThreads && checkRunningThreads))
+    {
+        const char* pLineEnd = (const char*)::memchr(pCurrentLine, '\n', pOutputEnd - pCurrentLine);
+
+        if (pLineEnd == NULL)
+        {
+            pLineEnd = pOutputEnd;
+        }
+
+        switch (classifyGDBOutputRecord(pCurrentLine, pLineEnd))
+        {
+            case PD_GDB_STOPPED_RECORD:
+            case PD_GDB_THREAD_EXITED_RECORD:
+                checkStoppedThreads = true;
+                break;
+
+            case PD_GDB_RUNNING_RECORD:
+                checkRunningThreads = true;
+                break;
+
+            case PD_GDB_UNKNOWN_RECORD:
+                // Records may follow debugged process output on the same line, so look for all of them:
+                checkStoppedThreads = true;
+                checkRunningThreads = true;
+                break;
+
+            default:
+                break;
+        }
+
+        pCurrentLine = pLineEnd + 1;
+    }
+
+    if (checkStoppedThreads)
+    {
+        // Check if some thread exited or stopped
+        GetStoppedThreadGDBId(gdbOutputString);
+    }
+
+    if (checkRunningThreads)
+    {
+        // Check if some thread created or start running
+        GetRunningThreadGDBId(gdbOutputString);
+    }
+}
+
+
 // ---------------------------------------------------------------------------
 // Name:        pdGDBOutputReader::parseGDBOutput
 // Description:
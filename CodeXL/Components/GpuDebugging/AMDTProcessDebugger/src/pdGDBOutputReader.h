@@ -20,6 +20,7 @@ class apExpression;
 #include <AMDTBaseTools/Include/gtAutoPtr.h>
 #include <AMDTBaseTools/Include/gtPtrVector.h>
 #include <AMDTBaseTools/Include/gtString.h>
+#include <AMDTBaseTools/Include/gtVector.h>
 #include <AMDTOSWrappers/Include/osCriticalSection.h>
 #include <AMDTOSWrappers/Include/osModuleArchitecture.h>
 #include <AMDTAPIClasses/Include/Events/apEvent.h>
@@ -68,6 +69,9 @@ private:
     bool readGDBOutput(gtASCIIString& gdbOutputString);
     bool readSynchronousCommandGDBOutput(gtASCIIString& gdbOutputString);
     bool readAsynchronousCommandGDBOutput(gtASCIIString& gdbOutputString);
+    bool readGDBOutputChunk(char* pBuff, gtSize_t buffSize, gtSize_t& bytesRead);
+    bool fillGDBOutputReadBuffer();
+    void discardGDBOutputReadBuffer();
     bool parseGDBOutput(const gtASCIIString& gdbOutputString, const pdGDBData** ppGDBOutputData);
     bool parseGeneralGDBOutput(const gtASCIIString& gdbOutputString, const pdGDBData** ppGDBOutputData);
     bool parseGeneralGDBOutputLine(const gtASCIIString& gdbOutputLine);
@@ -230,6 +234,32 @@ private:
     /// \date 18/01/2016
     int GetRunningThreadGDBId(const gtASCIIString& gdbOutputLine);
 
+    // The kinds of GDB/MI output records, as far as threads state tracking is concerned:
+    enum pdGDBOutputRecordKind
+    {
+        PD_GDB_STREAM_OR_RESULT_RECORD,     // ~, @, & stream records, ^ result records, the (gdb) prompt and empty lines
+        PD_GDB_STOPPED_RECORD,              // *stopped async records
+        PD_GDB_RUNNING_RECORD,              // *running async records
+        PD_GDB_THREAD_EXITED_RECORD,        // =thread-exited notifications
+        PD_GDB_OTHER_ASYNC_RECORD,          // Any other * or = async record
+        PD_GDB_UNKNOWN_RECORD               // Not an MI record (e.g. debugged process output mixed into the line)
+    };
+
+    /////////////////////////////////////////////////////////////////
+    /// \brief Classify a single GDB/MI output line by its record prefix
+    ///
+    /// \param pLine the line start
+    /// \param pLineEnd the line end (exclusive)
+    /// \return the record kind
+    static pdGDBOutputRecordKind classifyGDBOutputRecord(const char* pLine, const char* pLineEnd);
+
+    /////////////////////////////////////////////////////////////////
+    /// \brief Update the threads state from GDB output, calling GetStoppedThreadGDBId / GetRunningThreadGDBId
+    ///        only if the output contains records that may carry threads state
+    ///
+    /// \param gdbOutputString a GDB output string, containing one or more lines
+    void updateThreadsStateFromGDBOutput(const gtASCIIString& gdbOutputString);
+
     /////////////////////////////////////////////////////////////////////////////////////////
     /// \brief Parse nested gdb values
     ///
@@ -254,6 +284,13 @@ private:
     osPipeSocket* _pGDBCommunicationPipe;
     osCriticalSection m_gdbPipeAccessCS;
 
+    // GDB output that was read from the pipe but not consumed yet. The data is kept between
+    // readGDBOutput calls, and is discarded when the GDB communication pipe changes:
+    gtVector<char> m_gdbOutputReadBuffer;
+    gtSize_t m_gdbOutputReadBufferStart;
+    gtSize_t m_gdbOutputReadBufferEnd;
+    osPipeSocket* m_pGDBOutputReadBufferPipe;
+
     // Will contain GDB error strings:
     gtASCIIString _gdbErrorString;
 
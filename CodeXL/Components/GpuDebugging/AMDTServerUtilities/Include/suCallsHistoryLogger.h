@@ -14,12 +14,17 @@
 // C:
 #include <stdarg.h>
 
+// Standard C++:
+#include <atomic>
+#include <string>
+#include <unordered_map>
 
 // Infra:
 #include <AMDTBaseTools/Include/gtAutoPtr.h>
 #include <AMDTBaseTools/Include/gtIAllocationFailureObserver.h>
 #include <AMDTBaseTools/Include/gtVector.h>
 #include <AMDTAPIClasses/Include/apContextID.h>
+#include <AMDTOSWrappers/Include/osCriticalSection.h>
 #include <AMDTOSWrappers/Include/osFile.h>
 #include <AMDTOSWrappers/Include/osRawMemoryStream.h>
 #include <AMDTOSWrappers/Include/osTime.h>
@@ -74,6 +79,9 @@ public:
 
     apParameter** getStaticTransferableObjTypeToParameterVector() { return _transferableObjTypeToParameter; };
 
+    // Is called when a thread terminates. Releases the thread log segments:
+    static void onThreadTerminated();
+
 protected:
     // Must be implemented by sub-classes:
     virtual void calculateHTMLLogFilePath(osFilePath& htmlLogFilePath) const = 0;
@@ -93,14 +101,112 @@ protected:
     unsigned int maxLoggedFunctionsAmount() const {return _maxLoggedFunctions;};
 
 private:
+    // The location of a logged function call: the raw memory stream that holds it,
+    // and the call position in that stream:
+    struct CallLocation
+    {
+        osRawMemoryStream* _pRawMemoryLogger;
+        size_t _position;
+    };
+
+    // A fixed size block of a thread log segment. The logging thread appends calls to its last block,
+    // and publishes each call by storing the block calls amount (with release semantics). The merging
+    // thread reads the calls up to the calls amount it loads (with acquire semantics). A block is never
+    // reallocated, so the published calls do not move while the logging thread appends calls after them:
+    struct ThreadLogBlock
+    {
+        ThreadLogBlock(size_t bytesCapacity);
+        ~ThreadLogBlock();
+
+        // The maximal amount of calls in a block:
+        enum { MAX_CALLS_AMOUNT = 1024 };
+
+        // The block calls records:
+        gtByte* _pBytes;
+        size_t _bytesCapacity;
+
+        // Written by the logging thread only - the amount of used bytes:
+        size_t _bytesAmount;
+
+        // The end position of each call in _pBytes (a call starts where the previous call ends), and its global sequence number:
+        size_t _callEndPositions[MAX_CALLS_AMOUNT];
+        gtUInt64 _callSequenceNumbers[MAX_CALLS_AMOUNT];
+
+        // The amount of published calls:
+        std::atomic<unsigned int> _callsAmount;
+
+        // The next block. Set by the logging thread after the last call of this block is published:
+        std::atomic<ThreadLogBlock*> _pNext;
+    };
+
+    // A log segment, appended to by a single thread.
+    // When logging is thread safe, each logging thread writes its calls into its own segment without
+    // taking a lock, so that the logging threads do not wait for each other. The segments are merged into
+    // the log (by their calls sequence numbers) only when the log is read.
+    struct ThreadLogSegment
+    {
+        ThreadLogSegment();
+
+        // Written by the logging thread only - the stream a call is written into before it is copied into the block:
+        osRawMemoryStream _rawMemoryLogger;
+
+        // Written by the logging thread only - the block the calls are appended to:
+        ThreadLogBlock* _pWriteBlock;
+
+        // Accessed by the merging thread only (under _threadLogSegmentsCS) - the first block that was not merged
+        // entirely, and the amount of its calls that were already merged into the log. The blocks before it were
+        // deleted by the merge:
+        ThreadLogBlock* _pMergeBlock;
+        unsigned int _mergedCallsAmount;
+
+        // The logging thread instances of the transferable object types parameters:
+        apParameter** _transferableObjTypeToParameter;
+    };
+
+    // A log segment of the calling thread, and the id of the logger that owns it.
+    // The log segments of each thread are held in a single (process wide) thread local data slot,
+    // since a logger is created per context, and each logger slot would exhaust the OS slots:
+    struct ThreadLogSegmentEntry
+    {
+        gtUInt64 _loggerId;
+        ThreadLogSegment* _pSegment;
+    };
+    typedef gtVector<ThreadLogSegmentEntry> ThreadLogSegmentsTable;
+
+    // The indices of the calls that contain a search token. Each index is stored as its difference
+    // from the previous index, in a 7 bits per byte variable length encoding, so that a token
+    // that appears in most calls takes about a byte per call:
+    struct SearchTokenCalls
+    {
+        SearchTokenCalls() : _lastCallIndex(-1) {};
+        void addCall(int callIndex);
+        void getCalls(gtVector<int>& callIndices) const;
+
+        gtVector<unsigned char> _encodedCallIndices;
+        int _lastCallIndex;
+    };
+
     // Disallow use of my default constructor:
     suCallsHistoryLogger();
 
-    bool initializeTransferableObjectTypeVec();
-    void destroyTransferableObjectTypeVec();
-
-    void seekRawMemoryLoggerReadPosition(int callIndex);
-    bool fillFunctionArguments(apFunctionCall& functionCall);
+    static bool initializeTransferableObjectTypeVec(apParameter**& pTransferableObjTypeToParameter);
+    static void destroyTransferableObjectTypeVec(apParameter**& pTransferableObjTypeToParameter);
+
+    void writeFunctionCallRecord(osRawMemoryStream& rawMemoryLogger, apParameter** pTransferableObjTypeToParameter, apMonitoredFunctionId calledFunctionIndex,
+                                 int argumentsAmount, va_list& pArgumentList, apFunctionDeprecationStatus functionDeprecationStatus);
+    void addFunctionCallToThreadLogSegment(apMonitoredFunctionId calledFunctionIndex, int argumentsAmount, va_list& pArgumentList, apFunctionDeprecationStatus functionDeprecationStatus);
+    ThreadLogSegment* currentThreadLogSegment();
+    void lockThreadLogSegments();
+    void unlockThreadLogSegments();
+    void mergeThreadLogSegments();
+    void clearLoggedCalls();
+    void releaseThreadLogSegment(ThreadLogSegment* pSegment);
+    void deleteThreadLogSegments();
+    static void deleteThreadLogSegment(ThreadLogSegment* pSegment);
+
+    osRawMemoryStream& seekRawMemoryLoggerReadPosition(int callIndex);
+    bool readFunctionCall(int callIndex, gtAutoPtr<apFunctionCall>& aptrFunctionCall);
+    bool fillFunctionArguments(osRawMemoryStream& rawMemoryLogger, apFunctionCall& functionCall);
     void startLogFilesFunctionLogging(apMonitoredFunctionId functionId);
     void writeArgumentIntoLogFile(const apParameter& argument, bool isFirstFunctionArgument);
     void endLogFilesFunctionLogging(int functionId);
@@ -108,6 +214,9 @@ private:
     void outputTextLogRecordingSuspendedMessage();
     void outputTextLogRecordingResumedMessage();
     bool isFunctionCallContainingString(int callIndex, bool isCaseSensitiveSearch, const gtString& searchedString) const;
+    void indexLoggedCall(int callIndex);
+    void getSearchCandidates(const gtString& searchedStringLowerCase, gtVector<int>& candidateIndices) const;
+    void clearSearchIndex();
 
     inline void beforeLogging();
     inline bool beforeLoggingWithFailure();
@@ -149,10 +258,47 @@ private:
     osFilePath _textLogFilePath;
 
     // A raw memory stream that stores our function calls:
+    // (When logging is thread safe, the calls are stored in the threads log segments instead)
     osRawMemoryStream _rawMemoryLogger;
 
     // Maps call no. to its location in the _rawMemoryLogger stream:
-    gtVector<size_t> _callLocations;
+    // (When logging is thread safe, the threads log segments calls are copied into _rawMemoryLogger when they are merged)
+    gtVector<CallLocation> _callLocations;
+
+    // The threads log segments (used when logging is thread safe).
+    // _threadLogSegmentsCS protects the segments vector and the merged calls. It is entered by a thread when it logs
+    // its first call and when it terminates, and by the log readers. It is never entered while a call is logged:
+    gtVector<ThreadLogSegment*> _threadLogSegments;
+    osCriticalSection _threadLogSegmentsCS;
+
+    // Identifies my log segments in the logging threads log segments tables:
+    gtUInt64 _loggerId;
+
+    // The amount of calls logged into the threads log segments (including calls that were not merged yet).
+    // A call is counted after it is published, so the count may go below 0 for a moment when the log is cleared:
+    std::atomic<int> _threadLogSegmentsCallsAmount;
+
+    // Search indices over the logged calls. A call is indexed when it is logged (or merged, when logging is
+    // thread safe, under _threadLogSegmentsCS):
+    // - The amount of indexed calls:
+    int _searchIndexedCallsAmount;
+
+    // - The distinct tokens (maximal runs of lower case ASCII letters, digits and underscores) of the
+    //   indexed calls string forms, and their ids. Only the distinct tokens are kept, not the calls text:
+    std::unordered_map<std::string, unsigned int> _searchTokenIds;
+    gtVector<std::string> _searchTokens;
+
+    // - For each token id, the (ascending) indices of the calls that contain it:
+    gtVector<SearchTokenCalls> _searchTokenCalls;
+
+    // - Maps each 1, 2 and 3 characters n-gram of the tokens to the (ascending) ids of the tokens that contain it:
+    std::unordered_map<unsigned int, gtVector<unsigned int> > _searchTokenNGrams;
+
+    // - The indexed calls that could not be read when they were indexed. They are searched directly:
+    gtVector<int> _searchIndexUnreadCalls;
+
+    // - Maps function id to the (ascending) indices of its calls:
+    gtVector< gtVector<int> > _callIndicesByFunctionId;
 
     // Contains the last called function id:
     // (Is used when functions logging is not enabled)
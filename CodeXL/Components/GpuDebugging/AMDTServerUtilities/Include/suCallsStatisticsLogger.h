@@ -21,6 +21,7 @@
 
 // Local
 #include <AMDTServerUtilities/Include/suSpiesUtilitiesDLLBuild.h>
+#include <AMDTServerUtilities/Include/suEnumeratorsUsageTable.h>
 
 // ----------------------------------------------------------------------------------
 // Class Name:   suCallsStatisticsLogger
@@ -135,15 +136,8 @@ private:
     // A calls statistics vector sized (measured in bytes)
     static int _statisticsVectorSize;
 
-    // Logs current frame enumerators usage:
-    gtVector<apEnumeratorUsageStatistics> _currentFrameEnumeratorsUsage[amountOfLoggedEnumFunctions];
-
-    // Logs full frames enumerators usage:
-    gtVector<apEnumeratorUsageStatistics> _fullFramesEnumeratorsUsage[amountOfLoggedEnumFunctions];
-
-    // Logs total (full frames + current) enumerators usage:
-    // We need this, since once we summarize for get statistics, we do not want to create another apEnumeratorUsageStatistics object:
-    gtVector<apEnumeratorUsageStatistics> _totalEnumeratorsUsage[amountOfLoggedEnumFunctions];
+    // Logs the current frame, full frames and total (full frames + current) enumerators usage:
+    suEnumeratorsUsageTable _enumeratorsUsage[amountOfLoggedEnumFunctions];
 
     // Stores the currently logged function enumeration value:
     GLenum _currentFunctionCallEnumValue;
@@ -0,0 +1,76 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file suEnumeratorsUsageTable.h
+///
+//==================================================================================
+
+//------------------------------ suEnumeratorsUsageTable.h ------------------------------
+
+#ifndef __SUENUMERATORSUSAGETABLE_H
+#define __SUENUMERATORSUSAGETABLE_H
+
+// Infra:
+#include <AMDTBaseTools/Include/gtVector.h>
+#include <AMDTAPIClasses/Include/apFunctionCallStatistics.h>
+
+// Local
+#include <AMDTServerUtilities/Include/suSpiesUtilitiesDLLBuild.h>
+
+// ----------------------------------------------------------------------------------
+// Class Name:           suEnumeratorsUsageTable
+// General Description: Logs the enumerators usage statistics of a single monitored function.
+//                      The enumerators are kept in the order in which they were first used, and are
+//                      indexed by an open-addressed hash table keyed by the enumerator value and type.
+//                      Equal values of different types (e.g. GL_POINTS and GL_NONE) are logged as different enumerators.
+//                      Only the enumerators used in the current frame are visited when a frame ends.
+// ----------------------------------------------------------------------------------
+class SU_API suEnumeratorsUsageTable
+{
+public:
+    suEnumeratorsUsageTable();
+    virtual ~suEnumeratorsUsageTable();
+
+    void addEnumeratorUsage(GLenum enumValue, osTransferableObjectType enumType);
+    void onFrameEnded();
+    void clear();
+
+    int amountOfEnumerators() const { return (int)_entries.size(); };
+    const apEnumeratorUsageStatistics& enumeratorTotalUsage(int enumeratorIndex) const { return _entries[enumeratorIndex]._totalUsage; };
+
+private:
+    // Holds the usage counters of a single enumerator:
+    struct suEnumeratorUsageEntry
+    {
+        // The enumerator and its total (full frames + current frame) usage:
+        apEnumeratorUsageStatistics _totalUsage;
+
+        // The enumerator full frames usage:
+        gtUInt64 _fullFramesAmountOfTimesUsed;
+        gtUInt64 _fullFramesAmountOfRedundantTimesUsed;
+
+        // The enumerator current frame usage:
+        gtUInt64 _currentFrameAmountOfTimesUsed;
+        gtUInt64 _currentFrameAmountOfRedundantTimesUsed;
+    };
+
+    int findEntry(GLenum enumValue, osTransferableObjectType enumType) const;
+    void addEntry(GLenum enumValue, osTransferableObjectType enumType);
+    void rebuildHashSlots(int amountOfSlots);
+    static unsigned int hashKey(GLenum enumValue, osTransferableObjectType enumType);
+
+private:
+    // The enumerators usage entries, in the order in which the enumerators were first used:
+    gtVector<suEnumeratorUsageEntry> _entries;
+
+    // The open-addressed hash table. Each slot holds an _entries index, or -1 for an empty slot.
+    // The amount of slots is a power of 2, and is kept at least twice the amount of entries:
+    gtVector<int> _hashSlots;
+
+    // The indices of the entries used in the current frame:
+    gtVector<int> _currentFrameUsedEntries;
+};
+
+
+#endif //__SUENUMERATORSUSAGETABLE_H
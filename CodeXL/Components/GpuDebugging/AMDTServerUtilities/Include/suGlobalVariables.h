@@ -102,6 +102,12 @@ SU_API const osFilePath& suCurrentProjectLogFilesDirectory();
 SU_API void suSetCurrentSessionLogFilesDirectory(const osFilePath& directoryPath);
 SU_API const osFilePath& suCurrentSessionLogFilesDirectory();
 
+// Raw data (textures and buffers) files:
+SU_API void suEnableRawDataTmpfsStagingDirectory(bool isEnabled);
+SU_API const osFilePath& suCurrentSessionRawDataFilesDirectory(gtUInt64 rawDataFileSize = 0);
+SU_API void suRemoveRawDataTmpfsStagingDirectory();
+SU_API void suRemoveStaleRawDataTmpfsStagingDirectories();
+
 // Textures data logging:
 SU_API void suEnableImagesDataLogging(bool isEnabled);
 SU_API bool suIsTexturesDataLoggingEnabled();
@@ -11,6 +11,9 @@
 #ifndef __SUINTEROPERABILITYHELPER_H
 #define __SUINTEROPERABILITYHELPER_H
 
+// Standard C++:
+#include <atomic>
+
 // Local:
 #include <AMDTServerUtilities/Include/suSpiesUtilitiesDLLBuild.h>
 
@@ -34,9 +37,10 @@ public:
     ~suInteroperabilityHelper();
 
     // Nested functions:
-    void onNestedFunctionEntered() {_nestedFunctionCount++;};
+    void onNestedFunctionEntered() {_nestedFunctionCount++; _nestedFunctionsEnteredCount++;};
     void onNestedFunctionExited();
     bool isInNestedFunction() {return (_nestedFunctionCount > 0);};
+    unsigned int nestedFunctionsEnteredCount() const {return _nestedFunctionsEnteredCount;};
 
 private:
     // The constructor should only be called by the instance() function:
@@ -51,6 +55,11 @@ private:
     // This variable is used preventing the API servers from logging the function call and doing other
     // redundant works in such cases.
     int _nestedFunctionCount;
+
+    // The amount of times a nested function was entered. API calls made inside nested functions are not reported
+    // to the API servers, so a change of this count tells a server that such calls might have been made.
+    // (Counted by every thread that enters a nested function, and read by the render context threads):
+    std::atomic<unsigned int> _nestedFunctionsEnteredCount;
 };
 
 #endif //__SUINTEROPERABILITYHELPER_H
@@ -56,6 +56,7 @@
 #define SU_STR_DebugLog_cannotFindAPIFunctionStub L"Error: cannot find API function stub (API function "
 #define SU_STR_DebugLog_failedToReadAPISharedObjName L"Failed to read API shared memory object name"
 #define SU_STR_DebugLog_failedToReadTCPIPEnvVariables L"Failed to read TCP/IP connection environment variables"
+#define SU_STR_DebugLog_rawDataTmpfsStagingDirectoryUnavailable L"tmpfs raw data files staging directory is unavailable, using the session log files directory: "
 #define SU_STR_DebugLog_failedToReadDebuggedApplicationName L"Failed to read the debugged application name"
 #define SU_STR_DebugLog_notRunningUnderDebuggedApp L"Notice: This application is not CodeXL's debugged application (debugged application = %ls, this application = %ls)"
 #define SU_STR_DebugLog_ServersAreInitializedInStandaloneMode L"CodeXL Servers are initialized in stand-alone mode"
@@ -93,6 +94,11 @@
 // General strings:
 #define SU_STR_unknownApplicationName L"Unknown Application"
 #define SU_STR_rawFileExtension L"grw"
+// The tmpfs raw data files staging directory of a debugged process (formatted with the process id).
+// Also used by the debugger, to remove the directory of a debugged process that did not remove it:
+#define SU_STR_rawDataTmpfsStagingParentDirectoryPath "/dev/shm"
+#define SU_STR_rawDataTmpfsStagingDirectoryNameFormat "CodeXL-%u"
+#define SU_STR_rawDataTmpfsStagingDirectoryPath L"" SU_STR_rawDataTmpfsStagingParentDirectoryPath "/" SU_STR_rawDataTmpfsStagingDirectoryNameFormat
 #define SU_STR_CodeXLError L"CodeXL error"
 #define SU_STR_communicationFailedMessage L"Error: Communication between the debugged application and CodeXL has failed. "
 #define GS_STR_SpiesUtilitiesInitializationFailureMessage L"Error: CodeXL failed to attach to the debugged application (%ls)\nThe debugged application will now exit."
@@ -11,16 +11,22 @@
 // C:
 #include <AMDTOSWrappers/Include/osStdLibIncludes.h>
 
+// Standard C++:
+#include <algorithm>
+
 // OpenGL:
 #include <AMDTOSAPIWrappers/Include/oaOpenGLIncludes.h>
 
 // Infra:
 #include <AMDTBaseTools/Include/gtAssert.h>
+#include <AMDTBaseTools/Include/gtMap.h>
 #include <AMDTBaseTools/Include/AMDTDefinitions.h>
+#include <AMDTOSWrappers/Include/osCriticalSectionLocker.h>
 #include <AMDTOSWrappers/Include/osOSDefinitions.h>
 #include <AMDTOSWrappers/Include/osDebuggingFunctions.h>
 #include <AMDTOSWrappers/Include/osDebugLog.h>
 #include <AMDTOSWrappers/Include/osThread.h>
+#include <AMDTOSWrappers/Include/osThreadLocalData.h>
 #include <AMDTOSWrappers/Include/osTime.h>
 #include <AMDTOSWrappers/Include/osTransferableObjectCreatorsManager.h>
 #include <AMDTOSWrappers/Include/osTransferableObjectType.h>
@@ -46,11 +52,41 @@
 // Initialize raw memory size to be 1 Kb:
 static const size_t INITIALE_SIZE_OF_RAW_MEMORY = 1024;
 
+// The size of a thread log segment block. Calls larger than this get a block of their own:
+static const size_t THREAD_LOG_BLOCK_SIZE = 64 * 1024;
+
 // Static argument sizes:
 static size_t static_sizeOfTransferableObjectType = sizeof(osTransferableObjectType);
 static size_t static_sizeOfInt = sizeof(int);
 static size_t static_sizeOfUInt = sizeof(unsigned int);
 
+// The sequence number of the next function call logged into a thread log segment.
+// Orders the calls logged by different threads when the segments are merged:
+static std::atomic<gtUInt64> stat_nextCallSequenceNumber(0);
+
+// Holds, for each logging thread, its log segments table. Allocated when the first thread safe logger
+// is created, and kept until the process terminates:
+static osTheadLocalDataHandle stat_threadLogSegmentsTLSHandle;
+static bool stat_isThreadLogSegmentsTLSAllocated = false;
+
+// The live thread safe loggers, by their ids, and the id of the next created logger.
+// Lets a terminating thread find the loggers of its log segments:
+static gtMap<gtUInt64, suCallsHistoryLogger*> stat_threadSafeLoggers;
+static gtUInt64 stat_nextLoggerId = 0;
+static osCriticalSection stat_threadSafeLoggersCS;
+
+#if AMDT_BUILD_TARGET == AMDT_LINUX_OS
+// Releases the thread log segments when a thread terminates.
+// (On Windows, this is done by DllMain when it gets DLL_THREAD_DETACH)
+struct suThreadLogSegmentsReleaser
+{
+    suThreadLogSegmentsReleaser() : _isArmed(false) {}
+    ~suThreadLogSegmentsReleaser() { if (_isArmed) { suCallsHistoryLogger::onThreadTerminated(); } }
+    bool _isArmed;
+};
+static thread_local suThreadLogSegmentsReleaser stat_threadLogSegmentsReleaser;
+#endif
+
 
 // ---------------------------------------------------------------------------
 // Name:        suCallsHistoryLogger::suCallsHistoryLogger
@@ -68,6 +104,9 @@ suCallsHistoryLogger::suCallsHistoryLogger(apContextID contextId, apMonitoredFun
       _maxLoggedFunctions(maxLoggedFunctions),
       _isHTMLLogFileActive(false),
       _rawMemoryLogger(INITIALE_SIZE_OF_RAW_MEMORY, threadSafeLogging),
+      _loggerId(0),
+      _threadLogSegmentsCallsAmount(0),
+      _searchIndexedCallsAmount(0),
       _lastCalledFunctionId(apMonitoredFunctionsAmount),
       _isInOpenGLBeginEndBlock(false),
       _allocationFailureOccur(false),
@@ -77,12 +116,28 @@ suCallsHistoryLogger::suCallsHistoryLogger(apContextID contextId, apMonitoredFun
     _loggerMessagesLabel.appendFormattedString(loggerMessagesLabelFormat, contextId._contextId);
 
     // Initialize the _transferableObjTypeToParameter vector:
-    bool rc = initializeTransferableObjectTypeVec();
+    bool rc = initializeTransferableObjectTypeVec(_transferableObjTypeToParameter);
     GT_ASSERT(rc);
 
     // Register me to receive _rawMemoryLogger memory allocation failures notifications:
     _rawMemoryLogger.registerAllocationFailureObserver(this);
 
+    // Thread safe logging uses a log segment per logging thread:
+    if (_threadSafeLogging)
+    {
+        osCriticalSectionLocker loggersCSLocker(stat_threadSafeLoggersCS);
+
+        if (!stat_isThreadLogSegmentsTLSAllocated)
+        {
+            stat_isThreadLogSegmentsTLSAllocated = osAllocateThreadsLocalData(stat_threadLogSegmentsTLSHandle);
+            GT_ASSERT(stat_isThreadLogSegmentsTLSAllocated);
+        }
+
+        // Logger ids are never reused, so the threads log segments tables never confuse a deleted logger with a new one:
+        _loggerId = stat_nextLoggerId++;
+        stat_threadSafeLoggers[_loggerId] = this;
+    }
+
     // Initialize the log file creation time to the current time:
     _logCreationTime.setFromCurrentTime();
 }
@@ -97,13 +152,63 @@ suCallsHistoryLogger::suCallsHistoryLogger(apContextID contextId, apMonitoredFun
 suCallsHistoryLogger::~suCallsHistoryLogger()
 {
     // De-initialize the _transferableObjTypeToParameter vector:
-    destroyTransferableObjectTypeVec();
+    destroyTransferableObjectTypeVec(_transferableObjTypeToParameter);
 
     // Close the physical log file:
     closeHTMLLogFile();
 
     // Unregister me from receiving _rawMemoryLogger memory allocation failures notifications:
     _rawMemoryLogger.registerAllocationFailureObserver(NULL);
+
+    // Delete the threads log segments:
+    if (_threadSafeLogging)
+    {
+        // Terminating threads should not release my segments from now on:
+        {
+            osCriticalSectionLocker loggersCSLocker(stat_threadSafeLoggersCS);
+            stat_threadSafeLoggers.erase(_loggerId);
+        }
+
+        deleteThreadLogSegments();
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::ThreadLogBlock::ThreadLogBlock
+// Description: Constructor
+// ---------------------------------------------------------------------------
+suCallsHistoryLogger::ThreadLogBlock::ThreadLogBlock(size_t bytesCapacity)
+    : _pBytes(new gtByte[bytesCapacity]),
+      _bytesCapacity(bytesCapacity),
+      _bytesAmount(0),
+      _callsAmount(0),
+      _pNext(NULL)
+{
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::ThreadLogBlock::~ThreadLogBlock
+// Description: Destructor
+// ---------------------------------------------------------------------------
+suCallsHistoryLogger::ThreadLogBlock::~ThreadLogBlock()
+{
+    delete[] _pBytes;
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::ThreadLogSegment::ThreadLogSegment
+// Description: Constructor
+// ---------------------------------------------------------------------------
+suCallsHistoryLogger::ThreadLogSegment::ThreadLogSegment()
+    : _rawMemoryLogger(INITIALE_SIZE_OF_RAW_MEMORY, false),
+      _pWriteBlock(new ThreadLogBlock(THREAD_LOG_BLOCK_SIZE)),
+      _pMergeBlock(_pWriteBlock),
+      _mergedCallsAmount(0),
+      _transferableObjTypeToParameter(NULL)
+{
 }
 
 
@@ -143,8 +248,7 @@ void suCallsHistoryLogger::clearLog(bool isInSyncBlock)
         _htmlLogFile.flush();
     }
 
-    _rawMemoryLogger.clear();
-    _callLocations.clear();
+    clearLoggedCalls();
     _isInOpenGLBeginEndBlock = false;
     _lastCalledFunctionId = apMonitoredFunctionsAmount;
 
@@ -187,6 +291,8 @@ void suCallsHistoryLogger::enableLogging(bool isLoggingEnabled)
 // a. Logging called function and arguments:
 //    -------------------------------------
 //    The function calls are logged into a raw memory chunk.
+//    When logging is thread safe, each logging thread has its own raw memory blocks
+//    (see ThreadLogSegment), and their calls are merged into the log when it is read.
 //    Each function log has the following memory layout:
 //    Header: <called function id><amount of arguments>
 //    Arguments: <argument type><argument value> ...  <argument type><argument value>
@@ -205,103 +311,509 @@ void suCallsHistoryLogger::addFunctionCall(apMonitoredFunctionId calledFunctionI
     // If monitored functions logging is enabled, and we are in debugging or analyze mode:
     if (_isLoggingEnabled && (currentExecMode != AP_PROFILING_MODE))
     {
-        beforeLogging();
+        if (_threadSafeLogging)
+        {
+            // Log the call into the calling thread log segment:
+            addFunctionCallToThreadLogSegment(calledFunctionIndex, argumentsAmount, pArgumentList, functionDeprecationStatus);
+        }
+        else
+        {
+            // If we are about to exceed the logged functions amount limit:
+            gtSize_t loggedFunctionsAmount = _callLocations.size();
 
-        // If we are about to exceed the logged functions amount limit:
-        gtSize_t loggedFunctionsAmount = _callLocations.size();
+            if (loggedFunctionsAmount >= _maxLoggedFunctions)
+            {
+                reportExceedingMaximalLoggedFunctionsAmount();
+            }
+
+            // Store the place (memory location) in which the current function was logged:
+            CallLocation functionLogLocation;
+            functionLogLocation._pRawMemoryLogger = &_rawMemoryLogger;
+            functionLogLocation._position = _rawMemoryLogger.currentWritePosition();
+            _callLocations.push_back(functionLogLocation);
+
+            // Log the function call:
+            writeFunctionCallRecord(_rawMemoryLogger, _transferableObjTypeToParameter, calledFunctionIndex, argumentsAmount, pArgumentList, functionDeprecationStatus);
+
+            // Add it to the search indices:
+            indexLoggedCall((int)loggedFunctionsAmount);
 
-        if (loggedFunctionsAmount >= _maxLoggedFunctions)
+            // If a memory allocation failure occur:
+            if (_allocationFailureOccur)
+            {
+                reportMemoryAllocationFailure();
+            }
+        }
+    }
+
+    // Store the called function:
+    _lastCalledFunctionId = calledFunctionIndex;
+
+    // Handle glBegin - glEnd block:
+    if (calledFunctionIndex == ap_glBegin)
+    {
+        _isInOpenGLBeginEndBlock = true;
+    }
+    else if (calledFunctionIndex == ap_glEnd)
+    {
+        _isInOpenGLBeginEndBlock = false;
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::writeFunctionCallRecord
+// Description: Writes a function call into a raw memory stream, and into the log files.
+// Arguments:   rawMemoryLogger - The stream into which the call is written.
+//              pTransferableObjTypeToParameter - The parameter instances used for writing
+//                                                the call arguments.
+//              calledFunctionIndex - The called function id.
+//              argumentsAmount - The amount of function arguments.
+//              pArgumentList - The function arguments.
+//              functionDeprecationStatus - The function deprecation status.
+// ---------------------------------------------------------------------------
+void suCallsHistoryLogger::writeFunctionCallRecord(osRawMemoryStream& rawMemoryLogger, apParameter** pTransferableObjTypeToParameter, apMonitoredFunctionId calledFunctionIndex,
+                                                   int argumentsAmount, va_list& pArgumentList, apFunctionDeprecationStatus functionDeprecationStatus)
+{
+    // Log the called function index:
+    rawMemoryLogger.write((gtByte*)&calledFunctionIndex, static_sizeOfInt);
+
+    // Write the initial value of the function redundancy status:
+    static unsigned int initialRedundancyStatus = (unsigned int)AP_REDUNDANCY_UNKNOWN;
+    rawMemoryLogger.write((gtByte*)&initialRedundancyStatus, static_sizeOfUInt);
+
+    // Write the value of the function deprecation status:
+    unsigned int functionDeprecationStatusAsInt = (unsigned int)functionDeprecationStatus;
+    rawMemoryLogger.write((gtByte*)&functionDeprecationStatusAsInt, static_sizeOfUInt);
+
+    // Write the called function into the log files:
+    startLogFilesFunctionLogging(calledFunctionIndex);
+
+    // Log the amount of arguments
+    rawMemoryLogger.write((gtByte*)&argumentsAmount, static_sizeOfInt);
+
+    // Iterate on the argument list:
+    va_list pCurrentArgument;
+    va_copy(pCurrentArgument, pArgumentList);
+    int currentArgumentIndex = 1;
+
+    while (currentArgumentIndex <= argumentsAmount)
+    {
+        // Get and log the argument type:
+        osTransferableObjectType argumentType = (osTransferableObjectType)(va_arg(pCurrentArgument , int));
+        rawMemoryLogger.write((gtByte*)&argumentType, static_sizeOfTransferableObjectType);
+
+        // Get a parameter object that match this argument type:
+        apParameter* pStatParameter = pTransferableObjTypeToParameter[argumentType];
+
+        if (pStatParameter)
+        {
+            // Read the parameter from the arguments list:
+            pStatParameter->readValueFromArgumentsList(pCurrentArgument);
+
+            // Log the argument:
+            pStatParameter->writeSelfIntoChannel(rawMemoryLogger);
+
+            // Write the argument into the log files:
+            bool isFirstArgument = (currentArgumentIndex == 1);
+            writeArgumentIntoLogFile(*pStatParameter, isFirstArgument);
+        }
+        else
+        {
+            // We failed to find a parameter that match this argument type:
+            GT_ASSERT(0);
+
+            // Exit the loop:
+            currentArgumentIndex = argumentsAmount;
+        }
+
+        // Increment the current argument index:
+        currentArgumentIndex++;
+    }
+
+    // End the current function log file logging:
+    endLogFilesFunctionLogging(calledFunctionIndex);
+
+    // Free the arguments pointer:
+    va_end(pCurrentArgument);
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::addFunctionCallToThreadLogSegment
+// Description: Logs a function call into the calling thread log segment.
+//              The call is stamped with a global sequence number, which orders
+//              it relative to the calls logged by other threads.
+//              No lock is taken, unless the call is recorded into the HTML log file:
+//              the segment has a single writer, and the call is published to the
+//              merging thread by the block calls amount.
+// ---------------------------------------------------------------------------
+void suCallsHistoryLogger::addFunctionCallToThreadLogSegment(apMonitoredFunctionId calledFunctionIndex, int argumentsAmount, va_list& pArgumentList, apFunctionDeprecationStatus functionDeprecationStatus)
+{
+    ThreadLogSegment* pSegment = currentThreadLogSegment();
+    GT_IF_WITH_ASSERT(pSegment != NULL)
+    {
+        // If we are about to exceed the logged functions amount limit:
+        if (_threadLogSegmentsCallsAmount >= (int)_maxLoggedFunctions)
         {
+            beforeLogging();
             reportExceedingMaximalLoggedFunctionsAmount();
+            afterLogging();
         }
 
-        // Store the place (memory location) in which the current function was logged:
-        size_t functionLogPosition = _rawMemoryLogger.currentWritePosition();
-        _callLocations.push_back(functionLogPosition);
+        // All the threads record into the same HTML log file, so recording is serialized:
+        bool isRecordingToHTMLLogFile = _isHTMLLogFileActive;
+
+        if (isRecordingToHTMLLogFile)
+        {
+            beforeLogging();
+        }
 
-        // Log the called function index:
-        _rawMemoryLogger.write((gtByte*)&calledFunctionIndex, static_sizeOfInt);
+        // Write the call record, and copy it into the write block:
+        pSegment->_rawMemoryLogger.clear();
+        writeFunctionCallRecord(pSegment->_rawMemoryLogger, pSegment->_transferableObjTypeToParameter, calledFunctionIndex, argumentsAmount, pArgumentList, functionDeprecationStatus);
+        size_t recordSize = pSegment->_rawMemoryLogger.currentWritePosition();
 
-        // Write the initial value of the function redundancy status:
-        static unsigned int initialRedundancyStatus = (unsigned int)AP_REDUNDANCY_UNKNOWN;
-        _rawMemoryLogger.write((gtByte*)&initialRedundancyStatus, static_sizeOfUInt);
+        ThreadLogBlock* pBlock = pSegment->_pWriteBlock;
+        unsigned int blockCallsAmount = pBlock->_callsAmount.load(std::memory_order_relaxed);
 
-        // Write the value of the function deprecation status:
-        unsigned int functionDeprecationStatusAsInt = (unsigned int)functionDeprecationStatus;
-        _rawMemoryLogger.write((gtByte*)&functionDeprecationStatusAsInt, static_sizeOfUInt);
+        if ((blockCallsAmount == ThreadLogBlock::MAX_CALLS_AMOUNT) || (pBlock->_bytesCapacity - pBlock->_bytesAmount < recordSize))
+        {
+            // The merging thread moves to the next block only after it merged all the calls published before the next block was set:
+            ThreadLogBlock* pNewBlock = new ThreadLogBlock(std::max(THREAD_LOG_BLOCK_SIZE, recordSize));
+            pBlock->_pNext.store(pNewBlock, std::memory_order_release);
+            pSegment->_pWriteBlock = pNewBlock;
+            pBlock = pNewBlock;
+            blockCallsAmount = 0;
+        }
 
-        // Write the called function into the log files:
-        startLogFilesFunctionLogging(calledFunctionIndex);
+        pSegment->_rawMemoryLogger.seekReadPosition(0);
+        bool rc = pSegment->_rawMemoryLogger.read(pBlock->_pBytes + pBlock->_bytesAmount, recordSize);
+        GT_ASSERT(rc);
 
-        // Log the amount of arguments
-        _rawMemoryLogger.write((gtByte*)&argumentsAmount, static_sizeOfInt);
+        pBlock->_bytesAmount += recordSize;
+        pBlock->_callEndPositions[blockCallsAmount] = pBlock->_bytesAmount;
+        pBlock->_callSequenceNumbers[blockCallsAmount] = stat_nextCallSequenceNumber++;
 
-        // Iterate on the argument list:
-        va_list pCurrentArgument;
-        va_copy(pCurrentArgument, pArgumentList);
-        int currentArgumentIndex = 1;
+        // Publish the call:
+        pBlock->_callsAmount.store(blockCallsAmount + 1, std::memory_order_release);
+        ++_threadLogSegmentsCallsAmount;
 
-        while (currentArgumentIndex <= argumentsAmount)
+        if (isRecordingToHTMLLogFile)
         {
-            // Get and log the argument type:
-            osTransferableObjectType argumentType = (osTransferableObjectType)(va_arg(pCurrentArgument , int));
-            _rawMemoryLogger.write((gtByte*)&argumentType, static_sizeOfTransferableObjectType);
+            afterLogging();
+        }
+
+        // If a memory allocation failure occur:
+        if (_allocationFailureOccur)
+        {
+            beforeLogging();
+            reportMemoryAllocationFailure();
+            afterLogging();
+        }
+    }
+}
 
-            // Get a parameter object that match this argument type:
-            apParameter* pStatParameter = _transferableObjTypeToParameter[argumentType];
 
-            if (pStatParameter)
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::currentThreadLogSegment
+// Description: Returns the calling thread log segment. Creates it when the thread
+//              logs its first call.
+// ---------------------------------------------------------------------------
+suCallsHistoryLogger::ThreadLogSegment* suCallsHistoryLogger::currentThreadLogSegment()
+{
+    ThreadLogSegment* retVal = NULL;
+
+    // A thread logs into a few contexts, so its table is searched linearly:
+    ThreadLogSegmentsTable* pSegmentsTable = (ThreadLogSegmentsTable*)osGetCurrentThreadLocalData(stat_threadLogSegmentsTLSHandle);
+
+    if (pSegmentsTable != NULL)
+    {
+        for (const ThreadLogSegmentEntry& entry : *pSegmentsTable)
+        {
+            if (entry._loggerId == _loggerId)
             {
-                // Read the parameter from the arguments list:
-                pStatParameter->readValueFromArgumentsList(pCurrentArgument);
+                retVal = entry._pSegment;
+                break;
+            }
+        }
+    }
+
+    if (retVal == NULL)
+    {
+        if (pSegmentsTable == NULL)
+        {
+            pSegmentsTable = new ThreadLogSegmentsTable;
+            osSetCurrentThreadLocalData(stat_threadLogSegmentsTLSHandle, pSegmentsTable);
+
+#if AMDT_BUILD_TARGET == AMDT_LINUX_OS
+            stat_threadLogSegmentsReleaser._isArmed = true;
+#endif
+        }
+
+        retVal = new ThreadLogSegment;
+
+        // The parameter instances hold the argument values while they are written, so each thread needs its own:
+        bool rc = initializeTransferableObjectTypeVec(retVal->_transferableObjTypeToParameter);
+        GT_ASSERT(rc);
+
+        // Register me to receive the segment memory allocation failures notifications:
+        retVal->_rawMemoryLogger.registerAllocationFailureObserver(this);
+
+        {
+            osCriticalSectionLocker segmentsCSLocker(_threadLogSegmentsCS);
+            _threadLogSegments.push_back(retVal);
+        }
+
+        // Drop the entries of the deleted loggers, so that the table of a thread that outlives many contexts does not grow:
+        {
+            osCriticalSectionLocker loggersCSLocker(stat_threadSafeLoggersCS);
+            pSegmentsTable->erase(std::remove_if(pSegmentsTable->begin(), pSegmentsTable->end(),
+                                                 [](const ThreadLogSegmentEntry& entry) { return stat_threadSafeLoggers.find(entry._loggerId) == stat_threadSafeLoggers.end(); }),
+                                  pSegmentsTable->end());
+        }
+
+        ThreadLogSegmentEntry newEntry;
+        newEntry._loggerId = _loggerId;
+        newEntry._pSegment = retVal;
+        pSegmentsTable->push_back(newEntry);
+    }
+
+    return retVal;
+}
 
-                // Log the argument:
-                pStatParameter->writeSelfIntoChannel(_rawMemoryLogger);
 
-                // Write the argument into the log files:
-                bool isFirstArgument = (currentArgumentIndex == 1);
-                writeArgumentIntoLogFile(*pStatParameter, isFirstArgument);
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::onThreadTerminated
+// Description: Is called when a thread terminates. Releases the thread log segments
+//              of the live loggers, and deletes the thread log segments table.
+// ---------------------------------------------------------------------------
+void suCallsHistoryLogger::onThreadTerminated()
+{
+    ThreadLogSegmentsTable* pSegmentsTable = NULL;
+
+    {
+        osCriticalSectionLocker loggersCSLocker(stat_threadSafeLoggersCS);
+
+        if (stat_isThreadLogSegmentsTLSAllocated)
+        {
+            pSegmentsTable = (ThreadLogSegmentsTable*)osGetCurrentThreadLocalData(stat_threadLogSegmentsTLSHandle);
+        }
+
+        if (pSegmentsTable != NULL)
+        {
+            // Holding stat_threadSafeLoggersCS keeps the found loggers alive while their segments are released:
+            for (const ThreadLogSegmentEntry& entry : *pSegmentsTable)
+            {
+                gtMap<gtUInt64, suCallsHistoryLogger*>::iterator findIter = stat_threadSafeLoggers.find(entry._loggerId);
+
+                if (findIter != stat_threadSafeLoggers.end())
+                {
+                    findIter->second->releaseThreadLogSegment(entry._pSegment);
+                }
             }
-            else
+
+            osSetCurrentThreadLocalData(stat_threadLogSegmentsTLSHandle, NULL);
+        }
+    }
+
+    delete pSegmentsTable;
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::releaseThreadLogSegment
+// Description: Releases the log segment of a terminated thread. The segment calls
+//              are merged into the log first, so the segment is not needed anymore.
+// ---------------------------------------------------------------------------
+void suCallsHistoryLogger::releaseThreadLogSegment(ThreadLogSegment* pSegment)
+{
+    osCriticalSectionLocker segmentsCSLocker(_threadLogSegmentsCS);
+
+    mergeThreadLogSegments();
+
+    gtVector<ThreadLogSegment*>::iterator findIter = std::find(_threadLogSegments.begin(), _threadLogSegments.end(), pSegment);
+
+    GT_IF_WITH_ASSERT(findIter != _threadLogSegments.end())
+    {
+        _threadLogSegments.erase(findIter);
+        deleteThreadLogSegment(pSegment);
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::lockThreadLogSegments
+// Description: Prevents other readers and terminating threads from changing the merged
+//              calls, and merges the calls the threads logged since the last merge into
+//              the log. The logging threads are not blocked.
+//              Must be matched by a call to unlockThreadLogSegments.
+// ---------------------------------------------------------------------------
+void suCallsHistoryLogger::lockThreadLogSegments()
+{
+    if (_threadSafeLogging)
+    {
+        _threadLogSegmentsCS.enter();
+        mergeThreadLogSegments();
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::unlockThreadLogSegments
+// Description: Ends the access started by lockThreadLogSegments.
+// ---------------------------------------------------------------------------
+void suCallsHistoryLogger::unlockThreadLogSegments()
+{
+    if (_threadSafeLogging)
+    {
+        _threadLogSegmentsCS.leave();
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::mergeThreadLogSegments
+// Description: Copies the calls published in the threads log segments since the
+//              last merge into _rawMemoryLogger, and appends them to _callLocations,
+//              ordered by their sequence numbers. The merged blocks which the
+//              logging threads moved on from are deleted.
+//              Must be called while _threadLogSegmentsCS is entered.
+//              A call that is being logged while the merge runs is merged by the
+//              next merge, after the calls that were published before it.
+// ---------------------------------------------------------------------------
+void suCallsHistoryLogger::mergeThreadLogSegments()
+{
+    struct NewCall
+    {
+        gtUInt64 _sequenceNumber;
+        const ThreadLogBlock* _pBlock;
+        unsigned int _callIndex;
+    };
+
+    gtVector<NewCall> newCalls;
+    gtVector<ThreadLogBlock*> mergedBlocks;
+
+    for (ThreadLogSegment* pSegment : _threadLogSegments)
+    {
+        ThreadLogBlock* pBlock = pSegment->_pMergeBlock;
+
+        while (pBlock != NULL)
+        {
+            // Load the next block first: once it is set, all the calls of this block are published:
+            ThreadLogBlock* pNextBlock = pBlock->_pNext.load(std::memory_order_acquire);
+            unsigned int blockCallsAmount = pBlock->_callsAmount.load(std::memory_order_acquire);
+
+            for (unsigned int i = pSegment->_mergedCallsAmount; i < blockCallsAmount; i++)
             {
-                // We failed to find a parameter that match this argument type:
-                GT_ASSERT(0);
+                NewCall newCall;
+                newCall._sequenceNumber = pBlock->_callSequenceNumbers[i];
+                newCall._pBlock = pBlock;
+                newCall._callIndex = i;
+                newCalls.push_back(newCall);
+            }
+
+            pSegment->_mergedCallsAmount = blockCallsAmount;
 
-                // Exit the loop:
-                currentArgumentIndex = argumentsAmount;
+            if (pNextBlock != NULL)
+            {
+                // The logging thread does not access this block anymore:
+                mergedBlocks.push_back(pBlock);
+                pSegment->_pMergeBlock = pNextBlock;
+                pSegment->_mergedCallsAmount = 0;
             }
 
-            // Increment the current argument index:
-            currentArgumentIndex++;
+            pBlock = pNextBlock;
         }
+    }
 
-        // End the current function log file logging:
-        endLogFilesFunctionLogging(calledFunctionIndex);
+    if (!newCalls.empty())
+    {
+        std::sort(newCalls.begin(), newCalls.end(), [](const NewCall& a, const NewCall& b) { return a._sequenceNumber < b._sequenceNumber; });
 
-        // Free the arguments pointer:
-        va_end(pCurrentArgument);
+        _callLocations.reserve(_callLocations.size() + newCalls.size());
 
-        // If a memory allocation failure occur:
-        if (_allocationFailureOccur)
+        for (const NewCall& newCall : newCalls)
         {
-            reportMemoryAllocationFailure();
+            size_t callStartPosition = (newCall._callIndex > 0) ? newCall._pBlock->_callEndPositions[newCall._callIndex - 1] : 0;
+            size_t callEndPosition = newCall._pBlock->_callEndPositions[newCall._callIndex];
+
+            CallLocation callLocation;
+            callLocation._pRawMemoryLogger = &_rawMemoryLogger;
+            callLocation._position = _rawMemoryLogger.currentWritePosition();
+            _rawMemoryLogger.write(newCall._pBlock->_pBytes + callStartPosition, callEndPosition - callStartPosition);
+            _callLocations.push_back(callLocation);
+
+            // Add it to the search indices:
+            indexLoggedCall((int)_callLocations.size() - 1);
         }
+    }
 
-        afterLogging();
+    for (ThreadLogBlock* pBlock : mergedBlocks)
+    {
+        delete pBlock;
     }
+}
 
-    // Store the called function:
-    _lastCalledFunctionId = calledFunctionIndex;
 
-    // Handle glBegin - glEnd block:
-    if (calledFunctionIndex == ap_glBegin)
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::clearLoggedCalls
+// Description: Deletes the logged calls. When logging is thread safe, the calls
+//              published in the threads log segments are merged and deleted too.
+//              Calls that are being logged meanwhile are kept.
+// ---------------------------------------------------------------------------
+void suCallsHistoryLogger::clearLoggedCalls()
+{
+    lockThreadLogSegments();
+
+    if (_threadSafeLogging)
     {
-        _isInOpenGLBeginEndBlock = true;
+        _threadLogSegmentsCallsAmount -= (int)_callLocations.size();
     }
-    else if (calledFunctionIndex == ap_glEnd)
+
+    _rawMemoryLogger.clear();
+    _callLocations.clear();
+    clearSearchIndex();
+
+    unlockThreadLogSegments();
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::deleteThreadLogSegments
+// Description: Deletes the threads log segments.
+// ---------------------------------------------------------------------------
+void suCallsHistoryLogger::deleteThreadLogSegments()
+{
+    osCriticalSectionLocker segmentsCSLocker(_threadLogSegmentsCS);
+
+    for (ThreadLogSegment* pSegment : _threadLogSegments)
     {
-        _isInOpenGLBeginEndBlock = false;
+        deleteThreadLogSegment(pSegment);
     }
+
+    _threadLogSegments.clear();
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::deleteThreadLogSegment
+// Description: Deletes a thread log segment, and its blocks.
+// ---------------------------------------------------------------------------
+void suCallsHistoryLogger::deleteThreadLogSegment(ThreadLogSegment* pSegment)
+{
+    ThreadLogBlock* pBlock = pSegment->_pMergeBlock;
+
+    while (pBlock != NULL)
+    {
+        ThreadLogBlock* pNextBlock = pBlock->_pNext.load(std::memory_order_acquire);
+        delete pBlock;
+        pBlock = pNextBlock;
+    }
+
+    pSegment->_rawMemoryLogger.registerAllocationFailureObserver(NULL);
+    destroyTransferableObjectTypeVec(pSegment->_transferableObjTypeToParameter);
+    delete pSegment;
 }
 
 
@@ -317,26 +829,32 @@ void suCallsHistoryLogger::addFunctionCall(apMonitoredFunctionId calledFunctionI
 void suCallsHistoryLogger::writeFunctionRedundancyStatus(int callIndex, apFunctionRedundancyStatus redundancyStatus)
 {
     beforeLogging();
+    lockThreadLogSegments();
 
-    // Get the current write position (in order to turn it back to what it was later):
-    size_t currentWritePosition = _rawMemoryLogger.currentWritePosition();
+    if ((0 <= callIndex) && (callIndex < (int)_callLocations.size()))
+    {
+        // Get the stream and location in which the requested call resides:
+        osRawMemoryStream& rawMemoryLogger = *(_callLocations[callIndex]._pRawMemoryLogger);
+        size_t functionLocation = _callLocations[callIndex]._position;
 
-    // Get the location in which the requested call resides:
-    size_t functionLocation = _callLocations[callIndex];
+        // Get the current write position (in order to turn it back to what it was later):
+        size_t currentWritePosition = rawMemoryLogger.currentWritePosition();
 
-    // This position is supposed to point the function id, progress to the next position:
-    functionLocation += static_sizeOfInt;
+        // This position is supposed to point the function id, progress to the next position:
+        functionLocation += static_sizeOfInt;
 
-    // Seek the raw memory logger to this position:
-    _rawMemoryLogger.seekWritePosition(functionLocation);
+        // Seek the raw memory logger to this position:
+        rawMemoryLogger.seekWritePosition(functionLocation);
 
-    // Write the redundancy status:
-    unsigned int redundancyStatusAsUInt = (unsigned int)redundancyStatus;
-    _rawMemoryLogger.write((gtByte*)&redundancyStatusAsUInt, static_sizeOfUInt);
+        // Write the redundancy status:
+        unsigned int redundancyStatusAsUInt = (unsigned int)redundancyStatus;
+        rawMemoryLogger.write((gtByte*)&redundancyStatusAsUInt, static_sizeOfUInt);
 
-    // Set the stream write position back to what it was:
-    _rawMemoryLogger.seekWritePosition(currentWritePosition);
+        // Set the stream write position back to what it was:
+        rawMemoryLogger.seekWritePosition(currentWritePosition);
+    }
 
+    unlockThreadLogSegments();
     afterLogging();
 }
 
@@ -349,7 +867,9 @@ void suCallsHistoryLogger::writeFunctionRedundancyStatus(int callIndex, apFuncti
 // ---------------------------------------------------------------------------
 int suCallsHistoryLogger::amountOfFunctionCalls() const
 {
-    return (int)_callLocations.size();
+    // The threads log segments calls are counted when they are logged, so there is no need to merge them here:
+    int retVal = _threadSafeLogging ? std::max((int)_threadLogSegmentsCallsAmount, 0) : (int)_callLocations.size();
+    return retVal;
 }
 
 
@@ -377,50 +897,75 @@ bool suCallsHistoryLogger::getFunctionCall(int callIndex, gtAutoPtr<apFunctionCa
 
         if (canRead)
         {
-            // Seek the raw memory read position to the beginning of the requested
-            // function call raw memory log:
-            nonConstMe.seekRawMemoryLoggerReadPosition(callIndex);
+            // Merge the calls logged by the threads since the last read:
+            nonConstMe.lockThreadLogSegments();
+        }
 
-            // Get the logged function index:
-            int functionIndex = 0;
-            unsigned int redundancyStatusUInt = AP_REDUNDANCY_UNKNOWN;
-            unsigned int functionDeprecationStatusAsUInt = AP_DEPRECATION_NONE;
-            rc = nonConstMe._rawMemoryLogger.read((gtByte*)&functionIndex, static_sizeOfInt);
-            rc = nonConstMe._rawMemoryLogger.read((gtByte*)&redundancyStatusUInt, static_sizeOfUInt) && rc;
-            rc = nonConstMe._rawMemoryLogger.read((gtByte*)&functionDeprecationStatusAsUInt, static_sizeOfUInt) && rc;
+        // The log might have been cleared after the range test:
+        if (canRead && (callIndex < (int)_callLocations.size()))
+        {
+            rc = nonConstMe.readFunctionCall(callIndex, aptrFunctionCall);
+        }
 
-            apFunctionRedundancyStatus redundancyStatus = (apFunctionRedundancyStatus)redundancyStatusUInt;
-            apFunctionDeprecationStatus deprecationStatus = (apFunctionDeprecationStatus)functionDeprecationStatusAsUInt;
+        if (canRead)
+        {
+            // Release the CS if we entered it:
+            nonConstMe.unlockThreadLogSegments();
+            nonConstMe.afterLogging();
+        }
+    }
 
-            if (rc)
-            {
-                // Create a transferable object that represents the function call:
-                apFunctionCall* pFunctionCall = new apFunctionCall((apMonitoredFunctionId)functionIndex);
+    return rc;
+}
 
 
-                // Set the function redundancy status:
-                pFunctionCall->setRedundanctStatus(redundancyStatus);
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::readFunctionCall
+// Description: Reads a logged call from the raw memory logger into an apFunctionCall
+//              object. The caller is responsible for the log synchronization.
+// Return Val:  bool - Success / failure.
+// ---------------------------------------------------------------------------
+bool suCallsHistoryLogger::readFunctionCall(int callIndex, gtAutoPtr<apFunctionCall>& aptrFunctionCall)
+{
+    // Seek the raw memory read position to the beginning of the requested
+    // function call raw memory log:
+    osRawMemoryStream& rawMemoryLogger = seekRawMemoryLoggerReadPosition(callIndex);
 
-                // Set the function deprecation status:
-                pFunctionCall->setDeprecationStatus(deprecationStatus);
+    // Get the logged function index:
+    int functionIndex = 0;
+    unsigned int redundancyStatusUInt = AP_REDUNDANCY_UNKNOWN;
+    unsigned int functionDeprecationStatusAsUInt = AP_DEPRECATION_NONE;
+    bool rc = rawMemoryLogger.read((gtByte*)&functionIndex, static_sizeOfInt);
+    rc = rawMemoryLogger.read((gtByte*)&redundancyStatusUInt, static_sizeOfUInt) && rc;
+    rc = rawMemoryLogger.read((gtByte*)&functionDeprecationStatusAsUInt, static_sizeOfUInt) && rc;
 
-                if (pFunctionCall)
-                {
-                    // Get the function arguments:
-                    nonConstMe.fillFunctionArguments(*pFunctionCall);
+    apFunctionRedundancyStatus redundancyStatus = (apFunctionRedundancyStatus)redundancyStatusUInt;
+    apFunctionDeprecationStatus deprecationStatus = (apFunctionDeprecationStatus)functionDeprecationStatusAsUInt;
 
-                    // Return the transferable object:
-                    aptrFunctionCall = pFunctionCall;
-                }
-                else
-                {
-                    // We failed to create the apFunctionCall object:
-                    rc = false;
-                }
-            }
+    if (rc)
+    {
+        // Create a transferable object that represents the function call:
+        apFunctionCall* pFunctionCall = new apFunctionCall((apMonitoredFunctionId)functionIndex);
 
-            // Release the CS if we entered it:
-            nonConstMe.afterLogging();
+
+        // Set the function redundancy status:
+        pFunctionCall->setRedundanctStatus(redundancyStatus);
+
+        // Set the function deprecation status:
+        pFunctionCall->setDeprecationStatus(deprecationStatus);
+
+        if (pFunctionCall)
+        {
+            // Get the function arguments:
+            fillFunctionArguments(rawMemoryLogger, *pFunctionCall);
+
+            // Return the transferable object:
+            aptrFunctionCall = pFunctionCall;
+        }
+        else
+        {
+            // We failed to create the apFunctionCall object:
+            rc = false;
         }
     }
 
@@ -451,15 +996,23 @@ bool suCallsHistoryLogger::getCalledFunctionId(int callIndex, int& calledFunctio
 
         if (canRead)
         {
-            // Seek the raw memory read position to the beginning of the requested
-            // function call raw memory log:
-            nonConstMe.seekRawMemoryLoggerReadPosition(callIndex);
+            // Merge the calls logged by the threads since the last read:
+            nonConstMe.lockThreadLogSegments();
 
-            // Get the logged function index:
-            calledFunctionId = 0;
-            rc = nonConstMe._rawMemoryLogger.read((gtByte*)&calledFunctionId, static_sizeOfInt);
+            // The log might have been cleared after the range test:
+            if (callIndex < (int)_callLocations.size())
+            {
+                // Seek the raw memory read position to the beginning of the requested
+                // function call raw memory log:
+                osRawMemoryStream& rawMemoryLogger = nonConstMe.seekRawMemoryLoggerReadPosition(callIndex);
+
+                // Get the logged function index:
+                calledFunctionId = 0;
+                rc = rawMemoryLogger.read((gtByte*)&calledFunctionId, static_sizeOfInt);
+            }
 
             // Release the CS if we entered it:
+            nonConstMe.unlockThreadLogSegments();
             nonConstMe.afterLogging();
         }
     }
@@ -504,6 +1057,10 @@ bool suCallsHistoryLogger::findFunctionCall(apSearchDirection searchDirection,
     {
         retVal = true;
 
+        // Get a non-const pointer to myself:
+        // (This function has const semantics, but it actually merges the threads logged calls):
+        suCallsHistoryLogger& nonConstMe = *((suCallsHistoryLogger*)this);
+
         gtString searchedStringProperCase = searchedString;
 
         if (!isCaseSensitiveSearch)
@@ -511,29 +1068,70 @@ bool suCallsHistoryLogger::findFunctionCall(apSearchDirection searchDirection,
             searchedStringProperCase.toLowerCase();
         }
 
-        // Search down the indices
+        // Get the indexed calls that may contain the searched string. Each candidate is verified against
+        // the call itself (this handles case sensitive searches, and strings that span several tokens).
+        // Calls that could not be indexed yet are searched directly:
+        gtString searchedStringLowerCase = searchedString;
+        searchedStringLowerCase.toLowerCase();
+        // The calls are indexed when they are logged (or merged, when logging is thread safe):
+        gtVector<int> candidateIndices;
+        nonConstMe.lockThreadLogSegments();
+        int indexedCallsAmount = _searchIndexedCallsAmount;
+        getSearchCandidates(searchedStringLowerCase, candidateIndices);
+        nonConstMe.unlockThreadLogSegments();
+
+        bool isFound = false;
+
         if (searchDirection == AP_SEARCH_INDICES_DOWN)
         {
-            int searchEndIndex = amountOfFunctionCalls() - 1;
+            // Search down the indices
+            gtVector<int>::const_iterator candidateIter = std::lower_bound(candidateIndices.begin(), candidateIndices.end(), searchStartIndex);
 
-            for (int i = searchStartIndex; i <= searchEndIndex; i++)
+            for (; !isFound && (candidateIter != candidateIndices.end()); candidateIter++)
+            {
+                if (isFunctionCallContainingString(*candidateIter, isCaseSensitiveSearch, searchedStringProperCase))
+                {
+                    foundIndex = *candidateIter;
+                    isFound = true;
+                }
+            }
+
+            int searchEndIndex = amountOfFuncCalls - 1;
+
+            int firstNotIndexedIndex = (searchStartIndex < indexedCallsAmount) ? indexedCallsAmount : searchStartIndex;
+
+            for (int i = firstNotIndexedIndex; !isFound && (i <= searchEndIndex); i++)
             {
                 if (isFunctionCallContainingString(i, isCaseSensitiveSearch, searchedStringProperCase))
                 {
                     foundIndex = i;
-                    break;
+                    isFound = true;
                 }
             }
         }
         else if (searchDirection == AP_SEARCH_INDICES_UP)
         {
             // Search up the indices
-            for (int i = searchStartIndex; 0 <= i; i--)
+            for (int i = searchStartIndex; !isFound && (indexedCallsAmount <= i); i--)
             {
                 if (isFunctionCallContainingString(i, isCaseSensitiveSearch, searchedStringProperCase))
                 {
                     foundIndex = i;
-                    break;
+                    isFound = true;
+                }
+            }
+
+            // Continue with the candidates at or before the start index:
+            gtVector<int>::const_iterator candidateIter = std::upper_bound(candidateIndices.begin(), candidateIndices.end(), searchStartIndex);
+
+            while (!isFound && (candidateIter != candidateIndices.begin()))
+            {
+                candidateIter--;
+
+                if (isFunctionCallContainingString(*candidateIter, isCaseSensitiveSearch, searchedStringProperCase))
+                {
+                    foundIndex = *candidateIter;
+                    isFound = true;
                 }
             }
         }
@@ -568,52 +1166,345 @@ bool suCallsHistoryLogger::findStringMarker(apSearchDirection searchDirection, i
     {
         retVal = true;
 
-        // If the search direction is down:
-        int currentFunctionId = 0;
+        // Get a non-const pointer to myself:
+        // (This function has const semantics, but it actually merges the threads logged calls):
+        suCallsHistoryLogger& nonConstMe = *((suCallsHistoryLogger*)this);
+        nonConstMe.lockThreadLogSegments();
 
-        if (searchDirection == AP_SEARCH_INDICES_DOWN)
+        if (ap_glStringMarkerGREMEDY < (int)_callIndicesByFunctionId.size())
         {
-            // Search down the indices
-            for (int i = searchStartIndex; 0 <= i; i--)
+            const gtVector<int>& stringMarkerCalls = _callIndicesByFunctionId[ap_glStringMarkerGREMEDY];
+
+            if (searchDirection == AP_SEARCH_INDICES_DOWN)
             {
-                // Get the current function id:
-                bool rc = getCalledFunctionId(i, currentFunctionId);
+                // Search down the indices - find the last string marker at or before the start index:
+                gtVector<int>::const_iterator foundIter = std::upper_bound(stringMarkerCalls.begin(), stringMarkerCalls.end(), searchStartIndex);
 
-                if (rc)
+                if (foundIter != stringMarkerCalls.begin())
+                {
+                    foundIndex = *(foundIter - 1);
+                }
+            }
+            else if (searchDirection == AP_SEARCH_INDICES_UP)
+            {
+                // Search up the indices - find the first string marker at or after the start index:
+                gtVector<int>::const_iterator foundIter = std::lower_bound(stringMarkerCalls.begin(), stringMarkerCalls.end(), searchStartIndex);
+
+                if (foundIter != stringMarkerCalls.end())
                 {
-                    // If the current function is a string marker:
-                    if (currentFunctionId == ap_glStringMarkerGREMEDY)
+                    foundIndex = *foundIter;
+                }
+            }
+        }
+
+        nonConstMe.unlockThreadLogSegments();
+    }
+
+    return retVal;
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        isSearchTokenCharacter
+// Description: Returns true iff a (lower case) character is a part of a search token.
+// ---------------------------------------------------------------------------
+static inline bool isSearchTokenCharacter(wchar_t c)
+{
+    return ((L'a' <= c) && (c <= L'z')) || ((L'0' <= c) && (c <= L'9')) || (c == L'_');
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::SearchTokenCalls::addCall
+// Description: Adds a call index, which is not lower than the indices already added.
+// ---------------------------------------------------------------------------
+void suCallsHistoryLogger::SearchTokenCalls::addCall(int callIndex)
+{
+    // A token that appears more than once in a call is added once:
+    if (_lastCallIndex < callIndex)
+    {
+        unsigned int delta = (unsigned int)(callIndex - _lastCallIndex);
+
+        while (0x80 <= delta)
+        {
+            _encodedCallIndices.push_back((unsigned char)(0x80 | (delta & 0x7F)));
+            delta >>= 7;
+        }
+
+        _encodedCallIndices.push_back((unsigned char)delta);
+        _lastCallIndex = callIndex;
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::SearchTokenCalls::getCalls
+// Description: Appends the call indices to a vector.
+// ---------------------------------------------------------------------------
+void suCallsHistoryLogger::SearchTokenCalls::getCalls(gtVector<int>& callIndices) const
+{
+    int callIndex = -1;
+    unsigned int delta = 0;
+    int shift = 0;
+
+    for (unsigned char encodedByte : _encodedCallIndices)
+    {
+        delta |= (unsigned int)(encodedByte & 0x7F) << shift;
+        shift += 7;
+
+        if ((encodedByte & 0x80) == 0)
+        {
+            callIndex += (int)delta;
+            callIndices.push_back(callIndex);
+            delta = 0;
+            shift = 0;
+        }
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        searchTokenNGramKey
+// Description: Returns the key of a token n-gram (1 to 3 characters).
+// ---------------------------------------------------------------------------
+static inline unsigned int searchTokenNGramKey(const char* pNGram, int nGramLength)
+{
+    unsigned int retVal = (unsigned int)nGramLength << 24;
+
+    for (int i = 0; i < nGramLength; i++)
+    {
+        retVal |= (unsigned int)(unsigned char)pNGram[i] << (16 - 8 * i);
+    }
+
+    return retVal;
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::indexLoggedCall
+// Description: Adds a call that was just logged (or merged, when logging is thread
+//              safe) to the search indices. The call is translated into its string
+//              form once, and only its distinct tokens are kept. A new token is added
+//              to the n-grams index, so that searches look up the tokens containing a
+//              searched string instead of scanning all the tokens.
+//              Must be called in the calls order.
+// ---------------------------------------------------------------------------
+void suCallsHistoryLogger::indexLoggedCall(int callIndex)
+{
+    gtAutoPtr<apFunctionCall> aptrFunctionCall;
+
+    if (!readFunctionCall(callIndex, aptrFunctionCall))
+    {
+        // This call will be searched directly:
+        _searchIndexUnreadCalls.push_back(callIndex);
+    }
+    else
+    {
+        // Add the call to the calls of its function:
+        if (_callIndicesByFunctionId.empty())
+        {
+            _callIndicesByFunctionId.resize(apMonitoredFunctionsAmount);
+        }
+
+        int functionId = aptrFunctionCall->functionId();
+
+        if ((0 <= functionId) && (functionId < (int)_callIndicesByFunctionId.size()))
+        {
+            _callIndicesByFunctionId[functionId].push_back(callIndex);
+        }
+
+        // Translate the function call into a lower case string:
+        gtString functionCallAsString;
+        aptrFunctionCall->asString(functionCallAsString);
+        functionCallAsString.toLowerCase();
+
+        // Add the call to the calls of each of its tokens:
+        const wchar_t* pCallString = functionCallAsString.asCharArray();
+        int callStringLength = functionCallAsString.length();
+        std::string token;
+
+        for (int j = 0; j <= callStringLength; j++)
+        {
+            if ((j < callStringLength) && isSearchTokenCharacter(pCallString[j]))
+            {
+                token.push_back((char)pCallString[j]);
+            }
+            else if (!token.empty())
+            {
+                unsigned int tokenId = (unsigned int)_searchTokens.size();
+                std::pair<std::unordered_map<std::string, unsigned int>::iterator, bool> insertResult = _searchTokenIds.insert(std::make_pair(token, tokenId));
+
+                if (insertResult.second)
+                {
+                    _searchTokens.push_back(token);
+                    _searchTokenCalls.push_back(SearchTokenCalls());
+
+                    // Add the new token to the tokens of each of its 1, 2 and 3 characters n-grams:
+                    int tokenLength = (int)token.length();
+
+                    for (int nGramLength = 1; nGramLength <= 3; nGramLength++)
                     {
-                        foundIndex = i;
-                        break;
+                        for (int k = 0; k + nGramLength <= tokenLength; k++)
+                        {
+                            gtVector<unsigned int>& nGramTokens = _searchTokenNGrams[searchTokenNGramKey(token.c_str() + k, nGramLength)];
+
+                            // An n-gram that appears more than once in the token is added once:
+                            if (nGramTokens.empty() || (nGramTokens.back() != tokenId))
+                            {
+                                nGramTokens.push_back(tokenId);
+                            }
+                        }
                     }
                 }
+
+                _searchTokenCalls[insertResult.first->second].addCall(callIndex);
+                token.clear();
             }
         }
-        else if (searchDirection == AP_SEARCH_INDICES_UP)
+    }
+
+    _searchIndexedCallsAmount = callIndex + 1;
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::getSearchCandidates
+// Description: Gets the (ascending) indices of the indexed calls that may contain
+//              a (lower case) searched string.
+//              The longest run of token characters in the searched string is
+//              contained in a single token of each call that contains the searched
+//              string, so the candidates are the calls of the tokens that contain it:
+//              - A run that is delimited on both sides in the searched string is a
+//                whole token, which is looked up directly.
+//              - Otherwise, the tokens that contain the run are the tokens of its
+//                rarest n-gram that contain it (start or end with it, if it is
+//                delimited on its left or right side).
+// ---------------------------------------------------------------------------
+void suCallsHistoryLogger::getSearchCandidates(const gtString& searchedStringLowerCase, gtVector<int>& candidateIndices) const
+{
+    // Find the longest run of token characters in the searched string:
+    const wchar_t* pSearchedString = searchedStringLowerCase.asCharArray();
+    int searchedStringLength = searchedStringLowerCase.length();
+    std::string longestFragment;
+    int longestFragmentStart = 0;
+    std::string fragment;
+
+    for (int i = 0; i <= searchedStringLength; i++)
+    {
+        if ((i < searchedStringLength) && isSearchTokenCharacter(pSearchedString[i]))
         {
-            // Search up the indices
-            int searchEndIndex = amountOfFunctionCalls() - 1;
+            fragment.push_back((char)pSearchedString[i]);
+        }
+        else
+        {
+            if (longestFragment.length() < fragment.length())
+            {
+                longestFragment = fragment;
+                longestFragmentStart = i - (int)fragment.length();
+            }
+
+            fragment.clear();
+        }
+    }
 
-            for (int i = searchStartIndex; i <= searchEndIndex; i++)
+    if (longestFragment.empty())
+    {
+        // The searched string has no token characters, so all the indexed calls are candidates:
+        candidateIndices.resize(_searchIndexedCallsAmount);
+
+        for (int i = 0; i < _searchIndexedCallsAmount; i++)
+        {
+            candidateIndices[i] = i;
+        }
+    }
+    else
+    {
+        int fragmentLength = (int)longestFragment.length();
+        bool isDelimitedOnLeft = (0 < longestFragmentStart);
+        bool isDelimitedOnRight = (longestFragmentStart + fragmentLength < searchedStringLength);
+
+        if (isDelimitedOnLeft && isDelimitedOnRight)
+        {
+            std::unordered_map<std::string, unsigned int>::const_iterator findIter = _searchTokenIds.find(longestFragment);
+
+            if (findIter != _searchTokenIds.end())
             {
-                // Get the current function id:
-                bool rc = getCalledFunctionId(i, currentFunctionId);
+                _searchTokenCalls[findIter->second].getCalls(candidateIndices);
+            }
+        }
+        else
+        {
+            // Find the fragment n-gram that appears in the fewest tokens:
+            int nGramLength = std::min(fragmentLength, 3);
+            const gtVector<unsigned int>* pRarestNGramTokens = NULL;
 
-                if (rc)
+            for (int i = 0; i + nGramLength <= fragmentLength; i++)
+            {
+                std::unordered_map<unsigned int, gtVector<unsigned int> >::const_iterator findIter = _searchTokenNGrams.find(searchTokenNGramKey(longestFragment.c_str() + i, nGramLength));
+
+                if (findIter == _searchTokenNGrams.end())
+                {
+                    // No token contains the fragment:
+                    pRarestNGramTokens = NULL;
+                    break;
+                }
+
+                if ((pRarestNGramTokens == NULL) || (findIter->second.size() < pRarestNGramTokens->size()))
                 {
-                    // If the current function is a string marker:
-                    if (currentFunctionId == ap_glStringMarkerGREMEDY)
+                    pRarestNGramTokens = &(findIter->second);
+                }
+            }
+
+            if (pRarestNGramTokens != NULL)
+            {
+                for (unsigned int tokenId : *pRarestNGramTokens)
+                {
+                    const std::string& token = _searchTokens[tokenId];
+                    int tokenLength = (int)token.length();
+                    bool isMatch = false;
+
+                    if (isDelimitedOnLeft)
+                    {
+                        isMatch = (token.compare(0, fragmentLength, longestFragment) == 0);
+                    }
+                    else if (isDelimitedOnRight)
+                    {
+                        isMatch = (fragmentLength <= tokenLength) && (token.compare(tokenLength - fragmentLength, fragmentLength, longestFragment) == 0);
+                    }
+                    else
                     {
-                        foundIndex = i;
-                        break;
+                        isMatch = (token.find(longestFragment) != std::string::npos);
+                    }
+
+                    if (isMatch)
+                    {
+                        _searchTokenCalls[tokenId].getCalls(candidateIndices);
                     }
                 }
             }
         }
+
+        candidateIndices.insert(candidateIndices.end(), _searchIndexUnreadCalls.begin(), _searchIndexUnreadCalls.end());
+
+        std::sort(candidateIndices.begin(), candidateIndices.end());
+        candidateIndices.erase(std::unique(candidateIndices.begin(), candidateIndices.end()), candidateIndices.end());
     }
+}
 
-    return retVal;
+
+// ---------------------------------------------------------------------------
+// Name:        suCallsHistoryLogger::clearSearchIndex
+// Description: Clears the search indices (when the log is cleared).
+// ---------------------------------------------------------------------------
+void suCallsHistoryLogger::clearSearchIndex()
+{
+    _searchIndexedCallsAmount = 0;
+    _searchTokenIds.clear();
+    _searchTokens.clear();
+    _searchTokenCalls.clear();
+    _searchTokenNGrams.clear();
+    _searchIndexUnreadCalls.clear();
+    _callIndicesByFunctionId.clear();
 }
 
 
@@ -744,16 +1635,17 @@ void suCallsHistoryLogger::onDebuggedProcessTerminationAlert()
 
 // ---------------------------------------------------------------------------
 // Name:        suCallsHistoryLogger::initializeTransferableObjectTypeVec
-// Description: Initializes the _transferableObjTypeToParameter static vector.
+// Description: Initializes a transferable object types to parameters vector.
+// Arguments:   pTransferableObjTypeToParameter - The vector to initialize.
 // Author:      Yaki Tebeka
 // Date:        11/5/2004
 // ---------------------------------------------------------------------------
-bool suCallsHistoryLogger::initializeTransferableObjectTypeVec()
+bool suCallsHistoryLogger::initializeTransferableObjectTypeVec(apParameter**& pTransferableObjTypeToParameter)
 {
     bool retVal = true;
 
     // If the static vector was not initialized yet:
-    if (_transferableObjTypeToParameter == NULL)
+    if (pTransferableObjTypeToParameter == NULL)
     {
         // Initialize the ApiClasses library:
         retVal = apiClassesInitFunc();
@@ -768,14 +1660,14 @@ bool suCallsHistoryLogger::initializeTransferableObjectTypeVec()
             }
 #endif
 
-            // Allocate the _transferableObjTypeToParameter array:
-            _transferableObjTypeToParameter = new apParameter*[OS_AMOUNT_OF_TRANSFERABLE_OBJECT_TYPES];
+            // Allocate the transferable object types array:
+            pTransferableObjTypeToParameter = new apParameter*[OS_AMOUNT_OF_TRANSFERABLE_OBJECT_TYPES];
 
 
             // Get the transferable objects creator manager:
             osTransferableObjectCreatorsManager& creatorsMgr = osTransferableObjectCreatorsManager::instance();
 
-            // Fill the _transferableObjTypeToParameter array:
+            // Fill the transferable object types array:
             for (unsigned int i = 0; i < OS_AMOUNT_OF_TRANSFERABLE_OBJECT_TYPES; i++)
             {
                 // Create an instance of the current transferable object:
@@ -796,9 +1688,9 @@ bool suCallsHistoryLogger::initializeTransferableObjectTypeVec()
                     }
                 }
 
-                // Push the apParameter pointer into _transferableObjTypeToParameter.
+                // Push the apParameter pointer into the array.
                 // (NULL value in case of a non apParameter object).
-                _transferableObjTypeToParameter[i] = pParameter;
+                pTransferableObjTypeToParameter[i] = pParameter;
             }
         }
     }
@@ -809,18 +1701,25 @@ bool suCallsHistoryLogger::initializeTransferableObjectTypeVec()
 
 // ---------------------------------------------------------------------------
 // Name:        suCallsHistoryLogger::destroyTransferableObjectTypeVec
-// Description: Deletes the transferable object instances held in the
-//              _transferableObjTypeToParameter static vector.
+// Description: Deletes the transferable object instances held in a
+//              transferable object types to parameters vector, and the vector.
+// Arguments:   pTransferableObjTypeToParameter - The vector to destroy.
 // Author:      Yaki Tebeka
 // Date:        11/5/2004
 // ---------------------------------------------------------------------------
-void suCallsHistoryLogger::destroyTransferableObjectTypeVec()
+void suCallsHistoryLogger::destroyTransferableObjectTypeVec(apParameter**& pTransferableObjTypeToParameter)
 {
-    for (unsigned int i = 0; i < OS_AMOUNT_OF_TRANSFERABLE_OBJECT_TYPES; i++)
+    if (pTransferableObjTypeToParameter != NULL)
     {
-        osTransferableObject* pCurrentObject = _transferableObjTypeToParameter[i];
-        delete pCurrentObject;
-        _transferableObjTypeToParameter[i] = NULL;
+        for (unsigned int i = 0; i < OS_AMOUNT_OF_TRANSFERABLE_OBJECT_TYPES; i++)
+        {
+            osTransferableObject* pCurrentObject = pTransferableObjTypeToParameter[i];
+            delete pCurrentObject;
+            pTransferableObjTypeToParameter[i] = NULL;
+        }
+
+        delete[] pTransferableObjTypeToParameter;
+        pTransferableObjTypeToParameter = NULL;
     }
 }
 
@@ -829,16 +1728,20 @@ void suCallsHistoryLogger::destroyTransferableObjectTypeVec()
 // Name:        suCallsHistoryLogger::seekRawMemoryLoggerReadPosition
 // Description: Seek the raw memory logger read position to the place
 //              where an input call index log starts.
+// Return Val:  osRawMemoryStream& - The raw memory logger that holds the call.
 // Author:      Yaki Tebeka
 // Date:        26/7/2004
 // ---------------------------------------------------------------------------
-void suCallsHistoryLogger::seekRawMemoryLoggerReadPosition(int callIndex)
+osRawMemoryStream& suCallsHistoryLogger::seekRawMemoryLoggerReadPosition(int callIndex)
 {
     // Get the location in which the requested call resides:
-    size_t functionLocation = _callLocations[callIndex];
+    const CallLocation& functionLocation = _callLocations[callIndex];
 
     // Seek the raw memory logger to this position:
-    _rawMemoryLogger.seekReadPosition(functionLocation);
+    osRawMemoryStream& rawMemoryLogger = *(functionLocation._pRawMemoryLogger);
+    rawMemoryLogger.seekReadPosition(functionLocation._position);
+
+    return rawMemoryLogger;
 }
 
 
@@ -846,18 +1749,19 @@ void suCallsHistoryLogger::seekRawMemoryLoggerReadPosition(int callIndex)
 // Name:        suCallsHistoryLogger::fillFunctionArguments
 // Description: Inputs an apFunctionCall object and fills its argument list
 //              from the raw memory logger.
-// Arguments:   functionCall - The function call to be filled.
+// Arguments:   rawMemoryLogger - The raw memory logger, positioned at the call arguments.
+//              functionCall - The function call to be filled.
 // Return Val:  bool - Success / failure.
 // Author:      Yaki Tebeka
 // Date:        26/4/2004
 // ---------------------------------------------------------------------------
-bool suCallsHistoryLogger::fillFunctionArguments(apFunctionCall& functionCall)
+bool suCallsHistoryLogger::fillFunctionArguments(osRawMemoryStream& rawMemoryLogger, apFunctionCall& functionCall)
 {
     bool rc = true;
 
     // Get the amount of function arguments:
     int argumentsAmount = 0;
-    rc = _rawMemoryLogger.read((gtByte*)&argumentsAmount, static_sizeOfInt);
+    rc = rawMemoryLogger.read((gtByte*)&argumentsAmount, static_sizeOfInt);
 
     if (rc)
     {
@@ -868,7 +1772,7 @@ bool suCallsHistoryLogger::fillFunctionArguments(apFunctionCall& functionCall)
         {
             // Read the current argument type:
             unsigned int argumentType = 0;
-            rc = _rawMemoryLogger.read((gtByte*)&argumentType, static_sizeOfInt);
+            rc = rawMemoryLogger.read((gtByte*)&argumentType, static_sizeOfInt);
 
             if (rc)
             {
@@ -887,7 +1791,7 @@ bool suCallsHistoryLogger::fillFunctionArguments(apFunctionCall& functionCall)
                         gtAutoPtr<apParameter> aptrCurrentParam = (apParameter*)(aptrTransferableObj.releasePointedObjectOwnership());
 
                         // Read its value from the raw memory logger:
-                        rc = aptrCurrentParam->readSelfFromChannel(_rawMemoryLogger);
+                        rc = aptrCurrentParam->readSelfFromChannel(rawMemoryLogger);
 
                         if (rc)
                         {
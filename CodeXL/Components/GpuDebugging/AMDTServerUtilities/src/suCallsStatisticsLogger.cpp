@@ -136,35 +136,10 @@ void suCallsStatisticsLogger::onFrameTerminatorCall()
         _wasFirstFrameSkipped = true;
     }
 
-    // Iterate the functions to which we support enumerators logging:
+    // Accumulate the enumerators usage of the functions to which we support enumerators logging:
     for (int i = 0; i < amountOfLoggedEnumFunctions; i++)
     {
-        // Get the function's current and previous frame enumerators statistics holders:
-        gtVector<apEnumeratorUsageStatistics>& currFuncFullFramesLoggedEnumsStat = _fullFramesEnumeratorsUsage[i];
-        gtVector<apEnumeratorUsageStatistics>& currFuncCurrFrameLoggedEnumsStat = _currentFrameEnumeratorsUsage[i];
-        gtVector<apEnumeratorUsageStatistics>& currFuncTotalLoggedEnumsStat = _totalEnumeratorsUsage[i];
-
-        // Iterate the logged enumerators:
-        int amountOfLoggedEnums = (int)currFuncCurrFrameLoggedEnumsStat.size();
-
-        for (int j = 0; j < amountOfLoggedEnums; j++)
-        {
-            // Copy the current frame statistics to the previous frame statistics:
-            currFuncFullFramesLoggedEnumsStat[j]._amountOfTimesUsed += currFuncCurrFrameLoggedEnumsStat[j]._amountOfTimesUsed;
-
-            // Copy the current frame redundancy statistics to the previous frame statistics:
-            currFuncFullFramesLoggedEnumsStat[j]._amountOfRedundantTimesUsed += currFuncCurrFrameLoggedEnumsStat[j]._amountOfRedundantTimesUsed;
-
-            // Initialize current frame statistics:
-            currFuncCurrFrameLoggedEnumsStat[j]._amountOfTimesUsed = 0;
-
-            // Initialize current frame redundancy statistics:
-            currFuncCurrFrameLoggedEnumsStat[j]._amountOfRedundantTimesUsed = 0;
-
-            // At this moment, the total amount of usage is identical to full frame:
-            currFuncTotalLoggedEnumsStat[j]._amountOfTimesUsed = currFuncFullFramesLoggedEnumsStat[j]._amountOfTimesUsed;
-            currFuncTotalLoggedEnumsStat[j]._amountOfRedundantTimesUsed = currFuncFullFramesLoggedEnumsStat[j]._amountOfRedundantTimesUsed;
-        }
+        _enumeratorsUsage[i].onFrameEnded();
     }
 }
 
@@ -475,65 +450,14 @@ void suCallsStatisticsLogger::addFunctionCall(int calledFunctionIndex)
 
         // Handle functions for which we log enumerators usage:
         // ---------------------------------------------------
-        // Get the _currentFrameEnumeratorsUsage index of the called function:
+        // Get the _enumeratorsUsage index of the called function:
         int funVecIndex = _monitoredFuncIdToLoggedEnumFunc[calledFunctionIndex];
 
         // If it is a function for which we log enumerators:
         if (funVecIndex != -1)
         {
-            // Get the function enumerators statistics vector:
-            gtVector<apEnumeratorUsageStatistics>& enumsStatisticsVec = _currentFrameEnumeratorsUsage[funVecIndex];
-            gtVector<apEnumeratorUsageStatistics>& totalEnumStatisticsVec = _totalEnumeratorsUsage[funVecIndex];
-            gtVector<apEnumeratorUsageStatistics>& fullFramesEnumStatisticsVec = _fullFramesEnumeratorsUsage[funVecIndex];
-
-            // Look for the used enumerator statistics handler:
-            bool haveEnumStatisticHandler = false;
-            int amountOfEnumeratorsUsed = (int)enumsStatisticsVec.size();
-
-            for (int i = 0; i < amountOfEnumeratorsUsed; i++)
-            {
-                // If we already have an handler for the used enumerator:
-                apEnumeratorUsageStatistics& curEnumStatisticsHolder = enumsStatisticsVec[i];
-                apEnumeratorUsageStatistics& totalEnumStatisticsHolder = totalEnumStatisticsVec[i];
-
-                if (curEnumStatisticsHolder._enum == _currentFunctionCallEnumValue)
-                {
-                    // Increment the enum statistics:
-                    (curEnumStatisticsHolder._amountOfTimesUsed)++;
-
-                    // Increment the total usage count of the enum:
-                    (totalEnumStatisticsHolder._amountOfTimesUsed)++;
-
-                    // Mark that we found the enum statistics handler:
-                    haveEnumStatisticHandler = true;
-                    break;
-                }
-            }
-
-            // If we don't have an handler for the used enumerator:
-            if (!haveEnumStatisticHandler)
-            {
-                // Implementation note:
-                // We add the enumerator handler to full frames vector, current frame vector, and total vector
-                // This makes the three vectors indices similar (the same index refers to the same
-                // enumerator in both vectors).
-
-                apEnumeratorUsageStatistics enumStatisticsHandler;
-
-                enumStatisticsHandler._enum = _currentFunctionCallEnumValue;
-                enumStatisticsHandler._enumType = _currentFunctionCallEnumType;
-
-                enumStatisticsHandler._amountOfTimesUsed = 1;
-
-                // a. Add it to the full frames statistics:
-                fullFramesEnumStatisticsVec.push_back(enumStatisticsHandler);
-
-                // b. Add it to the total and full frames counters:
-                totalEnumStatisticsVec.push_back(enumStatisticsHandler);
-
-                // c. Add it to the current frame statistics:
-                enumsStatisticsVec.push_back(enumStatisticsHandler);
-            }
+            // Log the used enumerator:
+            _enumeratorsUsage[funVecIndex].addEnumeratorUsage(_currentFunctionCallEnumValue, _currentFunctionCallEnumType);
         }
     }
     else
@@ -626,7 +550,7 @@ void suCallsStatisticsLogger::saveCurrentFunctionCallAttributes(apMonitoredFunct
     // Handle functions for which we log enumerators usage:
     // ---------------------------------------------------
 
-    // Get the _currentFrameEnumeratorsUsage index of the called function:
+    // Get the _enumeratorsUsage index of the called function:
     int funVecIndex = _monitoredFuncIdToLoggedEnumFunc[calledFunctionId];
 
     // If it is a function for which we log enumerators:
@@ -688,32 +612,10 @@ bool suCallsStatisticsLogger::clearFunctionCallsStatistics()
     // Initialize the deprecation statistics:
     ::memset(_fullFramesDeprecationFunctionCallCounter, 0, _statisticsVectorSize * AP_DEPRECATION_STATUS_AMOUNT);
 
-    // Iterate the functions to which we support enumerators logging:
+    // Clear the enumerators usage of the functions to which we support enumerators logging:
     for (int i = 0; i < amountOfLoggedEnumFunctions; i++)
     {
-        // Get the function's current and previous frame enumerators statistics holders:
-        gtVector<apEnumeratorUsageStatistics>& currFuncFullFramesLoggedEnumsStat = _fullFramesEnumeratorsUsage[i];
-        gtVector<apEnumeratorUsageStatistics>& currFuncCurrFrameLoggedEnumsStat = _currentFrameEnumeratorsUsage[i];
-        gtVector<apEnumeratorUsageStatistics>& currTotalFrameLoggedEnumsStat = _totalEnumeratorsUsage[i];
-
-        // Iterate the logged enumerators:
-        int amountOfLoggedEnums = (int)currFuncCurrFrameLoggedEnumsStat.size();
-
-        for (int j = 0; j < amountOfLoggedEnums; j++)
-        {
-            // Copy the current frame statistics to the previous frame statistics:
-            currFuncFullFramesLoggedEnumsStat[j]._amountOfTimesUsed = 0;
-            currFuncFullFramesLoggedEnumsStat[j]._amountOfRedundantTimesUsed = 0;
-
-            // Initialize current frame statistics:
-            currFuncCurrFrameLoggedEnumsStat[j]._amountOfTimesUsed = 0;
-            currFuncCurrFrameLoggedEnumsStat[j]._amountOfRedundantTimesUsed = 0;
-
-            // Initialize total statistics:
-            currTotalFrameLoggedEnumsStat[j]._amountOfTimesUsed = 0;
-            currTotalFrameLoggedEnumsStat[j]._amountOfRedundantTimesUsed = 0;
-
-        }
+        _enumeratorsUsage[i].clear();
     }
 
     // Clear full frames count:
@@ -772,16 +674,16 @@ void suCallsStatisticsLogger::fillFunctionEnumeratorsStatistics(apFunctionCallSt
     // If this is a function to which we log enumerators:
     if (loggedEnumFuncId != -1)
     {
-        // Get the function enumerators statistics vector:
-        const gtVector<apEnumeratorUsageStatistics>& enumsTotalStatisticsVec = _totalEnumeratorsUsage[loggedEnumFuncId];
+        // Get the function enumerators statistics table:
+        const suEnumeratorsUsageTable& enumsUsageTable = _enumeratorsUsage[loggedEnumFuncId];
 
         // Iterate the used enumerators statistics handlers:
-        int amountOfEnumeratorsUsed = (int)enumsTotalStatisticsVec.size();
+        int amountOfEnumeratorsUsed = enumsUsageTable.amountOfEnumerators();
 
         for (int i = 0; i < amountOfEnumeratorsUsed; i++)
         {
             // Get the current enumerator statistics holder:
-            const apEnumeratorUsageStatistics& enumTotalStatisticsHolder = enumsTotalStatisticsVec[i];
+            const apEnumeratorUsageStatistics& enumTotalStatisticsHolder = enumsUsageTable.enumeratorTotalUsage(i);
 
             // If the enumerator was used in the previous frame:
             if (0 < enumTotalStatisticsHolder._amountOfTimesUsed)
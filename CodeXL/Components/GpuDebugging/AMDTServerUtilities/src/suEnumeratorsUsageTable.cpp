@@ -0,0 +1,264 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file suEnumeratorsUsageTable.cpp
+///
+//==================================================================================
+
+//------------------------------ suEnumeratorsUsageTable.cpp ------------------------------
+
+// Infra:
+#include <AMDTBaseTools/Include/gtAssert.h>
+
+// Local:
+#include <AMDTServerUtilities/Include/suEnumeratorsUsageTable.h>
+
+// The amount of hash slots allocated when the first enumerator is added:
+#define SU_ENUMERATORS_USAGE_TABLE_INITIAL_SLOTS_AMOUNT 16
+
+
+// ---------------------------------------------------------------------------
+// Name:        suEnumeratorsUsageTable::suEnumeratorsUsageTable
+// Description: Constructor
+// ---------------------------------------------------------------------------
+suEnumeratorsUsageTable::suEnumeratorsUsageTable()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suEnumeratorsUsageTable::~suEnumeratorsUsageTable
+// Description: Destructor.
+// ---------------------------------------------------------------------------
+suEnumeratorsUsageTable::~suEnumeratorsUsageTable()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suEnumeratorsUsageTable::addEnumeratorUsage
+// Description: Logs a single usage of an enumerator in the current frame.
+// Arguments: enumValue - The used enumerator value.
+//            enumType - The used enumerator type.
+// ---------------------------------------------------------------------------
+void suEnumeratorsUsageTable::addEnumeratorUsage(GLenum enumValue, osTransferableObjectType enumType)
+{
+    int entryIndex = findEntry(enumValue, enumType);
+
+    if (entryIndex != -1)
+    {
+        suEnumeratorUsageEntry& usedEntry = _entries[entryIndex];
+
+        // If this is the first usage of the enumerator in the current frame, remember to summarize it when the frame ends:
+        if (usedEntry._currentFrameAmountOfTimesUsed == 0)
+        {
+            _currentFrameUsedEntries.push_back(entryIndex);
+        }
+
+        // Increment the current frame and total usage counts:
+        usedEntry._currentFrameAmountOfTimesUsed++;
+        usedEntry._totalUsage._amountOfTimesUsed++;
+    }
+    else
+    {
+        addEntry(enumValue, enumType);
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suEnumeratorsUsageTable::onFrameEnded
+// Description: Accumulates the current frame usage into the full frames usage,
+//              and starts a new frame.
+// ---------------------------------------------------------------------------
+void suEnumeratorsUsageTable::onFrameEnded()
+{
+    // Only the enumerators used in the current frame have counters to accumulate. For the other
+    // enumerators, the total usage is already identical to the full frames usage:
+    int amountOfUsedEntries = (int)_currentFrameUsedEntries.size();
+
+    for (int i = 0; i < amountOfUsedEntries; i++)
+    {
+        suEnumeratorUsageEntry& usedEntry = _entries[_currentFrameUsedEntries[i]];
+
+        // Accumulate the current frame statistics to the full frames statistics:
+        usedEntry._fullFramesAmountOfTimesUsed += usedEntry._currentFrameAmountOfTimesUsed;
+        usedEntry._fullFramesAmountOfRedundantTimesUsed += usedEntry._currentFrameAmountOfRedundantTimesUsed;
+
+        // Initialize the current frame statistics:
+        usedEntry._currentFrameAmountOfTimesUsed = 0;
+        usedEntry._currentFrameAmountOfRedundantTimesUsed = 0;
+
+        // At this moment, the total amount of usage is identical to full frames:
+        usedEntry._totalUsage._amountOfTimesUsed = usedEntry._fullFramesAmountOfTimesUsed;
+        usedEntry._totalUsage._amountOfRedundantTimesUsed = usedEntry._fullFramesAmountOfRedundantTimesUsed;
+    }
+
+    _currentFrameUsedEntries.clear();
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suEnumeratorsUsageTable::clear
+// Description: Clears the usage counters of all the logged enumerators.
+//              The enumerators themselves (and their order) are kept.
+// ---------------------------------------------------------------------------
+void suEnumeratorsUsageTable::clear()
+{
+    int amountOfEntries = (int)_entries.size();
+
+    for (int i = 0; i < amountOfEntries; i++)
+    {
+        suEnumeratorUsageEntry& currentEntry = _entries[i];
+
+        currentEntry._totalUsage._amountOfTimesUsed = 0;
+        currentEntry._totalUsage._amountOfRedundantTimesUsed = 0;
+        currentEntry._fullFramesAmountOfTimesUsed = 0;
+        currentEntry._fullFramesAmountOfRedundantTimesUsed = 0;
+        currentEntry._currentFrameAmountOfTimesUsed = 0;
+        currentEntry._currentFrameAmountOfRedundantTimesUsed = 0;
+    }
+
+    _currentFrameUsedEntries.clear();
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suEnumeratorsUsageTable::findEntry
+// Description: Looks for the entry of an enumerator.
+// Arguments: enumValue - The enumerator value.
+//            enumType - The enumerator type.
+// Return Val: int - The entry index, or -1 if the enumerator was not used yet.
+// ---------------------------------------------------------------------------
+int suEnumeratorsUsageTable::findEntry(GLenum enumValue, osTransferableObjectType enumType) const
+{
+    int retVal = -1;
+
+    int amountOfSlots = (int)_hashSlots.size();
+
+    if (amountOfSlots > 0)
+    {
+        // Linear probing, until we find the enumerator or an empty slot:
+        unsigned int slotsMask = (unsigned int)(amountOfSlots - 1);
+        unsigned int slotIndex = hashKey(enumValue, enumType) & slotsMask;
+
+        for (;;)
+        {
+            int entryIndex = _hashSlots[slotIndex];
+
+            if (entryIndex == -1)
+            {
+                break;
+            }
+
+            const apEnumeratorUsageStatistics& entryEnumerator = _entries[entryIndex]._totalUsage;
+
+            if ((entryEnumerator._enum == enumValue) && (entryEnumerator._enumType == enumType))
+            {
+                retVal = entryIndex;
+                break;
+            }
+
+            slotIndex = (slotIndex + 1) & slotsMask;
+        }
+    }
+
+    return retVal;
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suEnumeratorsUsageTable::addEntry
+// Description: Adds an entry for an enumerator that was not used yet, and logs its first usage.
+// Arguments: enumValue - The enumerator value.
+//            enumType - The enumerator type.
+// ---------------------------------------------------------------------------
+void suEnumeratorsUsageTable::addEntry(GLenum enumValue, osTransferableObjectType enumType)
+{
+    // Implementation note:
+    // The first usage is logged in the full frames, current frame and total counters, as
+    // the per-function enumerator vectors did before this table replaced them.
+    suEnumeratorUsageEntry newEntry;
+    newEntry._totalUsage._enum = enumValue;
+    newEntry._totalUsage._enumType = enumType;
+    newEntry._totalUsage._amountOfTimesUsed = 1;
+    newEntry._totalUsage._amountOfRedundantTimesUsed = 0;
+    newEntry._fullFramesAmountOfTimesUsed = 1;
+    newEntry._fullFramesAmountOfRedundantTimesUsed = 0;
+    newEntry._currentFrameAmountOfTimesUsed = 1;
+    newEntry._currentFrameAmountOfRedundantTimesUsed = 0;
+
+    int newEntryIndex = (int)_entries.size();
+    _entries.push_back(newEntry);
+    _currentFrameUsedEntries.push_back(newEntryIndex);
+
+    // Keep the hash table at most half full:
+    int amountOfSlots = (int)_hashSlots.size();
+
+    if (amountOfSlots < (int)_entries.size() * 2)
+    {
+        int newAmountOfSlots = (amountOfSlots > 0) ? amountOfSlots * 2 : SU_ENUMERATORS_USAGE_TABLE_INITIAL_SLOTS_AMOUNT;
+        rebuildHashSlots(newAmountOfSlots);
+    }
+    else
+    {
+        unsigned int slotsMask = (unsigned int)(amountOfSlots - 1);
+        unsigned int slotIndex = hashKey(enumValue, enumType) & slotsMask;
+
+        while (_hashSlots[slotIndex] != -1)
+        {
+            slotIndex = (slotIndex + 1) & slotsMask;
+        }
+
+        _hashSlots[slotIndex] = newEntryIndex;
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suEnumeratorsUsageTable::rebuildHashSlots
+// Description: Reallocates the hash table, and re-inserts all the entries into it.
+// Arguments: amountOfSlots - The new amount of slots. Must be a power of 2.
+// ---------------------------------------------------------------------------
+void suEnumeratorsUsageTable::rebuildHashSlots(int amountOfSlots)
+{
+    GT_ASSERT((amountOfSlots > 0) && ((amountOfSlots & (amountOfSlots - 1)) == 0));
+
+    _hashSlots.clear();
+    _hashSlots.resize(amountOfSlots, -1);
+
+    unsigned int slotsMask = (unsigned int)(amountOfSlots - 1);
+    int amountOfEntries = (int)_entries.size();
+
+    for (int i = 0; i < amountOfEntries; i++)
+    {
+        const apEnumeratorUsageStatistics& entryEnumerator = _entries[i]._totalUsage;
+        unsigned int slotIndex = hashKey(entryEnumerator._enum, entryEnumerator._enumType) & slotsMask;
+
+        while (_hashSlots[slotIndex] != -1)
+        {
+            slotIndex = (slotIndex + 1) & slotsMask;
+        }
+
+        _hashSlots[slotIndex] = i;
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suEnumeratorsUsageTable::hashKey
+// Description: Calculates the hash value of an enumerator.
+// Arguments: enumValue - The enumerator value.
+//            enumType - The enumerator type.
+// Return Val: unsigned int - The hash value.
+// ---------------------------------------------------------------------------
+unsigned int suEnumeratorsUsageTable::hashKey(GLenum enumValue, osTransferableObjectType enumType)
+{
+    // OpenGL enumerators are mostly small, dense values. Multiplicative hashing spreads
+    // them over the table, and the high bits are folded into the masked low bits:
+    unsigned int retVal = ((unsigned int)enumValue ^ ((unsigned int)enumType << 24)) * 2654435761U;
+    retVal ^= (retVal >> 16);
+
+    return retVal;
+}
@@ -24,6 +24,19 @@
 #include <AMDTServerUtilities/Include/suMemoryAllocationMonitor.h>
 #include <AMDTServerUtilities/Include/suStringConstants.h>
 
+// Linux generic:
+#if ((AMDT_BUILD_TARGET == AMDT_LINUX_OS) && (AMDT_LINUX_VARIANT == AMDT_GENERIC_LINUX_VARIANT))
+    #include <dirent.h>
+    #include <errno.h>
+    #include <signal.h>
+    #include <stdio.h>
+    #include <sys/stat.h>
+    #include <sys/statvfs.h>
+    #include <AMDTBaseTools/Include/gtAssert.h>
+    #include <AMDTOSWrappers/Include/osDirectory.h>
+    #include <AMDTOSWrappers/Include/osProcess.h>
+#endif
+
 // Mac OS X:
 #if ((AMDT_BUILD_TARGET == AMDT_LINUX_OS) && (AMDT_LINUX_VARIANT == AMDT_MAC_OS_X_LINUX_VARIANT))
     #include <AMDTServerUtilities/Include/suMacOSXInterception.h>
@@ -56,6 +69,20 @@ static osFilePath* su_stat_SessionlogFilesDirectoryPath = NULL;
 // The path of the log files directory:
 static osFilePath* su_stat_ProjectlogFilesDirectoryPath = NULL;
 
+// Gets true when raw data files may be staged in a tmpfs directory:
+static bool su_stat_isRawDataTmpfsStagingDirectoryEnabled = false;
+
+// The path of the tmpfs raw data files staging directory, or NULL if it was not created:
+static osFilePath* su_stat_rawDataTmpfsStagingDirectoryPath = NULL;
+
+// The amount of bytes that may still be staged in the tmpfs directory. Measured once, when the directory
+// is created, and reduced by the size of each raw data file staged in it:
+static gtUInt64 su_stat_rawDataTmpfsStagingBytesLeft = 0;
+
+// The amount of tmpfs memory that is left free for the rest of the system when raw data files are staged in it.
+// Beyond it, raw data files are written to the session log files directory:
+#define SU_RAW_DATA_TMPFS_STAGING_MIN_FREE_BYTES (512 * 1024 * 1024)
+
 // Gets true when textures data logging is enabled:
 bool su_stat_isImagesDataLoggingEnabled = true;
 
@@ -270,6 +297,176 @@ const osFilePath& suCurrentSessionLogFilesDirectory()
     return *su_stat_SessionlogFilesDirectoryPath;
 }
 
+// ---------------------------------------------------------------------------
+// Name:        suEnableRawDataTmpfsStagingDirectory
+// Description: Enables or disables staging raw data files in a tmpfs directory.
+//              This should only be enabled when the debugger runs on this machine, and
+//              reads the raw data files directly (i.e. not in remote sessions).
+// Arguments:   isEnabled - true to enable the tmpfs staging directory.
+// ---------------------------------------------------------------------------
+void suEnableRawDataTmpfsStagingDirectory(bool isEnabled)
+{
+    su_stat_isRawDataTmpfsStagingDirectoryEnabled = isEnabled;
+
+    if (isEnabled)
+    {
+        // Release the memory held by the staging directories of previous debug sessions:
+        suRemoveStaleRawDataTmpfsStagingDirectories();
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suCurrentSessionRawDataFilesDirectory
+// Description: Returns the directory into which textures and buffers raw data files
+//              should be written.
+//              On Linux, when enabled, this is a per-process staging directory on tmpfs (/dev/shm).
+//              The raw data files are still regular files, written by the spy and read by the
+//              debugger, but their pages stay in memory instead of going through the disk.
+//              When the staging directory is not enabled, cannot be created, or the file does
+//              not fit in the memory left for staging, the session log files directory is returned.
+//              Should be called once for each raw data file about to be written, since the file
+//              size is taken from the memory left for staging.
+// Arguments:   rawDataFileSize - The size of the raw data file about to be written, or 0 if it
+//                                is not known.
+// ---------------------------------------------------------------------------
+const osFilePath& suCurrentSessionRawDataFilesDirectory(gtUInt64 rawDataFileSize)
+{
+    const osFilePath* pRetVal = &suCurrentSessionLogFilesDirectory();
+
+#if ((AMDT_BUILD_TARGET == AMDT_LINUX_OS) && (AMDT_LINUX_VARIANT == AMDT_GENERIC_LINUX_VARIANT))
+
+    if (su_stat_isRawDataTmpfsStagingDirectoryEnabled)
+    {
+        // Create the directory on first use:
+        if (su_stat_rawDataTmpfsStagingDirectoryPath == NULL)
+        {
+            gtString directoryPathAsString;
+            directoryPathAsString.appendFormattedString(SU_STR_rawDataTmpfsStagingDirectoryPath, (unsigned int)osGetCurrentProcessId());
+
+            // The directory is private to the user running the debugged process:
+            int rcMkdir = ::mkdir(directoryPathAsString.asASCIICharArray(), S_IRWXU);
+
+            if ((rcMkdir == 0) || (errno == EEXIST))
+            {
+                su_stat_rawDataTmpfsStagingDirectoryPath = new osFilePath;
+                su_stat_rawDataTmpfsStagingDirectoryPath->setPath(directoryPathAsString);
+                su_stat_rawDataTmpfsStagingDirectoryPath->reinterpretAsDirectory();
+
+                // The staged files occupy physical memory until they are removed, so only stage them
+                // in the memory that is free at the start of the session, minus a reserve for the system:
+                struct statvfs fileSystemStatus;
+                int rcStat = ::statvfs(directoryPathAsString.asASCIICharArray(), &fileSystemStatus);
+
+                if (rcStat == 0)
+                {
+                    gtUInt64 freeBytes = (gtUInt64)fileSystemStatus.f_bavail * (gtUInt64)fileSystemStatus.f_frsize;
+
+                    if (freeBytes > (gtUInt64)SU_RAW_DATA_TMPFS_STAGING_MIN_FREE_BYTES)
+                    {
+                        su_stat_rawDataTmpfsStagingBytesLeft = freeBytes - (gtUInt64)SU_RAW_DATA_TMPFS_STAGING_MIN_FREE_BYTES;
+                    }
+                }
+            }
+            else
+            {
+                // Do not try again:
+                su_stat_isRawDataTmpfsStagingDirectoryEnabled = false;
+
+                gtString debugMessage = SU_STR_DebugLog_rawDataTmpfsStagingDirectoryUnavailable;
+                debugMessage += directoryPathAsString;
+                OS_OUTPUT_DEBUG_LOG(debugMessage.asCharArray(), OS_DEBUG_LOG_INFO);
+            }
+        }
+
+        // A file that is written again (e.g. a texture updated in a later frame) is counted again,
+        // so the count only overestimates the staged memory:
+        if ((su_stat_rawDataTmpfsStagingDirectoryPath != NULL) && (su_stat_rawDataTmpfsStagingBytesLeft > 0) && (rawDataFileSize <= su_stat_rawDataTmpfsStagingBytesLeft))
+        {
+            su_stat_rawDataTmpfsStagingBytesLeft -= rawDataFileSize;
+            pRetVal = su_stat_rawDataTmpfsStagingDirectoryPath;
+        }
+    }
+
+#endif
+
+    return *pRetVal;
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suRemoveRawDataTmpfsStagingDirectory
+// Description: Removes the tmpfs raw data files staging directory and its contents,
+//              releasing the memory they occupy.
+// ---------------------------------------------------------------------------
+void suRemoveRawDataTmpfsStagingDirectory()
+{
+#if ((AMDT_BUILD_TARGET == AMDT_LINUX_OS) && (AMDT_LINUX_VARIANT == AMDT_GENERIC_LINUX_VARIANT))
+
+    if (su_stat_rawDataTmpfsStagingDirectoryPath != NULL)
+    {
+        osDirectory rawDataDirectory(*su_stat_rawDataTmpfsStagingDirectoryPath);
+        bool rcDelete = rawDataDirectory.deleteRecursively();
+        GT_ASSERT(rcDelete);
+
+        delete su_stat_rawDataTmpfsStagingDirectoryPath;
+        su_stat_rawDataTmpfsStagingDirectoryPath = NULL;
+        su_stat_rawDataTmpfsStagingBytesLeft = 0;
+    }
+
+#endif
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        suRemoveStaleRawDataTmpfsStagingDirectories
+// Description: Removes the tmpfs raw data files staging directories of debugged
+//              processes that no longer exist. A debugged process that crashed or was
+//              killed does not remove its directory, which would otherwise hold its
+//              memory until the machine is restarted.
+// ---------------------------------------------------------------------------
+void suRemoveStaleRawDataTmpfsStagingDirectories()
+{
+#if ((AMDT_BUILD_TARGET == AMDT_LINUX_OS) && (AMDT_LINUX_VARIANT == AMDT_GENERIC_LINUX_VARIANT))
+
+    DIR* pTmpfsDirectory = ::opendir(SU_STR_rawDataTmpfsStagingParentDirectoryPath);
+
+    if (pTmpfsDirectory != NULL)
+    {
+        unsigned int currentProcessId = (unsigned int)osGetCurrentProcessId();
+        struct dirent* pEntry = NULL;
+
+        while ((pEntry = ::readdir(pTmpfsDirectory)) != NULL)
+        {
+            // Only look at the directories named exactly as the raw data files staging directories:
+            unsigned int directoryProcessId = 0;
+            int directoryNameLength = 0;
+            bool isRawDataDirectory = (pEntry->d_type == DT_DIR) &&
+                                      (::sscanf(pEntry->d_name, SU_STR_rawDataTmpfsStagingDirectoryNameFormat "%n", &directoryProcessId, &directoryNameLength) == 1) &&
+                                      (pEntry->d_name[directoryNameLength] == '\0');
+
+            // A signal 0 only checks if the process exists. Processes of other users (EPERM) are considered alive:
+            if (isRawDataDirectory && (directoryProcessId != currentProcessId) && (::kill((pid_t)directoryProcessId, 0) != 0) && (errno == ESRCH))
+            {
+                gtString directoryPathAsString;
+                directoryPathAsString.appendFormattedString(SU_STR_rawDataTmpfsStagingDirectoryPath, directoryProcessId);
+
+                osFilePath directoryPath;
+                directoryPath.setPath(directoryPathAsString);
+                directoryPath.reinterpretAsDirectory();
+
+                // The directories of other users cannot be removed, so a failure is not an error:
+                osDirectory staleDirectory(directoryPath);
+                staleDirectory.deleteRecursively();
+            }
+        }
+
+        ::closedir(pTmpfsDirectory);
+    }
+
+#endif
+}
+
 // ---------------------------------------------------------------------------
 // Name:        suSetCurrentProjectLogFilesDirectory
 // Description: Set the project log files directory path.
@@ -42,7 +42,7 @@ suInteroperabilityHelper& suInteroperabilityHelper::instance()
 // Date:        9/11/2011
 // ---------------------------------------------------------------------------
 suInteroperabilityHelper::suInteroperabilityHelper()
-    : _nestedFunctionCount(0)
+    : _nestedFunctionCount(0), _nestedFunctionsEnteredCount(0)
 {
 
 }
@@ -139,6 +139,9 @@ bool suTerminateSpiesUtilitiesModule()
         OS_OUTPUT_DEBUG_LOG(SU_STR_DebugLog_FailedToTerminateAPI, OS_DEBUG_LOG_ERROR);
     }
 
+    // Release the memory occupied by raw data files:
+    suRemoveRawDataTmpfsStagingDirectory();
+
     // Terminate the debug log file:
     suTerminateDebugLogFile();
 
@@ -473,6 +476,9 @@ bool suInitializeSpyToAPIConnection()
         {
             // Via shared memory object:
             retVal = apiConnector.initialize(apiConnectionSharedMemoryObjName);
+
+            // The debugger runs on this machine, so raw data files can be staged on tmpfs:
+            suEnableRawDataTmpfsStagingDirectory(true);
         }
     }
 
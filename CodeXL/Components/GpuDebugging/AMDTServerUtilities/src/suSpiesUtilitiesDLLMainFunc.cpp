@@ -15,6 +15,7 @@
 #include <AMDTBaseTools/Include/AMDTDefinitions.h>
 
 // Local:
+#include <AMDTServerUtilities/Include/suCallsHistoryLogger.h>
 #include <src/suSpiesUtilitiesDLLInitializationFunctions.h>
 
 
@@ -57,8 +58,14 @@ BOOL APIENTRY DllMain(HANDLE hModule, DWORD callReason, LPVOID lpReserved)
         break;
 
         case DLL_THREAD_ATTACH:
-        case DLL_THREAD_DETACH:
             break;
+
+        case DLL_THREAD_DETACH:
+        {
+            // Release the log segments of the terminated thread:
+            suCallsHistoryLogger::onThreadTerminated();
+        }
+        break;
     }
 
     return TRUE;
@@ -0,0 +1,256 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file sbCallStreams.cpp
+///
+//==================================================================================
+
+//------------------------------ sbCallStreams.cpp ------------------------------
+
+// Infra:
+#include <AMDTBaseTools/Include/gtAssert.h>
+#include <AMDTOSAPIWrappers/Include/oaOpenGLIncludes.h>
+
+// OpenGL Server:
+#include <AMDTOpenGLServer/src/gsGlobalVariables.h>
+#include <AMDTOpenGLServer/src/gsMonitoredFunctionPointers.h>
+
+// Local:
+#include <src/sbCallStreams.h>
+
+// Immediate mode rendering: many small vertex calls inside glBegin - glEnd blocks:
+static const sbCallType stat_glImmediateModePattern[] =
+{
+    SB_CALL_GL_BEGIN,
+    SB_CALL_GL_COLOR3F, SB_CALL_GL_VERTEX3F,
+    SB_CALL_GL_COLOR3F, SB_CALL_GL_VERTEX3F,
+    SB_CALL_GL_COLOR3F, SB_CALL_GL_VERTEX3F,
+    SB_CALL_GL_END,
+};
+
+// Vertex arrays rendering: state changes, texture binds and indexed draws:
+static const sbCallType stat_glDrawCallsPattern[] =
+{
+    SB_CALL_GL_CLEAR,
+    SB_CALL_GL_ENABLE, SB_CALL_GL_BIND_TEXTURE, SB_CALL_GL_TEX_PARAMETERI, SB_CALL_GL_TEX_PARAMETERI, SB_CALL_GL_DRAW_ELEMENTS,
+    SB_CALL_GL_BIND_TEXTURE, SB_CALL_GL_TEX_PARAMETERI, SB_CALL_GL_DRAW_ELEMENTS,
+    SB_CALL_GL_BIND_TEXTURE, SB_CALL_GL_TEX_PARAMETERI, SB_CALL_GL_DRAW_ELEMENTS,
+};
+
+#define SB_PATTERN_LENGTH(pattern) (int)(sizeof(pattern) / sizeof(pattern[0]))
+
+static const sbCallMix stat_callMixes[] =
+{
+    { "gl-immediate", stat_glImmediateModePattern, SB_PATTERN_LENGTH(stat_glImmediateModePattern) },
+    { "gl-draw", stat_glDrawCallsPattern, SB_PATTERN_LENGTH(stat_glDrawCallsPattern) },
+};
+
+
+// ---------------------------------------------------------------------------
+// Name:        sbCallMixesAmount
+// Description: Returns the amount of synthetic call mixes
+// ---------------------------------------------------------------------------
+int sbCallMixesAmount()
+{
+    return SB_PATTERN_LENGTH(stat_callMixes);
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        sbGetCallMix
+// Description: Returns a synthetic call mix by its index
+// ---------------------------------------------------------------------------
+const sbCallMix& sbGetCallMix(int mixIndex)
+{
+    GT_ASSERT((0 <= mixIndex) && (mixIndex < sbCallMixesAmount()));
+    return stat_callMixes[mixIndex];
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        sbReplayOpenGLCall
+// Description: Makes an OpenGL call, either through the OpenGL Server wrapper (which
+//              monitors the call and then calls the fake "real" function), or directly
+//              through the fake "real" function pointer.
+// Arguments:   callIndex - varies the call arguments values.
+//              shouldCallWrappers - false to measure the dispatch baseline.
+// ---------------------------------------------------------------------------
+static void sbReplayOpenGLCall(sbCallType callType, unsigned int callIndex, bool shouldCallWrappers)
+{
+    static GLushort stat_indices[6] = { 0, 1, 2, 2, 1, 3 };
+    const gsMonitoredFunctionPointers& realGL = gs_stat_realFunctionPointers;
+
+    GLfloat value = (GLfloat)(callIndex & 0xFF) / 255.0f;
+
+    switch (callType)
+    {
+        case SB_CALL_GL_BEGIN:
+        {
+            GLenum mode = GL_TRIANGLES;
+
+            if (shouldCallWrappers)
+            {
+                glBegin(mode);
+            }
+            else
+            {
+                realGL.glBegin(mode);
+            }
+        }
+        break;
+
+        case SB_CALL_GL_END:
+        {
+            if (shouldCallWrappers)
+            {
+                glEnd();
+            }
+            else
+            {
+                realGL.glEnd();
+            }
+        }
+        break;
+
+        case SB_CALL_GL_VERTEX3F:
+        {
+            if (shouldCallWrappers)
+            {
+                glVertex3f(value, 1.0f - value, 0.0f);
+            }
+            else
+            {
+                realGL.glVertex3f(value, 1.0f - value, 0.0f);
+            }
+        }
+        break;
+
+        case SB_CALL_GL_COLOR3F:
+        {
+            if (shouldCallWrappers)
+            {
+                glColor3f(value, value, 1.0f);
+            }
+            else
+            {
+                realGL.glColor3f(value, value, 1.0f);
+            }
+        }
+        break;
+
+        case SB_CALL_GL_ENABLE:
+        {
+            GLenum cap = ((callIndex & 1) == 0) ? GL_DEPTH_TEST : GL_BLEND;
+
+            if (shouldCallWrappers)
+            {
+                glEnable(cap);
+            }
+            else
+            {
+                realGL.glEnable(cap);
+            }
+        }
+        break;
+
+        case SB_CALL_GL_BIND_TEXTURE:
+        {
+            GLenum target = GL_TEXTURE_2D;
+            GLuint texture = 1 + (callIndex % 16);
+
+            if (shouldCallWrappers)
+            {
+                glBindTexture(target, texture);
+            }
+            else
+            {
+                realGL.glBindTexture(target, texture);
+            }
+        }
+        break;
+
+        case SB_CALL_GL_TEX_PARAMETERI:
+        {
+            GLenum target = GL_TEXTURE_2D;
+            GLenum pname = ((callIndex & 1) == 0) ? GL_TEXTURE_MIN_FILTER : GL_TEXTURE_MAG_FILTER;
+            GLint param = GL_LINEAR;
+
+            if (shouldCallWrappers)
+            {
+                glTexParameteri(target, pname, param);
+            }
+            else
+            {
+                realGL.glTexParameteri(target, pname, param);
+            }
+        }
+        break;
+
+        case SB_CALL_GL_DRAW_ELEMENTS:
+        {
+            GLenum mode = GL_TRIANGLES;
+            GLsizei count = 6;
+            GLenum type = GL_UNSIGNED_SHORT;
+            const GLvoid* indices = stat_indices;
+
+            if (shouldCallWrappers)
+            {
+                glDrawElements(mode, count, type, indices);
+            }
+            else
+            {
+                realGL.glDrawElements(mode, count, type, indices);
+            }
+        }
+        break;
+
+        case SB_CALL_GL_CLEAR:
+        {
+            GLbitfield mask = GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT;
+
+            if (shouldCallWrappers)
+            {
+                glClear(mask);
+            }
+            else
+            {
+                realGL.glClear(mask);
+            }
+        }
+        break;
+
+        default:
+        {
+            // Unexpected value!
+            GT_ASSERT(false);
+        }
+        break;
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        sbReplayCallStream
+// Description: Replays a synthetic call stream
+// Arguments:   callMix - the replayed mix.
+//              callsAmount - the amount of calls to replay.
+//              shouldCallWrappers - true to make the calls through the OpenGL Server
+//                                   wrappers, false to call the fake functions directly.
+// ---------------------------------------------------------------------------
+void sbReplayCallStream(const sbCallMix& callMix, unsigned int callsAmount, bool shouldCallWrappers)
+{
+    int patternPosition = 0;
+
+    for (unsigned int i = 0; i < callsAmount; i++)
+    {
+        sbReplayOpenGLCall(callMix._pCallsPattern[patternPosition], i, shouldCallWrappers);
+
+        patternPosition++;
+
+        if (patternPosition == callMix._callsPatternLength)
+        {
+            patternPosition = 0;
+        }
+    }
+}
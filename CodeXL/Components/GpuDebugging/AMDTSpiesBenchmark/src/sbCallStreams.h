@@ -0,0 +1,47 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file sbCallStreams.h
+///
+//==================================================================================
+
+//------------------------------ sbCallStreams.h ------------------------------
+
+#ifndef __SBCALLSTREAMS_H
+#define __SBCALLSTREAMS_H
+
+// The intercepted calls that the synthetic call streams are made of:
+enum sbCallType
+{
+    SB_CALL_GL_BEGIN,
+    SB_CALL_GL_END,
+    SB_CALL_GL_VERTEX3F,
+    SB_CALL_GL_COLOR3F,
+    SB_CALL_GL_ENABLE,
+    SB_CALL_GL_BIND_TEXTURE,
+    SB_CALL_GL_TEX_PARAMETERI,
+    SB_CALL_GL_DRAW_ELEMENTS,
+    SB_CALL_GL_CLEAR
+};
+
+// ----------------------------------------------------------------------------------
+// Struct Name:          sbCallMix
+// General Description:  A synthetic call stream. The stream repeats a calls pattern
+//                       that is typical to a kind of OpenGL application.
+// ----------------------------------------------------------------------------------
+struct sbCallMix
+{
+    // The mix name, as used in the command line and the results file:
+    const char* _name;
+
+    // The repeated calls pattern:
+    const sbCallType* _pCallsPattern;
+    int _callsPatternLength;
+};
+
+int sbCallMixesAmount();
+const sbCallMix& sbGetCallMix(int mixIndex);
+void sbReplayCallStream(const sbCallMix& callMix, unsigned int callsAmount, bool shouldCallWrappers);
+
+#endif //__SBCALLSTREAMS_H
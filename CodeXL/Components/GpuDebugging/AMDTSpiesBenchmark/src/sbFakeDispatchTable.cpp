@@ -0,0 +1,73 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file sbFakeDispatchTable.cpp
+///
+//==================================================================================
+
+//------------------------------ sbFakeDispatchTable.cpp ------------------------------
+
+// Infra:
+#include <AMDTOSWrappers/Include/osModule.h>
+#include <AMDTOSAPIWrappers/Include/oaOpenGLIncludes.h>
+
+// OpenGL Server:
+#include <AMDTOpenGLServer/src/gsMonitoredFunctionPointers.h>
+#include <AMDTOpenGLServer/src/gsWrappersCommon.h>
+
+// Local:
+#include <src/sbFakeDispatchTable.h>
+
+// The fake functions are only reached through gs_stat_realFunctionPointers, so the compiler cannot
+// remove the calls, just as it cannot remove the calls to the real OpenGL functions.
+static void APIENTRY sbFake_glBegin(GLenum mode) { (void)(mode); }
+static void APIENTRY sbFake_glEnd() {}
+static void APIENTRY sbFake_glVertex3f(GLfloat x, GLfloat y, GLfloat z) { (void)(x); (void)(y); (void)(z); }
+static void APIENTRY sbFake_glColor3f(GLfloat red, GLfloat green, GLfloat blue) { (void)(red); (void)(green); (void)(blue); }
+static void APIENTRY sbFake_glEnable(GLenum cap) { (void)(cap); }
+static void APIENTRY sbFake_glBindTexture(GLenum target, GLuint texture) { (void)(target); (void)(texture); }
+static void APIENTRY sbFake_glTexParameteri(GLenum target, GLenum pname, GLint param) { (void)(target); (void)(pname); (void)(param); }
+static void APIENTRY sbFake_glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices) { (void)(mode); (void)(count); (void)(type); (void)(indices); }
+static void APIENTRY sbFake_glClear(GLbitfield mask) { (void)(mask); }
+
+// Stands for all the other functions, which the OpenGL Server may call while it is initialized
+// or while it monitors the measured calls (e.g. glGetError, glXGetProcAddress). Returning 0
+// reads as GL_NO_ERROR, GL_FALSE or NULL:
+static void* sbFake_otherFunction() { return NULL; }
+
+
+// ---------------------------------------------------------------------------
+// Name:        sbConnectWrappersToFakeOpenGLFunctions
+// Description: Connects the OpenGL Server wrappers to fake "real" OpenGL functions,
+//              instead of the system's OpenGL module functions. Must be called before
+//              the first OpenGL call, which initializes the OpenGL Server.
+// Return Val:  bool - Success / failure.
+// ---------------------------------------------------------------------------
+bool sbConnectWrappersToFakeOpenGLFunctions()
+{
+    static gsMonitoredFunctionPointers stat_fakeFunctionPointers;
+
+    // Each gsMonitoredFunctionPointers member is a function pointer:
+    int functionPointersAmount = (int)(sizeof(gsMonitoredFunctionPointers) / sizeof(osProcedureAddress));
+
+    for (int i = 0; i < functionPointersAmount; i++)
+    {
+        ((osProcedureAddress*)(&stat_fakeFunctionPointers))[i] = (osProcedureAddress)sbFake_otherFunction;
+    }
+
+    // The functions the call mixes make:
+    stat_fakeFunctionPointers.glBegin = sbFake_glBegin;
+    stat_fakeFunctionPointers.glEnd = sbFake_glEnd;
+    stat_fakeFunctionPointers.glVertex3f = sbFake_glVertex3f;
+    stat_fakeFunctionPointers.glColor3f = sbFake_glColor3f;
+    stat_fakeFunctionPointers.glEnable = sbFake_glEnable;
+    stat_fakeFunctionPointers.glBindTexture = sbFake_glBindTexture;
+    stat_fakeFunctionPointers.glTexParameteri = sbFake_glTexParameteri;
+    stat_fakeFunctionPointers.glDrawElements = sbFake_glDrawElements;
+    stat_fakeFunctionPointers.glClear = sbFake_glClear;
+
+    bool retVal = gsInitializeWrapperFunctionsWithStubs(stat_fakeFunctionPointers);
+
+    return retVal;
+}
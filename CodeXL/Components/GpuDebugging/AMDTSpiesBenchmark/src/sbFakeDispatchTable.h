@@ -0,0 +1,17 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file sbFakeDispatchTable.h
+///
+//==================================================================================
+
+//------------------------------ sbFakeDispatchTable.h ------------------------------
+
+#ifndef __SBFAKEDISPATCHTABLE_H
+#define __SBFAKEDISPATCHTABLE_H
+
+// Connects the OpenGL Server wrappers to fake "real" OpenGL functions that do nothing:
+bool sbConnectWrappersToFakeOpenGLFunctions();
+
+#endif //__SBFAKEDISPATCHTABLE_H
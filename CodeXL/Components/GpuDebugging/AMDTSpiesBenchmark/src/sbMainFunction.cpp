@@ -0,0 +1,249 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file sbMainFunction.cpp
+///
+//==================================================================================
+
+//------------------------------ sbMainFunction.cpp ------------------------------
+
+// C:
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Standard C++:
+#include <chrono>
+
+// Infra:
+#include <AMDTAPIClasses/Include/apExecutionMode.h>
+#include <AMDTAPIClasses/Include/apMonitoredFunctionId.h>
+
+// Spies Utilities:
+#include <AMDTServerUtilities/Include/suBreakpointsManager.h>
+#include <AMDTServerUtilities/Include/suGlobalVariables.h>
+
+// OpenGL Server:
+#include <AMDTOpenGLServer/src/gsGlobalVariables.h>
+#include <AMDTOpenGLServer/src/gsOpenGLMonitor.h>
+#include <AMDTOpenGLServer/src/gsOpenGLSpyInitFuncs.h>
+
+// Local:
+#include <src/sbCallStreams.h>
+#include <src/sbFakeDispatchTable.h>
+
+// Default command line values:
+#define SB_DEFAULT_CALLS_AMOUNT 200000
+#define SB_DEFAULT_REPETITIONS_AMOUNT 5
+#define SB_DEFAULT_RESULTS_FILE_PATH "CXLSpiesBenchmarkResults.csv"
+
+// The measured spy stages. "dispatch" is the cost of the fake function call alone, and
+// is subtracted from the other stages to get their overhead:
+struct sbMeasuredStage
+{
+    const char* _name;
+
+    // false to call the fake functions directly, true to call them through the OpenGL Server wrappers:
+    bool _shouldCallWrappers;
+
+    // The debugged process execution mode. In profiling mode the calls are not logged:
+    apExecutionMode _executionMode;
+
+    // true to test the calls against a breakpoints table that holds breakpoints that never trigger:
+    bool _shouldSetBreakpoints;
+};
+
+static const sbMeasuredStage stat_measuredStages[] =
+{
+    { "dispatch", false, AP_DEBUGGING_MODE, false },
+    { "profiling", true, AP_PROFILING_MODE, false },
+    { "debugging", true, AP_DEBUGGING_MODE, false },
+    { "breakpoints", true, AP_DEBUGGING_MODE, true },
+};
+
+#define SB_MEASURED_STAGES_AMOUNT (int)(sizeof(stat_measuredStages) / sizeof(stat_measuredStages[0]))
+
+
+// ---------------------------------------------------------------------------
+// Name:        sbPrintUsage
+// Description: Prints the command line usage
+// ---------------------------------------------------------------------------
+static void sbPrintUsage()
+{
+    printf("Usage: CXLSpiesBenchmark [--calls <amount>] [--repetitions <amount>] [--mix <name>] [--output <file path>]\n");
+    printf("  --calls        The amount of calls replayed per measurement (default: %d).\n", SB_DEFAULT_CALLS_AMOUNT);
+    printf("  --repetitions  The amount of measurements; the fastest one is reported (default: %d).\n", SB_DEFAULT_REPETITIONS_AMOUNT);
+    printf("  --mix          Measure only this call mix. The mixes are:");
+
+    for (int i = 0; i < sbCallMixesAmount(); i++)
+    {
+        printf(" %s", sbGetCallMix(i)._name);
+    }
+
+    printf("\n  --output       The results file (default: %s).\n", SB_DEFAULT_RESULTS_FILE_PATH);
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        sbMeasureNanosecondsPerCall
+// Description: Replays a call mix in a spy stage, and returns the fastest time per
+//              call of all the repetitions.
+// ---------------------------------------------------------------------------
+static double sbMeasureNanosecondsPerCall(const sbCallMix& callMix, const sbMeasuredStage& measuredStage, unsigned int callsAmount, int repetitionsAmount)
+{
+    double retVal = 0.0;
+
+    suSetDebuggedProcessExecutionMode(measuredStage._executionMode);
+
+    // Set breakpoints at functions that the mixes do not call:
+    if (measuredStage._shouldSetBreakpoints)
+    {
+        su_stat_theBreakpointsManager.setBreakpointAtMonitoredFunction(ap_glFlush);
+        su_stat_theBreakpointsManager.setBreakpointAtMonitoredFunction(ap_glFinish);
+    }
+
+    for (int i = 0; i < repetitionsAmount; i++)
+    {
+        // Each repetition starts a new frame, so that the calls history logger starts empty:
+        gs_stat_openGLMonitorInstance.onFrameTerminatorCall();
+
+        // Warm up the caches and let the loggers allocate their initial buffers:
+        sbReplayCallStream(callMix, callsAmount / 10, measuredStage._shouldCallWrappers);
+
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        sbReplayCallStream(callMix, callsAmount, measuredStage._shouldCallWrappers);
+        std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+
+        double nanosecondsPerCall = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count() / (double)callsAmount;
+
+        if ((i == 0) || (nanosecondsPerCall < retVal))
+        {
+            retVal = nanosecondsPerCall;
+        }
+    }
+
+    su_stat_theBreakpointsManager.clearAllBreakPoints();
+    suSetDebuggedProcessExecutionMode(AP_DEBUGGING_MODE);
+
+    return retVal;
+}
+
+
+// ---------------------------------------------------------------------------
+// Name:        main
+// Description: Measures the OpenGL spy per call overhead for each call mix and spy
+//              stage, and writes the results into a CSV file:
+//              mix,stage,calls,ns_per_call,overhead_ns_per_call
+// ---------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    int exitCode = 0;
+
+    unsigned int callsAmount = SB_DEFAULT_CALLS_AMOUNT;
+    int repetitionsAmount = SB_DEFAULT_REPETITIONS_AMOUNT;
+    const char* pMeasuredMixName = NULL;
+    const char* pResultsFilePath = SB_DEFAULT_RESULTS_FILE_PATH;
+
+    // Parse the command line:
+    bool isCommandLineValid = true;
+
+    for (int i = 1; isCommandLineValid && (i < argc); i++)
+    {
+        bool hasValue = (i + 1 < argc);
+
+        if ((strcmp(argv[i], "--calls") == 0) && hasValue)
+        {
+            callsAmount = (unsigned int)strtoul(argv[++i], NULL, 10);
+            isCommandLineValid = (callsAmount > 0);
+        }
+        else if ((strcmp(argv[i], "--repetitions") == 0) && hasValue)
+        {
+            repetitionsAmount = atoi(argv[++i]);
+            isCommandLineValid = (repetitionsAmount > 0);
+        }
+        else if ((strcmp(argv[i], "--mix") == 0) && hasValue)
+        {
+            pMeasuredMixName = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--output") == 0) && hasValue)
+        {
+            pResultsFilePath = argv[++i];
+        }
+        else
+        {
+            isCommandLineValid = false;
+        }
+    }
+
+    // Verify that the measured mix exists:
+    if (isCommandLineValid && (pMeasuredMixName != NULL))
+    {
+        isCommandLineValid = false;
+
+        for (int mixIndex = 0; mixIndex < sbCallMixesAmount(); mixIndex++)
+        {
+            if (strcmp(pMeasuredMixName, sbGetCallMix(mixIndex)._name) == 0)
+            {
+                isCommandLineValid = true;
+            }
+        }
+    }
+
+    if (!isCommandLineValid)
+    {
+        sbPrintUsage();
+        exitCode = 1;
+    }
+    else if (!sbConnectWrappersToFakeOpenGLFunctions() || !gsOpenGLSpyInit())
+    {
+        printf("Could not initialize the OpenGL Server with the fake OpenGL functions\n");
+        exitCode = 1;
+    }
+    else
+    {
+        FILE* pResultsFile = fopen(pResultsFilePath, "w");
+
+        if (pResultsFile == NULL)
+        {
+            printf("Could not open the results file: %s\n", pResultsFilePath);
+            exitCode = 1;
+        }
+        else
+        {
+            fprintf(pResultsFile, "mix,stage,calls,ns_per_call,overhead_ns_per_call\n");
+            printf("%-14s %-12s %14s %14s\n", "mix", "stage", "ns/call", "overhead ns");
+
+            for (int mixIndex = 0; mixIndex < sbCallMixesAmount(); mixIndex++)
+            {
+                const sbCallMix& callMix = sbGetCallMix(mixIndex);
+
+                if ((pMeasuredMixName == NULL) || (strcmp(pMeasuredMixName, callMix._name) == 0))
+                {
+                    double dispatchNanosecondsPerCall = 0.0;
+
+                    for (int stagesIndex = 0; stagesIndex < SB_MEASURED_STAGES_AMOUNT; stagesIndex++)
+                    {
+                        const sbMeasuredStage& measuredStage = stat_measuredStages[stagesIndex];
+                        double nanosecondsPerCall = sbMeasureNanosecondsPerCall(callMix, measuredStage, callsAmount, repetitionsAmount);
+
+                        if (!measuredStage._shouldCallWrappers)
+                        {
+                            dispatchNanosecondsPerCall = nanosecondsPerCall;
+                        }
+
+                        double overheadNanosecondsPerCall = nanosecondsPerCall - dispatchNanosecondsPerCall;
+
+                        fprintf(pResultsFile, "%s,%s,%u,%.2f,%.2f\n", callMix._name, measuredStage._name, callsAmount, nanosecondsPerCall, overheadNanosecondsPerCall);
+                        printf("%-14s %-12s %14.2f %14.2f\n", callMix._name, measuredStage._name, nanosecondsPerCall, overheadNanosecondsPerCall);
+                    }
+                }
+            }
+
+            fclose(pResultsFile);
+        }
+    }
+
+    return exitCode;
+}
+
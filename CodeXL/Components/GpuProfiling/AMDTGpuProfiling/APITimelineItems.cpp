@@ -13,6 +13,12 @@
 // Change list:    $Change: 569613 $
 //=====================================================================
 
+// Qt:
+#include <QPainter>
+
+// std
+#include <algorithm>
+
 // Infra:
 #include <AMDTApplicationComponents/Include/acFunctions.h>
 #include <AMDTApplicationComponents/Include/Timeline/acTimeline.h>
@@ -23,10 +29,10 @@
 #include <AMDTGpuProfiling/gpStringConstants.h>
 
 
-APITimelineItem::APITimelineItem() : acAPITimelineItem(std::numeric_limits<quint64>::max(), std::numeric_limits<quint64>::min(), -1), m_pTraceTableItem(NULL)
+APITimelineItem::APITimelineItem() : acAPITimelineItem(std::numeric_limits<quint64>::max(), std::numeric_limits<quint64>::min(), -1), m_pTraceTableModel(NULL), m_traceTableRow(0)
 {
 }
-APITimelineItem::APITimelineItem(quint64 startTime, quint64 endTime, int apiIndex) : acAPITimelineItem(startTime, endTime, apiIndex), m_pTraceTableItem(NULL)
+APITimelineItem::APITimelineItem(quint64 startTime, quint64 endTime, int apiIndex) : acAPITimelineItem(startTime, endTime, apiIndex), m_pTraceTableModel(NULL), m_traceTableRow(0)
 {
 }
 
@@ -35,9 +41,9 @@ void APITimelineItem::tooltipItems(acTimelineItemToolTip& tooltip) const
     // Add the base class tooltip items:
     acAPITimelineItem::tooltipItems(tooltip);
 
-    if (m_pTraceTableItem != NULL)
+    if (m_pTraceTableModel != NULL)
     {
-        QString strDeviceTime = m_pTraceTableItem->GetColumnData(TraceTableModel::TRACE_DEVICE_TIME_COLUMN).toString();
+        QString strDeviceTime = m_pTraceTableModel->GetColumnStore().GetColumnData(m_traceTableRow, TraceTableModel::TRACE_DEVICE_TIME_COLUMN).toString();
 
         if (!strDeviceTime.isEmpty())
         {
@@ -65,7 +71,7 @@ HostAPITimelineItem::HostAPITimelineItem(quint64 startTime, quint64 endTime, int
 }
 
 
-PerfMarkerTimelineItem::PerfMarkerTimelineItem(quint64 startTime, quint64 endTime) : acTimelineItem(startTime, endTime), m_pTraceTableItem(NULL)
+PerfMarkerTimelineItem::PerfMarkerTimelineItem(quint64 startTime, quint64 endTime) : acTimelineItem(startTime, endTime), m_pTraceTableModel(NULL), m_traceTableRow(0)
 {
 
 }
@@ -104,3 +110,95 @@ void CommandListTimelineItem::tooltipItems(acTimelineItemToolTip& tooltip) const
     QString tooltipLine = QString(GPU_STR_APITimeline_TimeTooltipLine).arg(fnumStartStr).arg(fnumEndStr).arg(durationStr);
     tooltip.add("", tooltipLine);
 }
+
+APIAggregateTimelineItem::APIAggregateTimelineItem(quint64 startTime, quint64 endTime) :
+    acTimelineItem(startTime, endTime), m_callCount(0), m_firstIndexOffset(-1), m_lastIndexOffset(-1), m_isExpanded(false)
+{
+}
+
+void APIAggregateTimelineItem::addCall(const QString& apiName, quint64 startTime, quint64 endTime, qint64 indexOffset)
+{
+    if (m_callCount == 0)
+    {
+        m_firstIndexOffset = indexOffset;
+    }
+
+    m_callCount++;
+    m_apiCallCounts[apiName]++;
+    m_lastIndexOffset = indexOffset;
+    m_nStartTime = qMin(m_nStartTime, startTime);
+    m_nEndTime = qMax(m_nEndTime, endTime);
+}
+
+void APIAggregateTimelineItem::setDetailedCalls(std::vector<DetailedCall>& detailedCalls)
+{
+    m_detailedCalls.swap(detailedCalls);
+    std::sort(m_detailedCalls.begin(), m_detailedCalls.end(), [](const DetailedCall& call, const DetailedCall& otherCall)
+    {
+        return call.m_startTime < otherCall.m_startTime;
+    });
+
+    m_isExpanded = true;
+}
+
+void APIAggregateTimelineItem::draw(QPainter& painter, const int x, const int y, const int w, const int h)
+{
+    if (!m_isExpanded || m_detailedCalls.empty() || (m_nEndTime <= m_nStartTime))
+    {
+        acTimelineItem::draw(painter, x, y, w, h);
+    }
+    else
+    {
+        double pixelsPerNanosecond = static_cast<double>(w) / (m_nEndTime - m_nStartTime);
+        QFontMetrics fontMetrics = painter.fontMetrics();
+
+        painter.save();
+
+        for (const DetailedCall& call : m_detailedCalls)
+        {
+            int callX = x + static_cast<int>((call.m_startTime - m_nStartTime) * pixelsPerNanosecond);
+            int callWidth = std::max(1, static_cast<int>((call.m_endTime - call.m_startTime) * pixelsPerNanosecond));
+            painter.fillRect(callX, y, callWidth, h, call.m_color);
+
+            // The API name is shown only when it fits in the call:
+            if (fontMetrics.width(call.m_apiName) < callWidth)
+            {
+                painter.setPen(m_foregroundColor);
+                painter.drawText(QRect(callX, y, callWidth, h), Qt::AlignCenter, call.m_apiName);
+            }
+        }
+
+        painter.restore();
+    }
+}
+
+void APIAggregateTimelineItem::tooltipItems(acTimelineItemToolTip& tooltip) const
+{
+    tooltip.add(tr("API Calls"), QString::number(m_callCount));
+
+    for (QMap<QString, unsigned int>::const_iterator it = m_apiCallCounts.begin(); it != m_apiCallCounts.end(); ++it)
+    {
+        tooltip.add(it.key(), QString::number(it.value()));
+    }
+
+    quint64 timelineStartTime = 0;
+
+    if ((m_pParentBranch != NULL) && (m_pParentBranch->parentTimeline() != NULL))
+    {
+        timelineStartTime = m_pParentBranch->parentTimeline()->startTime();
+    }
+
+    QString durationStr = NanosecToTimeStringFormatted(m_nEndTime - m_nStartTime, true);
+    QString startStr = NanosecToTimeStringFormatted(m_nStartTime - timelineStartTime, true);
+    QString endStr = NanosecToTimeStringFormatted(m_nEndTime - timelineStartTime, true);
+    tooltip.add("", QString(GPU_STR_APITimeline_TimeTooltipLine).arg(startStr).arg(endStr).arg(durationStr));
+
+    if (m_isExpanded)
+    {
+        tooltip.add("", GPU_STR_APITimeline_AggregateExpandedNote);
+    }
+    else if (m_firstIndexOffset >= 0)
+    {
+        tooltip.add("", GPU_STR_APITimeline_AggregateExpandHint);
+    }
+}
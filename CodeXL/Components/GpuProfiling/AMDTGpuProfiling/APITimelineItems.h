@@ -16,11 +16,16 @@
 #ifndef _API_TIMELINE_ITEMS_H_
 #define _API_TIMELINE_ITEMS_H_
 
+#include <QMap>
+
+// std
+#include <vector>
+
 #include <AMDTApplicationComponents/Include/Timeline/acTimeline.h>
 
 
 //forward declarations
-class TraceTableItem;
+class TraceTableModel;
 
 /// qcAPITimelineItem descendant for API items that have an associated trace table item -- this allows for faster navigation between timeline items and trace table items.
 class APITimelineItem : public acAPITimelineItem
@@ -36,20 +41,26 @@ public:
     /// \param apiIndex the index of this api in the application's call sequence
     APITimelineItem(quint64 startTime, quint64 endTime, int apiIndex);
 
-    /// Gets the trace table item for this API
-    /// \return the trace table item for this API
-    TraceTableItem* traceTableItem() const { return m_pTraceTableItem; }
+    /// Gets the trace table model holding the row of this API
+    /// \return the trace table model, NULL if the API is not in a trace table
+    TraceTableModel* traceTableModel() const { return m_pTraceTableModel; }
 
-    /// Sets the trace table item for this API
-    /// \param newTraceTableItem the trace table item for this API
-    void setTraceTableItem(TraceTableItem* newTraceTableItem) { m_pTraceTableItem = newTraceTableItem; }
+    /// Gets the trace table row of this API
+    /// \return the column store row of this API in the trace table model
+    quint32 traceTableRow() const { return m_traceTableRow; }
+
+    /// Sets the trace table row of this API
+    /// \param pTraceTableModel the trace table model holding the row
+    /// \param traceTableRow the column store row of this API in the trace table model
+    void setTraceTableRow(TraceTableModel* pTraceTableModel, quint32 traceTableRow) { m_pTraceTableModel = pTraceTableModel; m_traceTableRow = traceTableRow; }
 
     /// Fill in a TimelineItemToolTip instance with a set of name/value pairs that will be displayed in the tooltip for this timeline item
     /// \param tooltip acTimelineItemToolTip instance that should get populated with name/value pairs
     virtual void tooltipItems(acTimelineItemToolTip& tooltip) const;
 
 protected:
-    TraceTableItem* m_pTraceTableItem; ///< the trace table item for this API
+    TraceTableModel* m_pTraceTableModel; ///< the trace table model holding the row of this API
+    quint32 m_traceTableRow;             ///< the column store row of this API in the trace table model
 };
 
 /// APITimelineItem descendant for dispatch API items
@@ -110,16 +121,22 @@ public:
     /// \param endTime the end time for this timeline item.
     PerfMarkerTimelineItem(quint64 startTime, quint64 endTime);
 
-    /// Gets the trace table item for this API
-    /// \return the trace table item for this API
-    TraceTableItem* traceTableItem() const { return m_pTraceTableItem; }
+    /// Gets the trace table model holding the row of this API
+    /// \return the trace table model, NULL if the API is not in a trace table
+    TraceTableModel* traceTableModel() const { return m_pTraceTableModel; }
+
+    /// Gets the trace table row of this API
+    /// \return the column store row of this API in the trace table model
+    quint32 traceTableRow() const { return m_traceTableRow; }
 
-    /// Sets the trace table item for this API
-    /// \param newTraceTableItem the trace table item for this API
-    void setTraceTableItem(TraceTableItem* newTraceTableItem) { m_pTraceTableItem = newTraceTableItem; }
+    /// Sets the trace table row of this API
+    /// \param pTraceTableModel the trace table model holding the row
+    /// \param traceTableRow the column store row of this API in the trace table model
+    void setTraceTableRow(TraceTableModel* pTraceTableModel, quint32 traceTableRow) { m_pTraceTableModel = pTraceTableModel; m_traceTableRow = traceTableRow; }
 
 private:
-    TraceTableItem* m_pTraceTableItem; ///< the trace table item for this API
+    TraceTableModel* m_pTraceTableModel; ///< the trace table model holding the row of this API
+    quint32 m_traceTableRow;             ///< the column store row of this API in the trace table model
 };
 
 
@@ -146,6 +163,77 @@ protected:
     QString m_commandListPtr;
 };
 
+/// acTimelineItem descendant that stands for all the API calls made from a host API branch within a time bucket.
+/// Used once the session has more API calls than can be loaded in full detail. The calls are loaded in full detail from the
+/// session index when the item is clicked. Once expanded, the item draws the calls in place of the aggregate block, so that
+/// the items of the host API branch stay in call order
+class APIAggregateTimelineItem : public acTimelineItem
+{
+    Q_OBJECT
+
+public:
+    /// An API call loaded in full detail
+    struct DetailedCall
+    {
+        quint64 m_startTime;    ///< the API start time
+        quint64 m_endTime;      ///< the API end time
+        QString m_apiName;      ///< the API name
+        QColor m_color;         ///< the API color
+    };
+
+    /// Initializes a new instance of the APIAggregateTimelineItem class
+    /// \param startTime the start time of the first aggregated call
+    /// \param endTime the end time of the first aggregated call
+    APIAggregateTimelineItem(quint64 startTime, quint64 endTime);
+
+    /// Adds an API call to the aggregate
+    /// \param apiName the API name
+    /// \param startTime the API start time
+    /// \param endTime the API end time
+    /// \param indexOffset the offset of the API record in the session index
+    void addCall(const QString& apiName, quint64 startTime, quint64 endTime, qint64 indexOffset);
+
+    /// Gets the number of aggregated calls
+    /// \return the number of aggregated calls
+    unsigned int callCount() const { return m_callCount; }
+
+    /// Gets the session index offset of the first aggregated call
+    /// \return the session index offset of the first aggregated call, or -1 if the calls are not in the session index
+    qint64 firstIndexOffset() const { return m_firstIndexOffset; }
+
+    /// Gets the session index offset of the last aggregated call
+    /// \return the session index offset of the last aggregated call, or -1 if the calls are not in the session index
+    qint64 lastIndexOffset() const { return m_lastIndexOffset; }
+
+    /// Gets a flag indicating whether the aggregated calls were already loaded in full detail
+    /// \return true iff the aggregated calls were already loaded in full detail
+    bool isExpanded() const { return m_isExpanded; }
+
+    /// Sets the aggregated calls loaded in full detail, and marks the item as expanded
+    /// \param detailedCalls the calls. The vector is taken by the item, and sorted by start time
+    void setDetailedCalls(std::vector<DetailedCall>& detailedCalls);
+
+    /// Draws the item. An expanded item draws each of its calls, otherwise the aggregate block is drawn
+    /// \param painter the painter
+    /// \param x the left of the item
+    /// \param y the top of the item
+    /// \param w the width of the item
+    /// \param h the height of the item
+    virtual void draw(QPainter& painter, const int x, const int y, const int w, const int h);
+
+    /// Fill in a TimelineItemToolTip instance with a set of name/value pairs that will be displayed in the tooltip for this timeline item
+    /// \param tooltip acTimelineItemToolTip instance that should get populated with name/value pairs
+    virtual void tooltipItems(acTimelineItemToolTip& tooltip) const;
+
+private:
+    unsigned int m_callCount;                       ///< the number of aggregated calls
+    QMap<QString, unsigned int> m_apiCallCounts;    ///< the number of aggregated calls of each API
+    qint64 m_firstIndexOffset;                      ///< the session index offset of the first aggregated call
+    qint64 m_lastIndexOffset;                       ///< the session index offset of the last aggregated call
+    bool m_isExpanded;                              ///< true iff the aggregated calls were loaded in full detail
+    std::vector<DetailedCall> m_detailedCalls;      ///< the calls loaded in full detail, sorted by start time
+};
+
 
 
 #endif // _API_TIMELINE_ITEMS_H_
@@ -73,9 +73,9 @@ void CLAPITimelineItem::tooltipItems(acTimelineItemToolTip& tooltip) const
     // Add the base class tooltip items:
     QString strCPUTime;
 
-    if (m_pTraceTableItem != NULL)
+    if (m_pTraceTableModel != NULL)
     {
-        strCPUTime = m_pTraceTableItem->GetColumnData(TraceTableModel::TRACE_CPU_TIME_COLUMN).toString();
+        strCPUTime = m_pTraceTableModel->GetColumnStore().GetColumnData(m_traceTableRow, TraceTableModel::TRACE_CPU_TIME_COLUMN).toString();
 
         if (!strCPUTime.isEmpty())
         {
@@ -83,7 +83,7 @@ void CLAPITimelineItem::tooltipItems(acTimelineItemToolTip& tooltip) const
             strCPUTime = getDurationString(cpuTime);
         }
 
-        QString strDeviceTime = m_pTraceTableItem->GetColumnData(TraceTableModel::TRACE_DEVICE_TIME_COLUMN).toString();
+        QString strDeviceTime = m_pTraceTableModel->GetColumnStore().GetColumnData(m_traceTableRow, TraceTableModel::TRACE_DEVICE_TIME_COLUMN).toString();
 
         if (!strDeviceTime.isEmpty())
         {
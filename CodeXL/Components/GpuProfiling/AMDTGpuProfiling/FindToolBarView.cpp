@@ -14,6 +14,7 @@
 //=====================================================================
 
 #include "FindToolBarView.h"
+#include <AMDTGpuProfiling/gpStringConstants.h>
 
 
 FindToolBarView::FindToolBarView(QWidget* parent)
@@ -22,6 +23,17 @@ FindToolBarView::FindToolBarView(QWidget* parent)
     setParent(parent);
 
     setFixedHeight(46);
+
+    lineEdit->setPlaceholderText(GPU_STR_TraceSearchPlaceholder);
+    lineEdit->setToolTip(GPU_STR_TraceSearchPlaceholder);
+
+    connect(lineEdit, SIGNAL(textChanged(const QString&)), this, SIGNAL(FindQueryChanged()));
+    connect(checkBoxMatchCase, SIGNAL(toggled(bool)), this, SIGNAL(FindQueryChanged()));
+    connect(checkBoxmatchRegexp, SIGNAL(toggled(bool)), this, SIGNAL(FindQueryChanged()));
+    connect(checkBoxFilter, SIGNAL(toggled(bool)), this, SIGNAL(FilterModeChanged(bool)));
+    connect(lineEdit, SIGNAL(returnPressed()), this, SIGNAL(FindNext()));
+    connect(pushButtonFindNext, SIGNAL(clicked()), this, SIGNAL(FindNext()));
+    connect(pushButtonFindPrevious, SIGNAL(clicked()), this, SIGNAL(FindPrevious()));
 }
 
 
@@ -29,6 +41,19 @@ FindToolBarView::~FindToolBarView()
 {
 }
 
+void FindToolBarView::SetStatusText(const QString& strStatus, bool isError)
+{
+    QPalette statusPalette = palette();
+
+    if (isError)
+    {
+        statusPalette.setColor(QPalette::WindowText, Qt::red);
+    }
+
+    labelStatus->setPalette(statusPalette);
+    labelStatus->setText(strStatus);
+}
+
 
 
 
@@ -21,15 +21,48 @@
 #include "ui_FindToolBar.h"
 
 
-/// UI for Find toolbar (currently unused in CodeXL)
+/// UI for the Find toolbar of the trace view. The toolbar only holds the query; the trace view runs it
 class FindToolBarView : public QWidget, private Ui::FindToolBar
 {
+    Q_OBJECT
+
 public:
     /// Initializes a new instance of the FindToolBarView class.
     FindToolBarView(QWidget* parent = 0);
 
     /// Destructor
     ~FindToolBarView();
+
+    /// \return the query text
+    QString GetQueryText() const { return lineEdit->text(); }
+
+    /// \return true iff the query is case sensitive
+    bool IsMatchCase() const { return checkBoxMatchCase->isChecked(); }
+
+    /// \return true iff the query text terms are regular expressions
+    bool IsRegex() const { return checkBoxmatchRegexp->isChecked(); }
+
+    /// \return true iff only the matched items should be shown
+    bool IsFilterMode() const { return checkBoxFilter->isChecked(); }
+
+    /// Displays the search status
+    /// \param strStatus the status text
+    /// \param isError true iff the status is an error (i.e. an invalid query)
+    void SetStatusText(const QString& strStatus, bool isError);
+
+signals:
+    /// Emitted when the query text or one of its options changes
+    void FindQueryChanged();
+
+    /// Emitted when the next match is requested
+    void FindNext();
+
+    /// Emitted when the previous match is requested
+    void FindPrevious();
+
+    /// Emitted when the filter mode changes
+    /// \param isFilterMode true iff only the matched items should be shown
+    void FilterModeChanged(bool isFilterMode);
 };
 
 #endif // _FIND_TOOL_BAR_VIEW_H_
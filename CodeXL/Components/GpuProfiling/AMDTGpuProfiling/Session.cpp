@@ -39,7 +39,8 @@ GPUSessionTreeItemData::GPUSessionTreeItemData(const QString& strName,
                                                const QString& strSessionFilePath,
                                                const QString& strProjName,
                                                GPUProfileType profileType,
-                                               bool isImported)
+                                               bool isImported,
+                                               bool isPropertiesLoadDeferred)
     : SessionTreeNodeData()
 {
     m_workingDirectory = strWorkingDirectory;
@@ -60,11 +61,16 @@ GPUSessionTreeItemData::GPUSessionTreeItemData(const QString& strName,
     m_properties.clear();
     m_propertyLinesCount = 0;
     m_isPropertySectionLoaded = false;
+    m_isPropertiesLoadDeferred = isPropertiesLoadDeferred;
     m_versionMajor = m_versionMinor = -1;
     m_sessionAPIToTrace = APIToTrace_OPENCL;
 
     // call LoadProperties so that a renamed session will show the correct name
-    LoadProperties(strSessionFilePath);
+    if (!m_isPropertiesLoadDeferred)
+    {
+        LoadProperties(strSessionFilePath);
+    }
+
     m_isImported = isImported;
     m_displayName = strName;
 
@@ -81,6 +87,7 @@ GPUSessionTreeItemData::GPUSessionTreeItemData(const GPUSessionTreeItemData& oth
     m_occupancyFileLoadExecuted = other.m_occupancyFileLoadExecuted;
     m_propertyLinesCount = other.m_propertyLinesCount;
     m_isPropertySectionLoaded = other.m_isPropertySectionLoaded;
+    m_isPropertiesLoadDeferred = other.m_isPropertiesLoadDeferred;
     m_versionMajor = other.m_versionMajor;
 
     foreach (QString additionalFile, other.m_additionalFiles)
@@ -479,6 +486,9 @@ void GPUSessionTreeItemData::SetDisplayName(const QString& displayName)
 
 bool GPUSessionTreeItemData::UpdateDisplayNameInOutputFile(const QString& displayName, QString& errorMessage)
 {
+    // The properties section is rewritten from the loaded properties:
+    LoadDeferredProperties();
+
     bool foundExisting = false;
 
     for (QList<QPair<QString, QString> >::iterator it = m_properties.begin(); it != m_properties.end(); ++it)
@@ -523,6 +533,8 @@ QString GPUSessionTreeItemData::GetOccupancyFile() const
 
 int GPUSessionTreeItemData::GetPropertyCount()
 {
+    LoadDeferredProperties();
+
     // Sanity check:
     GT_IF_WITH_ASSERT(m_pParentData != nullptr)
     {
@@ -533,6 +545,8 @@ int GPUSessionTreeItemData::GetPropertyCount()
 
 bool GPUSessionTreeItemData::GetProperty(const QString& strPropName, QString& strPropValue)
 {
+    LoadDeferredProperties();
+
     // Sanity check:
     GT_IF_WITH_ASSERT(m_pParentData != nullptr)
     {
@@ -555,6 +569,33 @@ bool GPUSessionTreeItemData::GetProperty(const QString& strPropName, QString& st
     return retVal;
 }
 
+void GPUSessionTreeItemData::LoadDeferredProperties()
+{
+    if (m_isPropertiesLoadDeferred)
+    {
+        m_isPropertiesLoadDeferred = false;
+
+        QString exeName = m_exeName;
+        QString exeFullPath = m_exeFullPath;
+        QString commandArguments = m_commandArguments;
+        QString workingDirectory = m_workingDirectory;
+        gtString envVariables = m_envVariables;
+        QString displayName = m_displayName;
+
+        // In VS, the item file path is the temporary file which points to the session file:
+        osFilePath sessionFilePath;
+        GetSessionCSVFile(sessionFilePath);
+        LoadProperties(acGTStringToQString(sessionFilePath.asString()));
+
+        m_exeName = exeName;
+        m_exeFullPath = exeFullPath;
+        m_commandArguments = commandArguments;
+        m_workingDirectory = workingDirectory;
+        m_envVariables = envVariables;
+        m_displayName = displayName;
+    }
+}
+
 int GPUSessionTreeItemData::GetVersionMajor() const
 {
     return m_versionMajor;
@@ -683,13 +724,15 @@ TraceSession::TraceSession(const QString& strName,
                            const QString& strWorkingDirectory,
                            const QString& strSessionFilePath,
                            const QString& strProjName,
-                           bool isImported)
+                           bool isImported,
+                           bool isPropertiesLoadDeferred)
     : GPUSessionTreeItemData(strName,
                              strWorkingDirectory,
                              strSessionFilePath,
                              strProjName,
                              API_TRACE,
-                             isImported),
+                             isImported,
+                             isPropertiesLoadDeferred),
       m_exlcudedAPIsChecked(false)
 {
 }
@@ -788,13 +831,15 @@ PerformanceCounterSession::PerformanceCounterSession(const QString& strName,
                                                      const QString& strWorkingDirectory,
                                                      const QString& strSessionFilePath,
                                                      const QString& strProjName,
-                                                     bool isImported)
+                                                     bool isImported,
+                                                     bool isPropertiesLoadDeferred)
     : GPUSessionTreeItemData(strName,
                              strWorkingDirectory,
                              strSessionFilePath,
                              strProjName,
                              PERFORMANCE,
-                             isImported)
+                             isImported,
+                             isPropertiesLoadDeferred)
 {
 }
 
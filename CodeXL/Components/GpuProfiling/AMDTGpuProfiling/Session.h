@@ -43,12 +43,14 @@ public:
     /// \param strProjName project name
     /// \param profileType the type of profile performed
     /// \param isImported is the session imported
+    /// \param isPropertiesLoadDeferred true to read the session file properties only when they are first needed (see LoadDeferredProperties)
     GPUSessionTreeItemData(const QString& strName,
                            const QString& strWorkingDirectory,
                            const QString& strSessionFilePath,
                            const QString& strProjName,
                            GPUProfileType profileType,
-                           bool isImported);
+                           bool isImported,
+                           bool isPropertiesLoadDeferred = false);
 
     /// Copy constructor
     /// \param other the other session to copy from
@@ -86,6 +88,11 @@ public:
     /// \return true if the property is found, false otherwise
     bool GetProperty(const QString& strPropName, QString& strPropValue);
 
+    /// Reads the session file properties, if reading them was deferred when the session was created.
+    /// The session tree fields (executable, arguments, working directory, environment) are kept, since they were already set
+    /// from the session catalog, and possibly from the project settings since
+    void LoadDeferredProperties();
+
     /// Gets the major version number of the session file
     /// \return the major version number of the session file
     int GetVersionMajor() const;
@@ -185,6 +192,7 @@ private:
     void AddProperty(const QString& input);
 
     bool                               m_isPropertySectionLoaded; ///< Flag indicating if the properties section has been loaded
+    bool                               m_isPropertiesLoadDeferred;///< Flag indicating that the properties section was not read yet, see LoadDeferredProperties
     int                                m_propertyLinesCount;      ///< Number of lines for property section
     bool                               m_propertyAdded;           ///< Flag indicating that a property was added
     bool                               m_occupancyFileIsLoaded;   ///< Value indicating whether occupancy file is loaded
@@ -212,11 +220,13 @@ public:
     /// \param strSessionOutputFile the session's output file
     /// \param strProjName project name
     /// \param isImported is the session imported
+    /// \param isPropertiesLoadDeferred true to read the session file properties only when they are first needed
     TraceSession(const QString& strName,
                  const QString& strWorkingDirectory,
                  const QString& strSessionFilePath,
                  const QString& strProjName,
-                 bool isImported);
+                 bool isImported,
+                 bool isPropertiesLoadDeferred = false);
 
     /// Destructor
     virtual ~TraceSession();
@@ -265,11 +275,13 @@ public:
     /// \param strSessionFilePath the session file path
     /// \param strProjName project name
     /// \param isImported is the session imported
+    /// \param isPropertiesLoadDeferred true to read the session file properties only when they are first needed
     PerformanceCounterSession(const QString& strName,
                               const QString& strWorkingDirectory,
                               const QString& strSessionFilePath,
                               const QString& strProjName,
-                              bool isImported);
+                              bool isImported,
+                              bool isPropertiesLoadDeferred = false);
 
     /// Destructor
     virtual ~PerformanceCounterSession();
@@ -54,7 +54,7 @@ SessionManager::~SessionManager()
 }
 
 GPUSessionTreeItemData* SessionManager::AddSession(const QString& strSessionDisplayName, const QString& strWorkingDirectory, const QString& strSessionOutputFile,
-                                                   const QString& strProjName, GPUProfileType profileType, bool isImported)
+                                                   const QString& strProjName, GPUProfileType profileType, bool isImported, const gpSessionCatalogEntry* pCatalogEntry)
 {
     GPUSessionTreeItemData* pRetVal = nullptr;
     GT_IF_WITH_ASSERT(m_pProfileTreeHandler != nullptr)
@@ -65,13 +65,16 @@ GPUSessionTreeItemData* SessionManager::AddSession(const QString& strSessionDisp
 
         if (pItemData == nullptr)
         {
+            // A session from the session catalog reads its session file properties when they are first needed:
+            bool isPropertiesLoadDeferred = (pCatalogEntry != nullptr);
+
             if (profileType == API_TRACE)
             {
-                pRetVal = new TraceSession(strSessionDisplayName, strWorkingDirectory, strSessionOutputFile, strProjName, isImported);
+                pRetVal = new TraceSession(strSessionDisplayName, strWorkingDirectory, strSessionOutputFile, strProjName, isImported, isPropertiesLoadDeferred);
             }
             else if (profileType == PERFORMANCE)
             {
-                pRetVal = new PerformanceCounterSession(strSessionDisplayName, strWorkingDirectory, strSessionOutputFile, strProjName, isImported);
+                pRetVal = new PerformanceCounterSession(strSessionDisplayName, strWorkingDirectory, strSessionOutputFile, strProjName, isImported, isPropertiesLoadDeferred);
             }
 
             // Sanity check:
@@ -85,7 +88,16 @@ GPUSessionTreeItemData* SessionManager::AddSession(const QString& strSessionDisp
 
                 // Set the profile type:
                 pRetVal->m_profileTypeStr = Util::GetProfileTypeName(profileType);
-                pRetVal->SearchForAdditionalFiles();
+
+                if (pCatalogEntry != nullptr)
+                {
+                    RestoreSessionFromCatalogEntry(pRetVal, *pCatalogEntry);
+                }
+                else
+                {
+                    pRetVal->SearchForAdditionalFiles();
+                }
+
                 m_sessionsVector.push_back(pRetVal);
             }
         }
@@ -314,10 +326,31 @@ QList<GPUSessionTreeItemData*> SessionManager::LoadProjectProfileSessions(QStrin
 
     gtString projectFolderString = projectFilePath.fileDirectoryAsString();
     projectFolderString.append(osFilePath::osPathSeparator);
-    QDir projectProfilesQDir(acGTStringToQString(projectFolderString));
-    QFileInfoList sessionDirs = projectProfilesQDir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Time | QDir::Reversed);
-    // sort the directories by creation date, so the sessions appear chronologically
-    qSort(sessionDirs.begin(), sessionDirs.end(), CompareDirOnSessionIndex);
+    QString projectProfilesDirPath = acGTStringToQString(projectFolderString);
+    QDir projectProfilesQDir(projectProfilesDirPath);
+
+    // The session catalog holds the sessions found by the previous load. While the profile output directory is not modified,
+    // its session directories are the catalog entries, so the directory is not listed:
+    gpSessionCatalog sessionCatalog;
+    bool isCatalogLoaded = sessionCatalog.Load(projectProfilesDirPath);
+    bool isCatalogModified = !isCatalogLoaded;
+    gpSessionCatalog updatedSessionCatalog;
+    QFileInfoList sessionDirs;
+
+    if (isCatalogLoaded && sessionCatalog.IsComplete(projectProfilesDirPath))
+    {
+        for (const gpSessionCatalogEntry& catalogEntry : sessionCatalog.GetEntries())
+        {
+            sessionDirs << QFileInfo(projectProfilesQDir.filePath(catalogEntry.m_sessionDirName));
+        }
+    }
+    else
+    {
+        sessionDirs = projectProfilesQDir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Time | QDir::Reversed);
+        // sort the directories by creation date, so the sessions appear chronologically
+        qSort(sessionDirs.begin(), sessionDirs.end(), CompareDirOnSessionIndex);
+        isCatalogModified = true;
+    }
 
     foreach (QFileInfo currentSessionDir, sessionDirs)
     {
@@ -327,47 +360,78 @@ QList<GPUSessionTreeItemData*> SessionManager::LoadProjectProfileSessions(QStrin
         {
             QString strOutputDirectory = currentSessionDir.absoluteFilePath();
             QDir dSession(strOutputDirectory);
-            QFileInfoList sessionFiles = dSession.entryInfoList();
+            QString strOutputFile;
+            GPUProfileType profileType = NA_PROFILE_TYPE;
+
+            // A session directory which was not modified since its catalog entry was recorded is not scanned:
+            const gpSessionCatalogEntry* pCatalogEntry = sessionCatalog.FindEntry(sessionDirName);
+
+            if ((pCatalogEntry != nullptr) && !gpSessionCatalog::IsEntryValid(*pCatalogEntry, strOutputDirectory))
+            {
+                pCatalogEntry = nullptr;
+            }
 
-            foreach (QFileInfo fFile, sessionFiles)
+            if (pCatalogEntry != nullptr)
+            {
+                strOutputFile = dSession.filePath(pCatalogEntry->m_sessionFileName);
+                profileType = static_cast<GPUProfileType>(pCatalogEntry->m_profileType);
+            }
+            else
             {
-                bool isSessionFile = false;
-                GPUProfileType profileType = NA_PROFILE_TYPE;
+                isCatalogModified = true;
+                QFileInfoList sessionFiles = dSession.entryInfoList();
 
-                if (fFile.fileName().endsWith(GP_CSV_FileExtension))
+                foreach (QFileInfo fFile, sessionFiles)
                 {
-                    isSessionFile = true;
-                    profileType = PERFORMANCE;
+                    if (fFile.fileName().endsWith(GP_CSV_FileExtension))
+                    {
+                        profileType = PERFORMANCE;
+                    }
+                    else if (fFile.fileName().endsWith(GP_ATP_FileExtension))
+                    {
+                        profileType = API_TRACE;
+                    }
+
+                    if (profileType != NA_PROFILE_TYPE)
+                    {
+                        strOutputFile = fFile.filePath();
+                        break;
+                    }
                 }
-                else if (fFile.fileName().endsWith(GP_ATP_FileExtension))
+            }
+
+            if (profileType != NA_PROFILE_TYPE)
+            {
+                // use the dir name as the default session name (same behavior as APP Profiler)
+                QString strSessionName = dSession.dirName();
+                bool isImported = strSessionName.endsWith("_Imported");
+
+                if (isImported)
                 {
-                    isSessionFile = true;
-                    profileType = API_TRACE;
+                    strSessionName.replace("_Imported", "");
                 }
 
-                if (isSessionFile)
+                if (!strOutputDirectory.endsWith(QDir::separator()))
                 {
-                    // use the dir name as the default session name (same behavior as APP Profiler)
-                    QString strSessionName = dSession.dirName();
-                    bool isImported = strSessionName.endsWith("_Imported");
+                    strOutputDirectory.append(QDir::separator());
+                }
 
-                    if (isImported)
-                    {
-                        strSessionName.replace("_Imported", "");
-                    }
+                QString projNameToUse = projName;
 
-                    QString strOutputFile = fFile.filePath();
+                // Create the session item data from the session file path
+                GPUSessionTreeItemData* pSession = AddSession(strSessionName, workingDirectory, strOutputFile, projNameToUse, profileType, isImported, pCatalogEntry);
 
-                    if (!strOutputDirectory.endsWith(QDir::separator()))
+                GT_IF_WITH_ASSERT(pSession != nullptr)
+                {
+                    // Record the session before the project settings are applied, so that the entry holds what was read from the session files:
+                    if (pCatalogEntry != nullptr)
                     {
-                        strOutputDirectory.append(QDir::separator());
+                        updatedSessionCatalog.AddEntry(*pCatalogEntry);
+                    }
+                    else
+                    {
+                        updatedSessionCatalog.AddEntry(BuildSessionCatalogEntry(pSession, strOutputDirectory, strOutputFile));
                     }
-
-                    QString projNameToUse = projName;
-                    QDir outputDir(strOutputDirectory);
-
-                    // Create the session item data from the session file path
-                    GPUSessionTreeItemData* pSession = AddSession(strSessionName, workingDirectory, strOutputFile, projNameToUse, profileType, isImported);
 
                     // Fill in the session data from the project settings
                     pSession->m_commandArguments = acGTStringToQString(projectSettings.commandLineArguments());
@@ -380,26 +444,86 @@ QList<GPUSessionTreeItemData*> SessionManager::LoadProjectProfileSessions(QStrin
                         pSession->m_envVariables.appendFormattedString(L"%ls=%ls;", (*iter)._name.asCharArray(), (*iter)._value.asCharArray());
                     }
 
-                    GT_IF_WITH_ASSERT(pSession != nullptr)
-                    {
-                        sessionList.append(pSession);
-                    }
-                    else
-                    {
-                        QString s = QString("Could not load\"%1\" of \"%2\"\n") .arg(sessionDirName) .arg(strOutputFile);
-                        strErrMsg.append(s);
-                    }
-
-                    break;
+                    sessionList.append(pSession);
+                }
+                else
+                {
+                    QString s = QString("Could not load\"%1\" of \"%2\"\n") .arg(sessionDirName) .arg(strOutputFile);
+                    strErrMsg.append(s);
                 }
             }
-
+        }
+        else
+        {
+            isCatalogModified = true;
         }
     }
 
+    if (isCatalogModified && projectProfilesQDir.exists())
+    {
+        // The catalog is an optimization only, so failing to save it is not reported:
+        updatedSessionCatalog.Save(projectProfilesDirPath);
+    }
+
     return sessionList;
 }
 
+void SessionManager::RestoreSessionFromCatalogEntry(GPUSessionTreeItemData* pSession, const gpSessionCatalogEntry& catalogEntry)
+{
+    // Sanity check:
+    GT_IF_WITH_ASSERT((pSession != nullptr) && (pSession->m_pParentData != nullptr))
+    {
+        // The fields set from the session file properties:
+        pSession->m_exeName = catalogEntry.m_exeName;
+        pSession->m_workingDirectory = catalogEntry.m_workingDirectory;
+        pSession->m_envVariables = acQStringToGTString(catalogEntry.m_envVariables);
+
+        // The files found in the session directory:
+        QDir sessionDir(acGTStringToQString(pSession->SessionDir().directoryPath().asString()));
+        QStringList additionalFiles;
+
+        foreach (QString fileName, catalogEntry.m_additionalFileNames)
+        {
+            additionalFiles << Util::ToQtPath(sessionDir.filePath(fileName));
+        }
+
+        pSession->SetAdditionalFiles(additionalFiles);
+
+        if (!catalogEntry.m_occupancyFileName.isEmpty())
+        {
+            pSession->SetOccupancyFile(QDir::toNativeSeparators(sessionDir.filePath(catalogEntry.m_occupancyFileName)));
+        }
+    }
+}
+
+gpSessionCatalogEntry SessionManager::BuildSessionCatalogEntry(GPUSessionTreeItemData* pSession, const QString& strSessionDirectory, const QString& strSessionFile)
+{
+    gpSessionCatalogEntry catalogEntry;
+
+    // Sanity check:
+    GT_IF_WITH_ASSERT(pSession != nullptr)
+    {
+        QFileInfo sessionFileInfo(strSessionFile);
+
+        catalogEntry.m_sessionDirName = QDir(strSessionDirectory).dirName();
+        catalogEntry.m_sessionDirModifiedTime = gpSessionCatalog::GetModifiedTime(strSessionDirectory);
+        catalogEntry.m_sessionFileName = sessionFileInfo.fileName();
+        catalogEntry.m_sessionFileModifiedTime = gpSessionCatalog::GetModifiedTime(strSessionFile);
+        catalogEntry.m_profileType = pSession->GetProfileType();
+        catalogEntry.m_exeName = pSession->m_exeName;
+        catalogEntry.m_workingDirectory = pSession->m_workingDirectory;
+        catalogEntry.m_envVariables = acGTStringToQString(pSession->m_envVariables);
+        catalogEntry.m_occupancyFileName = pSession->OccupancyFile().isEmpty() ? QString() : QFileInfo(pSession->OccupancyFile()).fileName();
+
+        foreach (QString additionalFile, pSession->GetAdditionalFiles())
+        {
+            catalogEntry.m_additionalFileNames << QFileInfo(additionalFile).fileName();
+        }
+    }
+
+    return catalogEntry;
+}
+
 void SessionManager::CheckAndDeleteSessionFiles()
 {
     QMessageBox::StandardButton dlgResult = QMessageBox::No; // default
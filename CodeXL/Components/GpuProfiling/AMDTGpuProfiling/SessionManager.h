@@ -25,6 +25,7 @@
 #include <TSingleton.h>
 
 #include <AMDTGpuProfiling/AMDTGpuProfilerDefs.h>
+#include <AMDTGpuProfiling/gpSessionCatalog.h>
 
 #include "Session.h"
 #include "GlobalSettings.h"
@@ -48,9 +49,12 @@ public:
     /// \param strProjName project name
     /// \param profileType the type of profile performed
     /// \param isImported flag indicating whether or not this session is imported
+    /// \param pCatalogEntry the session catalog entry of the session, if it is still valid. The session file properties are
+    ///        then read when first needed, and the additional files are taken from the entry instead of the session directory
     /// \return Newly created session
     GPUSessionTreeItemData* AddSession(const QString& strName, const QString& strWorkingDirectory,
-                                       const QString& strSessionOutputFile, const QString& strProjName, GPUProfileType profileType, bool isImported);
+                                       const QString& strSessionOutputFile, const QString& strProjName, GPUProfileType profileType, bool isImported,
+                                       const gpSessionCatalogEntry* pCatalogEntry = nullptr);
 
     /// Add a session from a file
     /// \param strSessionName the name of the session to add
@@ -76,7 +80,8 @@ public:
     /// \return list of sessions loaded
     QString GetProjectNameFromFullName(const QString& strFullPath);
 
-    /// Load previous session
+    /// Load previous session. The sessions are taken from the project session catalog, and only the session directories
+    /// which were modified since the catalog was saved are scanned
     /// \param strErrMsg output error message
     /// \return list of sessions loaded
     QList<GPUSessionTreeItemData*> LoadProjectProfileSessions(QString& strErrMsg);
@@ -96,6 +101,18 @@ private:
     /// Destroys the singleton instance of the SessionManager class.
     ~SessionManager();
 
+    /// Sets the session data recorded in a session catalog entry
+    /// \param pSession the session
+    /// \param catalogEntry the catalog entry of the session
+    void RestoreSessionFromCatalogEntry(GPUSessionTreeItemData* pSession, const gpSessionCatalogEntry& catalogEntry);
+
+    /// Builds the session catalog entry of a session which was loaded from its session directory
+    /// \param pSession the session
+    /// \param strSessionDirectory the session directory
+    /// \param strSessionFile the session output file
+    /// \return the catalog entry
+    gpSessionCatalogEntry BuildSessionCatalogEntry(GPUSessionTreeItemData* pSession, const QString& strSessionDirectory, const QString& strSessionFile);
+
     ///< Vector containing the sessions:
     gtVector<GPUSessionTreeItemData*> m_sessionsVector;
     ProfileApplicationTreeHandler* m_pProfileTreeHandler;
@@ -36,13 +36,27 @@
 #include <AMDTApplicationFramework/src/afUtils.h>
 
 #include "SummaryView.h"
+#include "gpStringConstants.h"
+
+/// The role holding the value a summary cell is sorted by
+static const int s_SORT_ROLE = Qt::UserRole + 1;
+
+/// The role of the first cell of a summary row, holding the index of the row in its summary page
+static const int s_ROW_INDEX_ROLE = Qt::UserRole + 2;
+
+/// The number of decimals shown for times, percentages, sizes and rates
+static const int s_DECIMALS = 3;
 
 
 SummaryView::SummaryView(QWidget* parent) :
     QWidget(parent),
     m_pSummarizer(nullptr),
-    m_newestPageIndex(-1),
-    m_currentPageIndex(-1),
+    m_pSummaryModel(nullptr),
+    m_displayedPageType(GP_TRACE_SUMMARY_PAGES_COUNT),
+    m_hasSelectedRange(false),
+    m_selectedRangeStart(0),
+    m_selectedRangeEnd(0),
+    m_pDisplayedTraceSession(nullptr),
     m_loading(false),
     m_pContextMenu(nullptr),
     m_pCopyAction(nullptr),
@@ -51,19 +65,18 @@ SummaryView::SummaryView(QWidget* parent) :
 {
     setupUi(this);
 
-    // Set the zoom factor to fit the resolution. QWebEngineView assumes 96 DPI.
-    QWidget* pScreen = QApplication::desktop()->screen();
+    // The cells hold their display text, and the value they are sorted by:
+    m_pSummaryModel = new QStandardItemModel(this);
+    m_pSummaryModel->setSortRole(s_SORT_ROLE);
+    tableViewSummary->setModel(m_pSummaryModel);
+    tableViewSummary->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    connect(tableViewSummary, SIGNAL(doubleClicked(const QModelIndex&)), this, SLOT(RowDoubleClickedHandler(const QModelIndex&)));
 
-    if (pScreen != nullptr)
-    {
-        const int horizontalDpi = pScreen->logicalDpiX();
-        webView->setZoomFactor(horizontalDpi / 96.0);
-    }
+    checkBoxSelectedRangeOnly->setText(GPU_STR_TraceSummarySelectedRangeOnly);
+    checkBoxSelectedRangeOnly->setToolTip(GPU_STR_TraceSummarySelectedRangeTooltip);
+    connect(checkBoxSelectedRangeOnly, SIGNAL(toggled(bool)), this, SLOT(SelectedRangeOnlyToggled(bool)));
 
-    webView->setContextMenuPolicy(Qt::NoContextMenu);
-    connect(webView, SIGNAL(urlChanged(const QUrl&)), this, SLOT(LinkClickedHandler(const QUrl&)));
-
-    m_pContextMenu = new QMenu(webView);
+    m_pContextMenu = new QMenu(tableViewSummary);
 
     // Add the actions to the table:
     m_pCopyAction = m_pContextMenu->addAction(AF_STR_CopyA, this, SLOT(OnEditCopy()));
@@ -73,8 +86,10 @@ SummaryView::SummaryView(QWidget* parent) :
     // m_pContextMenu->addSeparator();
     // m_pExportToCSVAction = m_pContextMenu->addAction(AF_STR_ExportToCSV, this, SLOT(OnExportToCSV()));
 
-    webView->setContextMenuPolicy(Qt::CustomContextMenu);
-    connect(webView, SIGNAL(customContextMenuRequested(const QPoint&)), this, SLOT(OnContextMenu(const QPoint&)));
+    tableViewSummary->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(tableViewSummary, SIGNAL(customContextMenuRequested(const QPoint&)), this, SLOT(OnContextMenu(const QPoint&)));
+
+    connect(comboBoxPages, SIGNAL(currentIndexChanged(int)), this, SLOT(SelectedPageChanged()));
 }
 
 SummaryView::~SummaryView()
@@ -82,7 +97,7 @@ SummaryView::~SummaryView()
 }
 
 
-bool SummaryView::LoadSession(TraceSession* pSession, CLSummarizer* pSummarizer)
+bool SummaryView::LoadSession(TraceSession* pSession, const gpTraceSummarizer* pSummarizer)
 {
     bool retVal = false;
 
@@ -92,52 +107,27 @@ bool SummaryView::LoadSession(TraceSession* pSession, CLSummarizer* pSummarizer)
         Reset();
 
         m_pSummarizer = pSummarizer;
-        m_pSummarizer->CreateSummaryPages();
 
-        if (m_pSummarizer->GetSummaryPagesMap().count() != 0)
+        if (!m_pSummarizer->IsEmpty())
         {
-            int i = 0;
-            QString selPage;
-            bool initialPageSelected = false;
-
-            foreach (QString page, m_pSummarizer->GetSummaryPagesMap().keys())
-            {
-                if (selPage.isEmpty())
-                {
-                    selPage = page;
-                }
-
-                comboBoxPages->addItem(page);
+            m_pSummarizer->Summarize(m_pSummarizer->GetStartTime(), m_pSummarizer->GetEndTime(), m_summary);
 
-                if (!initialPageSelected)
-                {
-                    if (GetHasErrorWarningPage())
-                    {
-                        if (page.endsWith(Util::ms_BESTPRACTICES)) // focus first best practices summary page
-                        {
-                            selPage = page;
-                            initialPageSelected = true;
-                        }
-                    }
-                    else if (page.endsWith(Util::ms_CTXSUM))  // focus first context summary page
-                    {
-                        selPage = page;
-                        initialPageSelected = true;
-                    }
-                }
+            // Focus the best practices page when it has messages, and the context summary otherwise:
+            bool hasErrorWarningPage = !m_summary.m_pages[GP_TRACE_SUMMARY_PAGE_BEST_PRACTICES].m_rows.empty();
+            int selectedIndex = hasErrorWarningPage ? GP_TRACE_SUMMARY_PAGE_BEST_PRACTICES : GP_TRACE_SUMMARY_PAGE_CONTEXT;
 
-                i++;
-            }
+            m_loading = true;
 
-            if (!selPage.trimmed().isEmpty())
+            for (int i = 0; i < GP_TRACE_SUMMARY_PAGES_COUNT; i++)
             {
-                webView->setUrl(QUrl::fromLocalFile(m_pSummarizer->GetSummaryPagesMap()[selPage]));
+                comboBoxPages->addItem(GetPageTitle(static_cast<gpTraceSummaryPageType>(i)), i);
             }
 
-            connect(comboBoxPages, SIGNAL(currentIndexChanged(int)), this, SLOT(SelectedPageChanged()));
-            m_loading = true;
-            comboBoxPages->setCurrentText(selPage);
+            // Changing the current page shows it:
+            comboBoxPages->setCurrentIndex(selectedIndex);
             m_loading = false;
+
+            UpdateRangeLabel();
             retVal = true;
         }
     }
@@ -145,19 +135,177 @@ bool SummaryView::LoadSession(TraceSession* pSession, CLSummarizer* pSummarizer)
     return retVal;
 }
 
+void SummaryView::SetSelectedRange(quint64 startTime, quint64 endTime)
+{
+    m_hasSelectedRange = true;
+    m_selectedRangeStart = startTime;
+    m_selectedRangeEnd = std::max(startTime, endTime);
+
+    if (checkBoxSelectedRangeOnly->isChecked())
+    {
+        UpdateSummary();
+    }
+}
+
 void SummaryView::Reset()
 {
     m_pSummarizer = nullptr;
+    m_summary = gpTraceSummary();
+    m_displayedPageType = GP_TRACE_SUMMARY_PAGES_COUNT;
+    m_hasSelectedRange = false;
+    m_pSummaryModel->clear();
+
+    m_loading = true;
     comboBoxPages->clear();
+    checkBoxSelectedRangeOnly->setChecked(false);
+    m_loading = false;
+
+    labelRange->clear();
 }
 
-bool SummaryView::GetHasErrorWarningPage()
+void SummaryView::UpdateSummary()
 {
-    bool retVal = false;
+    if (m_pSummarizer != nullptr)
+    {
+        if (checkBoxSelectedRangeOnly->isChecked() && m_hasSelectedRange)
+        {
+            m_pSummarizer->Summarize(m_selectedRangeStart, m_selectedRangeEnd, m_summary);
+        }
+        else
+        {
+            m_pSummarizer->Summarize(m_pSummarizer->GetStartTime(), m_pSummarizer->GetEndTime(), m_summary);
+        }
+
+        DisplayPage(m_displayedPageType);
+        UpdateRangeLabel();
+    }
+}
+
+void SummaryView::DisplayPage(gpTraceSummaryPageType pageType)
+{
+    m_pSummaryModel->clear();
+    m_displayedPageType = pageType;
+
+    if ((pageType >= 0) && (pageType < GP_TRACE_SUMMARY_PAGES_COUNT))
+    {
+        const gpTraceSummaryPage& page = m_summary.m_pages[pageType];
+        m_pSummaryModel->setHorizontalHeaderLabels(page.m_columnNames);
+
+        // Disable sorting while the rows are added, so that the model is not sorted with each row:
+        tableViewSummary->setSortingEnabled(false);
+
+        for (size_t rowIndex = 0; rowIndex < page.m_rows.size(); rowIndex++)
+        {
+            const gpTraceSummaryRow& row = page.m_rows[rowIndex];
+            QList<QStandardItem*> items;
+
+            for (const QVariant& cell : row.m_cells)
+            {
+                QStandardItem* pItem = new QStandardItem;
+
+                if (cell.type() == QVariant::Double)
+                {
+                    pItem->setData(QString::number(cell.toDouble(), 'f', s_DECIMALS), Qt::DisplayRole);
+                    pItem->setData(static_cast<int>(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
+                }
+                else if (cell.type() == QVariant::String)
+                {
+                    pItem->setData(cell, Qt::DisplayRole);
+                }
+                else
+                {
+                    pItem->setData(cell.toString(), Qt::DisplayRole);
+                    pItem->setData(static_cast<int>(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
+                }
+
+                pItem->setData(cell, s_SORT_ROLE);
+                items << pItem;
+            }
+
+            if (!items.isEmpty())
+            {
+                items.first()->setData(static_cast<int>(rowIndex), s_ROW_INDEX_ROLE);
+
+                if (row.m_linkViewType != AnalyzerHTMLViewType_None)
+                {
+                    items.first()->setToolTip(GPU_STR_TraceSummaryRowLinkTooltip);
+                }
+            }
+
+            m_pSummaryModel->appendRow(items);
+        }
+
+        tableViewSummary->setSortingEnabled(true);
+        tableViewSummary->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+        tableViewSummary->resizeColumnsToContents();
+    }
+}
+
+void SummaryView::UpdateRangeLabel()
+{
+    QString rangeText;
+
+    if (m_pSummarizer != nullptr)
+    {
+        quint64 traceStart = m_pSummarizer->GetStartTime();
+
+        if (!checkBoxSelectedRangeOnly->isChecked())
+        {
+            rangeText = QString(GPU_STR_TraceSummaryWholeTraceRange).arg((m_pSummarizer->GetEndTime() - traceStart) / 1000000.0, 0, 'f', s_DECIMALS);
+        }
+        else if (!m_hasSelectedRange)
+        {
+            rangeText = GPU_STR_TraceSummaryNoSelectedRange;
+        }
+        else
+        {
+            quint64 relativeStart = (m_selectedRangeStart > traceStart) ? (m_selectedRangeStart - traceStart) : 0;
+            quint64 relativeEnd = (m_selectedRangeEnd > traceStart) ? (m_selectedRangeEnd - traceStart) : 0;
 
-    if (m_pSummarizer)
+            rangeText = QString(GPU_STR_TraceSummaryRange).arg(relativeStart / 1000000.0, 0, 'f', s_DECIMALS)
+                        .arg(relativeEnd / 1000000.0, 0, 'f', s_DECIMALS)
+                        .arg((m_selectedRangeEnd - m_selectedRangeStart) / 1000000.0, 0, 'f', s_DECIMALS);
+        }
+    }
+
+    labelRange->setText(rangeText);
+}
+
+QString SummaryView::GetPageTitle(gpTraceSummaryPageType pageType) const
+{
+    // The page titles keep the "<API> <page>" form of the backend summary pages, which the tree items and links rely on:
+    QString retVal = ((m_pSummarizer != nullptr) && m_pSummarizer->IsHSA()) ? GPU_STR_TraceViewHSA : GPU_STR_TraceViewOpenCL;
+    retVal.append(' ');
+
+    switch (pageType)
     {
-        retVal = m_pSummarizer->GetHasErrorWarningPage();
+        case GP_TRACE_SUMMARY_PAGE_API:
+            retVal.append(Util::ms_APISUM);
+            break;
+
+        case GP_TRACE_SUMMARY_PAGE_CONTEXT:
+            retVal.append(Util::ms_CTXSUM);
+            break;
+
+        case GP_TRACE_SUMMARY_PAGE_KERNEL:
+            retVal.append(Util::ms_KERNELSUM);
+            break;
+
+        case GP_TRACE_SUMMARY_PAGE_TOP_KERNELS:
+            retVal.append(Util::ms_TOP10KERNEL);
+            break;
+
+        case GP_TRACE_SUMMARY_PAGE_TOP_DATA_TRANSFERS:
+            retVal.append(Util::ms_TOP10DATA);
+            break;
+
+        case GP_TRACE_SUMMARY_PAGE_BEST_PRACTICES:
+            retVal.append(Util::ms_BESTPRACTICES);
+            break;
+
+        default:
+            GT_ASSERT(false);
+            break;
     }
 
     return retVal;
@@ -167,28 +315,21 @@ void SummaryView::SelectedPageChanged()
 {
     ProfileApplicationTreeHandler* pTreeHandler = ProfileApplicationTreeHandler::instance();
     afApplicationCommands* pApplicationCommands = afApplicationCommands::instance();
-    GT_IF_WITH_ASSERT((m_pSummarizer != nullptr) && (m_pDisplayedTraceSession != nullptr) && (pTreeHandler != nullptr) && (pApplicationCommands != nullptr))
-    {
-        gtString message;
-        message.appendFormattedString(L"m_loading = %d", m_loading);
 
-        if (!m_loading)
+    if (!m_loading && (comboBoxPages->currentIndex() >= 0))
+    {
+        GT_IF_WITH_ASSERT((m_pSummarizer != nullptr) && (m_pDisplayedTraceSession != nullptr) && (pTreeHandler != nullptr) && (pApplicationCommands != nullptr))
         {
             // Get the item data for the session:
             afApplicationTreeItemData* pItemData = m_pDisplayedTraceSession->m_pParentData;
             GT_IF_WITH_ASSERT(pItemData != nullptr)
             {
-                message.appendFormattedString(L". m_profileOutputFilePath: %ls", m_pDisplayedTraceSession->m_pParentData->m_filePath.asString().asCharArray());
                 // Get the item data for the item representing the summary type in the tree:
                 afTreeItemType treeItemType = Util::GetEnumTypeFromSumPageName(comboBoxPages->currentText());
-
-                message.appendFormattedString(L". treeItemType: %d. CurrentText: %ls", (int)treeItemType, acQStringToGTString(comboBoxPages->currentText()).asCharArray());
-
                 afApplicationTreeItemData* pItemTypeItemData = pTreeHandler->FindSessionChildItemData(pItemData, treeItemType);
 
                 if (pItemTypeItemData != nullptr)
                 {
-                    message.append(L" Got it");
                     afApplicationTree* pApplicationTree = pApplicationCommands->applicationTree();
                     GT_IF_WITH_ASSERT(pApplicationTree != nullptr)
                     {
@@ -198,57 +339,54 @@ void SummaryView::SelectedPageChanged()
                 }
             }
         }
+    }
 
-        QString key = comboBoxPages->currentText();
-        QString path = m_pSummarizer->GetSummaryPagesMap()[key];
+    if (comboBoxPages->currentIndex() >= 0)
+    {
+        gpTraceSummaryPageType pageType = static_cast<gpTraceSummaryPageType>(comboBoxPages->currentData().toInt());
 
-        webView->setUrl(QUrl::fromLocalFile(path));
+        if (pageType != m_displayedPageType)
+        {
+            DisplayPage(pageType);
+        }
     }
 }
 
-void SummaryView::LinkClickedHandler(const QUrl& url)
+void SummaryView::SelectedRangeOnlyToggled(bool isChecked)
 {
-    QString format = url.fragment();
+    GT_UNREFERENCED_PARAMETER(isChecked);
 
-    // QUrlQuery does not handle "?" like QUrl old function did.
-    // in case the format starts with ? remove it
-    if (format.startsWith("?"))
+    if (!m_loading)
     {
-        format.remove(0, 1);
+        UpdateSummary();
     }
+}
 
-    QUrlQuery fragUrl(format);
-
-    bool hasThread = fragUrl.hasQueryItem(gs_THREAD_ID_TAG);
-
-    QString strQueryTid = fragUrl.queryItemValue(gs_THREAD_ID_TAG);
-    QString strQuerySeqid = fragUrl.queryItemValue(gs_SEQUENCE_ID_TAG);
-    QString strQueryView = fragUrl.queryItemValue(gs_VIEW_TAG);
-
-    bool ok = false;
-    unsigned int threadId = 0;
-
-    if (hasThread)
+void SummaryView::RowDoubleClickedHandler(const QModelIndex& index)
+{
+    if (index.isValid() && (m_displayedPageType < GP_TRACE_SUMMARY_PAGES_COUNT))
     {
-        threadId = strQueryTid.toUInt(&ok);
+        // The rows may be sorted, so the summary row is found by the index kept in the first cell:
+        QStandardItem* pFirstItem = m_pSummaryModel->item(index.row(), 0);
+        const gpTraceSummaryPage& page = m_summary.m_pages[m_displayedPageType];
 
-        if (!ok)
+        if (pFirstItem != nullptr)
         {
-            return;
-        }
-    }
+            bool ok = false;
+            int rowIndex = pFirstItem->data(s_ROW_INDEX_ROLE).toInt(&ok);
 
-    unsigned int callIndex = strQuerySeqid.toUInt(&ok);
+            if (ok && (rowIndex >= 0) && (rowIndex < static_cast<int>(page.m_rows.size())))
+            {
+                const gpTraceSummaryRow& row = page.m_rows[rowIndex];
 
-    if (!ok)
-    {
-        return;
+                if (row.m_linkViewType != AnalyzerHTMLViewType_None)
+                {
+                    // navigate to the block in the timeline/trace
+                    emit LinkClicked(comboBoxPages->currentText(), static_cast<unsigned int>(row.m_threadId), row.m_sequenceId, row.m_linkViewType);
+                }
+            }
+        }
     }
-
-    AnalyzerHTMLViewType viewType = StringToAnalyzerHTMLType(strQueryView.toStdString());
-
-    // navigate to the block in the timeline/trace
-    emit LinkClicked(comboBoxPages->currentText(), threadId, callIndex, viewType);
 }
 
 int SummaryView::GetComboIndexByPageName(const QString& name)
@@ -273,37 +411,26 @@ void SummaryView::DisplaySummaryPageType(int type)
 
     GT_IF_WITH_ASSERT(comboBoxPages != nullptr && comboBoxPages->count() > 0)
     {
-        gtString message;
-        message.appendFormattedString(L"type = %d, ", type);
         QString page = acGTStringToQString(Util::SummaryTypeToGTString(static_cast<afTreeItemType>(type)));
 
-        message.appendFormattedString(L"page = %ls, ", acQStringToGTString(page).asCharArray());
-        // get the combo item string - not by findText - because on remote sessions the pages name has prefix
+        // get the combo item string - not by findText - because the pages name has an API prefix
         int index = GetComboIndexByPageName(page);
 
-        message.appendFormattedString(L"index = %d, ", index);
-
         // in case of bad index - put default
         if (index < 0)
         {
-            message.appendFormattedString(L" Index < 0");
-
             // set the index default to be first Warning(s)/Error(s)
             index = GetComboIndexByPageName(Util::ms_BESTPRACTICES);
 
             // if not exist set it to be Context Summary
             if (index < 0)
             {
-                message.appendFormattedString(L" Index < 0");
-
                 index = GetComboIndexByPageName(Util::ms_CTXSUM);
             }
 
             // if not exist set to first in combo
             if (index < 0)
             {
-                message.appendFormattedString(L" Index < 0");
-
                 index = 0;
 
                 GT_ASSERT_EX(false, L"Should not get here. ");
@@ -319,12 +446,38 @@ void SummaryView::DisplaySummaryPageType(int type)
 
 void SummaryView::OnEditCopy()
 {
-    webView->triggerPageAction(QWebEnginePage::Copy);
+    QModelIndexList selectedIndexes = tableViewSummary->selectionModel()->selectedIndexes();
+
+    if (!selectedIndexes.isEmpty())
+    {
+        std::sort(selectedIndexes.begin(), selectedIndexes.end());
+
+        // Copy the selected cells as tab separated rows:
+        QString text;
+        int currentRow = selectedIndexes.first().row();
+
+        for (const QModelIndex& index : selectedIndexes)
+        {
+            if (index.row() != currentRow)
+            {
+                text.append('\n');
+                currentRow = index.row();
+            }
+            else if (!text.isEmpty() && !text.endsWith('\n'))
+            {
+                text.append('\t');
+            }
+
+            text.append(index.data(Qt::DisplayRole).toString());
+        }
+
+        QApplication::clipboard()->setText(text);
+    }
 }
 
 void SummaryView::OnEditSelectAll()
 {
-    webView->triggerPageAction(QWebEnginePage::SelectAll);
+    tableViewSummary->selectAll();
 }
 
 void SummaryView::OnContextMenu(const QPoint& point)
@@ -360,4 +513,3 @@ void SummaryView::OnContextMenu(const QPoint& point)
 //         }
 //     }
 // }
-
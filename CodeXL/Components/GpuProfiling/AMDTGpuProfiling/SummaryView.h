@@ -22,14 +22,17 @@
 // Qt:
 #include <QtCore>
 
-#include "CLSummarizer.h"
 #include "CXLAnalyzerHTMLUtils.h"
 #include "Session.h"
+#include "gpTraceSummarizer.h"
 
 // need to undef Bool after all includes so the moc will compile in Linux
 #undef Bool
 
-/// The Summary view class
+class QStandardItemModel;
+
+/// The Summary view class. Shows the pages computed by a gpTraceSummarizer in sortable tables,
+/// for the whole trace or for the time range of the selected timeline item
 class SummaryView : public QWidget, private Ui::SummaryViewBase
 {
     Q_OBJECT
@@ -44,9 +47,14 @@ public:
 
     /// Loads a session into the Summary View
     /// \param pSession the session to load
-    /// \param pSummarizer the summarizer instance to use
+    /// \param pSummarizer the summarizer holding the session records
     /// \return true if the session was loaded, false otherwise
-    bool LoadSession(TraceSession* pSession, CLSummarizer* pSummarizer);
+    bool LoadSession(TraceSession* pSession, const gpTraceSummarizer* pSummarizer);
+
+    /// Sets the time range summarized when "Selected timeline item only" is checked
+    /// \param startTime the range start
+    /// \param endTime the range end
+    void SetSelectedRange(quint64 startTime, quint64 endTime);
 
     /// Resets the Summary view (clears the  combo box)
     void Reset();
@@ -70,23 +78,41 @@ public slots:
     // void OnExportToCSV();
 
 private:
-    /// OpenCL Trace Summarizer
-    CLSummarizer* m_pSummarizer;
+    /// Trace Summarizer
+    const gpTraceSummarizer* m_pSummarizer;
+
+    /// The summary of the displayed range
+    gpTraceSummary m_summary;
+
+    /// The model of the summary table
+    QStandardItemModel* m_pSummaryModel;
+
+    /// The page shown in the summary table, GP_TRACE_SUMMARY_PAGES_COUNT if none
+    gpTraceSummaryPageType m_displayedPageType;
 
-    /// ComboBox index to the newest page in history
-    int m_newestPageIndex;
+    /// True iff a range was selected with SetSelectedRange
+    bool m_hasSelectedRange;
 
-    /// ComboBox index to the current page in history
-    int m_currentPageIndex;
+    /// The selected range start
+    quint64 m_selectedRangeStart;
 
-    /// Initialize the data and state
-    /// \param pSession the current session
-    /// \return True if success in initialization
-    bool Initialize(GPUSessionTreeItemData* pSession);
+    /// The selected range end
+    quint64 m_selectedRangeEnd;
 
-    /// If there is warning in page
-    /// \return True if there is warning in page
-    bool GetHasErrorWarningPage();
+    /// Summarizes the whole trace, or the selected range, and shows the current page
+    void UpdateSummary();
+
+    /// Fills the summary table with a page of the summary
+    /// \param pageType the page
+    void DisplayPage(gpTraceSummaryPageType pageType);
+
+    /// Updates the range label
+    void UpdateRangeLabel();
+
+    /// Gets the title of a summary page, as shown in the combo box
+    /// \param pageType the page
+    /// \return the page title
+    QString GetPageTitle(gpTraceSummaryPageType pageType) const;
 
 signals:
     /// Signal emitted when a clicked link should be shown in the timeline or trace view
@@ -100,9 +126,13 @@ protected slots:
     /// Selected summary page changed
     void SelectedPageChanged();
 
-    /// Handler for when a link is clicked
-    /// \param url the URL of the link clicked
-    void LinkClickedHandler(const QUrl& url);
+    /// Handler for when a summary row is double clicked. Shows the call of the row in the timeline or trace view
+    /// \param index the double clicked index
+    void RowDoubleClickedHandler(const QModelIndex& index);
+
+    /// Handler for when "Selected timeline item only" is toggled
+    /// \param isChecked true iff only the selected range is summarized
+    void SelectedRangeOnlyToggled(bool isChecked);
 
     /// Context menu:
     void OnContextMenu(const QPoint&);
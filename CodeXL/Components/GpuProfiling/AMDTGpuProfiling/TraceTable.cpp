@@ -19,6 +19,9 @@
 #include <QtCore>
 #include <QtWidgets>
 
+// std
+#include <algorithm>
+
 // Infra:
 #include <AMDTBaseTools/Include/gtAssert.h>
 #include <AMDTBaseTools/Include/gtIgnoreCompilerWarnings.h>
@@ -40,139 +43,192 @@
 
 namespace boosticl = boost::icl;
 
-TraceTableItem::TraceTableItem(const QString& strAPIPrefix, const QString& strApiName, IAPIInfoDataHandler* pApiInfo, acTimelineItem* pTimelineItem, acTimelineItem* pDeviceBlock, IOccupancyInfoDataHandler* pOccupancyInfo) :
-    m_parent(nullptr), m_startIndex(-1), m_endIndex(-1), m_pTimelineItem(pTimelineItem), m_pDeviceBlock(pDeviceBlock), m_pOccupancyInfo(pOccupancyInfo)
+TraceTableColumnStore::TraceTableColumnStore()
+{
+    // Interned string 0 is the empty string, used for rows without a result
+    InternString(QString());
+}
+
+void TraceTableColumnStore::Reserve(size_t rowsCount)
+{
+    m_itemTypes.reserve(rowsCount);
+    m_uniqueIdPrefixIds.reserve(rowsCount);
+    m_uniqueIdNumbers.reserve(rowsCount);
+    m_threadIdIndexes.reserve(rowsCount);
+    m_nameIds.reserve(rowsCount);
+    m_resultIds.reserve(rowsCount);
+    m_argumentsOffsets.reserve(rowsCount);
+    m_argumentsLengths.reserve(rowsCount);
+    m_startTimes.reserve(rowsCount);
+    m_endTimes.reserve(rowsCount);
+    m_firstCallIndices.reserve(rowsCount);
+    m_lastCallIndices.reserve(rowsCount);
+    m_timelineItems.reserve(rowsCount);
+}
+
+quint32 TraceTableColumnStore::InternString(const QString& str)
 {
-    // Fill the data structure with empty strings:
-    m_data.reserve(TraceTableModel::TRACE_COLUMN_COUNT);
+    quint32 retVal = 0;
+
+    QHash<QString, quint32>::const_iterator iter = m_internedStringIds.constFind(str);
 
-    for (int i = 0 ; i < TraceTableModel::TRACE_COLUMN_COUNT; i++)
+    if (iter != m_internedStringIds.constEnd())
     {
-        m_data << "";
+        retVal = iter.value();
     }
-
-    if (pApiInfo != nullptr)
+    else
     {
-        if (pApiInfo->IsApiSequenceIdDisplayble())
-        {
-            unsigned int dispSeqId = pApiInfo->GetApiDisplaySequenceId();
-            m_startIndex = static_cast<int>(dispSeqId);
-        }
+        retVal = static_cast<quint32>(m_internedStrings.size());
+        m_internedStrings.push_back(str);
+        m_internedStringIds.insert(str, retVal);
+    }
+
+    return retVal;
+}
 
-        m_data[TraceTableModel::TRACE_INTERFACE_COLUMN] = strApiName;
-        m_data[TraceTableModel::TRACE_PARAMETERS_COLUMN] = QString::fromStdString(pApiInfo->GetApiArgListString());
-        m_data[TraceTableModel::TRACE_RESULT_COLUMN] = QString::fromStdString(pApiInfo->GetApiRetString());
+quint32 TraceTableColumnStore::InternThreadId(quint64 threadId)
+{
+    // The tables hold the calls of a single thread, so this is usually found at once:
+    std::vector<quint64>::const_iterator iter = std::find(m_threadIds.begin(), m_threadIds.end(), threadId);
+    quint32 retVal = static_cast<quint32>(iter - m_threadIds.begin());
 
-        QString strUniqueId = strAPIPrefix;
-        strUniqueId.append('.').append(QString::number(pApiInfo->GetApiSequenceId()));
-        m_uniqueId = QVariant::fromValue(strUniqueId);
+    if (iter == m_threadIds.end())
+    {
+        m_threadIds.push_back(threadId);
     }
+
+    return retVal;
+}
+
+quint32 TraceTableColumnStore::AddRow(TraceTableItemType itemType, const QString& strUniqueIdPrefix, quint64 uniqueIdNumber, quint64 threadId, const QString& strName,
+                                      const std::string& strArguments, const std::string& strResult, acTimelineItem* pTimelineItem)
+{
+    quint32 retVal = static_cast<quint32>(m_nameIds.size());
+
+    m_itemTypes.push_back(static_cast<quint8>(itemType));
+    m_uniqueIdPrefixIds.push_back(InternString(strUniqueIdPrefix));
+    m_uniqueIdNumbers.push_back(uniqueIdNumber);
+    m_threadIdIndexes.push_back(InternThreadId(threadId));
+    m_nameIds.push_back(InternString(strName));
+    m_resultIds.push_back(strResult.empty() ? 0 : InternString(QString::fromStdString(strResult)));
+
+    // The arguments are mostly unique, so they are not interned, but kept as UTF8 in one contiguous buffer:
+    m_argumentsOffsets.push_back(m_argumentsChars.size());
+    m_argumentsLengths.push_back(static_cast<quint32>(strArguments.size()));
+    m_argumentsChars.insert(m_argumentsChars.end(), strArguments.begin(), strArguments.end());
+
+    m_startTimes.push_back(0);
+    m_endTimes.push_back(0);
+    m_firstCallIndices.push_back(-1);
+    m_lastCallIndices.push_back(-1);
+    m_timelineItems.push_back(pTimelineItem);
+
+    return retVal;
 }
 
-TraceTableItem::TraceTableItem(const QString& strAPIPrefix, const QString& strMarkerName, IPerfMarkerInfoDataHandler* pMarkerEntry, acTimelineItem* pTimelineItem) :
-    m_parent(nullptr), m_startIndex(-1), m_endIndex(-1), m_pTimelineItem(pTimelineItem), m_pDeviceBlock(nullptr), m_pOccupancyInfo(nullptr)
+void TraceTableColumnStore::SetTimes(quint32 row, quint64 startTime, quint64 endTime)
 {
-    // Fill the data structure with empty strings:
-    m_data.reserve(TraceTableModel::TRACE_COLUMN_COUNT);
+    m_startTimes[row] = startTime;
+    m_endTimes[row] = endTime;
+}
 
-    for (int i = 0 ; i < TraceTableModel::TRACE_COLUMN_COUNT; i++)
+void TraceTableColumnStore::SetDeviceData(quint32 row, acTimelineItem* pDeviceBlock, IOccupancyInfoDataHandler* pOccupancyInfo)
+{
+    if (pDeviceBlock != nullptr)
     {
-        m_data << "";
+        m_deviceBlocks.insert(row, pDeviceBlock);
     }
 
-    if (pMarkerEntry != nullptr)
+    if (pOccupancyInfo != nullptr)
     {
-        m_data[TraceTableModel::TRACE_INTERFACE_COLUMN] = strMarkerName;
-
-        QString strUniqueId = strAPIPrefix;
-        static int dummy = 0;
-        dummy++;
-        strUniqueId.append('.').append(QString::number(dummy));
-        m_uniqueId = QVariant::fromValue(strUniqueId);
+        m_occupancyInfos.insert(row, pOccupancyInfo);
     }
 }
 
-TraceTableItem::~TraceTableItem()
+void TraceTableColumnStore::SetCallIndices(quint32 row, int firstCallIndex, int lastCallIndex)
 {
-    m_data.clear();
-    qDeleteAll(m_children);
+    m_firstCallIndices[row] = firstCallIndex;
+    m_lastCallIndices[row] = lastCallIndex;
 }
 
-void TraceTableItem::AppendChild(TraceTableItem* child)
+QString TraceTableColumnStore::GetArguments(quint32 row) const
 {
-    TraceTableItem* curParent = child->GetParent();
+    QString retVal;
 
-    if (curParent != this)
+    if (m_argumentsLengths[row] > 0)
     {
-        if (curParent != nullptr)
-        {
-            curParent->m_children.removeAt(child->GetRow());
-        }
-
-        m_children.append(child);
-        child->m_parent = this;
+        retVal = QString::fromUtf8(&m_argumentsChars[m_argumentsOffsets[row]], static_cast<int>(m_argumentsLengths[row]));
     }
+
+    return retVal;
 }
 
-void TraceTableItem::InsertChild(int index, TraceTableItem* child)
+QString TraceTableColumnStore::GetUniqueId(quint32 row) const
 {
-    TraceTableItem* curParent = child->GetParent();
+    QString retVal = m_internedStrings[m_uniqueIdPrefixIds[row]];
+    retVal.append('.').append(QString::number(m_uniqueIdNumbers[row]));
+    return retVal;
+}
+
+/// Formats a time duration (in nanoseconds) for the time columns. Durations are displayed in milliseconds
+/// \param duration the duration
+/// \return the duration string, an empty string for negligible durations
+static QString FormatTraceTableDuration(quint64 duration)
+{
+    QString retVal;
+
+    float floatVal = static_cast<float>(duration / 1000000.0f);
 
-    if (curParent != this)
+    // Do not show values less then 0.0001:
+    if (floatVal > 0.0001)
     {
-        if (curParent != nullptr)
+        int precision = 4;
+
+        if (fmod(floatVal, (float)1.0) == 0.0)
         {
-            curParent->m_children.removeAt(child->GetRow());
+            precision = 0;
         }
 
-        m_children.insert(index, child);
-        child->m_parent = this;
+        retVal = QLocale(QLocale::English).toString(floatVal, 'f', precision);
     }
+
+    return retVal;
 }
 
-QVariant TraceTableItem::GetColumnData(int columnIndex) const
+QVariant TraceTableColumnStore::GetColumnData(quint32 row, int columnIndex) const
 {
     TraceTableModel::TraceTableColIndex columnIndexId = (TraceTableModel::TraceTableColIndex)columnIndex;
 
     switch (columnIndexId)
     {
         case TraceTableModel::TRACE_INTERFACE_COLUMN:
+        {
+            return GetName(row);
+        }
+
         case TraceTableModel::TRACE_PARAMETERS_COLUMN:
-        case TraceTableModel::TRACE_RESULT_COLUMN:
         {
-            if (m_data.count() > columnIndex)
-            {
-                return m_data[columnIndex];
-            }
+            return GetArguments(row);
+        }
 
-            return QVariant();
+        case TraceTableModel::TRACE_RESULT_COLUMN:
+        {
+            return GetResult(row);
         }
 
         case TraceTableModel::TRACE_CPU_TIME_COLUMN:
+        {
+            return FormatTraceTableDuration(GetEndTime(row) - GetStartTime(row));
+        }
+
         case TraceTableModel::TRACE_DEVICE_TIME_COLUMN:
         {
             QString retVal;
+            acTimelineItem* pDeviceBlock = GetDeviceBlock(row);
 
-            if (m_data.count() > columnIndex)
+            if (pDeviceBlock != nullptr)
             {
-                bool isFloat = false;
-                float floatVal = m_data[columnIndex].toFloat(&isFloat);
-
-                if (isFloat)
-                {
-                    // Do not show values less then 0.0001:
-                    if (floatVal > 0.0001)
-                    {
-                        int precision = 4;
-
-                        if (fmod(floatVal, (float)1.0) == 0.0)
-                        {
-                            precision = 0;
-                        }
-
-                        retVal = QLocale(QLocale::English).toString(floatVal, 'f', precision);
-                    }
-                }
+                retVal = FormatTraceTableDuration(pDeviceBlock->endTime() - pDeviceBlock->startTime());
             }
 
             return retVal;
@@ -180,13 +236,16 @@ QVariant TraceTableItem::GetColumnData(int columnIndex) const
 
         case TraceTableModel::TRACE_INDEX_COLUMN:
         {
-            if (m_startIndex >= 0)
+            int startIndex = m_firstCallIndices[row];
+            int endIndex = m_lastCallIndices[row];
+
+            if (startIndex >= 0)
             {
-                QString retVal = QString::number(m_startIndex);
+                QString retVal = QString::number(startIndex);
 
-                if (m_endIndex >= 0)
+                if (endIndex >= 0)
                 {
-                    retVal.sprintf("%d-%d", m_startIndex, m_endIndex);
+                    retVal.sprintf("%d-%d", startIndex, endIndex);
                 }
 
                 return retVal;
@@ -198,9 +257,11 @@ QVariant TraceTableItem::GetColumnData(int columnIndex) const
 
         case TraceTableModel::TRACE_DEVICE_BLOCK_COLUMN:
         {
-            if (m_pDeviceBlock != nullptr)
+            acTimelineItem* pDeviceBlock = GetDeviceBlock(row);
+
+            if (pDeviceBlock != nullptr)
             {
-                return m_pDeviceBlock->text();
+                return pDeviceBlock->text();
             }
 
             return QVariant();
@@ -209,9 +270,11 @@ QVariant TraceTableItem::GetColumnData(int columnIndex) const
 
         case TraceTableModel::TRACE_OCCUPANCY_COLUMN:
         {
-            if (m_pOccupancyInfo != nullptr && m_pOccupancyInfo->GetOccupancy() >= 0)
+            IOccupancyInfoDataHandler* pOccupancyInfo = GetOccupancyInfo(row);
+
+            if (pOccupancyInfo != nullptr && pOccupancyInfo->GetOccupancy() >= 0)
             {
-                return Util::RemoveTrailingZero(QString("%1").number(m_pOccupancyInfo->GetOccupancy(), 'f', 2)).append('%');
+                return Util::RemoveTrailingZero(QString("%1").number(pOccupancyInfo->GetOccupancy(), 'f', 2)).append('%');
             }
 
             return QVariant();
@@ -225,317 +288,379 @@ QVariant TraceTableItem::GetColumnData(int columnIndex) const
     }
 }
 
+TraceTableModel::TraceTableModel(QObject* parent) : QAbstractItemModel(parent), m_rootItem(TraceTableColumnStore::INVALID_ROW), m_reservedApiCallsTraceItems(0),
+    m_isInitialized(false), m_shouldExpandBeEnabled(false), m_isFiltered(false), m_matchColor(255, 240, 150)
+{
+}
 
-void TraceTableItem::SetColumnData(int columnIndex, QVariant data)
+TraceTableModel::~TraceTableModel()
 {
-    TraceTableModel::TraceTableColIndex columnIndexId = (TraceTableModel::TraceTableColIndex)columnIndex;
+}
 
-    switch (columnIndexId)
-    {
-        case TraceTableModel::TRACE_INDEX_COLUMN:
-        case TraceTableModel::TRACE_INTERFACE_COLUMN:
-        case TraceTableModel::TRACE_PARAMETERS_COLUMN:
-        case TraceTableModel::TRACE_RESULT_COLUMN:
-        case TraceTableModel::TRACE_CPU_TIME_COLUMN:
-        case TraceTableModel::TRACE_DEVICE_TIME_COLUMN:
-        {
-            if (m_data.count() > columnIndex)
-            {
-                m_data[columnIndex] = data;
-            }
+void TraceTableModel::SetVisualProperties(const QColor& defaultForegroundColor, const QColor& linkColor, const QFont& font)
+{
+    // Build the list of headers:
+    BuildHeaderData();
 
-            break;
-        }
 
-        default:
-        {
-            GT_ASSERT_EX(false, L"Invalid data column index");
-            break;
-        }
+    m_defaultForegroundColor = defaultForegroundColor;
+    m_linkColor = linkColor;
+    m_font = font;
+    m_underlineFont = m_font;
+    m_underlineFont.setUnderline(true);
+}
+
+void TraceTableModel::AddTreeRow(quint32 storeRow)
+{
+    GT_IF_WITH_ASSERT(storeRow == m_parentRows.size())
+    {
+        m_parentRows.push_back(TraceTableColumnStore::INVALID_ROW);
+        m_rowsInParent.push_back(-1);
     }
 }
 
+const TraceTableItem* TraceTableModel::GetParentItem(quint32 parentRow) const
+{
+    const TraceTableItem* pRetVal = &m_rootItem;
 
-int TraceTableItem::GetRow() const
+    if (parentRow != TraceTableColumnStore::INVALID_ROW)
+    {
+        QHash<quint32, TraceTableItem>::const_iterator iter = m_parentItems.constFind(parentRow);
+        pRetVal = (iter != m_parentItems.constEnd()) ? &iter.value() : nullptr;
+    }
+
+    return pRetVal;
+}
+
+TraceTableItem* TraceTableModel::GetOrCreateParentItem(quint32 parentRow)
 {
-    int retVal = 0;
+    TraceTableItem* pRetVal = &m_rootItem;
 
-    if (m_parent != nullptr)
+    if (parentRow != TraceTableColumnStore::INVALID_ROW)
     {
-        retVal = m_parent->m_children.indexOf(const_cast<TraceTableItem*>(this));
+        QHash<quint32, TraceTableItem>::iterator iter = m_parentItems.find(parentRow);
+
+        if (iter == m_parentItems.end())
+        {
+            iter = m_parentItems.insert(parentRow, TraceTableItem(parentRow));
+        }
+
+        pRetVal = &iter.value();
     }
 
-    return retVal;
+    return pRetVal;
 }
 
-void TraceTableItem::UpdateIndices(int childStartIndex, int childEndIndex)
+void TraceTableModel::InsertChild(quint32 parentRow, int index, quint32 childRow)
 {
-    if ((childEndIndex < 0) && (childStartIndex >= 0))
+    GT_IF_WITH_ASSERT((childRow < m_rowsInParent.size()) && (m_rowsInParent[childRow] < 0))
     {
-        if (m_startIndex < 0)
+        TraceTableItem* pParent = GetOrCreateParentItem(parentRow);
+        std::vector<quint32>& childRows = pParent->m_childRows;
+
+        if ((index < 0) || (index >= static_cast<int>(childRows.size())))
         {
-            m_startIndex = childStartIndex;
+            index = static_cast<int>(childRows.size());
         }
-        else
+
+        childRows.insert(childRows.begin() + index, childRow);
+        m_parentRows[childRow] = parentRow;
+
+        // Update the row of the inserted child, and of the children following it:
+        for (int i = index; i < static_cast<int>(childRows.size()); i++)
         {
-            if (m_startIndex > childStartIndex)
-            {
-                m_startIndex = childStartIndex;
-            }
+            m_rowsInParent[childRows[i]] = i;
         }
+    }
+}
 
-        if (m_endIndex < 0)
+void TraceTableModel::UpdateIndices(quint32 parentRow, int childStartIndex, int childEndIndex)
+{
+    int startIndex = m_columnStore.GetFirstCallIndex(parentRow);
+    int endIndex = m_columnStore.GetLastCallIndex(parentRow);
+
+    if ((childEndIndex < 0) && (childStartIndex >= 0))
+    {
+        if ((startIndex < 0) || (startIndex > childStartIndex))
         {
-            m_endIndex = childStartIndex;
+            startIndex = childStartIndex;
         }
-        else
+
+        if ((endIndex < 0) || (endIndex < childStartIndex))
         {
-            if (m_endIndex < childStartIndex)
-            {
-                m_endIndex = childStartIndex;
-            }
+            endIndex = childStartIndex;
         }
+
+        m_columnStore.SetCallIndices(parentRow, startIndex, endIndex);
     }
 
     // Go through the parents, and update its indices, until you get to the root item
-    TraceTableItem* pParent = m_parent;
-
-    while (pParent != nullptr)
+    for (quint32 ancestorRow = m_parentRows[parentRow]; ancestorRow != TraceTableColumnStore::INVALID_ROW; ancestorRow = m_parentRows[ancestorRow])
     {
-        if (pParent->m_startIndex < 0)
-        {
-            pParent->m_startIndex = m_startIndex;
-        }
+        int ancestorStartIndex = m_columnStore.GetFirstCallIndex(ancestorRow);
+        int ancestorEndIndex = m_columnStore.GetLastCallIndex(ancestorRow);
 
-        if (pParent->m_endIndex < 0)
+        if (ancestorStartIndex < 0)
         {
-            pParent->m_endIndex = m_endIndex;
+            ancestorStartIndex = startIndex;
         }
-        else
+
+        if ((ancestorEndIndex < 0) || (ancestorEndIndex < endIndex))
         {
-            if (pParent->m_endIndex < m_endIndex)
-            {
-                pParent->m_endIndex = m_endIndex;
-            }
+            ancestorEndIndex = endIndex;
         }
 
-        pParent = pParent->m_parent;
+        m_columnStore.SetCallIndices(ancestorRow, ancestorStartIndex, ancestorEndIndex);
     }
 }
 
-
-void TraceTableItem::UpdateMarkerName(const QString& strMarkerName)
+bool TraceTableModel::IsInTimeRange(quint32 storeRow, quint64 startTime, quint64 endTime) const
 {
-    m_data[TraceTableModel::TRACE_INTERFACE_COLUMN] = strMarkerName;
+    return (m_columnStore.GetStartTime(storeRow) <= endTime) && (m_columnStore.GetEndTime(storeRow) >= startTime);
 }
 
-
-TraceTableModel::TraceTableModel(QObject* parent) : QAbstractItemModel(parent), m_isInitialized(false), m_shouldExpandBeEnabled(false)
+quint32 TraceTableModel::CreateAPIItem(const QString& strAPIPrefix, const QString& strApiName, const gpTraceAPIRecord* pApiInfo, acTimelineItem* pTimelineItem, acTimelineItem* pDeviceBlock, IOccupancyInfoDataHandler* pOccupancyInfo)
 {
-    m_pRootItem = new TraceTableItem("", "", nullptr, nullptr, nullptr, nullptr);
+    quint32 retVal = m_columnStore.AddRow(API, strAPIPrefix, pApiInfo->m_sequenceId, pApiInfo->m_threadId, strApiName, pApiInfo->m_argList, pApiInfo->m_retString, pTimelineItem);
+    AddTreeRow(retVal);
+
+    m_columnStore.SetDeviceData(retVal, pDeviceBlock, pOccupancyInfo);
+
+    if (pApiInfo->m_isSequenceIdDisplayable)
+    {
+        m_columnStore.SetCallIndices(retVal, static_cast<int>(pApiInfo->m_displaySequenceId), -1);
+    }
+
+    // The device time is calculated from the device block when displayed, only the CPU time is stored:
+    m_columnStore.SetTimes(retVal, pApiInfo->m_startTime, pApiInfo->m_endTime);
 
+    return retVal;
 }
 
-TraceTableModel::~TraceTableModel()
+std::vector<quint32>::iterator TraceTableModel::APICallsTraceRowsLowerBound(quint64 endTime)
 {
-    m_apiCallsTraceItemsMap.clear();
-    m_perfMarkersTraceItemsMap.clear();
-    m_perfmarkerList.clear();
-    SAFE_DELETE(m_pRootItem);
+    const TraceTableColumnStore& store = m_columnStore;
+
+    return std::lower_bound(m_apiCallsTraceRows.begin(), m_apiCallsTraceRows.end(), endTime, [&store](quint32 storeRow, quint64 time)
+    {
+        return store.GetEndTime(storeRow) < time;
+    });
 }
 
-void TraceTableModel::SetVisualProperties(const QColor& defaultForegroundColor, const QColor& linkColor, const QFont& font)
+void TraceTableModel::InsertToAPICallsTraceRows(quint32 storeRow)
 {
-    // Build the list of headers:
-    BuildHeaderData();
-
+    quint64 endTime = m_columnStore.GetEndTime(storeRow);
 
-    m_defaultForegroundColor = defaultForegroundColor;
-    m_linkColor = linkColor;
-    m_font = font;
-    m_underlineFont = m_font;
-    m_underlineFont.setUnderline(true);
+    // API calls are mostly added in order of their end time, so in most cases this is an append:
+    if (m_apiCallsTraceRows.empty() || (m_columnStore.GetEndTime(m_apiCallsTraceRows.back()) <= endTime))
+    {
+        m_apiCallsTraceRows.push_back(storeRow);
+    }
+    else
+    {
+        const TraceTableColumnStore& store = m_columnStore;
+        auto iter = std::upper_bound(m_apiCallsTraceRows.begin(), m_apiCallsTraceRows.end(), endTime, [&store](quint64 time, quint32 otherRow)
+        {
+            return time < store.GetEndTime(otherRow);
+        });
+        m_apiCallsTraceRows.insert(iter, storeRow);
+    }
 }
 
-TraceTableItem* TraceTableModel::AddTraceItem(const QString& strAPIPrefix, const QString& strApiName, IAPIInfoDataHandler* pApiInfo, acTimelineItem* pTimelineItem, acTimelineItem* pDeviceBlock, IOccupancyInfoDataHandler* pOccupancyInfo)
+quint32 TraceTableModel::AddTraceItem(const QString& strAPIPrefix, const QString& strApiName, const gpTraceAPIRecord* pApiInfo, acTimelineItem* pTimelineItem, acTimelineItem* pDeviceBlock, IOccupancyInfoDataHandler* pOccupancyInfo)
 {
-    TraceTableItem* pRetVal = nullptr;
+    quint32 retVal = TraceTableColumnStore::INVALID_ROW;
 
     // Sanity check:
     GT_IF_WITH_ASSERT((pApiInfo != nullptr) && (pTimelineItem != nullptr))
     {
-        TraceTableItem* pParent = nullptr;
-
-        pRetVal = new TraceTableItem(strAPIPrefix, strApiName, pApiInfo, pTimelineItem, pDeviceBlock, pOccupancyInfo);
+        quint32 parentRow = TraceTableColumnStore::INVALID_ROW;
 
+        retVal = CreateAPIItem(strAPIPrefix, strApiName, pApiInfo, pTimelineItem, pDeviceBlock, pOccupancyInfo);
 
         // Get the start and end time for the current pTableItem:
-
-        quint64 startTime = pApiInfo->GetApiStartTime();
-        quint64 endTime = pApiInfo->GetApiEndTime();
-
-        float cpuTimeSec = static_cast<float>((endTime - startTime) / 1000000.0f);
-        QVariant cpuTimeVar;
-        cpuTimeVar.setValue(cpuTimeSec);
-        pRetVal->SetColumnData(TRACE_CPU_TIME_COLUMN, cpuTimeVar);
-
-        if (pDeviceBlock != nullptr)
-        {
-            float gpuTimeSec = static_cast<float>((pDeviceBlock->endTime() - pDeviceBlock->startTime()) / 1000000.0f);
-            QVariant gpuTimeVar;
-            gpuTimeVar.setValue(gpuTimeSec);
-            pRetVal->SetColumnData(TRACE_DEVICE_TIME_COLUMN, gpuTimeVar);
-        }
+        quint64 startTime = pApiInfo->m_startTime;
+        quint64 endTime = pApiInfo->m_endTime;
 
         // Go through the existing API items, and look for an appropriate parent:
-        auto iter = m_apiCallsTraceItemsMap.lower_bound(endTime);
+        auto iter = APICallsTraceRowsLowerBound(endTime);
 
-        if (iter != m_apiCallsTraceItemsMap.end() && iter != m_apiCallsTraceItemsMap.begin())
+        if (iter != m_apiCallsTraceRows.end() && iter != m_apiCallsTraceRows.begin())
         {
-            auto iterPrev = std::prev(iter);
+            quint32 previousRow = *std::prev(iter);
 
-            quint64 prevTime = iterPrev->second->GetTimelineItem()->startTime();
+            quint64 prevTime = m_columnStore.GetTimelineItem(previousRow)->startTime();
 
             if (prevTime < startTime)
             {
-                pParent = iterPrev->second;
+                parentRow = previousRow;
             }
         }
 
-        if (pParent != nullptr)
+        if (parentRow != TraceTableColumnStore::INVALID_ROW)
         {
-            if (pParent != m_pRootItem)
-            {
-                m_shouldExpandBeEnabled = true;
-            }
-
-            pParent->AppendChild(pRetVal);
+            m_shouldExpandBeEnabled = true;
+            InsertChild(parentRow, -1, retVal);
         }
         else
         {
-            // Add the pTableItem to the map:
-            m_apiCallsTraceItemsMap[endTime] = pRetVal;
+            // Add the pTableItem to the sorted items:
+            InsertToAPICallsTraceRows(retVal);
         }
     }
 
-    return pRetVal;
+    return retVal;
 }
 
 
-TraceTableItem* TraceTableModel::AddTopLevelTraceItem(const QString& strAPIPrefix, const QString& strApiName, IAPIInfoDataHandler* pApiInfo, acTimelineItem* pTimelineItem, acTimelineItem* pDeviceBlock, IOccupancyInfoDataHandler* pOccupancyInfo)
+quint32 TraceTableModel::AddTopLevelTraceItem(const QString& strAPIPrefix, const QString& strApiName, const gpTraceAPIRecord* pApiInfo, acTimelineItem* pTimelineItem, acTimelineItem* pDeviceBlock, IOccupancyInfoDataHandler* pOccupancyInfo)
 {
-    TraceTableItem* pRetVal = nullptr;
+    quint32 retVal = TraceTableColumnStore::INVALID_ROW;
 
     // Sanity check:
     GT_IF_WITH_ASSERT((pApiInfo != nullptr) && (pTimelineItem != nullptr))
     {
-        pRetVal = new TraceTableItem(strAPIPrefix, strApiName, pApiInfo, pTimelineItem, pDeviceBlock, pOccupancyInfo);
-
+        retVal = CreateAPIItem(strAPIPrefix, strApiName, pApiInfo, pTimelineItem, pDeviceBlock, pOccupancyInfo);
 
-        // Get the start and end time for the current pTableItem:
-        quint64 startTime = pApiInfo->GetApiStartTime();
-        quint64 endTime = pApiInfo->GetApiEndTime();
-
-        float cpuTimeSec = static_cast<float>((endTime - startTime) / 1000000.0f);
-        QVariant cpuTimeVar;
-        cpuTimeVar.setValue(cpuTimeSec);
-        pRetVal->SetColumnData(TRACE_CPU_TIME_COLUMN, cpuTimeVar);
-
-        if (pDeviceBlock != nullptr)
-        {
-            float gpuTimeSec = static_cast<float>((pDeviceBlock->endTime() - pDeviceBlock->startTime()) / 1000000.0f);
-            QVariant gpuTimeVar;
-            gpuTimeVar.setValue(gpuTimeSec);
-            pRetVal->SetColumnData(TRACE_DEVICE_TIME_COLUMN, gpuTimeVar);
-        }
-
-        // Add the pTableItem to the map:
-        m_apiCallsTraceItemsMap[endTime] = pRetVal;
+        // Add the pTableItem to the sorted items:
+        InsertToAPICallsTraceRows(retVal);
     }
 
-    return pRetVal;
+    return retVal;
 }
 
-TraceTableItem* TraceTableModel::AddTraceItem(const QString& strAPIPrefix, const QString& strMarkerName, IPerfMarkerInfoDataHandler* pMarkerEntry)
+quint32 TraceTableModel::InsertTopLevelTraceItem(const QString& strAPIPrefix, const QString& strApiName, const gpTraceAPIRecord* pApiInfo, acTimelineItem* pTimelineItem)
 {
-    TraceTableItem* pRetVal = nullptr;
+    quint32 retVal = TraceTableColumnStore::INVALID_ROW;
 
     // Sanity check:
-    GT_IF_WITH_ASSERT(pMarkerEntry != nullptr)
+    GT_IF_WITH_ASSERT((pApiInfo != nullptr) && (pTimelineItem != nullptr) && m_isInitialized)
     {
-        TraceTableItem* pParent = nullptr;
+        retVal = CreateAPIItem(strAPIPrefix, strApiName, pApiInfo, pTimelineItem, nullptr, nullptr);
 
-        // Create the new table pTableItem:
-        pRetVal = new TraceTableItem(strAPIPrefix, strMarkerName, pMarkerEntry, nullptr);
+        // The children of each item are sorted by their start time. Look for the row of the item, and go down into the
+        // perf marker preceding it as long as the marker contains the item:
+        const TraceTableColumnStore& store = m_columnStore;
+        quint32 parentRow = TraceTableColumnStore::INVALID_ROW;
+        int row = 0;
+        bool isParentFound = false;
 
-        if (!m_openedPerfMarkerItemsStack.isEmpty())
+        while (!isParentFound)
         {
-            pParent = m_openedPerfMarkerItemsStack.top();
+            const TraceTableItem* pParent = GetParentItem(parentRow);
+            const std::vector<quint32> noChildRows;
+            const std::vector<quint32>& childRows = (pParent != nullptr) ? pParent->m_childRows : noChildRows;
+
+            std::vector<quint32>::const_iterator iter = std::upper_bound(childRows.begin(), childRows.end(), pApiInfo->m_startTime, [&store](quint64 time, quint32 childRow)
+            {
+                return time < store.GetStartTime(childRow);
+            });
+
+            row = static_cast<int>(iter - childRows.begin());
+            quint32 previousRow = (row > 0) ? childRows[row - 1] : TraceTableColumnStore::INVALID_ROW;
+
+            if ((previousRow != TraceTableColumnStore::INVALID_ROW) && (store.GetItemType(previousRow) == PERFMARKER) && (store.GetEndTime(previousRow) >= pApiInfo->m_endTime))
+            {
+                parentRow = previousRow;
+            }
+            else
+            {
+                isParentFound = true;
+            }
         }
 
-        m_openedPerfMarkerItemsStack.push_back(pRetVal);
+        // In filter mode the tree is not shown, so only the matched items change the rows:
+        if (!m_isFiltered)
+        {
+            QModelIndex parentIndex = (parentRow == TraceTableColumnStore::INVALID_ROW) ? QModelIndex() : createIndex(m_rowsInParent[parentRow], 0, static_cast<quintptr>(parentRow));
+            beginInsertRows(parentIndex, row, row);
+        }
+
+        InsertChild(parentRow, row, retVal);
+
+        if (parentRow != TraceTableColumnStore::INVALID_ROW)
+        {
+            m_shouldExpandBeEnabled = true;
+            UpdateIndices(parentRow, store.GetFirstCallIndex(retVal), store.GetLastCallIndex(retVal));
+        }
+
+        if (!m_isFiltered)
+        {
+            endInsertRows();
+        }
     }
 
-    return pRetVal;
+    return retVal;
 }
 
-TraceTableItem* TraceTableModel::CloseLastOpenedPerfMarker(acTimelineItem* pTimelineItem)
+quint32 TraceTableModel::AddTraceItem(const QString& strAPIPrefix, const QString& strMarkerName, const gpTracePerfMarkerRecord* pMarkerEntry)
 {
-    TraceTableItem* pOpenedItem = m_openedPerfMarkerItemsStack.pop();
+    quint32 retVal = TraceTableColumnStore::INVALID_ROW;
 
-    Marker marker;
-    marker.m_pPerfMarkerItem = pOpenedItem;
-
-    if (!m_openedPerfMarkerItemsStack.empty())
+    // Sanity check:
+    GT_IF_WITH_ASSERT(pMarkerEntry != nullptr)
     {
-        marker.m_pParentMarker = m_openedPerfMarkerItemsStack.top();
+        // Create the new table row. The timeline item is set when the marker is closed:
+        static int dummy = 0;
+        dummy++;
+        retVal = m_columnStore.AddRow(PERFMARKER, strAPIPrefix, dummy, pMarkerEntry->m_threadId, strMarkerName, std::string(), std::string(), nullptr);
+        AddTreeRow(retVal);
+
+        m_openedPerfMarkerRowsStack.push_back(retVal);
     }
 
-    m_perfmarkerList.push_back(marker);
+    return retVal;
+}
+
+quint32 TraceTableModel::CloseLastOpenedPerfMarker(acTimelineItem* pTimelineItem)
+{
+    quint32 retVal = TraceTableColumnStore::INVALID_ROW;
 
-    GT_IF_WITH_ASSERT(pOpenedItem != nullptr)
+    GT_IF_WITH_ASSERT((pTimelineItem != nullptr) && !m_openedPerfMarkerRowsStack.isEmpty())
     {
-        // Set the timeline pTableItem:
-        pOpenedItem->SetTimelineItem(pTimelineItem);
+        retVal = m_openedPerfMarkerRowsStack.pop();
 
-        pOpenedItem->UpdateMarkerName(pTimelineItem->text());
+        if (!m_openedPerfMarkerRowsStack.isEmpty())
+        {
+            m_perfMarkerParentRows.insert(retVal, m_openedPerfMarkerRowsStack.top());
+        }
 
-        // Calculate the CPU time:
-        quint64 cpuTime = pTimelineItem->endTime() - pTimelineItem->startTime();
-        float cpuTimeSec = static_cast<float>(cpuTime / 1000000.0f);
-        QVariant cpuTimeVar;
-        cpuTimeVar.setValue(cpuTimeSec);
-        pOpenedItem->SetColumnData(TRACE_CPU_TIME_COLUMN, cpuTimeVar);
+        // Set the timeline item, the name and the CPU time:
+        m_columnStore.SetTimelineItem(retVal, pTimelineItem);
+        m_columnStore.SetName(retVal, pTimelineItem->text());
+        m_columnStore.SetTimes(retVal, pTimelineItem->startTime(), pTimelineItem->endTime());
 
         QPair<quint64, quint64> range;
         range.first = pTimelineItem->startTime();
         range.second = pTimelineItem->endTime();
-        m_perfMarkersTraceItemsMap[range] = pOpenedItem;
-        m_markerIntervals += make_pair(boosticl::interval<quint64>::closed(range.first, range.second), pOpenedItem);
+        m_perfMarkersTraceItemsMap[range] = retVal;
+        m_markerIntervals += make_pair(boosticl::interval<quint64>::closed(range.first, range.second), retVal + 1);
     }
 
-    return pOpenedItem;
+    return retVal;
 }
 
 int TraceTableModel::rowCount(const QModelIndex& parent) const
 {
     int retVal = 0;
 
-    TraceTableItem* parentItem;
-
-    if (parent.column() <= 0)
+    if (m_isFiltered)
     {
-
+        // In filter mode, the matched items are shown as a flat list:
         if (!parent.isValid())
         {
-            parentItem = m_pRootItem;
+            retVal = static_cast<int>(m_matchedRows.size());
         }
-        else
+    }
+    else if (parent.column() <= 0)
+    {
+        // Rows without an item have no children:
+        const TraceTableItem* pParentItem = GetParentItem(GetIndexStoreRow(parent));
+
+        if (pParentItem != nullptr)
         {
-            parentItem = static_cast<TraceTableItem*>(parent.internalPointer());
+            retVal = pParentItem->GetChildCount();
         }
-
-        retVal = parentItem->GetChildCount();
     }
 
     return retVal;
@@ -555,39 +680,45 @@ QVariant TraceTableModel::data(const QModelIndex& index, int role) const
         return QVariant();
     }
 
+    quint32 storeRow = GetIndexStoreRow(index);
+
     if (role == Qt::TextAlignmentRole)
     {
         return int(Qt::AlignLeft | Qt::AlignVCenter);
     }
+    else if (role == Qt::BackgroundRole)
+    {
+        // Highlight the items matched by the find toolbar (there is no need to highlight them in filter mode):
+        if (!m_isFiltered && (storeRow < m_isRowMatched.size()) && m_isRowMatched[storeRow])
+        {
+            return QVariant::fromValue(m_matchColor);
+        }
+    }
     else if (role == Qt::DisplayRole || role == Qt::ForegroundRole || role == Qt::FontRole || role == Qt::UserRole)
     {
-        TraceTableItem* pTableItem = static_cast<TraceTableItem*>(index.internalPointer());
-
-        GT_IF_WITH_ASSERT(pTableItem != nullptr)
+        GT_IF_WITH_ASSERT(storeRow < m_columnStore.GetRowCount())
         {
             if (role == Qt::DisplayRole)
             {
-                return pTableItem->GetColumnData(index.column());
+                return m_columnStore.GetColumnData(storeRow, index.column());
             }
             else if (role == Qt::ForegroundRole)
             {
                 QColor retVal;
 
-                if ((index.column() == TRACE_DEVICE_BLOCK_COLUMN && pTableItem->GetDeviceBlock() != nullptr) || (index.column() == TRACE_OCCUPANCY_COLUMN && pTableItem->GetOccupancyInfo() != nullptr))
+                if ((index.column() == TRACE_DEVICE_BLOCK_COLUMN && m_columnStore.GetDeviceBlock(storeRow) != nullptr) || (index.column() == TRACE_OCCUPANCY_COLUMN && m_columnStore.GetOccupancyInfo(storeRow) != nullptr))
                 {
                     retVal = m_linkColor;
                 }
                 else if (index.column() == TRACE_INTERFACE_COLUMN)
                 {
-                    PerfMarkerTimelineItem* pMarker = qobject_cast<PerfMarkerTimelineItem*>(pTableItem->GetTimelineItem());
-
-                    if (pMarker != nullptr)
+                    if (m_columnStore.GetItemType(storeRow) == PERFMARKER)
                     {
                         retVal = APIColorMap::Instance()->GetPerfMarkersColor();
                     }
                     else
                     {
-                        retVal = APIColorMap::Instance()->GetAPIColor(pTableItem->GetColumnData(TRACE_INTERFACE_COLUMN).toString(), m_defaultForegroundColor);
+                        retVal = APIColorMap::Instance()->GetAPIColor(m_columnStore.GetName(storeRow), m_defaultForegroundColor);
                     }
                 }
 
@@ -595,20 +726,16 @@ QVariant TraceTableModel::data(const QModelIndex& index, int role) const
             }
             else if (role == Qt::FontRole)
             {
-                if ((index.column() == TRACE_DEVICE_BLOCK_COLUMN && pTableItem->GetDeviceBlock() != nullptr) || (index.column() == TRACE_OCCUPANCY_COLUMN && pTableItem->GetOccupancyInfo() != nullptr))
+                if ((index.column() == TRACE_DEVICE_BLOCK_COLUMN && m_columnStore.GetDeviceBlock(storeRow) != nullptr) || (index.column() == TRACE_OCCUPANCY_COLUMN && m_columnStore.GetOccupancyInfo(storeRow) != nullptr))
                 {
                     return QVariant::fromValue(m_underlineFont);
                 }
 
                 return QVariant::fromValue(m_font);
             }
-            else if (role == Qt::TextAlignmentRole)
-            {
-                return QVariant(Qt::AlignLeft);
-            }
             else if (role == Qt::UserRole)
             {
-                return pTableItem->GetUniqueId();
+                return QVariant::fromValue(m_columnStore.GetUniqueId(storeRow));
             }
         }
     }
@@ -645,22 +772,22 @@ QModelIndex TraceTableModel::index(int row, int column, const QModelIndex& paren
         return QModelIndex();
     }
 
-    TraceTableItem* parentItem;
-
-    if (!parent.isValid())
-    {
-        parentItem = m_pRootItem;
-    }
-    else
+    if (m_isFiltered)
     {
-        parentItem = static_cast<TraceTableItem*>(parent.internalPointer());
+        // In filter mode, the matched items are the children of the root:
+        if (parent.isValid() || (row < 0) || (row >= static_cast<int>(m_matchedRows.size())))
+        {
+            return QModelIndex();
+        }
+
+        return createIndex(row, column, static_cast<quintptr>(m_matchedRows[row]));
     }
 
-    TraceTableItem* childItem = parentItem->GetChild(row);
+    const TraceTableItem* pParentItem = GetParentItem(GetIndexStoreRow(parent));
 
-    if (childItem != nullptr)
+    if ((pParentItem != nullptr) && (row < pParentItem->GetChildCount()))
     {
-        return createIndex(row, column, childItem);
+        return createIndex(row, column, static_cast<quintptr>(pParentItem->GetChildRow(row)));
     }
     else
     {
@@ -670,81 +797,91 @@ QModelIndex TraceTableModel::index(int row, int column, const QModelIndex& paren
 
 QModelIndex TraceTableModel::parent(const QModelIndex& index) const
 {
-    if (!index.isValid())
+    if (!index.isValid() || m_isFiltered)
     {
         return QModelIndex();
     }
 
-    TraceTableItem* childItem = static_cast<TraceTableItem*>(index.internalPointer());
-    TraceTableItem* parentItem = childItem->GetParent();
+    quint32 parentRow = m_parentRows[GetIndexStoreRow(index)];
 
-    if (parentItem == m_pRootItem)
+    if (parentRow == TraceTableColumnStore::INVALID_ROW)
     {
         return QModelIndex();
     }
 
-    return createIndex(parentItem->GetRow(), 0, parentItem);
+    return createIndex(m_rowsInParent[parentRow], 0, static_cast<quintptr>(parentRow));
 }
 
-acTimelineItem* TraceTableModel::GetDeviceBlock(const QModelIndex& index)
+acTimelineItem* TraceTableModel::GetDeviceBlock(const QModelIndex& index) const
 {
     acTimelineItem* retVal = nullptr;
 
     if (index.isValid())
     {
-        TraceTableItem* childItem = static_cast<TraceTableItem*>(index.internalPointer());
-        retVal = childItem->GetDeviceBlock();
+        retVal = m_columnStore.GetDeviceBlock(GetIndexStoreRow(index));
     }
 
     return retVal;
 }
 
-IOccupancyInfoDataHandler* TraceTableModel::GetOccupancyItem(const QModelIndex& index)
+IOccupancyInfoDataHandler* TraceTableModel::GetOccupancyItem(const QModelIndex& index) const
 {
     IOccupancyInfoDataHandler* pRetVal = nullptr;
 
     if (index.isValid())
     {
-        TraceTableItem* childItem = static_cast<TraceTableItem*>(index.internalPointer());
-        pRetVal = childItem->GetOccupancyInfo();
+        pRetVal = m_columnStore.GetOccupancyInfo(GetIndexStoreRow(index));
+    }
+
+    return pRetVal;
+}
+
+acTimelineItem* TraceTableModel::GetTimelineItem(const QModelIndex& index) const
+{
+    acTimelineItem* pRetVal = nullptr;
+
+    if (index.isValid())
+    {
+        pRetVal = m_columnStore.GetTimelineItem(GetIndexStoreRow(index));
     }
 
     return pRetVal;
 }
 
-bool TraceTableItemComparer(TraceTableItem* pFirst, TraceTableItem* pSecond)
+/// Compares the timeline items of two rows, to sort the rows in the table order
+static bool TraceTableItemComparer(TraceTableItemType firstType, const acTimelineItem* pFirst, TraceTableItemType secondType, const acTimelineItem* pSecond)
 {
-    if (pFirst->m_itemType == API && pSecond->m_itemType == PERFMARKER)
+    if (firstType == API && secondType == PERFMARKER)
     {
         // API - PERFMARKER
-        if (pFirst->GetTimelineItem()->endTime() <= pSecond->GetTimelineItem()->startTime())
+        if (pFirst->endTime() <= pSecond->startTime())
         {
             return true;
         }
     }
 
-    if (pFirst->m_itemType == PERFMARKER && pSecond->m_itemType == API)
+    if (firstType == PERFMARKER && secondType == API)
     {
         // PERFMARKER - API
-        if (pFirst->GetTimelineItem()->startTime() <= pSecond->GetTimelineItem()->startTime() &&
-            pFirst->GetTimelineItem()->endTime() >= pSecond->GetTimelineItem()->endTime())
+        if (pFirst->startTime() <= pSecond->startTime() &&
+            pFirst->endTime() >= pSecond->endTime())
         {
             return true;
         }
     }
 
-    if (pFirst->m_itemType == PERFMARKER && pSecond->m_itemType == PERFMARKER)
+    if (firstType == PERFMARKER && secondType == PERFMARKER)
     {
         // PERFMARKER - PERFMARKER
-        if (pFirst->GetTimelineItem()->startTime() <= pSecond->GetTimelineItem()->startTime() &&
-            pFirst->GetTimelineItem()->endTime() >= pSecond->GetTimelineItem()->endTime())
+        if (pFirst->startTime() <= pSecond->startTime() &&
+            pFirst->endTime() >= pSecond->endTime())
         {
             return true;
         }
     }
 
     // Other Cases
-    if (pFirst->GetTimelineItem()->endTime() <= pSecond->GetTimelineItem()->startTime())
+    if (pFirst->endTime() <= pSecond->startTime())
     {
         return true;
     }
@@ -756,81 +893,70 @@ bool TraceTableModel::InitializeModel()
 {
     bool retVal = false;
 
-    GT_IF_WITH_ASSERT(m_pRootItem != nullptr)
-    {
-        // Go through the marker items, and the API items in parallel, and add it to the table:
-        auto apiIter = m_apiCallsTraceItemsMap.begin();
-        auto apiIterEnd = m_apiCallsTraceItemsMap.end();
-
-        auto markersIter = m_perfMarkersTraceItemsMap.begin();
-        auto markersIterEnd = m_perfMarkersTraceItemsMap.end();
+    int itemCount = m_apiCallsTraceRows.size() + m_perfMarkersTraceItemsMap.size();
 
-        int itemCount = m_apiCallsTraceItemsMap.size() + m_perfMarkersTraceItemsMap.size();
+    if (m_perfMarkersTraceItemsMap.isEmpty())
+    {
+        m_rootItem.ReserveChildrenCount(itemCount);
+    }
 
-        if (m_perfMarkersTraceItemsMap.isEmpty())
-        {
-            m_pRootItem->ReserveChildrenCount(itemCount);
-        }
+    afProgressBarWrapper::instance().setProgressText(GPU_STR_TraceViewLoadingTraceTableItemsProgress);
 
-        afProgressBarWrapper::instance().setProgressText(GPU_STR_TraceViewLoadingTraceTableItemsProgress);
+    // Go over the API items and the markers item, and add them to the table:
+    std::vector<quint32> leftTraceTableRowList;
+    leftTraceTableRowList.reserve(itemCount);
+    leftTraceTableRowList.insert(leftTraceTableRowList.end(), m_apiCallsTraceRows.begin(), m_apiCallsTraceRows.end());
 
-        // Go over the API items and the markers item, and add them to the table:
-        std::vector<TraceTableItem*> leftTraceTableItemList;
+    for (auto itr = m_perfMarkersTraceItemsMap.begin(); itr != m_perfMarkersTraceItemsMap.end(); ++itr)
+    {
+        leftTraceTableRowList.push_back(itr.value());
+    }
 
-        for (auto itr = m_apiCallsTraceItemsMap.begin(); itr != m_apiCallsTraceItemsMap.end(); ++itr)
-        {
-            itr->second->m_itemType = API;
-            leftTraceTableItemList.push_back(itr->second);
-        }
+    const TraceTableColumnStore& store = m_columnStore;
+    std::sort(leftTraceTableRowList.begin(), leftTraceTableRowList.end(), [&store](quint32 firstRow, quint32 secondRow)
+    {
+        return TraceTableItemComparer(store.GetItemType(firstRow), store.GetTimelineItem(firstRow), store.GetItemType(secondRow), store.GetTimelineItem(secondRow));
+    });
 
-        for (auto itr = m_perfMarkersTraceItemsMap.begin(); itr != m_perfMarkersTraceItemsMap.end(); ++itr)
-        {
-            itr.value()->m_itemType = PERFMARKER;
-            leftTraceTableItemList.push_back(itr.value());
-        }
+    for (quint32 nextRowToAdd : leftTraceTableRowList)
+    {
+        /// calculate next item parent
+        quint32 parentRow = GetNextItemParent(nextRowToAdd, m_columnStore.GetItemType(nextRowToAdd));
 
-        std::sort(leftTraceTableItemList.begin(), leftTraceTableItemList.end(), TraceTableItemComparer);
-        unsigned int listIndx = 0;
+        // Add the child to the appropriate parent:
+        InsertChild(parentRow, -1, nextRowToAdd);
 
-        while (listIndx < leftTraceTableItemList.size())
+        if (parentRow != TraceTableColumnStore::INVALID_ROW)
         {
-            /// calculate next item and advance iterator
-            TraceTableItem* pNextItemToAdd = leftTraceTableItemList[listIndx];
-            TraceTableItem* pParent = GetNextItemParent(pNextItemToAdd, pNextItemToAdd->m_itemType);
-            GT_IF_WITH_ASSERT(pParent != nullptr)
-            {
-                // Add the child to the appropriate parent:
-                pParent->AppendChild(pNextItemToAdd);
-
-                if (pParent != m_pRootItem)
-                {
-                    pParent->UpdateIndices(pNextItemToAdd->GetStartIndex(), pNextItemToAdd->GetEndIndex());
-                }
-
-                afProgressBarWrapper::instance().incrementProgressBar();
-            }
-            listIndx++;
+            UpdateIndices(parentRow, m_columnStore.GetFirstCallIndex(nextRowToAdd), m_columnStore.GetLastCallIndex(nextRowToAdd));
         }
 
-        m_apiCallsTraceItemsMap.clear();
-        m_perfMarkersTraceItemsMap.clear();
-        m_markerIntervals.clear();
-        retVal = true;
+        afProgressBarWrapper::instance().incrementProgressBar();
     }
 
+    m_apiCallsTraceRows.clear();
+    m_apiCallsTraceRows.shrink_to_fit();
+    m_perfMarkersTraceItemsMap.clear();
+    m_markerIntervals.clear();
+    m_perfMarkerParentRows.clear();
+    retVal = true;
+
     m_isInitialized = retVal;
     return retVal;
 }
+
 /// returns items parent , by default it's a root item,unless overlapping marker item is found
-TraceTableItem* TraceTableModel::GetNextItemParent(const TraceTableItem* pNextItemToAdd, const TraceTableItemType& itemType) const
+quint32 TraceTableModel::GetNextItemParent(quint32 nextRowToAdd, TraceTableItemType itemType) const
 {
     // Look for the right parent for this item:
     // By default all items are immediate children of the root node
-    TraceTableItem* pParent = m_pRootItem;
-    GT_IF_WITH_ASSERT(pNextItemToAdd != nullptr)
+    quint32 parentRow = TraceTableColumnStore::INVALID_ROW;
+    const acTimelineItem* pNextTimelineItem = m_columnStore.GetTimelineItem(nextRowToAdd);
+
+    GT_IF_WITH_ASSERT(pNextTimelineItem != nullptr)
     {
-        quint64 nextItemStartTime = pNextItemToAdd->GetTimelineItem()->startTime();
-        quint64 nextItemEndTime = pNextItemToAdd->GetTimelineItem()->endTime();
+        quint64 nextItemStartTime = pNextTimelineItem->startTime();
+        quint64 nextItemEndTime = pNextTimelineItem->endTime();
 
         // Temporary Solution - Intervals is not feasible with same lower and upper bound
         if (nextItemStartTime == nextItemEndTime)
@@ -846,151 +972,162 @@ TraceTableItem* TraceTableModel::GetNextItemParent(const TraceTableItem* pNextIt
 
             if (itr != m_markerIntervals.end())
             {
-                auto pMarker = itr->second;
+                quint32 markerRow = itr->second - 1;
 
                 //check if next item we're adding overlapped by the found marker , if so make it next item parent
-                if (pMarker != pNextItemToAdd)
+                if (markerRow != nextRowToAdd)
                 {
-                    if (pMarker->GetTimelineItem() != nullptr &&
-                        pMarker->GetTimelineItem()->startTime() <= nextItemStartTime &&
-                        pMarker->GetTimelineItem()->endTime() >= nextItemEndTime)
+                    const acTimelineItem* pMarkerTimelineItem = m_columnStore.GetTimelineItem(markerRow);
+
+                    if (pMarkerTimelineItem != nullptr &&
+                        pMarkerTimelineItem->startTime() <= nextItemStartTime &&
+                        pMarkerTimelineItem->endTime() >= nextItemEndTime)
                     {
-                        pParent = pMarker;
+                        parentRow = markerRow;
                     }
                 }
             }
         }
         else
         {
-            for (std::vector<Marker>::const_iterator it = m_perfmarkerList.begin();
-                 it != m_perfmarkerList.end(); ++it)
-            {
-                if (pNextItemToAdd == it->m_pPerfMarkerItem && nullptr != it->m_pParentMarker)
-                {
-                    pParent = it->m_pParentMarker;
-                }
-            }
+            parentRow = m_perfMarkerParentRows.value(nextRowToAdd, TraceTableColumnStore::INVALID_ROW);
         }
     }
 
-    return pParent;
+    return parentRow;
 }
 
-/// calculates next item and advance one of iterators - marker or api iterator
-TraceTableItem* TraceTableModel::CalculateNextTraceTableItem(PerfMarkersMapItr& markersIter, const PerfMarkersMapItr& markersIterEnd,
-                                                             ApiCallsTraceMapItr& apiIter, const ApiCallsTraceMapItr& apiIterEnd, TraceTableItemType& itemType) const
+void TraceTableModel::SetAPICallsNumber(unsigned int apiNum)
 {
-    TraceTableItem* pNextItemToAdd = nullptr;
-    TraceTableItem* pCurrentAPI = (apiIter != apiIterEnd) ? apiIter->second : nullptr;
-    TraceTableItem* pCurrentMarker = (markersIter != markersIterEnd) ? markersIter.value() : nullptr;
+    // set reserved items - for checking before tab creation
+    m_reservedApiCallsTraceItems = apiNum;
 
-    quint64 currentApiStartTime = 0u;
-    quint64 currentMarkerStartTime = 0u;
+    // The API calls number is known before the items are added, so the columns are allocated once:
+    m_columnStore.Reserve(apiNum);
+    m_parentRows.reserve(apiNum);
+    m_rowsInParent.reserve(apiNum);
+    m_apiCallsTraceRows.reserve(apiNum);
+}
 
-    if (nullptr != pCurrentAPI)
-    {
-        currentApiStartTime = pCurrentAPI->GetTimelineItem()->startTime();
-    }
+void TraceTableModel::GetTopLevelRows(std::vector<quint32>& storeRows) const
+{
+    storeRows = m_rootItem.m_childRows;
+}
+
+void TraceTableModel::GetTimeRangeRows(quint64 startTime, quint64 endTime, std::vector<quint32>& storeRows) const
+{
+    storeRows.clear();
+
+    // Go through the tree depth first, so that parents come before their children:
+    QStack<quint32> rowsStack;
 
-    if (nullptr != pCurrentMarker)
+    for (int row = m_rootItem.GetChildCount() - 1; row >= 0; --row)
     {
-        currentMarkerStartTime = pCurrentMarker->GetTimelineItem()->startTime();
+        rowsStack.push(m_rootItem.GetChildRow(row));
     }
 
-    // There are some markers which are not yet added
-    if (nullptr != pCurrentMarker)
+    while (!rowsStack.isEmpty())
     {
-        if (currentMarkerStartTime <= currentApiStartTime)
+        quint32 storeRow = rowsStack.pop();
+
+        if (IsInTimeRange(storeRow, startTime, endTime))
         {
-            pNextItemToAdd = pCurrentMarker;
-            itemType = PERFMARKER;
-            ++markersIter;
+            storeRows.push_back(storeRow);
         }
-        else
+
+        const TraceTableItem* pItem = GetParentItem(storeRow);
+
+        if (pItem != nullptr)
         {
-            pNextItemToAdd = pCurrentAPI;
-            itemType = API;
-            ++apiIter;
+            for (int row = pItem->GetChildCount() - 1; row >= 0; --row)
+            {
+                rowsStack.push(pItem->GetChildRow(row));
+            }
         }
     }
-    else if (nullptr != pCurrentAPI)
-    {
-        pNextItemToAdd = pCurrentAPI;
-        itemType = API;
-        ++apiIter;
-    }
-
-    return pNextItemToAdd;
-}
-
-
-void TraceTableModel::SetAPICallsNumber(unsigned int apiNum)
-{
-    // set reserved items - for checking before tab creation
-    m_reservedApiCallsTraceItems = apiNum;
 }
 
-bool TraceTableModel::ExportToCSV(const QString& outputFilePath)
+void TraceTableModel::AddMatchedRows(const std::vector<quint32>& storeRows)
 {
-    bool retVal = false;
-
-    // Sanity check:
-    GT_IF_WITH_ASSERT(m_pRootItem != nullptr)
+    if (!storeRows.empty())
     {
-        // Define a file handle:
-        QFile fileHandle(outputFilePath);
-
-        // Open the file for write:
-        bool rcOpen = fileHandle.open(QFile::WriteOnly | QFile::Truncate);
-
-        if (rcOpen)
+        // Rows inserted after the previous matches were added are not matched:
+        if (m_isRowMatched.size() != m_columnStore.GetRowCount())
         {
-            QTextStream data(&fileHandle);
-            QStringList strList;
+            m_isRowMatched.resize(m_columnStore.GetRowCount(), false);
+        }
 
+        int firstNewRow = static_cast<int>(m_matchedRows.size());
 
-            // Get the row count:
-            int rowCount = m_pRootItem->GetChildCount();
+        if (m_isFiltered)
+        {
+            beginInsertRows(QModelIndex(), firstNewRow, firstNewRow + static_cast<int>(storeRows.size()) - 1);
+        }
 
-            // Write the headers:
-            for (int i = 0; i < TRACE_COLUMN_COUNT; ++i)
+        for (quint32 storeRow : storeRows)
+        {
+            GT_IF_WITH_ASSERT(storeRow < m_isRowMatched.size())
             {
-                QString headerString = headerData(i, Qt::Horizontal, Qt::DisplayRole).toString();
-                strList << AC_STR_Quot + headerString + AC_STR_Quot;
+                m_isRowMatched[storeRow] = true;
+                m_matchedRows.push_back(storeRow);
             }
+        }
 
-            // Write a new line:
-            data << strList.join(AC_STR_CommaA) << AC_STR_NewLineA;
-            strList.clear();
+        if (m_isFiltered)
+        {
+            endInsertRows();
+        }
+    }
+}
 
-            // Go through the rows and export each of them:
-            for (int row = 0; row < rowCount; ++row)
-            {
-                QString rowStr;
-                TraceTableItem* pRowItem = m_pRootItem->GetChild(row);
+void TraceTableModel::ClearMatchedRows()
+{
+    if (m_isFiltered)
+    {
+        beginResetModel();
+    }
 
-                for (int column = 0; column < TRACE_COLUMN_COUNT; ++column)
-                {
-                    QString colString = pRowItem->GetColumnData(column).toString();
-                    colString.replace("\"", "\"\"");
-                    strList << AC_STR_Quot + colString + AC_STR_Quot;
-                }
+    m_isRowMatched.clear();
+    m_matchedRows.clear();
 
-                data << strList.join(AC_STR_CommaA) << AC_STR_NewLineA;
-                strList.clear();
-            }
+    if (m_isFiltered)
+    {
+        endResetModel();
+    }
+}
 
-            // Close the file:
-            fileHandle.close();
+void TraceTableModel::SetFilterMode(bool isFiltered)
+{
+    if (m_isFiltered != isFiltered)
+    {
+        beginResetModel();
+        m_isFiltered = isFiltered;
+        endResetModel();
+    }
+}
 
-            retVal = true;
+QModelIndex TraceTableModel::GetStoreRowIndex(quint32 storeRow) const
+{
+    QModelIndex retVal;
+
+    if (m_isFiltered)
+    {
+        // The matched rows are sorted:
+        std::vector<quint32>::const_iterator iter = std::lower_bound(m_matchedRows.begin(), m_matchedRows.end(), storeRow);
+
+        if ((iter != m_matchedRows.end()) && (*iter == storeRow))
+        {
+            retVal = createIndex(static_cast<int>(iter - m_matchedRows.begin()), 0, static_cast<quintptr>(storeRow));
         }
     }
+    else if ((storeRow < m_rowsInParent.size()) && (m_rowsInParent[storeRow] >= 0))
+    {
+        retVal = createIndex(m_rowsInParent[storeRow], 0, static_cast<quintptr>(storeRow));
+    }
 
     return retVal;
 }
 
-
 void TraceTableModel::BuildHeaderData()
 {
     m_headerData.clear();
@@ -1201,16 +1338,47 @@ int TraceTable::NumOfSelectedRows() const
     return selectionModel()->selectedRows().count();
 }
 
-bool TraceTable::ExportToCSV(const QString& outputFilePath)
+void TraceTable::GetVisibleRows(std::vector<quint32>& storeRows) const
 {
-    bool retVal = false;
-    TraceTableModel* pModel = qobject_cast<TraceTableModel*>(model());
-    GT_IF_WITH_ASSERT(pModel != nullptr)
+    storeRows.clear();
+
+    // Go through the shown rows depth first, and only into the expanded rows:
+    QStack<QModelIndex> indexesStack;
+    indexesStack.push(QModelIndex());
+
+    while (!indexesStack.isEmpty())
     {
-        retVal = pModel->ExportToCSV(outputFilePath);
+        QModelIndex parentIndex = indexesStack.pop();
+
+        if (parentIndex.isValid())
+        {
+            storeRows.push_back(TraceTableModel::GetIndexStoreRow(parentIndex));
+        }
+
+        if (!parentIndex.isValid() || isExpanded(parentIndex))
+        {
+            for (int row = model()->rowCount(parentIndex) - 1; row >= 0; --row)
+            {
+                indexesStack.push(model()->index(row, 0, parentIndex));
+            }
+        }
     }
+}
 
-    return retVal;
+void TraceTable::GetVisibleColumns(std::vector<int>& columns) const
+{
+    columns.clear();
+
+    // The columns may have been moved by the user, so follow the header visual order:
+    for (int visualIndex = 0; visualIndex < header()->count(); ++visualIndex)
+    {
+        int logicalIndex = header()->logicalIndex(visualIndex);
+
+        if (!isColumnHidden(logicalIndex))
+        {
+            columns.push_back(logicalIndex);
+        }
+    }
 }
 
 void TraceTable::SetHiddenColumnsList(const QList<TraceTableModel::TraceTableColIndex>& hiddenColumnsList)
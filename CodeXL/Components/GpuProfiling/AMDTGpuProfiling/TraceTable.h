@@ -30,12 +30,19 @@
     #pragma warning(pop)
 #endif
 
+// std
+#include <vector>
+
 // boost
 #include <boost/icl/split_interval_map.hpp>
 
 //BackEnd
 #include <ATPParserInterface.h>
 
+// Local
+#include <AMDTGpuProfiling/gpTraceSessionIndex.h>
+#include <AMDTGpuProfiling/gpTraceSearch.h>
+
 // forward declarations
 class acTimelineItem;
 
@@ -46,124 +53,199 @@ enum TraceTableItemType
     PERFMARKER      ///< Perfmarker Item
 };
 
-/// Class to hold the item data for the API Trace table model
-class TraceTableItem
+/// Columnar storage for the data of the trace table rows.
+/// Each row's values are kept in flat arrays, and the strings that repeat across rows (API names, results,
+/// unique id prefixes, thread ids) are interned. The display strings are formatted only when a cell is displayed.
+/// The device blocks and occupancy infos are only set for the few enqueue and dispatch rows, so they are kept in hash tables.
+/// The class is final, so that the calls through a TraceTableColumnStore to the gpTraceSearchStore getters are not virtual
+class TraceTableColumnStore final : public gpTraceSearchStore
 {
 public:
-    /// Initializes a new instance of the TraceTableItem class
-    /// \param strAPIPrefix an API-specific prefix used (along with the sequence id) to uniquely identify each trace item (i.e. "OpenCL" or "HSA")
-    /// \param strApiName the name of the method for this item
-    /// \param pApiInfo structure containing info about this api (params, return val, timestamps, etc...)
-    /// \param pTimelineItem the timeline item that corresponds to this trace item
-    /// \param pDeviceBlock the device block timeline item that corresponds to this trace item (can be NULL)
-    /// \param pOccupancyInfo the occupancy info that corresponds to this trace item (can be NULL)
-    TraceTableItem(const QString& strAPIPrefix, const QString& strApiName, IAPIInfoDataHandler* pApiInfo, acTimelineItem* pTimelineItem, acTimelineItem* pDeviceBlock, IOccupancyInfoDataHandler* pOccupancyInfo);
+    /// Value used for "no row": the parent of the top level rows, and the rows that could not be added
+    static const quint32 INVALID_ROW = 0xFFFFFFFF;
 
-    /// Initializes a new instance of the TraceTableItem class
-    /// \param strAPIPrefix an API-specific prefix used (along with the sequence id) to uniquely identify each trace item (i.e. "OpenCL" or "HSA")
-    /// \param strMarkerName the name of the marker for this item
-    /// \param pMarkerEntry structure containing info about this marker
-    /// \param pTimelineItem the timeline item that corresponds to this trace item
-    TraceTableItem(const QString& strAPIPrefix, const QString& strMarkerName, IPerfMarkerInfoDataHandler* pMarkerEntry, acTimelineItem* pTimelineItem);
+    /// Initializes a new instance of the TraceTableColumnStore class
+    TraceTableColumnStore();
 
-    /// Destructor
-    virtual ~TraceTableItem();
+    /// Reserves place for the specified number of rows
+    /// \param rowsCount the expected number of rows
+    void Reserve(size_t rowsCount);
 
-    /// Appends a child to the end of the child list of this item
-    /// \param child the child item to append
-    void AppendChild(TraceTableItem* child);
+    /// Adds a data row
+    /// \param itemType the type of the row
+    /// \param strUniqueIdPrefix the prefix of the row unique id
+    /// \param uniqueIdNumber the number appended to the prefix to build the row unique id
+    /// \param threadId the thread of the API or marker
+    /// \param strName the API or marker name
+    /// \param strArguments the API arguments
+    /// \param strResult the API result
+    /// \param pTimelineItem the timeline item of the row (can be null until the perf marker is closed)
+    /// \return the index of the new row
+    quint32 AddRow(TraceTableItemType itemType, const QString& strUniqueIdPrefix, quint64 uniqueIdNumber, quint64 threadId, const QString& strName,
+                   const std::string& strArguments, const std::string& strResult, acTimelineItem* pTimelineItem);
 
-    /// Inserts a child at the specified index in the child list of this item
-    /// \param index the index at which to insert the child
-    /// \param child the child item to append
-    void InsertChild(int index, TraceTableItem* child);
+    /// Sets the CPU start and end time of a row
+    /// \param row the row index
+    /// \param startTime the start time
+    /// \param endTime the end time
+    void SetTimes(quint32 row, quint64 startTime, quint64 endTime);
 
-    /// Gets the parent of this item
-    /// \return the parent of this item
-    TraceTableItem* GetParent() const { return m_parent; }
+    /// Sets the name of a row
+    /// \param row the row index
+    /// \param strName the API or marker name
+    void SetName(quint32 row, const QString& strName) { m_nameIds[row] = InternString(strName); }
 
-    /// Gets the unique ID for this item
-    /// \return the unique ID for this item
-    QVariant GetUniqueId() { return m_uniqueId; }
+    /// Sets the timeline item of a row
+    void SetTimelineItem(quint32 row, acTimelineItem* pTimelineItem) { m_timelineItems[row] = pTimelineItem; }
 
-    /// Gets the number of children this node has
-    /// \return the number of children this node has
-    int GetChildCount() const { return m_children.count(); }
+    /// Sets the device block and the occupancy info of a row
+    /// \param row the row index
+    /// \param pDeviceBlock the device block timeline item (can be null)
+    /// \param pOccupancyInfo the occupancy info (can be null)
+    void SetDeviceData(quint32 row, acTimelineItem* pDeviceBlock, IOccupancyInfoDataHandler* pOccupancyInfo);
 
-    /// Reserves a count places of children:
-    void ReserveChildrenCount(int count) { m_children.reserve(count); }
+    /// Sets the range of call indices shown in the index column of a row. Rows with a single call have no last index
+    /// \param row the row index
+    /// \param firstCallIndex the first call index, -1 for none
+    /// \param lastCallIndex the last call index, -1 for none
+    void SetCallIndices(quint32 row, int firstCallIndex, int lastCallIndex);
 
-    /// Gets the specified child
-    /// \param childIndex the index of the child requested
-    /// \return the specified child
-    TraceTableItem* GetChild(int childIndex) const { return m_children[childIndex]; }
+    /// \return the type of the row
+    TraceTableItemType GetItemType(quint32 row) const { return static_cast<TraceTableItemType>(m_itemTypes[row]); }
+
+    /// \return the API or marker name of the row
+    const QString& GetName(quint32 row) const { return m_internedStrings[m_nameIds[row]]; }
+
+    /// \return the API result of the row
+    const QString& GetResult(quint32 row) const { return m_internedStrings[m_resultIds[row]]; }
+
+    /// \return the API arguments of the row
+    QString GetArguments(quint32 row) const;
+
+    /// \return the unique id of the row
+    QString GetUniqueId(quint32 row) const;
+
+    /// \return the thread of the API or marker of the row
+    quint64 GetThreadId(quint32 row) const { return m_threadIds[m_threadIdIndexes[row]]; }
+
+    /// \return the CPU start time of the row
+    virtual quint64 GetStartTime(quint32 row) const override { return m_startTimes[row]; }
+
+    /// \return the CPU end time of the row
+    virtual quint64 GetEndTime(quint32 row) const override { return m_endTimes[row]; }
 
-    /// Gets the data for the specified column
-    /// \param columnIndex the index of the column whose data is needed
-    /// \return the data for the specified column
-    QVariant GetColumnData(int columnIndex) const;
+    /// \return the timeline item of the row
+    acTimelineItem* GetTimelineItem(quint32 row) const { return m_timelineItems[row]; }
 
-    /// Gets the data for the specified column
-    /// \param columnIndex the index of the column whose data should be set
-    /// \param data the data for the specified column
-    void SetColumnData(int columnIndex, QVariant data);
+    /// \return the device block timeline item of the row, null if it has none
+    acTimelineItem* GetDeviceBlock(quint32 row) const { return m_deviceBlocks.value(row, nullptr); }
 
-    /// Gets the timeline item associated with this item
-    /// \return the timeline item associated with this item
-    acTimelineItem* GetTimelineItem() const { return m_pTimelineItem; }
+    /// \return the occupancy info of the row, null if it has none
+    IOccupancyInfoDataHandler* GetOccupancyInfo(quint32 row) const { return m_occupancyInfos.value(row, nullptr); }
 
-    /// \Set the timeline item associated with this item
-    void SetTimelineItem(acTimelineItem* pItem) { m_pTimelineItem = pItem; }
+    /// \return the first call index of the row, -1 if none
+    int GetFirstCallIndex(quint32 row) const { return m_firstCallIndices[row]; }
 
-    /// Gets the device block timeline item associated with this item (can be null)
-    /// \return the device block timeline item associated with this item
-    acTimelineItem* GetDeviceBlock() const { return m_pDeviceBlock; }
+    /// \return the last call index of the row, -1 if none
+    int GetLastCallIndex(quint32 row) const { return m_lastCallIndices[row]; }
 
-    /// Gets the occupancy info associated with this item (can be null)
-    /// \return the occupancy info associated with this item
-    IOccupancyInfoDataHandler* GetOccupancyInfo() const { return m_pOccupancyInfo; }
+    /// \return the number of rows
+    virtual quint32 GetRowCount() const override { return static_cast<quint32>(m_nameIds.size()); }
+
+    /// \return the interned id of the name of the row
+    virtual quint32 GetNameId(quint32 row) const override { return m_nameIds[row]; }
 
-    /// Gets the index of this item within its parent
-    /// \return the index of this item within its parent
-    int GetRow() const;
+    /// \return the number of interned strings. Interned ids are smaller than this count
+    virtual quint32 GetInternedStringsCount() const override { return static_cast<quint32>(m_internedStrings.size()); }
 
-    /// Update the start & end indices with the current added child index:
-    /// \param childStartIndex start updating from childStartIndex
-    /// \param childEndIndex end updating at childEndIndex
-    void UpdateIndices(int childStartIndex, int childEndIndex);
+    /// \return the interned string with the specified id
+    virtual const QString& GetInternedString(quint32 id) const override { return m_internedStrings[id]; }
 
-    /// Gets the item start index
-    /// \return the item start index
-    int GetStartIndex() const { return m_startIndex; }
+    /// \return the arguments of all rows (UTF8, not null terminated). The arguments of a row start at GetArgumentsOffset
+    virtual const char* GetArgumentsChars() const override { return m_argumentsChars.data(); }
 
-    /// Gets the item end index
-    /// \return the item end index
-    int GetEndIndex() const { return m_endIndex; }
+    /// \return the offset of the arguments of the row in GetArgumentsChars
+    virtual quint64 GetArgumentsOffset(quint32 row) const override { return m_argumentsOffsets[row]; }
 
-    /// Updates the marker name for an existing perf marker
-    /// \param strMarkerName the new marker name for the item
-    void UpdateMarkerName(const QString& strMarkerName);
+    /// \return the length of the arguments of the row
+    virtual quint32 GetArgumentsLength(quint32 row) const override { return m_argumentsLengths[row]; }
 
-    /// type of the trace table item
-    TraceTableItemType m_itemType;
+    /// Gets the data of a cell. The data is formatted from the columns on each call
+    /// \param row the row index
+    /// \param columnIndex the TraceTableModel::TraceTableColIndex of the cell
+    /// \return the data of the cell
+    QVariant GetColumnData(quint32 row, int columnIndex) const;
 
 private:
+    /// Gets the id of an interned string, adding it to the interned strings if needed
+    /// \param str the string
+    /// \return the interned string id
+    quint32 InternString(const QString& str);
+
+    /// Gets the index of a thread id, adding it to the thread ids if needed
+    /// \param threadId the thread id
+    /// \return the thread id index
+    quint32 InternThreadId(quint64 threadId);
+
     /// Disable copy constructor
-    TraceTableItem(const TraceTableItem&);
+    TraceTableColumnStore(const TraceTableColumnStore&);
 
     /// Disable default assignment operator
-    const TraceTableItem& operator=(const TraceTableItem& obj);
-
-    QList<TraceTableItem*> m_children;  ///< list of children of this item
-    TraceTableItem* m_parent;           ///< the parent of this item
-
-    QList<QVariant> m_data;             ///< list of column data
-    int m_startIndex;                   ///< The item start index (-1 in case where index is irelevant)
-    int m_endIndex;                     ///< The item end index (-1 in case where index is irelevant)
-    acTimelineItem* m_pTimelineItem;    ///< the timeline item for this trace table item
-    acTimelineItem* m_pDeviceBlock;     ///< the device block for this trace table item (can be null)
-    IOccupancyInfoDataHandler* m_pOccupancyInfo;    ///< the occupancy info for this trace table item (can be null)
-    QVariant m_uniqueId;                ///< the unique id of the item.  This is returned from the model data for the Qt::UserRole
+    const TraceTableColumnStore& operator=(const TraceTableColumnStore& obj);
+
+    QVector<QString>        m_internedStrings;      ///< the interned strings
+    QHash<QString, quint32> m_internedStringIds;    ///< a map from an interned string to its id
+    std::vector<quint64>    m_threadIds;            ///< the interned thread ids. A table usually holds the calls of a single thread
+
+    std::vector<quint8>     m_itemTypes;            ///< per row: the TraceTableItemType
+    std::vector<quint32>    m_uniqueIdPrefixIds;    ///< per row: the interned id of the unique id prefix
+    std::vector<quint64>    m_uniqueIdNumbers;      ///< per row: the number of the unique id
+    std::vector<quint32>    m_threadIdIndexes;      ///< per row: the index of the thread id in m_threadIds
+    std::vector<quint32>    m_nameIds;              ///< per row: the interned id of the name
+    std::vector<quint32>    m_resultIds;            ///< per row: the interned id of the result
+    std::vector<quint64>    m_argumentsOffsets;     ///< per row: the offset of the arguments in m_argumentsChars
+    std::vector<quint32>    m_argumentsLengths;     ///< per row: the length of the arguments
+    std::vector<char>       m_argumentsChars;       ///< the arguments of all rows (UTF8, not null terminated)
+    std::vector<quint64>    m_startTimes;           ///< per row: the CPU start time
+    std::vector<quint64>    m_endTimes;             ///< per row: the CPU end time
+    std::vector<qint32>     m_firstCallIndices;     ///< per row: the first call index shown in the index column
+    std::vector<qint32>     m_lastCallIndices;      ///< per row: the last call index shown in the index column
+    std::vector<acTimelineItem*> m_timelineItems;   ///< per row: the timeline item
+
+    QHash<quint32, acTimelineItem*> m_deviceBlocks;                 ///< the device blocks of the enqueue and dispatch rows
+    QHash<quint32, IOccupancyInfoDataHandler*> m_occupancyInfos;    ///< the occupancy infos of the dispatch rows
+};
+
+/// A node of the API Trace table tree: a row which has children, or the root. The rows without children have no item,
+/// the model serves their data directly from its TraceTableColumnStore
+class TraceTableItem
+{
+public:
+    /// Initializes a new instance of the TraceTableItem class
+    /// \param storeRow the column store row of the item, TraceTableColumnStore::INVALID_ROW for the root
+    explicit TraceTableItem(quint32 storeRow = TraceTableColumnStore::INVALID_ROW) : m_storeRow(storeRow) {}
+
+    /// Gets the index of this item's data in the column store
+    /// \return the column store row, TraceTableColumnStore::INVALID_ROW for the root item
+    quint32 GetStoreRow() const { return m_storeRow; }
+
+    /// Gets the number of children this node has
+    /// \return the number of children this node has
+    int GetChildCount() const { return static_cast<int>(m_childRows.size()); }
+
+    /// Reserves a count places of children:
+    void ReserveChildrenCount(int count) { m_childRows.reserve(count); }
+
+    /// Gets the column store row of the specified child
+    /// \param childIndex the index of the child requested
+    /// \return the column store row of the child
+    quint32 GetChildRow(int childIndex) const { return m_childRows[childIndex]; }
+
+    /// The column store rows of the children, in the table order
+    std::vector<quint32> m_childRows;
+
+private:
+    quint32 m_storeRow;                         ///< the column store row of this item
 };
 
 /// QAbstractItemModel descendant used for the API trace table in the TraceView
@@ -250,8 +332,8 @@ public:
     /// \param pTimelineItem the item's timeline item
     /// \param pDeviceBlock the device block for the api, can be NULL
     /// \param pOccupancyInfo the occupancy info for the api, can be NULL
-    /// \return the TraceTableItem instance added to the model
-    TraceTableItem* AddTraceItem(const QString& strAPIPrefix, const QString& strApiName, IAPIInfoDataHandler* pApiInfo, acTimelineItem* pTimelineItem, acTimelineItem* pDeviceBlock, IOccupancyInfoDataHandler* pOccupancyInfo);
+    /// \return the column store row of the item, TraceTableColumnStore::INVALID_ROW on failure
+    quint32 AddTraceItem(const QString& strAPIPrefix, const QString& strApiName, const gpTraceAPIRecord* pApiInfo, acTimelineItem* pTimelineItem, acTimelineItem* pDeviceBlock, IOccupancyInfoDataHandler* pOccupancyInfo);
 
     /// Adds a top level item to the trace items table:
     /// \param strAPIPrefix an API-specific prefix used to uniquely identify each trace item
@@ -260,29 +342,44 @@ public:
     /// \param pTimelineItem the item's timeline item
     /// \param pDeviceBlock the device block for the api, can be NULL
     /// \param pOccupancyInfo the occupancy info for the api, can be NULL
-    /// \return the TraceTableItem instance added to the model
-    TraceTableItem* AddTopLevelTraceItem(const QString& strAPIPrefix, const QString& strApiName, IAPIInfoDataHandler* pApiInfo, acTimelineItem* pTimelineItem, acTimelineItem* pDeviceBlock, IOccupancyInfoDataHandler* pOccupancyInfo);
+    /// \return the column store row of the item, TraceTableColumnStore::INVALID_ROW on failure
+    quint32 AddTopLevelTraceItem(const QString& strAPIPrefix, const QString& strApiName, const gpTraceAPIRecord* pApiInfo, acTimelineItem* pTimelineItem, acTimelineItem* pDeviceBlock, IOccupancyInfoDataHandler* pOccupancyInfo);
+
+    /// Inserts an API item without device work into an initialized model, in the order of its start time. The item is added
+    /// under the perf marker that contains it, if any
+    /// \param strAPIPrefix an API-specific prefix used to uniquely identify each trace item
+    /// \param strApiName the name of the api
+    /// \param pApiInfo struct containing info for the api
+    /// \param pTimelineItem the item's timeline item
+    /// \return the column store row of the item, TraceTableColumnStore::INVALID_ROW on failure
+    quint32 InsertTopLevelTraceItem(const QString& strAPIPrefix, const QString& strApiName, const gpTraceAPIRecord* pApiInfo, acTimelineItem* pTimelineItem);
 
     /// Adds a perf marker item to the maps of trace items (this map will later be added to the model, in InitializeModel)
     /// \param strAPIPrefix an API-specific prefix used to uniquely identify each trace item
     /// \param strMarkerName the name of the marker
     /// \param pMarkerEntry struct containing info for the marker
-    TraceTableItem* AddTraceItem(const QString& strAPIPrefix, const QString& strMarkerName, IPerfMarkerInfoDataHandler* pMarkerEntry);
+    /// \return the column store row of the item, TraceTableColumnStore::INVALID_ROW on failure
+    quint32 AddTraceItem(const QString& strAPIPrefix, const QString& strMarkerName, const gpTracePerfMarkerRecord* pMarkerEntry);
 
     /// Gets the device block data for the specified row
     /// \param index the index of the row
     /// \return the timeline item representing the device block
-    acTimelineItem* GetDeviceBlock(const QModelIndex& index);
+    acTimelineItem* GetDeviceBlock(const QModelIndex& index) const;
 
     /// Gets the occupancy data for the specified row
     /// \param index the index of the row
     /// \return the occupancy info
-    IOccupancyInfoDataHandler* GetOccupancyItem(const QModelIndex& index);
+    IOccupancyInfoDataHandler* GetOccupancyItem(const QModelIndex& index) const;
+
+    /// Gets the timeline item of the specified row
+    /// \param index the index of the row
+    /// \return the timeline item
+    acTimelineItem* GetTimelineItem(const QModelIndex& index) const;
 
     /// Closing the last opened perf marker item:
     /// \param pTimelineItem the timeline item that matches the requested perf marker item
-    /// \return the table item
-    TraceTableItem* CloseLastOpenedPerfMarker(acTimelineItem* pTimelineItem);
+    /// \return the column store row of the marker, TraceTableColumnStore::INVALID_ROW if no marker is opened
+    quint32 CloseLastOpenedPerfMarker(acTimelineItem* pTimelineItem);
 
     /// Initialize the model: construct the tree structure from the maps of API, HSA, and markers:
     /// \return true iff the initialization was successful
@@ -299,88 +396,164 @@ public:
     /// get the number of Api Calls Trace Items to be set
     int GetReservedApiCallsTraceItems() const {return m_reservedApiCallsTraceItems;}
 
-    /// Export the model data to a CSV file
-    /// \param outputFilePath the CSV output file path
-    /// \return true if the export succeeded
-    bool ExportToCSV(const QString& outputFilePath);
+    /// Gets the top level rows, in the table order
+    /// \param[out] storeRows the column store rows
+    void GetTopLevelRows(std::vector<quint32>& storeRows) const;
+
+    /// Gets the rows whose CPU time overlaps a time range, in the table order (parents before their children)
+    /// \param startTime the range start
+    /// \param endTime the range end
+    /// \param[out] storeRows the column store rows
+    void GetTimeRangeRows(quint64 startTime, quint64 endTime, std::vector<quint32>& storeRows) const;
 
     /// Return true when there is no API or perf markers in the table:
-    bool IsEmpty() const { return (m_apiCallsTraceItemsMap.empty() && m_perfMarkersTraceItemsMap.isEmpty()); }
+    bool IsEmpty() const { return (m_apiCallsTraceRows.empty() && m_perfMarkersTraceItemsMap.isEmpty()); }
+
+    /// Gets the column store holding the data of the table rows. Once the model is initialized, the store only changes
+    /// when InsertTopLevelTraceItem is called
+    /// \return the column store
+    const TraceTableColumnStore& GetColumnStore() const { return m_columnStore; }
+
+    /// Adds rows found by the find toolbar to the matched rows. Matched rows are highlighted, and in filter mode they are the only rows shown
+    /// \param storeRows the column store rows of the matched items, sorted, and following the rows already matched
+    void AddMatchedRows(const std::vector<quint32>& storeRows);
+
+    /// Clears the matched rows
+    void ClearMatchedRows();
+
+    /// Sets the filter mode. In filter mode, the table shows the matched items as a flat list
+    /// \param isFiltered true to show only the matched items
+    void SetFilterMode(bool isFiltered);
+
+    /// Gets the model index of an item
+    /// \param storeRow the column store row of the item
+    /// \return the model index of the item, an invalid index if the item is not shown
+    QModelIndex GetStoreRowIndex(quint32 storeRow) const;
+
+    /// Gets the column store row of a model index. The model indexes of this model hold their store row as internal id
+    /// \param index the model index
+    /// \return the column store row, TraceTableColumnStore::INVALID_ROW for an invalid index
+    static quint32 GetIndexStoreRow(const QModelIndex& index) { return index.isValid() ? static_cast<quint32>(index.internalId()) : TraceTableColumnStore::INVALID_ROW; }
 
     ///types and definitions
 private:
     /// Maps containing the perf markers trace items:
     using TimeRange = QPair<quint64, quint64>;
-    using ApiCallsTraceMapItr = std::map<quint64, TraceTableItem*>::iterator;
-    using PerfMarkersMapItr = QMap<TimeRange, TraceTableItem*>::iterator;
 
     ///Methods
 private:
 
-    /// This method :
-    /// 1. calculates next TraceTableItem to be connected with its parent during table initialization
-    /// 2. advances input api and markers  iterators
-    /// \param markersIter inout marker iterator, advanced each time this method called unless it reaches end
-    /// \param markersIterEnd marker end iterator
-    /// \param apiIter inout api iterator, advanced each time this method called unless it reaches end
-    /// \param apiIterEnd api end iterator
-    /// \return TraceTableItem* pointer to next TraceTableItem that shall be connected to it's parent  root or  marker
-    TraceTableItem* CalculateNextTraceTableItem(PerfMarkersMapItr& markersIter, const PerfMarkersMapItr& markersIterEnd,
-                                                ApiCallsTraceMapItr& apiIter, const ApiCallsTraceMapItr& apiIterEnd, TraceTableItemType& itemType) const;
-
-
-    /// This method returns items parent , by default it's a root item,unless time overlapping marker item is found
-    /// \param pNextItemToAdd item for which parent needs to be found
-    /// \return TraceTableItem* pointer to parent for a given item
-    TraceTableItem* GetNextItemParent(const TraceTableItem* pNextItemToAdd, const TraceTableItemType& itemType) const;
+    /// This method returns the parent row of an item, by default it's the root ,unless time overlapping marker item is found
+    /// \param nextRowToAdd the store row of the item for which parent needs to be found
+    /// \param itemType the type of the item
+    /// \return the store row of the parent, TraceTableColumnStore::INVALID_ROW for the root
+    quint32 GetNextItemParent(quint32 nextRowToAdd, TraceTableItemType itemType) const;
+
+    /// Creates a new API row in the column store, and sets its CPU times
+    /// \return the store row of the new item
+    quint32 CreateAPIItem(const QString& strAPIPrefix, const QString& strApiName, const gpTraceAPIRecord* pApiInfo, acTimelineItem* pTimelineItem, acTimelineItem* pDeviceBlock, IOccupancyInfoDataHandler* pOccupancyInfo);
+
+    /// Adds the tree columns of a new store row
+    /// \param storeRow the new store row
+    void AddTreeRow(quint32 storeRow);
+
+    /// Gets the item holding the children of a row
+    /// \param parentRow the store row, TraceTableColumnStore::INVALID_ROW for the root
+    /// \return the item, nullptr if the row has no children. The item may move when another row gets its first child
+    const TraceTableItem* GetParentItem(quint32 parentRow) const;
+
+    /// Gets the item holding the children of a row, and creates it if the row has no children yet
+    /// \param parentRow the store row, TraceTableColumnStore::INVALID_ROW for the root
+    /// \return the item. The item may move when another row gets its first child
+    TraceTableItem* GetOrCreateParentItem(quint32 parentRow);
+
+    /// Inserts a row into the children of a parent row. The row should not have a parent yet
+    /// \param parentRow the store row of the parent, TraceTableColumnStore::INVALID_ROW for the root
+    /// \param index the index at which to insert the child, -1 to append it
+    /// \param childRow the store row of the child
+    void InsertChild(quint32 parentRow, int index, quint32 childRow);
+
+    /// Update the start & end call indices of a parent row, and of its ancestors, with the call indices of a child:
+    /// \param parentRow the store row of the parent
+    /// \param childStartIndex the child first call index
+    /// \param childEndIndex the child last call index
+    void UpdateIndices(quint32 parentRow, int childStartIndex, int childEndIndex);
+
+    /// Checks if the CPU time of a row overlaps a time range
+    /// \param storeRow the store row
+    /// \param startTime the range start
+    /// \param endTime the range end
+    /// \return true iff the row CPU time overlaps the range
+    bool IsInTimeRange(quint32 storeRow, quint64 startTime, quint64 endTime) const;
+
+    /// Inserts a top level API row to the API rows sorted by end time
+    /// \param storeRow the row to insert
+    void InsertToAPICallsTraceRows(quint32 storeRow);
+
+    /// Gets the first API row whose end time is not less than the specified time
+    /// \param endTime the end time to look for
+    /// \return the iterator of the first API row whose end time is not less than endTime
+    std::vector<quint32>::iterator APICallsTraceRowsLowerBound(quint64 endTime);
 
 private:
 
     QStringList                m_headerData;             ///< the header data for this model
-    TraceTableItem*            m_pRootItem;              ///< the root item of the trace table (tree)
     QColor                     m_defaultForegroundColor; ///< the default foreground (font) color for this model
     QColor                     m_linkColor;              ///< the link color for this model
     QFont                      m_font;                   ///< the font used for this model
     QFont                      m_underlineFont;          ///< the underlined font used for this model
 
-    QStack<TraceTableItem*> m_openedPerfMarkerItemsStack;
+    /// The store rows of the perf markers which are not closed yet
+    QStack<quint32> m_openedPerfMarkerRowsStack;
 
-    /// Maps containing the API call trace items:
-    std::map<quint64, TraceTableItem*> m_apiCallsTraceItemsMap;
+    /// The column store holding the data of all the table rows
+    TraceTableColumnStore m_columnStore;
 
-    /// number of reserved items for m_apiCallsTraceItemsMap -
-    int m_reservedApiCallsTraceItems;
+    /// The root of the tree, holding the top level rows
+    TraceTableItem m_rootItem;
 
-    /// Maps containing the perf markers trace items:
-    QMap<TimeRange, TraceTableItem*> m_perfMarkersTraceItemsMap;
+    /// A map from the store row of a row which has children to its item. Most rows have no children, and no item
+    QHash<quint32, TraceTableItem> m_parentItems;
 
+    /// Per column store row: the store row of its parent, TraceTableColumnStore::INVALID_ROW for the top level rows
+    std::vector<quint32> m_parentRows;
 
-    /// holds all markers sorted by their time range intervals
-    boost::icl::split_interval_map<quint64, TraceTableItem*, boost::icl::partial_absorber, std::less, boost::icl::inplace_max> m_markerIntervals;
+    /// Per column store row: the index of the row within its parent, -1 if the row is not in the tree yet
+    std::vector<int> m_rowsInParent;
 
-    /// structure for holding marker information
-    struct Marker
-    {
-        /// pointer to the marker
-        TraceTableItem* m_pPerfMarkerItem;
+    /// The top level API call trace rows, sorted by their end time (searched with a binary search)
+    std::vector<quint32> m_apiCallsTraceRows;
+
+    /// number of reserved items for m_apiCallsTraceRows -
+    int m_reservedApiCallsTraceItems;
 
-        /// pointer to the parent of the marker
-        TraceTableItem* m_pParentMarker;
+    /// Maps containing the perf markers trace items:
+    QMap<TimeRange, quint32> m_perfMarkersTraceItemsMap;
 
-        /// Constructor
-        Marker() : m_pPerfMarkerItem(nullptr),
-            m_pParentMarker(nullptr)
-        {}
-    };
+    /// holds all markers sorted by their time range intervals. The value is the marker store row + 1, since 0 is absorbed
+    /// as the identity value, and the innermost (last opened) marker wins where markers overlap
+    boost::icl::split_interval_map<quint64, quint32, boost::icl::partial_absorber, std::less, boost::icl::inplace_max> m_markerIntervals;
 
-    /// list of the perf markers
-    std::vector<Marker> m_perfmarkerList;
+    /// A map from the store row of a closed perf marker to the store row of the marker that was opened when it was closed
+    QHash<quint32, quint32> m_perfMarkerParentRows;
 
     /// Was the model initialized already?
     bool m_isInitialized;
 
     /// Does the root item has grandchildren?
     bool m_shouldExpandBeEnabled;
+
+    /// Per column store row: true iff the row was matched by the find toolbar
+    std::vector<bool> m_isRowMatched;
+
+    /// The store rows of the matched items, sorted. In filter mode these are the root children
+    std::vector<quint32> m_matchedRows;
+
+    /// Is the table showing only the matched items?
+    bool m_isFiltered;
+
+    /// The background color of the matched items
+    QColor m_matchColor;
 };
 
 /// QTreeView descendant that hosts an API Trace table
@@ -415,10 +588,13 @@ public:
     /// \returns the number of selected rows
     int NumOfSelectedRows() const;
 
-    /// Export the table table content into a CSV file
-    /// \param outputFilePath the CSV output file path
-    /// \return true if the export succeeded
-    bool ExportToCSV(const QString& outputFilePath);
+    /// Gets the rows shown in the table, in the display order: the expanded rows, or the matched rows in filter mode
+    /// \param[out] storeRows the column store rows
+    void GetVisibleRows(std::vector<quint32>& storeRows) const;
+
+    /// Gets the columns shown in the table, in the display order
+    /// \param[out] columns the columns (TraceTableModel::TraceTableColIndex)
+    void GetVisibleColumns(std::vector<int>& columns) const;
 
     /// Set the list of columns that should be hidden:
     /// \param the list of hidden columns
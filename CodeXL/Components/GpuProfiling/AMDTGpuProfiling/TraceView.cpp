@@ -26,7 +26,6 @@
 #include <AMDTOSWrappers/Include/osThread.h>
 #include <AMDTApplicationComponents/Include/Timeline/acTimeline.h>
 
-#include "AtpUtils.h"
 #include <HSAFunctionDefs.h>
 
 // AMDTApplicationFramework:
@@ -57,6 +56,8 @@
 #include <AMDTGpuProfiling/ProfileManager.h>
 #include <AMDTGpuProfiling/SessionViewTabWidget.h>
 #include <AMDTGpuProfiling/gpViewsCreator.h>
+#include <AMDTGpuProfiling/gpTraceLoader.h>
+#include <AMDTGpuProfiling/gpTraceComparisonView.h>
 #include <iostream>
 #include <Version.h>
 #include <ProfilerOutputFileDefs.h>
@@ -65,15 +66,77 @@
 static QList<TraceTableModel::TraceTableColIndex> s_hsaHiddenColumns = { TraceTableModel::TRACE_DEVICE_BLOCK_COLUMN, TraceTableModel::TRACE_OCCUPANCY_COLUMN, TraceTableModel::TRACE_DEVICE_TIME_COLUMN };
 
 static const unsigned int s_UI_REFRESH_RATE = 1000;
+
+// Only the first 200K records are loaded in full detail. Past this limit, API calls without device work are aggregated on the timeline,
+// which bounds the memory of the view (on windows, we are limited with a 2GB memory size):
 static const unsigned int s_MAX_TRACE_ENTRIES = 200000;
+
+/// The interval (in milliseconds) in which the records published by the trace loader are handled
+static const int s_LOAD_POLL_INTERVAL_MS = 10;
+
+/// The time (in milliseconds) the records published by the trace loader are handled for, before the event loop is resumed
+static const qint64 s_LOAD_TIME_SLICE_MS = 50;
+
+/// The duration (in nanoseconds) of the time buckets the aggregated API calls are grouped by
+static const quint64 s_AGGREGATE_BUCKET_DURATION = 1000000;
+
 static const int PROGRESS_STAGES = 6;
 
+/// The interval (in milliseconds) in which the matches of a running find query are added to the view
+static const int s_FIND_RESULTS_POLL_INTERVAL_MS = 50;
+
+/// The maximal number of matches highlighted in the timeline. All the matches are highlighted in the trace tables
+static const size_t s_MAX_HIGHLIGHTED_TIMELINE_ITEMS = 100000;
+
+/// The background color of the find matches in the timeline
+static const QColor s_FIND_MATCH_TIMELINE_COLOR(255, 200, 0);
+
+/// The interval (in milliseconds) in which the progress of a running CSV export is updated
+static const int s_EXPORT_TO_CSV_POLL_INTERVAL_MS = 100;
+
+/// Gets the display name of an OpenCL API
+static QString GetCLAPIName(const gpTraceCLAPIRecord& clApiRecord)
+{
+    QString retVal;
+
+    if (clApiRecord.m_apiId < CL_FUNC_TYPE_Unknown)
+    {
+        retVal = CLAPIDefs::Instance()->GetOpenCLAPIString(CL_FUNC_TYPE(clApiRecord.m_apiId));
+    }
+    else
+    {
+        retVal = QString::fromStdString(clApiRecord.m_api.m_apiName);
+    }
+
+    return retVal;
+}
+
+/// Checks whether a record is an API call that may be aggregated, i.e. an API call without device work.
+/// Enqueue APIs, HSA memory APIs, dispatches and perf markers are always loaded in full detail
+static bool IsAggregatableAPIRecord(const gpTraceIndexRecord& record)
+{
+    bool retVal = false;
+
+    if (GP_TRACE_INDEX_RECORD_CL_API == record.m_type)
+    {
+        CLAPIType apiType = static_cast<CLAPIType>(record.m_clApi.m_apiType);
+        retVal = ((apiType & CL_ENQUEUE_BASE_API) != CL_ENQUEUE_BASE_API);
+    }
+    else if (GP_TRACE_INDEX_RECORD_HSA_API == record.m_type)
+    {
+        retVal = record.m_hsaApi.m_isApi && !record.m_hsaApi.m_hasMemoryInfo;
+    }
+
+    return retVal;
+}
+
 TraceView::TraceView(QWidget* parent) : gpBaseSessionView(parent),
     m_pCurrentSession(nullptr),
     m_pMainSplitter(nullptr),
     m_pTimeline(nullptr),
     m_pTraceTabView(nullptr),
     m_pSummaryView(nullptr),
+    m_pFindToolBar(nullptr),
     m_pSymbolInfo(nullptr),
     m_pSummarizer(nullptr),
     m_pOpenCLBranch(nullptr),
@@ -85,11 +148,20 @@ TraceView::TraceView(QWidget* parent) : gpBaseSessionView(parent),
     m_lastDeviceItemIdx(-1)
 #endif
     , m_areTimelinePropertiesSet(false),
-    m_parseCallsCounter(0),
-    m_alreadyDisplayedAPILimitMessage(false),
-    m_shouldStopParsing(false),
-    m_maxTimestampWhenParsingStopped(0),
-    m_isProgressRangeSet(false)
+    m_detailedRecordsCount(0),
+    m_pTraceLoader(nullptr),
+    m_pLoadTimer(nullptr),
+    m_loadStage(LOAD_STAGE_NONE),
+    m_loadSessionInnerPage(AF_TREE_ITEM_ITEM_NONE),
+    m_isProgressRangeSet(false),
+    m_pFindResultsTimer(nullptr),
+    m_currentFindMatch(-1),
+    m_findSearchTimeMs(0),
+    m_findSearchState(gpTraceSearch::SEARCH_STATE_IDLE),
+    m_pExportToCSVTimer(nullptr),
+    m_isTimeRangeSelected(false),
+    m_selectedRangeStartTime(0),
+    m_selectedRangeEndTime(0)
 {
     BuildWindowLayout();
 
@@ -107,6 +179,12 @@ TraceView::TraceView(QWidget* parent) : gpBaseSessionView(parent),
     m_pTraceTableContextMenu->addSeparator();
 
     m_pExportToCSVAction = m_pTraceTableContextMenu->addAction(AF_STR_ExportToCSV, this, SLOT(OnExportToCSV()));
+    m_pExportVisibleRowsToCSVAction = m_pTraceTableContextMenu->addAction(GPU_STR_TraceViewExportVisibleRowsToCSV, this, SLOT(OnExportVisibleRowsToCSV()));
+    m_pExportTimeRangeToCSVAction = m_pTraceTableContextMenu->addAction(GPU_STR_TraceViewExportTimeRangeToCSV, this, SLOT(OnExportTimeRangeToCSV()));
+    m_pCancelExportToCSVAction = m_pTraceTableContextMenu->addAction(GPU_STR_TraceViewCancelExportToCSV, this, SLOT(OnCancelExportToCSV()));
+    m_pTraceTableContextMenu->addSeparator();
+
+    m_pCompareWithSessionAction = m_pTraceTableContextMenu->addAction(GPU_STR_TraceViewCompareWithSession, this, SLOT(OnCompareWithSession()));
 
 
     bool rc = connect(m_pTimeline, SIGNAL(itemClicked(acTimelineItem*)), this, SLOT(TimelineItemClickedHandler(acTimelineItem*)));
@@ -118,15 +196,54 @@ TraceView::TraceView(QWidget* parent) : gpBaseSessionView(parent),
     rc = connect(afApplicationCommands::instance()->applicationTree()->treeControl(), SIGNAL(itemChanged(QTreeWidgetItem*, int)), this, SLOT(OnApplicationTreeSelection()));
     GT_ASSERT(rc);
 
+    // Connect the find toolbar:
+    rc = connect(m_pFindToolBar, SIGNAL(FindQueryChanged()), this, SLOT(OnFindQueryChanged()));
+    GT_ASSERT(rc);
+
+    rc = connect(m_pFindToolBar, SIGNAL(FindNext()), this, SLOT(OnFindNext()));
+    GT_ASSERT(rc);
+
+    rc = connect(m_pFindToolBar, SIGNAL(FindPrevious()), this, SLOT(OnFindPrevious()));
+    GT_ASSERT(rc);
+
+    rc = connect(m_pFindToolBar, SIGNAL(FilterModeChanged(bool)), this, SLOT(OnFindFilterModeChanged(bool)));
+    GT_ASSERT(rc);
+
+    m_pFindResultsTimer = new QTimer(this);
+    m_pFindResultsTimer->setInterval(s_FIND_RESULTS_POLL_INTERVAL_MS);
+
+    rc = connect(m_pFindResultsTimer, SIGNAL(timeout()), this, SLOT(OnFindResultsTimer()));
+    GT_ASSERT(rc);
+
+    m_pExportToCSVTimer = new QTimer(this);
+    m_pExportToCSVTimer->setInterval(s_EXPORT_TO_CSV_POLL_INTERVAL_MS);
+
+    rc = connect(m_pExportToCSVTimer, SIGNAL(timeout()), this, SLOT(OnExportToCSVTimer()));
+    GT_ASSERT(rc);
+
+    m_pLoadTimer = new QTimer(this);
+    m_pLoadTimer->setInterval(s_LOAD_POLL_INTERVAL_MS);
+
+    rc = connect(m_pLoadTimer, SIGNAL(timeout()), this, SLOT(OnLoadTimer()));
+    GT_ASSERT(rc);
 }
 
 TraceView::~TraceView()
 {
+    // Stop the loader, search and export threads before the trace tables are deleted:
+    if (m_loadStage != LOAD_STAGE_NONE)
+    {
+        CancelLoading();
+        afProgressBarWrapper::instance().hideProgressBar();
+    }
+
+    m_traceSearch.Reset();
+    CancelExportToCSV();
+
     SAFE_DELETE(m_pSummarizer);
 
     // Remove me from the list of session windows in the session view creator:
     gpViewsCreator::Instance()->OnWindowClose(this);
-    AtpUtils::Instance()->RemoveHandlerFromCallBackHandlerList(this);
 }
 
 
@@ -144,9 +261,6 @@ bool TraceView::DisplaySession(const osFilePath& sessionFilePath, afTreeItemType
         m_sessionFilePath = sessionFilePath;
 
         m_pCurrentSession = nullptr;
-        m_alreadyDisplayedAPILimitMessage = false;
-        m_shouldStopParsing = false;
-        m_maxTimestampWhenParsingStopped = 0;
         m_pCurrentSession = qobject_cast <TraceSession*> (m_pSessionData);
 
 
@@ -173,44 +287,30 @@ bool TraceView::DisplaySession(const osFilePath& sessionFilePath, afTreeItemType
                 }
                 else
                 {
-                    LoadSessionUsingBackendParser(m_pCurrentSession->m_pParentData->m_filePath);
-
-                    // if we didn't load symbol info from .atp file, try loading it from .st file
-                    if (m_symbolTableMap.isEmpty())
-                    {
-                        osFilePath stFilePath = m_pCurrentSession->m_pParentData->m_filePath;
-                        stFilePath.setFileExtension(L"st");
-
-                        if (stFilePath.exists())
-                        {
-                            LoadSessionUsingBackendParser(stFilePath);
-                        }
-                    }
-
-                    // if we didn't load CL perfmarker info from .atp file, try loading it from .clperfmarker file
-                    if (!m_perfMarkersAdded)
-                    {
-                        osFilePath perfMarkerFilePath = m_pCurrentSession->m_pParentData->m_filePath;
-                        perfMarkerFilePath.setFileExtension(L"clperfmarker");
-
-                        if (perfMarkerFilePath.exists())
-                        {
-                            LoadSessionUsingBackendParser(perfMarkerFilePath);
-                        }
-                    }
-
-                    DoneParsingATPFile();
-
-                    // Load the summary view
-                    LoadSummary(sessionInnerPage);
-
-                    afProgressBarWrapper::instance().hideProgressBar();
-
+                    // The trace files are loaded on background threads, and their records are handled from the event loop.
+                    // The requested page is shown once the session is loaded:
+                    m_loadSessionInnerPage = sessionInnerPage;
+                    CancelLoading();
+                    LoadNextTraceFile();
                 }
             }
         }
     }
 
+    if (m_loadStage != LOAD_STAGE_NONE)
+    {
+        m_loadSessionInnerPage = sessionInnerPage;
+    }
+    else
+    {
+        ShowSessionInnerPage(sessionInnerPage);
+    }
+
+    return retVal;
+}
+
+void TraceView::ShowSessionInnerPage(afTreeItemType sessionInnerPage)
+{
     if ((m_pSummaryView != nullptr) && (m_pTraceTabView != nullptr) && (m_pSessionTabWidget != nullptr))
     {
         m_pSummaryView->DisplaySummaryPageType(sessionInnerPage);
@@ -235,8 +335,6 @@ bool TraceView::DisplaySession(const osFilePath& sessionFilePath, afTreeItemType
         // Set the timeline as the current index
         m_pSessionTabWidget->setCurrentIndex(0);
     }
-
-    return retVal;
 }
 
 void TraceView::LoadSummary(afTreeItemType summaryItemType)
@@ -246,9 +344,10 @@ void TraceView::LoadSummary(afTreeItemType summaryItemType)
         m_pSummarizer = new CLSummarizer(m_pCurrentSession);
     }
 
+    // The summary pages written by the backend are only registered as session files. The summary is computed from the trace records:
     m_pSummarizer->CreateSummaryPages();
 
-    if (m_pTraceTabView != nullptr && m_pSummarizer->GetSummaryPagesMap().count() != 0)
+    if (m_pTraceTabView != nullptr && !m_traceSummarizer.IsEmpty())
     {
         if (m_pSummaryView == nullptr)
         {
@@ -258,7 +357,7 @@ void TraceView::LoadSummary(afTreeItemType summaryItemType)
                     this, SLOT(SummaryPageLinkClickedHandler(const QString&, unsigned int, unsigned int, AnalyzerHTMLViewType)));
         }
 
-        GT_IF_WITH_ASSERT(m_pSummaryView->LoadSession(m_pCurrentSession, m_pSummarizer))
+        GT_IF_WITH_ASSERT(m_pSummaryView->LoadSession(m_pCurrentSession, &m_traceSummarizer))
         {
             int indexOfSummary = m_pTraceTabView->addTab(m_pSummaryView, GPU_STR_TraceViewSummary);
             m_pTraceTabView->setCurrentIndex(indexOfSummary);
@@ -318,6 +417,23 @@ void TraceView::AddTraceTable(TraceTableModel* pModel, unsigned int threadId)
 
 void TraceView::Clear()
 {
+    // The records of a running load are discarded:
+    CancelLoading();
+
+    // Stop the search thread before the trace tables are cleared. The highlighted timeline items are deleted with the timeline:
+    m_traceSearch.Reset();
+    m_pFindResultsTimer->stop();
+    m_findTables.clear();
+    m_findMatches.clear();
+    m_highlightedTimelineItems.clear();
+    m_currentFindMatch = -1;
+    m_findSearchState = gpTraceSearch::SEARCH_STATE_IDLE;
+    UpdateFindStatus();
+
+    // The exported items are deleted with the trace tables:
+    CancelExportToCSV();
+    m_isTimeRangeSelected = false;
+
     m_pTimeline->reset();
 
     if (m_pSummaryView != nullptr)
@@ -326,6 +442,7 @@ void TraceView::Clear()
     }
 
     SAFE_DELETE(m_pSummarizer);
+    m_traceSummarizer.Clear();
     m_pTraceTabView->clear();
 
     if (m_pCurrentSession != nullptr)
@@ -356,6 +473,11 @@ void TraceView::Clear()
     m_titleStack.clear();
     m_branchStack.clear();
     m_perfMarkersAdded = false;
+    m_detailedRecordsCount = 0;
+
+    // Aggregate items that were not added to the timeline are not owned by it:
+    qDeleteAll(m_aggregateItemsMap);
+    m_aggregateItemsMap.clear();
 #ifdef SHOW_KERNEL_LAUNCH_AND_COMPLETION_LATENCY
     m_lastDeviceItem = nullptr;
     m_lastDeviceItemIdx = -1;
@@ -386,15 +508,15 @@ bool TraceView::SessionHasSymbolInformation()
 
 void TraceView::TraceTableMouseClickedHandler(const QModelIndex& modelIndex)
 {
-    TraceTableItem* item = static_cast<TraceTableItem*>(modelIndex.internalPointer());
+    const TraceTableModel* pModel = qobject_cast<const TraceTableModel*>(modelIndex.model());
     QTreeView* table = dynamic_cast<QTreeView*>(sender());
 
-    if (table != nullptr)
+    if ((table != nullptr) && (pModel != nullptr))
     {
         if (modelIndex.column() == TraceTableModel::TRACE_OCCUPANCY_COLUMN)
         {
 
-            IOccupancyInfoDataHandler* occInfo = item->GetOccupancyInfo();
+            IOccupancyInfoDataHandler* occInfo = pModel->GetOccupancyItem(modelIndex);
 
             if (occInfo != nullptr)
             {
@@ -402,7 +524,7 @@ void TraceView::TraceTableMouseClickedHandler(const QModelIndex& modelIndex)
 
                 // get the api index from the Index column (column 0)
                 QString strCallIndex;
-                strCallIndex = item->GetColumnData(TraceTableModel::TRACE_INDEX_COLUMN).toString();
+                strCallIndex = pModel->GetColumnStore().GetColumnData(TraceTableModel::GetIndexStoreRow(modelIndex), TraceTableModel::TRACE_INDEX_COLUMN).toString();
 
                 bool ok;
                 int callIndex = strCallIndex.toInt(&ok);
@@ -426,7 +548,7 @@ void TraceView::TraceTableMouseClickedHandler(const QModelIndex& modelIndex)
         }
         else if (modelIndex.column() == TraceTableModel::TRACE_DEVICE_BLOCK_COLUMN)
         {
-            acTimelineItem* deviceBlockItem = item->GetDeviceBlock();
+            acTimelineItem* deviceBlockItem = pModel->GetDeviceBlock(modelIndex);
 
             if (deviceBlockItem != nullptr)
             {
@@ -440,28 +562,28 @@ void TraceView::TraceTableMouseClickedHandler(const QModelIndex& modelIndex)
 void TraceView::TraceTableMouseDoubleClickedHandler(const QModelIndex& modelIndex)
 {
     // Get the activated item:
-    TraceTableItem* pItem = static_cast<TraceTableItem*>(modelIndex.internalPointer());
-    GT_IF_WITH_ASSERT(pItem != nullptr)
+    const TraceTableModel* pModel = qobject_cast<const TraceTableModel*>(modelIndex.model());
+    GT_IF_WITH_ASSERT((pModel != nullptr) && modelIndex.isValid())
     {
         // Zoom the timeline into the double-clicked item:
-        m_pTimeline->ZoomToItem(pItem->GetTimelineItem(), true);
+        m_pTimeline->ZoomToItem(pModel->GetTimelineItem(modelIndex), true);
 
         // Display the item properties:
-        DisplayItemInPropertiesView(pItem->GetTimelineItem());
+        DisplayItemInPropertiesView(pModel->GetTimelineItem(modelIndex));
     }
 
 }
 
 void TraceView::TraceTableMouseEnteredHandler(const QModelIndex& modelIndex)
 {
-    TraceTableItem* item = static_cast<TraceTableItem*>(modelIndex.internalPointer());
+    const TraceTableModel* pModel = qobject_cast<const TraceTableModel*>(modelIndex.model());
     // change the mouse cursor to the hand cursor when hovering over a device block item or a kernel occupancy item
     QTreeView* table = dynamic_cast<QTreeView*>(sender());
 
-    if (table != nullptr)
+    if ((table != nullptr) && (pModel != nullptr))
     {
-        IOccupancyInfoDataHandler* occInfo = item->GetOccupancyInfo();
-        acTimelineItem* deviceBlockItem = item->GetDeviceBlock();
+        IOccupancyInfoDataHandler* occInfo = pModel->GetOccupancyItem(modelIndex);
+        acTimelineItem* deviceBlockItem = pModel->GetDeviceBlock(modelIndex);
 
         if ((occInfo != nullptr && modelIndex.column() == TraceTableModel::TRACE_OCCUPANCY_COLUMN) || (deviceBlockItem != nullptr && modelIndex.column() == TraceTableModel::TRACE_DEVICE_BLOCK_COLUMN))
         {
@@ -483,10 +605,29 @@ void TraceView::TimelineItemClickedHandler(acTimelineItem* pItem)
         DisplayItemInPropertiesView(pItem);
         m_areTimelinePropertiesSet = true;
 
+        // The summary, and the exported rows, can be restricted to the time range of the clicked item:
+        m_isTimeRangeSelected = true;
+        m_selectedRangeStartTime = pItem->startTime();
+        m_selectedRangeEndTime = pItem->endTime();
+
+        if (m_pSummaryView != nullptr)
+        {
+            m_pSummaryView->SetSelectedRange(pItem->startTime(), pItem->endTime());
+        }
+
+        // Clicking an aggregate item loads its API calls in full detail:
+        APIAggregateTimelineItem* pAggregateItem = dynamic_cast<APIAggregateTimelineItem*>(pItem);
+
+        if (pAggregateItem != nullptr)
+        {
+            ExpandAggregateTimelineItem(pAggregateItem);
+        }
+
         // first get the correct pItem (if user clicks a timeline pItem for a device)
         HostAPITimelineItem* hostApiItem = dynamic_cast<HostAPITimelineItem*>(pItem);
         PerfMarkerTimelineItem* pPerfItem = dynamic_cast<PerfMarkerTimelineItem*>(pItem);
-        TraceTableItem* pTableItem = nullptr;
+        TraceTableModel* pTableModel = nullptr;
+        quint32 tableRow = TraceTableColumnStore::INVALID_ROW;
 
         if (hostApiItem != nullptr)
         {
@@ -498,12 +639,14 @@ void TraceView::TimelineItemClickedHandler(acTimelineItem* pItem)
 
         if (apiItem != nullptr)
         {
-            pTableItem = apiItem->traceTableItem();
+            pTableModel = apiItem->traceTableModel();
+            tableRow = apiItem->traceTableRow();
         }
 
         if (pPerfItem != nullptr)
         {
-            pTableItem = pPerfItem->traceTableItem();
+            pTableModel = pPerfItem->traceTableModel();
+            tableRow = pPerfItem->traceTableRow();
         }
 
         if (pItem && pItem->parentBranch() != nullptr)
@@ -525,11 +668,15 @@ void TraceView::TimelineItemClickedHandler(acTimelineItem* pItem)
                 treeview = dynamic_cast<QTreeView*>(m_pTraceTabView->currentWidget());
             }
 
-            if (treeview != nullptr && pTableItem != nullptr)
+            if (treeview != nullptr && pTableModel != nullptr && treeview->model() == pTableModel)
             {
                 // select the api that corresponds to the timeline pItem clicked
-                QModelIndexList selectionList = treeview->model()->match(treeview->model()->index(0, 0), Qt::UserRole, pTableItem->GetUniqueId(), 1, Qt::MatchExactly | Qt::MatchRecursive);
-                treeview->setCurrentIndex(selectionList.first());
+                QModelIndex tableIndex = pTableModel->GetStoreRowIndex(tableRow);
+
+                if (tableIndex.isValid())
+                {
+                    treeview->setCurrentIndex(tableIndex);
+                }
             }
         }
     }
@@ -769,6 +916,13 @@ void TraceView::TraceTableContextMenuHandler(const QPoint& pt)
         m_pZoomInTimelineAction->setEnabled(isCopyEnabled && !isMultiRowSelection);
         m_pCopyAction->setEnabled(isCopyEnabled);
         m_pSelectAllAction->setEnabled(isSelectAllEnabled);
+
+        // A single CSV export runs at a time:
+        bool isExporting = m_csvExporter.IsRunning();
+        m_pExportToCSVAction->setEnabled(!isExporting);
+        m_pExportVisibleRowsToCSVAction->setEnabled(!isExporting);
+        m_pExportTimeRangeToCSVAction->setEnabled(!isExporting && m_isTimeRangeSelected);
+        m_pCancelExportToCSVAction->setVisible(isExporting);
         m_pTraceTableContextMenu->exec(acMapToGlobal(table, pt));
     }
 }
@@ -846,47 +1000,6 @@ void TraceView::SetAPINum(osThreadId threadId, unsigned int apiNum)
     }
 }
 
-bool TraceView::CheckStopParsing(quint64 curEndTime)
-{
-    bool stopParsing = false;
-
-    // On windows, we are limited with a 2GB memory size, so we limit the API calls load to 200K.
-    // On linux this limitation is not relevant, so we do not stop parse:
-#if AMDT_BUILD_TARGET == AMDT_WINDOWS_OS
-    stopParsing = m_parseCallsCounter >= s_MAX_TRACE_ENTRIES;
-
-    if (stopParsing)
-    {
-        // CODEXL-3550: If the API limit was reached, continue to parse additional items (HSA kernel timestamps, perf markers, etc.), up to the point (in time) where api parsing stopped.
-        // This ensures that the partial timeline shown will at least be complete (in the sense that all items in the given timespan will be shown):
-        stopParsing = ((0 == m_maxTimestampWhenParsingStopped || curEndTime != std::numeric_limits<quint64>::max()) && curEndTime > m_maxTimestampWhenParsingStopped);
-    }
-
-    if (stopParsing && !m_alreadyDisplayedAPILimitMessage)
-    {
-        // We ask the user if they want to continue loading the data at their own risk:
-        QString userMessage = QString(GPU_STR_APICallsAmountExceedsTheLimitQuestion).arg(s_MAX_TRACE_ENTRIES);
-        int userAnswer = acMessageBox::instance().question(afGlobalVariablesManager::ProductNameA(), userMessage, QMessageBox::No | QMessageBox::Yes);
-        m_shouldStopParsing = stopParsing = (userAnswer == QMessageBox::Yes);
-
-        m_alreadyDisplayedAPILimitMessage = true;
-
-        if (m_shouldStopParsing)
-        {
-            m_maxTimestampWhenParsingStopped = curEndTime;
-        }
-    }
-    else if (stopParsing && m_alreadyDisplayedAPILimitMessage)
-    {
-        stopParsing = m_shouldStopParsing;
-    }
-#else
-    (void)(curEndTime); // unused
-#endif
-
-    return stopParsing;
-}
-
 acTimelineBranch* TraceView::AddHSADataTransferBranch(QString srcHandle, QString srcName, QString destHandle, QString destName)
 {
     acTimelineBranch* returnBranch = GetHSADataTransferBranch(srcHandle, destHandle);
@@ -931,88 +1044,173 @@ acTimelineBranch* TraceView::GetHSADataTransferBranch(QString src, QString dest)
     return returnBranch;
 }
 
-void TraceView::OnParseCallHandler(AtpInfoType apiType, bool& stopParsing)
+void TraceView::HandleTraceIndexRecord(const gpTraceIndexRecord& record)
 {
-    m_parseCallsCounter++;
-    void* pPtr;
-
-    if (!AtpUtils::Instance()->IsModuleLoaded())
-    {
-        AtpUtils::Instance()->LoadModule();
-    }
+    // All the records are summarized, including the API calls which are only aggregated in the timeline:
+    m_traceSummarizer.AddRecord(record);
 
-    AtpDataHandlerFunc pAtpDataHandler_func = AtpUtils::Instance()->GetAtpDataHandlerFunc();
+    // Once the detail budget is used, the API calls without device work are only aggregated:
+    bool isAggregated = (m_detailedRecordsCount >= s_MAX_TRACE_ENTRIES) && IsAggregatableAPIRecord(record);
 
-    if (nullptr != pAtpDataHandler_func)
+    switch (record.m_type)
     {
-        pAtpDataHandler_func(&pPtr);
-        IAtpDataHandler* pAtpDataHandler = reinterpret_cast<IAtpDataHandler*>(pPtr);
+        case GP_TRACE_INDEX_RECORD_API_NUM:
+            SetAPINum(static_cast<osThreadId>(record.m_apiNumThreadId), record.m_apiNum);
+            break;
 
-        switch (apiType)
+        case GP_TRACE_INDEX_RECORD_CL_API:
         {
-            case OPENCL_INFO:
+            m_api = APIToTrace_OPENCL;
+
+            if (isAggregated)
             {
-                m_api = APIToTrace_OPENCL;
-                ICLAPIInfoDataHandler* clApiInfoHandler = pAtpDataHandler->GetCLApiInfoDataHandler();
-                stopParsing = CheckStopParsing(clApiInfoHandler->GetApiInfoDataHandler()->GetApiEndTime());
+                AddAggregatedAPICall(record);
+            }
+            else
+            {
+                HandleCLAPIInfo(record.m_clApi);
+                m_detailedRecordsCount++;
+            }
+        }
+        break;
 
-                if (!stopParsing)
-                {
-                    HandleCLAPIInfo(clApiInfoHandler);
-                }
+        case GP_TRACE_INDEX_RECORD_HSA_API:
+        {
+            m_api = APIToTrace_HSA;
+
+            if (isAggregated)
+            {
+                AddAggregatedAPICall(record);
+            }
+            else
+            {
+                HandleHSAAPIInfo(record.m_hsaApi);
+                m_detailedRecordsCount++;
             }
+        }
+        break;
+
+        case GP_TRACE_INDEX_RECORD_PERF_MARKER:
+            HandlePerfMarkerEntry(record.m_perfMarker);
+            m_detailedRecordsCount++;
             break;
 
-            case HSA_INFO:
-            {
-                m_api = APIToTrace_HSA;
-                IHSAAPIInfoDataHandler* hsaApiInfoHandler = pAtpDataHandler->GetHSAApiInfoDataHandler();
-                stopParsing = CheckStopParsing(hsaApiInfoHandler->GetApiInfoDataHandler()->GetApiEndTime());
+        case GP_TRACE_INDEX_RECORD_SYMBOL:
+            AGP_TODO("should check the module of pSymFileEntry and match it up to that module's APIs. This will be needed to properly support multi-module traces (i.e. traces that contain both HSA and OCL)")
 
-                if (!stopParsing)
-                {
-                    HandleHSAAPIInfo(hsaApiInfoHandler);
-                }
-            }
+            HandleSymFileEntry(record.m_symbol);
+            m_detailedRecordsCount++;
             break;
 
-            case PERF_MARKER_ENTRY:
-            {
-                IPerfMarkerInfoDataHandler* perMarkerApiInfoDataHandler = pAtpDataHandler->GetPerfMarkerInfoDataHandler();
-                stopParsing = CheckStopParsing(perMarkerApiInfoDataHandler->GetPerfMarkerTimestamp());
+        default:
+            break;
+    }
+}
+
+void TraceView::AddAggregatedAPICall(const gpTraceIndexRecord& record)
+{
+    bool isCLAPI = (GP_TRACE_INDEX_RECORD_CL_API == record.m_type);
+    const gpTraceAPIRecord& apiRecord = isCLAPI ? record.m_clApi.m_api : record.m_hsaApi.m_api;
+    QString apiName = isCLAPI ? GetCLAPIName(record.m_clApi) : QString::fromStdString(apiRecord.m_apiName);
+
+    acTimelineBranch* pHostBranch = GetHostBranchForAPI(static_cast<osThreadId>(apiRecord.m_threadId), isCLAPI ? GPU_STR_TraceViewOpenCL : GPU_STR_TraceViewHSA);
+    GT_IF_WITH_ASSERT(pHostBranch != nullptr)
+    {
+        QPair<acTimelineBranch*, quint64> bucketKey(pHostBranch, apiRecord.m_startTime / s_AGGREGATE_BUCKET_DURATION);
+        APIAggregateTimelineItem*& pAggregateItem = m_aggregateItemsMap[bucketKey];
+
+        if (pAggregateItem == nullptr)
+        {
+            pAggregateItem = new APIAggregateTimelineItem(apiRecord.m_startTime, apiRecord.m_endTime);
+            pAggregateItem->setBackgroundColor(QColor(90, 90, 90));
+            pAggregateItem->setForegroundColor(Qt::white);
+        }
+
+        pAggregateItem->addCall(apiName, apiRecord.m_startTime, apiRecord.m_endTime, record.m_indexOffset);
+    }
+}
+
+void TraceView::ExpandAggregateTimelineItem(APIAggregateTimelineItem* pAggregateItem)
+{
+    GT_IF_WITH_ASSERT((pAggregateItem != nullptr) && (m_pCurrentSession != nullptr) && (m_pCurrentSession->m_pParentData != nullptr))
+    {
+        if (!pAggregateItem->isExpanded())
+        {
+            // Only the .atp file has API calls, so the aggregated calls are all in its session index:
+            gpTraceSessionIndexReader indexReader;
+            QString traceFilePath = acGTStringToQString(m_pCurrentSession->m_pParentData->m_filePath.asString());
+            gpTraceIndexRecord record;
 
-                if (!stopParsing)
+            bool isIndexValid = (pAggregateItem->firstIndexOffset() >= 0) && indexReader.Open(traceFilePath) &&
+                                indexReader.SeekToRecord(pAggregateItem->firstIndexOffset()) && indexReader.ReadNext(record) && IsAggregatableAPIRecord(record);
+
+            if (!isIndexValid)
+            {
+                Util::ShowWarningBox(QString(GPU_STR_TraceViewAggregateIndexMissing).arg(traceFilePath));
+            }
+            else
+            {
+                // The first aggregated call sets the thread, API and bucket of the calls to load:
+                gpTraceIndexRecordType aggregatedType = record.m_type;
+                bool isCLAPI = (GP_TRACE_INDEX_RECORD_CL_API == aggregatedType);
+                const gpTraceAPIRecord& apiRecord = isCLAPI ? record.m_clApi.m_api : record.m_hsaApi.m_api;
+                quint64 threadId = apiRecord.m_threadId;
+                quint64 bucket = apiRecord.m_startTime / s_AGGREGATE_BUCKET_DURATION;
+
+                // The search and export threads read the trace tables, so they are stopped while the calls are inserted:
+                m_traceSearch.Reset();
+                m_pFindResultsTimer->stop();
+                ClearFindMatches();
+                CancelExportToCSV();
+
+                // The calls are inserted to the trace table of their thread, if the thread has one:
+                TraceTableModel* pTableModel = nullptr;
+                int tabIndex = GetTabIndex(QString(GPU_STR_TraceViewHostThreadBranchName).arg(threadId));
+                TraceTable* pTraceTable = (tabIndex >= 0) ? qobject_cast<TraceTable*>(m_pTraceTabView->widget(tabIndex)) : nullptr;
+
+                if (pTraceTable != nullptr)
                 {
-                    HandlePerfMarkerEntry(perMarkerApiInfoDataHandler);
+                    pTableModel = qobject_cast<TraceTableModel*>(pTraceTable->model());
                 }
-            }
-            break;
 
-            case SYMBOL_ENTRY:
-            {
-                AGP_TODO("should check the module of pSymFileEntry and match it up to that module's APIs. This will be needed to properly support multi-module traces (i.e. traces that contain both HSA and OCL)")
-                ISymbolFileEntryInfoDataHandler* symbolFileEntryHandler = pAtpDataHandler->GetSymbolFileEntryInfoDataHandler();
-                stopParsing = CheckStopParsing(std::numeric_limits<quint64>::max());
+                std::vector<APIAggregateTimelineItem::DetailedCall> detailedCalls;
+                bool isReading = true;
 
-                if (!stopParsing)
+                while (isReading && (record.m_indexOffset <= pAggregateItem->lastIndexOffset()))
                 {
-                    HandleSymFileEntry(symbolFileEntryHandler);
+                    if ((record.m_type == aggregatedType) && IsAggregatableAPIRecord(record) &&
+                        (apiRecord.m_threadId == threadId) && ((apiRecord.m_startTime / s_AGGREGATE_BUCKET_DURATION) == bucket))
+                    {
+                        QString apiName = isCLAPI ? GetCLAPIName(record.m_clApi) : QString::fromStdString(apiRecord.m_apiName);
+
+                        APIAggregateTimelineItem::DetailedCall detailedCall;
+                        detailedCall.m_startTime = apiRecord.m_startTime;
+                        detailedCall.m_endTime = apiRecord.m_endTime;
+                        detailedCall.m_apiName = apiName;
+                        detailedCall.m_color = APIColorMap::Instance()->GetAPIColor(apiName, QColor(90, 90, 90));
+                        detailedCalls.push_back(detailedCall);
+
+                        // The timeline items of the host branch are in call order, so the call rows point at the aggregate item:
+                        if (pTableModel != nullptr)
+                        {
+                            pTableModel->InsertTopLevelTraceItem(isCLAPI ? GPU_STR_TraceViewOpenCL : GPU_STR_TraceViewHSA, apiName, &apiRecord, pAggregateItem);
+                        }
+                    }
+
+                    isReading = indexReader.ReadNext(record);
                 }
-            }
-            break;
 
-            default:
-                break;
+                pAggregateItem->setDetailedCalls(detailedCalls);
+                m_pTimeline->update();
+
+                // The inserted rows are indexed with the rest of the tables:
+                StartTraceSearchIndexing();
+            }
         }
     }
 }
 
-void TraceView::OnSetApiNumCallHandler(osThreadId threadId, unsigned int apiNum)
-{
-    this->SetAPINum(threadId, apiNum);
-}
-
-void TraceView::OnParserProgressCallHandler(const char* strProgressMessage, unsigned int uiCurItem, unsigned int uiTotalItems)
+void TraceView::ReportLoadProgress(const char* strProgressMessage, unsigned int uiCurItem, unsigned int uiTotalItems)
 {
     gtString localProgressMsg;
     afProgressBarWrapper& theProgressBarWrapper = afProgressBarWrapper::instance();
@@ -1085,33 +1283,149 @@ acTimelineBranch* TraceView::GetHostBranchForAPI(osThreadId threadId, const QStr
     return retVal;
 }
 
-bool TraceView::LoadSessionUsingBackendParser(const osFilePath& sessionFile)
+bool TraceView::StartLoadingTraceFile(const osFilePath& traceFilePath)
 {
     bool retVal = false;
 
-    if (!AtpUtils::Instance()->IsModuleLoaded())
+    // The loader thread parses the trace file (or reads its session index), while the records it publishes are handled by the load timer:
+    GT_IF_WITH_ASSERT(m_pTraceLoader == nullptr)
+    {
+        m_pTraceLoader = new gpTraceLoader;
+        retVal = m_pTraceLoader->Start(acGTStringToQString(traceFilePath.asString()));
+
+        if (retVal)
+        {
+            m_pLoadTimer->start();
+        }
+        else
+        {
+            SAFE_DELETE(m_pTraceLoader);
+        }
+    }
+
+    return retVal;
+}
+
+void TraceView::LoadNextTraceFile()
+{
+    bool isLoading = false;
+
+    GT_IF_WITH_ASSERT((m_pCurrentSession != nullptr) && (m_pCurrentSession->m_pParentData != nullptr))
+    {
+        // Move on to the next trace file of the session that exists, until a load is started:
+        while (!isLoading && (m_loadStage != LOAD_STAGE_PERF_MARKER_FILE))
+        {
+            m_loadStage = static_cast<LoadStage>(m_loadStage + 1);
+            osFilePath traceFilePath = m_pCurrentSession->m_pParentData->m_filePath;
+
+            switch (m_loadStage)
+            {
+                case LOAD_STAGE_TRACE_FILE:
+                    isLoading = StartLoadingTraceFile(traceFilePath);
+                    break;
+
+                case LOAD_STAGE_SYMBOL_FILE:
+                {
+                    // if we didn't load symbol info from .atp file, try loading it from .st file
+                    traceFilePath.setFileExtension(L"st");
+                    isLoading = m_symbolTableMap.isEmpty() && traceFilePath.exists() && StartLoadingTraceFile(traceFilePath);
+                }
+                break;
+
+                case LOAD_STAGE_PERF_MARKER_FILE:
+                {
+                    // if we didn't load CL perfmarker info from .atp file, try loading it from .clperfmarker file
+                    traceFilePath.setFileExtension(L"clperfmarker");
+                    isLoading = !m_perfMarkersAdded && traceFilePath.exists() && StartLoadingTraceFile(traceFilePath);
+                }
+                break;
+
+                default:
+                    break;
+            }
+        }
+    }
+
+    if (!isLoading)
     {
-        AtpUtils::Instance()->LoadModule();
+        m_loadStage = LOAD_STAGE_NONE;
+
+        DoneParsingATPFile();
+
+        // Load the summary view
+        LoadSummary(m_loadSessionInnerPage);
+
+        afProgressBarWrapper::instance().hideProgressBar();
+
+        ShowSessionInnerPage(m_loadSessionInnerPage);
     }
+}
 
-    AtpParserFunc parserFunc = AtpUtils::Instance()->GetAtpParserFunctionPointer();
+void TraceView::CancelLoading()
+{
+    m_pLoadTimer->stop();
 
-    if (nullptr != parserFunc)
+    if (m_pTraceLoader != nullptr)
     {
-        AtpUtils::Instance()->AddToCallBackHandlerList(this);
-        std::string sessionFileAsString = sessionFile.asString().asASCIICharArray();
-        retVal = parserFunc(sessionFileAsString.c_str(), OnParse, SetApiNum, ReportProgressOnParsing);
-        AtpUtils::Instance()->RemoveHandlerFromCallBackHandlerList(this);
+        m_pTraceLoader->Finish();
+        SAFE_DELETE(m_pTraceLoader);
     }
 
-    return retVal;
+    m_loadStage = LOAD_STAGE_NONE;
 }
 
+void TraceView::OnLoadTimer()
+{
+    GT_IF_WITH_ASSERT(m_pTraceLoader != nullptr)
+    {
+        // Handle the published batches for a time slice, so that the UI stays responsive while the session is loaded:
+        QElapsedTimer sliceTimer;
+        sliceTimer.start();
+
+        gpTraceRecordBatch* pBatch = nullptr;
+        bool isLoaderDone = false;
+        bool isBatchHandled = true;
+
+        while (isBatchHandled && (sliceTimer.elapsed() < s_LOAD_TIME_SLICE_MS))
+        {
+            isLoaderDone = !m_pTraceLoader->WaitForNextBatch(pBatch, 0);
+            isBatchHandled = (pBatch != nullptr);
+
+            if (isBatchHandled)
+            {
+                for (size_t i = 0; i < pBatch->m_recordCount; i++)
+                {
+                    HandleTraceIndexRecord(pBatch->m_records[i]);
+                }
+
+                m_pTraceLoader->ReleaseBatch(pBatch);
+            }
+        }
+
+        std::string progressMessage;
+        unsigned int progressCurrentItem = 0;
+        unsigned int progressTotalItems = 0;
+
+        if (m_pTraceLoader->GetProgress(progressMessage, progressCurrentItem, progressTotalItems))
+        {
+            ReportLoadProgress(progressMessage.c_str(), progressCurrentItem, progressTotalItems);
+        }
+
+        if (isLoaderDone)
+        {
+            m_pLoadTimer->stop();
+            m_pTraceLoader->Finish();
+            SAFE_DELETE(m_pTraceLoader);
+
+            LoadNextTraceFile();
+        }
+    }
+}
 
-void TraceView::HandleCLAPIInfo(ICLAPIInfoDataHandler* pClApiInfo)
+void TraceView::HandleCLAPIInfo(const gpTraceCLAPIRecord& clApiRecord)
 {
-    IAPIInfoDataHandler* pApiInfo = pClApiInfo->GetApiInfoDataHandler();
-    osThreadId threadId = pApiInfo->GetApiThreadId();
+    const gpTraceAPIRecord& apiRecord = clApiRecord.m_api;
+    osThreadId threadId = static_cast<osThreadId>(apiRecord.m_threadId);
 
     TraceTableModel* tableModel = nullptr;
     acTimelineItem* deviceBlockItem = nullptr;
@@ -1133,28 +1447,12 @@ void TraceView::HandleCLAPIInfo(ICLAPIInfoDataHandler* pClApiInfo)
     acTimelineBranch* hostBranch = GetHostBranchForAPI(threadId, GPU_STR_TraceViewOpenCL);
     GT_ASSERT(hostBranch != nullptr);
 
-    unsigned int apiID = pClApiInfo->GetCLApiId();
-    std::string strComment = pClApiInfo->GetCLApiComment();
+    unsigned int apiID = clApiRecord.m_apiId;
 
-    if (!strComment.empty())
-    {
-        std::string argList = pApiInfo->GetApiArgListString();
-        argList.append(" /* ").append(strComment).append(" */");
-    }
+    QString apiName = GetCLAPIName(clApiRecord);
 
-    QString apiName;
-
-    if (apiID < CL_FUNC_TYPE_Unknown)
-    {
-        apiName = CLAPIDefs::Instance()->GetOpenCLAPIString(CL_FUNC_TYPE(apiID));
-    }
-    else
-    {
-        apiName = QString::fromStdString(pApiInfo->GetApiNameString());
-    }
-
-    quint64 itemStartTime = pApiInfo->GetApiStartTime();
-    quint64 itemEndTime = pApiInfo->GetApiEndTime();
+    quint64 itemStartTime = apiRecord.m_startTime;
+    quint64 itemEndTime = apiRecord.m_endTime;
 
     // check for reasonable timestamps
     GT_ASSERT((itemEndTime >= itemStartTime) && itemStartTime != 0);
@@ -1165,7 +1463,7 @@ void TraceView::HandleCLAPIInfo(ICLAPIInfoDataHandler* pClApiInfo)
 
     if (m_lastDeviceItemIdx != -1 && (apiID == CL_FUNC_TYPE_clFinish || apiID == CL_FUNC_TYPE_clWaitForEvents || apiID == CL_FUNC_TYPE_clGetEventInfo))
     {
-        QString syncParams = QString::fromStdString(pApiInfo->m_ArgList);
+        QString syncParams = QString::fromStdString(apiRecord.m_argList);
         QString enqueueParams = tableModel->data(tableModel->index(m_lastDeviceItemIdx, TraceTableModel::TRACE_PARAMETERS_COLUMN), Qt::DisplayRole).toString();
 
         if (apiID == CL_FUNC_TYPE_clFinish)
@@ -1224,7 +1522,7 @@ void TraceView::HandleCLAPIInfo(ICLAPIInfoDataHandler* pClApiInfo)
 
 #endif
 
-    unsigned int dispSequenceId = pApiInfo->GetApiDisplaySequenceId();
+    unsigned int dispSequenceId = apiRecord.m_displaySequenceId;
 
     if (apiID == CL_FUNC_TYPE_clGetEventInfo)
     {
@@ -1240,36 +1538,32 @@ void TraceView::HandleCLAPIInfo(ICLAPIInfoDataHandler* pClApiInfo)
     pAPITimelineItem->setBackgroundColor(APIColorMap::Instance()->GetAPIColor(apiName, QColor(90, 90, 90)));
     pAPITimelineItem->setForegroundColor(Qt::white);
 
-    CLAPIType apiType = pClApiInfo->GetCLApiType();
+    CLAPIType apiType = static_cast<CLAPIType>(clApiRecord.m_apiType);
 
     if ((apiType & CL_ENQUEUE_BASE_API) == CL_ENQUEUE_BASE_API) // this is an enqueue api
     {
-
-        ICLEnqueueApiInfoDataHandler* enqueueApiInfo;
-        pClApiInfo->IsCLEnqueueAPI(&enqueueApiInfo);
-
-        GT_IF_WITH_ASSERT(enqueueApiInfo != nullptr)
+        GT_IF_WITH_ASSERT(clApiRecord.m_hasEnqueueInfo)
         {
-            unsigned int cmdType = enqueueApiInfo->GetCLCommandTypeEnum();
-            QString strCmdType = QString::fromStdString(enqueueApiInfo->GetCLCommandTypeString());
+            unsigned int cmdType = clApiRecord.m_commandType;
+            QString strCmdType = QString::fromStdString(clApiRecord.m_commandTypeString);
 
-            quint64 gpuStart = enqueueApiInfo->GetCLRunningTimestamp();
+            quint64 gpuStart = clApiRecord.m_runningTime;
 
-            quint64 gpuEnd = enqueueApiInfo->GetCLCompleteTimestamp();
+            quint64 gpuEnd = clApiRecord.m_completeTime;
 
-            quint64 gpuQueued = enqueueApiInfo->GetCLQueueTimestamp();
+            quint64 gpuQueued = clApiRecord.m_queueTime;
 
-            quint64 gpuSubmit = enqueueApiInfo->GetCLSubmitTimestamp();
+            quint64 gpuSubmit = clApiRecord.m_submitTime;
 
-            QString strQueueHandle = QString::fromStdString(enqueueApiInfo->GetCLCommandQueueHandleString());
+            QString strQueueHandle = QString::fromStdString(clApiRecord.m_queueHandleString);
 
-            unsigned int queueId = enqueueApiInfo->GetCLQueueId();
+            unsigned int queueId = clApiRecord.m_queueId;
 
-            QString strContextHandle = QString::fromStdString(enqueueApiInfo->GetCLContextHandleString());
+            QString strContextHandle = QString::fromStdString(clApiRecord.m_contextHandleString);
 
-            unsigned int contextId = enqueueApiInfo->GetCLContextId();
+            unsigned int contextId = clApiRecord.m_contextId;
 
-            QString deviceNameStr = QString::fromStdString(enqueueApiInfo->GetCLDeviceNameString());
+            QString deviceNameStr = QString::fromStdString(clApiRecord.m_deviceName);
 
             int nOccIndex = 0;
 
@@ -1295,17 +1589,14 @@ void TraceView::HandleCLAPIInfo(ICLAPIInfoDataHandler* pClApiInfo)
 
                 if ((apiType & CL_ENQUEUE_KERNEL) == CL_ENQUEUE_KERNEL)  // TODO does CL_COMMAND_NATIVE_KERNEL need special handling here????
                 {
-
-                    ICLKernelApiInfoDataHandler* kernelApiInfo;
-                    pClApiInfo->IsCLKernelApiInfo(&kernelApiInfo);
-                    GT_IF_WITH_ASSERT((kernelApiInfo != nullptr) && (pBranchInfo != nullptr) && (pBranchInfo->m_pQueueBranch != nullptr))
+                    GT_IF_WITH_ASSERT(clApiRecord.m_hasKernelInfo && (pBranchInfo != nullptr) && (pBranchInfo->m_pQueueBranch != nullptr))
                     {
-                        unsigned int displaySeqId = pApiInfo->GetApiDisplaySequenceId();
+                        unsigned int displaySeqId = apiRecord.m_displaySequenceId;
                         CLKernelTimelineItem* gpuItem = new CLKernelTimelineItem(gpuStart, gpuEnd, displaySeqId);
 
 #ifdef SHOW_KERNEL_LAUNCH_AND_COMPLETION_LATENCY
                         m_lastDeviceItem = gpuItem;
-                        m_lastDeviceItemIdx = pApiInfo->m_uiSeqID;
+                        m_lastDeviceItemIdx = apiRecord.m_sequenceId;
 #endif
 
                         APITimelineItem* newItem = new DispatchAPITimelineItem(gpuItem, pAPITimelineItem);
@@ -1313,9 +1604,9 @@ void TraceView::HandleCLAPIInfo(ICLAPIInfoDataHandler* pClApiInfo)
                         SAFE_DELETE(pAPITimelineItem);
                         pAPITimelineItem = newItem;
 
-                        gpuItem->setText(QString::fromStdString(kernelApiInfo->GetCLKernelNameString()));
-                        gpuItem->setGlobalWorkSize(QString::fromStdString(kernelApiInfo->GetCLKernelGlobalWorkGroupSize()));
-                        gpuItem->setLocalWorkSize(QString::fromStdString(kernelApiInfo->GetCLKernelWorkGroupSize()));
+                        gpuItem->setText(QString::fromStdString(clApiRecord.m_kernelName));
+                        gpuItem->setGlobalWorkSize(QString::fromStdString(clApiRecord.m_globalWorkSize));
+                        gpuItem->setLocalWorkSize(QString::fromStdString(clApiRecord.m_localWorkSize));
                         gpuItem->setBackgroundColor(pAPITimelineItem->backgroundColor());
                         gpuItem->setForegroundColor(Qt::white);
                         gpuItem->setQueueTime(gpuQueued);
@@ -1360,20 +1651,15 @@ void TraceView::HandleCLAPIInfo(ICLAPIInfoDataHandler* pClApiInfo)
                     m_lastDeviceItem = nullptr;
                     m_lastDeviceItemIdx = -1;
 #endif
-                    ICLMemApiInfoDataHandler* memApiInfo;
-                    pClApiInfo->IsCLMemoryApiInfo(&memApiInfo);
-
-                    GT_IF_WITH_ASSERT((memApiInfo != nullptr) && (pBranchInfo != nullptr) && (pBranchInfo->m_pMemoryBranch != nullptr))
+                    GT_IF_WITH_ASSERT(clApiRecord.m_hasMemoryInfo && (pBranchInfo != nullptr) && (pBranchInfo->m_pMemoryBranch != nullptr))
                     {
                         CLAPITimelineItem* gpuItem = nullptr;
 
                         //if ((cmdType >= CL_COMMAND_READ_BUFFER && cmdType <= CL_COMMAND_MAP_IMAGE) || (cmdType >= CL_COMMAND_READ_BUFFER_RECT && cmdType <= CL_COMMAND_COPY_BUFFER_RECT))
-                        unsigned int displaySeqId = pApiInfo->GetApiDisplaySequenceId();
+                        unsigned int displaySeqId = apiRecord.m_displaySequenceId;
                         gpuItem = new CLMemTimelineItem(gpuStart, gpuEnd, displaySeqId);
 
-                        quint64 transferSize;
-                        unsigned int uiTransferSize = memApiInfo->GetCLMemoryTransferSize();
-                        transferSize = static_cast<quint64>(uiTransferSize);
+                        quint64 transferSize = clApiRecord.m_memoryTransferSize;
 
                         (reinterpret_cast<CLMemTimelineItem*>(gpuItem))->setDataTransferSize(transferSize);
                         gpuItem->setText(CLMemTimelineItem::getDataSizeString(transferSize, 1) + " " + strCmdType.mid(11));
@@ -1403,15 +1689,12 @@ void TraceView::HandleCLAPIInfo(ICLAPIInfoDataHandler* pClApiInfo)
                     m_lastDeviceItemIdx = -1;
 #endif
 
-                    ICLOtherEnqueueApiInfoDataHandler* pOtherEnqueueOperationsInfo;
-                    pClApiInfo->IsCLEnqueueOtherOperations(&pOtherEnqueueOperationsInfo);
-
-                    GT_IF_WITH_ASSERT((pOtherEnqueueOperationsInfo != nullptr) && (pBranchInfo != nullptr) && (pBranchInfo->m_pQueueBranch != nullptr))
+                    GT_IF_WITH_ASSERT(clApiRecord.m_hasOtherEnqueueInfo && (pBranchInfo != nullptr) && (pBranchInfo->m_pQueueBranch != nullptr))
                     {
                         CLAPITimelineItem* gpuItem = nullptr;
 
-                        quint64 startTime = enqueueApiInfo->GetCLRunningTimestamp();
-                        quint64 endTime = enqueueApiInfo->GetCLCompleteTimestamp();
+                        quint64 startTime = clApiRecord.m_runningTime;
+                        quint64 endTime = clApiRecord.m_completeTime;
 
                         // Prepare the command name:
                         QString commandName = strCmdType.replace("CL_COMMAND_", "");
@@ -1419,22 +1702,19 @@ void TraceView::HandleCLAPIInfo(ICLAPIInfoDataHandler* pClApiInfo)
                         if ((apiType & CL_ENQUEUE_DATA_OPERATIONS) == CL_ENQUEUE_DATA_OPERATIONS)
                         {
                             // if (cmdType == CL_COMMAND_FILL_IMAGE) || (cmdType == CL_COMMAND_FILL_BUFFER)) || (cmdType == CL_COMMAND_SVM_MAP) || cmdType == CL_COMMAND_SVM_UNMAP)
-                            unsigned int displaySeqId = pApiInfo->GetApiDisplaySequenceId();
+                            unsigned int displaySeqId = apiRecord.m_displaySequenceId;
                             gpuItem = new CLDataEnqueueOperationsTimelineItem(startTime, endTime, displaySeqId);
 
-                            ICLDataEnqueueApiInfoDataHandler* pDataEnqueueOperationsInfo;
-                            pClApiInfo->IsCLDataEnqueueApi(&pDataEnqueueOperationsInfo);
-
-                            GT_IF_WITH_ASSERT((pDataEnqueueOperationsInfo != nullptr) && (pBranchInfo != nullptr) && (pBranchInfo->m_pQueueBranch != nullptr))
+                            GT_IF_WITH_ASSERT(clApiRecord.m_hasDataEnqueueInfo && (pBranchInfo != nullptr) && (pBranchInfo->m_pQueueBranch != nullptr))
                             {
-                                quint64 dataSize = static_cast<quint64>(pDataEnqueueOperationsInfo->GetCLDataTransferSize());
+                                quint64 dataSize = clApiRecord.m_dataTransferSize;
                                 static_cast<CLDataEnqueueOperationsTimelineItem*>(gpuItem)->setDataSize(dataSize);
                                 commandName.prepend(CLMemTimelineItem::getDataSizeString(dataSize, 1) + " ");
                             }
                         }
                         else
                         {
-                            gpuItem = new CLOtherEnqueueOperationsTimelineItem(startTime, endTime, pApiInfo->GetApiDisplaySequenceId());
+                            gpuItem = new CLOtherEnqueueOperationsTimelineItem(startTime, endTime, apiRecord.m_displaySequenceId);
                         }
 
                         APITimelineItem* newItem = new DispatchAPITimelineItem(gpuItem, pAPITimelineItem);
@@ -1478,18 +1758,18 @@ void TraceView::HandleCLAPIInfo(ICLAPIInfoDataHandler* pClApiInfo)
     if (pAPITimelineItem != nullptr)
     {
         hostBranch->addTimelineItem(pAPITimelineItem);
-        pAPITimelineItem->setTraceTableItem(tableModel->AddTopLevelTraceItem(GPU_STR_TraceViewOpenCL, apiName, pApiInfo, pAPITimelineItem, deviceBlockItem, occupancyInfo));
+        pAPITimelineItem->setTraceTableRow(tableModel, tableModel->AddTopLevelTraceItem(GPU_STR_TraceViewOpenCL, apiName, &apiRecord, pAPITimelineItem, deviceBlockItem, occupancyInfo));
     }
 
 }
 
-void TraceView::HandleHSAAPIInfo(IHSAAPIInfoDataHandler* phsaApiInfo)
+void TraceView::HandleHSAAPIInfo(const gpTraceHSAAPIRecord& hsaApiRecord)
 {
-    IAPIInfoDataHandler* pApiInfo = phsaApiInfo->GetApiInfoDataHandler();
-    HSA_API_Type apiID = phsaApiInfo->GetHSAApiTypeId();
-    osThreadId threadId = pApiInfo->GetApiThreadId();
+    const gpTraceAPIRecord& apiRecord = hsaApiRecord.m_api;
+    HSA_API_Type apiID = static_cast<HSA_API_Type>(hsaApiRecord.m_apiId);
+    osThreadId threadId = static_cast<osThreadId>(apiRecord.m_threadId);
 
-    if (phsaApiInfo->IsApi())
+    if (hsaApiRecord.m_isApi)
     {
         TraceTableModel* tableModel = nullptr;
         acTimelineItem* deviceBlockItem = nullptr;
@@ -1529,41 +1809,35 @@ void TraceView::HandleHSAAPIInfo(IHSAAPIInfoDataHandler* phsaApiInfo)
         if (apiID < HSA_API_Type_Init)
         {
             //apiName = CLAPIDefs::Instance()->GetOpenCLAPIString(CL_FUNC_TYPE(apiID));  //TODO : add a HSA version....
-            apiName = QString::fromStdString(pApiInfo->GetApiNameString());
+            apiName = QString::fromStdString(apiRecord.m_apiName);
         }
         else
         {
-            apiName = QString::fromStdString(pApiInfo->GetApiNameString());
+            apiName = QString::fromStdString(apiRecord.m_apiName);
         }
 
-        quint64 itemStartTime = pApiInfo->GetApiStartTime();
-        quint64 itemEndTime = pApiInfo->GetApiEndTime();
+        quint64 itemStartTime = apiRecord.m_startTime;
+        quint64 itemEndTime = apiRecord.m_endTime;
 
         // check for reasonable timestamps
         GT_ASSERT((itemEndTime >= itemStartTime) && itemStartTime != 0);
 
         APITimelineItem* item = nullptr;
 
-        IHSAMemoryApiInfoDataHandler* pHsaMemoryAPIInfo;
-        phsaApiInfo->IsHSAMemoryApi(&pHsaMemoryAPIInfo);
-
-        if (nullptr != pHsaMemoryAPIInfo)
+        if (hsaApiRecord.m_hasMemoryInfo)
         {
-            unsigned int dispSeqId = pApiInfo->GetApiDisplaySequenceId();
-            size_t hsaMemorySize = pHsaMemoryAPIInfo->GetHSAMemoryApiSize();
+            unsigned int dispSeqId = apiRecord.m_displaySequenceId;
+            size_t hsaMemorySize = static_cast<size_t>(hsaApiRecord.m_memorySize);
 
             item = new HSAMemoryTimelineItem(itemStartTime, itemEndTime, dispSeqId, hsaMemorySize);
 
-            IHSAMemoryTransferApiInfoDataHandler* pHsaMemoryTransferAPIInfo;
-            phsaApiInfo->IsHSAMemoryTransferApi(&pHsaMemoryTransferAPIInfo);
-
             uint64_t hsaTransferStartTime = 0;
             uint64_t hsaTransferEndTime = 0;
 
-            if (nullptr != pHsaMemoryTransferAPIInfo)
+            if (hsaApiRecord.m_hasTransferInfo)
             {
-                hsaTransferStartTime = pHsaMemoryTransferAPIInfo->GetHSAMemoryTransferStartTime();
-                hsaTransferEndTime = pHsaMemoryTransferAPIInfo->GetHSAMemoryTransferEndTime();
+                hsaTransferStartTime = hsaApiRecord.m_transferStartTime;
+                hsaTransferEndTime = hsaApiRecord.m_transferEndTime;
             }
 
             auto SplitAgentHandleAndName = [](const std::string& agentString, std::string& agentHandle , std::string& agentName)
@@ -1587,19 +1861,17 @@ void TraceView::HandleHSAAPIInfo(IHSAAPIInfoDataHandler* phsaApiInfo)
                 }
             };
 
-            if ((nullptr != pHsaMemoryTransferAPIInfo) && (0 != hsaTransferStartTime) && (0 != hsaTransferEndTime))
+            if (hsaApiRecord.m_hasTransferInfo && (0 != hsaTransferStartTime) && (0 != hsaTransferEndTime))
             {
 
                 std::string agentHandle;
                 std::string agentName;
 
-                std::string agentString = pHsaMemoryTransferAPIInfo->GetHSASrcAgentString();
-                SplitAgentHandleAndName(agentString, agentHandle, agentName);
+                SplitAgentHandleAndName(hsaApiRecord.m_srcAgentString, agentHandle, agentName);
                 QString srcAgentHandle = QString::fromStdString(agentHandle);
                 QString srcAgentName = QString::fromStdString(agentName);
 
-                agentString = pHsaMemoryTransferAPIInfo->GetHSADestinationAgentString();
-                SplitAgentHandleAndName(agentString, agentHandle, agentName);
+                SplitAgentHandleAndName(hsaApiRecord.m_dstAgentString, agentHandle, agentName);
                 QString dstAgentHandle = QString::fromStdString(agentHandle);
                 QString dstAgentName = QString::fromStdString(agentName);
 
@@ -1648,7 +1920,7 @@ void TraceView::HandleHSAAPIInfo(IHSAAPIInfoDataHandler* phsaApiInfo)
         }
         else
         {
-            unsigned int dispSeqId = pApiInfo->GetApiDisplaySequenceId();
+            unsigned int dispSeqId = apiRecord.m_displaySequenceId;
             item = new APITimelineItem(itemStartTime, itemEndTime, dispSeqId);
         }
 
@@ -1660,19 +1932,16 @@ void TraceView::HandleHSAAPIInfo(IHSAAPIInfoDataHandler* phsaApiInfo)
             hostBranch->addTimelineItem(item);
         }
 
-        item->setTraceTableItem(tableModel->AddTraceItem(GPU_STR_TraceViewHSA, apiName, pApiInfo, item, deviceBlockItem, occupancyInfo));
+        item->setTraceTableRow(tableModel, tableModel->AddTraceItem(GPU_STR_TraceViewHSA, apiName, &apiRecord, item, deviceBlockItem, occupancyInfo));
     }
     else if (HSA_API_Type_Non_API_Dispatch == apiID)
     {
-        IHSADispatchApiInfoDataHandler* dispatchInfo;
-        phsaApiInfo->IsHSADispatchApi(&dispatchInfo);
-
-        if (dispatchInfo != nullptr)
+        if (hsaApiRecord.m_hasDispatchInfo)
         {
-            quint64 gpuStart = pApiInfo->GetApiStartTime();
-            quint64 gpuEnd = pApiInfo->GetApiEndTime();
-            QString kernelNameStr = QString::fromStdString(dispatchInfo->GetHSAKernelName());
-            QString deviceNameStr = QString::fromStdString(dispatchInfo->GetHSADeviceName());
+            quint64 gpuStart = apiRecord.m_startTime;
+            quint64 gpuEnd = apiRecord.m_endTime;
+            QString kernelNameStr = QString::fromStdString(hsaApiRecord.m_kernelName);
+            QString deviceNameStr = QString::fromStdString(hsaApiRecord.m_deviceName);
 
             if ((gpuEnd < gpuStart))
             {
@@ -1698,7 +1967,7 @@ void TraceView::HandleHSAAPIInfo(IHSAAPIInfoDataHandler* phsaApiInfo)
                     m_pHSABranch->setText(GPU_STR_TraceViewHSA);
                 }
 
-                unsigned int hsaQueueIndex = dispatchInfo->GetHSAQueueIndex();
+                unsigned int hsaQueueIndex = hsaApiRecord.m_queueIndex;
 
                 if (m_hsaQueueMap.contains(hsaQueueIndex))
                 {
@@ -1708,22 +1977,22 @@ void TraceView::HandleHSAAPIInfo(IHSAAPIInfoDataHandler* phsaApiInfo)
                 {
                     deviceBranch = new acTimelineBranch();
                     deviceBranch->SetBGColor(QColor::fromRgb(230, 230, 230));
-                    QString deviceIndexStr = dispatchInfo->GetHSAQueueHandleString(); // "GetHSAQueueHandleString" is a misnomer. This function returns the device index
+                    QString deviceIndexStr = QString::fromStdString(hsaApiRecord.m_queueHandleString); // "GetHSAQueueHandleString" is a misnomer. This function returns the device index
                     QString queueBranchText = QString(tr(GPU_STR_HSATraceViewQueueRow)).arg(hsaQueueIndex).arg(deviceIndexStr).arg(deviceNameStr);
 
                     deviceBranch->setText(queueBranchText);
                     m_hsaQueueMap[hsaQueueIndex] = deviceBranch;
                 }
 
-                unsigned int uiSeqId = pApiInfo->GetApiSequenceId();
+                unsigned int uiSeqId = apiRecord.m_sequenceId;
                 HSADispatchTimelineItem* dispatchItem = new HSADispatchTimelineItem(gpuStart, gpuEnd, uiSeqId);
 
                 dispatchItem->setText(kernelNameStr);
-                dispatchItem->setGlobalWorkSize(QString::fromStdString(dispatchInfo->GetHSAGlobalWorkGroupSize()));
-                dispatchItem->setLocalWorkSize(QString::fromStdString(dispatchInfo->GetHSAWorkGroupSizeString()));
+                dispatchItem->setGlobalWorkSize(QString::fromStdString(hsaApiRecord.m_globalWorkSize));
+                dispatchItem->setLocalWorkSize(QString::fromStdString(hsaApiRecord.m_localWorkSize));
                 //dispatchItem->setOffset(QString::fromStdString(dispatchInfo->m_strOffset));
                 dispatchItem->setDeviceType(deviceNameStr);
-                dispatchItem->setQueueHandle(QString::fromStdString(dispatchInfo->GetHSAQueueHandleString()));
+                dispatchItem->setQueueHandle(QString::fromStdString(hsaApiRecord.m_queueHandleString));
                 dispatchItem->setBackgroundColor(Qt::darkGreen);
                 dispatchItem->setForegroundColor(Qt::white);
                 //dispatchItem->setHostItem(item);
@@ -1745,52 +2014,42 @@ void TraceView::HandleHSAAPIInfo(IHSAAPIInfoDataHandler* phsaApiInfo)
     }
 }
 
-void TraceView::HandleSymFileEntry(ISymbolFileEntryInfoDataHandler* pSymFileEntry)
+void TraceView::HandleSymFileEntry(const gpTraceSymbolRecord& symbolRecord)
 {
-    GT_IF_WITH_ASSERT(pSymFileEntry != nullptr)
+    osThreadId threadId = static_cast<osThreadId>(symbolRecord.m_threadId);
+    SymbolInfo* entry = nullptr;
+
+    if (symbolRecord.m_hasStackEntry)
     {
-        osThreadId threadId = pSymFileEntry->GetsymbolThreadId();
-        SymbolInfo* entry = nullptr;
+        LineNum lineNumber = static_cast<LineNum>(symbolRecord.m_lineNumber);
+        const std::string& fileName = symbolRecord.m_fileName;
 
-        if (!pSymFileEntry->IsStackEntryNull())
+        if (lineNumber != static_cast<LineNum>(-1) && !fileName.empty())
         {
-            IStackEntryInfoDataHandler* pStackEntryInfoHandler = pSymFileEntry->GetStackEntryInfoHandler();
-            LineNum lineNumber = pStackEntryInfoHandler->GetLineNumber();
-            std::string fileName = pStackEntryInfoHandler->GetFileNameString();
-
-            if (lineNumber != static_cast<LineNum>(-1) && !fileName.empty())
-            {
-                std::string apiName;
-                pSymFileEntry->GetSymbolApiName();
-
-                std::string symbolName;
-                pStackEntryInfoHandler->GetSymbolNameString();
-
-                entry = new SymbolInfo(QString::fromStdString(apiName),
-                                       QString::fromStdString(symbolName),
-                                       QString::fromStdString(fileName),
-                                       lineNumber);
-            }
-            else
-            {
-                entry = new SymbolInfo;
-            }
+            entry = new SymbolInfo(QString::fromStdString(symbolRecord.m_apiName),
+                                   QString::fromStdString(symbolRecord.m_symbolName),
+                                   QString::fromStdString(fileName),
+                                   lineNumber);
         }
         else
         {
             entry = new SymbolInfo;
         }
+    }
+    else
+    {
+        entry = new SymbolInfo;
+    }
 
-        if (m_symbolTableMap.contains(threadId))
-        {
-            m_symbolTableMap[threadId].append(entry);
-        }
-        else
-        {
-            QList<SymbolInfo*> list;
-            list.append(entry);
-            m_symbolTableMap.insert(threadId, list);
-        }
+    if (m_symbolTableMap.contains(threadId))
+    {
+        m_symbolTableMap[threadId].append(entry);
+    }
+    else
+    {
+        QList<SymbolInfo*> list;
+        list.append(entry);
+        m_symbolTableMap.insert(threadId, list);
     }
 }
 
@@ -1823,10 +2082,10 @@ acTimelineBranch* TraceView::GetPerfMarkerSubBranchHelper(const QString& name, a
     return ret;
 }
 
-void TraceView::HandlePerfMarkerEntry(IPerfMarkerInfoDataHandler* pPerfMarkerEntry)
+void TraceView::HandlePerfMarkerEntry(const gpTracePerfMarkerRecord& perfMarkerRecord)
 {
     m_perfMarkersAdded = true;
-    osThreadId threadId = pPerfMarkerEntry->GetPerfMarkerThreadId();
+    osThreadId threadId = static_cast<osThreadId>(perfMarkerRecord.m_threadId);
 
     TraceTableModel* pTableModel = nullptr;
 
@@ -1847,38 +2106,31 @@ void TraceView::HandlePerfMarkerEntry(IPerfMarkerInfoDataHandler* pPerfMarkerEnt
     unsigned long long startTime = 0;
     unsigned long long endTime = 0;
 
-    IPerfMarkerBeginInfoDataHandler* pBeginMarkerEntry;
-
-    if (pPerfMarkerEntry->IsBeginPerfMarkerEntry(&pBeginMarkerEntry))
+    if (gpTracePerfMarkerRecord::MARKER_BEGIN == perfMarkerRecord.m_markerType)
     {
-
-        GT_IF_WITH_ASSERT(pBeginMarkerEntry != nullptr)
+        if (m_branchStack.count() > 0)
         {
-            if (m_branchStack.count() > 0)
-            {
-                hostBranch = m_branchStack.top();
-            }
+            hostBranch = m_branchStack.top();
+        }
 
-            std::string markerGroup = pBeginMarkerEntry->GetPerfMarkerBeginInfoGroupName();
-            acTimelineBranch* branchToUse = GetPerfMarkerSubBranchHelper(QString::fromStdString(markerGroup), hostBranch);
+        acTimelineBranch* branchToUse = GetPerfMarkerSubBranchHelper(QString::fromStdString(perfMarkerRecord.m_groupName), hostBranch);
 
-            if (branchToUse != hostBranch)
-            {
-                m_branchStack.push(branchToUse);
-            }
+        if (branchToUse != hostBranch)
+        {
+            m_branchStack.push(branchToUse);
+        }
 
-            std::string markerName = pBeginMarkerEntry->GetPerfMarkerBeginInfoName();
-            m_titleStack.push(QString::fromStdString(markerName));
+        QString markerName = QString::fromStdString(perfMarkerRecord.m_name);
+        m_titleStack.push(markerName);
 
-            unsigned long long markerTimestamp = pPerfMarkerEntry->GetPerfMarkerTimestamp();
-            m_timestampStack.push(markerTimestamp);
+        unsigned long long markerTimestamp = perfMarkerRecord.m_timestamp;
+        m_timestampStack.push(markerTimestamp);
 
-            // Add an item to the table:
-            TraceTableItem* pTableItem = pTableModel->AddTraceItem("Perf Marker", QString::fromStdString(markerName), pPerfMarkerEntry);
-            GT_ASSERT(pTableItem != nullptr);
-        }
+        // Add an item to the table:
+        quint32 tableRow = pTableModel->AddTraceItem("Perf Marker", markerName, &perfMarkerRecord);
+        GT_ASSERT(tableRow != TraceTableColumnStore::INVALID_ROW);
     }
-    else if (pPerfMarkerEntry->IsEndPerfMarkerEntry())
+    else if (gpTracePerfMarkerRecord::MARKER_END == perfMarkerRecord.m_markerType)
     {
         if (m_timestampStack.isEmpty())
         {
@@ -1887,7 +2139,7 @@ void TraceView::HandlePerfMarkerEntry(IPerfMarkerInfoDataHandler* pPerfMarkerEnt
         }
 
         startTime = m_timestampStack.pop();
-        endTime = pPerfMarkerEntry->GetPerfMarkerTimestamp();
+        endTime = perfMarkerRecord.m_timestamp;
 
         // Create the new time line item:
         PerfMarkerTimelineItem* pNewItem = new PerfMarkerTimelineItem(startTime, endTime);
@@ -1905,13 +2157,13 @@ void TraceView::HandlePerfMarkerEntry(IPerfMarkerInfoDataHandler* pPerfMarkerEnt
         }
 
         // Add an item to the table:
-        TraceTableItem* pTableItem = pTableModel->CloseLastOpenedPerfMarker(pNewItem);
-        GT_IF_WITH_ASSERT(pTableItem != nullptr)
+        quint32 tableRow = pTableModel->CloseLastOpenedPerfMarker(pNewItem);
+        GT_IF_WITH_ASSERT(tableRow != TraceTableColumnStore::INVALID_ROW)
         {
-            pNewItem->setTraceTableItem(pTableItem);
+            pNewItem->setTraceTableRow(pTableModel, tableRow);
         }
     }
-    else if (pPerfMarkerEntry->IsEndExPerfMarkerEntry())
+    else if (gpTracePerfMarkerRecord::MARKER_END_EX == perfMarkerRecord.m_markerType)
     {
         if (m_timestampStack.isEmpty())
         {
@@ -1919,11 +2171,8 @@ void TraceView::HandlePerfMarkerEntry(IPerfMarkerInfoDataHandler* pPerfMarkerEnt
             return;
         }
 
-        IPerfMarkerEndExInfoDataHandler* pEndExMarkerEntry;
-        pPerfMarkerEntry->IsEndExPerfMarkerEntry(&pEndExMarkerEntry);
-
         startTime = m_timestampStack.pop();
-        endTime = pPerfMarkerEntry->GetPerfMarkerTimestamp();
+        endTime = perfMarkerRecord.m_timestamp;
 
         // Create the new time line item:
         PerfMarkerTimelineItem* pNewItem = new PerfMarkerTimelineItem(startTime, endTime);
@@ -1932,8 +2181,7 @@ void TraceView::HandlePerfMarkerEntry(IPerfMarkerInfoDataHandler* pPerfMarkerEnt
         pNewItem->setBackgroundColor(APIColorMap::Instance()->GetPerfMarkersColor());
         pNewItem->setForegroundColor(Qt::black);
 
-        std::string markerName = pEndExMarkerEntry->GetPerfMarkerEndExName();
-        pNewItem->setText(QString::fromStdString(markerName));
+        pNewItem->setText(QString::fromStdString(perfMarkerRecord.m_name));
 
         // Remove the title that was specified from the BeginPerfMarker call
         m_titleStack.pop();
@@ -1948,16 +2196,15 @@ void TraceView::HandlePerfMarkerEntry(IPerfMarkerInfoDataHandler* pPerfMarkerEnt
                 hostBranch = m_branchStack.top();
             }
 
-            std::string markerGroup = pEndExMarkerEntry->GetPerfMarkerEndExGroupName();
-            currentBranch = GetPerfMarkerSubBranchHelper(QString::fromStdString(markerGroup), hostBranch);
+            currentBranch = GetPerfMarkerSubBranchHelper(QString::fromStdString(perfMarkerRecord.m_groupName), hostBranch);
             currentBranch->addTimelineItem(pNewItem);
         }
 
         // Add an item to the table:
-        TraceTableItem* pTableItem = pTableModel->CloseLastOpenedPerfMarker(pNewItem);
-        GT_IF_WITH_ASSERT(pTableItem != nullptr)
+        quint32 tableRow = pTableModel->CloseLastOpenedPerfMarker(pNewItem);
+        GT_IF_WITH_ASSERT(tableRow != TraceTableColumnStore::INVALID_ROW)
         {
-            pNewItem->setTraceTableItem(pTableItem);
+            pNewItem->setTraceTableRow(pTableModel, tableRow);
         }
     }
 }
@@ -1966,10 +2213,20 @@ void TraceView::DoneParsingATPFile()
 {
     bool timelineDataLoaded = false;
     bool traceDataLoaded = false;
-    m_parseCallsCounter = 0;
+    m_detailedRecordsCount = 0;
 
     afApplicationCommands::instance()->EndPerformancePrintout("Parsing trace file");
 
+    // Add the aggregate items to their host branches, now that their time spans are final:
+    for (QMap<QPair<acTimelineBranch*, quint64>, APIAggregateTimelineItem*>::const_iterator i = m_aggregateItemsMap.begin(); i != m_aggregateItemsMap.end(); ++i)
+    {
+        APIAggregateTimelineItem* pAggregateItem = *i;
+        pAggregateItem->setText(QString(GPU_STR_TraceViewAggregatedAPICalls).arg(pAggregateItem->callCount()));
+        i.key().first->addTimelineItem(pAggregateItem);
+    }
+
+    m_aggregateItemsMap.clear();
+
     if (!m_hostBranchMap.isEmpty())
     {
         timelineDataLoaded = true;
@@ -2054,6 +2311,9 @@ void TraceView::DoneParsingATPFile()
         }
 
         m_modelMap.clear();
+
+        // The tables are complete, so they can be indexed for the find toolbar:
+        StartTraceSearchIndexing();
     }
 
     if (!timelineDataLoaded)
@@ -2065,6 +2325,7 @@ void TraceView::DoneParsingATPFile()
             m_pMainSplitter = nullptr;
             m_pTraceTabView = nullptr;
             m_pTimeline = nullptr;
+            m_pFindToolBar = nullptr;
             QString strError = "An error occurred when loading the Application Trace.";
             QStringList excludedAPIs;
 
@@ -2235,10 +2496,10 @@ void TraceView::OnZoomItemInTimeline()
             GT_IF_WITH_ASSERT(!pTraceTable->selectionModel()->selectedIndexes().isEmpty())
             {
                 QModelIndex firstSelected = pTraceTable->selectionModel()->selectedIndexes().first();
-                TraceTableItem* pSelectedItem = static_cast<TraceTableItem*>(firstSelected.internalPointer());
-                GT_IF_WITH_ASSERT(pSelectedItem != nullptr)
+                TraceTableModel* pModel = qobject_cast<TraceTableModel*>(pTraceTable->model());
+                GT_IF_WITH_ASSERT((pModel != nullptr) && firstSelected.isValid())
                 {
-                    m_pTimeline->ZoomToItem(pSelectedItem->GetTimelineItem(), true);
+                    m_pTimeline->ZoomToItem(pModel->GetTimelineItem(firstSelected), true);
                 }
             }
         }
@@ -2253,6 +2514,102 @@ void TraceView::OnExportToCSV()
         TraceTable* pTraceTable = qobject_cast<TraceTable*>(m_pTraceTabView->currentWidget());
 
         if (pTraceTable != nullptr)
+        {
+            TraceTableModel* pModel = qobject_cast<TraceTableModel*>(pTraceTable->model());
+            GT_IF_WITH_ASSERT(pModel != nullptr)
+            {
+                // Export all the columns of the top level rows:
+                std::vector<int> columns;
+
+                for (int column = 0; column < TraceTableModel::TRACE_COLUMN_COUNT; ++column)
+                {
+                    columns.push_back(column);
+                }
+
+                std::vector<quint32> storeRows;
+                pModel->GetTopLevelRows(storeRows);
+                StartExportToCSV(pTraceTable, columns, storeRows);
+            }
+        }
+    }
+}
+
+void TraceView::OnExportVisibleRowsToCSV()
+{
+    // Sanity check:
+    GT_IF_WITH_ASSERT(m_pTraceTabView != nullptr)
+    {
+        TraceTable* pTraceTable = qobject_cast<TraceTable*>(m_pTraceTabView->currentWidget());
+
+        if (pTraceTable != nullptr)
+        {
+            std::vector<int> columns;
+            pTraceTable->GetVisibleColumns(columns);
+
+            std::vector<quint32> storeRows;
+            pTraceTable->GetVisibleRows(storeRows);
+            StartExportToCSV(pTraceTable, columns, storeRows);
+        }
+    }
+}
+
+void TraceView::OnExportTimeRangeToCSV()
+{
+    // Sanity check:
+    GT_IF_WITH_ASSERT((m_pTraceTabView != nullptr) && m_isTimeRangeSelected)
+    {
+        TraceTable* pTraceTable = qobject_cast<TraceTable*>(m_pTraceTabView->currentWidget());
+
+        if (pTraceTable != nullptr)
+        {
+            TraceTableModel* pModel = qobject_cast<TraceTableModel*>(pTraceTable->model());
+            GT_IF_WITH_ASSERT(pModel != nullptr)
+            {
+                std::vector<int> columns;
+                pTraceTable->GetVisibleColumns(columns);
+
+                std::vector<quint32> storeRows;
+                pModel->GetTimeRangeRows(m_selectedRangeStartTime, m_selectedRangeEndTime, storeRows);
+                StartExportToCSV(pTraceTable, columns, storeRows);
+            }
+        }
+    }
+}
+
+void TraceView::OnCancelExportToCSV()
+{
+    CancelExportToCSV();
+}
+
+void TraceView::OnExportToCSVTimer()
+{
+    size_t exportedRowsCount = 0;
+    size_t totalRowsCount = 0;
+    gpTraceCSVExporter::ExportState state = m_csvExporter.GetState(exportedRowsCount, totalRowsCount);
+
+    if (gpTraceCSVExporter::EXPORT_STATE_RUNNING == state)
+    {
+        afProgressBarWrapper::instance().updateProgressBar(static_cast<int>(exportedRowsCount));
+    }
+    else
+    {
+        m_pExportToCSVTimer->stop();
+        afProgressBarWrapper::instance().hideProgressBar();
+
+        if (gpTraceCSVExporter::EXPORT_STATE_FAILED == state)
+        {
+            acMessageBox::instance().warning(afGlobalVariablesManager::ProductNameA(), QString(GPU_STR_TraceViewExportToCSVFailed).arg(m_csvExporter.GetOutputFilePath()));
+        }
+    }
+}
+
+void TraceView::StartExportToCSV(TraceTable* pTraceTable, const std::vector<int>& columns, std::vector<quint32>& storeRows)
+{
+    // Sanity check:
+    GT_IF_WITH_ASSERT((pTraceTable != nullptr) && (m_pCurrentSession != nullptr) && !m_csvExporter.IsRunning())
+    {
+        TraceTableModel* pModel = qobject_cast<TraceTableModel*>(pTraceTable->model());
+        GT_IF_WITH_ASSERT(pModel != nullptr)
         {
             // The file path for the saved CSV file:
             QString csvFilePathStr;
@@ -2260,11 +2617,63 @@ void TraceView::OnExportToCSV()
             // Build the CSV default file name:
             QString fileName = QString(GPU_CSV_FileNameFormat).arg(m_pCurrentSession->m_displayName).arg(GPU_CSV_FileNameTraceView);
             bool rc = afApplicationCommands::instance()->ShowQTSaveCSVFileDialog(csvFilePathStr, fileName, this);
-            GT_IF_WITH_ASSERT(rc)
+
+            if (rc)
             {
-                // Export the web view table to a CSV file:
-                rc = pTraceTable->ExportToCSV(csvFilePathStr);
-                GT_ASSERT(rc);
+                QStringList columnHeaders;
+
+                for (int column : columns)
+                {
+                    columnHeaders << pModel->headerData(column, Qt::Horizontal, Qt::DisplayRole).toString();
+                }
+
+                // The rows are formatted and written on the export thread, and the progress is polled by the export timer:
+                int rowsCount = static_cast<int>(storeRows.size());
+                rc = m_csvExporter.Start(csvFilePathStr, columns, columnHeaders, pModel, storeRows);
+                GT_IF_WITH_ASSERT(rc)
+                {
+                    afProgressBarWrapper::instance().ShowProgressBar(acQStringToGTString(QString(GPU_STR_TraceViewExportingToCSV).arg(rowsCount)), rowsCount);
+                    m_pExportToCSVTimer->start();
+                }
+            }
+        }
+    }
+}
+
+void TraceView::CancelExportToCSV()
+{
+    m_csvExporter.Cancel();
+
+    if (m_pExportToCSVTimer->isActive())
+    {
+        m_pExportToCSVTimer->stop();
+        afProgressBarWrapper::instance().hideProgressBar();
+    }
+}
+
+void TraceView::OnCompareWithSession()
+{
+    // Sanity check:
+    GT_IF_WITH_ASSERT((m_pCurrentSession != nullptr) && (m_pCurrentSession->m_pParentData != nullptr) && (m_pSessionTabWidget != nullptr))
+    {
+        QString currentTraceFilePath = acGTStringToQString(m_pCurrentSession->m_pParentData->m_filePath.asString());
+
+        // The baseline is usually another session of the project, so browse from the project profile output directory:
+        QDir profilesDir = QFileInfo(currentTraceFilePath).dir();
+        profilesDir.cdUp();
+        QString defaultLocation = profilesDir.absolutePath();
+
+        QString baselineTraceFilePath = afApplicationCommands::instance()->ShowFileSelectionDialog(GPU_STR_TraceComparisonSelectBaseline, defaultLocation, GPU_STR_TraceComparisonTraceFileFilter, nullptr);
+
+        if (!baselineTraceFilePath.isEmpty())
+        {
+            // The traces are compared on a background thread, and the tab is closed like the other session tabs:
+            gpTraceComparisonView* pComparisonView = new gpTraceComparisonView(this);
+            GT_IF_WITH_ASSERT(pComparisonView->StartComparison(baselineTraceFilePath, currentTraceFilePath))
+            {
+                QString baselineSessionName = QFileInfo(baselineTraceFilePath).dir().dirName();
+                int tabIndex = m_pSessionTabWidget->addTab(pComparisonView, QString(GPU_STR_TraceComparisonTabCaption).arg(baselineSessionName));
+                m_pSessionTabWidget->setCurrentIndex(tabIndex);
             }
         }
     }
@@ -2339,8 +2748,8 @@ void TraceView::BuildWindowLayout()
 
     m_pTraceTabView = new QTabWidget(this);
 
-    //    m_findToolBar = new FindToolBarView(this);
-    //
+    m_pFindToolBar = new FindToolBarView(this);
+
     m_pTraceTableContextMenu = new QMenu(this);
 
     m_pSessionTabWidget->setTabsClosable(true);
@@ -2348,13 +2757,13 @@ void TraceView::BuildWindowLayout()
     m_pMainSplitter->setOrientation(Qt::Vertical);
     m_pMainSplitter->addWidget(m_pTimeline);
     m_pMainSplitter->addWidget(m_pTraceTabView);
-    //    addWidget(m_findToolBar);
+    m_pMainSplitter->addWidget(m_pFindToolBar);
 
     // set the initial sizes for the timeline, trace/summary tabs, and find toolbar
     QList<int> sizeList;
     sizeList.append(100); // timeline
     sizeList.append(100); // trace/summary tabs
-    //    sizeList.append(10);  // find toolbar
+    sizeList.append(10);  // find toolbar
     m_pMainSplitter->setSizes(sizeList);
 
     m_pMainLayout = new QHBoxLayout(this);
@@ -2364,3 +2773,287 @@ void TraceView::BuildWindowLayout()
     setLayout(m_pMainLayout);
 }
 
+
+void TraceView::StartTraceSearchIndexing()
+{
+    GT_IF_WITH_ASSERT(m_pTraceTabView != nullptr)
+    {
+        std::vector<gpTraceSearchTable> searchTables;
+        m_findTables.clear();
+
+        for (int tabIndex = 0; tabIndex < m_pTraceTabView->count(); tabIndex++)
+        {
+            TraceTable* pTraceTable = qobject_cast<TraceTable*>(m_pTraceTabView->widget(tabIndex));
+
+            if (pTraceTable != nullptr)
+            {
+                TraceTableModel* pModel = qobject_cast<TraceTableModel*>(pTraceTable->model());
+                GT_IF_WITH_ASSERT(pModel != nullptr)
+                {
+                    gpTraceSearchTable searchTable;
+                    searchTable.m_pStore = &pModel->GetColumnStore();
+                    searchTable.m_threadId = pTraceTable->GetThreadId();
+                    searchTables.push_back(searchTable);
+                    m_findTables.push_back(pTraceTable);
+                }
+            }
+        }
+
+        // The index is built on the search thread:
+        m_traceSearch.SetTables(searchTables);
+
+        // A query typed while the session was loading is run against the new tables:
+        if ((m_pFindToolBar != nullptr) && !m_pFindToolBar->GetQueryText().isEmpty())
+        {
+            OnFindQueryChanged();
+        }
+    }
+}
+
+void TraceView::ClearFindMatches()
+{
+    for (TraceTable* pTraceTable : m_findTables)
+    {
+        TraceTableModel* pModel = qobject_cast<TraceTableModel*>(pTraceTable->model());
+
+        if (pModel != nullptr)
+        {
+            pModel->ClearMatchedRows();
+            pTraceTable->viewport()->update();
+        }
+    }
+
+    // Restore the original colors of the highlighted timeline items:
+    for (const std::pair<acTimelineItem*, QColor>& highlightedItem : m_highlightedTimelineItems)
+    {
+        highlightedItem.first->setBackgroundColor(highlightedItem.second);
+    }
+
+    if (!m_highlightedTimelineItems.empty() && (m_pTimeline != nullptr))
+    {
+        m_pTimeline->update();
+    }
+
+    m_highlightedTimelineItems.clear();
+    m_findMatches.clear();
+    m_currentFindMatch = -1;
+}
+
+void TraceView::SetTablesFilterMode(bool isFiltered)
+{
+    for (TraceTable* pTraceTable : m_findTables)
+    {
+        TraceTableModel* pModel = qobject_cast<TraceTableModel*>(pTraceTable->model());
+
+        if (pModel != nullptr)
+        {
+            pModel->SetFilterMode(isFiltered);
+
+            if (!isFiltered)
+            {
+                // The model reset collapsed the tree:
+                pTraceTable->expandAll();
+            }
+        }
+    }
+}
+
+void TraceView::OnFindQueryChanged()
+{
+    GT_IF_WITH_ASSERT((m_pFindToolBar != nullptr) && (m_pFindResultsTimer != nullptr))
+    {
+        ClearFindMatches();
+
+        gpTraceSearchQuery query;
+        QString strErrorMessage;
+
+        if (query.Parse(m_pFindToolBar->GetQueryText(), m_pFindToolBar->IsMatchCase(), m_pFindToolBar->IsRegex(), strErrorMessage))
+        {
+            SetTablesFilterMode(m_pFindToolBar->IsFilterMode() && !query.IsEmpty());
+
+            // The query runs on the search thread, and its matches are added by the results timer:
+            m_traceSearch.StartSearch(query);
+            m_pFindResultsTimer->start();
+            OnFindResultsTimer();
+        }
+        else
+        {
+            m_traceSearch.CancelSearch();
+            m_pFindResultsTimer->stop();
+            m_findSearchState = gpTraceSearch::SEARCH_STATE_IDLE;
+            m_pFindToolBar->SetStatusText(strErrorMessage, true);
+        }
+    }
+}
+
+void TraceView::OnFindResultsTimer()
+{
+    std::vector<gpTraceSearchMatch> matches;
+    m_findSearchState = m_traceSearch.TakeMatches(matches, m_findSearchTimeMs);
+
+    if (!matches.empty())
+    {
+        // The matches are ordered by table, so the rows of each table are added at once:
+        std::vector<quint32> tableRows;
+        size_t firstTableMatch = 0;
+
+        while (firstTableMatch < matches.size())
+        {
+            unsigned int tableIndex = matches[firstTableMatch].m_tableIndex;
+            size_t endTableMatch = firstTableMatch;
+            tableRows.clear();
+
+            while ((endTableMatch < matches.size()) && (matches[endTableMatch].m_tableIndex == tableIndex))
+            {
+                tableRows.push_back(matches[endTableMatch].m_storeRow);
+                endTableMatch++;
+            }
+
+            GT_IF_WITH_ASSERT(tableIndex < m_findTables.size())
+            {
+                TraceTable* pTraceTable = m_findTables[tableIndex];
+                TraceTableModel* pModel = qobject_cast<TraceTableModel*>(pTraceTable->model());
+                GT_IF_WITH_ASSERT(pModel != nullptr)
+                {
+                    pModel->AddMatchedRows(tableRows);
+                    pTraceTable->viewport()->update();
+
+                    // Highlight the matches in the timeline:
+                    for (size_t i = 0; (i < tableRows.size()) && (m_highlightedTimelineItems.size() < s_MAX_HIGHLIGHTED_TIMELINE_ITEMS); i++)
+                    {
+                        acTimelineItem* pTimelineItem = pModel->GetColumnStore().GetTimelineItem(tableRows[i]);
+
+                        if (pTimelineItem != nullptr)
+                        {
+                            m_highlightedTimelineItems.push_back(std::make_pair(pTimelineItem, pTimelineItem->backgroundColor()));
+                            pTimelineItem->setBackgroundColor(s_FIND_MATCH_TIMELINE_COLOR);
+                        }
+                    }
+                }
+            }
+
+            firstTableMatch = endTableMatch;
+        }
+
+        m_findMatches.insert(m_findMatches.end(), matches.begin(), matches.end());
+
+        if (m_pTimeline != nullptr)
+        {
+            m_pTimeline->update();
+        }
+
+        // Show the first match as soon as it is found:
+        if (m_currentFindMatch < 0)
+        {
+            ShowFindMatch(0);
+        }
+    }
+
+    if ((m_findSearchState == gpTraceSearch::SEARCH_STATE_IDLE) || (m_findSearchState == gpTraceSearch::SEARCH_STATE_DONE))
+    {
+        m_pFindResultsTimer->stop();
+    }
+
+    UpdateFindStatus();
+}
+
+void TraceView::OnFindNext()
+{
+    if (!m_findMatches.empty())
+    {
+        ShowFindMatch((m_currentFindMatch + 1) % static_cast<int>(m_findMatches.size()));
+        UpdateFindStatus();
+    }
+}
+
+void TraceView::OnFindPrevious()
+{
+    if (!m_findMatches.empty())
+    {
+        int matchesCount = static_cast<int>(m_findMatches.size());
+        ShowFindMatch((m_currentFindMatch + matchesCount - 1) % matchesCount);
+        UpdateFindStatus();
+    }
+}
+
+void TraceView::OnFindFilterModeChanged(bool isFilterMode)
+{
+    GT_IF_WITH_ASSERT(m_pFindToolBar != nullptr)
+    {
+        // Without a query there is nothing to filter by:
+        SetTablesFilterMode(isFilterMode && !m_pFindToolBar->GetQueryText().trimmed().isEmpty());
+
+        if (m_currentFindMatch >= 0)
+        {
+            ShowFindMatch(m_currentFindMatch);
+        }
+    }
+}
+
+void TraceView::ShowFindMatch(int matchIndex)
+{
+    GT_IF_WITH_ASSERT((matchIndex >= 0) && (matchIndex < static_cast<int>(m_findMatches.size())) && (m_pTraceTabView != nullptr))
+    {
+        m_currentFindMatch = matchIndex;
+
+        const gpTraceSearchMatch& match = m_findMatches[matchIndex];
+        TraceTable* pTraceTable = m_findTables[match.m_tableIndex];
+        TraceTableModel* pModel = qobject_cast<TraceTableModel*>(pTraceTable->model());
+        GT_IF_WITH_ASSERT(pModel != nullptr)
+        {
+            m_pTraceTabView->setCurrentWidget(pTraceTable);
+
+            QModelIndex matchModelIndex = pModel->GetStoreRowIndex(match.m_storeRow);
+
+            if (matchModelIndex.isValid())
+            {
+                pTraceTable->setCurrentIndex(matchModelIndex);
+                pTraceTable->scrollTo(matchModelIndex, QAbstractItemView::PositionAtCenter);
+            }
+
+            acTimelineItem* pTimelineItem = pModel->GetColumnStore().GetTimelineItem(match.m_storeRow);
+
+            if ((pTimelineItem != nullptr) && (m_pTimeline != nullptr))
+            {
+                m_pTimeline->ZoomToItem(pTimelineItem, true);
+            }
+        }
+    }
+}
+
+void TraceView::UpdateFindStatus()
+{
+    if (m_pFindToolBar != nullptr)
+    {
+        QString strStatus;
+
+        switch (m_findSearchState)
+        {
+            case gpTraceSearch::SEARCH_STATE_BUILDING_INDEX:
+                strStatus = GPU_STR_TraceSearchBuildingIndex;
+                break;
+
+            case gpTraceSearch::SEARCH_STATE_SEARCHING:
+                strStatus = GPU_STR_TraceSearchSearching;
+                break;
+
+            case gpTraceSearch::SEARCH_STATE_DONE:
+                if (m_findMatches.empty())
+                {
+                    strStatus = GPU_STR_TraceSearchNoMatches;
+                }
+                else
+                {
+                    strStatus = QString(GPU_STR_TraceSearchMatches).arg(m_currentFindMatch + 1).arg(m_findMatches.size()).arg(m_findSearchTimeMs);
+                }
+
+                break;
+
+            case gpTraceSearch::SEARCH_STATE_IDLE:
+            default:
+                break;
+        }
+
+        m_pFindToolBar->SetStatusText(strStatus, false);
+    }
+}
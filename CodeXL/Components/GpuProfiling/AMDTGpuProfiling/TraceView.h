@@ -21,10 +21,12 @@
 
 #include <QString>
 #include <QMap>
+#include <QPair>
 #include <QList>
 #include <QSplitter>
 #include <QTabWidget>
 #include <QAbstractTableModel>
+#include <QTimer>
 
 // RCP Backend header files
 #include <IAtpDataHandler.h>
@@ -37,17 +39,23 @@
 // Local:
 #include <AMDTGpuProfiling/Session.h>
 #include <AMDTGpuProfiling/SummaryView.h>
+#include <AMDTGpuProfiling/CLSummarizer.h>
 #include <AMDTGpuProfiling/FindToolBarView.h>
 #include <AMDTGpuProfiling/TraceTable.h>
 #include <AMDTGpuProfiling/ProjectSettings.h>
 #include <AMDTGpuProfiling/gpBaseSessionView.h>
-#include "ICallBackParserHandler.h"
+#include <AMDTGpuProfiling/gpTraceSessionIndex.h>
+#include <AMDTGpuProfiling/gpTraceSearch.h>
+#include <AMDTGpuProfiling/gpTraceCSVExporter.h>
+#include <AMDTGpuProfiling/gpTraceSummarizer.h>
 #include "CXLAnalyzerHTMLUtils.h"
 
 // forward declaration
 class acTimeline;
 class acTimelineBranch;
 class acTimelineItem;
+class APIAggregateTimelineItem;
+class gpTraceLoader;
 
 //forward declarations
 class KernelOccupancyWindow;
@@ -59,7 +67,7 @@ class SessionViewTabWidget;
 #endif
 
 /// UI for Application Trace GPUSessionTreeItemData view
-class TraceView : public gpBaseSessionView, public ICallBackParserHandler
+class TraceView : public gpBaseSessionView
 {
     Q_OBJECT
 
@@ -90,16 +98,11 @@ public:
     /// \param apiNum the number of api calls expected in the parsed atp file
     void SetAPINum(osThreadId threadId, unsigned int apiNum);
 
-
-    void OnParseCallHandler(AtpInfoType apiType, bool& stopParsing) override;
-
-    void OnSetApiNumCallHandler(osThreadId threadId, unsigned int apiNum) override;
-
-    /// IParserProgressMonitor implementation for reporting progress when loading trace data
+    /// Reports the progress of loading trace data
     /// \param strProgressMessage the progress message to display for this progress event
     /// \param uiCurItem the index of the current item being parsed
     /// \param uiTotalItems the total number of items to be parsed
-    void OnParserProgressCallHandler(const char* strProgressMessage, unsigned int uiCurItem, unsigned int uiTotalItems) override;
+    void ReportLoadProgress(const char* strProgressMessage, unsigned int uiCurItem, unsigned int uiTotalItems);
 
     /// Display the requested summary type
     /// \param selectedIndex - The requested summary to display on the summary page tab
@@ -168,13 +171,59 @@ private slots:
     /// handler for when the expand all action is selected
     void OnExpandAll();
 
-    /// Handler for export to CSV context menu:
+    /// Handler for export to CSV context menu. Exports all the top level rows of the current table
     void OnExportToCSV();
 
+    /// Handler for export visible rows to CSV context menu. Exports the rows and columns shown in the current table
+    void OnExportVisibleRowsToCSV();
+
+    /// Handler for export selected timeline range to CSV context menu. Exports the rows of the current table
+    /// which overlap the time range of the last clicked timeline item
+    void OnExportTimeRangeToCSV();
+
+    /// Handler for cancel CSV export context menu
+    void OnCancelExportToCSV();
+
+    /// Handler for the CSV export timer. Updates the export progress, and reports the export end
+    void OnExportToCSVTimer();
+
+    /// Handler for compare with session context menu. Compares a baseline trace, selected by the user, with this session
+    /// in a new session tab
+    void OnCompareWithSession();
+
     /// Application tree selection signal:
     void OnApplicationTreeSelection() {m_areTimelinePropertiesSet = false;};
 
+    /// Handler for a change of the find toolbar query. Starts the query on the search thread
+    void OnFindQueryChanged();
+
+    /// Handler for the find toolbar next button. Shows the next match
+    void OnFindNext();
+
+    /// Handler for the find toolbar previous button. Shows the previous match
+    void OnFindPrevious();
+
+    /// Handler for the find toolbar filter check box
+    /// \param isFilterMode true iff only the matched items should be shown
+    void OnFindFilterModeChanged(bool isFilterMode);
+
+    /// Handler for the find results timer. Adds the matches published by the search thread to the tables and the timeline
+    void OnFindResultsTimer();
+
+    /// Handler for the load timer. Handles the records published by the trace loader for a time slice, and moves on to the
+    /// next trace file of the session once the current one is loaded
+    void OnLoadTimer();
+
 private:
+    /// The trace files of a session, in the order they are loaded
+    enum LoadStage
+    {
+        LOAD_STAGE_NONE,                ///< no trace file is being loaded
+        LOAD_STAGE_TRACE_FILE,          ///< the .atp file
+        LOAD_STAGE_SYMBOL_FILE,         ///< the .st file, when the .atp file has no symbol info
+        LOAD_STAGE_PERF_MARKER_FILE     ///< the .clperfmarker file, when the .atp file has no perf markers
+    };
+
     /// struct that holds the queue, data transfer and kernel execution branches
     struct OCLQueueBranchInfo
     {
@@ -203,20 +252,53 @@ private:
         }
     };
 
+    /// Asks for the CSV file path, and starts exporting rows of a trace table on the export thread
+    /// \param pTraceTable the exported table
+    /// \param columns the exported columns, in the written order
+    /// \param storeRows the column store rows of the exported items, in the written order
+    void StartExportToCSV(TraceTable* pTraceTable, const std::vector<int>& columns, std::vector<quint32>& storeRows);
+
+    /// Cancels the running CSV export, and hides its progress
+    void CancelExportToCSV();
+
     /// Gets the host timeline branch for the give thread and API
     /// \param threadId the thread id whose host timeline branch is needed
     /// \param strAPIName the API whose host timeline branch is needed
     /// \return the timeline branch for the given thread and API
     acTimelineBranch* GetHostBranchForAPI(osThreadId threadId, const QString& strAPIName);
 
-    /// Loads the Trace GPUSessionTreeItemData from the specified .atp file
-    /// \param the .atp file to load into the session view
-    /// \return true if successful, false otherwise
-    bool LoadSessionUsingBackendParser(const osFilePath& sessionFile);
+    /// Starts loading a trace file of the session on a background thread. The published records are handled by the load timer
+    /// \param traceFilePath the trace file to load into the session view
+    /// \return true iff the load was started
+    bool StartLoadingTraceFile(const osFilePath& traceFilePath);
+
+    /// Starts loading the next trace file of the session. Once all the trace files are loaded, populates the view, and shows
+    /// the requested inner page
+    void LoadNextTraceFile();
+
+    /// Stops the running trace file load, and discards the records that were not handled yet
+    void CancelLoading();
+
+    /// Shows an inner page of the loaded session
+    /// \param sessionInnerPage the item type describing the inner view to show
+    void ShowSessionInnerPage(afTreeItemType sessionInnerPage);
+
+    /// Handles a record of the trace file, either parsed or read from the session index
+    /// \param record the record to handle
+    void HandleTraceIndexRecord(const gpTraceIndexRecord& record);
+
+    /// Adds an API call that is not loaded in full detail to the aggregate timeline item of its host branch and time bucket
+    /// \param record the CL or HSA API record
+    void AddAggregatedAPICall(const gpTraceIndexRecord& record);
+
+    /// Loads the API calls of an aggregate timeline item in full detail from the session index. The item draws the calls in place
+    /// of the aggregate block, and the calls are inserted to the trace table of their thread
+    /// \param pAggregateItem the aggregate timeline item
+    void ExpandAggregateTimelineItem(APIAggregateTimelineItem* pAggregateItem);
 
     /// Handle the specified CLAPIInfo instance supplied by the .atp file parser. Adds an item to the timeline and api trace list
-    /// \param pApiInfo the CLAPIInfo instance to add to the trace/timeline
-    void HandleCLAPIInfo(ICLAPIInfoDataHandler* pApiInfo);
+    /// \param clApiRecord the CL API record to add to the trace/timeline
+    void HandleCLAPIInfo(const gpTraceCLAPIRecord& clApiRecord);
 
     /// Initializes or creates branch info for the requested queue:
     /// \param contextId the id of the context for which the branch is created
@@ -227,16 +309,16 @@ private:
     OCLQueueBranchInfo* GetBranchInfo(unsigned int contextId, unsigned int queueId, const QString& strContextHandle, const QString& deviceNameStr, const QString& strQueueHandle);
 
     /// Handle the specified HSAAPIInfo instance supplied by the .atp file parser. Adds an item to the timeline and api trace list
-    /// \param pApiInfo the HSAAPIInfo instance to add to the trace/timeline
-    void HandleHSAAPIInfo(IHSAAPIInfoDataHandler* pApiInfo);
+    /// \param hsaApiRecord the HSA API record to add to the trace/timeline
+    void HandleHSAAPIInfo(const gpTraceHSAAPIRecord& hsaApiRecord);
 
     /// Handle the specified SymbolFileEntry instance supplied by the .atp file parser. Stores the symbol info for use when navigating to source
-    /// \param pSymFileEntry the SymbolFileEntry instance begin added
-    void HandleSymFileEntry(ISymbolFileEntryInfoDataHandler* pSymFileEntry);
+    /// \param symbolRecord the symbol record being added
+    void HandleSymFileEntry(const gpTraceSymbolRecord& symbolRecord);
 
     /// Handle the specified PerfMarkerEntry instance supplied by the .atp file parser. Adds the perf markers to the timeline
-    /// \param pPerfMarkerEntry the CLPerfMarkerEntry instance begin added
-    void HandlePerfMarkerEntry(IPerfMarkerInfoDataHandler* pPerfMarkerEntry);
+    /// \param perfMarkerRecord the perf marker record being added
+    void HandlePerfMarkerEntry(const gpTracePerfMarkerRecord& perfMarkerRecord);
 
     /// After parsing is done, populate the view with the data collected by the parser
     void DoneParsingATPFile();
@@ -252,6 +334,23 @@ private:
     /// Clears the timeline and trace table
     void Clear();
 
+    /// Starts indexing the trace tables for the find toolbar
+    void StartTraceSearchIndexing();
+
+    /// Clears the find matches from the trace tables and the timeline
+    void ClearFindMatches();
+
+    /// Selects a find match in its trace table, and zooms to it in the timeline
+    /// \param matchIndex the index of the match
+    void ShowFindMatch(int matchIndex);
+
+    /// Sets the filter mode of the trace tables
+    /// \param isFiltered true to show only the matched items
+    void SetTablesFilterMode(bool isFiltered);
+
+    /// Updates the find toolbar status with the state of the current query
+    void UpdateFindStatus();
+
     /// Helper to get the symbol info for the API specified by threadId and callIndex
     /// \param threadId the thread Id of the API
     /// \param callIndex the call index of the API
@@ -277,11 +376,6 @@ private:
     /// \param pItem the item to display
     void DisplayItemInPropertiesView(acTimelineItem* pItem);
 
-    /// Checks whether the parser should be stopped due to too many api calls
-    /// \param curEndTime the end time of the item being parsed
-    /// \return true if the parser should stop, false otherwise
-    bool CheckStopParsing(quint64 curEndTime);
-
     /// Adds the data transfer branch based on uniqueness of the src and dest
     /// \param[in] srcHandle source string of the HSA data transfer
     /// \param[in] srcName source string of the HSA data transfer
@@ -303,7 +397,7 @@ private:
     QTabWidget*                              m_pTraceTabView;           ///< Tab widget for table and summary view
     SummaryView*                             m_pSummaryView;            ///< SummaryView control
 
-    //    FindToolBarView*                         m_findToolBar;            ///< Find toolbar
+    FindToolBarView*                         m_pFindToolBar;            ///< Find toolbar
     QMenu*                                   m_pTraceTableContextMenu;  ///< Context menu for trace table
     QAction*                                 m_pGotoSourceAction;       ///< Goto Source menu item action
     QAction*                                 m_pZoomInTimelineAction;   ///< Zoom item in timeline
@@ -312,10 +406,15 @@ private:
     QAction*                                 m_pCopyAction;             ///< Copy action
     QAction*                                 m_pSelectAllAction;        ///< Select all action
     QAction*                                 m_pExportToCSVAction;      ///< Export to csv action
+    QAction*                                 m_pExportVisibleRowsToCSVAction; ///< Export visible rows to csv action
+    QAction*                                 m_pExportTimeRangeToCSVAction; ///< Export selected timeline range to csv action
+    QAction*                                 m_pCancelExportToCSVAction; ///< Cancel csv export action
+    QAction*                                 m_pCompareWithSessionAction; ///< Compare with session action
     QHBoxLayout*                             m_pMainLayout;             ///< Main layout
 
     SymbolInfo*                              m_pSymbolInfo;             ///< symbol info cached when context menu is shown
-    CLSummarizer*                            m_pSummarizer;             ///< OpenCL Trace Summarizer
+    CLSummarizer*                            m_pSummarizer;             ///< Tracks the summary pages written by the backend, which are session files
+    gpTraceSummarizer                        m_traceSummarizer;         ///< Computes the summary pages from the parsed trace records
 
     // members used by new parser code
     QMap<osThreadId, acTimelineBranch*>      m_hostBranchMap;           ///< map from thread id to the host timeline branch for that thread
@@ -343,15 +442,31 @@ private:
 
     bool m_areTimelinePropertiesSet;
 
-    unsigned int m_parseCallsCounter;                                   /// <Is used to count the amount of parse calls, so that we will update the UI only every 1000 calls
-
-    bool m_alreadyDisplayedAPILimitMessage;                             /// <Flag indicating whether or not we've already displayed the api limit message for this session
-    bool m_shouldStopParsing;                                           /// <Flag indicating whether or not we should stop parsing. (We parse until we exceed a pre-defined limit, and then ask the user if we should continue)
-    quint64 m_maxTimestampWhenParsingStopped;                           /// <The max end timestamp for the timeline -- used to know where parsing stopped when the API limit was reached
+    unsigned int m_detailedRecordsCount;                                /// <The number of records loaded in full detail. Past s_MAX_TRACE_ENTRIES, API calls with no device work are aggregated
+    QMap<QPair<acTimelineBranch*, quint64>, APIAggregateTimelineItem*> m_aggregateItemsMap; /// <map from host branch and time bucket to the aggregate item of the bucket, until the items are added to the timeline
 
     APIToTrace                              m_api;                      /// < API type for the currently loaded session
+    gpTraceLoader*                          m_pTraceLoader;             ///< loads the current trace file on a background thread, nullptr when no file is loaded
+    QTimer*                                 m_pLoadTimer;               ///< handles the records published by the trace loader from the event loop
+    LoadStage                               m_loadStage;                ///< the trace file of the session being loaded
+    afTreeItemType                          m_loadSessionInnerPage;     ///< the inner page shown once the session is loaded
     bool m_isProgressRangeSet;                                          /// < true iff the progress range from the backend parser is already set
     std::string                             m_currentProgressMessage;   /// Store the current message presneted in the progress bar and dialog
+
+    gpTraceSearch                           m_traceSearch;              ///< indexes the trace tables, and runs the find toolbar queries
+    QTimer*                                 m_pFindResultsTimer;        ///< polls the search thread for matches while a query runs
+    std::vector<TraceTable*>                m_findTables;               ///< the searched trace tables, by their search table index
+    std::vector<gpTraceSearchMatch>         m_findMatches;              ///< the matches of the current query
+    int                                     m_currentFindMatch;         ///< the index of the shown match, -1 if no match is shown
+    unsigned int                            m_findSearchTimeMs;         ///< the time the current query took
+    gpTraceSearch::SearchState              m_findSearchState;          ///< the state of the current query
+    std::vector<std::pair<acTimelineItem*, QColor> > m_highlightedTimelineItems; ///< the highlighted timeline items, and their original background color
+
+    gpTraceCSVExporter                      m_csvExporter;              ///< exports trace table rows to CSV files on a background thread
+    QTimer*                                 m_pExportToCSVTimer;        ///< polls the export thread while an export runs
+    bool                                    m_isTimeRangeSelected;      ///< true iff a timeline item was clicked, and its time range can be exported
+    quint64                                 m_selectedRangeStartTime;   ///< the start time of the last clicked timeline item
+    quint64                                 m_selectedRangeEndTime;     ///< the end time of the last clicked timeline item
 };
 
 #endif // _TRACEVIEW_H_
@@ -114,6 +114,23 @@ void gpBaseSessionView::OnTabClose(int index)
                 m_codeViewerTabIndex--;
             }
         }
+        else
+        {
+            // Any other closable tab (i.e. a session comparison) is owned by the tab widget:
+            QWidget* pTabWidget = m_pSessionTabWidget->widget(index);
+            m_pSessionTabWidget->removeTab(index);
+            SAFE_DELETE(pTabWidget);
+
+            if (m_codeViewerTabIndex > index)
+            {
+                m_codeViewerTabIndex--;
+            }
+
+            if (m_kernelOccupancyTabIndex > index)
+            {
+                m_kernelOccupancyTabIndex--;
+            }
+        }
     }
 }
 
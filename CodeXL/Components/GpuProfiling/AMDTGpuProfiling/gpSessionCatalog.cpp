@@ -0,0 +1,163 @@
+//=============================================================
+// Copyright (c) 2016-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+/// \author GPU Developer Tools
+/// \file
+/// \brief Per-project catalog of the GPU profile sessions, used to populate the session tree without scanning every session directory
+//=============================================================
+
+#include <qtIgnoreCompilerWarnings.h>
+#include <QtCore>
+
+// Local:
+#include <AMDTGpuProfiling/gpSessionCatalog.h>
+#include <AMDTGpuProfiling/gpStringConstants.h>
+
+gpSessionCatalog::gpSessionCatalog() : m_profilesDirModifiedTime(0)
+{
+}
+
+bool gpSessionCatalog::Load(const QString& profilesDirPath)
+{
+    bool retVal = false;
+
+    m_profilesDirModifiedTime = 0;
+    m_entries.clear();
+
+    QFile catalogFile(GetCatalogFilePath(profilesDirPath));
+
+    if (catalogFile.open(QIODevice::ReadOnly))
+    {
+        QDataStream stream(&catalogFile);
+        stream.setByteOrder(QDataStream::LittleEndian);
+        stream.setVersion(QDataStream::Qt_5_0);
+
+        quint32 magic = 0;
+        quint32 formatVersion = 0;
+        quint32 entriesCount = 0;
+        stream >> magic >> formatVersion >> m_profilesDirModifiedTime >> entriesCount;
+
+        retVal = (stream.status() == QDataStream::Ok) && (magic == ms_magic) && (formatVersion == ms_formatVersion);
+
+        for (quint32 i = 0; retVal && (i < entriesCount); i++)
+        {
+            gpSessionCatalogEntry entry;
+            qint32 profileType = 0;
+            stream >> entry.m_sessionDirName >> entry.m_sessionDirModifiedTime >> entry.m_sessionFileName >> entry.m_sessionFileModifiedTime >> profileType
+                   >> entry.m_exeName >> entry.m_workingDirectory >> entry.m_envVariables >> entry.m_occupancyFileName >> entry.m_additionalFileNames;
+            entry.m_profileType = profileType;
+
+            retVal = (stream.status() == QDataStream::Ok);
+
+            if (retVal)
+            {
+                m_entries.push_back(entry);
+            }
+        }
+
+        if (!retVal)
+        {
+            m_profilesDirModifiedTime = 0;
+            m_entries.clear();
+        }
+    }
+
+    return retVal;
+}
+
+bool gpSessionCatalog::Save(const QString& profilesDirPath)
+{
+    QString catalogFilePath = GetCatalogFilePath(profilesDirPath);
+
+    m_profilesDirModifiedTime = GetModifiedTime(profilesDirPath);
+    bool retVal = Write(catalogFilePath);
+
+    // Creating the catalog file modifies the directory. Rewriting the existing file in place does not:
+    qint64 profilesDirModifiedTime = GetModifiedTime(profilesDirPath);
+
+    if (retVal && (profilesDirModifiedTime != m_profilesDirModifiedTime))
+    {
+        m_profilesDirModifiedTime = profilesDirModifiedTime;
+        retVal = Write(catalogFilePath);
+    }
+
+    return retVal;
+}
+
+bool gpSessionCatalog::IsComplete(const QString& profilesDirPath) const
+{
+    return (m_profilesDirModifiedTime != 0) && (m_profilesDirModifiedTime == GetModifiedTime(profilesDirPath));
+}
+
+bool gpSessionCatalog::IsEntryValid(const gpSessionCatalogEntry& entry, const QString& sessionDirPath)
+{
+    bool retVal = (entry.m_sessionDirModifiedTime != 0) && (entry.m_sessionDirModifiedTime == GetModifiedTime(sessionDirPath));
+
+    if (retVal)
+    {
+        // Renaming a session rewrites the properties section of the session file, which does not modify the directory:
+        retVal = (entry.m_sessionFileModifiedTime == GetModifiedTime(QDir(sessionDirPath).filePath(entry.m_sessionFileName)));
+    }
+
+    return retVal;
+}
+
+const gpSessionCatalogEntry* gpSessionCatalog::FindEntry(const QString& sessionDirName) const
+{
+    const gpSessionCatalogEntry* pRetVal = nullptr;
+
+    for (const gpSessionCatalogEntry& entry : m_entries)
+    {
+        if (entry.m_sessionDirName == sessionDirName)
+        {
+            pRetVal = &entry;
+            break;
+        }
+    }
+
+    return pRetVal;
+}
+
+qint64 gpSessionCatalog::GetModifiedTime(const QString& path)
+{
+    QFileInfo fileInfo(path);
+    return fileInfo.exists() ? fileInfo.lastModified().toMSecsSinceEpoch() : 0;
+}
+
+QString gpSessionCatalog::GetCatalogFilePath(const QString& profilesDirPath)
+{
+    return QDir(profilesDirPath).filePath(GP_SessionCatalogFileName);
+}
+
+bool gpSessionCatalog::Write(const QString& catalogFilePath) const
+{
+    bool retVal = false;
+
+    QFile catalogFile(catalogFilePath);
+
+    if (catalogFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        QDataStream stream(&catalogFile);
+        stream.setByteOrder(QDataStream::LittleEndian);
+        stream.setVersion(QDataStream::Qt_5_0);
+
+        stream << ms_magic << ms_formatVersion << m_profilesDirModifiedTime << static_cast<quint32>(m_entries.size());
+
+        for (const gpSessionCatalogEntry& entry : m_entries)
+        {
+            stream << entry.m_sessionDirName << entry.m_sessionDirModifiedTime << entry.m_sessionFileName << entry.m_sessionFileModifiedTime << static_cast<qint32>(entry.m_profileType)
+                   << entry.m_exeName << entry.m_workingDirectory << entry.m_envVariables << entry.m_occupancyFileName << entry.m_additionalFileNames;
+        }
+
+        retVal = (stream.status() == QDataStream::Ok) && catalogFile.flush();
+        catalogFile.close();
+
+        if (!retVal)
+        {
+            // A partially written catalog is read as invalid, but there is no reason to keep it:
+            catalogFile.remove();
+        }
+    }
+
+    return retVal;
+}
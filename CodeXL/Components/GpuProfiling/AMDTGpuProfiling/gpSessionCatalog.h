@@ -0,0 +1,99 @@
+//=============================================================
+// Copyright (c) 2016-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+/// \author GPU Developer Tools
+/// \file
+/// \brief Per-project catalog of the GPU profile sessions, used to populate the session tree without scanning every session directory
+//=============================================================
+
+#ifndef __GPSESSIONCATALOG_H
+#define __GPSESSIONCATALOG_H
+
+// std
+#include <vector>
+
+// Qt
+#include <qtIgnoreCompilerWarnings.h>
+#include <QString>
+#include <QStringList>
+
+/// A session recorded in the session catalog
+struct gpSessionCatalogEntry
+{
+    QString m_sessionDirName;               ///< the name of the session directory
+    qint64 m_sessionDirModifiedTime;        ///< the modification time of the session directory (msecs since epoch)
+    QString m_sessionFileName;              ///< the name of the session output file (.atp or .csv), in the session directory
+    qint64 m_sessionFileModifiedTime;       ///< the modification time of the session output file (msecs since epoch)
+    int m_profileType;                      ///< the GPUProfileType of the session
+    QString m_exeName;                      ///< the executable name read from the session file properties
+    QString m_workingDirectory;             ///< the working directory, as set from the session file properties
+    QString m_envVariables;                 ///< the environment variables read from the session file properties
+    QString m_occupancyFileName;            ///< the name of the occupancy file, in the session directory (empty if none)
+    QStringList m_additionalFileNames;      ///< the names of the additional files, in the session directory
+
+    gpSessionCatalogEntry() : m_sessionDirModifiedTime(0), m_sessionFileModifiedTime(0), m_profileType(0) {}
+};
+
+/// The catalog of the sessions of a project, stored in the project profile output directory.
+/// A catalog entry is valid while the modification times of its session directory and session file are unchanged,
+/// and the list of entries is complete while the modification time of the profile output directory is unchanged
+class gpSessionCatalog
+{
+public:
+    /// The catalog file magic ("GPSC")
+    static const quint32 ms_magic = 0x43535047;
+
+    /// The catalog file format version
+    static const quint32 ms_formatVersion = 1;
+
+    gpSessionCatalog();
+
+    /// Loads the catalog of a profile output directory
+    /// \param profilesDirPath the profile output directory
+    /// \return false if there is no catalog, or it could not be read. The catalog is then empty
+    bool Load(const QString& profilesDirPath);
+
+    /// Saves the catalog to a profile output directory, and stamps it with the modification time of the directory
+    /// \param profilesDirPath the profile output directory
+    /// \return true iff the catalog was saved
+    bool Save(const QString& profilesDirPath);
+
+    /// Checks if the session directories of a profile output directory are the catalog entries
+    /// \param profilesDirPath the profile output directory
+    /// \return true iff the directory was not modified since the catalog was saved
+    bool IsComplete(const QString& profilesDirPath) const;
+
+    /// Checks if an entry is still valid for its session directory
+    /// \param entry the entry
+    /// \param sessionDirPath the session directory path
+    /// \return true iff the session directory and session file were not modified since the entry was recorded
+    static bool IsEntryValid(const gpSessionCatalogEntry& entry, const QString& sessionDirPath);
+
+    /// Finds the entry of a session directory
+    /// \param sessionDirName the name of the session directory
+    /// \return the entry, or null if there is none
+    const gpSessionCatalogEntry* FindEntry(const QString& sessionDirName) const;
+
+    /// \return the entries, ordered as the sessions appear in the session tree
+    const std::vector<gpSessionCatalogEntry>& GetEntries() const { return m_entries; }
+
+    /// Appends an entry
+    /// \param entry the entry
+    void AddEntry(const gpSessionCatalogEntry& entry) { m_entries.push_back(entry); }
+
+    /// \return the modification time (msecs since epoch) of a file or directory, 0 if it does not exist
+    static qint64 GetModifiedTime(const QString& path);
+
+private:
+    /// \return the path of the catalog file of a profile output directory
+    static QString GetCatalogFilePath(const QString& profilesDirPath);
+
+    /// Writes the catalog file
+    /// \return true iff the file was written
+    bool Write(const QString& catalogFilePath) const;
+
+    qint64 m_profilesDirModifiedTime;               ///< the modification time of the profile output directory when the catalog was saved
+    std::vector<gpSessionCatalogEntry> m_entries;   ///< the entries
+};
+
+#endif // __GPSESSIONCATALOG_H
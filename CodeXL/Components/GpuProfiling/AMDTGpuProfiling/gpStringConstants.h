@@ -215,6 +215,11 @@
 #define GPU_STR_TraceViewZoomTimeline "&Show in timeline"
 #define GPU_STR_TraceViewExpandAll "&Expand all"
 #define GPU_STR_TraceViewCollapseAll "Co&llapse all"
+#define GPU_STR_TraceViewExportVisibleRowsToCSV "Export &visible rows to CSV"
+#define GPU_STR_TraceViewExportTimeRangeToCSV "Export selected &timeline range to CSV"
+#define GPU_STR_TraceViewCancelExportToCSV "Cancel CSV e&xport"
+#define GPU_STR_TraceViewExportingToCSV "Exporting %1 rows to CSV..."
+#define GPU_STR_TraceViewExportToCSVFailed "Failed to write the CSV file:\n%1"
 #define GPU_STR_TraceViewCpuDevice "CPU_Device"
 #define GPU_STR_TraceViewOpenCL "OpenCL"
 #define GPU_STR_TraceViewHSA "HSA"
@@ -223,6 +228,106 @@
 #define GPU_STR_TraceViewQueueRow "Queue %1 - %2 (%3)"
 #define GPU_STR_HSATraceViewQueueRow "Queue %1 - Device %2 (%3)"
 
+// Trace view find toolbar:
+#define GPU_STR_TraceSearchAPIField "api:"
+#define GPU_STR_TraceSearchArgumentField "arg:"
+#define GPU_STR_TraceSearchThreadField "thread:"
+#define GPU_STR_TraceSearchDurationField "dur:"
+#define GPU_STR_TraceSearchPlaceholder "Text, or api:<name> arg:<value> thread:<id> dur:<min>..<max> (e.g. api:clEnqueueNDRangeKernel dur:>1ms)"
+#define GPU_STR_TraceSearchInvalidDuration "Invalid duration: %1"
+#define GPU_STR_TraceSearchInvalidRegex "Invalid regular expression: %1"
+#define GPU_STR_TraceSearchBuildingIndex "Indexing the trace..."
+#define GPU_STR_TraceSearchSearching "Searching..."
+#define GPU_STR_TraceSearchNoMatches "No matches"
+#define GPU_STR_TraceSearchMatches "%1 of %2 matches (%3 ms)"
+
+// Trace summary pages:
+#define GPU_STR_TraceSummaryColumnAPIName "API Name"
+#define GPU_STR_TraceSummaryColumnCalls "# of Calls"
+#define GPU_STR_TraceSummaryColumnTotalTime "Total Time(ms)"
+#define GPU_STR_TraceSummaryColumnPercentOfTime "% of Time"
+#define GPU_STR_TraceSummaryColumnAvgTime "Avg Time(ms)"
+#define GPU_STR_TraceSummaryColumnMaxTime "Max Time(ms)"
+#define GPU_STR_TraceSummaryColumnMinTime "Min Time(ms)"
+#define GPU_STR_TraceSummaryColumnContextId "Context ID"
+#define GPU_STR_TraceSummaryColumnQueue "Queue"
+#define GPU_STR_TraceSummaryColumnDevice "Device"
+#define GPU_STR_TraceSummaryColumnKernelDispatches "# of Kernel Dispatches"
+#define GPU_STR_TraceSummaryColumnKernelTime "Kernel Time(ms)"
+#define GPU_STR_TraceSummaryColumnMemoryTransfers "# of Memory Transfers"
+#define GPU_STR_TraceSummaryColumnMemoryTransferTime "Memory Transfer Time(ms)"
+#define GPU_STR_TraceSummaryColumnMemoryTransferSize "Memory Transfer Size(KB)"
+#define GPU_STR_TraceSummaryColumnOtherCommands "# of Other Commands"
+#define GPU_STR_TraceSummaryColumnKernelName "Kernel Name"
+#define GPU_STR_TraceSummaryColumnThreadId "Thread ID"
+#define GPU_STR_TraceSummaryColumnCallIndex "Call Index"
+#define GPU_STR_TraceSummaryColumnGlobalWorkSize "Global Work Size"
+#define GPU_STR_TraceSummaryColumnWorkGroupSize "Work Group Size"
+#define GPU_STR_TraceSummaryColumnTime "Time(ms)"
+#define GPU_STR_TraceSummaryColumnCommandType "Command Type"
+#define GPU_STR_TraceSummaryColumnSize "Size(KB)"
+#define GPU_STR_TraceSummaryColumnRate "Rate(GB/s)"
+#define GPU_STR_TraceSummaryColumnType "Type"
+#define GPU_STR_TraceSummaryColumnMessage "Message"
+#define GPU_STR_TraceSummaryError "Error"
+#define GPU_STR_TraceSummaryWarning "Warning"
+#define GPU_STR_TraceSummaryAPIError "%1 returned %2"
+#define GPU_STR_TraceSummaryBlockingTransfer "%1 blocks the host until the transfer ends. Use a non-blocking call and wait for its event only when the data is needed"
+#define GPU_STR_TraceSummaryRuntimeWorkGroupSize "The work-group size of kernel %1 is chosen by the runtime. Set it explicitly, to a multiple of %2"
+#define GPU_STR_TraceSummaryWorkGroupSizeNotMultiple "The work-group size of kernel %1 (%2) is not a multiple of the wavefront size (%3)"
+#define GPU_STR_TraceSummarySmallTransfer "%1 transfers only %2 bytes. Batch small transfers, to reduce the per-transfer overhead"
+#define GPU_STR_TraceSummaryDeprecatedAPI "%1 is deprecated in recent versions of OpenCL"
+#define GPU_STR_TraceSummaryRedundantSync "%1 waits for command queue %2, which has no commands since its last synchronization"
+#define GPU_STR_TraceSummaryPersistentMemoryRead "%1 reads buffer %2, which was created with CL_MEM_USE_PERSISTENT_MEM_AMD. The CPU reads host-visible device memory slowly. Copy it to a host buffer on the device first, or create it without this flag"
+#define GPU_STR_TraceSummaryResourceLeak "%1 created by %2 is never released"
+#define GPU_STR_TraceSummaryHiddenMessages "%1 more messages are not shown"
+#define GPU_STR_TraceSummarySelectedRangeOnly "Selected timeline item only"
+#define GPU_STR_TraceSummarySelectedRangeTooltip "Summarize only the calls and commands which overlap the time range of the timeline item selected last"
+#define GPU_STR_TraceSummaryWholeTraceRange "Whole trace (%1 ms)"
+#define GPU_STR_TraceSummaryRange "%1 ms - %2 ms (%3 ms)"
+#define GPU_STR_TraceSummaryNoSelectedRange "Select a timeline item"
+#define GPU_STR_TraceSummaryRowLinkTooltip "Double click to show the call in the timeline or trace view"
+
+// Trace session comparison:
+#define GPU_STR_TraceViewCompareWithSession "Co&mpare with session..."
+#define GPU_STR_TraceComparisonSelectBaseline "Select the Baseline Trace to Compare With"
+#define GPU_STR_TraceComparisonTraceFileFilter "Application Trace Files (*.atp)"
+#define GPU_STR_TraceComparisonTabCaption "Comparison with %1"
+#define GPU_STR_TraceComparisonSessions "Baseline: %1    Current: %2"
+#define GPU_STR_TraceComparisonThreshold "Regression threshold:"
+#define GPU_STR_TraceComparisonThresholdTooltip "Flag the APIs and kernels whose average time grew by more than this percentage"
+#define GPU_STR_TraceComparisonLoadingBaseline "Loading the baseline trace... %1%"
+#define GPU_STR_TraceComparisonLoadingCurrent "Loading the current trace... %1%"
+#define GPU_STR_TraceComparisonFailed "Failed to load the compared traces"
+#define GPU_STR_TraceComparisonCanceled "The comparison was canceled"
+#define GPU_STR_TraceComparisonResult "%1 regressions, %2 new and %3 missing APIs and kernels. %4 of %5 threads call the APIs in the same sequence (%6 new calls, %7 missing calls)"
+#define GPU_STR_TraceComparisonAPIsPage "APIs"
+#define GPU_STR_TraceComparisonKernelsPage "Kernels"
+#define GPU_STR_TraceComparisonThreadsPage "Threads"
+#define GPU_STR_TraceComparisonColumnStatus "Status"
+#define GPU_STR_TraceComparisonColumnBaselineCalls "Baseline # of Calls"
+#define GPU_STR_TraceComparisonColumnCurrentCalls "Current # of Calls"
+#define GPU_STR_TraceComparisonColumnBaselineDispatches "Baseline # of Dispatches"
+#define GPU_STR_TraceComparisonColumnCurrentDispatches "Current # of Dispatches"
+#define GPU_STR_TraceComparisonColumnCountDelta "Count Delta"
+#define GPU_STR_TraceComparisonColumnBaselineTotalTime "Baseline Total Time(ms)"
+#define GPU_STR_TraceComparisonColumnCurrentTotalTime "Current Total Time(ms)"
+#define GPU_STR_TraceComparisonColumnTotalTimeDelta "Total Time Delta(ms)"
+#define GPU_STR_TraceComparisonColumnBaselineAvgTime "Baseline Avg Time(ms)"
+#define GPU_STR_TraceComparisonColumnCurrentAvgTime "Current Avg Time(ms)"
+#define GPU_STR_TraceComparisonColumnAvgTimeDelta "Avg Time Delta(%)"
+#define GPU_STR_TraceComparisonColumnNewCalls "New Calls"
+#define GPU_STR_TraceComparisonColumnMissingCalls "Missing Calls"
+#define GPU_STR_TraceComparisonColumnBaselineThreadId "Baseline Thread ID"
+#define GPU_STR_TraceComparisonColumnCurrentThreadId "Current Thread ID"
+#define GPU_STR_TraceComparisonColumnMatchedCalls "Aligned Calls"
+#define GPU_STR_TraceComparisonColumnFirstDivergence "First Divergence"
+#define GPU_STR_TraceComparisonFirstDivergence "Baseline call %1, current call %2"
+#define GPU_STR_TraceComparisonStatusNew "New"
+#define GPU_STR_TraceComparisonStatusMissing "Missing"
+#define GPU_STR_TraceComparisonStatusRegression "Regression"
+#define GPU_STR_TraceComparisonStatusSequenceChanged "Sequence changed"
+
 // Trace table captions
 #define GP_STR_TraceTableColumnIndex "Index"
 #define GP_STR_TraceTableColumnInterface "Interface"
@@ -246,6 +351,8 @@
 #define GPU_STR_TraceViewLoadingAPITimelineItems L"Loading API items to timeline..."
 #define GPU_STR_TraceViewLoadingGPUTimelineItems L"Loading GPU items to timeline..."
 #define GPU_STR_TraceViewLoadingPerfMarkersTimelineItems L"Loading Performance Markers to timeline..."
+#define GPU_STR_TraceViewLoadingSessionIndexProgress "Loading trace data from session index..."
+#define GPU_STR_TraceViewAggregatedAPICalls "%1 API calls"
 
 // Profile Manager error messages
 #define GPU_STR_ERR_NoCountersSelected "Unable to profile. At least one counter needs to be selected.\nCounter selection can be modified in the Project Settings dialog."
@@ -254,8 +361,7 @@
 #define GPU_STR_ERR_FileMissing        "Unable to profile. The specified %1 does not exist: \n%2"
 
 // User messages:
-#define GPU_STR_APICallsAmountExceedsTheLimitQuestion "The session contains more than %1 API calls.\n" \
-    "Do you want to analyze only the first %1 API calls (recommended for performance reasons)?\n Selecting 'No' will analyze all API calls."
+#define GPU_STR_TraceViewAggregateIndexMissing "The API calls of this item cannot be loaded in full detail, because the session index of the trace file is missing or out of date:\n%1\nReopen the session to rebuild the session index."
 
 /// CSV export file names:
 #define GPU_CSV_FileNameFormat "CodeXL%1_%2"
@@ -289,6 +395,9 @@
 #define GP_HTML_FileExtensionW L"html"
 #define GP_Occupancy_FileExtensionW L"occupancy"
 
+/// The session catalog file, in the project profile output directory
+#define GP_SessionCatalogFileName "GpuProfileSessions.catalog"
+
 // Process Monitor Types
 #define GPU_STR_ProcessMonitorRunType_Profile L"GPU profile in progress"
 #define GPU_STR_ProcessMonitorRunType_GenSummary L"Generating Summary Pages"
@@ -312,5 +421,7 @@
 #define GPU_STR_timeline_ContextBranchNameWithParam "Queue %1 - %2 (%3)"
 
 #define GPU_STR_APITimeline_TimeTooltipLine "Time: %3 - %4 (%5)"
+#define GPU_STR_APITimeline_AggregateExpandHint "Click to load these API calls in full detail"
+#define GPU_STR_APITimeline_AggregateExpandedNote "These API calls are loaded in full detail, and listed in the API trace table"
 
 #endif //__GPSTRINGCONSTANTS_H
@@ -0,0 +1,216 @@
+//=============================================================
+// Copyright (c) 2016-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+/// \author GPU Developer Tools
+/// \file
+/// \brief Exports trace table rows to a CSV file on a background thread
+//=============================================================
+
+#include <qtIgnoreCompilerWarnings.h>
+#include <QtCore>
+
+// std
+#include <algorithm>
+#include <cstring>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtAssert.h>
+
+// Local:
+#include <AMDTGpuProfiling/gpTraceCSVExporter.h>
+#include "TraceTable.h"
+
+/// The initial capacity of a chunk buffer, per row. The buffers grow as needed, and are reused from chunk to chunk
+static const size_t s_INITIAL_BYTES_PER_ROW = 160;
+
+gpTraceCSVExporter::gpTraceCSVExporter() :
+    m_pModel(nullptr), m_isCancelRequested(false), m_state(EXPORT_STATE_IDLE), m_exportedRowsCount(0)
+{
+}
+
+gpTraceCSVExporter::~gpTraceCSVExporter()
+{
+    Cancel();
+}
+
+bool gpTraceCSVExporter::Start(const QString& outputFilePath, const std::vector<int>& columns, const QStringList& columnHeaders, const TraceTableModel* pModel, std::vector<quint32>& storeRows)
+{
+    bool retVal = false;
+
+    if (!IsRunning())
+    {
+        // The previous export thread is done, but may not have been joined yet:
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+
+        m_outputFilePath = outputFilePath;
+        m_columns = columns;
+        m_columnHeaders = columnHeaders;
+        m_pModel = pModel;
+        m_storeRows.swap(storeRows);
+        storeRows.clear();
+
+        m_isCancelRequested = false;
+        m_exportedRowsCount = 0;
+        m_state = EXPORT_STATE_RUNNING;
+
+        m_thread = std::thread(&gpTraceCSVExporter::ExportThreadFunc, this);
+        retVal = true;
+    }
+
+    return retVal;
+}
+
+void gpTraceCSVExporter::Cancel()
+{
+    if (m_thread.joinable())
+    {
+        m_isCancelRequested = true;
+        m_thread.join();
+    }
+
+    // The model may change once the export is canceled:
+    m_pModel = nullptr;
+    m_storeRows.clear();
+}
+
+gpTraceCSVExporter::ExportState gpTraceCSVExporter::GetState(size_t& exportedRowsCount, size_t& totalRowsCount) const
+{
+    exportedRowsCount = m_exportedRowsCount;
+    totalRowsCount = m_storeRows.size();
+    return static_cast<ExportState>(m_state.load());
+}
+
+void gpTraceCSVExporter::ExportThreadFunc()
+{
+    QFile file(m_outputFilePath);
+
+    // The rows are written in large chunks, so the file is not buffered again:
+    bool isOK = file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered);
+
+    if (isOK)
+    {
+        std::string headersBuffer;
+
+        for (int i = 0; i < m_columnHeaders.size(); i++)
+        {
+            if (i > 0)
+            {
+                headersBuffer.push_back(',');
+            }
+
+            AppendCell(m_columnHeaders[i], headersBuffer);
+        }
+
+        headersBuffer.push_back('\n');
+        isOK = (file.write(headersBuffer.data(), headersBuffer.size()) == static_cast<qint64>(headersBuffer.size()));
+    }
+
+    // Each batch has a chunk per worker. The first chunk is formatted on the export thread:
+    size_t workersCount = std::max(1u, std::thread::hardware_concurrency());
+    size_t rowsCount = m_storeRows.size();
+    std::vector<std::string> buffers(workersCount);
+
+    for (std::string& buffer : buffers)
+    {
+        buffer.reserve(ms_CHUNK_ROWS_COUNT * s_INITIAL_BYTES_PER_ROW);
+    }
+
+    for (size_t batchFirstRow = 0; isOK && !m_isCancelRequested && (batchFirstRow < rowsCount); batchFirstRow += workersCount * ms_CHUNK_ROWS_COUNT)
+    {
+        size_t chunksCount = std::min(workersCount, (rowsCount - batchFirstRow + ms_CHUNK_ROWS_COUNT - 1) / ms_CHUNK_ROWS_COUNT);
+        std::vector<std::thread> workers;
+
+        for (size_t chunk = 1; chunk < chunksCount; chunk++)
+        {
+            size_t firstRow = batchFirstRow + chunk * ms_CHUNK_ROWS_COUNT;
+            size_t endRow = std::min(firstRow + ms_CHUNK_ROWS_COUNT, rowsCount);
+            workers.emplace_back(&gpTraceCSVExporter::FormatRows, this, firstRow, endRow, std::ref(buffers[chunk]));
+        }
+
+        FormatRows(batchFirstRow, std::min(batchFirstRow + ms_CHUNK_ROWS_COUNT, rowsCount), buffers[0]);
+
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+
+        // Write the chunks in the rows order:
+        for (size_t chunk = 0; isOK && !m_isCancelRequested && (chunk < chunksCount); chunk++)
+        {
+            const std::string& buffer = buffers[chunk];
+            isOK = (file.write(buffer.data(), buffer.size()) == static_cast<qint64>(buffer.size()));
+
+            if (isOK)
+            {
+                size_t firstRow = batchFirstRow + chunk * ms_CHUNK_ROWS_COUNT;
+                m_exportedRowsCount = std::min(firstRow + ms_CHUNK_ROWS_COUNT, rowsCount);
+            }
+        }
+    }
+
+    file.close();
+
+    if (!isOK || m_isCancelRequested)
+    {
+        // Do not leave a partial file:
+        file.remove();
+        m_state = isOK ? EXPORT_STATE_CANCELED : EXPORT_STATE_FAILED;
+    }
+    else
+    {
+        m_state = EXPORT_STATE_DONE;
+    }
+}
+
+void gpTraceCSVExporter::FormatRows(size_t firstRow, size_t endRow, std::string& buffer) const
+{
+    buffer.clear();
+
+    for (size_t row = firstRow; row < endRow; row++)
+    {
+        quint32 storeRow = m_storeRows[row];
+        GT_IF_WITH_ASSERT((m_pModel != nullptr) && (storeRow < m_pModel->GetColumnStore().GetRowCount()))
+        {
+            for (size_t i = 0; i < m_columns.size(); i++)
+            {
+                if (i > 0)
+                {
+                    buffer.push_back(',');
+                }
+
+                AppendCell(m_pModel->GetColumnStore().GetColumnData(storeRow, m_columns[i]).toString(), buffer);
+            }
+
+            buffer.push_back('\n');
+        }
+    }
+}
+
+void gpTraceCSVExporter::AppendCell(const QString& text, std::string& buffer)
+{
+    QByteArray utf8Text = text.toUtf8();
+    const char* pText = utf8Text.constData();
+    const char* pTextEnd = pText + utf8Text.size();
+
+    buffer.push_back('"');
+
+    // Copy the text up to each quote, and double the quote:
+    while (pText < pTextEnd)
+    {
+        const char* pQuote = static_cast<const char*>(memchr(pText, '"', pTextEnd - pText));
+        const char* pCopyEnd = (pQuote != nullptr) ? pQuote + 1 : pTextEnd;
+        buffer.append(pText, pCopyEnd - pText);
+
+        if (pQuote != nullptr)
+        {
+            buffer.push_back('"');
+        }
+
+        pText = pCopyEnd;
+    }
+
+    buffer.push_back('"');
+}
@@ -0,0 +1,97 @@
+//=============================================================
+// Copyright (c) 2016-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+/// \author GPU Developer Tools
+/// \file
+/// \brief Exports trace table rows to a CSV file on a background thread
+//=============================================================
+
+#ifndef __GPTRACECSVEXPORTER_H
+#define __GPTRACECSVEXPORTER_H
+
+// std
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Qt
+#include <QString>
+#include <QStringList>
+
+class TraceTableModel;
+
+/// Exports trace table rows to a CSV file on a background thread.
+/// The rows are formatted in chunks, in parallel, into UTF8 buffers which are reused from chunk to chunk,
+/// and the buffers are written to the file in the rows order, one large write per chunk
+class gpTraceCSVExporter
+{
+public:
+    /// The state of the export
+    enum ExportState
+    {
+        EXPORT_STATE_IDLE,          ///< no export was started
+        EXPORT_STATE_RUNNING,       ///< the rows are being exported
+        EXPORT_STATE_DONE,          ///< all the rows were exported
+        EXPORT_STATE_FAILED,        ///< the file could not be written
+        EXPORT_STATE_CANCELED       ///< the export was canceled
+    };
+
+    /// The number of rows formatted by a worker thread at once
+    static const unsigned int ms_CHUNK_ROWS_COUNT = 4096;
+
+    gpTraceCSVExporter();
+    ~gpTraceCSVExporter();
+
+    /// Starts exporting rows on the export thread. The rows are written in the given order.
+    /// The model must not change, and must not be deleted, before the export ends or Cancel is called
+    /// \param outputFilePath the CSV output file path
+    /// \param columns the exported columns (TraceTableModel::TraceTableColIndex), in the written order
+    /// \param columnHeaders the headers of the exported columns
+    /// \param pModel the model holding the exported rows
+    /// \param[in,out] storeRows the column store rows of the exported items. The list is taken by the exporter
+    /// \return false if an export is already running
+    bool Start(const QString& outputFilePath, const std::vector<int>& columns, const QStringList& columnHeaders, const TraceTableModel* pModel, std::vector<quint32>& storeRows);
+
+    /// Cancels the running export, and waits for the export thread to end. The partially written file is removed
+    void Cancel();
+
+    /// Gets the state of the export
+    /// \param[out] exportedRowsCount the number of rows written so far
+    /// \param[out] totalRowsCount the number of exported rows
+    /// \return the export state
+    ExportState GetState(size_t& exportedRowsCount, size_t& totalRowsCount) const;
+
+    /// \return true iff the rows are being exported
+    bool IsRunning() const { return EXPORT_STATE_RUNNING == m_state; }
+
+    /// \return the output file path of the last export
+    const QString& GetOutputFilePath() const { return m_outputFilePath; }
+
+private:
+    /// The export thread function
+    void ExportThreadFunc();
+
+    /// Formats a range of the exported rows
+    /// \param firstRow the first formatted row
+    /// \param endRow the row following the last formatted row
+    /// \param[out] buffer the formatted rows (UTF8). The buffer is cleared first, and keeps its capacity
+    void FormatRows(size_t firstRow, size_t endRow, std::string& buffer) const;
+
+    /// Appends a quoted CSV cell to a buffer
+    /// \param text the cell text. Quotes are doubled
+    /// \param[in,out] buffer the buffer
+    static void AppendCell(const QString& text, std::string& buffer);
+
+    QString m_outputFilePath;                       ///< the CSV output file path
+    std::vector<int> m_columns;                     ///< the exported columns
+    QStringList m_columnHeaders;                    ///< the headers of the exported columns
+    const TraceTableModel* m_pModel;                ///< the model holding the exported rows
+    std::vector<quint32> m_storeRows;               ///< the column store rows of the exported items, in the written order
+    std::thread m_thread;                           ///< the export thread
+    std::atomic<bool> m_isCancelRequested;          ///< true iff the export thread should stop
+    std::atomic<int> m_state;                       ///< the ExportState of the export
+    std::atomic<size_t> m_exportedRowsCount;        ///< the number of rows written so far
+};
+
+#endif // __GPTRACECSVEXPORTER_H
@@ -0,0 +1,355 @@
+//=============================================================
+// Copyright (c) 2016-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+/// \author GPU Developer Tools
+/// \file
+/// \brief Shows the comparison of two trace sessions, per API, per kernel and per thread
+//=============================================================
+
+#include <qtIgnoreCompilerWarnings.h>
+#include <QtCore>
+#include <QtWidgets>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtAssert.h>
+
+// Local:
+#include <AMDTGpuProfiling/gpTraceComparisonView.h>
+#include <AMDTGpuProfiling/gpStringConstants.h>
+#include <AMDTGpuProfiling/CLAPIDefs.h>
+
+/// The role holding the value a cell is sorted by
+static const int s_SORT_ROLE = Qt::UserRole + 1;
+
+/// The number of decimals shown for times and percentages
+static const int s_DECIMALS = 3;
+
+/// Time between two polls of the comparer thread
+static const int s_COMPARE_POLL_INTERVAL_MS = 100;
+
+/// The background colors of the highlighted rows
+static const QColor s_NEW_ROW_COLOR(210, 240, 210);
+static const QColor s_MISSING_ROW_COLOR(225, 225, 225);
+static const QColor s_REGRESSION_ROW_COLOR(255, 205, 205);
+static const QColor s_SEQUENCE_CHANGED_ROW_COLOR(255, 240, 200);
+
+/// \return the milliseconds of a duration in nanoseconds
+static double ToMilliseconds(double duration)
+{
+    return duration / 1000000.0;
+}
+
+gpTraceComparisonView::gpTraceComparisonView(QWidget* pParent) :
+    QWidget(pParent),
+    m_pCompareTimer(nullptr),
+    m_pSessionsLabel(nullptr),
+    m_pResultLabel(nullptr),
+    m_pThresholdSpinBox(nullptr),
+    m_pPagesTabWidget(nullptr)
+{
+    m_pSessionsLabel = new QLabel(this);
+    m_pResultLabel = new QLabel(this);
+    m_pResultLabel->setWordWrap(true);
+
+    m_pThresholdSpinBox = new QSpinBox(this);
+    m_pThresholdSpinBox->setRange(0, 1000);
+    m_pThresholdSpinBox->setSuffix("%");
+    m_pThresholdSpinBox->setValue(ms_DEFAULT_REGRESSION_THRESHOLD_PERCENT);
+    m_pThresholdSpinBox->setToolTip(GPU_STR_TraceComparisonThresholdTooltip);
+
+    QHBoxLayout* pHeaderLayout = new QHBoxLayout;
+    pHeaderLayout->addWidget(m_pSessionsLabel);
+    pHeaderLayout->addStretch();
+    pHeaderLayout->addWidget(new QLabel(GPU_STR_TraceComparisonThreshold, this));
+    pHeaderLayout->addWidget(m_pThresholdSpinBox);
+
+    m_pPagesTabWidget = new QTabWidget(this);
+    const char* pageTitles[PAGES_COUNT] = { GPU_STR_TraceComparisonAPIsPage, GPU_STR_TraceComparisonKernelsPage, GPU_STR_TraceComparisonThreadsPage };
+
+    for (int page = 0; page < PAGES_COUNT; page++)
+    {
+        // The cells hold their display text, and the value they are sorted by:
+        m_pModels[page] = new QStandardItemModel(this);
+        m_pModels[page]->setSortRole(s_SORT_ROLE);
+
+        m_pTables[page] = new QTableView(this);
+        m_pTables[page]->setModel(m_pModels[page]);
+        m_pTables[page]->setSelectionMode(QAbstractItemView::ExtendedSelection);
+        m_pTables[page]->setSelectionBehavior(QAbstractItemView::SelectRows);
+        m_pTables[page]->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        m_pTables[page]->verticalHeader()->hide();
+
+        m_pPagesTabWidget->addTab(m_pTables[page], pageTitles[page]);
+    }
+
+    QVBoxLayout* pMainLayout = new QVBoxLayout(this);
+    pMainLayout->addLayout(pHeaderLayout);
+    pMainLayout->addWidget(m_pResultLabel);
+    pMainLayout->addWidget(m_pPagesTabWidget);
+    setLayout(pMainLayout);
+
+    m_pCompareTimer = new QTimer(this);
+    m_pCompareTimer->setInterval(s_COMPARE_POLL_INTERVAL_MS);
+
+    bool rc = connect(m_pCompareTimer, SIGNAL(timeout()), this, SLOT(OnCompareTimer()));
+    GT_ASSERT(rc);
+
+    rc = connect(m_pThresholdSpinBox, SIGNAL(valueChanged(int)), this, SLOT(OnThresholdChanged()));
+    GT_ASSERT(rc);
+}
+
+gpTraceComparisonView::~gpTraceComparisonView()
+{
+    m_comparer.Cancel();
+}
+
+bool gpTraceComparisonView::StartComparison(const QString& baselineTraceFilePath, const QString& currentTraceFilePath)
+{
+    bool retVal = m_comparer.Start(baselineTraceFilePath, currentTraceFilePath);
+
+    if (retVal)
+    {
+        for (int page = 0; page < PAGES_COUNT; page++)
+        {
+            m_pModels[page]->clear();
+        }
+
+        m_pSessionsLabel->setText(QString(GPU_STR_TraceComparisonSessions).arg(QDir::toNativeSeparators(baselineTraceFilePath)).arg(QDir::toNativeSeparators(currentTraceFilePath)));
+        m_pResultLabel->setText(QString(GPU_STR_TraceComparisonLoadingBaseline).arg(0));
+        m_pCompareTimer->start();
+    }
+
+    return retVal;
+}
+
+void gpTraceComparisonView::OnCompareTimer()
+{
+    gpTraceComparisonSession loadedSession = GP_TRACE_COMPARISON_BASELINE;
+    unsigned int currentItem = 0;
+    unsigned int totalItems = 0;
+    gpTraceSessionComparer::CompareState state = m_comparer.GetState(loadedSession, currentItem, totalItems);
+
+    if (gpTraceSessionComparer::COMPARE_STATE_RUNNING == state)
+    {
+        int percent = (totalItems > 0) ? static_cast<int>(100.0 * currentItem / totalItems) : 0;
+        m_pResultLabel->setText(QString((GP_TRACE_COMPARISON_BASELINE == loadedSession) ? GPU_STR_TraceComparisonLoadingBaseline : GPU_STR_TraceComparisonLoadingCurrent).arg(percent));
+    }
+    else
+    {
+        m_pCompareTimer->stop();
+
+        if (gpTraceSessionComparer::COMPARE_STATE_DONE == state)
+        {
+            DisplayComparison();
+        }
+        else
+        {
+            m_pResultLabel->setText((gpTraceSessionComparer::COMPARE_STATE_CANCELED == state) ? GPU_STR_TraceComparisonCanceled : GPU_STR_TraceComparisonFailed);
+        }
+    }
+}
+
+void gpTraceComparisonView::OnThresholdChanged()
+{
+    // The comparison is shown only once the comparer thread is done with it:
+    if (!m_pCompareTimer->isActive() && (m_pModels[PAGE_APIS]->columnCount() > 0))
+    {
+        DisplayComparison();
+    }
+}
+
+void gpTraceComparisonView::DisplayComparison()
+{
+    const gpTraceComparison& comparison = m_comparer.GetComparison();
+    int regressionsCount = 0;
+    int newCount = 0;
+    int missingCount = 0;
+
+    DisplayRows(PAGE_APIS, comparison.m_apiRows, regressionsCount, newCount, missingCount);
+    DisplayRows(PAGE_KERNELS, comparison.m_kernelRows, regressionsCount, newCount, missingCount);
+    DisplayThreads();
+
+    int alignedThreadsCount = 0;
+    quint64 newCallsCount = 0;
+    quint64 missingCallsCount = 0;
+
+    for (const gpTraceComparisonThread& thread : comparison.m_threads)
+    {
+        if (!thread.m_hasDivergence)
+        {
+            alignedThreadsCount++;
+        }
+
+        newCallsCount += thread.m_newCallsCount;
+        missingCallsCount += thread.m_missingCallsCount;
+    }
+
+    m_pResultLabel->setText(QString(GPU_STR_TraceComparisonResult).arg(regressionsCount).arg(newCount).arg(missingCount)
+                            .arg(alignedThreadsCount).arg(comparison.m_threads.size()).arg(newCallsCount).arg(missingCallsCount));
+}
+
+void gpTraceComparisonView::DisplayRows(PageType pageType, const std::vector<gpTraceComparisonRow>& rows, int& regressionsCount, int& newCount, int& missingCount)
+{
+    bool isAPIPage = (PAGE_APIS == pageType);
+    unsigned int thresholdPercent = static_cast<unsigned int>(m_pThresholdSpinBox->value());
+
+    QStringList columnNames;
+    columnNames << (isAPIPage ? GPU_STR_TraceSummaryColumnAPIName : GPU_STR_TraceSummaryColumnKernelName) << GPU_STR_TraceComparisonColumnStatus
+                << (isAPIPage ? GPU_STR_TraceComparisonColumnBaselineCalls : GPU_STR_TraceComparisonColumnBaselineDispatches)
+                << (isAPIPage ? GPU_STR_TraceComparisonColumnCurrentCalls : GPU_STR_TraceComparisonColumnCurrentDispatches)
+                << GPU_STR_TraceComparisonColumnCountDelta << GPU_STR_TraceComparisonColumnBaselineTotalTime << GPU_STR_TraceComparisonColumnCurrentTotalTime
+                << GPU_STR_TraceComparisonColumnTotalTimeDelta << GPU_STR_TraceComparisonColumnBaselineAvgTime << GPU_STR_TraceComparisonColumnCurrentAvgTime
+                << GPU_STR_TraceComparisonColumnAvgTimeDelta;
+
+    if (isAPIPage)
+    {
+        columnNames << GPU_STR_TraceComparisonColumnNewCalls << GPU_STR_TraceComparisonColumnMissingCalls;
+    }
+
+    BeginPage(pageType, columnNames);
+
+    for (const gpTraceComparisonRow& row : rows)
+    {
+        quint64 baselineCount = row.m_counts[GP_TRACE_COMPARISON_BASELINE];
+        quint64 currentCount = row.m_counts[GP_TRACE_COMPARISON_CURRENT];
+        double baselineAverage = gpTraceSessionComparer::GetAverageDuration(row, GP_TRACE_COMPARISON_BASELINE);
+        double currentAverage = gpTraceSessionComparer::GetAverageDuration(row, GP_TRACE_COMPARISON_CURRENT);
+
+        QString status;
+        QColor background;
+
+        if (0 == currentCount)
+        {
+            status = GPU_STR_TraceComparisonStatusMissing;
+            background = s_MISSING_ROW_COLOR;
+            missingCount++;
+        }
+        else if (0 == baselineCount)
+        {
+            status = GPU_STR_TraceComparisonStatusNew;
+            background = s_NEW_ROW_COLOR;
+            newCount++;
+        }
+        else if (gpTraceSessionComparer::IsRegression(row, thresholdPercent))
+        {
+            status = GPU_STR_TraceComparisonStatusRegression;
+            background = s_REGRESSION_ROW_COLOR;
+            regressionsCount++;
+        }
+        else if ((row.m_newCallsCount > 0) || (row.m_missingCallsCount > 0))
+        {
+            status = GPU_STR_TraceComparisonStatusSequenceChanged;
+            background = s_SEQUENCE_CHANGED_ROW_COLOR;
+        }
+
+        QString name = row.m_name;
+
+        if (row.m_clApiId >= 0)
+        {
+            name = CLAPIDefs::Instance()->GetOpenCLAPIString(CL_FUNC_TYPE(row.m_clApiId));
+        }
+
+        QList<QStandardItem*> items;
+        items << CreateCell(name, background) << CreateCell(status, background)
+              << CreateCell(baselineCount, background) << CreateCell(currentCount, background)
+              << CreateCell(static_cast<qint64>(currentCount) - static_cast<qint64>(baselineCount), background)
+              << CreateCell(ToMilliseconds(row.m_durations[GP_TRACE_COMPARISON_BASELINE]), background)
+              << CreateCell(ToMilliseconds(row.m_durations[GP_TRACE_COMPARISON_CURRENT]), background)
+              << CreateCell(ToMilliseconds(row.m_durations[GP_TRACE_COMPARISON_CURRENT]) - ToMilliseconds(row.m_durations[GP_TRACE_COMPARISON_BASELINE]), background)
+              << CreateCell(ToMilliseconds(baselineAverage), background) << CreateCell(ToMilliseconds(currentAverage), background);
+
+        // The average time delta is only defined for the APIs and kernels of both sessions:
+        items << CreateCell(((baselineAverage > 0) && (currentCount > 0)) ? QVariant(100.0 * (currentAverage - baselineAverage) / baselineAverage) : QVariant(QString()), background);
+
+        if (isAPIPage)
+        {
+            items << CreateCell(row.m_newCallsCount, background) << CreateCell(row.m_missingCallsCount, background);
+        }
+
+        m_pModels[pageType]->appendRow(items);
+    }
+
+    EndPage(pageType);
+}
+
+void gpTraceComparisonView::DisplayThreads()
+{
+    QStringList columnNames;
+    columnNames << GPU_STR_TraceComparisonColumnBaselineThreadId << GPU_STR_TraceComparisonColumnCurrentThreadId
+                << GPU_STR_TraceComparisonColumnBaselineCalls << GPU_STR_TraceComparisonColumnCurrentCalls << GPU_STR_TraceComparisonColumnMatchedCalls
+                << GPU_STR_TraceComparisonColumnNewCalls << GPU_STR_TraceComparisonColumnMissingCalls << GPU_STR_TraceComparisonColumnFirstDivergence;
+
+    BeginPage(PAGE_THREADS, columnNames);
+
+    for (const gpTraceComparisonThread& thread : m_comparer.GetComparison().m_threads)
+    {
+        QColor background;
+        QString firstDivergence;
+
+        if (thread.m_hasDivergence)
+        {
+            background = s_SEQUENCE_CHANGED_ROW_COLOR;
+            firstDivergence = QString(GPU_STR_TraceComparisonFirstDivergence).arg(thread.m_firstDivergenceCallIndex[GP_TRACE_COMPARISON_BASELINE] + 1)
+                              .arg(thread.m_firstDivergenceCallIndex[GP_TRACE_COMPARISON_CURRENT] + 1);
+        }
+
+        QList<QStandardItem*> items;
+
+        for (int session = 0; session < GP_TRACE_COMPARISON_SESSIONS_COUNT; session++)
+        {
+            items << CreateCell(thread.m_hasThread[session] ? QVariant(thread.m_threadIds[session]) : QVariant(QString()), background);
+        }
+
+        items << CreateCell(thread.m_callsCount[GP_TRACE_COMPARISON_BASELINE], background) << CreateCell(thread.m_callsCount[GP_TRACE_COMPARISON_CURRENT], background)
+              << CreateCell(thread.m_matchedCallsCount, background) << CreateCell(thread.m_newCallsCount, background)
+              << CreateCell(thread.m_missingCallsCount, background) << CreateCell(firstDivergence, background);
+
+        m_pModels[PAGE_THREADS]->appendRow(items);
+    }
+
+    EndPage(PAGE_THREADS);
+}
+
+void gpTraceComparisonView::BeginPage(PageType pageType, const QStringList& columnNames)
+{
+    m_pModels[pageType]->clear();
+    m_pModels[pageType]->setHorizontalHeaderLabels(columnNames);
+
+    // Disable sorting while the rows are added, so that the model is not sorted with each row:
+    m_pTables[pageType]->setSortingEnabled(false);
+}
+
+void gpTraceComparisonView::EndPage(PageType pageType)
+{
+    m_pTables[pageType]->setSortingEnabled(true);
+    m_pTables[pageType]->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+    m_pTables[pageType]->resizeColumnsToContents();
+}
+
+QStandardItem* gpTraceComparisonView::CreateCell(const QVariant& value, const QColor& background)
+{
+    QStandardItem* pItem = new QStandardItem;
+
+    if (value.type() == QVariant::Double)
+    {
+        pItem->setData(QString::number(value.toDouble(), 'f', s_DECIMALS), Qt::DisplayRole);
+        pItem->setData(static_cast<int>(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
+    }
+    else if (value.type() == QVariant::String)
+    {
+        pItem->setData(value, Qt::DisplayRole);
+    }
+    else
+    {
+        pItem->setData(value.toString(), Qt::DisplayRole);
+        pItem->setData(static_cast<int>(Qt::AlignRight | Qt::AlignVCenter), Qt::TextAlignmentRole);
+    }
+
+    if (background.isValid())
+    {
+        pItem->setData(background, Qt::BackgroundRole);
+    }
+
+    pItem->setData(value, s_SORT_ROLE);
+    return pItem;
+}
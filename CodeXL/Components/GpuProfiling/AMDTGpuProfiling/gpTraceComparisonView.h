@@ -0,0 +1,102 @@
+//=============================================================
+// Copyright (c) 2016-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+/// \author GPU Developer Tools
+/// \file
+/// \brief Shows the comparison of two trace sessions, per API, per kernel and per thread
+//=============================================================
+
+#ifndef __GPTRACECOMPARISONVIEW_H
+#define __GPTRACECOMPARISONVIEW_H
+
+// Qt
+#include <qtIgnoreCompilerWarnings.h>
+#include <QtWidgets>
+
+// Local:
+#include <AMDTGpuProfiling/gpTraceSessionComparer.h>
+
+// need to undef Bool after all includes so the moc will compile in Linux
+#undef Bool
+
+/// Compares a baseline trace with a current trace on a background thread, and shows the count and time deltas of the APIs
+/// and kernels in sortable tables. New and missing APIs and kernels, the APIs whose calls are out of sequence, and the APIs
+/// and kernels whose average time grew by more than the regression threshold are highlighted
+class gpTraceComparisonView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    /// The default regression threshold, in percents
+    static const int ms_DEFAULT_REGRESSION_THRESHOLD_PERCENT = 10;
+
+    /// Initializes a new instance of the gpTraceComparisonView class
+    /// \param pParent the parent widget
+    gpTraceComparisonView(QWidget* pParent);
+
+    /// Destroys the view, and cancels the running comparison
+    virtual ~gpTraceComparisonView();
+
+    /// Starts comparing two trace files. The tables are filled once the comparison is done
+    /// \param baselineTraceFilePath the trace file compared against
+    /// \param currentTraceFilePath the compared trace file
+    /// \return true iff the comparison was started
+    bool StartComparison(const QString& baselineTraceFilePath, const QString& currentTraceFilePath);
+
+private slots:
+    /// Polls the comparer thread, and fills the tables once the comparison is done
+    void OnCompareTimer();
+
+    /// Highlights the rows again with the new regression threshold
+    void OnThresholdChanged();
+
+private:
+    /// The tables of the view
+    enum PageType
+    {
+        PAGE_APIS,
+        PAGE_KERNELS,
+        PAGE_THREADS,
+        PAGES_COUNT
+    };
+
+    /// Fills the tables and the result label with the comparison
+    void DisplayComparison();
+
+    /// Fills the API or kernel table
+    /// \param pageType PAGE_APIS or PAGE_KERNELS
+    /// \param rows the compared APIs or kernels
+    /// \param[in,out] regressionsCount incremented by the number of regressions
+    /// \param[in,out] newCount incremented by the number of new APIs or kernels
+    /// \param[in,out] missingCount incremented by the number of missing APIs or kernels
+    void DisplayRows(PageType pageType, const std::vector<gpTraceComparisonRow>& rows, int& regressionsCount, int& newCount, int& missingCount);
+
+    /// Fills the threads table
+    void DisplayThreads();
+
+    /// Starts filling a table
+    /// \param pageType the table
+    /// \param columnNames the column headers
+    void BeginPage(PageType pageType, const QStringList& columnNames);
+
+    /// Ends filling a table
+    /// \param pageType the table
+    void EndPage(PageType pageType);
+
+    /// Creates a table cell
+    /// \param value the cell value. Doubles are shown with a fixed number of decimals
+    /// \param background the background color of the row, invalid to keep the default background
+    /// \return the cell
+    static QStandardItem* CreateCell(const QVariant& value, const QColor& background);
+
+    gpTraceSessionComparer m_comparer;                  ///< compares the traces on a background thread
+    QTimer* m_pCompareTimer;                            ///< polls the comparer thread while the comparison runs
+    QLabel* m_pSessionsLabel;                           ///< shows the compared trace files
+    QLabel* m_pResultLabel;                             ///< shows the progress, then the comparison result
+    QSpinBox* m_pThresholdSpinBox;                      ///< the regression threshold, in percents
+    QTabWidget* m_pPagesTabWidget;                      ///< the tab widget of the tables
+    QTableView* m_pTables[PAGES_COUNT];                 ///< the tables
+    QStandardItemModel* m_pModels[PAGES_COUNT];         ///< the models of the tables
+};
+
+#endif // __GPTRACECOMPARISONVIEW_H
@@ -0,0 +1,393 @@
+//=============================================================
+// Copyright (c) 2016-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+/// \author GPU Developer Tools
+/// \file
+/// \brief Loads the records of a trace file on a background thread, and publishes them to the UI thread in batches
+//=============================================================
+
+#include <qtIgnoreCompilerWarnings.h>
+#include <QtCore>
+
+// std
+#include <chrono>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtAssert.h>
+
+// Local:
+#include <AMDTGpuProfiling/gpTraceLoader.h>
+#include <AMDTGpuProfiling/gpStringConstants.h>
+#include <AMDTGpuProfiling/Util.h>
+#include "AtpUtils.h"
+
+/// Number of records in a batch
+static const size_t s_BATCH_SIZE = 1024;
+
+/// Number of batches. Once they are all published, the loader thread waits for the UI thread to release one
+static const size_t s_BATCH_COUNT = 4;
+
+/// The backend parser reports the parsed entries to every registered callback handler, so only one loader may parse at a time
+static std::mutex s_backendParserMutex;
+
+gpTraceLoader::gpTraceLoader() :
+    m_isStopRequested(false), m_loadSucceeded(false), m_isDone(false),
+    m_progressCurrentItem(0), m_progressTotalItems(0), m_isProgressChanged(false), m_pCurrentBatch(nullptr)
+{
+}
+
+gpTraceLoader::~gpTraceLoader()
+{
+    Finish();
+}
+
+bool gpTraceLoader::Start(const QString& traceFilePath)
+{
+    bool retVal = false;
+
+    GT_IF_WITH_ASSERT(!m_thread.joinable())
+    {
+        m_traceFilePath = traceFilePath;
+        m_isStopRequested = false;
+        m_loadSucceeded = false;
+        m_isDone = false;
+        m_isProgressChanged = false;
+        m_pCurrentBatch = nullptr;
+
+        m_batches.assign(s_BATCH_COUNT, gpTraceRecordBatch());
+        m_publishedBatches.clear();
+        m_freeBatches.clear();
+
+        for (gpTraceRecordBatch& batch : m_batches)
+        {
+            batch.m_records.resize(s_BATCH_SIZE);
+            m_freeBatches.push_back(&batch);
+        }
+
+        m_thread = std::thread(&gpTraceLoader::LoadThreadFunc, this);
+        retVal = true;
+    }
+
+    return retVal;
+}
+
+bool gpTraceLoader::WaitForNextBatch(gpTraceRecordBatch*& pBatch, unsigned int timeoutMs)
+{
+    pBatch = nullptr;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_batchPublishedCondition.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]() { return !m_publishedBatches.empty() || m_isDone; });
+
+    if (!m_publishedBatches.empty())
+    {
+        pBatch = m_publishedBatches.front();
+        m_publishedBatches.pop_front();
+    }
+
+    return (pBatch != nullptr) || !m_isDone;
+}
+
+void gpTraceLoader::ReleaseBatch(gpTraceRecordBatch* pBatch)
+{
+    GT_IF_WITH_ASSERT(pBatch != nullptr)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_freeBatches.push_back(pBatch);
+    }
+
+    m_batchReleasedCondition.notify_one();
+}
+
+bool gpTraceLoader::GetProgress(std::string& progressMessage, unsigned int& currentItem, unsigned int& totalItems)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bool retVal = m_isProgressChanged;
+
+    if (m_isProgressChanged)
+    {
+        progressMessage = m_progressMessage;
+        currentItem = m_progressCurrentItem;
+        totalItems = m_progressTotalItems;
+        m_isProgressChanged = false;
+    }
+
+    return retVal;
+}
+
+bool gpTraceLoader::Finish()
+{
+    if (m_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isStopRequested = m_isStopRequested || !m_isDone;
+        }
+
+        m_batchReleasedCondition.notify_one();
+        m_thread.join();
+    }
+
+    return m_loadSucceeded && !m_isStopRequested;
+}
+
+void gpTraceLoader::LoadThreadFunc()
+{
+    bool loadSucceeded = false;
+
+    // A trace file that was already parsed once is loaded from its session index:
+    if (!LoadFromIndex(loadSucceeded))
+    {
+        loadSucceeded = LoadUsingBackendParser();
+    }
+
+    m_loadSucceeded = loadSucceeded;
+
+    PublishBatch();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isDone = true;
+    }
+
+    m_batchPublishedCondition.notify_one();
+}
+
+bool gpTraceLoader::LoadFromIndex(bool& loadSucceeded)
+{
+    bool retVal = false;
+    loadSucceeded = false;
+
+    gpTraceSessionIndexReader indexReader;
+
+    if (indexReader.Open(m_traceFilePath))
+    {
+        retVal = true;
+
+        unsigned int recordCount = static_cast<unsigned int>(indexReader.GetRecordCount());
+        SetProgress(GPU_STR_TraceViewLoadingSessionIndexProgress, 0, recordCount);
+
+        gpTraceIndexRecord* pRecord = NextRecord();
+
+        while ((pRecord != nullptr) && indexReader.ReadNext(*pRecord))
+        {
+            m_pCurrentBatch->m_recordCount++;
+
+            unsigned int recordsRead = static_cast<unsigned int>(indexReader.GetRecordsRead());
+
+            if ((recordsRead % s_BATCH_SIZE) == 0)
+            {
+                SetProgress(GPU_STR_TraceViewLoadingSessionIndexProgress, recordsRead, recordCount);
+            }
+
+            pRecord = NextRecord();
+        }
+
+        loadSucceeded = (pRecord != nullptr) && !indexReader.IsCorrupted();
+
+        if (indexReader.IsCorrupted())
+        {
+            // The records that were read are already published, so do not parse on top of them. Remove the index so that the next load parses the trace:
+            Util::LogError("Invalid session index file");
+            indexReader.Close();
+            gpTraceSessionIndex::RemoveIndexFile(m_traceFilePath);
+        }
+    }
+
+    return retVal;
+}
+
+bool gpTraceLoader::LoadUsingBackendParser()
+{
+    bool retVal = false;
+
+    std::lock_guard<std::mutex> parserLock(s_backendParserMutex);
+
+    if (!AtpUtils::Instance()->IsModuleLoaded())
+    {
+        AtpUtils::Instance()->LoadModule();
+    }
+
+    AtpParserFunc parserFunc = AtpUtils::Instance()->GetAtpParserFunctionPointer();
+
+    if (nullptr != parserFunc)
+    {
+        // Failing to create the index (i.e. a read only session folder) only means the next load will parse again:
+        m_indexWriter.Open(m_traceFilePath);
+
+        AtpUtils::Instance()->AddToCallBackHandlerList(this);
+        std::string traceFilePathAsString = m_traceFilePath.toStdString();
+        retVal = parserFunc(traceFilePathAsString.c_str(), OnParse, SetApiNum, ReportProgressOnParsing);
+        AtpUtils::Instance()->RemoveHandlerFromCallBackHandlerList(this);
+
+        // Only an index of the complete trace can replace the parsing:
+        if (retVal && !m_isStopRequested)
+        {
+            m_indexWriter.Commit();
+        }
+        else
+        {
+            m_indexWriter.Discard();
+        }
+    }
+
+    return retVal;
+}
+
+gpTraceIndexRecord* gpTraceLoader::NextRecord()
+{
+    gpTraceIndexRecord* pRecord = nullptr;
+
+    if ((m_pCurrentBatch != nullptr) && (m_pCurrentBatch->m_recordCount == m_pCurrentBatch->m_records.size()))
+    {
+        PublishBatch();
+    }
+
+    if (m_pCurrentBatch == nullptr)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_batchReleasedCondition.wait(lock, [this]() { return !m_freeBatches.empty() || m_isStopRequested; });
+
+        if (!m_isStopRequested)
+        {
+            m_pCurrentBatch = m_freeBatches.back();
+            m_pCurrentBatch->m_recordCount = 0;
+            m_freeBatches.pop_back();
+        }
+    }
+
+    if (m_pCurrentBatch != nullptr)
+    {
+        pRecord = &m_pCurrentBatch->m_records[m_pCurrentBatch->m_recordCount];
+    }
+
+    return pRecord;
+}
+
+void gpTraceLoader::PublishBatch()
+{
+    if (m_pCurrentBatch != nullptr)
+    {
+        if (m_pCurrentBatch->m_recordCount > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_publishedBatches.push_back(m_pCurrentBatch);
+            }
+
+            m_batchPublishedCondition.notify_one();
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_freeBatches.push_back(m_pCurrentBatch);
+        }
+
+        m_pCurrentBatch = nullptr;
+    }
+}
+
+void gpTraceLoader::SetProgress(const char* strProgressMessage, unsigned int currentItem, unsigned int totalItems)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (nullptr != strProgressMessage)
+    {
+        m_progressMessage = strProgressMessage;
+    }
+
+    m_progressCurrentItem = currentItem;
+    m_progressTotalItems = totalItems;
+    m_isProgressChanged = true;
+}
+
+void gpTraceLoader::OnParseCallHandler(AtpInfoType apiInfoType, bool& stopParsing)
+{
+    gpTraceIndexRecordType recordType = GP_TRACE_INDEX_RECORD_NONE;
+
+    switch (apiInfoType)
+    {
+        case OPENCL_INFO:
+            recordType = GP_TRACE_INDEX_RECORD_CL_API;
+            break;
+
+        case HSA_INFO:
+            recordType = GP_TRACE_INDEX_RECORD_HSA_API;
+            break;
+
+        case PERF_MARKER_ENTRY:
+            recordType = GP_TRACE_INDEX_RECORD_PERF_MARKER;
+            break;
+
+        case SYMBOL_ENTRY:
+            recordType = GP_TRACE_INDEX_RECORD_SYMBOL;
+            break;
+
+        default:
+            break;
+    }
+
+    AtpDataHandlerFunc pAtpDataHandler_func = AtpUtils::Instance()->GetAtpDataHandlerFunc();
+
+    if ((GP_TRACE_INDEX_RECORD_NONE != recordType) && (nullptr != pAtpDataHandler_func))
+    {
+        gpTraceIndexRecord* pRecord = NextRecord();
+
+        if (pRecord != nullptr)
+        {
+            void* pPtr = nullptr;
+            pAtpDataHandler_func(&pPtr);
+            IAtpDataHandler* pAtpDataHandler = reinterpret_cast<IAtpDataHandler*>(pPtr);
+
+            // Copy the parsed entry to a record, which is both published and written to the session index:
+            pRecord->m_type = recordType;
+
+            switch (recordType)
+            {
+                case GP_TRACE_INDEX_RECORD_CL_API:
+                    pRecord->m_clApi.SetFromDataHandler(pAtpDataHandler->GetCLApiInfoDataHandler());
+                    break;
+
+                case GP_TRACE_INDEX_RECORD_HSA_API:
+                    pRecord->m_hsaApi.SetFromDataHandler(pAtpDataHandler->GetHSAApiInfoDataHandler());
+                    break;
+
+                case GP_TRACE_INDEX_RECORD_PERF_MARKER:
+                    pRecord->m_perfMarker.SetFromDataHandler(pAtpDataHandler->GetPerfMarkerInfoDataHandler());
+                    break;
+
+                case GP_TRACE_INDEX_RECORD_SYMBOL:
+                    pRecord->m_symbol.SetFromDataHandler(pAtpDataHandler->GetSymbolFileEntryInfoDataHandler());
+                    break;
+
+                default:
+                    break;
+            }
+
+            pRecord->m_indexOffset = m_indexWriter.GetNextRecordOffset();
+            m_indexWriter.Write(*pRecord);
+            m_pCurrentBatch->m_recordCount++;
+        }
+    }
+
+    stopParsing = m_isStopRequested;
+}
+
+void gpTraceLoader::OnSetApiNumCallHandler(osThreadId threadId, unsigned int apiNum)
+{
+    gpTraceIndexRecord* pRecord = NextRecord();
+
+    if (pRecord != nullptr)
+    {
+        pRecord->m_type = GP_TRACE_INDEX_RECORD_API_NUM;
+        pRecord->m_apiNumThreadId = static_cast<quint64>(threadId);
+        pRecord->m_apiNum = apiNum;
+        pRecord->m_indexOffset = m_indexWriter.GetNextRecordOffset();
+        m_indexWriter.Write(*pRecord);
+        m_pCurrentBatch->m_recordCount++;
+    }
+}
+
+void gpTraceLoader::OnParserProgressCallHandler(const char* strProgressMessage, unsigned int uiCurItem, unsigned int uiTotalItems)
+{
+    SetProgress(strProgressMessage, uiCurItem, uiTotalItems);
+}
@@ -0,0 +1,122 @@
+//=============================================================
+// Copyright (c) 2016-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+/// \author GPU Developer Tools
+/// \file
+/// \brief Loads the records of a trace file on a background thread, and publishes them to the UI thread in batches
+//=============================================================
+
+#ifndef __GPTRACELOADER_H
+#define __GPTRACELOADER_H
+
+// std
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Local:
+#include <AMDTGpuProfiling/gpTraceSessionIndex.h>
+#include "ICallBackParserHandler.h"
+
+/// A batch of records published by the loader thread
+struct gpTraceRecordBatch
+{
+    std::vector<gpTraceIndexRecord> m_records;  ///< the records. Only the first m_recordCount records are valid
+    size_t m_recordCount;                       ///< the number of valid records
+
+    gpTraceRecordBatch() : m_recordCount(0) {}
+};
+
+/// Loads a trace file on a background thread. The records are read from the session index of the trace file when it is valid,
+/// otherwise the trace file is parsed and its session index is written.
+/// The records are published in batches, which are recycled once the UI thread has handled them, so that the loader thread
+/// can never get further ahead of the UI than a fixed number of batches
+class gpTraceLoader : public ICallBackParserHandler
+{
+public:
+    /// Default time, in milliseconds, WaitForNextBatch waits for a batch before it returns
+    static const unsigned int ms_DEFAULT_BATCH_WAIT_TIMEOUT_MS = 100;
+
+    gpTraceLoader();
+    virtual ~gpTraceLoader();
+
+    /// Starts loading the specified trace file on the loader thread
+    /// \param traceFilePath the trace file path
+    /// \return true iff the loader thread was started
+    bool Start(const QString& traceFilePath);
+
+    /// Waits for the next batch of records. The batch must be returned with ReleaseBatch once its records are handled
+    /// \param[out] pBatch the next batch, or nullptr if no batch was published before the wait timed out
+    /// \param timeoutMs the time to wait for a batch. The UI thread passes 0 to poll without blocking the event loop
+    /// \return false when the loader thread is done and all the batches were consumed
+    bool WaitForNextBatch(gpTraceRecordBatch*& pBatch, unsigned int timeoutMs = ms_DEFAULT_BATCH_WAIT_TIMEOUT_MS);
+
+    /// Returns a batch obtained from WaitForNextBatch to the loader thread
+    /// \param pBatch the batch
+    void ReleaseBatch(gpTraceRecordBatch* pBatch);
+
+    /// Gets the latest progress reported by the loader thread
+    /// \param[out] progressMessage the progress message
+    /// \param[out] currentItem the index of the current item
+    /// \param[out] totalItems the total number of items
+    /// \return true iff the progress changed since the last call
+    bool GetProgress(std::string& progressMessage, unsigned int& currentItem, unsigned int& totalItems);
+
+    /// Stops the loader thread and waits for it to end
+    /// \return true iff the whole trace file was loaded
+    bool Finish();
+
+    /// ICallBackParserHandler implementation, called on the loader thread by the backend parser
+    void OnParseCallHandler(AtpInfoType apiInfoType, bool& stopParsing) override;
+    void OnSetApiNumCallHandler(osThreadId threadId, unsigned int apiNum) override;
+    void OnParserProgressCallHandler(const char* strProgressMessage, unsigned int uiCurItem, unsigned int uiTotalItems) override;
+
+private:
+    /// The loader thread function
+    void LoadThreadFunc();
+
+    /// Loads the records from the session index of the trace file
+    /// \param[out] loadSucceeded true iff all the index records were loaded
+    /// \return false if there is no valid index for the trace file, and it should be parsed
+    bool LoadFromIndex(bool& loadSucceeded);
+
+    /// Parses the trace file with the backend parser, and writes its session index
+    /// \return true iff parsing succeeded
+    bool LoadUsingBackendParser();
+
+    /// Gets the record to fill next, in the current batch
+    /// \return the record, or nullptr if loading was stopped
+    gpTraceIndexRecord* NextRecord();
+
+    /// Publishes the current batch to the UI thread, if it has records
+    void PublishBatch();
+
+    /// Updates the progress reported to the UI thread
+    void SetProgress(const char* strProgressMessage, unsigned int currentItem, unsigned int totalItems);
+
+    QString m_traceFilePath;                                    ///< the loaded trace file path
+    std::thread m_thread;                                       ///< the loader thread
+    std::atomic<bool> m_isStopRequested;                        ///< true iff the UI thread asked the loader thread to stop
+    bool m_loadSucceeded;                                       ///< true iff the whole trace file was loaded
+
+    std::mutex m_mutex;                                         ///< protects the members below
+    std::condition_variable m_batchPublishedCondition;          ///< signaled when a batch is published, or the loader thread is done
+    std::condition_variable m_batchReleasedCondition;           ///< signaled when a batch is released, or stop is requested
+    std::vector<gpTraceRecordBatch> m_batches;                  ///< all the batches. The vector is never resized while loading
+    std::deque<gpTraceRecordBatch*> m_publishedBatches;         ///< batches published and not yet consumed, in load order
+    std::vector<gpTraceRecordBatch*> m_freeBatches;             ///< batches the loader thread can fill
+    bool m_isDone;                                              ///< true iff the loader thread published its last batch
+    std::string m_progressMessage;                              ///< the latest progress message
+    unsigned int m_progressCurrentItem;                         ///< the latest progress item
+    unsigned int m_progressTotalItems;                          ///< the latest progress total
+    bool m_isProgressChanged;                                   ///< true iff the progress changed since GetProgress was called
+
+    gpTraceRecordBatch* m_pCurrentBatch;                        ///< the batch filled by the loader thread (loader thread only)
+    gpTraceSessionIndexWriter m_indexWriter;                    ///< writes the session index while parsing (loader thread only)
+};
+
+#endif // __GPTRACELOADER_H
@@ -0,0 +1,1017 @@
+//=============================================================
+// Copyright (c) 2016-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+/// \author GPU Developer Tools
+/// \file
+/// \brief Indexes the trace tables of a trace view, and runs the find toolbar queries against the index on a background thread
+//=============================================================
+
+#include <qtIgnoreCompilerWarnings.h>
+#include <QtCore>
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtAssert.h>
+
+// Local:
+#include <AMDTGpuProfiling/gpTraceSearch.h>
+#include <AMDTGpuProfiling/gpStringConstants.h>
+
+/// The characters separating the argument values in the arguments column
+static const char* s_ARGUMENT_SEPARATORS = " \t\r\n,;:=()[]{}|&<>\"'";
+
+/// Number of rows indexed between two checks of a stop request
+static const quint32 s_ROWS_PER_STOP_CHECK = 65536;
+
+/// \return true iff the character separates argument values
+static bool IsArgumentSeparator(char c)
+{
+    return (c != '\0') && (strchr(s_ARGUMENT_SEPARATORS, c) != nullptr);
+}
+
+/// \return the ASCII lower case of a character
+static char ToLowerASCII(char c)
+{
+    return ((c >= 'A') && (c <= 'Z')) ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/// \return true iff a string is ordered before another by their ASCII lower case, the order of the argument values index
+static bool IsLessCaseInsensitive(const std::string& str, const std::string& otherStr)
+{
+    return std::lexicographical_compare(str.begin(), str.end(), otherStr.begin(), otherStr.end(),
+                                        [](char c, char otherC) { return ToLowerASCII(c) < ToLowerASCII(otherC); });
+}
+
+/// \return true iff a string starts with a text
+/// \param str the string
+/// \param text the text, in lower case when matchCase is false
+/// \param matchCase true for a case sensitive comparison (ASCII only)
+static bool StartsWithText(const std::string& str, const std::string& text, bool matchCase)
+{
+    bool retVal = (str.size() >= text.size());
+
+    for (size_t i = 0; retVal && (i < text.size()); i++)
+    {
+        retVal = (matchCase ? str[i] : ToLowerASCII(str[i])) == text[i];
+    }
+
+    return retVal;
+}
+
+/// Finds a text in a range of characters
+/// \param pBegin the range start
+/// \param pEnd the range end
+/// \param text the text, in lower case when matchCase is false
+/// \param matchCase true for a case sensitive search (ASCII only)
+/// \return the first occurrence of the text, or nullptr if the range does not contain it
+static const char* FindText(const char* pBegin, const char* pEnd, const std::string& text, bool matchCase)
+{
+    const char* pRetVal = nullptr;
+    size_t textLength = text.size();
+
+    if ((textLength > 0) && (static_cast<size_t>(pEnd - pBegin) >= textLength))
+    {
+        const char* pLastStart = pEnd - textLength;
+
+        if (matchCase)
+        {
+            const char* pCurrent = pBegin;
+
+            while ((pRetVal == nullptr) && (pCurrent <= pLastStart))
+            {
+                pCurrent = static_cast<const char*>(memchr(pCurrent, text[0], pLastStart - pCurrent + 1));
+
+                if (pCurrent == nullptr)
+                {
+                    break;
+                }
+
+                if (memcmp(pCurrent, text.data(), textLength) == 0)
+                {
+                    pRetVal = pCurrent;
+                }
+
+                pCurrent++;
+            }
+        }
+        else
+        {
+            for (const char* pCurrent = pBegin; (pRetVal == nullptr) && (pCurrent <= pLastStart); pCurrent++)
+            {
+                if (ToLowerASCII(*pCurrent) == text[0])
+                {
+                    size_t i = 1;
+
+                    while ((i < textLength) && (ToLowerASCII(pCurrent[i]) == text[i]))
+                    {
+                        i++;
+                    }
+
+                    if (i == textLength)
+                    {
+                        pRetVal = pCurrent;
+                    }
+                }
+            }
+        }
+    }
+
+    return pRetVal;
+}
+
+/// Matches the text terms of a query against strings
+class gpTraceSearchTextMatcher
+{
+public:
+    gpTraceSearchTextMatcher(const QString& text, const gpTraceSearchQuery& query) :
+        m_isRegex(query.IsRegex()), m_caseSensitivity(query.IsMatchCase() ? Qt::CaseSensitive : Qt::CaseInsensitive), m_text(text)
+    {
+        if (m_isRegex)
+        {
+            m_regex.setPattern(text);
+            m_regex.setPatternOptions(query.IsMatchCase() ? QRegularExpression::NoPatternOption : QRegularExpression::CaseInsensitiveOption);
+        }
+
+        m_utf8Text = text.toUtf8().toStdString();
+
+        if (!query.IsMatchCase())
+        {
+            std::transform(m_utf8Text.begin(), m_utf8Text.end(), m_utf8Text.begin(), ToLowerASCII);
+        }
+    }
+
+    /// \return true iff the string matches
+    bool Matches(const QString& str) const
+    {
+        return m_isRegex ? m_regex.match(str).hasMatch() : str.contains(m_text, m_caseSensitivity);
+    }
+
+    /// \return true iff the UTF8 string matches
+    bool Matches(const std::string& str) const
+    {
+        return m_isRegex ? m_regex.match(QString::fromUtf8(str.data(), static_cast<int>(str.size()))).hasMatch() :
+               (FindText(str.data(), str.data() + str.size(), m_utf8Text, (m_caseSensitivity == Qt::CaseSensitive)) != nullptr);
+    }
+
+    /// \return the UTF8 text, in lower case for a case insensitive match
+    const std::string& GetUTF8Text() const { return m_utf8Text; }
+
+private:
+    bool m_isRegex;                         ///< true iff the text is a regular expression
+    Qt::CaseSensitivity m_caseSensitivity;  ///< the case sensitivity of a text match
+    QString m_text;                         ///< the text
+    QRegularExpression m_regex;             ///< the regular expression
+    std::string m_utf8Text;                 ///< the UTF8 text, in lower case for a case insensitive match
+};
+
+gpTraceSearchQuery::gpTraceSearchQuery() : m_matchCase(false), m_isRegex(false)
+{
+}
+
+bool gpTraceSearchQuery::Parse(const QString& queryText, bool matchCase, bool isRegex, QString& errorMessage)
+{
+    bool retVal = true;
+
+    m_terms.clear();
+    m_matchCase = matchCase;
+    m_isRegex = isRegex;
+    errorMessage.clear();
+
+    // Split the query to tokens. Quoted text is one token:
+    QStringList tokens;
+    QString currentToken;
+    bool isInQuotes = false;
+
+    for (const QChar& c : queryText)
+    {
+        if (c == '"')
+        {
+            isInQuotes = !isInQuotes;
+        }
+        else if (c.isSpace() && !isInQuotes)
+        {
+            if (!currentToken.isEmpty())
+            {
+                tokens << currentToken;
+                currentToken.clear();
+            }
+        }
+        else
+        {
+            currentToken.append(c);
+        }
+    }
+
+    if (!currentToken.isEmpty())
+    {
+        tokens << currentToken;
+    }
+
+    for (const QString& token : tokens)
+    {
+        if (!retVal)
+        {
+            break;
+        }
+
+        gpTraceSearchTerm term;
+        term.m_text = token;
+
+        if (token.startsWith(GPU_STR_TraceSearchAPIField, Qt::CaseInsensitive))
+        {
+            term.m_field = GP_TRACE_SEARCH_FIELD_API;
+            term.m_text = token.mid(static_cast<int>(strlen(GPU_STR_TraceSearchAPIField)));
+        }
+        else if (token.startsWith(GPU_STR_TraceSearchArgumentField, Qt::CaseInsensitive))
+        {
+            term.m_field = GP_TRACE_SEARCH_FIELD_ARGUMENT;
+            term.m_text = token.mid(static_cast<int>(strlen(GPU_STR_TraceSearchArgumentField)));
+        }
+        else if (token.startsWith(GPU_STR_TraceSearchThreadField, Qt::CaseInsensitive))
+        {
+            term.m_field = GP_TRACE_SEARCH_FIELD_THREAD;
+            term.m_text = token.mid(static_cast<int>(strlen(GPU_STR_TraceSearchThreadField)));
+        }
+        else if (token.startsWith(GPU_STR_TraceSearchDurationField, Qt::CaseInsensitive))
+        {
+            term.m_field = GP_TRACE_SEARCH_FIELD_DURATION;
+            term.m_text = token.mid(static_cast<int>(strlen(GPU_STR_TraceSearchDurationField)));
+
+            if (term.m_text.isEmpty())
+            {
+                // A field prefix which is not followed by a value is ignored while it is typed:
+                continue;
+            }
+
+            // Parse the duration range:
+            QString minText;
+            QString maxText;
+            int rangeSeparatorPos = term.m_text.indexOf("..");
+
+            if (rangeSeparatorPos >= 0)
+            {
+                minText = term.m_text.left(rangeSeparatorPos);
+                maxText = term.m_text.mid(rangeSeparatorPos + 2);
+            }
+            else if (term.m_text.startsWith('>'))
+            {
+                minText = term.m_text.mid(1);
+            }
+            else if (term.m_text.startsWith('<'))
+            {
+                maxText = term.m_text.mid(1);
+            }
+            else
+            {
+                minText = term.m_text;
+            }
+
+            term.m_minDuration = 0;
+            term.m_maxDuration = std::numeric_limits<quint64>::max();
+
+            bool isDurationValid = !minText.isEmpty() || !maxText.isEmpty();
+
+            if (isDurationValid && !minText.isEmpty())
+            {
+                isDurationValid = ParseDuration(minText, term.m_minDuration);
+            }
+
+            if (isDurationValid && !maxText.isEmpty())
+            {
+                isDurationValid = ParseDuration(maxText, term.m_maxDuration);
+            }
+
+            if (!isDurationValid || (term.m_minDuration > term.m_maxDuration))
+            {
+                errorMessage = QString(GPU_STR_TraceSearchInvalidDuration).arg(term.m_text);
+                retVal = false;
+            }
+        }
+
+        if (retVal && (term.m_field != GP_TRACE_SEARCH_FIELD_DURATION))
+        {
+            if (term.m_text.isEmpty())
+            {
+                // A field prefix which is not followed by a value is ignored while it is typed:
+                continue;
+            }
+
+            if (m_isRegex)
+            {
+                QRegularExpression regex(term.m_text);
+
+                if (!regex.isValid())
+                {
+                    errorMessage = QString(GPU_STR_TraceSearchInvalidRegex).arg(regex.errorString());
+                    retVal = false;
+                }
+            }
+        }
+
+        if (retVal)
+        {
+            m_terms.push_back(term);
+        }
+    }
+
+    if (!retVal)
+    {
+        m_terms.clear();
+    }
+
+    return retVal;
+}
+
+bool gpTraceSearchQuery::ParseDuration(const QString& durationText, quint64& duration)
+{
+    QString numberText = durationText.trimmed().toLower();
+    double multiplier = 1.0;
+
+    if (numberText.endsWith("ns"))
+    {
+        numberText.chop(2);
+    }
+    else if (numberText.endsWith("us"))
+    {
+        numberText.chop(2);
+        multiplier = 1000.0;
+    }
+    else if (numberText.endsWith("ms"))
+    {
+        numberText.chop(2);
+        multiplier = 1000000.0;
+    }
+    else if (numberText.endsWith("s"))
+    {
+        numberText.chop(1);
+        multiplier = 1000000000.0;
+    }
+
+    bool retVal = false;
+    double value = numberText.toDouble(&retVal);
+
+    if (retVal && (value >= 0.0))
+    {
+        duration = static_cast<quint64>(value * multiplier);
+    }
+    else
+    {
+        retVal = false;
+    }
+
+    return retVal;
+}
+
+gpTraceSearchTableIndex::gpTraceSearchTableIndex() : m_pStore(nullptr), m_threadId(0)
+{
+}
+
+bool gpTraceSearchTableIndex::Build(const gpTraceSearchTable& table, const std::atomic<bool>& isStopRequested)
+{
+    bool retVal = true;
+
+    m_pStore = table.m_pStore;
+    m_threadId = table.m_threadId;
+
+    GT_IF_WITH_ASSERT(m_pStore != nullptr)
+    {
+        quint32 rowCount = m_pStore->GetRowCount();
+
+        // Index the names. The rows of each name are counted, and then placed after the rows of the previous names:
+        quint32 nameIdsCount = m_pStore->GetInternedStringsCount();
+        m_nameRowsOffsets.assign(nameIdsCount + 1, 0);
+
+        for (quint32 row = 0; row < rowCount; row++)
+        {
+            m_nameRowsOffsets[m_pStore->GetNameId(row) + 1]++;
+        }
+
+        for (quint32 nameId = 0; nameId < nameIdsCount; nameId++)
+        {
+            m_nameRowsOffsets[nameId + 1] += m_nameRowsOffsets[nameId];
+        }
+
+        m_nameRows.resize(rowCount);
+        std::vector<quint32> nameRowsEnds(m_nameRowsOffsets.begin(), m_nameRowsOffsets.end() - 1);
+
+        for (quint32 row = 0; row < rowCount; row++)
+        {
+            m_nameRows[nameRowsEnds[m_pStore->GetNameId(row)]++] = row;
+        }
+
+        // Index the argument values. The values of each row are collected first, and then the rows of each value are placed as the names rows:
+        std::unordered_map<std::string, quint32> argumentValueIds;
+        std::vector<quint32> rowValueIds;
+        std::vector<quint32> rowValueIdsOffsets;
+        rowValueIdsOffsets.reserve(rowCount + 1);
+        rowValueIdsOffsets.push_back(0);
+
+        const char* pArgumentsChars = m_pStore->GetArgumentsChars();
+        std::string value;
+
+        for (quint32 row = 0; retVal && (row < rowCount); row++)
+        {
+            if (((row % s_ROWS_PER_STOP_CHECK) == 0) && isStopRequested)
+            {
+                retVal = false;
+                break;
+            }
+
+            const char* pCurrent = pArgumentsChars + m_pStore->GetArgumentsOffset(row);
+            const char* pEnd = pCurrent + m_pStore->GetArgumentsLength(row);
+            size_t firstValueIdIndex = rowValueIds.size();
+
+            while (pCurrent < pEnd)
+            {
+                while ((pCurrent < pEnd) && IsArgumentSeparator(*pCurrent))
+                {
+                    pCurrent++;
+                }
+
+                const char* pValueStart = pCurrent;
+
+                while ((pCurrent < pEnd) && !IsArgumentSeparator(*pCurrent))
+                {
+                    pCurrent++;
+                }
+
+                if (pCurrent > pValueStart)
+                {
+                    value.assign(pValueStart, pCurrent);
+                    std::unordered_map<std::string, quint32>::iterator iter = argumentValueIds.find(value);
+
+                    if (iter == argumentValueIds.end())
+                    {
+                        iter = argumentValueIds.insert(std::make_pair(value, static_cast<quint32>(m_argumentValues.size()))).first;
+                        m_argumentValues.push_back(value);
+                    }
+
+                    rowValueIds.push_back(iter->second);
+                }
+            }
+
+            // A value that repeats in the arguments of a row is indexed once:
+            std::sort(rowValueIds.begin() + firstValueIdIndex, rowValueIds.end());
+            rowValueIds.erase(std::unique(rowValueIds.begin() + firstValueIdIndex, rowValueIds.end()), rowValueIds.end());
+            rowValueIdsOffsets.push_back(static_cast<quint32>(rowValueIds.size()));
+        }
+
+        if (retVal)
+        {
+            // Sort the values, so that the values which start with a text are found with a binary search, and renumber them by their order:
+            quint32 valuesCount = static_cast<quint32>(m_argumentValues.size());
+            std::vector<quint32> sortedValueIds(valuesCount);
+
+            for (quint32 valueId = 0; valueId < valuesCount; valueId++)
+            {
+                sortedValueIds[valueId] = valueId;
+            }
+
+            std::sort(sortedValueIds.begin(), sortedValueIds.end(), [this](quint32 valueId, quint32 otherValueId)
+            {
+                const std::string& value = m_argumentValues[valueId];
+                const std::string& otherValue = m_argumentValues[otherValueId];
+                return IsLessCaseInsensitive(value, otherValue) || (!IsLessCaseInsensitive(otherValue, value) && (value < otherValue));
+            });
+
+            std::vector<std::string> sortedValues(valuesCount);
+            std::vector<quint32> sortedValueIdsByValueId(valuesCount);
+
+            for (quint32 sortedValueId = 0; sortedValueId < valuesCount; sortedValueId++)
+            {
+                sortedValues[sortedValueId].swap(m_argumentValues[sortedValueIds[sortedValueId]]);
+                sortedValueIdsByValueId[sortedValueIds[sortedValueId]] = sortedValueId;
+            }
+
+            m_argumentValues.swap(sortedValues);
+
+            for (quint32& valueId : rowValueIds)
+            {
+                valueId = sortedValueIdsByValueId[valueId];
+            }
+
+            m_argumentValueRowsOffsets.assign(valuesCount + 1, 0);
+
+            for (quint32 valueId : rowValueIds)
+            {
+                m_argumentValueRowsOffsets[valueId + 1]++;
+            }
+
+            for (quint32 valueId = 0; valueId < valuesCount; valueId++)
+            {
+                m_argumentValueRowsOffsets[valueId + 1] += m_argumentValueRowsOffsets[valueId];
+            }
+
+            m_argumentValueRows.resize(rowValueIds.size());
+            std::vector<quint32> valueRowsEnds(m_argumentValueRowsOffsets.begin(), m_argumentValueRowsOffsets.end() - 1);
+
+            for (quint32 row = 0; row < rowCount; row++)
+            {
+                for (quint32 i = rowValueIdsOffsets[row]; i < rowValueIdsOffsets[row + 1]; i++)
+                {
+                    m_argumentValueRows[valueRowsEnds[rowValueIds[i]]++] = row;
+                }
+            }
+
+            // Index the durations:
+            m_rowsByDuration.resize(rowCount);
+
+            for (quint32 row = 0; row < rowCount; row++)
+            {
+                quint64 startTime = m_pStore->GetStartTime(row);
+                quint64 endTime = m_pStore->GetEndTime(row);
+                m_rowsByDuration[row] = std::make_pair((endTime > startTime) ? (endTime - startTime) : 0, row);
+            }
+
+            std::sort(m_rowsByDuration.begin(), m_rowsByDuration.end());
+        }
+    }
+
+    return retVal;
+}
+
+void gpTraceSearchTableIndex::Find(const gpTraceSearchQuery& query, const std::atomic<unsigned int>& searchGeneration, unsigned int generation, std::vector<quint32>& rows) const
+{
+    rows.clear();
+
+    GT_IF_WITH_ASSERT((m_pStore != nullptr) && !query.IsEmpty())
+    {
+        RowSet matchedRows;
+
+        for (const gpTraceSearchTerm& term : query.GetTerms())
+        {
+            if ((searchGeneration != generation) || (!matchedRows.m_isAll && matchedRows.m_rows.empty()))
+            {
+                break;
+            }
+
+            RowSet termRows;
+            FindTerm(term, query, termRows);
+            IntersectRowSets(matchedRows, termRows);
+        }
+
+        if (searchGeneration == generation)
+        {
+            if (matchedRows.m_isAll)
+            {
+                rows.resize(m_pStore->GetRowCount());
+
+                for (quint32 row = 0; row < rows.size(); row++)
+                {
+                    rows[row] = row;
+                }
+            }
+            else
+            {
+                rows.swap(matchedRows.m_rows);
+            }
+        }
+    }
+}
+
+void gpTraceSearchTableIndex::FindTerm(const gpTraceSearchTerm& term, const gpTraceSearchQuery& query, RowSet& rowSet) const
+{
+    rowSet.m_isAll = false;
+    rowSet.m_rows.clear();
+
+    switch (term.m_field)
+    {
+        case GP_TRACE_SEARCH_FIELD_THREAD:
+        {
+            // All the rows of a table belong to its thread:
+            QString threadIdText = QString::number(m_threadId);
+            rowSet.m_isAll = query.IsRegex() ? gpTraceSearchTextMatcher(term.m_text, query).Matches(threadIdText) : (threadIdText == term.m_text);
+            break;
+        }
+
+        case GP_TRACE_SEARCH_FIELD_DURATION:
+        {
+            std::vector<std::pair<quint64, quint32> >::const_iterator firstIter = std::lower_bound(m_rowsByDuration.begin(), m_rowsByDuration.end(), std::make_pair(term.m_minDuration, quint32(0)));
+            std::vector<std::pair<quint64, quint32> >::const_iterator endIter = std::upper_bound(firstIter, m_rowsByDuration.end(), std::make_pair(term.m_maxDuration, std::numeric_limits<quint32>::max()));
+
+            rowSet.m_rows.reserve(endIter - firstIter);
+
+            for (std::vector<std::pair<quint64, quint32> >::const_iterator iter = firstIter; iter != endIter; ++iter)
+            {
+                rowSet.m_rows.push_back(iter->second);
+            }
+
+            std::sort(rowSet.m_rows.begin(), rowSet.m_rows.end());
+            break;
+        }
+
+        case GP_TRACE_SEARCH_FIELD_API:
+        {
+            FindNames(term, query, rowSet.m_rows);
+
+            // Each row has one name, so there are no duplicates:
+            std::sort(rowSet.m_rows.begin(), rowSet.m_rows.end());
+            break;
+        }
+
+        case GP_TRACE_SEARCH_FIELD_ARGUMENT:
+        {
+            FindArgumentValues(term, query, rowSet.m_rows);
+            SortAndRemoveDuplicates(rowSet.m_rows);
+            break;
+        }
+
+        case GP_TRACE_SEARCH_FIELD_ANY:
+        default:
+        {
+            FindNames(term, query, rowSet.m_rows);
+            FindArgumentValues(term, query, rowSet.m_rows);
+            SortAndRemoveDuplicates(rowSet.m_rows);
+            break;
+        }
+    }
+}
+
+void gpTraceSearchTableIndex::FindNames(const gpTraceSearchTerm& term, const gpTraceSearchQuery& query, std::vector<quint32>& rows) const
+{
+    gpTraceSearchTextMatcher matcher(term.m_text, query);
+
+    // The distinct names are few, so each of them is matched, and the rows of the matched ones are added:
+    quint32 nameIdsCount = static_cast<quint32>(m_nameRowsOffsets.size()) - 1;
+
+    for (quint32 nameId = 0; nameId < nameIdsCount; nameId++)
+    {
+        quint32 firstRowOffset = m_nameRowsOffsets[nameId];
+        quint32 endRowOffset = m_nameRowsOffsets[nameId + 1];
+
+        if ((firstRowOffset < endRowOffset) && matcher.Matches(m_pStore->GetInternedString(nameId)))
+        {
+            rows.insert(rows.end(), m_nameRows.begin() + firstRowOffset, m_nameRows.begin() + endRowOffset);
+        }
+    }
+}
+
+void gpTraceSearchTableIndex::FindArgumentValues(const gpTraceSearchTerm& term, const gpTraceSearchQuery& query, std::vector<quint32>& rows) const
+{
+    gpTraceSearchTextMatcher matcher(term.m_text, query);
+
+    if (query.IsRegex())
+    {
+        // A regular expression cannot be looked up in the sorted values, so each distinct value is matched:
+        quint32 valuesCount = static_cast<quint32>(m_argumentValues.size());
+
+        for (quint32 valueId = 0; valueId < valuesCount; valueId++)
+        {
+            if (matcher.Matches(m_argumentValues[valueId]))
+            {
+                rows.insert(rows.end(), m_argumentValueRows.begin() + m_argumentValueRowsOffsets[valueId], m_argumentValueRows.begin() + m_argumentValueRowsOffsets[valueId + 1]);
+            }
+        }
+    }
+    else
+    {
+        const std::string& utf8Text = matcher.GetUTF8Text();
+
+        if (std::find_if(utf8Text.begin(), utf8Text.end(), IsArgumentSeparator) != utf8Text.end())
+        {
+            // The text spans several values:
+            FindArgumentsText(utf8Text, query.IsMatchCase(), rows);
+        }
+        else
+        {
+            std::vector<quint32> valuesRows;
+            FindValuesRows(utf8Text, query.IsMatchCase(), false, valuesRows);
+            rows.insert(rows.end(), valuesRows.begin(), valuesRows.end());
+        }
+    }
+}
+
+void gpTraceSearchTableIndex::FindValuesRows(const std::string& text, bool matchCase, bool isWholeValue, std::vector<quint32>& rows) const
+{
+    rows.clear();
+
+    std::string lowerCaseText = text;
+    std::transform(lowerCaseText.begin(), lowerCaseText.end(), lowerCaseText.begin(), ToLowerASCII);
+
+    // The values which start with the text (in any case) are adjacent, starting at the first value which is not ordered before the text:
+    std::vector<std::string>::const_iterator firstIter = std::lower_bound(m_argumentValues.begin(), m_argumentValues.end(), lowerCaseText, IsLessCaseInsensitive);
+    quint32 valuesCount = 0;
+
+    for (std::vector<std::string>::const_iterator iter = firstIter; (iter != m_argumentValues.end()) && StartsWithText(*iter, lowerCaseText, false); ++iter)
+    {
+        if ((!isWholeValue || (iter->size() == text.size())) && (!matchCase || StartsWithText(*iter, text, true)))
+        {
+            quint32 valueId = static_cast<quint32>(iter - m_argumentValues.begin());
+            rows.insert(rows.end(), m_argumentValueRows.begin() + m_argumentValueRowsOffsets[valueId], m_argumentValueRows.begin() + m_argumentValueRowsOffsets[valueId + 1]);
+            valuesCount++;
+        }
+    }
+
+    // The rows of each value are sorted, and a value is indexed once per row:
+    if (valuesCount > 1)
+    {
+        SortAndRemoveDuplicates(rows);
+    }
+}
+
+void gpTraceSearchTableIndex::FindArgumentsText(const std::string& text, bool matchCase, std::vector<quint32>& rows) const
+{
+    // The rows which have all the values of the text are the candidates. A value which is followed by a separator in the text is
+    // a whole argument value, and the last value (if the text does not end with a separator) is the start of an argument value:
+    RowSet candidateRows;
+    const char* pCurrent = text.data();
+    const char* pEnd = pCurrent + text.size();
+
+    while ((pCurrent < pEnd) && (candidateRows.m_isAll || !candidateRows.m_rows.empty()))
+    {
+        while ((pCurrent < pEnd) && IsArgumentSeparator(*pCurrent))
+        {
+            pCurrent++;
+        }
+
+        const char* pValueStart = pCurrent;
+
+        while ((pCurrent < pEnd) && !IsArgumentSeparator(*pCurrent))
+        {
+            pCurrent++;
+        }
+
+        if (pCurrent > pValueStart)
+        {
+            RowSet valueRows;
+            valueRows.m_isAll = false;
+            FindValuesRows(std::string(pValueStart, pCurrent), matchCase, (pCurrent < pEnd), valueRows.m_rows);
+            IntersectRowSets(candidateRows, valueRows);
+        }
+    }
+
+    if (candidateRows.m_isAll)
+    {
+        // The text is made of separators only, so it has no values to look up:
+        ScanArguments(text, matchCase, rows);
+    }
+    else
+    {
+        for (quint32 row : candidateRows.m_rows)
+        {
+            if (RowArgumentsContain(row, text, matchCase))
+            {
+                rows.push_back(row);
+            }
+        }
+    }
+}
+
+void gpTraceSearchTableIndex::ScanArguments(const std::string& text, bool matchCase, std::vector<quint32>& rows) const
+{
+    quint32 rowCount = m_pStore->GetRowCount();
+
+    if (rowCount > 0)
+    {
+        // The arguments of all rows are contiguous, so they are scanned at once, and each occurrence is mapped to its row:
+        const char* pArgumentsChars = m_pStore->GetArgumentsChars();
+        const char* pEnd = pArgumentsChars + m_pStore->GetArgumentsOffset(rowCount - 1) + m_pStore->GetArgumentsLength(rowCount - 1);
+        const char* pCurrent = FindText(pArgumentsChars, pEnd, text, matchCase);
+
+        while (pCurrent != nullptr)
+        {
+            // Find the last row whose arguments start at or before the occurrence:
+            quint64 occurrenceOffset = static_cast<quint64>(pCurrent - pArgumentsChars);
+            quint32 firstRow = 0;
+            quint32 lastRow = rowCount;
+
+            while (lastRow - firstRow > 1)
+            {
+                quint32 middleRow = firstRow + (lastRow - firstRow) / 2;
+
+                if (m_pStore->GetArgumentsOffset(middleRow) <= occurrenceOffset)
+                {
+                    firstRow = middleRow;
+                }
+                else
+                {
+                    lastRow = middleRow;
+                }
+            }
+
+            quint64 rowEndOffset = m_pStore->GetArgumentsOffset(firstRow) + m_pStore->GetArgumentsLength(firstRow);
+
+            if (occurrenceOffset + text.size() <= rowEndOffset)
+            {
+                // Continue with the next row:
+                rows.push_back(firstRow);
+                pCurrent = FindText(pArgumentsChars + rowEndOffset, pEnd, text, matchCase);
+            }
+            else
+            {
+                // The occurrence spans two rows:
+                pCurrent = FindText(pCurrent + 1, pEnd, text, matchCase);
+            }
+        }
+    }
+}
+
+bool gpTraceSearchTableIndex::RowArgumentsContain(quint32 row, const std::string& text, bool matchCase) const
+{
+    bool retVal = false;
+
+    const char* pArgumentsStart = m_pStore->GetArgumentsChars() + m_pStore->GetArgumentsOffset(row);
+    const char* pArgumentsEnd = pArgumentsStart + m_pStore->GetArgumentsLength(row);
+    const char* pCurrent = FindText(pArgumentsStart, pArgumentsEnd, text, matchCase);
+
+    while (!retVal && (pCurrent != nullptr))
+    {
+        // The text matches from the start of a value, as its values were looked up in the index:
+        retVal = (pCurrent == pArgumentsStart) || IsArgumentSeparator(text[0]) || IsArgumentSeparator(pCurrent[-1]);
+
+        if (!retVal)
+        {
+            pCurrent = FindText(pCurrent + 1, pArgumentsEnd, text, matchCase);
+        }
+    }
+
+    return retVal;
+}
+
+void gpTraceSearchTableIndex::IntersectRowSets(RowSet& rowSet, const RowSet& otherRowSet)
+{
+    if (rowSet.m_isAll)
+    {
+        rowSet = otherRowSet;
+    }
+    else if (!otherRowSet.m_isAll)
+    {
+        std::vector<quint32> intersection;
+        std::set_intersection(rowSet.m_rows.begin(), rowSet.m_rows.end(), otherRowSet.m_rows.begin(), otherRowSet.m_rows.end(), std::back_inserter(intersection));
+        rowSet.m_rows.swap(intersection);
+    }
+}
+
+void gpTraceSearchTableIndex::SortAndRemoveDuplicates(std::vector<quint32>& rows)
+{
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+}
+
+gpTraceSearch::gpTraceSearch() :
+    m_isStopRequested(false), m_searchGeneration(0), m_isIndexBuilt(false), m_isSearchRequested(false), m_state(SEARCH_STATE_IDLE), m_searchTimeMs(0)
+{
+}
+
+gpTraceSearch::~gpTraceSearch()
+{
+    Reset();
+}
+
+void gpTraceSearch::SetTables(const std::vector<gpTraceSearchTable>& tables)
+{
+    Reset();
+
+    m_tables = tables;
+    m_tableIndexes.assign(m_tables.size(), gpTraceSearchTableIndex());
+    m_isStopRequested = false;
+
+    m_thread = std::thread(&gpTraceSearch::SearchThreadFunc, this);
+}
+
+void gpTraceSearch::Reset()
+{
+    if (m_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isStopRequested = true;
+            m_searchGeneration++;
+        }
+
+        m_searchRequestedCondition.notify_one();
+        m_thread.join();
+    }
+
+    m_tables.clear();
+    m_tableIndexes.clear();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isIndexBuilt = false;
+    m_isSearchRequested = false;
+    m_publishedMatches.clear();
+    m_state = SEARCH_STATE_IDLE;
+}
+
+void gpTraceSearch::StartSearch(const gpTraceSearchQuery& query)
+{
+    if (query.IsEmpty())
+    {
+        CancelSearch();
+    }
+    else
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_searchGeneration++;
+            m_query = query;
+            m_isSearchRequested = true;
+            m_publishedMatches.clear();
+            m_state = m_isIndexBuilt ? SEARCH_STATE_SEARCHING : SEARCH_STATE_BUILDING_INDEX;
+        }
+
+        m_searchRequestedCondition.notify_one();
+    }
+}
+
+void gpTraceSearch::CancelSearch()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_searchGeneration++;
+    m_isSearchRequested = false;
+    m_publishedMatches.clear();
+    m_state = SEARCH_STATE_IDLE;
+}
+
+gpTraceSearch::SearchState gpTraceSearch::TakeMatches(std::vector<gpTraceSearchMatch>& matches, unsigned int& searchTimeMs)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    matches.clear();
+    matches.swap(m_publishedMatches);
+    searchTimeMs = m_searchTimeMs;
+
+    return m_state;
+}
+
+void gpTraceSearch::SearchThreadFunc()
+{
+    // Build the index of all the tables first, so that the queries are answered from the index:
+    bool isIndexBuilt = true;
+
+    for (size_t i = 0; isIndexBuilt && (i < m_tables.size()); i++)
+    {
+        isIndexBuilt = m_tableIndexes[i].Build(m_tables[i], m_isStopRequested);
+    }
+
+    if (isIndexBuilt)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isIndexBuilt = true;
+
+        if (m_state == SEARCH_STATE_BUILDING_INDEX)
+        {
+            m_state = SEARCH_STATE_SEARCHING;
+        }
+    }
+
+    std::vector<quint32> rows;
+
+    while (isIndexBuilt && !m_isStopRequested)
+    {
+        gpTraceSearchQuery query;
+        unsigned int generation = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_searchRequestedCondition.wait(lock, [this]() { return m_isSearchRequested || m_isStopRequested; });
+
+            if (m_isStopRequested)
+            {
+                break;
+            }
+
+            query = m_query;
+            generation = m_searchGeneration;
+            m_isSearchRequested = false;
+        }
+
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+        // The matches are published table by table, so that the UI shows the first ones while the rest are searched:
+        for (size_t i = 0; (i < m_tableIndexes.size()) && (m_searchGeneration == generation); i++)
+        {
+            m_tableIndexes[i].Find(query, m_searchGeneration, generation, rows);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_searchGeneration == generation)
+            {
+                m_publishedMatches.reserve(m_publishedMatches.size() + rows.size());
+
+                for (quint32 row : rows)
+                {
+                    gpTraceSearchMatch match;
+                    match.m_tableIndex = static_cast<unsigned int>(i);
+                    match.m_storeRow = row;
+                    m_publishedMatches.push_back(match);
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_searchGeneration == generation)
+        {
+            m_searchTimeMs = static_cast<unsigned int>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count());
+            m_state = SEARCH_STATE_DONE;
+        }
+    }
+}
@@ -0,0 +1,274 @@
+//=============================================================
+// Copyright (c) 2016-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+/// \author GPU Developer Tools
+/// \file
+/// \brief Indexes the trace tables of a trace view, and runs the find toolbar queries against the index on a background thread
+//=============================================================
+
+#ifndef __GPTRACESEARCH_H
+#define __GPTRACESEARCH_H
+
+// std
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Qt
+#include <QString>
+
+/// The field a query term is matched against
+enum gpTraceSearchField
+{
+    GP_TRACE_SEARCH_FIELD_ANY,          ///< the API name or an argument value
+    GP_TRACE_SEARCH_FIELD_API,          ///< the API (or perf marker) name ("api:")
+    GP_TRACE_SEARCH_FIELD_ARGUMENT,     ///< an argument value ("arg:")
+    GP_TRACE_SEARCH_FIELD_THREAD,       ///< the host thread id ("thread:")
+    GP_TRACE_SEARCH_FIELD_DURATION      ///< the CPU duration ("dur:")
+};
+
+/// A term of a find query
+struct gpTraceSearchTerm
+{
+    gpTraceSearchField m_field;     ///< the field the term is matched against
+    QString m_text;                 ///< the text (or regular expression) of text fields
+    quint64 m_minDuration;          ///< the minimal duration (in nanoseconds) of duration terms
+    quint64 m_maxDuration;          ///< the maximal duration (in nanoseconds) of duration terms
+
+    gpTraceSearchTerm() : m_field(GP_TRACE_SEARCH_FIELD_ANY), m_minDuration(0), m_maxDuration(0) {}
+};
+
+/// A find query: a list of terms, which a matched row must all match.
+/// A term is either plain text, which is matched against the API name and the argument values, or a field-scoped term:
+///   api:<text>   arg:<text>   thread:<id>   dur:<min>..<max>   dur:><min>   dur:<<max>   dur:<min>
+/// Durations may have a ns, us, ms or s suffix (the default is ns). Text which contains spaces can be quoted.
+/// A text matches the API names that contain it, and the argument values that start with it. A text which contains argument
+/// separators matches the arguments that contain it from the start of a value
+class gpTraceSearchQuery
+{
+public:
+    gpTraceSearchQuery();
+
+    /// Parses a query
+    /// \param queryText the query text
+    /// \param matchCase true iff the text terms are case sensitive
+    /// \param isRegex true iff the text terms are regular expressions
+    /// \param[out] errorMessage the reason the query is invalid
+    /// \return true iff the query is valid
+    bool Parse(const QString& queryText, bool matchCase, bool isRegex, QString& errorMessage);
+
+    /// \return the query terms
+    const std::vector<gpTraceSearchTerm>& GetTerms() const { return m_terms; }
+
+    /// \return true iff the text terms are case sensitive
+    bool IsMatchCase() const { return m_matchCase; }
+
+    /// \return true iff the text terms are regular expressions
+    bool IsRegex() const { return m_isRegex; }
+
+    /// \return true iff the query has no terms
+    bool IsEmpty() const { return m_terms.empty(); }
+
+private:
+    /// Parses a duration with an optional unit suffix
+    /// \param durationText the duration text
+    /// \param[out] duration the duration in nanoseconds
+    /// \return true iff the duration is valid
+    static bool ParseDuration(const QString& durationText, quint64& duration);
+
+    std::vector<gpTraceSearchTerm> m_terms;     ///< the query terms
+    bool m_matchCase;                           ///< true iff the text terms are case sensitive
+    bool m_isRegex;                             ///< true iff the text terms are regular expressions
+};
+
+/// A row matched by a query
+struct gpTraceSearchMatch
+{
+    unsigned int m_tableIndex;      ///< the index of the table, in the tables given to gpTraceSearch::SetTables
+    quint32 m_storeRow;             ///< the column store row of the matched item
+};
+
+/// The columns of a trace table that are indexed. Implemented by the trace table column store
+class gpTraceSearchStore
+{
+public:
+    virtual ~gpTraceSearchStore() {}
+
+    /// \return the number of rows
+    virtual quint32 GetRowCount() const = 0;
+
+    /// \return the interned id of the name of the row
+    virtual quint32 GetNameId(quint32 row) const = 0;
+
+    /// \return the number of interned strings. Interned ids are smaller than this count
+    virtual quint32 GetInternedStringsCount() const = 0;
+
+    /// \return the interned string with the specified id
+    virtual const QString& GetInternedString(quint32 id) const = 0;
+
+    /// \return the arguments of all rows (UTF8, not null terminated). The arguments of a row start at GetArgumentsOffset
+    virtual const char* GetArgumentsChars() const = 0;
+
+    /// \return the offset of the arguments of the row in GetArgumentsChars
+    virtual quint64 GetArgumentsOffset(quint32 row) const = 0;
+
+    /// \return the length of the arguments of the row
+    virtual quint32 GetArgumentsLength(quint32 row) const = 0;
+
+    /// \return the CPU start time of the row
+    virtual quint64 GetStartTime(quint32 row) const = 0;
+
+    /// \return the CPU end time of the row
+    virtual quint64 GetEndTime(quint32 row) const = 0;
+};
+
+/// A searched trace table
+struct gpTraceSearchTable
+{
+    const gpTraceSearchStore* m_pStore;         ///< the column store of the table
+    quint64 m_threadId;                         ///< the host thread of the table
+};
+
+/// The per-column index of one trace table
+class gpTraceSearchTableIndex
+{
+public:
+    gpTraceSearchTableIndex();
+
+    /// Builds the index of a table
+    /// \param table the table
+    /// \param isStopRequested checked while building, to stop early
+    /// \return false if building was stopped
+    bool Build(const gpTraceSearchTable& table, const std::atomic<bool>& isStopRequested);
+
+    /// Matches a query against the table
+    /// \param query the query
+    /// \param searchGeneration the current search generation. The search stops early once it is not the query generation
+    /// \param generation the query generation
+    /// \param[out] rows the sorted column store rows of the matched items
+    void Find(const gpTraceSearchQuery& query, const std::atomic<unsigned int>& searchGeneration, unsigned int generation, std::vector<quint32>& rows) const;
+
+private:
+    /// A set of column store rows. All the rows, or a sorted list of rows
+    struct RowSet
+    {
+        bool m_isAll;                   ///< true iff the set holds all the rows
+        std::vector<quint32> m_rows;    ///< the sorted rows, when m_isAll is false
+
+        RowSet() : m_isAll(true) {}
+    };
+
+    /// Matches a term against the table
+    /// \param term the term
+    /// \param query the query of the term
+    /// \param[out] rowSet the matched rows
+    void FindTerm(const gpTraceSearchTerm& term, const gpTraceSearchQuery& query, RowSet& rowSet) const;
+
+    /// Adds the rows of the names matching a text term
+    void FindNames(const gpTraceSearchTerm& term, const gpTraceSearchQuery& query, std::vector<quint32>& rows) const;
+
+    /// Adds the rows of the argument values matching a text term
+    void FindArgumentValues(const gpTraceSearchTerm& term, const gpTraceSearchQuery& query, std::vector<quint32>& rows) const;
+
+    /// Gets the rows of the argument values that start with a text, or are equal to it
+    /// \param text the text
+    /// \param matchCase true for a case sensitive match (ASCII only)
+    /// \param isWholeValue true to match only the values which are equal to the text
+    /// \param[out] rows the sorted rows of the matched values, without duplicates
+    void FindValuesRows(const std::string& text, bool matchCase, bool isWholeValue, std::vector<quint32>& rows) const;
+
+    /// Adds the rows whose arguments contain a text that spans several argument values. The rows are looked up by the
+    /// values of the text in the index, and then the arguments of these rows are verified
+    void FindArgumentsText(const std::string& text, bool matchCase, std::vector<quint32>& rows) const;
+
+    /// Adds the rows whose arguments contain a text, by scanning the arguments column. Used for a text which has no values
+    void ScanArguments(const std::string& text, bool matchCase, std::vector<quint32>& rows) const;
+
+    /// \return true iff the arguments of a row contain a text, from the start of a value
+    bool RowArgumentsContain(quint32 row, const std::string& text, bool matchCase) const;
+
+    /// Intersects a set of rows into another
+    static void IntersectRowSets(RowSet& rowSet, const RowSet& otherRowSet);
+
+    /// Sorts a list of rows, and removes the duplicates
+    static void SortAndRemoveDuplicates(std::vector<quint32>& rows);
+
+    const gpTraceSearchStore* m_pStore;         ///< the indexed column store
+    quint64 m_threadId;                         ///< the host thread of the table
+
+    /// The rows of each name, by the interned name id. The rows of name id i are m_nameRows[m_nameRowsOffsets[i] .. m_nameRowsOffsets[i + 1])
+    std::vector<quint32> m_nameRowsOffsets;
+    std::vector<quint32> m_nameRows;
+
+    /// The distinct argument values, sorted by their ASCII lower case so that the values that start with a text are adjacent,
+    /// and their rows. The rows of value i are m_argumentValueRows[m_argumentValueRowsOffsets[i] .. m_argumentValueRowsOffsets[i + 1])
+    std::vector<std::string> m_argumentValues;
+    std::vector<quint32> m_argumentValueRowsOffsets;
+    std::vector<quint32> m_argumentValueRows;
+
+    /// The rows sorted by their CPU duration
+    std::vector<std::pair<quint64, quint32> > m_rowsByDuration;
+};
+
+/// Indexes the trace tables of a view, and runs the find queries on a background thread.
+/// The matches are published table by table, and are taken by the UI thread with TakeMatches
+class gpTraceSearch
+{
+public:
+    /// The state of the search
+    enum SearchState
+    {
+        SEARCH_STATE_IDLE,              ///< there are no tables, or no query
+        SEARCH_STATE_BUILDING_INDEX,    ///< the index is being built. The query is run once it is built
+        SEARCH_STATE_SEARCHING,         ///< the query is running
+        SEARCH_STATE_DONE               ///< the query is done
+    };
+
+    gpTraceSearch();
+    ~gpTraceSearch();
+
+    /// Sets the searched tables, and starts building their index on the search thread.
+    /// The column stores of the tables must not change, and must not be deleted before Reset is called
+    /// \param tables the searched tables
+    void SetTables(const std::vector<gpTraceSearchTable>& tables);
+
+    /// Stops the search thread, and clears the tables and their index
+    void Reset();
+
+    /// Starts a query, canceling the running one. The matches of the running query are discarded
+    /// \param query the query
+    void StartSearch(const gpTraceSearchQuery& query);
+
+    /// Cancels the running query
+    void CancelSearch();
+
+    /// Takes the matches published since the last call
+    /// \param[out] matches the matches, ordered by table and store row
+    /// \param[out] searchTimeMs the time the query took, once it is done
+    /// \return the search state
+    SearchState TakeMatches(std::vector<gpTraceSearchMatch>& matches, unsigned int& searchTimeMs);
+
+private:
+    /// The search thread function
+    void SearchThreadFunc();
+
+    std::vector<gpTraceSearchTable> m_tables;               ///< the searched tables (search thread only, while it runs)
+    std::vector<gpTraceSearchTableIndex> m_tableIndexes;    ///< the table indexes (search thread only, while it runs)
+    std::thread m_thread;                                   ///< the search thread
+    std::atomic<bool> m_isStopRequested;                    ///< true iff the search thread should end
+    std::atomic<unsigned int> m_searchGeneration;           ///< incremented with each query, so that the search thread drops the replaced ones
+
+    std::mutex m_mutex;                                     ///< protects the members below
+    std::condition_variable m_searchRequestedCondition;     ///< signaled when a query is started, or stop is requested
+    bool m_isIndexBuilt;                                    ///< true iff the index is built
+    bool m_isSearchRequested;                               ///< true iff a query is waiting for the search thread
+    gpTraceSearchQuery m_query;                             ///< the current query
+    std::vector<gpTraceSearchMatch> m_publishedMatches;     ///< the matches published and not yet taken
+    SearchState m_state;                                    ///< the search state
+    unsigned int m_searchTimeMs;                            ///< the time the last query took
+};
+
+#endif // __GPTRACESEARCH_H
@@ -0,0 +1,396 @@
+//=============================================================
+// Copyright (c) 2016-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+/// \author GPU Developer Tools
+/// \file
+/// \brief Compares the API calls and kernel dispatches of two trace sessions on a background thread
+//=============================================================
+
+#include <qtIgnoreCompilerWarnings.h>
+#include <QtCore>
+
+// std
+#include <algorithm>
+
+// Backend:
+#include <HSAFunctionDefs.h>
+
+// Local:
+#include <AMDTGpuProfiling/gpTraceSessionComparer.h>
+#include <AMDTGpuProfiling/gpTraceLoader.h>
+#include <AMDTGpuProfiling/CLAPIDefs.h>
+
+/// \return the duration of a call or dispatch, 0 if its times are not ordered
+static quint64 GetDuration(quint64 startTime, quint64 endTime)
+{
+    return (endTime > startTime) ? (endTime - startTime) : 0;
+}
+
+/// Records the first calls of a thread which are not aligned, if the thread did not diverge before
+static void SetDivergence(gpTraceComparisonThread& thread, quint64 baselineCallIndex, quint64 currentCallIndex)
+{
+    if (!thread.m_hasDivergence)
+    {
+        thread.m_hasDivergence = true;
+        thread.m_firstDivergenceCallIndex[GP_TRACE_COMPARISON_BASELINE] = baselineCallIndex;
+        thread.m_firstDivergenceCallIndex[GP_TRACE_COMPARISON_CURRENT] = currentCallIndex;
+    }
+}
+
+gpTraceSessionComparer::gpTraceSessionComparer() :
+    m_isCancelRequested(false), m_state(COMPARE_STATE_IDLE), m_loadedSession(GP_TRACE_COMPARISON_BASELINE),
+    m_progressCurrentItem(0), m_progressTotalItems(0), m_threadsCount()
+{
+}
+
+gpTraceSessionComparer::~gpTraceSessionComparer()
+{
+    Cancel();
+}
+
+bool gpTraceSessionComparer::Start(const QString& baselineTraceFilePath, const QString& currentTraceFilePath)
+{
+    bool retVal = false;
+
+    if (COMPARE_STATE_RUNNING != m_state)
+    {
+        // The previous comparer thread is done, but may not have been joined yet:
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+
+        m_traceFilePaths[GP_TRACE_COMPARISON_BASELINE] = baselineTraceFilePath;
+        m_traceFilePaths[GP_TRACE_COMPARISON_CURRENT] = currentTraceFilePath;
+        m_comparison = gpTraceComparison();
+
+        m_isCancelRequested = false;
+        m_loadedSession = GP_TRACE_COMPARISON_BASELINE;
+        m_progressCurrentItem = 0;
+        m_progressTotalItems = 0;
+        m_state = COMPARE_STATE_RUNNING;
+
+        m_thread = std::thread(&gpTraceSessionComparer::CompareThreadFunc, this);
+        retVal = true;
+    }
+
+    return retVal;
+}
+
+void gpTraceSessionComparer::Cancel()
+{
+    if (m_thread.joinable())
+    {
+        m_isCancelRequested = true;
+        m_thread.join();
+    }
+}
+
+gpTraceSessionComparer::CompareState gpTraceSessionComparer::GetState(gpTraceComparisonSession& loadedSession, unsigned int& currentItem, unsigned int& totalItems) const
+{
+    loadedSession = static_cast<gpTraceComparisonSession>(m_loadedSession.load());
+    currentItem = m_progressCurrentItem;
+    totalItems = m_progressTotalItems;
+    return static_cast<CompareState>(m_state.load());
+}
+
+bool gpTraceSessionComparer::IsRegression(const gpTraceComparisonRow& row, unsigned int thresholdPercent)
+{
+    double baselineAverage = GetAverageDuration(row, GP_TRACE_COMPARISON_BASELINE);
+    double currentAverage = GetAverageDuration(row, GP_TRACE_COMPARISON_CURRENT);
+
+    return (baselineAverage > 0) && (currentAverage > baselineAverage * (1.0 + thresholdPercent / 100.0));
+}
+
+double gpTraceSessionComparer::GetAverageDuration(const gpTraceComparisonRow& row, gpTraceComparisonSession session)
+{
+    return (row.m_counts[session] > 0) ? static_cast<double>(row.m_durations[session]) / row.m_counts[session] : 0.0;
+}
+
+void gpTraceSessionComparer::CompareThreadFunc()
+{
+    m_apis = NameTable();
+    m_kernels = NameTable();
+    m_threadAlignments.clear();
+
+    for (int session = 0; session < GP_TRACE_COMPARISON_SESSIONS_COUNT; session++)
+    {
+        m_threadIndexes[session].clear();
+        m_threadsCount[session] = 0;
+    }
+
+    // The backend parser can only parse one trace at a time, so the sessions are loaded one after the other:
+    bool isOK = LoadSession(GP_TRACE_COMPARISON_BASELINE) && LoadSession(GP_TRACE_COMPARISON_CURRENT);
+
+    if (isOK)
+    {
+        BuildComparison();
+    }
+
+    // Only the comparison is kept:
+    m_apis = NameTable();
+    m_kernels = NameTable();
+    m_threadAlignments.clear();
+    m_threadAlignments.shrink_to_fit();
+
+    for (int session = 0; session < GP_TRACE_COMPARISON_SESSIONS_COUNT; session++)
+    {
+        m_threadIndexes[session].clear();
+    }
+
+    if (m_isCancelRequested)
+    {
+        m_state = COMPARE_STATE_CANCELED;
+    }
+    else
+    {
+        m_state = isOK ? COMPARE_STATE_DONE : COMPARE_STATE_FAILED;
+    }
+}
+
+bool gpTraceSessionComparer::LoadSession(gpTraceComparisonSession session)
+{
+    bool retVal = false;
+
+    m_loadedSession = session;
+    m_progressCurrentItem = 0;
+    m_progressTotalItems = 0;
+
+    gpTraceLoader traceLoader;
+
+    if (traceLoader.Start(m_traceFilePaths[session]))
+    {
+        gpTraceRecordBatch* pBatch = nullptr;
+        std::string progressMessage;
+        unsigned int progressCurrentItem = 0;
+        unsigned int progressTotalItems = 0;
+
+        // Each batch is handled and released right away, so the loader thread streams the trace through a few batches:
+        while (!m_isCancelRequested && traceLoader.WaitForNextBatch(pBatch))
+        {
+            if (pBatch != nullptr)
+            {
+                for (size_t i = 0; i < pBatch->m_recordCount; i++)
+                {
+                    AddRecord(session, pBatch->m_records[i]);
+                }
+
+                traceLoader.ReleaseBatch(pBatch);
+            }
+
+            if (traceLoader.GetProgress(progressMessage, progressCurrentItem, progressTotalItems))
+            {
+                m_progressCurrentItem = progressCurrentItem;
+                m_progressTotalItems = progressTotalItems;
+            }
+        }
+
+        retVal = traceLoader.Finish() && !m_isCancelRequested;
+    }
+
+    return retVal;
+}
+
+void gpTraceSessionComparer::AddRecord(gpTraceComparisonSession session, const gpTraceIndexRecord& record)
+{
+    if (GP_TRACE_INDEX_RECORD_CL_API == record.m_type)
+    {
+        const gpTraceCLAPIRecord& clApiRecord = record.m_clApi;
+        AddCall(session, clApiRecord.m_api, (clApiRecord.m_apiId < CL_FUNC_TYPE_Unknown) ? static_cast<int>(clApiRecord.m_apiId) : -1);
+
+        CLAPIType apiType = static_cast<CLAPIType>(clApiRecord.m_apiType);
+
+        if (((apiType & CL_ENQUEUE_KERNEL) == CL_ENQUEUE_KERNEL) && clApiRecord.m_hasEnqueueInfo && clApiRecord.m_hasKernelInfo)
+        {
+            AddDispatch(session, clApiRecord.m_kernelName, clApiRecord.m_runningTime, clApiRecord.m_completeTime);
+        }
+    }
+    else if (GP_TRACE_INDEX_RECORD_HSA_API == record.m_type)
+    {
+        const gpTraceHSAAPIRecord& hsaApiRecord = record.m_hsaApi;
+
+        if (hsaApiRecord.m_isApi)
+        {
+            AddCall(session, hsaApiRecord.m_api, -1);
+        }
+        else if ((HSA_API_Type_Non_API_Dispatch == static_cast<HSA_API_Type>(hsaApiRecord.m_apiId)) && hsaApiRecord.m_hasDispatchInfo)
+        {
+            AddDispatch(session, hsaApiRecord.m_kernelName, hsaApiRecord.m_api.m_startTime, hsaApiRecord.m_api.m_endTime);
+        }
+    }
+}
+
+void gpTraceSessionComparer::AddCall(gpTraceComparisonSession session, const gpTraceAPIRecord& apiRecord, int clApiId)
+{
+    quint32 nameId = InternName(m_apis, apiRecord.m_apiName, clApiId);
+
+    Counters& counters = m_apis.m_counters[session][nameId];
+    counters.m_count++;
+    counters.m_duration += GetDuration(apiRecord.m_startTime, apiRecord.m_endTime);
+
+    ThreadAlignment& alignment = GetThreadAlignment(session, apiRecord.m_threadId);
+    alignment.m_thread.m_callsCount[session]++;
+
+    if (GP_TRACE_COMPARISON_BASELINE == session)
+    {
+        alignment.m_baselineCalls.push_back(nameId);
+    }
+    else
+    {
+        AlignCall(alignment, nameId);
+    }
+}
+
+void gpTraceSessionComparer::AddDispatch(gpTraceComparisonSession session, const std::string& kernelName, quint64 startTime, quint64 endTime)
+{
+    quint32 nameId = InternName(m_kernels, kernelName, -1);
+
+    Counters& counters = m_kernels.m_counters[session][nameId];
+    counters.m_count++;
+    counters.m_duration += GetDuration(startTime, endTime);
+}
+
+void gpTraceSessionComparer::AlignCall(ThreadAlignment& alignment, quint32 nameId)
+{
+    gpTraceComparisonThread& thread = alignment.m_thread;
+    quint64 callIndex = thread.m_callsCount[GP_TRACE_COMPARISON_CURRENT] - 1;
+
+    // Look for the call in the next baseline calls of the thread:
+    std::vector<quint32>::const_iterator cursorIt = alignment.m_baselineCalls.cbegin() + alignment.m_baselineCursor;
+    std::vector<quint32>::const_iterator windowEndIt = cursorIt + std::min(static_cast<size_t>(ms_ALIGNMENT_WINDOW), alignment.m_baselineCalls.size() - alignment.m_baselineCursor);
+    std::vector<quint32>::const_iterator matchIt = std::find(cursorIt, windowEndIt, nameId);
+
+    if (matchIt != windowEndIt)
+    {
+        // The baseline calls skipped to reach the matching call are missing from the current session:
+        size_t matchCursor = matchIt - alignment.m_baselineCalls.cbegin();
+
+        if (matchCursor > alignment.m_baselineCursor)
+        {
+            SetDivergence(thread, alignment.m_baselineCursor, callIndex);
+            SkipBaselineCalls(alignment, matchCursor);
+        }
+
+        alignment.m_baselineCursor = matchCursor + 1;
+        thread.m_matchedCallsCount++;
+    }
+    else
+    {
+        SetDivergence(thread, alignment.m_baselineCursor, callIndex);
+        thread.m_newCallsCount++;
+        m_apis.m_counters[GP_TRACE_COMPARISON_CURRENT][nameId].m_unalignedCallsCount++;
+    }
+}
+
+void gpTraceSessionComparer::SkipBaselineCalls(ThreadAlignment& alignment, size_t endCursor)
+{
+    for (size_t cursor = alignment.m_baselineCursor; cursor < endCursor; cursor++)
+    {
+        m_apis.m_counters[GP_TRACE_COMPARISON_BASELINE][alignment.m_baselineCalls[cursor]].m_unalignedCallsCount++;
+    }
+
+    alignment.m_thread.m_missingCallsCount += endCursor - alignment.m_baselineCursor;
+    alignment.m_baselineCursor = endCursor;
+}
+
+void gpTraceSessionComparer::BuildComparison()
+{
+    for (int session = 0; session < GP_TRACE_COMPARISON_SESSIONS_COUNT; session++)
+    {
+        m_comparison.m_traceFilePaths[session] = m_traceFilePaths[session];
+    }
+
+    // The baseline calls which were not reached by the current session calls are missing:
+    for (ThreadAlignment& alignment : m_threadAlignments)
+    {
+        size_t baselineCallsCount = alignment.m_baselineCalls.size();
+
+        if (alignment.m_baselineCursor < baselineCallsCount)
+        {
+            SetDivergence(alignment.m_thread, alignment.m_baselineCursor, alignment.m_thread.m_callsCount[GP_TRACE_COMPARISON_CURRENT]);
+            SkipBaselineCalls(alignment, baselineCallsCount);
+        }
+
+        m_comparison.m_threads.push_back(alignment.m_thread);
+    }
+
+    BuildRows(m_apis, m_comparison.m_apiRows);
+    BuildRows(m_kernels, m_comparison.m_kernelRows);
+}
+
+void gpTraceSessionComparer::BuildRows(const NameTable& table, std::vector<gpTraceComparisonRow>& rows) const
+{
+    rows.reserve(table.m_names.size());
+
+    for (size_t nameId = 0; nameId < table.m_names.size(); nameId++)
+    {
+        gpTraceComparisonRow row;
+        row.m_name = QString::fromStdString(table.m_names[nameId]);
+        row.m_clApiId = table.m_clApiIds[nameId];
+
+        for (int session = 0; session < GP_TRACE_COMPARISON_SESSIONS_COUNT; session++)
+        {
+            row.m_counts[session] = table.m_counters[session][nameId].m_count;
+            row.m_durations[session] = table.m_counters[session][nameId].m_duration;
+        }
+
+        row.m_newCallsCount = table.m_counters[GP_TRACE_COMPARISON_CURRENT][nameId].m_unalignedCallsCount;
+        row.m_missingCallsCount = table.m_counters[GP_TRACE_COMPARISON_BASELINE][nameId].m_unalignedCallsCount;
+        rows.push_back(row);
+    }
+
+    std::sort(rows.begin(), rows.end(), [](const gpTraceComparisonRow& first, const gpTraceComparisonRow& second) { return first.m_name < second.m_name; });
+}
+
+gpTraceSessionComparer::ThreadAlignment& gpTraceSessionComparer::GetThreadAlignment(gpTraceComparisonSession session, quint64 threadId)
+{
+    std::unordered_map<quint64, size_t>::const_iterator it = m_threadIndexes[session].find(threadId);
+    size_t threadIndex = 0;
+
+    if (it != m_threadIndexes[session].end())
+    {
+        threadIndex = it->second;
+    }
+    else
+    {
+        // The thread ids differ from run to run, so the threads are matched in the order they first call an API:
+        threadIndex = m_threadsCount[session]++;
+        m_threadIndexes[session][threadId] = threadIndex;
+
+        if (threadIndex == m_threadAlignments.size())
+        {
+            m_threadAlignments.push_back(ThreadAlignment());
+        }
+
+        gpTraceComparisonThread& thread = m_threadAlignments[threadIndex].m_thread;
+        thread.m_hasThread[session] = true;
+        thread.m_threadIds[session] = threadId;
+    }
+
+    return m_threadAlignments[threadIndex];
+}
+
+quint32 gpTraceSessionComparer::InternName(NameTable& table, const std::string& name, int clApiId)
+{
+    std::unordered_map<std::string, quint32>::const_iterator it = table.m_nameIds.find(name);
+    quint32 retVal = 0;
+
+    if (it != table.m_nameIds.end())
+    {
+        retVal = it->second;
+    }
+    else
+    {
+        retVal = static_cast<quint32>(table.m_names.size());
+        table.m_nameIds[name] = retVal;
+        table.m_names.push_back(name);
+        table.m_clApiIds.push_back(clApiId);
+
+        for (int session = 0; session < GP_TRACE_COMPARISON_SESSIONS_COUNT; session++)
+        {
+            table.m_counters[session].push_back(Counters());
+        }
+    }
+
+    return retVal;
+}
@@ -0,0 +1,206 @@
+//=============================================================
+// Copyright (c) 2016-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+/// \author GPU Developer Tools
+/// \file
+/// \brief Compares the API calls and kernel dispatches of two trace sessions on a background thread
+//=============================================================
+
+#ifndef __GPTRACESESSIONCOMPARER_H
+#define __GPTRACESESSIONCOMPARER_H
+
+// std
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Qt
+#include <qtIgnoreCompilerWarnings.h>
+#include <QString>
+
+// Local:
+#include <AMDTGpuProfiling/gpTraceSessionIndex.h>
+
+/// The compared sessions
+enum gpTraceComparisonSession
+{
+    GP_TRACE_COMPARISON_BASELINE,           ///< the session compared against ("before")
+    GP_TRACE_COMPARISON_CURRENT,            ///< the compared session ("after")
+    GP_TRACE_COMPARISON_SESSIONS_COUNT
+};
+
+/// The compared calls of an API, or the compared dispatches of a kernel
+struct gpTraceComparisonRow
+{
+    QString m_name;                                                 ///< the API or kernel name
+    int m_clApiId;                                                  ///< the CL_FUNC_TYPE of an OpenCL API, -1 otherwise
+    quint64 m_counts[GP_TRACE_COMPARISON_SESSIONS_COUNT];           ///< the calls or dispatches, per session
+    quint64 m_durations[GP_TRACE_COMPARISON_SESSIONS_COUNT];        ///< the total CPU time (APIs) or device time (kernels), per session, in nanoseconds
+    quint64 m_newCallsCount;                                        ///< APIs: the current session calls not aligned with a baseline call
+    quint64 m_missingCallsCount;                                    ///< APIs: the baseline calls not aligned with a current session call
+
+    gpTraceComparisonRow() : m_clApiId(-1), m_counts(), m_durations(), m_newCallsCount(0), m_missingCallsCount(0) {}
+};
+
+/// The alignment of the API calls of a thread of the baseline with a thread of the current session
+struct gpTraceComparisonThread
+{
+    bool m_hasThread[GP_TRACE_COMPARISON_SESSIONS_COUNT];           ///< true iff the session has the thread
+    quint64 m_threadIds[GP_TRACE_COMPARISON_SESSIONS_COUNT];        ///< the thread id, per session
+    quint64 m_callsCount[GP_TRACE_COMPARISON_SESSIONS_COUNT];       ///< the API calls of the thread, per session
+    quint64 m_matchedCallsCount;                                    ///< the calls aligned in both sessions
+    quint64 m_newCallsCount;                                        ///< the current session calls not aligned with a baseline call
+    quint64 m_missingCallsCount;                                    ///< the baseline calls not aligned with a current session call
+    bool m_hasDivergence;                                           ///< true iff the two sequences of calls differ
+    quint64 m_firstDivergenceCallIndex[GP_TRACE_COMPARISON_SESSIONS_COUNT]; ///< the index, in each session thread, of the first call that is not aligned
+
+    gpTraceComparisonThread() : m_hasThread(), m_threadIds(), m_callsCount(), m_matchedCallsCount(0), m_newCallsCount(0), m_missingCallsCount(0),
+        m_hasDivergence(false), m_firstDivergenceCallIndex() {}
+};
+
+/// The comparison of two trace sessions
+struct gpTraceComparison
+{
+    QString m_traceFilePaths[GP_TRACE_COMPARISON_SESSIONS_COUNT];   ///< the compared trace files
+    std::vector<gpTraceComparisonRow> m_apiRows;                    ///< the compared APIs, ordered by name
+    std::vector<gpTraceComparisonRow> m_kernelRows;                 ///< the compared kernels, ordered by name
+    std::vector<gpTraceComparisonThread> m_threads;                 ///< the aligned threads, in the order they first call an API
+};
+
+/// Compares two trace sessions on a background thread, with a single streaming pass over the records of each session.
+/// The sessions are loaded one after the other with gpTraceLoader (from their session index when it is valid), and only the
+/// per API and per kernel counters, and the API name sequence of each baseline thread (4 bytes per call), are kept in memory.
+/// The threads of the two sessions are matched in the order they first call an API, and the calls of each current session
+/// thread are aligned with the baseline thread calls by name, looking at most ms_ALIGNMENT_WINDOW calls ahead
+class gpTraceSessionComparer
+{
+public:
+    /// The state of the comparison
+    enum CompareState
+    {
+        COMPARE_STATE_IDLE,         ///< no comparison was started
+        COMPARE_STATE_RUNNING,      ///< the sessions are being compared
+        COMPARE_STATE_DONE,         ///< the comparison is available
+        COMPARE_STATE_FAILED,       ///< a trace file could not be loaded
+        COMPARE_STATE_CANCELED      ///< the comparison was canceled
+    };
+
+    /// The number of baseline calls searched for a current session call, before the call is considered new
+    static const unsigned int ms_ALIGNMENT_WINDOW = 256;
+
+    gpTraceSessionComparer();
+    ~gpTraceSessionComparer();
+
+    /// Starts comparing two trace files on the comparer thread
+    /// \param baselineTraceFilePath the trace file compared against
+    /// \param currentTraceFilePath the compared trace file
+    /// \return false if a comparison is already running
+    bool Start(const QString& baselineTraceFilePath, const QString& currentTraceFilePath);
+
+    /// Cancels the running comparison, and waits for the comparer thread to end
+    void Cancel();
+
+    /// Gets the state of the comparison
+    /// \param[out] loadedSession the session being loaded
+    /// \param[out] currentItem the progress of the session load
+    /// \param[out] totalItems the total of the session load progress
+    /// \return the comparison state
+    CompareState GetState(gpTraceComparisonSession& loadedSession, unsigned int& currentItem, unsigned int& totalItems) const;
+
+    /// \return the comparison. Valid only once the state is COMPARE_STATE_DONE
+    const gpTraceComparison& GetComparison() const { return m_comparison; }
+
+    /// Checks if the average duration of an API call or kernel dispatch grew by more than a threshold
+    /// \param row the compared API or kernel
+    /// \param thresholdPercent the threshold, in percents of the baseline average duration
+    /// \return true iff both sessions have calls, and the current session calls are slower by more than the threshold
+    static bool IsRegression(const gpTraceComparisonRow& row, unsigned int thresholdPercent);
+
+    /// \return the average duration, in nanoseconds, of the calls of a session, 0 if it has none
+    static double GetAverageDuration(const gpTraceComparisonRow& row, gpTraceComparisonSession session);
+
+private:
+    /// The counters of an API or a kernel in a session
+    struct Counters
+    {
+        quint64 m_count;                ///< the calls or dispatches
+        quint64 m_duration;             ///< the total duration
+        quint64 m_unalignedCallsCount;  ///< the calls not aligned with a call of the other session (APIs)
+
+        Counters() : m_count(0), m_duration(0), m_unalignedCallsCount(0) {}
+    };
+
+    /// The interned names of the APIs or the kernels, and their counters in each session
+    struct NameTable
+    {
+        std::unordered_map<std::string, quint32> m_nameIds;                     ///< a map from a name to its id
+        std::vector<std::string> m_names;                                       ///< the names, by id
+        std::vector<int> m_clApiIds;                                            ///< the CL_FUNC_TYPE of the names, by id (-1 if none)
+        std::vector<Counters> m_counters[GP_TRACE_COMPARISON_SESSIONS_COUNT];   ///< the counters of each session, by id
+    };
+
+    /// The alignment state of a thread
+    struct ThreadAlignment
+    {
+        gpTraceComparisonThread m_thread;   ///< the aligned thread
+        std::vector<quint32> m_baselineCalls; ///< the API name ids of the baseline thread calls
+        size_t m_baselineCursor;            ///< the first baseline call which is not aligned yet
+
+        ThreadAlignment() : m_baselineCursor(0) {}
+    };
+
+    /// The comparer thread function
+    void CompareThreadFunc();
+
+    /// Streams the records of a trace file into the comparison
+    /// \param session the loaded session
+    /// \return true iff the whole trace file was loaded
+    bool LoadSession(gpTraceComparisonSession session);
+
+    /// Adds a record of a session. Records other than API and dispatch records are ignored
+    void AddRecord(gpTraceComparisonSession session, const gpTraceIndexRecord& record);
+
+    /// Adds an API call of a session, and aligns it when it is a current session call
+    void AddCall(gpTraceComparisonSession session, const gpTraceAPIRecord& apiRecord, int clApiId);
+
+    /// Adds a kernel dispatch of a session
+    void AddDispatch(gpTraceComparisonSession session, const std::string& kernelName, quint64 startTime, quint64 endTime);
+
+    /// Aligns a current session call with the calls of the matching baseline thread
+    void AlignCall(ThreadAlignment& alignment, quint32 nameId);
+
+    /// Marks the baseline calls of a thread, up to a call, as missing from the current session
+    void SkipBaselineCalls(ThreadAlignment& alignment, size_t endCursor);
+
+    /// Marks the calls that remain unaligned once both sessions are loaded, and builds the comparison
+    void BuildComparison();
+
+    /// Builds the rows of a name table
+    void BuildRows(const NameTable& table, std::vector<gpTraceComparisonRow>& rows) const;
+
+    /// Gets the alignment of a session thread, adding the thread if needed
+    ThreadAlignment& GetThreadAlignment(gpTraceComparisonSession session, quint64 threadId);
+
+    /// Gets the id of a name in a name table, adding the name if needed
+    static quint32 InternName(NameTable& table, const std::string& name, int clApiId);
+
+    QString m_traceFilePaths[GP_TRACE_COMPARISON_SESSIONS_COUNT];   ///< the compared trace files
+    std::thread m_thread;                                           ///< the comparer thread
+    std::atomic<bool> m_isCancelRequested;                          ///< true iff the comparer thread should stop
+    std::atomic<int> m_state;                                       ///< the CompareState of the comparison
+    std::atomic<int> m_loadedSession;                               ///< the gpTraceComparisonSession being loaded
+    std::atomic<unsigned int> m_progressCurrentItem;                ///< the progress of the session load
+    std::atomic<unsigned int> m_progressTotalItems;                 ///< the total of the session load progress
+
+    NameTable m_apis;                                               ///< the APIs (comparer thread only)
+    NameTable m_kernels;                                            ///< the kernels (comparer thread only)
+    std::vector<ThreadAlignment> m_threadAlignments;                ///< the aligned threads (comparer thread only)
+    std::unordered_map<quint64, size_t> m_threadIndexes[GP_TRACE_COMPARISON_SESSIONS_COUNT]; ///< a map from a session thread id to its alignment index (comparer thread only)
+    size_t m_threadsCount[GP_TRACE_COMPARISON_SESSIONS_COUNT];      ///< the threads of each session (comparer thread only)
+
+    gpTraceComparison m_comparison;                                 ///< the comparison, once the state is COMPARE_STATE_DONE
+};
+
+#endif // __GPTRACESESSIONCOMPARER_H
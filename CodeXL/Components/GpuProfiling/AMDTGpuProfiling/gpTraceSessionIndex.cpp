@@ -0,0 +1,759 @@
+//=============================================================
+// Copyright (c) 2016-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+/// \author GPU Developer Tools
+/// \file
+/// \brief Binary session index (.atpidx) written next to a trace file, used to re-open a session without re-parsing it
+//=============================================================
+
+#include <qtIgnoreCompilerWarnings.h>
+#include <QtCore>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtAssert.h>
+
+// Local:
+#include <AMDTGpuProfiling/gpTraceSessionIndex.h>
+
+/// Suffix appended to the trace file path to get the index file path
+static const char* s_INDEX_FILE_SUFFIX = "idx";
+
+/// Suffix appended to the index file path while it is being written
+static const char* s_INDEX_TEMP_FILE_SUFFIX = ".tmp";
+
+/// Gets the size and modification time the index is validated against
+static void GetTraceFileStamp(const QString& traceFilePath, qint64& fileSize, qint64& fileModifiedTime)
+{
+    QFileInfo traceFileInfo(traceFilePath);
+    fileSize = traceFileInfo.size();
+    fileModifiedTime = traceFileInfo.lastModified().toMSecsSinceEpoch();
+}
+
+gpTraceAPIRecord::gpTraceAPIRecord() :
+    m_threadId(0), m_startTime(0), m_endTime(0), m_sequenceId(0), m_displaySequenceId(0), m_isSequenceIdDisplayable(false)
+{
+}
+
+void gpTraceAPIRecord::SetFromDataHandler(IAPIInfoDataHandler* pApiInfo)
+{
+    GT_IF_WITH_ASSERT(pApiInfo != nullptr)
+    {
+        m_threadId = static_cast<quint64>(pApiInfo->GetApiThreadId());
+        m_startTime = pApiInfo->GetApiStartTime();
+        m_endTime = pApiInfo->GetApiEndTime();
+        m_sequenceId = pApiInfo->GetApiSequenceId();
+        m_displaySequenceId = pApiInfo->GetApiDisplaySequenceId();
+        m_isSequenceIdDisplayable = pApiInfo->IsApiSequenceIdDisplayble();
+        m_apiName = pApiInfo->GetApiNameString();
+        m_argList = pApiInfo->GetApiArgListString();
+        m_retString = pApiInfo->GetApiRetString();
+    }
+}
+
+gpTraceCLAPIRecord::gpTraceCLAPIRecord() :
+    m_apiId(0), m_apiType(0), m_hasEnqueueInfo(false), m_commandType(0), m_queueTime(0), m_submitTime(0), m_runningTime(0), m_completeTime(0),
+    m_queueId(0), m_contextId(0), m_hasKernelInfo(false), m_hasMemoryInfo(false), m_memoryTransferSize(0), m_hasOtherEnqueueInfo(false),
+    m_hasDataEnqueueInfo(false), m_dataTransferSize(0)
+{
+}
+
+void gpTraceCLAPIRecord::SetFromDataHandler(ICLAPIInfoDataHandler* pClApiInfo)
+{
+    GT_IF_WITH_ASSERT(pClApiInfo != nullptr)
+    {
+        m_api.SetFromDataHandler(pClApiInfo->GetApiInfoDataHandler());
+        m_apiId = pClApiInfo->GetCLApiId();
+
+        CLAPIType apiType = pClApiInfo->GetCLApiType();
+        m_apiType = static_cast<unsigned int>(apiType);
+
+        m_hasEnqueueInfo = false;
+        m_hasKernelInfo = false;
+        m_hasMemoryInfo = false;
+        m_hasOtherEnqueueInfo = false;
+        m_hasDataEnqueueInfo = false;
+
+        if ((apiType & CL_ENQUEUE_BASE_API) == CL_ENQUEUE_BASE_API)
+        {
+            ICLEnqueueApiInfoDataHandler* pEnqueueApiInfo = nullptr;
+            pClApiInfo->IsCLEnqueueAPI(&pEnqueueApiInfo);
+
+            if (pEnqueueApiInfo != nullptr)
+            {
+                m_hasEnqueueInfo = true;
+                m_commandType = pEnqueueApiInfo->GetCLCommandTypeEnum();
+                m_commandTypeString = pEnqueueApiInfo->GetCLCommandTypeString();
+                m_queueTime = pEnqueueApiInfo->GetCLQueueTimestamp();
+                m_submitTime = pEnqueueApiInfo->GetCLSubmitTimestamp();
+                m_runningTime = pEnqueueApiInfo->GetCLRunningTimestamp();
+                m_completeTime = pEnqueueApiInfo->GetCLCompleteTimestamp();
+                m_queueHandleString = pEnqueueApiInfo->GetCLCommandQueueHandleString();
+                m_queueId = pEnqueueApiInfo->GetCLQueueId();
+                m_contextHandleString = pEnqueueApiInfo->GetCLContextHandleString();
+                m_contextId = pEnqueueApiInfo->GetCLContextId();
+                m_deviceName = pEnqueueApiInfo->GetCLDeviceNameString();
+            }
+
+            if ((apiType & CL_ENQUEUE_KERNEL) == CL_ENQUEUE_KERNEL)
+            {
+                ICLKernelApiInfoDataHandler* pKernelApiInfo = nullptr;
+                pClApiInfo->IsCLKernelApiInfo(&pKernelApiInfo);
+
+                if (pKernelApiInfo != nullptr)
+                {
+                    m_hasKernelInfo = true;
+                    m_kernelName = pKernelApiInfo->GetCLKernelNameString();
+                    m_globalWorkSize = pKernelApiInfo->GetCLKernelGlobalWorkGroupSize();
+                    m_localWorkSize = pKernelApiInfo->GetCLKernelWorkGroupSize();
+                }
+            }
+            else if ((apiType & CL_ENQUEUE_MEM) == CL_ENQUEUE_MEM)
+            {
+                ICLMemApiInfoDataHandler* pMemApiInfo = nullptr;
+                pClApiInfo->IsCLMemoryApiInfo(&pMemApiInfo);
+
+                if (pMemApiInfo != nullptr)
+                {
+                    m_hasMemoryInfo = true;
+                    m_memoryTransferSize = static_cast<quint64>(pMemApiInfo->GetCLMemoryTransferSize());
+                }
+            }
+            else if ((apiType & CL_ENQUEUE_OTHER_OPERATIONS) == CL_ENQUEUE_OTHER_OPERATIONS)
+            {
+                ICLOtherEnqueueApiInfoDataHandler* pOtherEnqueueOperationsInfo = nullptr;
+                pClApiInfo->IsCLEnqueueOtherOperations(&pOtherEnqueueOperationsInfo);
+                m_hasOtherEnqueueInfo = (pOtherEnqueueOperationsInfo != nullptr);
+
+                if ((apiType & CL_ENQUEUE_DATA_OPERATIONS) == CL_ENQUEUE_DATA_OPERATIONS)
+                {
+                    ICLDataEnqueueApiInfoDataHandler* pDataEnqueueOperationsInfo = nullptr;
+                    pClApiInfo->IsCLDataEnqueueApi(&pDataEnqueueOperationsInfo);
+
+                    if (pDataEnqueueOperationsInfo != nullptr)
+                    {
+                        m_hasDataEnqueueInfo = true;
+                        m_dataTransferSize = static_cast<quint64>(pDataEnqueueOperationsInfo->GetCLDataTransferSize());
+                    }
+                }
+            }
+        }
+    }
+}
+
+gpTraceHSAAPIRecord::gpTraceHSAAPIRecord() :
+    m_apiId(0), m_isApi(false), m_hasMemoryInfo(false), m_memorySize(0), m_hasTransferInfo(false), m_transferStartTime(0), m_transferEndTime(0),
+    m_hasDispatchInfo(false), m_queueIndex(0)
+{
+}
+
+void gpTraceHSAAPIRecord::SetFromDataHandler(IHSAAPIInfoDataHandler* pHsaApiInfo)
+{
+    GT_IF_WITH_ASSERT(pHsaApiInfo != nullptr)
+    {
+        m_api.SetFromDataHandler(pHsaApiInfo->GetApiInfoDataHandler());
+
+        HSA_API_Type apiId = pHsaApiInfo->GetHSAApiTypeId();
+        m_apiId = static_cast<unsigned int>(apiId);
+        m_isApi = pHsaApiInfo->IsApi();
+
+        m_hasMemoryInfo = false;
+        m_hasTransferInfo = false;
+        m_hasDispatchInfo = false;
+
+        if (m_isApi)
+        {
+            IHSAMemoryApiInfoDataHandler* pHsaMemoryAPIInfo = nullptr;
+            pHsaApiInfo->IsHSAMemoryApi(&pHsaMemoryAPIInfo);
+
+            if (pHsaMemoryAPIInfo != nullptr)
+            {
+                m_hasMemoryInfo = true;
+                m_memorySize = static_cast<quint64>(pHsaMemoryAPIInfo->GetHSAMemoryApiSize());
+
+                IHSAMemoryTransferApiInfoDataHandler* pHsaMemoryTransferAPIInfo = nullptr;
+                pHsaApiInfo->IsHSAMemoryTransferApi(&pHsaMemoryTransferAPIInfo);
+
+                if (pHsaMemoryTransferAPIInfo != nullptr)
+                {
+                    m_hasTransferInfo = true;
+                    m_transferStartTime = pHsaMemoryTransferAPIInfo->GetHSAMemoryTransferStartTime();
+                    m_transferEndTime = pHsaMemoryTransferAPIInfo->GetHSAMemoryTransferEndTime();
+                    m_srcAgentString = pHsaMemoryTransferAPIInfo->GetHSASrcAgentString();
+                    m_dstAgentString = pHsaMemoryTransferAPIInfo->GetHSADestinationAgentString();
+                }
+            }
+        }
+        else if (HSA_API_Type_Non_API_Dispatch == apiId)
+        {
+            IHSADispatchApiInfoDataHandler* pDispatchInfo = nullptr;
+            pHsaApiInfo->IsHSADispatchApi(&pDispatchInfo);
+
+            if (pDispatchInfo != nullptr)
+            {
+                m_hasDispatchInfo = true;
+                m_kernelName = pDispatchInfo->GetHSAKernelName();
+                m_deviceName = pDispatchInfo->GetHSADeviceName();
+                m_queueIndex = pDispatchInfo->GetHSAQueueIndex();
+                m_queueHandleString = pDispatchInfo->GetHSAQueueHandleString();
+                m_globalWorkSize = pDispatchInfo->GetHSAGlobalWorkGroupSize();
+                m_localWorkSize = pDispatchInfo->GetHSAWorkGroupSizeString();
+            }
+        }
+    }
+}
+
+gpTracePerfMarkerRecord::gpTracePerfMarkerRecord() :
+    m_threadId(0), m_timestamp(0), m_markerType(MARKER_UNKNOWN)
+{
+}
+
+void gpTracePerfMarkerRecord::SetFromDataHandler(IPerfMarkerInfoDataHandler* pPerfMarkerEntry)
+{
+    GT_IF_WITH_ASSERT(pPerfMarkerEntry != nullptr)
+    {
+        m_threadId = static_cast<quint64>(pPerfMarkerEntry->GetPerfMarkerThreadId());
+        m_timestamp = pPerfMarkerEntry->GetPerfMarkerTimestamp();
+        m_markerType = MARKER_UNKNOWN;
+        m_name.clear();
+        m_groupName.clear();
+
+        IPerfMarkerBeginInfoDataHandler* pBeginMarkerEntry = nullptr;
+
+        if (pPerfMarkerEntry->IsBeginPerfMarkerEntry(&pBeginMarkerEntry))
+        {
+            m_markerType = MARKER_BEGIN;
+
+            if (pBeginMarkerEntry != nullptr)
+            {
+                m_name = pBeginMarkerEntry->GetPerfMarkerBeginInfoName();
+                m_groupName = pBeginMarkerEntry->GetPerfMarkerBeginInfoGroupName();
+            }
+        }
+        else if (pPerfMarkerEntry->IsEndPerfMarkerEntry())
+        {
+            m_markerType = MARKER_END;
+        }
+        else if (pPerfMarkerEntry->IsEndExPerfMarkerEntry())
+        {
+            m_markerType = MARKER_END_EX;
+
+            IPerfMarkerEndExInfoDataHandler* pEndExMarkerEntry = nullptr;
+            pPerfMarkerEntry->IsEndExPerfMarkerEntry(&pEndExMarkerEntry);
+
+            if (pEndExMarkerEntry != nullptr)
+            {
+                m_name = pEndExMarkerEntry->GetPerfMarkerEndExName();
+                m_groupName = pEndExMarkerEntry->GetPerfMarkerEndExGroupName();
+            }
+        }
+    }
+}
+
+gpTraceSymbolRecord::gpTraceSymbolRecord() :
+    m_threadId(0), m_hasStackEntry(false), m_lineNumber(0)
+{
+}
+
+void gpTraceSymbolRecord::SetFromDataHandler(ISymbolFileEntryInfoDataHandler* pSymFileEntry)
+{
+    GT_IF_WITH_ASSERT(pSymFileEntry != nullptr)
+    {
+        m_threadId = static_cast<quint64>(pSymFileEntry->GetsymbolThreadId());
+        m_hasStackEntry = !pSymFileEntry->IsStackEntryNull();
+        m_lineNumber = 0;
+        m_fileName.clear();
+        m_symbolName.clear();
+        m_apiName.clear();
+
+        if (m_hasStackEntry)
+        {
+            IStackEntryInfoDataHandler* pStackEntryInfoHandler = pSymFileEntry->GetStackEntryInfoHandler();
+
+            if (pStackEntryInfoHandler != nullptr)
+            {
+                m_lineNumber = static_cast<quint64>(pStackEntryInfoHandler->GetLineNumber());
+                m_fileName = pStackEntryInfoHandler->GetFileNameString();
+                m_symbolName = pStackEntryInfoHandler->GetSymbolNameString();
+                m_apiName = pSymFileEntry->GetSymbolApiName();
+            }
+            else
+            {
+                m_hasStackEntry = false;
+            }
+        }
+    }
+}
+
+gpTraceIndexRecord::gpTraceIndexRecord() :
+    m_type(GP_TRACE_INDEX_RECORD_NONE), m_indexOffset(-1), m_apiNumThreadId(0), m_apiNum(0)
+{
+}
+
+QString gpTraceSessionIndex::GetIndexFilePath(const QString& traceFilePath)
+{
+    return traceFilePath + s_INDEX_FILE_SUFFIX;
+}
+
+void gpTraceSessionIndex::RemoveIndexFile(const QString& traceFilePath)
+{
+    QString indexFilePath = GetIndexFilePath(traceFilePath);
+
+    if (QFile::exists(indexFilePath))
+    {
+        QFile::remove(indexFilePath);
+    }
+}
+
+gpTraceSessionIndexWriter::gpTraceSessionIndexWriter() :
+    m_recordCount(0), m_recordCountOffset(0)
+{
+}
+
+gpTraceSessionIndexWriter::~gpTraceSessionIndexWriter()
+{
+    Discard();
+}
+
+bool gpTraceSessionIndexWriter::Open(const QString& traceFilePath)
+{
+    bool retVal = false;
+
+    Discard();
+
+    m_indexFilePath = gpTraceSessionIndex::GetIndexFilePath(traceFilePath);
+    m_file.setFileName(m_indexFilePath + s_INDEX_TEMP_FILE_SUFFIX);
+
+    if (m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qint64 traceFileSize = 0;
+        qint64 traceFileModifiedTime = 0;
+        GetTraceFileStamp(traceFilePath, traceFileSize, traceFileModifiedTime);
+
+        m_stream.setDevice(&m_file);
+        m_stream.setByteOrder(QDataStream::LittleEndian);
+        m_stream << gpTraceSessionIndex::ms_magic << gpTraceSessionIndex::ms_formatVersion << traceFileSize << traceFileModifiedTime;
+
+        // The record count and index size are only known when the index is committed:
+        m_recordCount = 0;
+        m_recordCountOffset = m_file.pos();
+        m_stream << m_recordCount << static_cast<qint64>(0);
+
+        retVal = (m_stream.status() == QDataStream::Ok);
+
+        if (!retVal)
+        {
+            Discard();
+        }
+    }
+
+    return retVal;
+}
+
+void gpTraceSessionIndexWriter::WriteString(const std::string& str)
+{
+    m_stream << static_cast<quint32>(str.size());
+    m_stream.writeRawData(str.data(), static_cast<int>(str.size()));
+}
+
+void gpTraceSessionIndexWriter::WriteAPIRecord(const gpTraceAPIRecord& record)
+{
+    m_stream << record.m_threadId << record.m_startTime << record.m_endTime << record.m_sequenceId << record.m_displaySequenceId << record.m_isSequenceIdDisplayable;
+    WriteString(record.m_apiName);
+    WriteString(record.m_argList);
+    WriteString(record.m_retString);
+}
+
+void gpTraceSessionIndexWriter::Write(const gpTraceIndexRecord& record)
+{
+    if (m_file.isOpen())
+    {
+        m_stream << static_cast<quint8>(record.m_type);
+
+        switch (record.m_type)
+        {
+            case GP_TRACE_INDEX_RECORD_API_NUM:
+                m_stream << record.m_apiNumThreadId << record.m_apiNum;
+                break;
+
+            case GP_TRACE_INDEX_RECORD_CL_API:
+            {
+                const gpTraceCLAPIRecord& cl = record.m_clApi;
+                WriteAPIRecord(cl.m_api);
+                m_stream << cl.m_apiId << cl.m_apiType << cl.m_hasEnqueueInfo << cl.m_hasKernelInfo << cl.m_hasMemoryInfo << cl.m_hasOtherEnqueueInfo << cl.m_hasDataEnqueueInfo;
+
+                if (cl.m_hasEnqueueInfo)
+                {
+                    m_stream << cl.m_commandType << cl.m_queueTime << cl.m_submitTime << cl.m_runningTime << cl.m_completeTime << cl.m_queueId << cl.m_contextId;
+                    WriteString(cl.m_commandTypeString);
+                    WriteString(cl.m_queueHandleString);
+                    WriteString(cl.m_contextHandleString);
+                    WriteString(cl.m_deviceName);
+                }
+
+                if (cl.m_hasKernelInfo)
+                {
+                    WriteString(cl.m_kernelName);
+                    WriteString(cl.m_globalWorkSize);
+                    WriteString(cl.m_localWorkSize);
+                }
+
+                if (cl.m_hasMemoryInfo)
+                {
+                    m_stream << cl.m_memoryTransferSize;
+                }
+
+                if (cl.m_hasDataEnqueueInfo)
+                {
+                    m_stream << cl.m_dataTransferSize;
+                }
+            }
+            break;
+
+            case GP_TRACE_INDEX_RECORD_HSA_API:
+            {
+                const gpTraceHSAAPIRecord& hsa = record.m_hsaApi;
+                WriteAPIRecord(hsa.m_api);
+                m_stream << hsa.m_apiId << hsa.m_isApi << hsa.m_hasMemoryInfo << hsa.m_hasTransferInfo << hsa.m_hasDispatchInfo;
+
+                if (hsa.m_hasMemoryInfo)
+                {
+                    m_stream << hsa.m_memorySize;
+                }
+
+                if (hsa.m_hasTransferInfo)
+                {
+                    m_stream << hsa.m_transferStartTime << hsa.m_transferEndTime;
+                    WriteString(hsa.m_srcAgentString);
+                    WriteString(hsa.m_dstAgentString);
+                }
+
+                if (hsa.m_hasDispatchInfo)
+                {
+                    m_stream << hsa.m_queueIndex;
+                    WriteString(hsa.m_kernelName);
+                    WriteString(hsa.m_deviceName);
+                    WriteString(hsa.m_queueHandleString);
+                    WriteString(hsa.m_globalWorkSize);
+                    WriteString(hsa.m_localWorkSize);
+                }
+            }
+            break;
+
+            case GP_TRACE_INDEX_RECORD_PERF_MARKER:
+            {
+                const gpTracePerfMarkerRecord& marker = record.m_perfMarker;
+                m_stream << marker.m_threadId << marker.m_timestamp << marker.m_markerType;
+                WriteString(marker.m_name);
+                WriteString(marker.m_groupName);
+            }
+            break;
+
+            case GP_TRACE_INDEX_RECORD_SYMBOL:
+            {
+                const gpTraceSymbolRecord& symbol = record.m_symbol;
+                m_stream << symbol.m_threadId << symbol.m_hasStackEntry;
+
+                if (symbol.m_hasStackEntry)
+                {
+                    m_stream << symbol.m_lineNumber;
+                    WriteString(symbol.m_fileName);
+                    WriteString(symbol.m_symbolName);
+                    WriteString(symbol.m_apiName);
+                }
+            }
+            break;
+
+            default:
+                GT_ASSERT_EX(false, L"Unknown session index record type");
+                break;
+        }
+
+        m_recordCount++;
+    }
+}
+
+bool gpTraceSessionIndexWriter::Commit()
+{
+    bool retVal = false;
+
+    if (m_file.isOpen())
+    {
+        qint64 indexSize = m_file.pos();
+
+        if (m_file.seek(m_recordCountOffset))
+        {
+            m_stream << m_recordCount << indexSize;
+        }
+
+        retVal = (m_stream.status() == QDataStream::Ok) && m_file.flush();
+        m_stream.setDevice(nullptr);
+        m_file.close();
+
+        if (retVal)
+        {
+            // QFile::rename does not overwrite an existing file:
+            QFile::remove(m_indexFilePath);
+            retVal = m_file.rename(m_indexFilePath);
+        }
+
+        if (!retVal)
+        {
+            m_file.remove();
+        }
+    }
+
+    return retVal;
+}
+
+void gpTraceSessionIndexWriter::Discard()
+{
+    if (m_file.isOpen())
+    {
+        m_stream.setDevice(nullptr);
+        m_file.close();
+        m_file.remove();
+    }
+}
+
+gpTraceSessionIndexReader::gpTraceSessionIndexReader() :
+    m_pMappedData(nullptr), m_recordCount(0), m_recordsRead(0), m_firstRecordOffset(0), m_isCorrupted(false)
+{
+}
+
+gpTraceSessionIndexReader::~gpTraceSessionIndexReader()
+{
+    Close();
+}
+
+bool gpTraceSessionIndexReader::Open(const QString& traceFilePath)
+{
+    bool retVal = false;
+
+    Close();
+
+    m_file.setFileName(gpTraceSessionIndex::GetIndexFilePath(traceFilePath));
+
+    if (m_file.exists() && m_file.open(QIODevice::ReadOnly) && (m_file.size() > 0))
+    {
+        m_pMappedData = m_file.map(0, m_file.size());
+
+        if (m_pMappedData != nullptr)
+        {
+            // The records are read in place, from the mapped data:
+            m_stream.SetData(m_pMappedData, m_file.size());
+
+            quint32 magic = 0;
+            quint32 formatVersion = 0;
+            qint64 traceFileSize = 0;
+            qint64 traceFileModifiedTime = 0;
+            qint64 indexSize = 0;
+            m_stream >> magic >> formatVersion >> traceFileSize >> traceFileModifiedTime >> m_recordCount >> indexSize;
+            m_firstRecordOffset = m_stream.Pos();
+
+            qint64 currentTraceFileSize = 0;
+            qint64 currentTraceFileModifiedTime = 0;
+            GetTraceFileStamp(traceFilePath, currentTraceFileSize, currentTraceFileModifiedTime);
+
+            retVal = m_stream.IsOk() &&
+                     (magic == gpTraceSessionIndex::ms_magic) &&
+                     (formatVersion == gpTraceSessionIndex::ms_formatVersion) &&
+                     (indexSize == m_file.size()) &&
+                     (traceFileSize == currentTraceFileSize) &&
+                     (traceFileModifiedTime == currentTraceFileModifiedTime);
+        }
+    }
+
+    if (!retVal)
+    {
+        Close();
+    }
+
+    return retVal;
+}
+
+void gpTraceSessionIndexReader::Close()
+{
+    m_stream.SetData(nullptr, 0);
+
+    if (m_pMappedData != nullptr)
+    {
+        m_file.unmap(m_pMappedData);
+        m_pMappedData = nullptr;
+    }
+
+    if (m_file.isOpen())
+    {
+        m_file.close();
+    }
+
+    m_recordCount = 0;
+    m_recordsRead = 0;
+    m_firstRecordOffset = 0;
+    m_isCorrupted = false;
+}
+
+bool gpTraceSessionIndexReader::SeekToRecord(qint64 indexOffset)
+{
+    bool retVal = false;
+
+    if ((m_pMappedData != nullptr) && !m_isCorrupted && (indexOffset >= m_firstRecordOffset) && (indexOffset < m_stream.Size()))
+    {
+        retVal = m_stream.Seek(indexOffset);
+
+        // The records before the offset were not read, so the record count only bounds the reading:
+        m_recordsRead = 0;
+    }
+
+    return retVal;
+}
+
+void gpTraceSessionIndexReader::ReadString(std::string& str)
+{
+    quint32 length = 0;
+    m_stream >> length;
+
+    const char* pChars = m_stream.ReadRawData(static_cast<qint64>(length));
+
+    if (pChars != nullptr)
+    {
+        str.assign(pChars, length);
+    }
+    else
+    {
+        str.clear();
+    }
+}
+
+void gpTraceSessionIndexReader::ReadAPIRecord(gpTraceAPIRecord& record)
+{
+    m_stream >> record.m_threadId >> record.m_startTime >> record.m_endTime >> record.m_sequenceId >> record.m_displaySequenceId >> record.m_isSequenceIdDisplayable;
+    ReadString(record.m_apiName);
+    ReadString(record.m_argList);
+    ReadString(record.m_retString);
+}
+
+bool gpTraceSessionIndexReader::ReadNext(gpTraceIndexRecord& record)
+{
+    bool retVal = false;
+
+    if ((m_pMappedData != nullptr) && !m_isCorrupted && (m_recordsRead < m_recordCount))
+    {
+        record.m_indexOffset = m_stream.Pos();
+
+        quint8 recordType = 0;
+        m_stream >> recordType;
+        record.m_type = static_cast<gpTraceIndexRecordType>(recordType);
+
+        switch (record.m_type)
+        {
+            case GP_TRACE_INDEX_RECORD_API_NUM:
+                m_stream >> record.m_apiNumThreadId >> record.m_apiNum;
+                break;
+
+            case GP_TRACE_INDEX_RECORD_CL_API:
+            {
+                gpTraceCLAPIRecord& cl = record.m_clApi;
+                ReadAPIRecord(cl.m_api);
+                m_stream >> cl.m_apiId >> cl.m_apiType >> cl.m_hasEnqueueInfo >> cl.m_hasKernelInfo >> cl.m_hasMemoryInfo >> cl.m_hasOtherEnqueueInfo >> cl.m_hasDataEnqueueInfo;
+
+                if (cl.m_hasEnqueueInfo)
+                {
+                    m_stream >> cl.m_commandType >> cl.m_queueTime >> cl.m_submitTime >> cl.m_runningTime >> cl.m_completeTime >> cl.m_queueId >> cl.m_contextId;
+                    ReadString(cl.m_commandTypeString);
+                    ReadString(cl.m_queueHandleString);
+                    ReadString(cl.m_contextHandleString);
+                    ReadString(cl.m_deviceName);
+                }
+
+                if (cl.m_hasKernelInfo)
+                {
+                    ReadString(cl.m_kernelName);
+                    ReadString(cl.m_globalWorkSize);
+                    ReadString(cl.m_localWorkSize);
+                }
+
+                if (cl.m_hasMemoryInfo)
+                {
+                    m_stream >> cl.m_memoryTransferSize;
+                }
+
+                if (cl.m_hasDataEnqueueInfo)
+                {
+                    m_stream >> cl.m_dataTransferSize;
+                }
+            }
+            break;
+
+            case GP_TRACE_INDEX_RECORD_HSA_API:
+            {
+                gpTraceHSAAPIRecord& hsa = record.m_hsaApi;
+                ReadAPIRecord(hsa.m_api);
+                m_stream >> hsa.m_apiId >> hsa.m_isApi >> hsa.m_hasMemoryInfo >> hsa.m_hasTransferInfo >> hsa.m_hasDispatchInfo;
+
+                if (hsa.m_hasMemoryInfo)
+                {
+                    m_stream >> hsa.m_memorySize;
+                }
+
+                if (hsa.m_hasTransferInfo)
+                {
+                    m_stream >> hsa.m_transferStartTime >> hsa.m_transferEndTime;
+                    ReadString(hsa.m_srcAgentString);
+                    ReadString(hsa.m_dstAgentString);
+                }
+
+                if (hsa.m_hasDispatchInfo)
+                {
+                    m_stream >> hsa.m_queueIndex;
+                    ReadString(hsa.m_kernelName);
+                    ReadString(hsa.m_deviceName);
+                    ReadString(hsa.m_queueHandleString);
+                    ReadString(hsa.m_globalWorkSize);
+                    ReadString(hsa.m_localWorkSize);
+                }
+            }
+            break;
+
+            case GP_TRACE_INDEX_RECORD_PERF_MARKER:
+            {
+                gpTracePerfMarkerRecord& marker = record.m_perfMarker;
+                m_stream >> marker.m_threadId >> marker.m_timestamp >> marker.m_markerType;
+                ReadString(marker.m_name);
+                ReadString(marker.m_groupName);
+            }
+            break;
+
+            case GP_TRACE_INDEX_RECORD_SYMBOL:
+            {
+                gpTraceSymbolRecord& symbol = record.m_symbol;
+                m_stream >> symbol.m_threadId >> symbol.m_hasStackEntry;
+
+                if (symbol.m_hasStackEntry)
+                {
+                    m_stream >> symbol.m_lineNumber;
+                    ReadString(symbol.m_fileName);
+                    ReadString(symbol.m_symbolName);
+                    ReadString(symbol.m_apiName);
+                }
+            }
+            break;
+
+            default:
+                m_stream.SetCorrupted();
+                break;
+        }
+
+        retVal = m_stream.IsOk();
+
+        if (retVal)
+        {
+            m_recordsRead++;
+        }
+        else
+        {
+            m_isCorrupted = true;
+        }
+    }
+
+    return retVal;
+}
@@ -0,0 +1,383 @@
+//=============================================================
+// Copyright (c) 2016-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+/// \author GPU Developer Tools
+/// \file
+/// \brief Binary session index (.atpidx) written next to a trace file, used to re-open a session without re-parsing it
+//=============================================================
+
+#ifndef __GPTRACESESSIONINDEX_H
+#define __GPTRACESESSIONINDEX_H
+
+// std
+#include <string>
+
+// Qt
+#include <qtIgnoreCompilerWarnings.h>
+#include <QString>
+#include <QFile>
+#include <QtEndian>
+#include <QDataStream>
+
+// BackEnd
+#include <IAtpDataHandler.h>
+
+/// The kinds of records stored in the session index. The values are part of the file format
+enum gpTraceIndexRecordType
+{
+    GP_TRACE_INDEX_RECORD_NONE = 0,         ///< No record
+    GP_TRACE_INDEX_RECORD_API_NUM = 1,      ///< Number of API calls of a thread
+    GP_TRACE_INDEX_RECORD_CL_API = 2,       ///< OpenCL API entry
+    GP_TRACE_INDEX_RECORD_HSA_API = 3,      ///< HSA API or dispatch entry
+    GP_TRACE_INDEX_RECORD_PERF_MARKER = 4,  ///< Perf marker entry
+    GP_TRACE_INDEX_RECORD_SYMBOL = 5        ///< Symbol file entry
+};
+
+/// The data of an API entry that is common to all APIs
+struct gpTraceAPIRecord
+{
+    gpTraceAPIRecord();
+
+    /// Copies the data from the backend parser data handler
+    void SetFromDataHandler(IAPIInfoDataHandler* pApiInfo);
+
+    quint64 m_threadId;                     ///< the thread the API was called from
+    quint64 m_startTime;                    ///< the CPU start time
+    quint64 m_endTime;                      ///< the CPU end time
+    unsigned int m_sequenceId;              ///< the sequence id of the API
+    unsigned int m_displaySequenceId;       ///< the display sequence id of the API
+    bool m_isSequenceIdDisplayable;         ///< true iff the display sequence id should be shown
+    std::string m_apiName;                  ///< the API name
+    std::string m_argList;                  ///< the API argument list
+    std::string m_retString;                ///< the API return value
+};
+
+/// An OpenCL API entry
+struct gpTraceCLAPIRecord
+{
+    gpTraceCLAPIRecord();
+
+    /// Copies the data from the backend parser data handler
+    void SetFromDataHandler(ICLAPIInfoDataHandler* pClApiInfo);
+
+    gpTraceAPIRecord m_api;                 ///< the common API data
+    unsigned int m_apiId;                   ///< the CL_FUNC_TYPE of the API
+    unsigned int m_apiType;                 ///< the CLAPIType mask of the API
+    bool m_hasEnqueueInfo;                  ///< true iff the enqueue fields below are set
+    unsigned int m_commandType;             ///< the enqueued command type
+    std::string m_commandTypeString;        ///< the enqueued command type name
+    quint64 m_queueTime;                    ///< the command queued time
+    quint64 m_submitTime;                   ///< the command submit time
+    quint64 m_runningTime;                  ///< the command start time
+    quint64 m_completeTime;                 ///< the command end time
+    std::string m_queueHandleString;        ///< the command queue handle
+    unsigned int m_queueId;                 ///< the command queue id
+    std::string m_contextHandleString;      ///< the context handle
+    unsigned int m_contextId;               ///< the context id
+    std::string m_deviceName;               ///< the device name
+    bool m_hasKernelInfo;                   ///< true iff the kernel fields below are set
+    std::string m_kernelName;               ///< the kernel name
+    std::string m_globalWorkSize;           ///< the kernel global work size
+    std::string m_localWorkSize;            ///< the kernel work group size
+    bool m_hasMemoryInfo;                   ///< true iff m_memoryTransferSize is set
+    quint64 m_memoryTransferSize;           ///< the memory command transfer size
+    bool m_hasOtherEnqueueInfo;             ///< true iff this is an "other" enqueue operation
+    bool m_hasDataEnqueueInfo;              ///< true iff m_dataTransferSize is set
+    quint64 m_dataTransferSize;             ///< the data enqueue operation size
+};
+
+/// An HSA API or kernel dispatch entry
+struct gpTraceHSAAPIRecord
+{
+    gpTraceHSAAPIRecord();
+
+    /// Copies the data from the backend parser data handler
+    void SetFromDataHandler(IHSAAPIInfoDataHandler* pHsaApiInfo);
+
+    gpTraceAPIRecord m_api;                 ///< the common API data
+    unsigned int m_apiId;                   ///< the HSA_API_Type of the entry
+    bool m_isApi;                           ///< true for an API call, false for a dispatch
+    bool m_hasMemoryInfo;                   ///< true iff m_memorySize is set
+    quint64 m_memorySize;                   ///< the memory API size
+    bool m_hasTransferInfo;                 ///< true iff the transfer fields below are set
+    quint64 m_transferStartTime;            ///< the memory transfer start time
+    quint64 m_transferEndTime;              ///< the memory transfer end time
+    std::string m_srcAgentString;           ///< the memory transfer source agent
+    std::string m_dstAgentString;           ///< the memory transfer destination agent
+    bool m_hasDispatchInfo;                 ///< true iff the dispatch fields below are set
+    std::string m_kernelName;               ///< the dispatched kernel name
+    std::string m_deviceName;               ///< the dispatch device name
+    unsigned int m_queueIndex;              ///< the dispatch queue index
+    std::string m_queueHandleString;        ///< the dispatch queue handle (holds the device index)
+    std::string m_globalWorkSize;           ///< the dispatch global work size
+    std::string m_localWorkSize;            ///< the dispatch work group size
+};
+
+/// A perf marker entry
+struct gpTracePerfMarkerRecord
+{
+    /// The kind of the perf marker entry
+    enum MarkerType
+    {
+        MARKER_UNKNOWN = 0,
+        MARKER_BEGIN = 1,
+        MARKER_END = 2,
+        MARKER_END_EX = 3
+    };
+
+    gpTracePerfMarkerRecord();
+
+    /// Copies the data from the backend parser data handler
+    void SetFromDataHandler(IPerfMarkerInfoDataHandler* pPerfMarkerEntry);
+
+    quint64 m_threadId;                     ///< the thread the marker was set from
+    quint64 m_timestamp;                    ///< the marker time
+    unsigned int m_markerType;              ///< the MarkerType of the entry
+    std::string m_name;                     ///< the marker name (begin and end ex markers)
+    std::string m_groupName;                ///< the marker group (begin and end ex markers)
+};
+
+/// A symbol file entry
+struct gpTraceSymbolRecord
+{
+    gpTraceSymbolRecord();
+
+    /// Copies the data from the backend parser data handler
+    void SetFromDataHandler(ISymbolFileEntryInfoDataHandler* pSymFileEntry);
+
+    quint64 m_threadId;                     ///< the thread of the API the symbol belongs to
+    bool m_hasStackEntry;                   ///< true iff the fields below are set
+    quint64 m_lineNumber;                   ///< the source line number
+    std::string m_fileName;                 ///< the source file name
+    std::string m_symbolName;               ///< the symbol name
+    std::string m_apiName;                  ///< the API name
+};
+
+/// A single record of the session index. Only the member matching m_type is valid.
+/// The members are reused between records, so that reading a large index does not allocate per record
+struct gpTraceIndexRecord
+{
+    gpTraceIndexRecord();
+
+    gpTraceIndexRecordType m_type;          ///< the record type
+    qint64 m_indexOffset;                   ///< the offset of the record in the session index, or -1 if the record is not in an index
+    quint64 m_apiNumThreadId;               ///< GP_TRACE_INDEX_RECORD_API_NUM: the thread id
+    unsigned int m_apiNum;                  ///< GP_TRACE_INDEX_RECORD_API_NUM: the number of API calls of the thread
+    gpTraceCLAPIRecord m_clApi;             ///< GP_TRACE_INDEX_RECORD_CL_API
+    gpTraceHSAAPIRecord m_hsaApi;           ///< GP_TRACE_INDEX_RECORD_HSA_API
+    gpTracePerfMarkerRecord m_perfMarker;   ///< GP_TRACE_INDEX_RECORD_PERF_MARKER
+    gpTraceSymbolRecord m_symbol;           ///< GP_TRACE_INDEX_RECORD_SYMBOL
+};
+
+/// Helpers for the session index file
+class gpTraceSessionIndex
+{
+public:
+    /// Gets the index file path for a trace file ("<session>.atp" -> "<session>.atpidx")
+    /// \param traceFilePath the trace file path
+    /// \return the index file path
+    static QString GetIndexFilePath(const QString& traceFilePath);
+
+    /// Removes the index file of a trace file, if it exists
+    /// \param traceFilePath the trace file path
+    static void RemoveIndexFile(const QString& traceFilePath);
+
+    /// The index file magic ("CXLI")
+    static const quint32 ms_magic = 0x494C5843;
+
+    /// The index file format version. Bump it whenever a record layout changes
+    static const quint32 ms_formatVersion = 1;
+};
+
+/// Writes the records of a trace file, in parse order, to its session index.
+/// The index is written to a temporary file, which replaces the index only when Commit is called
+class gpTraceSessionIndexWriter
+{
+public:
+    gpTraceSessionIndexWriter();
+    ~gpTraceSessionIndexWriter();
+
+    /// Starts writing the index of the specified trace file
+    /// \param traceFilePath the trace file path
+    /// \return true on success
+    bool Open(const QString& traceFilePath);
+
+    /// Appends a record to the index. Write failures are reported by Commit
+    /// \param record the record to write
+    void Write(const gpTraceIndexRecord& record);
+
+    /// Completes the index and replaces the existing index file with it
+    /// \return true on success
+    bool Commit();
+
+    /// Discards the index written so far
+    void Discard();
+
+    /// \return true iff the writer was opened and not yet committed or discarded
+    bool IsOpen() const { return m_file.isOpen(); }
+
+    /// \return the offset the next written record will have in the index, or -1 if the writer is not open
+    qint64 GetNextRecordOffset() const { return m_file.isOpen() ? m_file.pos() : -1; }
+
+private:
+    /// Writes the common API fields
+    void WriteAPIRecord(const gpTraceAPIRecord& record);
+
+    /// Writes a length prefixed string
+    void WriteString(const std::string& str);
+
+    QString m_indexFilePath;                ///< the final index file path
+    QFile m_file;                           ///< the temporary index file
+    QDataStream m_stream;                   ///< the stream writing to m_file
+    quint64 m_recordCount;                  ///< number of records written so far
+    qint64 m_recordCountOffset;             ///< the position of the record count and index size in the header
+};
+
+/// Reads the values written by the index QDataStream (little endian) directly from the mapped index file, without copying it.
+/// Offsets are 64 bit, so that indices larger than 2GB can be read
+class gpTraceIndexMappedStream
+{
+public:
+    gpTraceIndexMappedStream() : m_pData(nullptr), m_size(0), m_pos(0), m_isOk(false) {}
+
+    /// Sets the read memory, and moves to its beginning
+    /// \param pData the mapped data, nullptr to detach the stream
+    /// \param size the mapped data size
+    void SetData(const uchar* pData, qint64 size) { m_pData = pData; m_size = size; m_pos = 0; m_isOk = (pData != nullptr); }
+
+    /// \return the offset of the next read value
+    qint64 Pos() const { return m_pos; }
+
+    /// \return the mapped data size
+    qint64 Size() const { return m_size; }
+
+    /// \return the number of bytes after the read offset
+    qint64 BytesAvailable() const { return m_size - m_pos; }
+
+    /// \return false once a read went past the end of the data, or the data was marked as corrupted
+    bool IsOk() const { return m_isOk; }
+
+    /// Marks the data as corrupted
+    void SetCorrupted() { m_isOk = false; }
+
+    /// Moves the read offset
+    /// \param pos the new offset
+    /// \return false if the offset is out of the data
+    bool Seek(qint64 pos)
+    {
+        bool retVal = (m_pData != nullptr) && (pos >= 0) && (pos <= m_size);
+
+        if (retVal)
+        {
+            m_pos = pos;
+        }
+
+        return retVal;
+    }
+
+    /// Reads a little endian integer
+    template <typename T>
+    gpTraceIndexMappedStream& operator>>(T& value)
+    {
+        if (m_isOk && (BytesAvailable() >= static_cast<qint64>(sizeof(T))))
+        {
+            value = qFromLittleEndian<T>(m_pData + m_pos);
+            m_pos += sizeof(T);
+        }
+        else
+        {
+            value = T();
+            m_isOk = false;
+        }
+
+        return *this;
+    }
+
+    /// Reads a boolean, written by QDataStream as a single byte
+    gpTraceIndexMappedStream& operator>>(bool& value)
+    {
+        quint8 byteValue = 0;
+        *this >> byteValue;
+        value = (byteValue != 0);
+        return *this;
+    }
+
+    /// Gets a pointer to raw bytes, and moves past them
+    /// \param length the number of bytes
+    /// \return the bytes, nullptr if there are not enough bytes
+    const char* ReadRawData(qint64 length)
+    {
+        const char* pRetVal = nullptr;
+
+        if (m_isOk && (length >= 0) && (BytesAvailable() >= length))
+        {
+            pRetVal = reinterpret_cast<const char*>(m_pData + m_pos);
+            m_pos += length;
+        }
+        else
+        {
+            m_isOk = false;
+        }
+
+        return pRetVal;
+    }
+
+private:
+    const uchar* m_pData;                   ///< the mapped data
+    qint64 m_size;                          ///< the mapped data size
+    qint64 m_pos;                           ///< the offset of the next read value
+    bool m_isOk;                            ///< false once a read failed
+};
+
+/// Reads the records of a session index, from a memory mapped view of the index file
+class gpTraceSessionIndexReader
+{
+public:
+    gpTraceSessionIndexReader();
+    ~gpTraceSessionIndexReader();
+
+    /// Opens the index of the specified trace file. Fails if there is no index, or if it was written by
+    /// another format version or for another version of the trace file (size or modification time mismatch)
+    /// \param traceFilePath the trace file path
+    /// \return true iff the index is valid and can be read
+    bool Open(const QString& traceFilePath);
+
+    /// Closes the index
+    void Close();
+
+    /// Reads the next record, and sets its m_indexOffset
+    /// \param record the record to fill
+    /// \return false when there are no more records, or when the index is corrupted
+    bool ReadNext(gpTraceIndexRecord& record);
+
+    /// Moves to the record at the specified offset, so that it is the next record read
+    /// \param indexOffset the m_indexOffset of the record
+    /// \return false if the offset is not within the index records
+    bool SeekToRecord(qint64 indexOffset);
+
+    /// \return the number of records in the index
+    quint64 GetRecordCount() const { return m_recordCount; }
+
+    /// \return the number of records read so far
+    quint64 GetRecordsRead() const { return m_recordsRead; }
+
+    /// \return true iff the index was corrupted, i.e. a record could not be read
+    bool IsCorrupted() const { return m_isCorrupted; }
+
+private:
+    /// Reads the common API fields
+    void ReadAPIRecord(gpTraceAPIRecord& record);
+
+    /// Reads a length prefixed string
+    void ReadString(std::string& str);
+
+    QFile m_file;                           ///< the index file
+    uchar* m_pMappedData;                   ///< the mapped index file
+    gpTraceIndexMappedStream m_stream;      ///< reads the records from m_pMappedData
+    quint64 m_recordCount;                  ///< number of records in the index
+    quint64 m_recordsRead;                  ///< number of records read so far
+    qint64 m_firstRecordOffset;             ///< the offset of the first record, after the header
+    bool m_isCorrupted;                     ///< true iff reading a record failed
+};
+
+#endif // __GPTRACESESSIONINDEX_H
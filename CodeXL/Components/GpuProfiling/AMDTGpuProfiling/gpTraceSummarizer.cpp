@@ -0,0 +1,998 @@
+//=============================================================
+// Copyright (c) 2016-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+/// \author GPU Developer Tools
+/// \file
+/// \brief Computes the API, context, kernel, top data transfer and best practices summaries of a trace from its parsed records
+//=============================================================
+
+#include <qtIgnoreCompilerWarnings.h>
+#include <QtCore>
+
+// std
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+// Infra:
+#include <AMDTBaseTools/Include/gtAssert.h>
+
+// Backend:
+#include <HSAFunctionDefs.h>
+
+// Local:
+#include <AMDTGpuProfiling/gpTraceSummarizer.h>
+#include <AMDTGpuProfiling/gpStringConstants.h>
+#include <AMDTGpuProfiling/CLAPIDefs.h>
+
+/// The wavefront size that kernel work-group sizes should be a multiple of
+static const quint64 s_WAVEFRONT_SIZE = 64;
+
+/// Memory transfers smaller than this number of bytes are reported as small transfers
+static const quint64 s_SMALL_TRANSFER_SIZE = 4096;
+
+/// The index of the blocking flag in the arguments of the blocking read, write and map APIs
+static const int s_BLOCKING_ARGUMENT_INDEX = 2;
+
+/// The index of the buffer in the arguments of the buffer read APIs, and of the flags in the arguments of clCreateBuffer
+static const int s_BUFFER_ARGUMENT_INDEX = 1;
+
+/// \return the milliseconds of a duration in nanoseconds
+static double ToMilliseconds(quint64 duration)
+{
+    return static_cast<double>(duration) / 1000000.0;
+}
+
+/// \return true iff the range [itemStart, itemEnd] overlaps the range [startTime, endTime]
+static bool IsInRange(quint64 itemStart, quint64 itemEnd, quint64 startTime, quint64 endTime)
+{
+    return (itemStart <= endTime) && (itemEnd >= startTime);
+}
+
+/// \return true iff the OpenCL API has a blocking flag as its third argument
+static bool HasBlockingArgument(unsigned int apiId)
+{
+    bool retVal = false;
+
+    switch (apiId)
+    {
+        case CL_FUNC_TYPE_clEnqueueReadBuffer:
+        case CL_FUNC_TYPE_clEnqueueReadBufferRect:
+        case CL_FUNC_TYPE_clEnqueueWriteBuffer:
+        case CL_FUNC_TYPE_clEnqueueWriteBufferRect:
+        case CL_FUNC_TYPE_clEnqueueReadImage:
+        case CL_FUNC_TYPE_clEnqueueWriteImage:
+        case CL_FUNC_TYPE_clEnqueueMapBuffer:
+        case CL_FUNC_TYPE_clEnqueueMapImage:
+            retVal = true;
+            break;
+
+        default:
+            break;
+    }
+
+    return retVal;
+}
+
+/// \return true iff the OpenCL API is deprecated in recent versions of OpenCL
+static bool IsDeprecatedAPI(unsigned int apiId)
+{
+    bool retVal = false;
+
+    switch (apiId)
+    {
+        case CL_FUNC_TYPE_clCreateImage2D:
+        case CL_FUNC_TYPE_clCreateImage3D:
+        case CL_FUNC_TYPE_clEnqueueMarker:
+        case CL_FUNC_TYPE_clEnqueueWaitForEvents:
+        case CL_FUNC_TYPE_clEnqueueBarrier:
+        case CL_FUNC_TYPE_clUnloadCompiler:
+        case CL_FUNC_TYPE_clGetExtensionFunctionAddress:
+        case CL_FUNC_TYPE_clSetCommandQueueProperty:
+            retVal = true;
+            break;
+
+        default:
+            break;
+    }
+
+    return retVal;
+}
+
+/// \return true iff the OpenCL API reads a buffer back to the host
+static bool IsBufferReadAPI(unsigned int apiId)
+{
+    return (CL_FUNC_TYPE_clEnqueueReadBuffer == apiId) || (CL_FUNC_TYPE_clEnqueueReadBufferRect == apiId);
+}
+
+/// \return true iff a return value or an argument is a non null object handle
+static bool IsObjectHandle(const std::string& value)
+{
+    return (value.compare(0, 2, "0x") == 0) && (value.find_first_not_of('0', 2) != std::string::npos);
+}
+
+/// Gets an argument from an API argument list (the arguments are separated by ';')
+/// \param argList the argument list
+/// \param argumentIndex the index of the argument
+/// \param[out] argument the trimmed argument
+/// \return false if the list has less arguments
+static bool GetArgument(const std::string& argList, int argumentIndex, std::string& argument)
+{
+    size_t argumentStart = 0;
+
+    for (int i = 0; (i < argumentIndex) && (argumentStart != std::string::npos); i++)
+    {
+        argumentStart = argList.find(';', argumentStart);
+
+        if (argumentStart != std::string::npos)
+        {
+            argumentStart++;
+        }
+    }
+
+    bool retVal = (argumentStart != std::string::npos);
+
+    if (retVal)
+    {
+        size_t argumentEnd = argList.find(';', argumentStart);
+        argument = argList.substr(argumentStart, (argumentEnd == std::string::npos) ? std::string::npos : argumentEnd - argumentStart);
+
+        size_t first = argument.find_first_not_of(" \t");
+        size_t last = argument.find_last_not_of(" \t");
+        argument = (first == std::string::npos) ? std::string() : argument.substr(first, last - first + 1);
+    }
+
+    return retVal;
+}
+
+gpTraceSummarizer::gpTraceSummarizer() :
+    m_startTime(0),
+    m_endTime(0),
+    m_hasCLRecords(false),
+    m_hasHSARecords(false)
+{
+}
+
+void gpTraceSummarizer::Clear()
+{
+    m_internedStrings.clear();
+    m_internedStringIds.clear();
+    m_threadIds.clear();
+    m_callStartTimes.clear();
+    m_callEndTimes.clear();
+    m_callNameIds.clear();
+    m_callThreadIndexes.clear();
+    m_callSequenceIds.clear();
+    m_callBuckets.clear();
+    m_openCallBuckets.clear();
+    m_commands.clear();
+    m_messages.clear();
+    m_trackedObjects.clear();
+    m_liveObjectIndexes.clear();
+    m_queueIdleStates.clear();
+    m_startTime = 0;
+    m_endTime = 0;
+    m_hasCLRecords = false;
+    m_hasHSARecords = false;
+}
+
+void gpTraceSummarizer::AddRecord(const gpTraceIndexRecord& record)
+{
+    if (GP_TRACE_INDEX_RECORD_CL_API == record.m_type)
+    {
+        m_hasCLRecords = true;
+        AddCLRecord(record.m_clApi);
+    }
+    else if (GP_TRACE_INDEX_RECORD_HSA_API == record.m_type)
+    {
+        m_hasHSARecords = true;
+        AddHSARecord(record.m_hsaApi);
+    }
+}
+
+void gpTraceSummarizer::AddCLRecord(const gpTraceCLAPIRecord& clApiRecord)
+{
+    const gpTraceAPIRecord& apiRecord = clApiRecord.m_api;
+    QString apiName;
+
+    if (clApiRecord.m_apiId < CL_FUNC_TYPE_Unknown)
+    {
+        apiName = CLAPIDefs::Instance()->GetOpenCLAPIString(CL_FUNC_TYPE(clApiRecord.m_apiId));
+    }
+    else
+    {
+        apiName = QString::fromStdString(apiRecord.m_apiName);
+    }
+
+    // An error returned by the API:
+    const std::string& retString = apiRecord.m_retString;
+    bool isError = (retString.compare(0, 3, "CL_") == 0) && (retString != "CL_SUCCESS");
+
+    // A blocking read, write or map:
+    std::string blockingArgument;
+    bool isBlockingTransfer = HasBlockingArgument(clApiRecord.m_apiId) && GetArgument(apiRecord.m_argList, s_BLOCKING_ARGUMENT_INDEX, blockingArgument) && (blockingArgument == "CL_TRUE");
+
+    CLAPIType apiType = static_cast<CLAPIType>(clApiRecord.m_apiType);
+    bool isEnqueue = ((apiType & CL_ENQUEUE_BASE_API) == CL_ENQUEUE_BASE_API);
+    bool hasCommand = isEnqueue && clApiRecord.m_hasEnqueueInfo;
+
+    // A call to a deprecated API:
+    bool isDeprecated = IsDeprecatedAPI(clApiRecord.m_apiId);
+
+    // A read back of a buffer in host-visible device memory:
+    std::string bufferHandle;
+    const TrackedObject* pReadBuffer = (IsBufferReadAPI(clApiRecord.m_apiId) && GetArgument(apiRecord.m_argList, s_BUFFER_ARGUMENT_INDEX, bufferHandle)) ? FindTrackedObject(bufferHandle) : nullptr;
+    bool isPersistentMemoryRead = (pReadBuffer != nullptr) && pReadBuffer->m_isPersistentMemory;
+    quint32 readBufferHandleId = (pReadBuffer != nullptr) ? pReadBuffer->m_handleId : INVALID_INDEX;
+
+    // A clFinish of a queue which has no commands since it was last synchronized, by clFinish or by a blocking transfer (the queues are in order):
+    bool isFinish = (CL_FUNC_TYPE_clFinish == clApiRecord.m_apiId);
+    bool isRedundantSync = false;
+    std::string queueHandle;
+
+    if (!isError && (isEnqueue || isFinish) && GetArgument(apiRecord.m_argList, 0, queueHandle))
+    {
+        bool& isQueueIdle = m_queueIdleStates[queueHandle];
+        isRedundantSync = isFinish && isQueueIdle;
+        isQueueIdle = isFinish || isBlockingTransfer;
+    }
+
+    // The objects created, retained or released by the call:
+    CLAPIGroups apiGroups = (clApiRecord.m_apiId < CL_FUNC_TYPE_Unknown) ? CLAPIDefs::Instance()->GetCLAPIGroup(CL_FUNC_TYPE(clApiRecord.m_apiId)) : CLAPIGroup_Unknown;
+    bool isCreate = ((apiGroups & CLAPIGroup_CLObjectCreate) != 0) && IsObjectHandle(retString);
+
+    quint32 callIndex = AddCall(apiRecord, apiName, isError || isBlockingTransfer || hasCommand || isDeprecated || isPersistentMemoryRead || isRedundantSync || isCreate);
+
+    if (isError)
+    {
+        Message message = { callIndex, MESSAGE_API_ERROR, InternString(retString), 0 };
+        m_messages.push_back(message);
+    }
+    else if ((apiGroups & (CLAPIGroup_CLObjectCreate | CLAPIGroup_CLObjectRetain | CLAPIGroup_CLObjectRelease)) != 0)
+    {
+        TrackObject(callIndex, clApiRecord, apiGroups);
+    }
+
+    if (isBlockingTransfer)
+    {
+        Message message = { callIndex, MESSAGE_BLOCKING_TRANSFER, INVALID_INDEX, 0 };
+        m_messages.push_back(message);
+    }
+
+    if (isDeprecated)
+    {
+        Message message = { callIndex, MESSAGE_DEPRECATED_API, INVALID_INDEX, 0 };
+        m_messages.push_back(message);
+    }
+
+    if (isPersistentMemoryRead)
+    {
+        Message message = { callIndex, MESSAGE_PERSISTENT_MEMORY_READ, readBufferHandleId, 0 };
+        m_messages.push_back(message);
+    }
+
+    if (isRedundantSync)
+    {
+        Message message = { callIndex, MESSAGE_REDUNDANT_SYNC, InternString(queueHandle), 0 };
+        m_messages.push_back(message);
+    }
+
+    if (hasCommand)
+    {
+        Command command;
+        command.m_callIndex = callIndex;
+        command.m_threadIndex = m_callThreadIndexes[callIndex];
+        command.m_sequenceId = apiRecord.m_sequenceId;
+        command.m_kind = COMMAND_OTHER;
+        command.m_nameId = InternString(clApiRecord.m_commandTypeString);
+        command.m_deviceNameId = InternString(clApiRecord.m_deviceName);
+        command.m_globalWorkSizeId = INVALID_INDEX;
+        command.m_localWorkSizeId = INVALID_INDEX;
+        command.m_contextId = clApiRecord.m_contextId;
+        command.m_startTime = clApiRecord.m_runningTime;
+        command.m_endTime = clApiRecord.m_completeTime;
+        command.m_size = 0;
+
+        if (((apiType & CL_ENQUEUE_KERNEL) == CL_ENQUEUE_KERNEL) && clApiRecord.m_hasKernelInfo)
+        {
+            command.m_kind = COMMAND_KERNEL;
+            command.m_nameId = InternString(clApiRecord.m_kernelName);
+            command.m_globalWorkSizeId = InternString(clApiRecord.m_globalWorkSize);
+            command.m_localWorkSizeId = InternString(clApiRecord.m_localWorkSize);
+
+            AddWorkGroupSizeMessages(callIndex, clApiRecord.m_kernelName, clApiRecord.m_localWorkSize);
+        }
+        else if (((apiType & CL_ENQUEUE_MEM) == CL_ENQUEUE_MEM) && clApiRecord.m_hasMemoryInfo)
+        {
+            command.m_kind = COMMAND_MEMORY_TRANSFER;
+            command.m_size = clApiRecord.m_memoryTransferSize;
+
+            if ((command.m_size > 0) && (command.m_size < s_SMALL_TRANSFER_SIZE))
+            {
+                Message message = { callIndex, MESSAGE_SMALL_TRANSFER, INVALID_INDEX, command.m_size };
+                m_messages.push_back(message);
+            }
+        }
+        else if (clApiRecord.m_hasDataEnqueueInfo)
+        {
+            command.m_size = clApiRecord.m_dataTransferSize;
+        }
+
+        AddCommand(command);
+    }
+}
+
+void gpTraceSummarizer::AddHSARecord(const gpTraceHSAAPIRecord& hsaApiRecord)
+{
+    const gpTraceAPIRecord& apiRecord = hsaApiRecord.m_api;
+
+    if (hsaApiRecord.m_isApi)
+    {
+        // An error returned by the API:
+        bool isError = (apiRecord.m_retString.compare(0, 16, "HSA_STATUS_ERROR") == 0);
+        bool hasCommand = hsaApiRecord.m_hasMemoryInfo && hsaApiRecord.m_hasTransferInfo;
+
+        quint32 callIndex = AddCall(apiRecord, QString::fromStdString(apiRecord.m_apiName), isError || hasCommand);
+
+        if (isError)
+        {
+            Message message = { callIndex, MESSAGE_API_ERROR, InternString(apiRecord.m_retString), 0 };
+            m_messages.push_back(message);
+        }
+
+        if (hasCommand)
+        {
+            Command command;
+            command.m_callIndex = callIndex;
+            command.m_threadIndex = m_callThreadIndexes[callIndex];
+            command.m_sequenceId = apiRecord.m_sequenceId;
+            command.m_kind = COMMAND_MEMORY_TRANSFER;
+            command.m_nameId = m_callNameIds[callIndex];
+            command.m_deviceNameId = InternString(hsaApiRecord.m_srcAgentString + " -> " + hsaApiRecord.m_dstAgentString);
+            command.m_globalWorkSizeId = INVALID_INDEX;
+            command.m_localWorkSizeId = INVALID_INDEX;
+            command.m_contextId = INVALID_INDEX;
+            command.m_startTime = hsaApiRecord.m_transferStartTime;
+            command.m_endTime = hsaApiRecord.m_transferEndTime;
+            command.m_size = hsaApiRecord.m_memorySize;
+
+            if ((command.m_startTime != 0) && (command.m_endTime != 0))
+            {
+                AddCommand(command);
+            }
+        }
+    }
+    else if ((HSA_API_Type_Non_API_Dispatch == static_cast<HSA_API_Type>(hsaApiRecord.m_apiId)) && hsaApiRecord.m_hasDispatchInfo)
+    {
+        Command command;
+        command.m_callIndex = INVALID_INDEX;
+        command.m_threadIndex = GetThreadIndex(apiRecord.m_threadId);
+        command.m_sequenceId = apiRecord.m_sequenceId;
+        command.m_kind = COMMAND_KERNEL;
+        command.m_nameId = InternString(hsaApiRecord.m_kernelName);
+        command.m_deviceNameId = InternString(hsaApiRecord.m_deviceName);
+        command.m_globalWorkSizeId = InternString(hsaApiRecord.m_globalWorkSize);
+        command.m_localWorkSizeId = InternString(hsaApiRecord.m_localWorkSize);
+        command.m_contextId = hsaApiRecord.m_queueIndex;
+        command.m_startTime = apiRecord.m_startTime;
+        command.m_endTime = apiRecord.m_endTime;
+        command.m_size = 0;
+
+        AddCommand(command);
+    }
+}
+
+quint32 gpTraceSummarizer::AddCall(const gpTraceAPIRecord& apiRecord, const QString& apiName, bool isReferenced)
+{
+    quint32 retVal = INVALID_INDEX;
+    bool isFirst = IsEmpty();
+    quint64 callEndTime = std::max(apiRecord.m_startTime, apiRecord.m_endTime);
+    quint32 nameId = InternString(apiName);
+    quint32 threadIndex = GetThreadIndex(apiRecord.m_threadId);
+
+    if (isReferenced || (m_callStartTimes.size() < ms_MAX_DETAILED_CALLS))
+    {
+        retVal = static_cast<quint32>(m_callStartTimes.size());
+        m_callStartTimes.push_back(apiRecord.m_startTime);
+        m_callEndTimes.push_back(callEndTime);
+        m_callNameIds.push_back(nameId);
+        m_callThreadIndexes.push_back(threadIndex);
+        m_callSequenceIds.push_back(apiRecord.m_sequenceId);
+    }
+    else
+    {
+        AddCallToBucket(apiRecord, nameId, threadIndex);
+    }
+
+    m_startTime = isFirst ? apiRecord.m_startTime : std::min(m_startTime, apiRecord.m_startTime);
+    m_endTime = std::max(m_endTime, callEndTime);
+
+    return retVal;
+}
+
+void gpTraceSummarizer::AddCallToBucket(const gpTraceAPIRecord& apiRecord, quint32 nameId, quint32 threadIndex)
+{
+    quint64 callEndTime = std::max(apiRecord.m_startTime, apiRecord.m_endTime);
+    quint64 duration = callEndTime - apiRecord.m_startTime;
+
+    // The calls of a thread are collected in order, so only the last bucket of each thread and API can still be filled:
+    quint64 bucketKey = (static_cast<quint64>(threadIndex) << 32) | nameId;
+    std::unordered_map<quint64, size_t>::iterator it = m_openCallBuckets.find(bucketKey);
+
+    if ((it == m_openCallBuckets.end()) ||
+        ((m_callBuckets[it->second].m_startTime / ms_CALL_BUCKET_DURATION) != (apiRecord.m_startTime / ms_CALL_BUCKET_DURATION)))
+    {
+        CallBucket bucket = { nameId, threadIndex, apiRecord.m_startTime, callEndTime, 0, 0, duration, duration };
+        m_openCallBuckets[bucketKey] = m_callBuckets.size();
+        m_callBuckets.push_back(bucket);
+        it = m_openCallBuckets.find(bucketKey);
+    }
+
+    CallBucket& bucket = m_callBuckets[it->second];
+    bucket.m_startTime = std::min(bucket.m_startTime, apiRecord.m_startTime);
+    bucket.m_endTime = std::max(bucket.m_endTime, callEndTime);
+    bucket.m_callsCount++;
+    bucket.m_totalTime += duration;
+    bucket.m_maxTime = std::max(bucket.m_maxTime, duration);
+    bucket.m_minTime = std::min(bucket.m_minTime, duration);
+}
+
+void gpTraceSummarizer::AddCommand(const Command& command)
+{
+    // Commands without valid device times are not shown in the timeline, and are not summarized:
+    if (command.m_endTime >= command.m_startTime)
+    {
+        m_startTime = IsEmpty() ? command.m_startTime : std::min(m_startTime, command.m_startTime);
+        m_endTime = std::max(m_endTime, command.m_endTime);
+        m_commands.push_back(command);
+    }
+}
+
+void gpTraceSummarizer::AddWorkGroupSizeMessages(quint32 callIndex, const std::string& kernelName, const std::string& localWorkSize)
+{
+    // The work-group size is written as "{x,y,z}", or as "NULL" when the runtime chooses it:
+    quint64 workGroupSize = 1;
+    quint64 dimension = 0;
+    bool hasDimensions = false;
+    bool isInDimension = false;
+
+    for (char c : localWorkSize)
+    {
+        if ((c >= '0') && (c <= '9'))
+        {
+            dimension = (dimension * 10) + static_cast<quint64>(c - '0');
+            isInDimension = true;
+        }
+        else if (isInDimension)
+        {
+            workGroupSize *= dimension;
+            dimension = 0;
+            isInDimension = false;
+            hasDimensions = true;
+        }
+    }
+
+    if (isInDimension)
+    {
+        workGroupSize *= dimension;
+        hasDimensions = true;
+    }
+
+    if (!hasDimensions)
+    {
+        Message message = { callIndex, MESSAGE_RUNTIME_WORK_GROUP_SIZE, InternString(kernelName), 0 };
+        m_messages.push_back(message);
+    }
+    else if ((workGroupSize % s_WAVEFRONT_SIZE) != 0)
+    {
+        Message message = { callIndex, MESSAGE_WORK_GROUP_SIZE_NOT_MULTIPLE, InternString(kernelName), workGroupSize };
+        m_messages.push_back(message);
+    }
+}
+
+void gpTraceSummarizer::TrackObject(quint32 callIndex, const gpTraceCLAPIRecord& clApiRecord, unsigned int apiGroups)
+{
+    const gpTraceAPIRecord& apiRecord = clApiRecord.m_api;
+
+    if ((apiGroups & CLAPIGroup_CLObjectCreate) != 0)
+    {
+        if (IsObjectHandle(apiRecord.m_retString))
+        {
+            std::string flagsArgument;
+            bool isPersistentMemory = (CL_FUNC_TYPE_clCreateBuffer == clApiRecord.m_apiId) && GetArgument(apiRecord.m_argList, s_BUFFER_ARGUMENT_INDEX, flagsArgument) &&
+                                      (flagsArgument.find("CL_MEM_USE_PERSISTENT_MEM_AMD") != std::string::npos);
+
+            // The handle of a released object may be reused by a new object:
+            TrackedObject object = { callIndex, InternString(apiRecord.m_retString), 1, isPersistentMemory };
+            m_liveObjectIndexes[apiRecord.m_retString] = m_trackedObjects.size();
+            m_trackedObjects.push_back(object);
+        }
+    }
+    else
+    {
+        // The object is the first argument of the retain and release APIs. Objects that were not created by the trace calls are not tracked:
+        std::string handle;
+        std::unordered_map<std::string, size_t>::iterator it = GetArgument(apiRecord.m_argList, 0, handle) ? m_liveObjectIndexes.find(handle) : m_liveObjectIndexes.end();
+
+        if (it != m_liveObjectIndexes.end())
+        {
+            TrackedObject& object = m_trackedObjects[it->second];
+
+            if ((apiGroups & CLAPIGroup_CLObjectRetain) != 0)
+            {
+                object.m_referenceCount++;
+            }
+            else if (--object.m_referenceCount == 0)
+            {
+                m_liveObjectIndexes.erase(it);
+            }
+        }
+    }
+}
+
+const gpTraceSummarizer::TrackedObject* gpTraceSummarizer::FindTrackedObject(const std::string& handle) const
+{
+    std::unordered_map<std::string, size_t>::const_iterator it = m_liveObjectIndexes.find(handle);
+    return (it != m_liveObjectIndexes.end()) ? &m_trackedObjects[it->second] : nullptr;
+}
+
+quint32 gpTraceSummarizer::GetThreadIndex(quint64 threadId)
+{
+    // A trace has a handful of threads, and the calls of a thread are mostly consecutive:
+    quint32 retVal = m_callThreadIndexes.empty() ? INVALID_INDEX : m_callThreadIndexes.back();
+
+    if ((retVal == INVALID_INDEX) || (m_threadIds[retVal] != threadId))
+    {
+        std::vector<quint64>::iterator it = std::find(m_threadIds.begin(), m_threadIds.end(), threadId);
+        retVal = static_cast<quint32>(it - m_threadIds.begin());
+
+        if (it == m_threadIds.end())
+        {
+            m_threadIds.push_back(threadId);
+        }
+    }
+
+    return retVal;
+}
+
+quint32 gpTraceSummarizer::InternString(const QString& str)
+{
+    return InternString(str.toStdString());
+}
+
+quint32 gpTraceSummarizer::InternString(const std::string& str)
+{
+    std::unordered_map<std::string, quint32>::iterator it = m_internedStringIds.find(str);
+    quint32 retVal = 0;
+
+    if (it != m_internedStringIds.end())
+    {
+        retVal = it->second;
+    }
+    else
+    {
+        retVal = static_cast<quint32>(m_internedStrings.size());
+        m_internedStrings.push_back(QString::fromStdString(str));
+        m_internedStringIds.insert(std::make_pair(str, retVal));
+    }
+
+    return retVal;
+}
+
+void gpTraceSummarizer::Summarize(quint64 startTime, quint64 endTime, gpTraceSummary& summary) const
+{
+    summary.m_startTime = startTime;
+    summary.m_endTime = endTime;
+
+    for (int i = 0; i < GP_TRACE_SUMMARY_PAGES_COUNT; i++)
+    {
+        summary.m_pages[i].m_type = static_cast<gpTraceSummaryPageType>(i);
+        summary.m_pages[i].m_columnNames.clear();
+        summary.m_pages[i].m_rows.clear();
+    }
+
+    SummarizeAPIs(startTime, endTime, summary.m_pages[GP_TRACE_SUMMARY_PAGE_API]);
+    SummarizeCommands(startTime, endTime, summary);
+    SummarizeMessages(startTime, endTime, summary.m_pages[GP_TRACE_SUMMARY_PAGE_BEST_PRACTICES]);
+}
+
+void gpTraceSummarizer::SummarizeAPIs(quint64 startTime, quint64 endTime, gpTraceSummaryPage& page) const
+{
+    /// The accumulated calls of an API
+    struct APIStats
+    {
+        quint64 m_callsCount;
+        quint64 m_totalTime;
+        quint64 m_maxTime;
+        quint64 m_minTime;
+    };
+
+    // The APIs are accumulated by their interned name id, so each call costs a single array access:
+    APIStats emptyStats = { 0, 0, 0, 0 };
+    std::vector<APIStats> apiStats(m_internedStrings.size(), emptyStats);
+    quint64 totalTime = 0;
+    size_t callsCount = m_callStartTimes.size();
+
+    for (size_t i = 0; i < callsCount; i++)
+    {
+        quint64 callStart = m_callStartTimes[i];
+        quint64 callEnd = m_callEndTimes[i];
+
+        if (IsInRange(callStart, callEnd, startTime, endTime))
+        {
+            APIStats& stats = apiStats[m_callNameIds[i]];
+            quint64 duration = callEnd - callStart;
+
+            stats.m_minTime = (stats.m_callsCount == 0) ? duration : std::min(stats.m_minTime, duration);
+            stats.m_maxTime = std::max(stats.m_maxTime, duration);
+            stats.m_totalTime += duration;
+            stats.m_callsCount++;
+            totalTime += duration;
+        }
+    }
+
+    // The calls accumulated in buckets are summarized at the bucket time granularity:
+    for (const CallBucket& bucket : m_callBuckets)
+    {
+        if (IsInRange(bucket.m_startTime, bucket.m_endTime, startTime, endTime))
+        {
+            APIStats& stats = apiStats[bucket.m_nameId];
+
+            stats.m_minTime = (stats.m_callsCount == 0) ? bucket.m_minTime : std::min(stats.m_minTime, bucket.m_minTime);
+            stats.m_maxTime = std::max(stats.m_maxTime, bucket.m_maxTime);
+            stats.m_totalTime += bucket.m_totalTime;
+            stats.m_callsCount += bucket.m_callsCount;
+            totalTime += bucket.m_totalTime;
+        }
+    }
+
+    page.m_columnNames << GPU_STR_TraceSummaryColumnAPIName << GPU_STR_TraceSummaryColumnCalls << GPU_STR_TraceSummaryColumnTotalTime
+                       << GPU_STR_TraceSummaryColumnPercentOfTime << GPU_STR_TraceSummaryColumnAvgTime << GPU_STR_TraceSummaryColumnMaxTime
+                       << GPU_STR_TraceSummaryColumnMinTime;
+
+    for (size_t nameId = 0; nameId < apiStats.size(); nameId++)
+    {
+        const APIStats& stats = apiStats[nameId];
+
+        if (stats.m_callsCount > 0)
+        {
+            gpTraceSummaryRow row;
+            row.m_cells << m_internedStrings[nameId] << stats.m_callsCount << ToMilliseconds(stats.m_totalTime)
+                        << ((totalTime > 0) ? (100.0 * stats.m_totalTime / totalTime) : 0.0)
+                        << ToMilliseconds(stats.m_totalTime / stats.m_callsCount) << ToMilliseconds(stats.m_maxTime) << ToMilliseconds(stats.m_minTime);
+            page.m_rows.push_back(row);
+        }
+    }
+}
+
+void gpTraceSummarizer::SummarizeCommands(quint64 startTime, quint64 endTime, gpTraceSummary& summary) const
+{
+    /// The accumulated commands of a context (or HSA queue) on a device
+    struct ContextStats
+    {
+        unsigned int m_contextId;
+        quint32 m_deviceNameId;
+        quint64 m_kernelsCount;
+        quint64 m_kernelTime;
+        quint64 m_transfersCount;
+        quint64 m_transferTime;
+        quint64 m_transferSize;
+        quint64 m_otherCommandsCount;
+    };
+
+    /// The accumulated dispatches of a kernel on a device
+    struct KernelStats
+    {
+        quint32 m_nameId;
+        quint32 m_deviceNameId;
+        quint64 m_callsCount;
+        quint64 m_totalTime;
+        quint64 m_maxTime;
+        quint64 m_minTime;
+    };
+
+    typedef std::pair<quint64, size_t> DurationAndIndex;
+    typedef std::priority_queue<DurationAndIndex, std::vector<DurationAndIndex>, std::greater<DurationAndIndex> > TopCommandsHeap;
+
+    std::unordered_map<quint64, ContextStats> contextStats;
+    std::unordered_map<quint64, KernelStats> kernelStats;
+    TopCommandsHeap topKernels;
+    TopCommandsHeap topTransfers;
+    quint64 totalKernelTime = 0;
+
+    for (size_t i = 0; i < m_commands.size(); i++)
+    {
+        const Command& command = m_commands[i];
+
+        if (IsInRange(command.m_startTime, command.m_endTime, startTime, endTime))
+        {
+            quint64 duration = command.m_endTime - command.m_startTime;
+            TopCommandsHeap* pTopCommands = nullptr;
+
+            if (command.m_contextId != INVALID_INDEX)
+            {
+                quint64 contextKey = (static_cast<quint64>(command.m_contextId) << 32) | command.m_deviceNameId;
+                std::unordered_map<quint64, ContextStats>::iterator contextIt = contextStats.find(contextKey);
+
+                if (contextIt == contextStats.end())
+                {
+                    ContextStats emptyStats = { command.m_contextId, command.m_deviceNameId, 0, 0, 0, 0, 0, 0 };
+                    contextIt = contextStats.insert(std::make_pair(contextKey, emptyStats)).first;
+                }
+
+                ContextStats& stats = contextIt->second;
+
+                if (COMMAND_KERNEL == command.m_kind)
+                {
+                    stats.m_kernelsCount++;
+                    stats.m_kernelTime += duration;
+                }
+                else if (COMMAND_MEMORY_TRANSFER == command.m_kind)
+                {
+                    stats.m_transfersCount++;
+                    stats.m_transferTime += duration;
+                    stats.m_transferSize += command.m_size;
+                }
+                else
+                {
+                    stats.m_otherCommandsCount++;
+                }
+            }
+
+            if (COMMAND_KERNEL == command.m_kind)
+            {
+                quint64 kernelKey = (static_cast<quint64>(command.m_nameId) << 32) | command.m_deviceNameId;
+                std::unordered_map<quint64, KernelStats>::iterator kernelIt = kernelStats.find(kernelKey);
+
+                if (kernelIt == kernelStats.end())
+                {
+                    KernelStats emptyStats = { command.m_nameId, command.m_deviceNameId, 0, 0, 0, duration };
+                    kernelIt = kernelStats.insert(std::make_pair(kernelKey, emptyStats)).first;
+                }
+
+                KernelStats& stats = kernelIt->second;
+                stats.m_callsCount++;
+                stats.m_totalTime += duration;
+                stats.m_maxTime = std::max(stats.m_maxTime, duration);
+                stats.m_minTime = std::min(stats.m_minTime, duration);
+                totalKernelTime += duration;
+
+                pTopCommands = &topKernels;
+            }
+            else if (COMMAND_MEMORY_TRANSFER == command.m_kind)
+            {
+                pTopCommands = &topTransfers;
+            }
+
+            // Keep the longest commands in a bounded min-heap, so that the pass stays linear:
+            if (pTopCommands != nullptr)
+            {
+                if (pTopCommands->size() < ms_TOP_ROWS_COUNT)
+                {
+                    pTopCommands->push(DurationAndIndex(duration, i));
+                }
+                else if (pTopCommands->top().first < duration)
+                {
+                    pTopCommands->pop();
+                    pTopCommands->push(DurationAndIndex(duration, i));
+                }
+            }
+        }
+    }
+
+    // Context summary, ordered by context id:
+    gpTraceSummaryPage& contextPage = summary.m_pages[GP_TRACE_SUMMARY_PAGE_CONTEXT];
+    contextPage.m_columnNames << (IsHSA() ? GPU_STR_TraceSummaryColumnQueue : GPU_STR_TraceSummaryColumnContextId) << GPU_STR_TraceSummaryColumnDevice
+                              << GPU_STR_TraceSummaryColumnKernelDispatches << GPU_STR_TraceSummaryColumnKernelTime << GPU_STR_TraceSummaryColumnMemoryTransfers
+                              << GPU_STR_TraceSummaryColumnMemoryTransferTime << GPU_STR_TraceSummaryColumnMemoryTransferSize << GPU_STR_TraceSummaryColumnOtherCommands;
+
+    std::vector<ContextStats> sortedContexts;
+    sortedContexts.reserve(contextStats.size());
+
+    for (std::unordered_map<quint64, ContextStats>::const_iterator it = contextStats.begin(); it != contextStats.end(); ++it)
+    {
+        sortedContexts.push_back(it->second);
+    }
+
+    std::sort(sortedContexts.begin(), sortedContexts.end(), [](const ContextStats& a, const ContextStats& b)
+    {
+        return (a.m_contextId < b.m_contextId) || ((a.m_contextId == b.m_contextId) && (a.m_deviceNameId < b.m_deviceNameId));
+    });
+
+    for (const ContextStats& stats : sortedContexts)
+    {
+        gpTraceSummaryRow row;
+        row.m_cells << stats.m_contextId << m_internedStrings[stats.m_deviceNameId] << stats.m_kernelsCount << ToMilliseconds(stats.m_kernelTime)
+                    << stats.m_transfersCount << ToMilliseconds(stats.m_transferTime) << (stats.m_transferSize / 1024.0) << stats.m_otherCommandsCount;
+        contextPage.m_rows.push_back(row);
+    }
+
+    // Kernel summary, ordered by total time:
+    gpTraceSummaryPage& kernelPage = summary.m_pages[GP_TRACE_SUMMARY_PAGE_KERNEL];
+    kernelPage.m_columnNames << GPU_STR_TraceSummaryColumnKernelName << GPU_STR_TraceSummaryColumnDevice << GPU_STR_TraceSummaryColumnCalls
+                             << GPU_STR_TraceSummaryColumnTotalTime << GPU_STR_TraceSummaryColumnPercentOfTime << GPU_STR_TraceSummaryColumnAvgTime
+                             << GPU_STR_TraceSummaryColumnMaxTime << GPU_STR_TraceSummaryColumnMinTime;
+
+    std::vector<KernelStats> sortedKernels;
+    sortedKernels.reserve(kernelStats.size());
+
+    for (std::unordered_map<quint64, KernelStats>::const_iterator it = kernelStats.begin(); it != kernelStats.end(); ++it)
+    {
+        sortedKernels.push_back(it->second);
+    }
+
+    std::sort(sortedKernels.begin(), sortedKernels.end(), [](const KernelStats& a, const KernelStats& b)
+    {
+        return a.m_totalTime > b.m_totalTime;
+    });
+
+    for (const KernelStats& stats : sortedKernels)
+    {
+        gpTraceSummaryRow row;
+        row.m_cells << m_internedStrings[stats.m_nameId] << m_internedStrings[stats.m_deviceNameId] << stats.m_callsCount << ToMilliseconds(stats.m_totalTime)
+                    << ((totalKernelTime > 0) ? (100.0 * stats.m_totalTime / totalKernelTime) : 0.0)
+                    << ToMilliseconds(stats.m_totalTime / stats.m_callsCount) << ToMilliseconds(stats.m_maxTime) << ToMilliseconds(stats.m_minTime);
+        kernelPage.m_rows.push_back(row);
+    }
+
+    // Top kernels and top data transfers, longest first:
+    gpTraceSummaryPage& topKernelsPage = summary.m_pages[GP_TRACE_SUMMARY_PAGE_TOP_KERNELS];
+    topKernelsPage.m_columnNames << GPU_STR_TraceSummaryColumnKernelName << GPU_STR_TraceSummaryColumnDevice << GPU_STR_TraceSummaryColumnThreadId
+                                 << GPU_STR_TraceSummaryColumnCallIndex << GPU_STR_TraceSummaryColumnGlobalWorkSize << GPU_STR_TraceSummaryColumnWorkGroupSize
+                                 << GPU_STR_TraceSummaryColumnTime;
+
+    gpTraceSummaryPage& topTransfersPage = summary.m_pages[GP_TRACE_SUMMARY_PAGE_TOP_DATA_TRANSFERS];
+    topTransfersPage.m_columnNames << GPU_STR_TraceSummaryColumnCommandType << GPU_STR_TraceSummaryColumnDevice << GPU_STR_TraceSummaryColumnThreadId
+                                   << GPU_STR_TraceSummaryColumnCallIndex << GPU_STR_TraceSummaryColumnSize << GPU_STR_TraceSummaryColumnTime
+                                   << GPU_STR_TraceSummaryColumnRate;
+
+    for (; !topKernels.empty(); topKernels.pop())
+    {
+        topKernelsPage.m_rows.push_back(BuildTopCommandRow(m_commands[topKernels.top().second]));
+    }
+
+    for (; !topTransfers.empty(); topTransfers.pop())
+    {
+        topTransfersPage.m_rows.push_back(BuildTopCommandRow(m_commands[topTransfers.top().second]));
+    }
+
+    std::reverse(topKernelsPage.m_rows.begin(), topKernelsPage.m_rows.end());
+    std::reverse(topTransfersPage.m_rows.begin(), topTransfersPage.m_rows.end());
+}
+
+gpTraceSummaryRow gpTraceSummarizer::BuildTopCommandRow(const Command& command) const
+{
+    gpTraceSummaryRow row;
+    quint64 duration = command.m_endTime - command.m_startTime;
+
+    row.m_threadId = m_threadIds[command.m_threadIndex];
+    row.m_sequenceId = command.m_sequenceId;
+
+    if (command.m_callIndex == INVALID_INDEX)
+    {
+        // HSA dispatches have no host API:
+        row.m_linkViewType = AnalyzerHTMLViewType_TimelineDeviceNoAPI;
+    }
+    else
+    {
+        row.m_linkViewType = m_hasCLRecords ? AnalyzerHTMLViewType_TimelineDevice : AnalyzerHTMLViewType_Trace;
+    }
+
+    if (COMMAND_KERNEL == command.m_kind)
+    {
+        row.m_cells << m_internedStrings[command.m_nameId] << m_internedStrings[command.m_deviceNameId] << row.m_threadId << command.m_sequenceId
+                    << m_internedStrings[command.m_globalWorkSizeId] << m_internedStrings[command.m_localWorkSizeId] << ToMilliseconds(duration);
+    }
+    else
+    {
+        // Bytes per nanosecond are GB per second:
+        double rate = (duration > 0) ? (static_cast<double>(command.m_size) / duration) : 0.0;
+
+        row.m_cells << m_internedStrings[command.m_nameId] << m_internedStrings[command.m_deviceNameId] << row.m_threadId << command.m_sequenceId
+                    << (command.m_size / 1024.0) << ToMilliseconds(duration) << rate;
+    }
+
+    return row;
+}
+
+void gpTraceSummarizer::SummarizeMessages(quint64 startTime, quint64 endTime, gpTraceSummaryPage& page) const
+{
+    page.m_columnNames << GPU_STR_TraceSummaryColumnType << GPU_STR_TraceSummaryColumnThreadId << GPU_STR_TraceSummaryColumnCallIndex
+                       << GPU_STR_TraceSummaryColumnAPIName << GPU_STR_TraceSummaryColumnMessage;
+
+    quint64 hiddenMessagesCount = 0;
+
+    // Adds the row of a message about a call:
+    auto addMessageRow = [&](quint32 callIndex, const QString& type, const QString& text)
+    {
+        gpTraceSummaryRow row;
+        row.m_threadId = m_threadIds[m_callThreadIndexes[callIndex]];
+        row.m_sequenceId = m_callSequenceIds[callIndex];
+        row.m_linkViewType = AnalyzerHTMLViewType_Trace;
+        row.m_cells << type << row.m_threadId << row.m_sequenceId << m_internedStrings[m_callNameIds[callIndex]] << text;
+        page.m_rows.push_back(row);
+    };
+
+    for (const Message& message : m_messages)
+    {
+        if (IsInRange(m_callStartTimes[message.m_callIndex], m_callEndTimes[message.m_callIndex], startTime, endTime))
+        {
+            if (page.m_rows.size() >= ms_MAX_BEST_PRACTICES_ROWS)
+            {
+                hiddenMessagesCount++;
+            }
+            else
+            {
+                const QString& apiName = m_internedStrings[m_callNameIds[message.m_callIndex]];
+                QString type = GPU_STR_TraceSummaryWarning;
+                QString text;
+
+                switch (message.m_kind)
+                {
+                    case MESSAGE_API_ERROR:
+                        type = GPU_STR_TraceSummaryError;
+                        text = QString(GPU_STR_TraceSummaryAPIError).arg(apiName).arg(m_internedStrings[message.m_detailId]);
+                        break;
+
+                    case MESSAGE_BLOCKING_TRANSFER:
+                        text = QString(GPU_STR_TraceSummaryBlockingTransfer).arg(apiName);
+                        break;
+
+                    case MESSAGE_RUNTIME_WORK_GROUP_SIZE:
+                        text = QString(GPU_STR_TraceSummaryRuntimeWorkGroupSize).arg(m_internedStrings[message.m_detailId]).arg(s_WAVEFRONT_SIZE);
+                        break;
+
+                    case MESSAGE_WORK_GROUP_SIZE_NOT_MULTIPLE:
+                        text = QString(GPU_STR_TraceSummaryWorkGroupSizeNotMultiple).arg(m_internedStrings[message.m_detailId]).arg(message.m_value).arg(s_WAVEFRONT_SIZE);
+                        break;
+
+                    case MESSAGE_SMALL_TRANSFER:
+                        text = QString(GPU_STR_TraceSummarySmallTransfer).arg(apiName).arg(message.m_value);
+                        break;
+
+                    case MESSAGE_DEPRECATED_API:
+                        text = QString(GPU_STR_TraceSummaryDeprecatedAPI).arg(apiName);
+                        break;
+
+                    case MESSAGE_REDUNDANT_SYNC:
+                        text = QString(GPU_STR_TraceSummaryRedundantSync).arg(apiName).arg(m_internedStrings[message.m_detailId]);
+                        break;
+
+                    case MESSAGE_PERSISTENT_MEMORY_READ:
+                        text = QString(GPU_STR_TraceSummaryPersistentMemoryRead).arg(apiName).arg(m_internedStrings[message.m_detailId]);
+                        break;
+
+                    default:
+                        GT_ASSERT(false);
+                        break;
+                }
+
+                addMessageRow(message.m_callIndex, type, text);
+            }
+        }
+    }
+
+    // The objects which are still referenced at the end of the trace are leaked. They are reported with the call which created them:
+    for (const TrackedObject& object : m_trackedObjects)
+    {
+        if ((object.m_referenceCount > 0) && IsInRange(m_callStartTimes[object.m_callIndex], m_callEndTimes[object.m_callIndex], startTime, endTime))
+        {
+            if (page.m_rows.size() >= ms_MAX_BEST_PRACTICES_ROWS)
+            {
+                hiddenMessagesCount++;
+            }
+            else
+            {
+                const QString& apiName = m_internedStrings[m_callNameIds[object.m_callIndex]];
+                addMessageRow(object.m_callIndex, GPU_STR_TraceSummaryWarning, QString(GPU_STR_TraceSummaryResourceLeak).arg(m_internedStrings[object.m_handleId]).arg(apiName));
+            }
+        }
+    }
+
+    if (hiddenMessagesCount > 0)
+    {
+        gpTraceSummaryRow row;
+        row.m_cells << GPU_STR_TraceSummaryWarning << QVariant() << QVariant() << QString() << QString(GPU_STR_TraceSummaryHiddenMessages).arg(hiddenMessagesCount);
+        page.m_rows.push_back(row);
+    }
+}
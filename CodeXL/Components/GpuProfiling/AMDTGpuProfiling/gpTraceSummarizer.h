@@ -0,0 +1,267 @@
+//=============================================================
+// Copyright (c) 2016-2018 Advanced Micro Devices, Inc. All rights reserved.
+//
+/// \author GPU Developer Tools
+/// \file
+/// \brief Computes the API, context, kernel, top data transfer and best practices summaries of a trace from its parsed records
+//=============================================================
+
+#ifndef __GPTRACESUMMARIZER_H
+#define __GPTRACESUMMARIZER_H
+
+// std
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Qt
+#include <qtIgnoreCompilerWarnings.h>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+// Local:
+#include <AMDTGpuProfiling/gpTraceSessionIndex.h>
+#include "CXLAnalyzerHTMLUtils.h"
+
+/// The pages of a trace summary
+enum gpTraceSummaryPageType
+{
+    GP_TRACE_SUMMARY_PAGE_API,                  ///< the calls, and the CPU time, of each API
+    GP_TRACE_SUMMARY_PAGE_CONTEXT,              ///< the device work of each context (OpenCL) or queue (HSA)
+    GP_TRACE_SUMMARY_PAGE_KERNEL,               ///< the dispatches, and the device time, of each kernel
+    GP_TRACE_SUMMARY_PAGE_TOP_KERNELS,          ///< the longest kernel dispatches
+    GP_TRACE_SUMMARY_PAGE_TOP_DATA_TRANSFERS,   ///< the longest memory transfers
+    GP_TRACE_SUMMARY_PAGE_BEST_PRACTICES,       ///< the API errors, and the calls which do not follow the best practices
+    GP_TRACE_SUMMARY_PAGES_COUNT
+};
+
+/// A row of a summary page. Numeric cells hold numbers (times in milliseconds are doubles), so that the view sorts them numerically
+struct gpTraceSummaryRow
+{
+    QVariantList m_cells;                   ///< the row cells, one per page column
+    quint64 m_threadId;                     ///< the thread of the call the row links to
+    unsigned int m_sequenceId;              ///< the sequence id of the call the row links to
+    AnalyzerHTMLViewType m_linkViewType;    ///< where the linked call is shown, AnalyzerHTMLViewType_None if the row has no link
+
+    gpTraceSummaryRow() : m_threadId(0), m_sequenceId(0), m_linkViewType(AnalyzerHTMLViewType_None) {}
+};
+
+/// A summary page
+struct gpTraceSummaryPage
+{
+    gpTraceSummaryPageType m_type;          ///< the page type
+    QStringList m_columnNames;              ///< the column headers
+    std::vector<gpTraceSummaryRow> m_rows;  ///< the rows
+
+    gpTraceSummaryPage() : m_type(GP_TRACE_SUMMARY_PAGE_API) {}
+};
+
+/// The summary of a time range of a trace
+struct gpTraceSummary
+{
+    quint64 m_startTime;                    ///< the summarized range start
+    quint64 m_endTime;                      ///< the summarized range end
+    gpTraceSummaryPage m_pages[GP_TRACE_SUMMARY_PAGES_COUNT];   ///< the pages, by gpTraceSummaryPageType
+
+    gpTraceSummary() : m_startTime(0), m_endTime(0) {}
+};
+
+/// Collects the parsed API and dispatch records of a trace into compact columns, and summarizes any time range of them
+/// with a single linear pass. Unlike the summary pages written by the backend, the summary is available for every loaded
+/// trace (imported and truncated traces included), and covers the API calls that are only aggregated in the timeline.
+/// Once ms_MAX_DETAILED_CALLS calls are collected, the calls that no command or message refers to are only accumulated in
+/// per thread and API time buckets, so that the memory of the summarizer stays bounded for very long traces
+class gpTraceSummarizer
+{
+public:
+    /// The number of calls collected one by one before the calls without commands or messages are accumulated in buckets
+    static const size_t ms_MAX_DETAILED_CALLS = 1000000;
+
+    /// The duration (in nanoseconds) of the time buckets the calls are accumulated in, past ms_MAX_DETAILED_CALLS
+    static const quint64 ms_CALL_BUCKET_DURATION = 1000000;
+
+    /// The number of rows of the top kernels and top data transfers pages
+    static const unsigned int ms_TOP_ROWS_COUNT = 10;
+
+    /// The maximal number of rows of the best practices page
+    static const unsigned int ms_MAX_BEST_PRACTICES_ROWS = 10000;
+
+    gpTraceSummarizer();
+
+    /// Removes all the collected records
+    void Clear();
+
+    /// Collects a parsed record. Records other than API and dispatch records are ignored
+    /// \param record the record
+    void AddRecord(const gpTraceIndexRecord& record);
+
+    /// \return true iff no API call or dispatch was collected
+    bool IsEmpty() const { return m_callStartTimes.empty() && m_callBuckets.empty() && m_commands.empty(); }
+
+    /// \return true iff the collected records are HSA records only
+    bool IsHSA() const { return m_hasHSARecords && !m_hasCLRecords; }
+
+    /// \return the earliest start time of the collected calls and commands
+    quint64 GetStartTime() const { return m_startTime; }
+
+    /// \return the latest end time of the collected calls and commands
+    quint64 GetEndTime() const { return m_endTime; }
+
+    /// Summarizes the calls and commands which overlap a time range
+    /// \param startTime the range start
+    /// \param endTime the range end
+    /// \param[out] summary the summary
+    void Summarize(quint64 startTime, quint64 endTime, gpTraceSummary& summary) const;
+
+private:
+    /// The kind of a device command
+    enum CommandKind
+    {
+        COMMAND_KERNEL,             ///< a kernel dispatch
+        COMMAND_MEMORY_TRANSFER,    ///< a memory transfer
+        COMMAND_OTHER               ///< any other device command (fill, marker, migration...)
+    };
+
+    /// A device command
+    struct Command
+    {
+        quint32 m_callIndex;        ///< the index of the enqueue call, or INVALID_INDEX for commands without an API call (HSA dispatches)
+        quint32 m_threadIndex;      ///< the index of the thread in m_threadIds
+        unsigned int m_sequenceId;  ///< the sequence id of the command
+        CommandKind m_kind;         ///< the command kind
+        quint32 m_nameId;           ///< the kernel name (kernels), or command type (other commands)
+        quint32 m_deviceNameId;     ///< the device name
+        quint32 m_globalWorkSizeId; ///< the global work size (kernels)
+        quint32 m_localWorkSizeId;  ///< the work-group size (kernels)
+        unsigned int m_contextId;   ///< the context id (OpenCL) or queue index (HSA)
+        quint64 m_startTime;        ///< the device start time
+        quint64 m_endTime;          ///< the device end time
+        quint64 m_size;             ///< the transferred bytes (memory transfers and data operations)
+    };
+
+    /// The kind of a best practices message
+    enum MessageKind
+    {
+        MESSAGE_API_ERROR,                      ///< the call returned an error
+        MESSAGE_BLOCKING_TRANSFER,              ///< the call blocks the host until the transfer ends
+        MESSAGE_RUNTIME_WORK_GROUP_SIZE,        ///< the kernel work-group size is chosen by the runtime
+        MESSAGE_WORK_GROUP_SIZE_NOT_MULTIPLE,   ///< the kernel work-group size is not a multiple of the wavefront size
+        MESSAGE_SMALL_TRANSFER,                 ///< the call transfers only a few bytes
+        MESSAGE_DEPRECATED_API,                 ///< the API is deprecated
+        MESSAGE_REDUNDANT_SYNC,                 ///< the call waits for a command queue which has no commands since it was last synchronized
+        MESSAGE_PERSISTENT_MEMORY_READ          ///< the call reads a buffer in host-visible device memory
+    };
+
+    /// A best practices message about a call
+    struct Message
+    {
+        quint32 m_callIndex;        ///< the call
+        MessageKind m_kind;         ///< the message kind
+        quint32 m_detailId;         ///< the interned detail of the message (the result, kernel name...)
+        quint64 m_value;            ///< the numeric detail of the message (the size...)
+    };
+
+    /// An OpenCL object created by a call of the trace, tracked until its reference count drops to 0
+    struct TrackedObject
+    {
+        quint32 m_callIndex;        ///< the call that created the object
+        quint32 m_handleId;         ///< the interned object handle
+        quint64 m_referenceCount;   ///< the reference count of the object
+        bool m_isPersistentMemory;  ///< true iff the object is a buffer created with CL_MEM_USE_PERSISTENT_MEM_AMD
+    };
+
+    /// The calls of an API from a thread that started within the same time bucket, accumulated once the calls are no longer
+    /// collected one by one
+    struct CallBucket
+    {
+        quint32 m_nameId;           ///< the interned API name
+        quint32 m_threadIndex;      ///< the index of the thread in m_threadIds
+        quint64 m_startTime;        ///< the earliest CPU start time of the calls
+        quint64 m_endTime;          ///< the latest CPU end time of the calls
+        quint64 m_callsCount;       ///< the number of calls
+        quint64 m_totalTime;        ///< the total CPU time of the calls
+        quint64 m_maxTime;          ///< the longest call CPU time
+        quint64 m_minTime;          ///< the shortest call CPU time
+    };
+
+    static const quint32 INVALID_INDEX = 0xFFFFFFFF;
+
+    /// Collects an OpenCL API record
+    void AddCLRecord(const gpTraceCLAPIRecord& clApiRecord);
+
+    /// Collects an HSA API or dispatch record
+    void AddHSARecord(const gpTraceHSAAPIRecord& hsaApiRecord);
+
+    /// Collects the common data of an API call
+    /// \param apiRecord the API record
+    /// \param apiName the API name
+    /// \param isReferenced true iff a command or a message refers to the call. Such calls are always collected one by one
+    /// \return the index of the call, or INVALID_INDEX if the call was accumulated in a bucket
+    quint32 AddCall(const gpTraceAPIRecord& apiRecord, const QString& apiName, bool isReferenced);
+
+    /// Accumulates an API call in the bucket of its thread, API and start time
+    void AddCallToBucket(const gpTraceAPIRecord& apiRecord, quint32 nameId, quint32 threadIndex);
+
+    /// Collects a device command, if its times are valid
+    void AddCommand(const Command& command);
+
+    /// Adds the messages about a kernel work-group size
+    void AddWorkGroupSizeMessages(quint32 callIndex, const std::string& kernelName, const std::string& localWorkSize);
+
+    /// Updates the reference counts of the tracked objects with an OpenCL create, retain or release call
+    /// \param callIndex the call
+    /// \param clApiRecord the call record
+    /// \param apiGroups the CLAPIGroups of the API
+    void TrackObject(quint32 callIndex, const gpTraceCLAPIRecord& clApiRecord, unsigned int apiGroups);
+
+    /// \return the tracked object with a handle, or nullptr if the handle is not the handle of a live tracked object
+    const TrackedObject* FindTrackedObject(const std::string& handle) const;
+
+    /// Gets the index of a thread in m_threadIds, adding the thread if needed
+    quint32 GetThreadIndex(quint64 threadId);
+
+    /// Gets the id of an interned string, adding it to the interned strings if needed
+    quint32 InternString(const QString& str);
+
+    /// Gets the id of an interned string, adding it to the interned strings if needed
+    quint32 InternString(const std::string& str);
+
+    /// Builds the rows of the API summary page
+    void SummarizeAPIs(quint64 startTime, quint64 endTime, gpTraceSummaryPage& page) const;
+
+    /// Builds the rows of the context, kernel, top kernels and top data transfers pages
+    void SummarizeCommands(quint64 startTime, quint64 endTime, gpTraceSummary& summary) const;
+
+    /// Builds the rows of the best practices page
+    void SummarizeMessages(quint64 startTime, quint64 endTime, gpTraceSummaryPage& page) const;
+
+    /// Builds a top kernels or top data transfers row
+    gpTraceSummaryRow BuildTopCommandRow(const Command& command) const;
+
+    std::vector<QString> m_internedStrings;                         ///< the interned strings
+    std::unordered_map<std::string, quint32> m_internedStringIds;   ///< a map from an interned string (UTF8) to its id
+    std::vector<quint64> m_threadIds;                               ///< the threads of the collected calls
+
+    std::vector<quint64> m_callStartTimes;                          ///< per call: the CPU start time
+    std::vector<quint64> m_callEndTimes;                            ///< per call: the CPU end time
+    std::vector<quint32> m_callNameIds;                             ///< per call: the interned API name
+    std::vector<quint32> m_callThreadIndexes;                       ///< per call: the index of the thread in m_threadIds
+    std::vector<unsigned int> m_callSequenceIds;                    ///< per call: the sequence id
+
+    std::vector<CallBucket> m_callBuckets;                          ///< the calls accumulated past ms_MAX_DETAILED_CALLS
+    std::unordered_map<quint64, size_t> m_openCallBuckets;          ///< a map from the thread index and name id to the bucket filled with their calls
+
+    std::vector<Command> m_commands;                                ///< the device commands
+    std::vector<Message> m_messages;                                ///< the best practices messages
+    std::vector<TrackedObject> m_trackedObjects;                    ///< the OpenCL objects created by the calls, in creation order
+    std::unordered_map<std::string, size_t> m_liveObjectIndexes;    ///< a map from the handle of a live tracked object to its index in m_trackedObjects
+    std::unordered_map<std::string, bool> m_queueIdleStates;        ///< a map from a command queue handle to true iff it has no commands since it was last synchronized
+
+    quint64 m_startTime;                                            ///< the earliest start time
+    quint64 m_endTime;                                              ///< the latest end time
+    bool m_hasCLRecords;                                            ///< true iff an OpenCL record was collected
+    bool m_hasHSARecords;                                           ///< true iff an HSA record was collected
+};
+
+#endif // __GPTRACESUMMARIZER_H
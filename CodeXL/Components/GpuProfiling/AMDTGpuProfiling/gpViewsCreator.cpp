@@ -935,6 +935,14 @@ bool gpViewsCreator::LoadFileToView(SharedSessionWindow* pNewSessionWindow, cons
 
             if ((winType == GPUWindowTypeAPITrace) || (winType == GPUWindowTypePerformanceCounters))
             {
+                // Sessions found through the session catalog read their session file properties when they are first opened:
+                GPUSessionTreeItemData* pSessionData = qobject_cast<GPUSessionTreeItemData*>(pItemData->extendedItemData());
+
+                if (pSessionData != nullptr)
+                {
+                    pSessionData->LoadDeferredProperties();
+                }
+
                 // Get the requested profile from the manager
                 retVal = pNewSessionWindow->DisplaySession(sessionFilePath, displayItemInView, errorMessage);
             }
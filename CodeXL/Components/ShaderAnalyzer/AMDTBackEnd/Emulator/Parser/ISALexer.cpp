@@ -0,0 +1,340 @@
+//=============================================================
+// Copyright (c) 2016 Advanced Micro Devices, Inc.
+//
+/// \file   ISALexer.cpp
+/// \author GPU Developer Tools
+/// \brief Description: Lexer for the ISA disassembly text
+//
+//=============================================================
+
+// C++.
+#include <algorithm>
+#include <cstring>
+
+// Local.
+#include "ISALexer.h"
+
+// *** INTERNALLY-LINKED AUXILIARY FUNCTIONS - BEGIN ***
+
+// Character classes of the ISA lexer. These match the POSIX classes of the "C" locale.
+enum IsaCharClass
+{
+    ISA_CHAR_PRINT  = 0x01, // [[:print:]]
+    ISA_CHAR_BLANK  = 0x02, // [[:blank:]]
+    ISA_CHAR_DIGIT  = 0x04, // [[:digit:]]
+    ISA_CHAR_XDIGIT = 0x08, // [[:xdigit:]]
+    ISA_CHAR_SPACE  = 0x10  // [[:space:]]
+};
+
+// The character classes table, indexed by the character value.
+struct IsaCharClassTable
+{
+    unsigned char m_classes[256];
+
+    IsaCharClassTable()
+    {
+        for (int c = 0; c < 256; ++c)
+        {
+            unsigned char classes = 0;
+
+            if (c >= 0x20 && c <= 0x7e)
+            {
+                classes |= ISA_CHAR_PRINT;
+            }
+
+            if (c == ' ' || c == '\t')
+            {
+                classes |= ISA_CHAR_BLANK;
+            }
+
+            if (c == ' ' || (c >= '\t' && c <= '\r'))
+            {
+                classes |= ISA_CHAR_SPACE;
+            }
+
+            if (c >= '0' && c <= '9')
+            {
+                classes |= (ISA_CHAR_DIGIT | ISA_CHAR_XDIGIT);
+            }
+
+            if ((c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'))
+            {
+                classes |= ISA_CHAR_XDIGIT;
+            }
+
+            m_classes[c] = classes;
+        }
+    }
+};
+
+static const IsaCharClassTable s_isaCharClassTable;
+
+// Returns true if the given character belongs to the given class.
+static inline bool IsCharOfClass(char c, unsigned char charClass)
+{
+    return (s_isaCharClassTable.m_classes[static_cast<unsigned char>(c)] & charClass) != 0;
+}
+
+// Returns true if the count characters that start at pBegin are all of the given class.
+static bool IsRunOfClass(const char* pBegin, const char* pEnd, size_t count, unsigned char charClass)
+{
+    bool ret = (static_cast<size_t>(pEnd - pBegin) >= count);
+
+    for (size_t i = 0; ret && i < count; ++i)
+    {
+        ret = IsCharOfClass(pBegin[i], charClass);
+    }
+
+    return ret;
+}
+
+// Skips the characters of the given class, and returns the first character which is not of that class.
+static const char* SkipClass(const char* pBegin, const char* pEnd, unsigned char charClass)
+{
+    while (pBegin < pEnd && IsCharOfClass(*pBegin, charClass))
+    {
+        ++pBegin;
+    }
+
+    return pBegin;
+}
+
+// Returns the value of a hexadecimal digit.
+static inline unsigned int HexDigitValue(char c)
+{
+    unsigned int ret = 0;
+
+    if (c >= '0' && c <= '9')
+    {
+        ret = c - '0';
+    }
+    else if (c >= 'a' && c <= 'f')
+    {
+        ret = c - 'a' + 10;
+    }
+    else
+    {
+        ret = c - 'A' + 10;
+    }
+
+    return ret;
+}
+
+// Matches an instruction annotation at the given position (right after its "// "):
+// <offsetLength printable characters>": "<8 printable characters>[" "<8 printable characters>]
+// pLow and pHigh receive the positions of the instruction's low and high 32-bit words.
+static bool MatchInstructionAnnotationAt(const char* pPos, const char* pEnd, size_t offsetLength, bool is64Bit,
+                                         const char*& pLow, const char*& pHigh)
+{
+    bool ret = IsRunOfClass(pPos, pEnd, offsetLength, ISA_CHAR_PRINT);
+
+    if (ret)
+    {
+        pPos += offsetLength;
+        ret = (pEnd - pPos) >= 2 && pPos[0] == ':' && pPos[1] == ' ' && IsRunOfClass(pPos + 2, pEnd, 8, ISA_CHAR_PRINT);
+
+        if (ret)
+        {
+            pLow = pPos + 2;
+
+            if (is64Bit)
+            {
+                pPos = pLow + 8;
+                ret = (pPos < pEnd) && (*pPos == ' ') && IsRunOfClass(pPos + 1, pEnd, 8, ISA_CHAR_PRINT);
+                pHigh = pPos + 1;
+            }
+        }
+    }
+
+    return ret;
+}
+
+// *** INTERNALLY-LINKED AUXILIARY FUNCTIONS - END ***
+
+
+bool ISALexer::GetNextLine(const char*& pPos, const char* pEnd, const char*& pLineBegin, const char*& pLineEnd)
+{
+    bool ret = (pPos < pEnd);
+
+    if (ret)
+    {
+        pLineBegin = pPos;
+        pLineEnd = static_cast<const char*>(memchr(pPos, '\n', pEnd - pPos));
+
+        if (pLineEnd == nullptr)
+        {
+            pLineEnd = pEnd;
+        }
+
+        pPos = (pLineEnd < pEnd) ? pLineEnd + 1 : pEnd;
+    }
+
+    return ret;
+}
+
+const char* ISALexer::FindText(const char* pBegin, const char* pEnd, const char* pText, size_t textLength)
+{
+    const char* pRet = std::search(pBegin, pEnd, pText, pText + textLength);
+    return (pRet != pEnd || textLength == 0) ? pRet : nullptr;
+}
+
+uint64_t ISALexer::ReadHexNumber(const char* pBegin, const char* pEnd)
+{
+    uint64_t ret = 0;
+    bool isNegative = false;
+    pBegin = SkipClass(pBegin, pEnd, ISA_CHAR_SPACE);
+
+    if (pBegin < pEnd && (*pBegin == '+' || *pBegin == '-'))
+    {
+        isNegative = (*pBegin == '-');
+        ++pBegin;
+    }
+
+    if ((pEnd - pBegin) > 2 && pBegin[0] == '0' && (pBegin[1] == 'x' || pBegin[1] == 'X') && IsCharOfClass(pBegin[2], ISA_CHAR_XDIGIT))
+    {
+        pBegin += 2;
+    }
+
+    while (pBegin < pEnd && IsCharOfClass(*pBegin, ISA_CHAR_XDIGIT))
+    {
+        ret = (ret << 4) | HexDigitValue(*pBegin++);
+    }
+
+    // Like the stream, a negative number wraps around.
+    if (isNegative)
+    {
+        ret = 0 - ret;
+    }
+
+    return ret;
+}
+
+bool ISALexer::FindInstructionAnnotation(const char* pLineBegin, const char* pLineEnd, size_t offsetLength, bool is64Bit,
+                                         const char*& pLow, const char*& pHigh)
+{
+    bool ret = false;
+
+    // regex_search returns the match that starts first, and the leading [[:print:]]* makes it the last
+    // annotation of the first printable run that contains one.
+    for (const char* pPos = pLineBegin; (pLineEnd - pPos) >= 3; ++pPos)
+    {
+        // Once found, only annotations that can be reached through printable characters may replace the match.
+        if (ret && !IsCharOfClass(pPos[-1], ISA_CHAR_PRINT))
+        {
+            break;
+        }
+
+        const char* pCurrentLow = nullptr;
+        const char* pCurrentHigh = nullptr;
+
+        if (pPos[0] == '/' && pPos[1] == '/' && pPos[2] == ' ' &&
+            MatchInstructionAnnotationAt(pPos + 3, pLineEnd, offsetLength, is64Bit, pCurrentLow, pCurrentHigh))
+        {
+            ret = true;
+            pLow = pCurrentLow;
+            pHigh = pCurrentHigh;
+        }
+    }
+
+    return ret;
+}
+
+bool ISALexer::FindInstructionSizeAnnotation(const char* pLineBegin, const char* pLineEnd, bool& is64Bit)
+{
+    bool ret = false;
+
+    for (const char* pPos = pLineBegin; !ret && (pLineEnd - pPos) >= 2; ++pPos)
+    {
+        if (pPos[0] == '/' && pPos[1] == '/')
+        {
+            const char* pCurrent = SkipClass(pPos + 2, pLineEnd, ISA_CHAR_BLANK);
+
+            if (IsRunOfClass(pCurrent, pLineEnd, 12, ISA_CHAR_XDIGIT) && (pLineEnd - pCurrent) > 12 && pCurrent[12] == ':')
+            {
+                pCurrent = SkipClass(pCurrent + 13, pLineEnd, ISA_CHAR_BLANK);
+
+                if (IsRunOfClass(pCurrent, pLineEnd, 8, ISA_CHAR_XDIGIT))
+                {
+                    ret = true;
+                    pCurrent += 8;
+                    const char* pHigh = SkipClass(pCurrent, pLineEnd, ISA_CHAR_BLANK);
+                    is64Bit = (pHigh > pCurrent) && IsRunOfClass(pHigh, pLineEnd, 8, ISA_CHAR_XDIGIT);
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+bool ISALexer::FindNumericAssignment(const char* pLineBegin, const char* pLineEnd, const char* pKey, size_t keyLength, unsigned int& value)
+{
+    bool ret = false;
+
+    for (const char* pKeyPos = FindText(pLineBegin, pLineEnd, pKey, keyLength); !ret && pKeyPos != nullptr;
+         pKeyPos = FindText(pKeyPos + 1, pLineEnd, pKey, keyLength))
+    {
+        const char* pCurrent = SkipClass(pKeyPos + keyLength, pLineEnd, ISA_CHAR_BLANK);
+
+        if (pCurrent < pLineEnd && *pCurrent == '=')
+        {
+            ret = true;
+            value = 0;
+            pCurrent = SkipClass(pCurrent + 1, pLineEnd, ISA_CHAR_BLANK);
+
+            while (pCurrent < pLineEnd && IsCharOfClass(*pCurrent, ISA_CHAR_DIGIT))
+            {
+                value = value * 10 + (*pCurrent++ - '0');
+            }
+        }
+    }
+
+    return ret;
+}
+
+bool ISALexer::GetLabel(const char* pLineBegin, const char* pLineEnd, int& label)
+{
+    static const char LABEL_TOKEN[] = "label";
+    const size_t HSAIL_ISA_OFFSET = 2;
+    const char* pLabel = FindText(pLineBegin, pLineEnd, LABEL_TOKEN, sizeof(LABEL_TOKEN) - 1);
+    size_t location = (pLabel != nullptr) ? static_cast<size_t>(pLabel - pLineBegin) : 0;
+    bool ret = (pLabel != nullptr) && (location == 0 || location == HSAIL_ISA_OFFSET);
+
+    if (ret)
+    {
+        // The label number is read from the text that follows "label_", which excludes the last character of the line
+        // (the ':') when the label is not indented.
+        size_t lineLength = pLineEnd - pLineBegin;
+        size_t labelTextPos = std::min(6 + location, lineLength);
+        size_t labelTextLength = std::min(lineLength - labelTextPos, lineLength - 7);
+        label = static_cast<int>(ReadHexNumber(pLineBegin + labelTextPos, pLineBegin + labelTextPos + labelTextLength));
+    }
+
+    return ret;
+}
+
+bool ISALexer::GetGotoLabel(const char* pLineBegin, const char* pLineEnd, int& label)
+{
+    static const char LABEL_TOKEN[] = "label_";
+    const char* pLabel = FindText(pLineBegin, pLineEnd, LABEL_TOKEN, sizeof(LABEL_TOKEN) - 1);
+    bool ret = (pLabel != nullptr);
+
+    if (ret)
+    {
+        // The label number is read from the 4 characters that follow "label_".
+        const char* pLabelText = pLabel + sizeof(LABEL_TOKEN) - 1;
+        label = static_cast<int>(ReadHexNumber(pLabelText, pLabelText + std::min(static_cast<ptrdiff_t>(4), pLineEnd - pLabelText)));
+    }
+
+    return ret;
+}
+
+void ISALexer::Trim(const char*& pBegin, const char*& pEnd)
+{
+    pBegin = SkipClass(pBegin, pEnd, ISA_CHAR_SPACE);
+
+    while (pEnd > pBegin && IsCharOfClass(pEnd[-1], ISA_CHAR_SPACE))
+    {
+        --pEnd;
+    }
+}
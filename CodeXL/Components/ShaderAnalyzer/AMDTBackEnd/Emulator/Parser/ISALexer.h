@@ -0,0 +1,67 @@
+//=============================================================
+// Copyright (c) 2016 Advanced Micro Devices, Inc.
+//=============================================================
+
+#ifndef __ISALEXER_H
+#define __ISALEXER_H
+
+#include <cstddef>
+#include <cstdint>
+
+/// Lexer for the ISA disassembly text.
+/// The lexer works on [begin, end) ranges of the ISA buffer, so the text is scanned in place.
+/// Each matcher documents the regular expression it replaces: ParserISA used to match the
+/// lines with boost::regex, and the matchers keep the semantics of regex_search.
+class ISALexer
+{
+public:
+    /// The instruction annotation offset is 8 hex digits long, or 12 hex digits long in newer disassemblies.
+    static const size_t INST_OFFSET_LENGTH = 8;
+    static const size_t INST_OFFSET_LENGTH_48 = 12;
+
+    /// Gets the next line of the ISA text, the way getline() does, without copying it.
+    /// pPos is advanced to the beginning of the following line.
+    /// \returns false when there are no more lines.
+    static bool GetNextLine(const char*& pPos, const char* pEnd, const char*& pLineBegin, const char*& pLineEnd);
+
+    /// Finds the given text in the given range.
+    /// \returns the position of the text, or nullptr if it was not found.
+    static const char* FindText(const char* pBegin, const char* pEnd, const char* pText, size_t textLength);
+
+    /// Reads a hexadecimal number the way "stream >> std::hex >> value" does: leading white spaces
+    /// and an optional sign and "0x" prefix are skipped, and reading stops at the first character which
+    /// is not a hexadecimal digit.
+    /// \returns the number, or 0 if there are no digits.
+    static uint64_t ReadHexNumber(const char* pBegin, const char* pEnd);
+
+    /// Finds the instruction annotation of an ISA line, e.g. "// 00000010: BF8C007F" (32-bit instruction,
+    /// 8 digits offset) or "// 000000000130: D1190201 00000100" (64-bit instruction, 12 digits offset).
+    /// Matches [[:print:]]*// [[:print:]]{N}: ([[:print:]]{8})( [[:print:]]{8})? where N is offsetLength.
+    /// pLow and pHigh receive the positions of the instruction's low and high 32-bit words.
+    static bool FindInstructionAnnotation(const char* pLineBegin, const char* pLineEnd, size_t offsetLength, bool is64Bit,
+                                          const char*& pLow, const char*& pHigh);
+
+    /// Finds an instruction size annotation.
+    /// Matches //[[:blank:]]*[[:xdigit:]]{12}:[[:blank:]]*[[:xdigit:]]{8}([[:blank:]]+[[:xdigit:]]{8})?
+    /// is64Bit receives true if the annotation has a second instruction word.
+    static bool FindInstructionSizeAnnotation(const char* pLineBegin, const char* pLineEnd, bool& is64Bit);
+
+    /// Finds a "<key> = <number>" assignment in an ISA line, e.g. "NumVgprs = 12".
+    /// Matches <key>[[:blank:]]*=[[:blank:]]*([[:digit:]]*)
+    /// value receives the number, or 0 if there are no digits.
+    static bool FindNumericAssignment(const char* pLineBegin, const char* pLineEnd, const char* pKey, size_t keyLength, unsigned int& value);
+
+    /// Gets the label that an ISA line defines ("label_XXXX:" at the beginning of the line,
+    /// or after a 2 characters HSAIL indentation).
+    /// \returns true if the line defines a label.
+    static bool GetLabel(const char* pLineBegin, const char* pLineEnd, int& label);
+
+    /// Gets the label that an ISA line refers to ("label_XXXX" anywhere in the line).
+    /// \returns true if the line refers to a label.
+    static bool GetGotoLabel(const char* pLineBegin, const char* pLineEnd, int& label);
+
+    /// Trims the white spaces from both sides of the given range.
+    static void Trim(const char*& pBegin, const char*& pEnd);
+};
+
+#endif // __ISALEXER_H
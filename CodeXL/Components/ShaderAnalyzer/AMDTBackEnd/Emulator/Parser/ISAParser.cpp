@@ -14,17 +14,18 @@
 //=============================================================
 
 // C++.
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <sstream>
 #include <string>
 
-// Boost.
-#include <boost/regex.hpp>
-
 #include <AMDTOSWrappers/Include/osDebugLog.h>
 
 // Local.
 #include <Include/beStringConstants.h>
 #include "ISAParser.h"
+#include "ISALexer.h"
 #include "ParserSISOP2.h"
 #include "ParserSISOPK.h"
 #include "ParserSISOP1.h"
@@ -88,6 +89,12 @@ static std::string trimStr(const std::string& strToTrim)
     return trimStart(trimEnd(ret));
 }
 
+// The keys of the numeric assignments in the ISA text.
+static const char NUM_VGPRS_TOKEN[] = "NumVgprs";
+static const char NUM_SGPRS_TOKEN[] = "NumSgprs";
+static const char CODE_LEN_IN_BYTE_TOKEN[] = "codeLenInByte";
+static const char CODE_LEN_TOKEN[] = "CodeLen";
+
 // Split the given instruction into its building blocks: opcode, operands, binary representation and offset.
 static bool ExtractBuildingBlocks(const std::string& isaInstruction, std::string& instrOpCode,
                                   std::string& params, std::string& binaryRepresentation, std::string& offset)
@@ -374,37 +381,31 @@ bool ParserISA::ParseForSize(const std::string& isa)
     bool retVal = false;
 
     ResetInstsCounters();
-    boost::regex codeLenInByteEx("([[:blank:]]*codeLenInByte[[:blank:]]*=[[:blank:]]*)([[:digit:]]*)");
-    boost::regex codeLenInByteNI("([[:blank:]]*CodeLen[[:blank:]]*=[[:blank:]]*)([[:digit:]]*)");
+
     // v_add_u32     v1, s[2:3], v0, s0    // 000000000130: D1190201 00000100   <--- 64-bit instruction
     // v_mov_b32     v0, 0                 // 000000000138: 7E000280            <--- 32-bit instruction
-    boost::regex instAnnotation("//[[:blank:]]*[[:xdigit:]]{12}:[[:blank:]]*([[:xdigit:]]{8})([[:blank:]]+[[:xdigit:]]{8}){0,1}");
-
-    std::istringstream isaStream(isa);
-    boost::smatch matchInst;
-    std::string isaLine;
+    const char* pIsaPos = isa.data();
+    const char* pIsaEnd = pIsaPos + isa.size();
+    const char* pLineBegin = nullptr;
+    const char* pLineEnd = nullptr;
+    unsigned int codeLen = 0;
     int  isaSize = 0;
 
-    while (getline(isaStream, isaLine))
+    while (ISALexer::GetNextLine(pIsaPos, pIsaEnd, pLineBegin, pLineEnd))
     {
-        if (boost::regex_search(isaLine, matchInst, codeLenInByteEx))
-        {
-            std::string codeLenText(matchInst[2].first, matchInst[2].second);
-            m_CodeLen = atoi(codeLenText.c_str());
-            retVal = true;
-            break;
-        }
-        else if (boost::regex_search(isaLine, matchInst, codeLenInByteNI))
+        bool is64BitInst = false;
+
+        if (ISALexer::FindNumericAssignment(pLineBegin, pLineEnd, CODE_LEN_IN_BYTE_TOKEN, sizeof(CODE_LEN_IN_BYTE_TOKEN) - 1, codeLen) ||
+            ISALexer::FindNumericAssignment(pLineBegin, pLineEnd, CODE_LEN_TOKEN, sizeof(CODE_LEN_TOKEN) - 1, codeLen))
         {
-            std::string codeLenText(matchInst[2].first, matchInst[2].second);
-            m_CodeLen = atoi(codeLenText.c_str());
+            m_CodeLen = codeLen;
             retVal = true;
             break;
         }
-        else if (boost::regex_search(isaLine, matchInst, instAnnotation))
+        else if (ISALexer::FindInstructionSizeAnnotation(pLineBegin, pLineEnd, is64BitInst))
         {
             // Count size of instructions "manually" if ISA size is not provided by disassembler.
-            int  instSize = matchInst[(int) matchInst.size() - 1].matched ? 8 : 4;
+            int  instSize = is64BitInst ? 8 : 4;
             isaSize += instSize;
             retVal = true;
         }
@@ -429,23 +430,16 @@ bool ParserISA::ParseToVector(const std::string& isa)
     Instruction::instruction32bit inst32;
     Instruction::instruction64bit inst64;
 
-    std::istringstream isaStream(isa);
+    // The lines are scanned in place. Only the lines that become instructions are copied (into a reused buffer),
+    // since the instructions keep their text.
+    const char* pIsaPos = isa.data();
+    const char* pIsaEnd = pIsaPos + isa.size();
+    const char* pLineBegin = nullptr;
+    const char* pLineEnd = nullptr;
     std::string isaLine;
     bool isaCodeProc = false, parseOK = true, gprProc = false, vgprFound = false, sgprFound = false, codeLenFound = false;
     int iLabel = NO_LABEL, iGotoLabel = NO_LABEL;
 
-    boost::smatch matchInst;
-
-    boost::regex inst32_48Ex("([[:print:]]*// [[:print:]]{12}: )([[:print:]]{8})");
-    boost::regex inst64_48Ex("([[:print:]]*// [[:print:]]{12}: )([[:print:]]{8})( )([[:print:]]{8})");
-
-    boost::regex inst32Ex("([[:print:]]*// [[:print:]]{8}: )([[:print:]]{8})");
-    boost::regex inst64Ex("([[:print:]]*// [[:print:]]{8}: )([[:print:]]{8})( )([[:print:]]{8})");
-    boost::regex vgprsEx("([[:blank:]]*NumVgprs[[:blank:]]*=[[:blank:]]*)([[:digit:]]*)");
-    boost::regex sgprsEx("([[:blank:]]*NumSgprs[[:blank:]]*=[[:blank:]]*)([[:digit:]]*)");
-    boost::regex codeLenInByteEx("([[:blank:]]*codeLenInByte[[:blank:]]*=[[:blank:]]*)([[:digit:]]*)");
-    boost::regex codeLenInByteNI("([[:blank:]]*CodeLen[[:blank:]]*=[[:blank:]]*)([[:digit:]]*)");
-
     std::string isaStart;
     std::string isaEnd;
 
@@ -484,13 +478,14 @@ bool ParserISA::ParseToVector(const std::string& isa)
 
     GDT_HW_GENERATION asicGen = GDT_HW_GENERATION_NONE;
     /// Asic generation is in "asci("
-    const std::string asicGenStr("asic(");
+    static const char ASIC_GEN_TOKEN[] = "asic(";
+    static const char COMMENT_TOKEN[] = "//";
 
-    while (getline(isaStream, isaLine))
+    while (ISALexer::GetNextLine(pIsaPos, pIsaEnd, pLineBegin, pLineEnd))
     {
         iLineCount++;
 
-        if (!isaCodeProc && !gprProc && strstr(isaLine.c_str(), isaStart.c_str()) == NULL)
+        if (!isaCodeProc && !gprProc && ISALexer::FindText(pLineBegin, pLineEnd, isaStart.data(), isaStart.size()) == nullptr)
         {
             continue;
         }
@@ -498,8 +493,8 @@ bool ParserISA::ParseToVector(const std::string& isa)
         {
             isaCodeProc = true;
         }
-        else if (isaCodeProc && strstr(isaLine.c_str(), isaEnd.c_str()) != NULL
-                 && isaLine.find("//") == std::string::npos)
+        else if (isaCodeProc && ISALexer::FindText(pLineBegin, pLineEnd, isaEnd.data(), isaEnd.size()) != nullptr
+                 && ISALexer::FindText(pLineBegin, pLineEnd, COMMENT_TOKEN, sizeof(COMMENT_TOKEN) - 1) == nullptr)
         {
             // at least one line of valid code detected
             gprProc = true;
@@ -509,82 +504,76 @@ bool ParserISA::ParseToVector(const std::string& isa)
         else if (isaCodeProc)
         {
             /// check generation first
-            size_t iPos = isaLine.find(asicGenStr);
+            const char* pAsicGen = ISALexer::FindText(pLineBegin, pLineEnd, ASIC_GEN_TOKEN, sizeof(ASIC_GEN_TOKEN) - 1);
 
-            if (iPos != std::string::npos)
+            if (pAsicGen != nullptr && (pLineEnd - pAsicGen) >= 7)
             {
-                std::string sTemp = isaLine.substr(iPos + 5, 2);
-
-                if (sTemp == "SI")
+                if (strncmp(pAsicGen + 5, "SI", 2) == 0)
                 {
                     asicGen = GDT_HW_GENERATION_SOUTHERNISLAND;
                 }
-                else if (sTemp == "CI")
+                else if (strncmp(pAsicGen + 5, "CI", 2) == 0)
                 {
                     asicGen = GDT_HW_GENERATION_SEAISLAND;    // we consider SI and CI to be the same when parsing
                 }
-                else if (sTemp == "VI")
+                else if (strncmp(pAsicGen + 5, "VI", 2) == 0)
                 {
                     asicGen = GDT_HW_GENERATION_VOLCANICISLAND;
                 }
             }
 
-            std::stringstream instStream;
-            std::string::const_iterator isaLineStart = isaLine.begin();
-            std::string::const_iterator isaLineEnd   = isaLine.end();
+            const char* pInstLow = nullptr;
+            const char* pInstHigh = nullptr;
             bool instParseOK = true;
 
-            if (iLabel == NO_LABEL)
+            if (iLabel == NO_LABEL && !ISALexer::GetLabel(pLineBegin, pLineEnd, iLabel))
             {
-                iLabel = GetLabel(isaLine);
+                iLabel = NO_LABEL;
             }
 
-            iGotoLabel = GetGotoLabel(isaLine);
+            if (!ISALexer::GetGotoLabel(pLineBegin, pLineEnd, iGotoLabel))
+            {
+                iGotoLabel = NO_LABEL;
+            }
 
-            if ((boost::regex_search(isaLineStart, isaLineEnd, matchInst, inst64Ex)) ||
-                (boost::regex_search(isaLineStart, isaLineEnd, matchInst, inst64_48Ex)))
+            if (ISALexer::FindInstructionAnnotation(pLineBegin, pLineEnd, ISALexer::INST_OFFSET_LENGTH, true, pInstLow, pInstHigh) ||
+                ISALexer::FindInstructionAnnotation(pLineBegin, pLineEnd, ISALexer::INST_OFFSET_LENGTH_48, true, pInstLow, pInstHigh))
             {
-                // This is either inst64Ex or inst64_48Ex.
-                std::string inst32TextLow(matchInst[2].first, matchInst[2].second);
-                std::string inst32TextHigh(matchInst[4].first, matchInst[4].second);
-                instStream << std::hex << inst32TextHigh << inst32TextLow;
-                instStream >> inst64;
+                // This is a 64-bit instruction: the high word is followed by the low word.
+                char inst64Text[16];
+                memcpy(inst64Text, pInstHigh, 8);
+                memcpy(inst64Text + 8, pInstLow, 8);
+                inst64 = ISALexer::ReadHexNumber(inst64Text, inst64Text + sizeof(inst64Text));
+                isaLine.assign(pLineBegin, pLineEnd);
                 instParseOK = Parse(isaLine, asicGen, inst64, iLabel, iGotoLabel, iLineCount);
                 iLabel = iGotoLabel = NO_LABEL;
 
                 if (!instParseOK)
                 {
-                    uint32_t literal32b;
-
-                    instStream.clear();
-                    instStream << std::hex << inst32TextLow;
-                    instStream >> inst32;
-
-                    instStream.clear();
-                    instStream << std::hex << inst32TextHigh;
-                    instStream >> literal32b;
+                    inst32 = static_cast<Instruction::instruction32bit>(ISALexer::ReadHexNumber(pInstLow, pInstLow + 8));
+                    uint32_t literal32b = static_cast<uint32_t>(ISALexer::ReadHexNumber(pInstHigh, pInstHigh + 8));
 
                     instParseOK = Parse(isaLine, asicGen, inst32, true, literal32b, iLabel, iGotoLabel, iLineCount);
                     iLabel = iGotoLabel = NO_LABEL;
 
                 }
             }
-            else if (instParseOK && (boost::regex_search(isaLineStart, isaLineEnd, matchInst, inst32Ex) ||
-                                     boost::regex_search(isaLineStart, isaLineEnd, matchInst, inst32_48Ex)))
+            else if (instParseOK && (ISALexer::FindInstructionAnnotation(pLineBegin, pLineEnd, ISALexer::INST_OFFSET_LENGTH, false, pInstLow, pInstHigh) ||
+                                     ISALexer::FindInstructionAnnotation(pLineBegin, pLineEnd, ISALexer::INST_OFFSET_LENGTH_48, false, pInstLow, pInstHigh)))
             {
-                // This is either inst32Ex or inst32_48Ex.
-                std::string inst32Text(matchInst[2].first, matchInst[2].second);
-
-                instStream << std::hex << inst32Text;
-                instStream >> inst32;
+                // This is a 32-bit instruction.
+                inst32 = static_cast<Instruction::instruction32bit>(ISALexer::ReadHexNumber(pInstLow, pInstLow + 8));
+                isaLine.assign(pLineBegin, pLineEnd);
                 instParseOK = Parse(isaLine, asicGen, inst32 , false, 0, iLabel, iGotoLabel, iLineCount);
                 iLabel = iGotoLabel = NO_LABEL;
             }
             else if (iLabel != NO_LABEL)
             {
                 Instruction* pInstruction = nullptr;
-                std::string trimmedIsaLine = trimStr(isaLine);
-                pInstruction = new Instruction(trimmedIsaLine);
+                const char* pTrimmedBegin = pLineBegin;
+                const char* pTrimmedEnd = pLineEnd;
+                ISALexer::Trim(pTrimmedBegin, pTrimmedEnd);
+                pInstruction = new Instruction(std::string(pTrimmedBegin, pTrimmedEnd));
                 m_instructions.push_back(pInstruction);
                 iLabel = iGotoLabel = NO_LABEL;
             }
@@ -600,52 +589,29 @@ bool ParserISA::ParseToVector(const std::string& isa)
         // but a decision was made that we want it as part of the analysis as well, so I keep it until asked by the backend managerr
         else if (gprProc)
         {
-            std::string::const_iterator isaLineStart = isaLine.begin();
-            std::string::const_iterator isaLineEnd   = isaLine.end();
+            unsigned int codeLen = 0;
 
-            if (boost::regex_search(isaLineStart, isaLineEnd, matchInst, vgprsEx))
+            if (ISALexer::FindNumericAssignment(pLineBegin, pLineEnd, NUM_VGPRS_TOKEN, sizeof(NUM_VGPRS_TOKEN) - 1, m_vgprs))
             {
                 // Mark the VGPR section as found.
                 vgprFound = true;
-                m_vgprs = 0;
-
-                // Check if the number of VGPRs was changed by the runtime.
-                bool isChangedByRuntime = ExtractRuntimeChangedNumOfGprs(isaLine, m_vgprs);
 
-                if (!isChangedByRuntime)
-                {
-                    // If the value was not changed, extract the original value.
-                    std::string vgprsText(matchInst[2].first, matchInst[2].second);
-                    m_vgprs = atoi(vgprsText.c_str());
-                }
+                // Check if the number of VGPRs was changed by the runtime. If it was not, the original value is kept.
+                ExtractRuntimeChangedNumOfGprs(std::string(pLineBegin, pLineEnd), m_vgprs);
             }
-            else if (boost::regex_search(isaLineStart, isaLineEnd, matchInst, sgprsEx))
+            else if (ISALexer::FindNumericAssignment(pLineBegin, pLineEnd, NUM_SGPRS_TOKEN, sizeof(NUM_SGPRS_TOKEN) - 1, m_sgprs))
             {
                 // Mark the SGPR section as found.
                 sgprFound = true;
-                m_sgprs = 0;
 
-                // Check if the number of SGPRs was changed by the runtime.
-                bool isChangedByRuntime = ExtractRuntimeChangedNumOfGprs(isaLine, m_sgprs);
-
-                if (!isChangedByRuntime)
-                {
-                    // If the value was not changed, extract the original value.
-                    std::string sgprsText(matchInst[2].first, matchInst[2].second);
-                    m_sgprs = atoi(sgprsText.c_str());
-                }
-            }
-            else if (boost::regex_search(isaLineStart, isaLineEnd, matchInst, codeLenInByteEx))
-            {
-                codeLenFound = true;
-                std::string codeLenText(matchInst[2].first, matchInst[2].second);
-                m_CodeLen = atoi(codeLenText.c_str());
+                // Check if the number of SGPRs was changed by the runtime. If it was not, the original value is kept.
+                ExtractRuntimeChangedNumOfGprs(std::string(pLineBegin, pLineEnd), m_sgprs);
             }
-            else if (boost::regex_search(isaLineStart, isaLineEnd, matchInst, codeLenInByteNI))
+            else if (ISALexer::FindNumericAssignment(pLineBegin, pLineEnd, CODE_LEN_IN_BYTE_TOKEN, sizeof(CODE_LEN_IN_BYTE_TOKEN) - 1, codeLen) ||
+                     ISALexer::FindNumericAssignment(pLineBegin, pLineEnd, CODE_LEN_TOKEN, sizeof(CODE_LEN_TOKEN) - 1, codeLen))
             {
                 codeLenFound = true;
-                std::string codeLenText(matchInst[2].first, matchInst[2].second);
-                m_CodeLen = atoi(codeLenText.c_str());
+                m_CodeLen = codeLen;
             }
         }
     }
@@ -676,21 +642,10 @@ void ParserISA::ResetInstsCounters()
 int ParserISA::GetLabel(const std::string& sISALine)
 {
     int iRet = NO_LABEL;
-    int iLocation = (int)sISALine.find("label");
-    const int HSAIL_ISA_OFFSET = 2;
-    int offset = 0;
-
-    if (iLocation == HSAIL_ISA_OFFSET)
-    {
-        offset = HSAIL_ISA_OFFSET;
-    }
 
-    if (iLocation == 0 || iLocation == HSAIL_ISA_OFFSET)
+    if (!ISALexer::GetLabel(sISALine.data(), sISALine.data() + sISALine.size(), iRet))
     {
-        std::string labelText(sISALine.substr(6 + offset, sISALine.length() - 7));
-        std::stringstream instStream;
-        instStream << std::hex << labelText;
-        instStream >> iRet;
+        iRet = NO_LABEL;
     }
 
     return iRet;
@@ -699,14 +654,10 @@ int ParserISA::GetLabel(const std::string& sISALine)
 int ParserISA::GetGotoLabel(const std::string& sISALine)
 {
     int iRet = NO_LABEL;
-    size_t iLocation = (int)sISALine.find("label_");
 
-    if (iLocation != std::string::npos)
+    if (!ISALexer::GetGotoLabel(sISALine.data(), sISALine.data() + sISALine.size(), iRet))
     {
-        std::string labelText(sISALine.substr(iLocation + 6, 4));
-        std::stringstream instStream;
-        instStream << std::hex << labelText;
-        instStream >> iRet;
+        iRet = NO_LABEL;
     }
 
     return iRet;
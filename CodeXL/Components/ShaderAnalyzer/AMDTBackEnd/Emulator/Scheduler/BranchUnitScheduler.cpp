@@ -18,13 +18,16 @@
 #include <math.h>
 #include "BranchUnitScheduler.h"
 
-size_t BranchUnitScheduler::GetBranchInstructionsNum(const std::vector<Instruction*>& instructions)
+size_t BranchUnitScheduler::GetBranchInstructionsNum(const std::vector<Instruction*>* instructions)
 {
-    for (const Instruction*& iter : instructions)
+    if (instructions != nullptr)
     {
-        if (IsInstructionBranch(iter))
+        for (const Instruction* iter : *instructions)
         {
-            m_branchInstNum++;
+            if (IsInstructionBranch(iter))
+            {
+                m_branchInstNum++;
+            }
         }
     }
 
@@ -35,119 +38,119 @@ bool BranchUnitScheduler::IsInstructionBranch(const Instruction* inst) const
 {
     bool isInstruction = false;
 
-    if (inst != nullptr)
+    if (inst != nullptr && inst->GetInstructionCategory() == Instruction::ScalarALU)
     {
-        if (inst->GetInstructionCategory() == Instruction::ScalarALU)
+        /// The opcodes are defined per hardware generation, so the instruction is checked against the SI, VI and GFX9 classes.
+        switch (inst->GetInstructionFormat())
         {
-            if (inst->GetInstructionFormat() == Instruction::InstructionSet_SOPP)
+            case Instruction::InstructionSet_SOPP:
             {
-                SOPPInstruction* pSOPPInstruction = dynamic_cast<SOPPInstruction*>(inst);
+                const SISOPPInstruction* pSISOPPInstruction = dynamic_cast<const SISOPPInstruction*>(inst);
+                const VISOPPInstruction* pVISOPPInstruction = dynamic_cast<const VISOPPInstruction*>(inst);
 
-                if (pSOPPInstruction != nullptr)
+                if (pSISOPPInstruction != nullptr)
+                {
+                    SISOPPInstruction::OP opSOPP = pSISOPPInstruction->GetOp();
+                    isInstruction = (opSOPP == SISOPPInstruction::S_BRANCH) ||
+                                    (opSOPP >= SISOPPInstruction::S_CBRANCH_SCC0 && opSOPP <= SISOPPInstruction::S_CBRANCH_EXECNZ);
+                }
+                else if (pVISOPPInstruction != nullptr)
                 {
-                    SOPPInstruction::OP opSOPP = pSOPPInstruction->GetOp();
-
-                    switch (opSOPP)
-                    {
-                        case SOPPInstruction::S_BRANCH:
-                        case SOPPInstruction::S_CBRANCH_SCC0:
-                        case SOPPInstruction::S_CBRANCH_SCC1:
-                        case SOPPInstruction::S_CBRANCH_VCCZ:
-                        case SOPPInstruction::S_CBRANCH_VCCNZ:
-                        case SOPPInstruction::S_CBRANCH_EXECZ:
-                        case SOPPInstruction::S_CBRANCH_EXECNZ:
-                            isInstruction = true;
-                            break;
-                    }
+                    VISOPPInstruction::OP opSOPP = pVISOPPInstruction->GetOp();
+                    isInstruction = (opSOPP == VISOPPInstruction::s_branch) ||
+                                    (opSOPP >= VISOPPInstruction::s_cbranch_scc0 && opSOPP <= VISOPPInstruction::s_cbranch_execnz);
                 }
             }
-            else if (inst->GetInstructionFormat() == Instruction::InstructionSet_SOP1)
+            break;
+
+            case Instruction::InstructionSet_SOP1:
             {
-                SOP1Instruction* pSOP1Instruction = dynamic_cast<SOP1Instruction*>(inst);
+                const SISOP1Instruction* pSISOP1Instruction = dynamic_cast<const SISOP1Instruction*>(inst);
+                const VISOP1Instruction* pVISOP1Instruction = dynamic_cast<const VISOP1Instruction*>(inst);
+                const G9SOP1Instruction* pG9SOP1Instruction = dynamic_cast<const G9SOP1Instruction*>(inst);
 
-                if (pSOP1Instruction != nullptr)
+                if (pSISOP1Instruction != nullptr)
                 {
-                    SOP1Instruction::OP opSOP1 = pSOP1Instruction->GetOp();
-
-                    switch (opSOP1)
-                    {
-                        case SOP1Instruction::S_CBRANCH_JOIN:
-                        case SOP1Instruction::S_SETPC_B64:
-                        case SOP1Instruction::S_SWAPPC_B64:
-                        case SOP1Instruction::S_GETPC_B64:
-                        {
-                            isInstruction = true;
-                        }
-                        break;
-                    }
+                    SISOP1Instruction::OP opSOP1 = pSISOP1Instruction->GetOp();
+                    isInstruction = (opSOP1 == SISOP1Instruction::S_CBRANCH_JOIN) || (opSOP1 == SISOP1Instruction::S_SETPC_B64) ||
+                                    (opSOP1 == SISOP1Instruction::S_SWAPPC_B64) || (opSOP1 == SISOP1Instruction::S_GETPC_B64);
                 }
-                else if (inst->GetInstructionFormat() == Instruction::InstructionSet_SOP2)
+                else if (pVISOP1Instruction != nullptr)
                 {
-                    SOP2Instruction* pSOP2Instruction = dynamic_cast<SOP2Instruction*>(inst);
-
-                    if (pSOP2Instruction != nullptr)
-                    {
-                        SOP2Instruction::OP opSOP2 = pSOP2Instruction->GetOp();
-
-                        if (opSOP2 == SOP2Instruction::S_CBRANCH_G_FORK)
-                        {
-                            isInstruction = true;
-                        }
-                    }
+                    VISOP1Instruction::OP opSOP1 = pVISOP1Instruction->GetOp();
+                    isInstruction = (opSOP1 == VISOP1Instruction::s_cbranch_join) || (opSOP1 == VISOP1Instruction::s_setpc_b64) ||
+                                    (opSOP1 == VISOP1Instruction::s_swappc_b64) || (opSOP1 == VISOP1Instruction::s_getpc_b64);
                 }
-                else if (inst->GetInstructionFormat() == Instruction::InstructionSet_SOPK)
+                else if (pG9SOP1Instruction != nullptr)
                 {
-                    SOPKInstruction* pSOPKInstruction = dynamic_cast<SOPKInstruction*>(inst);
+                    G9SOP1Instruction::OP opSOP1 = pG9SOP1Instruction->GetOp();
+                    isInstruction = (opSOP1 == G9SOP1Instruction::s_cbranch_join) || (opSOP1 == G9SOP1Instruction::s_setpc_b64) ||
+                                    (opSOP1 == G9SOP1Instruction::s_swappc_b64) || (opSOP1 == G9SOP1Instruction::s_getpc_b64);
+                }
+            }
+            break;
 
-                    if (pSOPKInstruction != nullptr)
-                    {
-                        SOPKInstruction::OP opSOPK = pSOPKInstruction->GetOp();
+            case Instruction::InstructionSet_SOP2:
+            {
+                const SISOP2Instruction* pSISOP2Instruction = dynamic_cast<const SISOP2Instruction*>(inst);
+                const VISOP2Instruction* pVISOP2Instruction = dynamic_cast<const VISOP2Instruction*>(inst);
+                const G9SOP2Instruction* pG9SOP2Instruction = dynamic_cast<const G9SOP2Instruction*>(inst);
 
-                        if (opSOPK == SOPKInstruction::S_CBRANCH_I_FORK)
-                        {
-                            isInstruction = true;
-                        }
-                    }
-                }
-                else if (inst->GetInstructionFormat() == Instruction::InstructionSet_SOPC)
-                {
-                    SOPCInstruction* pSOPCInstruction = dynamic_cast<SOPCInstruction*>(inst);
+                isInstruction = (pSISOP2Instruction != nullptr && pSISOP2Instruction->GetOp() == SISOP2Instruction::S_CBRANCH_G_FORK) ||
+                                (pVISOP2Instruction != nullptr && pVISOP2Instruction->GetOp() == VISOP2Instruction::s_cbranch_g_fork) ||
+                                (pG9SOP2Instruction != nullptr && pG9SOP2Instruction->GetOp() == G9SOP2Instruction::s_cbranch_g_fork);
+            }
+            break;
 
-                    if (pSOPCInstruction != nullptr)
-                    {
-                        SOPCInstruction::OP opSOPC = pSOPCInstruction->GetOp();
+            case Instruction::InstructionSet_SOPK:
+            {
+                const SISOPKInstruction* pSISOPKInstruction = dynamic_cast<const SISOPKInstruction*>(inst);
+                const VISOPKInstruction* pVISOPKInstruction = dynamic_cast<const VISOPKInstruction*>(inst);
+                const G9SOPKInstruction* pG9SOPKInstruction = dynamic_cast<const G9SOPKInstruction*>(inst);
 
-                        if (opSOPC == OPCInstruction::S_SETVSKIP)
-                        {
-                            isInstruction = true;
-                        }
-                    }
-                }
+                isInstruction = (pSISOPKInstruction != nullptr && pSISOPKInstruction->GetOp() == SISOPKInstruction::S_CBRANCH_I_FORK) ||
+                                (pVISOPKInstruction != nullptr && pVISOPKInstruction->GetOp() == VISOPKInstruction::s_cbranch_i_fork) ||
+                                (pG9SOPKInstruction != nullptr && pG9SOPKInstruction->GetOp() == G9SOPKInstruction::s_cbranch_i_fork);
             }
-        }
+            break;
 
-        return isInstruction;
-    }
+            case Instruction::InstructionSet_SOPC:
+            {
+                const SISOPCInstruction* pSISOPCInstruction = dynamic_cast<const SISOPCInstruction*>(inst);
+                const VISOPCInstruction* pVISOPCInstruction = dynamic_cast<const VISOPCInstruction*>(inst);
 
-    bool BranchUnitScheduler::IsBranchTaken(size_t branchInstIdx)const
-    {
-        /// If the branch instruction index is in range of brach instructions return its branch prediction.
-        if (branchInstIdx < m_branchPredictor.size())
-        {
-            return m_branchPredictor[branchInstIdx];
-        }
+                isInstruction = (pSISOPCInstruction != nullptr && pSISOPCInstruction->GetOp() == SISOPCInstruction::S_SETVSKIP) ||
+                                (pVISOPCInstruction != nullptr && pVISOPCInstruction->GetOp() == VISOPCInstruction::s_setvskip);
+            }
+            break;
 
-        /// If the branch instruction index is not in range of brach instructions the instruction should be taken (as non-branch)
-        /// (Should not get here)
-        return true;
+            default:
+                break;
+        }
     }
 
-    void BranchUnitScheduler::SetUpBranchUnitScheduler()
+    return isInstruction;
+}
+
+bool BranchUnitScheduler::IsBranchTaken(size_t branchInstIdx)const
+{
+    /// If the branch instruction index is in range of brach instructions return its branch prediction.
+    if (branchInstIdx < m_branchPredictor.size())
     {
-        /// Predicted as taken branches number
-        size_t predictedBranches = (size_t)(m_branchInstNum * m_branchTakenRate);
-        m_branchPredictor.resize(predictedBranches, true);
-        m_branchPredictor.resize(m_branchInstNum, false);
-        /// Shuffle in random order taken and non-taken branch instructions predicators
-        std::random_shuffle(m_branchPredictor.begin(), m_branchPredictor.end());
+        return m_branchPredictor[branchInstIdx];
     }
+
+    /// If the branch instruction index is not in range of brach instructions the instruction should be taken (as non-branch)
+    /// (Should not get here)
+    return true;
+}
+
+void BranchUnitScheduler::SetUpBranchUnitScheduler()
+{
+    /// Predicted as taken branches number
+    size_t predictedBranches = (size_t)(m_branchInstNum * m_branchTakenRate);
+    m_branchPredictor.resize(predictedBranches, true);
+    m_branchPredictor.resize(m_branchInstNum, false);
+    /// Shuffle in random order taken and non-taken branch instructions predicators
+    std::random_shuffle(m_branchPredictor.begin(), m_branchPredictor.end());
+}
@@ -16,7 +16,7 @@
 /// Local:
 #include "CUScheduler.h"
 
-CUScheduler::CUScheduler(double branchRate, const std::vector<Instruction*>* pInstructions) : m_vectorUnitNextFreeClk(0), m_scalarUnitNextFreeClk(0), m_branchUnitNextFreeClk(0), m_branchUnitScheduler(branchRate)
+CUScheduler::CUScheduler(double branchRate, const std::vector<Instruction*>* pInstructions) : m_cu(0), m_vectorUnitNextFreeClk(0), m_scalarUnitNextFreeClk(0), m_branchUnitNextFreeClk(0), m_branchUnitScheduler(branchRate)
 {
     if (m_branchUnitScheduler.GetBranchInstructionsNum(pInstructions) > 0)
     {
@@ -35,6 +35,12 @@ CUScheduler::GetCU() const
     return m_cu;
 }
 
+void
+CUScheduler::SetCU(size_t cu)
+{
+    m_cu = cu;
+}
+
 CUScheduler::Status_ComputeUnitExe
 CUScheduler::ScheduleWF(WorkGroup& workGroup, size_t wf, bool& isScheduleProgress)
 {
@@ -85,7 +91,7 @@ CUScheduler::ScheduleWG(WorkGroup& workGroup, bool& isScheduleProgress)
 
     if (!workGroup.IsScheduled())
     {
-        workGroup.SetScheduled();
+        workGroup.SetScheduled(m_cu);
     }
 
     if (workGroup.IsScheduleFinished())
@@ -103,5 +109,38 @@ CUScheduler::ScheduleWG(WorkGroup& workGroup, bool& isScheduleProgress)
         isScheduleProgress |= isScheduleWFProgress;
     }
 
+    if (!isScheduleProgress)
+    {
+        workGroup.SetScheduleFinished();
+    }
+
     return Status_CUExeSuccess;
 }
+
+CUScheduler::Status_ComputeUnitExe
+CUScheduler::ScheduleWorkGroups(const WorkGroup& workGroup, size_t workGroupNum)
+{
+    Status_ComputeUnitExe status = Status_CUExeSuccess;
+
+    if (workGroupNum > 0)
+    {
+        size_t vectorUnitStartClk = m_vectorUnitNextFreeClk;
+        size_t scalarUnitStartClk = m_scalarUnitNextFreeClk;
+        size_t branchUnitStartClk = m_branchUnitNextFreeClk;
+
+        /// Emulate a copy, so that the given work group can be shared by all compute units.
+        WorkGroup emulatedWorkGroup(workGroup);
+        bool isScheduleProgress = true;
+
+        while (isScheduleProgress && status == Status_CUExeSuccess)
+        {
+            status = ScheduleWG(emulatedWorkGroup, isScheduleProgress);
+        }
+
+        m_vectorUnitNextFreeClk = vectorUnitStartClk + (m_vectorUnitNextFreeClk - vectorUnitStartClk) * workGroupNum;
+        m_scalarUnitNextFreeClk = scalarUnitStartClk + (m_scalarUnitNextFreeClk - scalarUnitStartClk) * workGroupNum;
+        m_branchUnitNextFreeClk = branchUnitStartClk + (m_branchUnitNextFreeClk - branchUnitStartClk) * workGroupNum;
+    }
+
+    return status;
+}
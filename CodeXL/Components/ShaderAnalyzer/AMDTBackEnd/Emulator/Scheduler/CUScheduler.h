@@ -65,6 +65,16 @@ public:
     /// -----------------------------------------------------------------------------------------------
     Status_ComputeUnitExe ScheduleWG(WorkGroup& workGroup, bool& isScheduleProgress);
     /// -----------------------------------------------------------------------------------------------
+    /// \brief Name:        ScheduleWorkGroups
+    /// \brief Description: Schedule workGroupNum work groups, which are identical to workGroup, to completion.
+    ///                     Identical work groups add the same number of clocks to each execution unit, so only one
+    ///                     is emulated, and its clocks are multiplied by the number of work groups.
+    /// \param[in]          workGroup
+    /// \param[in]          workGroupNum
+    /// \return Status_ComputeUnitExe
+    /// -----------------------------------------------------------------------------------------------
+    Status_ComputeUnitExe ScheduleWorkGroups(const WorkGroup& workGroup, size_t workGroupNum);
+    /// -----------------------------------------------------------------------------------------------
     /// \brief Name:        GetClkNum
     /// \brief Description: Get the clock number for program execution
     /// \return size_t
@@ -76,6 +86,13 @@ public:
     /// \return size_t
     /// -----------------------------------------------------------------------------------------------
     size_t GetCU() const;
+    /// -----------------------------------------------------------------------------------------------
+    /// \brief Name:        SetCU
+    /// \brief Description: Set the compute unit index
+    /// \param[in]          cu
+    /// \return void
+    /// -----------------------------------------------------------------------------------------------
+    void SetCU(size_t cu);
 
     /// -----------------------------------------------------------------------------------------------
     /// \brief Name:        ResetCUScheduler
@@ -15,12 +15,24 @@
 
 /// Local:
 
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <functional>
 #include <numeric>
+#include <sstream>
+#include <thread>
 #include <time.h>
 #include <stdlib.h>
 #include <cmath>
+#include <AMDTOSWrappers/Include/osApplication.h>
+#include <AMDTOSWrappers/Include/osFilePath.h>
 #include "UTDPScheduler.h"
 
+/// The devices file, which is installed next to the CodeXL binaries.
+static const wchar_t* EMULATOR_DEVICES_FILE_NAME = L"EmulatorDevices";
+static const wchar_t* EMULATOR_DEVICES_FILE_EXTENSION = L"txt";
+
 const size_t UTDPScheduler::NumCUTahiti = 32;
 const size_t UTDPScheduler::NumCUCapeVerde = 10;
 const size_t UTDPScheduler::NumCUPitcrain = 16;
@@ -84,34 +96,149 @@ UTDPScheduler::GetExeTime(size_t exeClkNum) const
     return exeClkNum * m_clkToSec;
 }
 
-UTDPScheduler::UTDPScheduler(const std::vector<Instruction*>& instructions, DeviceType deviceType, size_t workDim, const std::vector<size_t>& globalWorkSize, const std::vector<size_t>& localWorkSize, double branchRate)
-    : m_deviceType(deviceType), m_workDim(workDim), m_globalWorkSize(globalWorkSize), m_localWorkSize(localWorkSize), m_branchRate(branchRate), m_wavefronts(0)
+void
+UTDPScheduler::GetBuiltInDeviceDescription(DeviceType deviceType, DeviceDescription& device)
 {
-    switch (m_deviceType)
+    switch (deviceType)
     {
         case Tahiti:
-            m_numCU = NumCUTahiti;
-            m_clkToSec = ClkTahiti;
-            m_maxWorkGoupSize = DeviceMaxWorkGoupSizeTahiti;
-            m_waveFrontSize = WaveFrontWINumTahiti;
+            device.m_name = "Tahiti";
+            device.m_numCU = NumCUTahiti;
+            device.m_clk = ClkTahiti;
+            device.m_maxWorkGoupSize = DeviceMaxWorkGoupSizeTahiti;
+            device.m_waveFrontSize = WaveFrontWINumTahiti;
             break;
 
         case CapeVerde:
-            m_numCU = NumCUCapeVerde;
-            m_clkToSec = ClkCapeVerde;
-            m_maxWorkGoupSize = DeviceMaxWorkGoupSizeCapeVerde;
-            m_waveFrontSize = WaveFrontWINumCapeVerde;
+            device.m_name = "CapeVerde";
+            device.m_numCU = NumCUCapeVerde;
+            device.m_clk = ClkCapeVerde;
+            device.m_maxWorkGoupSize = DeviceMaxWorkGoupSizeCapeVerde;
+            device.m_waveFrontSize = WaveFrontWINumCapeVerde;
             break;
 
         case Pitcrain:
-            m_numCU = NumCUPitcrain;
-            m_clkToSec = ClkPitcrain;
-            m_maxWorkGoupSize = DeviceMaxWorkGoupSizePitcrain;
-            m_waveFrontSize = WaveFrontWINumPitcrain;
+            device.m_name = "Pitcairn";
+            device.m_numCU = NumCUPitcrain;
+            device.m_clk = ClkPitcrain;
+            device.m_maxWorkGoupSize = DeviceMaxWorkGoupSizePitcrain;
+            device.m_waveFrontSize = WaveFrontWINumPitcrain;
             break;
     }
+}
+
+bool
+UTDPScheduler::LoadDeviceDescriptions(const std::string& fileName, std::vector<DeviceDescription>& devices)
+{
+    std::ifstream devicesFile(fileName.c_str());
+    bool ret = devicesFile.is_open();
+    std::string line;
+
+    while (ret && std::getline(devicesFile, line))
+    {
+        std::istringstream lineStream(line);
+        DeviceDescription device;
+
+        /// Skip empty lines and comments.
+        if ((lineStream >> device.m_name) && device.m_name[0] != '#')
+        {
+            ret = static_cast<bool>(lineStream >> device.m_numCU >> device.m_waveFrontSize >> device.m_maxWorkGoupSize >> device.m_clk);
+
+            /// A device without compute units or wavefront work-items can not be emulated.
+            if (ret && device.m_numCU > 0 && device.m_waveFrontSize > 0)
+            {
+                devices.push_back(device);
+            }
+            else
+            {
+                ret = false;
+            }
+        }
+    }
+
+    return ret;
+}
+
+bool
+UTDPScheduler::FindDeviceDescription(const std::vector<DeviceDescription>& devices, const std::string& deviceName, DeviceDescription& device)
+{
+    for (const DeviceDescription& currentDevice : devices)
+    {
+        if (currentDevice.m_name.size() == deviceName.size() &&
+            std::equal(deviceName.begin(), deviceName.end(), currentDevice.m_name.begin(),
+                       [](char a, char b) { return tolower(a) == tolower(b); }))
+        {
+            device = currentDevice;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool
+UTDPScheduler::GetDeviceDescription(const std::string& deviceName, DeviceDescription& device)
+{
+    std::vector<DeviceDescription> devices;
+    osFilePath devicesFilePath;
+
+    if (osGetCurrentApplicationDllsPath(devicesFilePath))
+    {
+        devicesFilePath.setFileName(EMULATOR_DEVICES_FILE_NAME);
+        devicesFilePath.setFileExtension(EMULATOR_DEVICES_FILE_EXTENSION);
+
+        /// A missing or partly invalid file is not an error: the devices read from it are used, and the built-in devices complete them.
+        LoadDeviceDescriptions(devicesFilePath.asString().asASCIICharArray(), devices);
+    }
+
+    /// The built-in devices come after the file devices, so that the file devices override them.
+    const DeviceType builtInDeviceTypes[] = { Tahiti, CapeVerde, Pitcrain };
+
+    for (DeviceType deviceType : builtInDeviceTypes)
+    {
+        DeviceDescription builtInDevice;
+        GetBuiltInDeviceDescription(deviceType, builtInDevice);
+        devices.push_back(builtInDevice);
+    }
+
+    return FindDeviceDescription(devices, deviceName, device);
+}
+
+UTDPScheduler::UTDPScheduler(const std::vector<Instruction*>& instructions, DeviceType deviceType, size_t workDim, const std::vector<size_t>& globalWorkSize, const std::vector<size_t>& localWorkSize, double branchRate)
+    : m_workDim(workDim), m_globalWorkSize(globalWorkSize), m_localWorkSize(localWorkSize), m_branchRate(branchRate), m_wavefronts(0), m_throughput(0), m_threadNum(0)
+{
+    DeviceDescription builtInDevice;
+    GetBuiltInDeviceDescription(deviceType, builtInDevice);
+
+    /// The device is always found: the devices file can only override the built-in device.
+    DeviceDescription device;
+    GetDeviceDescription(builtInDevice.m_name, device);
+    InitDevice(instructions, device);
+}
+
+UTDPScheduler::UTDPScheduler(const std::vector<Instruction*>& instructions, const DeviceDescription& device, size_t workDim, const std::vector<size_t>& globalWorkSize, const std::vector<size_t>& localWorkSize, double branchRate)
+    : m_workDim(workDim), m_globalWorkSize(globalWorkSize), m_localWorkSize(localWorkSize), m_branchRate(branchRate), m_wavefronts(0), m_throughput(0), m_threadNum(0)
+{
+    InitDevice(instructions, device);
+}
+
+void
+UTDPScheduler::InitDevice(const std::vector<Instruction*>& instructions, const DeviceDescription& device)
+{
+    m_deviceName = device.m_name;
+    m_numCU = device.m_numCU;
+    m_clkToSec = device.m_clk;
+    m_maxWorkGoupSize = device.m_maxWorkGoupSize;
+    m_waveFrontSize = device.m_waveFrontSize;
+    m_pInstructions = &instructions;
+
+    m_vCUScheduler.assign(m_numCU, CUScheduler(m_branchRate, &instructions));
+
+    for (size_t cu = 0; cu < m_numCU; ++cu)
+    {
+        m_vCUScheduler[cu].SetCU(cu);
+    }
 
-    m_vCUScheduler.assign(m_numCU, CUScheduler(branchRate, &instructions));
     m_workGroupSize = std::accumulate(m_localWorkSize.begin(), m_localWorkSize.end(), 1, m_mul);
     size_t globalTotalWorkSize = std::accumulate(m_globalWorkSize.begin(), m_globalWorkSize.end(), 1, m_mul);
     m_workGroupNum = globalTotalWorkSize / m_workGroupSize;
@@ -119,14 +246,26 @@ UTDPScheduler::UTDPScheduler(const std::vector<Instruction*>& instructions, Devi
     /// Always the number of executed work-tems in lock-step is equal to m_waveFrontSize
     /// if m_workGroupSize is not evenly devided by m_waveFrontSize pad the wavefront by "nop" work-items.
     m_waveFrontNum = m_workGroupSize / m_waveFrontSize + m_workGroupSize % m_waveFrontSize;
-    m_workGroups.assign(m_workGroupNum, WorkGroup(m_waveFrontNum, &instructions));
+}
+
+size_t
+UTDPScheduler::GetWorkGroupNum(size_t cu) const
+{
+    /// Work group #wg is scheduled to compute unit #(wg % m_numCU).
+    return m_workGroupNum / m_numCU + ((cu < m_workGroupNum % m_numCU) ? 1 : 0);
 }
 
 void
-UTDPScheduler::Schedule(size_t workGroup, bool& isScheduleProgress)
+UTDPScheduler::ScheduleCUs(std::atomic<size_t>& nextCU)
 {
-    size_t cu = workGroup % m_numCU;
-    m_vCUScheduler[cu].ScheduleWG(m_workGroups[workGroup], isScheduleProgress);
+    /// All the work groups are identical, so they are not instantiated: each compute unit emulates one,
+    /// and accounts for all the work groups scheduled to it.
+    WorkGroup workGroup(m_waveFrontNum, m_pInstructions);
+
+    for (size_t cu = nextCU++; cu < m_numCU; cu = nextCU++)
+    {
+        m_vCUScheduler[cu].ScheduleWorkGroups(workGroup, GetWorkGroupNum(cu));
+    }
 }
 
 UTDPScheduler::StatusSchedule
@@ -141,23 +280,24 @@ UTDPScheduler::Schedule(size_t& exeClkNum)
         return Status_ScheduleInvalidWorkGroupSize;
     }
 
-    bool isScheduleProgress = true;
+    /// The compute units do not share any state, so each is emulated by a single thread.
+    size_t threadNum = (m_threadNum == 0) ? std::thread::hardware_concurrency() : m_threadNum;
+    threadNum = std::max(std::min(threadNum, m_numCU), (size_t)1);
+
+    std::atomic<size_t> nextCU(0);
+    std::vector<std::thread> threads;
 
-    while (isScheduleProgress)
+    for (size_t thread = 1; thread < threadNum; ++thread)
     {
-        isScheduleProgress = false;
-        bool isWorkGroupScheduleProgress = true;
+        threads.push_back(std::thread(&UTDPScheduler::ScheduleCUs, this, std::ref(nextCU)));
+    }
 
-        /// Execute an instruction from each work-group.
-        for (size_t workGroup = 0; workGroup < m_workGroupNum; ++workGroup)
-        {
-            Schedule(workGroup, isWorkGroupScheduleProgress);
+    /// The calling thread takes part in the emulation.
+    ScheduleCUs(nextCU);
 
-            if (isWorkGroupScheduleProgress)
-            {
-                isScheduleProgress = true;
-            }
-        }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
     }
 
     exeClkNum = 0;
@@ -287,11 +427,28 @@ UTDPScheduler::UpdateInstructionCounters(const std::vector<Instruction*>& instru
                 if (instructionFormat == Instruction::InstructionSet_SOPP)
                 {
                     SOPPInstruction* pSoppInstruction = static_cast<SOPPInstruction*>(pCurrentInstruction);
-                    SOPPInstruction::OP op = pSoppInstruction->GetOp();
                     SOPPInstruction::SIMM16 simm16 = pSoppInstruction->GetSIMM16();
+                    bool isBranch = false;
+                    bool isConditionalBranch = false;
+
+                    // The opcodes are defined per hardware generation.
+                    SISOPPInstruction* pSISoppInstruction = dynamic_cast<SISOPPInstruction*>(pSoppInstruction);
+                    VISOPPInstruction* pVISoppInstruction = dynamic_cast<VISOPPInstruction*>(pSoppInstruction);
+
+                    if (pSISoppInstruction != nullptr)
+                    {
+                        SISOPPInstruction::OP op = pSISoppInstruction->GetOp();
+                        isBranch = (op == SISOPPInstruction::S_BRANCH);
+                        isConditionalBranch = (op >= SISOPPInstruction::S_CBRANCH_SCC0 && op <= SISOPPInstruction::S_CBRANCH_EXECNZ);
+                    }
+                    else if (pVISoppInstruction != nullptr)
+                    {
+                        VISOPPInstruction::OP op = pVISoppInstruction->GetOp();
+                        isBranch = (op == VISOPPInstruction::s_branch);
+                        isConditionalBranch = (op >= VISOPPInstruction::s_cbranch_scc0 && op <= VISOPPInstruction::s_cbranch_execnz);
+                    }
 
-                    if (((op >= SOPPInstruction::S_CBRANCH_SCC0 && op <= SOPPInstruction::S_CBRANCH_EXECNZ) && IsBranchTaken(vBranchIteration[pc], branchRate, simm16 > 0)) ||
-                        op == SOPPInstruction::S_BRANCH)
+                    if ((isConditionalBranch && IsBranchTaken(vBranchIteration[pc], branchRate, simm16 > 0)) || isBranch)
                     {
                         vBranchIteration[pc]++;
                         m_instructionCounters.m_branchInstCount++;
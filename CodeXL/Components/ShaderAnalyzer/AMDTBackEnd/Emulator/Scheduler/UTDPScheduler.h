@@ -6,6 +6,8 @@
 #define __UTDPSCHEDULER_H
 
 
+#include <atomic>
+#include <string>
 #include <vector>
 #include "CUScheduler.h"
 #include "WorkGroup.h"
@@ -58,16 +60,81 @@ public:
     static const size_t DeviceMaxWorkGoupSizeCapeVerde;
     static const size_t DeviceMaxWorkGoupSizePitcrain;
 
+    /// The parameters of an emulated device.
+    struct DeviceDescription
+    {
+        /// The device name.
+        std::string m_name;
+
+        /// The number of compute units.
+        size_t m_numCU;
+
+        /// The number of work-items in the wavefront.
+        size_t m_waveFrontSize;
+
+        /// The maximum number of work-items in a work group.
+        size_t m_maxWorkGoupSize;
+
+        /// The value of clock (in nano-seconds).
+        size_t m_clk;
+
+        DeviceDescription() : m_numCU(0), m_waveFrontSize(0), m_maxWorkGoupSize(0), m_clk(0) {}
+    };
+
+    /// -----------------------------------------------------------------------------------------------
+    /// \brief Name:        GetBuiltInDeviceDescription
+    /// \brief Description: Get the description of one of the devices known to the emulator without a devices file.
+    /// \param[in]          deviceType
+    /// \param[out]         device
+    /// \return void
+    /// -----------------------------------------------------------------------------------------------
+    static void GetBuiltInDeviceDescription(DeviceType deviceType, DeviceDescription& device);
+
+    /// -----------------------------------------------------------------------------------------------
+    /// \brief Name:        LoadDeviceDescriptions
+    /// \brief Description: Load the device descriptions from a devices file. Each non-empty line of the file,
+    ///                     which does not start with '#', describes a device:
+    ///                     <name> <compute units> <wavefront size> <max work group size> <clock>
+    /// \param[in]          fileName
+    /// \param[out]         devices
+    /// \return True :      If the file was read, and all its lines are valid device descriptions.
+    /// \return False:      If no.
+    /// -----------------------------------------------------------------------------------------------
+    static bool LoadDeviceDescriptions(const std::string& fileName, std::vector<DeviceDescription>& devices);
+
+    /// -----------------------------------------------------------------------------------------------
+    /// \brief Name:        FindDeviceDescription
+    /// \brief Description: Find a device description by the device name (case insensitive).
+    /// \param[in]          devices
+    /// \param[in]          deviceName
+    /// \param[out]         device
+    /// \return True :      If the device was found.
+    /// \return False:      If no.
+    /// -----------------------------------------------------------------------------------------------
+    static bool FindDeviceDescription(const std::vector<DeviceDescription>& devices, const std::string& deviceName, DeviceDescription& device);
+
+    /// -----------------------------------------------------------------------------------------------
+    /// \brief Name:        GetDeviceDescription
+    /// \brief Description: Get the description of a device by its name. The devices file (EmulatorDevices.txt),
+    ///                     which is installed next to the CodeXL binaries, is searched first, so that it can
+    ///                     add devices and override the built-in ones.
+    /// \param[in]          deviceName
+    /// \param[out]         device
+    /// \return True :      If the device was found in the devices file or in the built-in devices.
+    /// \return False:      If no.
+    /// -----------------------------------------------------------------------------------------------
+    static bool GetDeviceDescription(const std::string& deviceName, DeviceDescription& device);
+
     /// -----------------------------------------------------------------------------------------------
     /// \brief Name:        UTDPScheduler
     /// \brief Description: c`tor
     /// \return
     /// -----------------------------------------------------------------------------------------------
-    UTDPScheduler(): m_wavefronts(0), m_throughput(0) {};
+    UTDPScheduler(): m_wavefronts(0), m_throughput(0), m_threadNum(1) {};
 
     /// -----------------------------------------------------------------------------------------------
     /// \brief Name:        UTDPScheduler
-    /// \brief Description: c`tor
+    /// \brief Description: c`tor. The device parameters are taken from the devices file when it describes the device.
     /// \param[in]          instructions
     /// \param[in]          deviceType
     /// \param[in]          workDim
@@ -77,6 +144,19 @@ public:
     /// \return
     /// -----------------------------------------------------------------------------------------------
     UTDPScheduler(const std::vector<Instruction*>& instructions, DeviceType deviceType, size_t workDim, const std::vector<size_t>& globalWorkSize, const std::vector<size_t>& localWorkSize, double branchRate);
+
+    /// -----------------------------------------------------------------------------------------------
+    /// \brief Name:        UTDPScheduler
+    /// \brief Description: c`tor
+    /// \param[in]          instructions
+    /// \param[in]          device - the emulated device, e.g. found with GetDeviceDescription
+    /// \param[in]          workDim
+    /// \param[in]          globalWorkSize
+    /// \param[in]          localWorkSize
+    /// \param[in]          branchRate
+    /// \return
+    /// -----------------------------------------------------------------------------------------------
+    UTDPScheduler(const std::vector<Instruction*>& instructions, const DeviceDescription& device, size_t workDim, const std::vector<size_t>& globalWorkSize, const std::vector<size_t>& localWorkSize, double branchRate);
     /// -----------------------------------------------------------------------------------------------
     /// \brief Name:        ~UTDPScheduler
     /// \brief Description: d`tor.
@@ -85,19 +165,30 @@ public:
     ~UTDPScheduler() {}
     /// -----------------------------------------------------------------------------------------------
     /// \brief Name:        Schedule
-    /// \brief Description:
+    /// \brief Description: The compute units are emulated in parallel, each on a single thread, so the result
+    ///                     does not depend on the number of threads.
     /// \param[in]          exeClkNum
     /// \return StatusSchedule Schedule the program kernel(s) and updated execution time.
     /// -----------------------------------------------------------------------------------------------
     StatusSchedule Schedule(size_t& exeClkNum);
+
     /// -----------------------------------------------------------------------------------------------
-    /// \brief Name:        Schedule
-    /// \brief Description:
-    /// \param[in]          workGroup
-    /// \param[in]          isScheduleProgress
-    /// \return void Schedule work group #workGroup
+    /// \brief Name:        SetThreadNum
+    /// \brief Description: Set the maximal number of threads used to emulate the compute units.
+    ///                     0 means one thread per hardware thread.
+    /// \param[in]          threadNum
+    /// \return void
     /// -----------------------------------------------------------------------------------------------
-    void Schedule(size_t workGroup, bool& isScheduleProgress);
+    void SetThreadNum(size_t threadNum) { m_threadNum = threadNum; }
+
+    /// -----------------------------------------------------------------------------------------------
+    /// \brief Name:        GetWorkGroupNum
+    /// \brief Description: Get the number of work groups scheduled to a compute unit.
+    ///                     Work groups are distributed to the compute units in a round robin order.
+    /// \param[in]          cu
+    /// \return size_t
+    /// -----------------------------------------------------------------------------------------------
+    size_t GetWorkGroupNum(size_t cu) const;
 
     /// -----------------------------------------------------------------------------------------------
     /// \brief Name:        IsWorkDimValid
@@ -241,8 +332,26 @@ public:
     double GetThroughput() const { return m_throughput; }
 
 private:
-    /// The device type.
-    DeviceType m_deviceType;
+    /// -----------------------------------------------------------------------------------------------
+    /// \brief Name:        ScheduleCUs
+    /// \brief Description: Thread function: emulate the compute units, taking the next unhandled compute unit
+    ///                     index from nextCU until all were emulated.
+    /// \param[in]          nextCU
+    /// \return void
+    /// -----------------------------------------------------------------------------------------------
+    void ScheduleCUs(std::atomic<size_t>& nextCU);
+
+    /// -----------------------------------------------------------------------------------------------
+    /// \brief Name:        InitDevice
+    /// \brief Description: Initialize the device parameters and the compute unit schedulers.
+    /// \param[in]          instructions
+    /// \param[in]          device
+    /// \return void
+    /// -----------------------------------------------------------------------------------------------
+    void InitDevice(const std::vector<Instruction*>& instructions, const DeviceDescription& device);
+
+    /// The device name.
+    std::string m_deviceName;
 
     /// The number of compute units in the device.
     size_t m_numCU;
@@ -277,8 +386,8 @@ private:
     /// The array of schedulers for all compute unit.
     std::vector<CUScheduler> m_vCUScheduler;
 
-    /// The array of all work groups.
-    std::vector<WorkGroup> m_workGroups;
+    /// The instructions [program kernel(s)] which the work groups execute.
+    const std::vector<Instruction*>* m_pInstructions;
 
     // The branchRate
     double m_branchRate;
@@ -315,6 +424,9 @@ private:
     /// The throughput
     double m_throughput;
 
+    /// The maximal number of threads used to emulate the compute units (0 - one per hardware thread).
+    size_t m_threadNum;
+
     void ResetInstructionsCounters();
 };
 
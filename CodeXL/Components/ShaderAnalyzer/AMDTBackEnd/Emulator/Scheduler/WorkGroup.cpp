@@ -16,7 +16,7 @@
 /// Local:
 #include "WorkGroup.h"
 
-WorkGroup::WorkGroup(size_t wavefrontNum, const std::vector<Instruction*>* pInstructions): m_waveFrontNum(wavefrontNum), m_isScheduled(false), m_isScheduleFinished(false), m_pInstructions(pInstructions)
+WorkGroup::WorkGroup(size_t wavefrontNum, const std::vector<Instruction*>* pInstructions): m_waveFrontNum(wavefrontNum), m_cu(0), m_isScheduled(false), m_isScheduleFinished(false), m_pInstructions(pInstructions)
 {
     m_wavefront.assign(wavefrontNum, WaveFront(pInstructions));
 }
@@ -62,8 +62,9 @@ WorkGroup::GetInstruction(size_t instIdx)
 }
 
 void
-WorkGroup::SetScheduled()
+WorkGroup::SetScheduled(size_t cu)
 {
+    m_cu = cu;
     m_isScheduled = true;
 }
 
@@ -81,10 +81,11 @@ public:
 
     /// -----------------------------------------------------------------------------------------------
     /// \brief Name:        SetScheduled
-    /// \brief Description: Set the indicator that the work group was  scheduled.
+    /// \brief Description: Set the indicator that the work group was  scheduled, to compute unit #cu.
+    /// \param[in]          cu
     /// \return void
     /// -----------------------------------------------------------------------------------------------
-    void SetScheduled();
+    void SetScheduled(size_t cu);
 
     /// -----------------------------------------------------------------------------------------------
     /// \brief Name:        SetScheduleFinished
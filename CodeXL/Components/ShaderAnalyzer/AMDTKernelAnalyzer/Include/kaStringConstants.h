@@ -212,6 +212,10 @@
 #define KA_STR_analsisSettingDefaultExecutionValuesNode L"DefaultExecutionValues"
 #define KA_STR_targetDeviceSettingsXMLSectionPageTitle L"KATargetDevice"
 #define KA_STR_targetDeviceSettingTargetDeviceNode L"TargetDevice"
+#define KA_STR_targetDeviceSettingParallelBuildsNode L"ParallelDeviceBuilds"
+#define KA_STR_parallelDeviceBuildsCaption "Concurrent device builds:"
+#define KA_STR_parallelDeviceBuildsAutomatic "Automatic"
+#define KA_STR_parallelDeviceBuildsTooltip "The number of devices which are built at the same time.\nAutomatic uses the number of CPU cores."
 
 
 // Tree Strings
@@ -390,6 +394,7 @@
 #define KA_STR_buildMainAnalysisFileName L"Analysis"
 #define KA_STR_buildMainBinaryFileName L"bin"
 #define KA_STR_buildMainBinaryFileNameASCII "bin"
+#define KA_STR_buildCacheDirectoryName L"KernelAnalyzerBuildCache"
 #define KA_STR_buildDXEntryPoint "main"
 
 // Progress notification
@@ -895,6 +900,7 @@ SV_Target[*], SV_TessFactor, SV_ViewportArrayIndex, SV_PrimitiveID, SV_VertexID,
 #define KA_STR_BUILD_CANCELLED_BY_USER_PREFIX "\n========== Build cancelled: "
 #define KA_STR_BUILD_CANCELLED_BY_USER_SUFFIX " devices skipped. ========== \n"
 #define KA_STR_BUILD_CANCELLED_BY_USER_NO_SKIPPED "\n========== Build cancelled. ========== \n"
+#define KA_STR_BUILD_CACHE_STATISTICS "\nBuild cache: %u up-to-date, %u built. The cache holds %u builds (%.1f MB).\n"
 
 
 // HTML Strings:
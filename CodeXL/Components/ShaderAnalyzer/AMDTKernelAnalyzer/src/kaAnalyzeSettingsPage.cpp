@@ -29,6 +29,7 @@
 #include <AMDTKernelAnalyzer/Include/kaStringConstants.h>
 
 #define KA_TARGET_DEVICES_TREE_VIEW_MIN_HEIGHT 300
+#define KA_PARALLEL_DEVICE_BUILDS_MAX 64
 
 // ---------------------------------------------------------------------------
 // Name:        kaAnalyzeSettingsPage::kaAnalyzeSettingsPage
@@ -38,7 +39,8 @@
 // ---------------------------------------------------------------------------
 kaAnalyzeSettingsPage::kaAnalyzeSettingsPage() :
     m_pInformationCaption(NULL),
-    m_pMainLayout(NULL), m_pTargetDevicesTreeView(NULL), m_pTargetDevicesTreeModel(NULL)
+    m_pMainLayout(NULL), m_pTargetDevicesTreeView(NULL), m_pTargetDevicesTreeModel(NULL),
+    m_pParallelDeviceBuildsSpinBox(NULL), m_maxParallelDeviceBuilds(0)
 {
 }
 
@@ -71,9 +73,21 @@ void kaAnalyzeSettingsPage::initialize()
     m_pTargetDevicesTreeView = new QTreeView(NULL);
     m_pTargetDevicesTreeView->setMinimumHeight(KA_TARGET_DEVICES_TREE_VIEW_MIN_HEIGHT);
 
+    m_pParallelDeviceBuildsSpinBox = new QSpinBox;
+    m_pParallelDeviceBuildsSpinBox->setRange(0, KA_PARALLEL_DEVICE_BUILDS_MAX);
+    m_pParallelDeviceBuildsSpinBox->setSpecialValueText(KA_STR_parallelDeviceBuildsAutomatic);
+    m_pParallelDeviceBuildsSpinBox->setToolTip(KA_STR_parallelDeviceBuildsTooltip);
+    m_pParallelDeviceBuildsSpinBox->setValue(m_maxParallelDeviceBuilds);
+
+    QHBoxLayout* pParallelDeviceBuildsLayout = new QHBoxLayout;
+    pParallelDeviceBuildsLayout->addWidget(new QLabel(KA_STR_parallelDeviceBuildsCaption));
+    pParallelDeviceBuildsLayout->addWidget(m_pParallelDeviceBuildsSpinBox);
+    pParallelDeviceBuildsLayout->addStretch(1);
+
     // Add widgets to layout:
     m_pMainLayout->addWidget(m_pInformationCaption);
     m_pMainLayout->addWidget(m_pTargetDevicesTreeView, 1);
+    m_pMainLayout->addLayout(pParallelDeviceBuildsLayout);
 
     // fill the tree with the default tree list:
     QStringList& defaultList = kaGlobalVariableManager::instance().defaultTreeList();
@@ -140,6 +154,7 @@ bool kaAnalyzeSettingsPage::getXMLSettingsString(gtString& projectAsXMLString)
         projectAsXMLString.appendFormattedString(L"<%ls>", xmlSectionTitle().asCharArray());
         gtString targetDeviceNode(KA_STR_targetDeviceSettingTargetDeviceNode);
         afUtils::addFieldToXML(projectAsXMLString, targetDeviceNode, saveStringAsStr);
+        afUtils::addFieldToXML(projectAsXMLString, KA_STR_targetDeviceSettingParallelBuildsNode, m_maxParallelDeviceBuilds);
         projectAsXMLString.appendFormattedString(L"</%ls>", xmlSectionTitle().asCharArray());
 
         retVal = true;
@@ -173,6 +188,11 @@ bool kaAnalyzeSettingsPage::setSettingsFromXMLString(const gtString& projectAsXM
         gtString targetDeviceNode(KA_STR_targetDeviceSettingTargetDeviceNode);
         afUtils::getFieldFromXML(*pKANode, targetDeviceNode, targetDeviceAsStr);
         afUtils::getFieldFromXML(*pKANode, KA_STR_analsisSettingDefaultExecutionValuesNode, defaultExecutionDataAsStr);
+
+        int maxParallelDeviceBuilds = 0;
+        afUtils::getFieldFromXML(*pKANode, KA_STR_targetDeviceSettingParallelBuildsNode, maxParallelDeviceBuilds);
+        setMaxParallelDeviceBuilds(maxParallelDeviceBuilds);
+
         // restore \t from escape code %9 since xml does not store tabs correctly
         targetDeviceAsStr.replace(L"%9", L"\t");
 
@@ -261,6 +281,11 @@ void kaAnalyzeSettingsPage::loadCurrentSettings()
         QStringList& currentList = kaGlobalVariableManager::instance().currentTreeList();
         replaceModel(currentList);
     }
+
+    GT_IF_WITH_ASSERT(m_pParallelDeviceBuildsSpinBox != NULL)
+    {
+        m_pParallelDeviceBuildsSpinBox->setValue(m_maxParallelDeviceBuilds);
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -277,6 +302,11 @@ void kaAnalyzeSettingsPage::restoreDefaultSettings()
         QStringList& defaultList = kaGlobalVariableManager::instance().defaultTreeList();
         replaceModel(defaultList);
     }
+
+    GT_IF_WITH_ASSERT(m_pParallelDeviceBuildsSpinBox != NULL)
+    {
+        m_pParallelDeviceBuildsSpinBox->setValue(0);
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -299,6 +329,11 @@ bool kaAnalyzeSettingsPage::saveCurrentSettings()
         retVal = true;
     }
 
+    GT_IF_WITH_ASSERT(m_pParallelDeviceBuildsSpinBox != NULL)
+    {
+        setMaxParallelDeviceBuilds(m_pParallelDeviceBuildsSpinBox->value());
+    }
+
     return retVal;
 }
 
@@ -354,6 +389,14 @@ void kaAnalyzeSettingsPage::replaceModel(QStringList& modelStringList)
     }
 }
 
+// ---------------------------------------------------------------------------
+void kaAnalyzeSettingsPage::setMaxParallelDeviceBuilds(int maxParallelDeviceBuilds)
+{
+    // Negative values in the settings file mean the default:
+    m_maxParallelDeviceBuilds = (maxParallelDeviceBuilds > 0) ? maxParallelDeviceBuilds : 0;
+    kaBackendManager::instance().SetMaxParallelDeviceBuilds(static_cast<unsigned int>(m_maxParallelDeviceBuilds));
+}
+
 // ---------------------------------------------------------------------------
 void kaAnalyzeSettingsPage::checkDriverVersion()
 {
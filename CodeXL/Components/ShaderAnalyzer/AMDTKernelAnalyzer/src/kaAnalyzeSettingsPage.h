@@ -51,6 +51,10 @@ private:
     /// Check if the driver version is not too old
     void checkDriverVersion();
 
+    /// Apply the number of concurrent device builds to the backend manager
+    /// \param[in] maxParallelDeviceBuilds the number of builds, or 0 to use the number of CPU cores
+    void setMaxParallelDeviceBuilds(int maxParallelDeviceBuilds);
+
     // Replace current model with a new one of a specific QStringList:
     void replaceModel(QStringList& modelStringList);
 
@@ -65,6 +69,12 @@ private:
 
     // Tree model of devices:
     kaTreeModel* m_pTargetDevicesTreeModel;
+
+    /// The number of device builds that run concurrently (0 for the number of CPU cores):
+    QSpinBox* m_pParallelDeviceBuildsSpinBox;
+
+    /// The applied number of concurrent device builds:
+    int m_maxParallelDeviceBuilds;
 };
 
 #endif // __KATARGETDEVICESETTINGPAGE_H
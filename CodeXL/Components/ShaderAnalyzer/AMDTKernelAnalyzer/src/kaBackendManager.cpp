@@ -19,9 +19,11 @@
 #include <cstring>
 #include <iostream>
 #include <algorithm>
+#include <condition_variable>
 #include <sstream>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <typeinfo>
 #include <vector>
@@ -52,6 +54,7 @@
 #include <AMDTOSAPIWrappers/Include/oaDriver.h>
 
 // Framework:
+#include <AMDTApplicationFramework/Include/afAidFunctions.h>
 #include <AMDTApplicationFramework/Include/afApplicationCommands.h>
 #include <AMDTApplicationFramework/Include/afGlobalVariablesManager.h>
 #include <AMDTApplicationFramework/Include/afMainAppWindow.h>
@@ -413,11 +416,17 @@ kaBackEndSmartPointers::~kaBackEndSmartPointers() { ; };
 kaBackendManager* kaBackendManager::m_psMySingleInstance = nullptr;
 
 //-----------------------------------------------------------------------------
-kaBackendManager::kaBackendManager() : m_firstTimeRun(true), m_isInBuild(false), m_isInitialized(false)
+kaBackendManager::kaBackendManager() : m_firstTimeRun(true), m_isInBuild(false), m_isInitialized(false), m_maxParallelDeviceBuilds(0)
 {
     m_pBoost = new kaBackEndSmartPointers;
     m_pBackend = Backend::Instance();
 
+    // The build cache is kept in the user data folder, so that it is shared by all the projects.
+    osFilePath buildCachePath;
+    afGetUserDataFolderPath(buildCachePath);
+    buildCachePath.appendSubDirectory(KA_STR_buildCacheDirectoryName);
+    m_pBuildCache.reset(new kaBuildCache(acGTStringToQString(buildCachePath.asString())));
+
     if (m_pBackend != nullptr && m_pBackend->Initialize(BuiltProgramKind_OpenCL, backendMessageCallback))
     {
         std::set<string> devices;
@@ -1462,9 +1471,6 @@ bool kaBackendManager::BuildThread::BuildOpenclSourceFile(kaSourceFile* pCurrent
 
         GT_IF_WITH_ASSERT(pOclOptions != nullptr)
         {
-            // Compile the code.
-            std::string cliOutput;
-
             // The index of the current build.
             int currBuildNumber = 1;
 
@@ -1495,48 +1501,79 @@ bool kaBackendManager::BuildThread::BuildOpenclSourceFile(kaSourceFile* pCurrent
 
                 int numberOfBuildAttempts = 0;
 
-                for (const std::string& device : devices)
+                gtString fileName;
+                pCurrentFile->filePath().getFileName(fileName);
+
+                // Device builds whose inputs did not change since they were last built are restored from the build cache.
+                kaBuildCache& buildCache = m_owner.GetBuildCache();
+                buildCache.ResetStatistics();
+                std::stringstream backendVersion;
+                backendVersion << GetCliVersionStamp(m_bitness) << ";" << m_bitness;
+                const std::string backendVersionStr = backendVersion.str();
+                const QString sourceCodePath = QString::fromStdString(sourceCodeFullPathName);
+                const QString outputDir = acGTStringToQString(osFilePath(isaFileName).fileDirectoryAsString());
+
+                RunDeviceSessions(devices,
+                                  [&](const std::string & device, std::string & cliOutput)
                 {
-                    if (!m_shouldBeCanceled)
+                    const QByteArray cacheKey = kaBuildCache::ComputeKey(sourceCodePath, buildOptions, device, backendVersionStr);
+
+                    if (!buildCache.Restore(cacheKey, outputDir, cliOutput))
                     {
-                        // Notify the user that the build started for the current device.
-                        gtString fileName;
-                        pCurrentFile->filePath().getFileName(fileName);
-                        std::stringstream buildMsg;
-                        buildMsg << std::endl << currBuildNumber++ << "> " << fileName.asASCIICharArray() << " for " << device << ": ";
-                        backendMessageCallback(buildMsg.str());
-                        m_owner.triggerMessageReady();
+                        const qint64 buildStartTime = QDateTime::currentMSecsSinceEpoch();
 
                         // Launch the session for that specific device.
-                        cliOutput.clear();
                         LaunchOpenCLSessionForDevice(m_bitness, isaFileName.asASCIICharArray(), ilFileName.asASCIICharArray(),
                                                      analysisFileName.asASCIICharArray(), binaryFile.asASCIICharArray(), device, sourceCodeFullPathName, buildOptions, m_shouldBeCanceled, cliOutput);
 
-                        const size_t MIN_OUTPUT_LEN = 3;
-
-                        if (!(cliOutput.size() < MIN_OUTPUT_LEN && m_shouldBeCanceled))
+                        // Only complete, successful builds are cached.
+                        if (!m_shouldBeCanceled && cliOutput.find(KA_CLI_STR_STATUS_SUCCESS) != string::npos)
                         {
-                            ++numberOfBuildAttempts;
+                            QStringList outputFiles;
+                            kaBuildCache::GetDeviceOutputFiles(outputDir, device, acGTStringToQString(fileName), buildStartTime, outputFiles);
+                            buildCache.Store(cacheKey, outputFiles, cliOutput);
                         }
+                    }
+                },
+                [&](const std::string & device, const std::string & cliOutput)
+                {
+                    // Notify the user that the build was done for the current device.
+                    std::stringstream buildMsg;
+                    buildMsg << std::endl << currBuildNumber++ << "> " << fileName.asASCIICharArray() << " for " << device << ": ";
+                    backendMessageCallback(buildMsg.str());
+                    m_owner.triggerMessageReady();
 
-                        if (cliOutput.find(KA_CLI_STR_STATUS_SUCCESS) != string::npos)
-                        {
-                            // We have another successful build.
-                            numOfSuccessfulBuilds++;
+                    const size_t MIN_OUTPUT_LEN = 3;
 
-                            // Store the name of the binary with the CL file's associated data
-                            pCurrentFile->buildFiles().append(acGTStringToQString(binaryFile));
-                        }
+                    if (!(cliOutput.size() < MIN_OUTPUT_LEN && m_shouldBeCanceled))
+                    {
+                        ++numberOfBuildAttempts;
+                    }
 
+                    if (cliOutput.find(KA_CLI_STR_STATUS_SUCCESS) != string::npos)
+                    {
+                        // We have another successful build.
+                        numOfSuccessfulBuilds++;
 
-                        // Inform the user.
-                        backendMessageCallback(cliOutput);
-                        m_owner.triggerMessageReady();
+                        // Store the name of the binary with the CL file's associated data
+                        pCurrentFile->buildFiles().append(acGTStringToQString(binaryFile));
                     }
-                }//for all devices
+
+
+                    // Inform the user.
+                    backendMessageCallback(cliOutput);
+                    m_owner.triggerMessageReady();
+                });
 
                 AggregateOpenCLStatistics(pCurrentFile, devices, analysisFileName);
 
+                // Report the build cache usage.
+                const kaBuildCache::Statistics cacheStatistics = buildCache.GetStatistics();
+                gtASCIIString cacheMsg;
+                cacheMsg.appendFormattedString(KA_STR_BUILD_CACHE_STATISTICS, cacheStatistics.m_hits, cacheStatistics.m_misses,
+                                               cacheStatistics.m_entriesCount, cacheStatistics.m_sizeInBytes / (1024.0 * 1024.0));
+                backendMessageCallback(cacheMsg.asCharArray());
+
                 PrintBuildEpilogue(numOfBuildsOverall, numOfSuccessfulBuilds, numberOfBuildAttempts);
                 result = (numOfBuildsOverall - numOfSuccessfulBuilds) == 0;
             }
@@ -1613,7 +1650,6 @@ void kaBackendManager::BuildThread::BuildGlslShader(kaSourceFile* pCurrentFile,
 
     if (pCurrentFile != nullptr)
     {
-        std::string cliOutput;
         gtVector<gtString> statisticsFiles;
 
         // The index of the current build.
@@ -1623,48 +1659,50 @@ void kaBackendManager::BuildThread::BuildGlslShader(kaSourceFile* pCurrentFile,
         // Reset the counter.
         numOfSuccessfulBuilds = 0;
 
-        for (const std::string& device : m_deviceNames)
+        RunDeviceSessions(m_deviceNames,
+                          [&](const std::string & device, std::string & cliOutput)
         {
-            if (!m_shouldBeCanceled)
-            {
-                // Prepare the dummy file names that contain the meta-data.
-                // This is being done just to align with the current tree handler mechanism,
-                // which is sub-optimal and will be revised in the next development time frame.
-                // This is temporary code.
-                const QString isaMetaFileName = acGTStringToQString(GenerateMetaFileName(m_kernelName, device, boftISA));
+            // Generate a file name to hold statistics for this device. The content of this file is copied to the aggregate statistics file
+            // after all the devices are built, and the individual device statistics files are deleted.
+            gtString deviceSpecificStatisticsFile;
+            GeneralFileNameToDeviceSpecificFileName(statisticsFileName, device, deviceSpecificStatisticsFile);
 
-                // Generate a file name to hold statistics for this device. The content of this file is copied to the aggregate statistics file
-                // after this devices loop is done, and the individual device statistics files are deleted.
-                gtString deviceSpecificStatisticsFile;
-                GeneralFileNameToDeviceSpecificFileName(statisticsFileName, device, deviceSpecificStatisticsFile);
-                statisticsFiles.push_back(deviceSpecificStatisticsFile);
+            // Launch the session for that specific device.
+            LaunchOpenGLSessionForDevice(m_bitness, m_glShaderType,
+                                         isaFileName.asASCIICharArray(), "", deviceSpecificStatisticsFile.asASCIICharArray(), device, sourceCodeFullPathName, m_shouldBeCanceled, cliOutput);
+        },
+        [&](const std::string & device, const std::string & cliOutput)
+        {
+            // Prepare the dummy file names that contain the meta-data.
+            // This is being done just to align with the current tree handler mechanism,
+            // which is sub-optimal and will be revised in the next development time frame.
+            // This is temporary code.
+            const QString isaMetaFileName = acGTStringToQString(GenerateMetaFileName(m_kernelName, device, boftISA));
 
-                // Notify the user that the build started for the current device.
-                std::stringstream buildMsg;
-                buildMsg << std::endl << currBuildNumber++ << "> " << device << ": ";
-                backendMessageCallback(buildMsg.str());
-                m_owner.triggerMessageReady();
+            gtString deviceSpecificStatisticsFile;
+            GeneralFileNameToDeviceSpecificFileName(statisticsFileName, device, deviceSpecificStatisticsFile);
+            statisticsFiles.push_back(deviceSpecificStatisticsFile);
 
-                // Launch the session for that specific device.
-                cliOutput.clear();
-                LaunchOpenGLSessionForDevice(m_bitness, m_glShaderType,
-                                             isaFileName.asASCIICharArray(), "", deviceSpecificStatisticsFile.asASCIICharArray(), device, sourceCodeFullPathName, m_shouldBeCanceled, cliOutput);
+            // Notify the user that the build was done for the current device.
+            std::stringstream buildMsg;
+            buildMsg << std::endl << currBuildNumber++ << "> " << device << ": ";
+            backendMessageCallback(buildMsg.str());
+            m_owner.triggerMessageReady();
 
-                // Inform the user.
-                backendMessageCallback(cliOutput);
-                m_owner.triggerMessageReady();
+            // Inform the user.
+            backendMessageCallback(cliOutput);
+            m_owner.triggerMessageReady();
 
-                if (cliOutput.find(KA_CLI_STR_STATUS_SUCCESS) != string::npos)
-                {
-                    // We have another successful build.
-                    numOfSuccessfulBuilds++;
+            if (cliOutput.find(KA_CLI_STR_STATUS_SUCCESS) != string::npos)
+            {
+                // We have another successful build.
+                numOfSuccessfulBuilds++;
 
-                    // Add the required meta files (to align with the existing tree handler mechanism).
-                    pCurrentFile->buildFiles().append(isaMetaFileName);
-                    isAnyDeviceBuildSuccessful = true;
-                }
+                // Add the required meta files (to align with the existing tree handler mechanism).
+                pCurrentFile->buildFiles().append(isaMetaFileName);
+                isAnyDeviceBuildSuccessful = true;
             }
-        }
+        });
 
         if (isAnyDeviceBuildSuccessful)
         {
@@ -1698,8 +1736,6 @@ bool kaBackendManager::BuildThread::BuildRenderProgram(const gtString& buildOutp
     // Will be used to summarize the build results for the user.
     int numOfSuccessfulBuilds = 0;
 
-    std::string cliOutput;
-
     gtMap<gtString, gtVector<gtString>> statisticsFilesGroups;  //stats per stage for all devices
     InitKaStageStatisticsGroups(statisticsFilesGroups);
 
@@ -1721,52 +1757,45 @@ bool kaBackendManager::BuildThread::BuildRenderProgram(const gtString& buildOutp
 
     int numOfBuildAttempts = 0;
 
-    for (const std::string& device : m_deviceNames)
+    RunDeviceSessions(m_deviceNames,
+                      [&](const std::string & device, std::string & cliOutput)
     {
-        if (!m_shouldBeCanceled)
-        {
-            // Prepare the dummy file names that contain the meta-data.
-            // This is being done just to align with the current tree handler mechanism,
-            // which is sub-optimal and will be revised in the next development time frame.
-            // This is temporary code.
-            const QString isaMetaFileName = acGTStringToQString(GenerateMetaFileName(m_kernelName, device, boftISA));
-
-            UpdateStatisticsFileGroups(statisticsFilesGroups, statisticsFileName, device);
+        // Launch the session for that specific device.
+        LaunchRenderSessionForDevice(m_buildType, m_bitness, m_shadersPaths,
+                                     isaFileName.asASCIICharArray(), ilFileName.asASCIICharArray(),
+                                     deviceStatisticsBaseFileName.asASCIICharArray(), binaryFileName.asASCIICharArray(),
+                                     device, m_shouldBeCanceled, cliOutput);
+    },
+    [&](const std::string & device, const std::string & cliOutput)
+    {
+        UpdateStatisticsFileGroups(statisticsFilesGroups, statisticsFileName, device);
 
-            // Notify the user that the build started for the current device.
-            std::stringstream buildMsg;
-            buildMsg << std::endl << currBuildNumber++ << "> " << device << ": ";
-            backendMessageCallback(buildMsg.str());
-            m_owner.triggerMessageReady();
+        // Notify the user that the build was done for the current device.
+        std::stringstream buildMsg;
+        buildMsg << std::endl << currBuildNumber++ << "> " << device << ": ";
+        backendMessageCallback(buildMsg.str());
+        m_owner.triggerMessageReady();
 
-            // Launch the session for that specific device.
-            cliOutput.clear();
-            LaunchRenderSessionForDevice(m_buildType, m_bitness, m_shadersPaths,
-                                         isaFileName.asASCIICharArray(), ilFileName.asASCIICharArray(),
-                                         deviceStatisticsBaseFileName.asASCIICharArray(), binaryFileName.asASCIICharArray(),
-                                         device, m_shouldBeCanceled, cliOutput);
+        // Inform the user.
+        backendMessageCallback(cliOutput);
+        m_owner.triggerMessageReady();
 
-            // Inform the user.
-            backendMessageCallback(cliOutput);
-            m_owner.triggerMessageReady();
-
-            if (cliOutput.find(KA_CLI_STR_STATUS_SUCCESS) != string::npos)
-            {
-                // We have another successful build.
-                numOfSuccessfulBuilds++;
+        if (cliOutput.find(KA_CLI_STR_STATUS_SUCCESS) != string::npos)
+        {
+            // We have another successful build.
+            numOfSuccessfulBuilds++;
 
-                // Add the required meta files (to align with the existing tree handler mechanism).
-                isAnyDeviceBuildSuccessful = true;
-            }
+            // Add the required meta files (to align with the existing tree handler mechanism).
+            isAnyDeviceBuildSuccessful = true;
+        }
 
-            const size_t MIN_OUTPUT_LEN = 3;
+        const size_t MIN_OUTPUT_LEN = 3;
 
-            if (!(cliOutput.size() < MIN_OUTPUT_LEN && m_shouldBeCanceled))
-            {
-                ++numOfBuildAttempts;
-            }
+        if (!(cliOutput.size() < MIN_OUTPUT_LEN && m_shouldBeCanceled))
+        {
+            ++numOfBuildAttempts;
         }
-    }
+    });
 
     //  for (const gtVector<gtString>& group : statisticsFilesGroups)
 
@@ -1901,7 +1930,6 @@ bool kaBackendManager::BuildThread::BuildDxShader(kaSourceFile* pCurrentFile,
 
     if (pCurrentFile != nullptr && !m_shouldBeCanceled)
     {
-        std::string cliOutput;
         gtVector<gtString> statisticsFiles;
 
         // The index of the current build.
@@ -1922,83 +1950,80 @@ bool kaBackendManager::BuildThread::BuildDxShader(kaSourceFile* pCurrentFile,
 
             int numOfBuildAttempts = 0;
 
-            for (const std::string& device : m_deviceNames)
+            RunDeviceSessions(m_deviceNames,
+                              [&](const std::string & device, std::string & cliOutput)
             {
-                if (!m_shouldBeCanceled)
-                {
-                    // Generate a file name to hold statistics for this device. The content of this file is copied to the aggregate statistics file
-                    // after this devices loop is done, and the individual device statistics files are deleted.
-                    osFilePath currentStatsFilePath = GenerateDXStatsFName(pCurrentFile, statisticsFileName, device);
-
-
-                    // Notify the user that the build started for the current device.
-                    std::stringstream buildMsg;
-                    buildMsg << std::endl << currBuildNumber++ << "> " << device << ": ";
-                    backendMessageCallback(buildMsg.str());
-                    m_owner.triggerMessageReady();
-
-                    // Launch the session for that specific device.
-                    cliOutput.clear();
-
-                    // Patch up the DX ASM output file to contain the device name.
-                    osFilePath dxAsmFilePath(dxAsmFileName);
-                    gtString originalDxAsmFileName;
-                    dxAsmFilePath.getFileName(originalDxAsmFileName);
-                    gtString fixedDxAsmFileName;
-                    fixedDxAsmFileName.fromASCIIString(device.c_str());
-                    fixedDxAsmFileName << L"_" << originalDxAsmFileName;
-                    dxAsmFilePath.setFileName(fixedDxAsmFileName);
-
-                    // Launch the CLI.
-                    LaunchDXSessionForDevice(m_bitness, profile.asASCIICharArray(),
-                                             entryPoint.asASCIICharArray(),
-                                             m_dxBuildOptions.m_buildOptions.toStdString(),
-                                             m_dxBuildOptions, isaFileName.asASCIICharArray(), binFileName.asASCIICharArray(), "",
-                                             currentStatsFilePath.asString().asASCIICharArray(), dxAsmFilePath.asString().asASCIICharArray(),
-                                             device, sourceCodeFullPathName, isIntrinsicsEnabled, m_shouldBeCanceled, cliOutput);
-
-                    // Rename the DX ASM file to align with the front-end's expected file name.
-                    osFilePath fixedDxAsmFilePath(dxAsmFilePath);
-                    dxAsmFilePath.getFileName(originalDxAsmFileName);
-                    fixedDxAsmFileName.makeEmpty();
-                    fixedDxAsmFileName << entryPoint;
-                    fixedDxAsmFileName << L"_" << originalDxAsmFileName;
-                    fixedDxAsmFilePath.setFileName(fixedDxAsmFileName);
-                    gtString deviceName;
-                    deviceName.fromASCIIString(device.c_str());
-                    deviceName << L"_";
-                    fixedDxAsmFileName.replace(deviceName, L"");
-                    fixedDxAsmFileName.prepend(deviceName);
-                    dxAsmFilePath.setFileName(fixedDxAsmFileName);
-                    fixedDxAsmFilePath.Rename(dxAsmFilePath.asString());
-
-                    // Handle the statistics file.
-                    gtString statsFileName;
-                    currentStatsFilePath.getFileName(statsFileName);
-                    statsFileName.prepend(L"_").prepend(entryPoint);
-                    currentStatsFilePath.setFileName(statsFileName);
-                    statisticsFiles.push_back(currentStatsFilePath.asString());
+                // Generate a file name to hold statistics for this device. The content of this file is copied to the aggregate statistics file
+                // after all the devices are built, and the individual device statistics files are deleted.
+                osFilePath currentStatsFilePath = GenerateDXStatsFName(pCurrentFile, statisticsFileName, device);
+
+                // Patch up the DX ASM output file to contain the device name.
+                osFilePath dxAsmFilePath(dxAsmFileName);
+                gtString originalDxAsmFileName;
+                dxAsmFilePath.getFileName(originalDxAsmFileName);
+                gtString fixedDxAsmFileName;
+                fixedDxAsmFileName.fromASCIIString(device.c_str());
+                fixedDxAsmFileName << L"_" << originalDxAsmFileName;
+                dxAsmFilePath.setFileName(fixedDxAsmFileName);
+
+                // Launch the CLI.
+                LaunchDXSessionForDevice(m_bitness, profile.asASCIICharArray(),
+                                         entryPoint.asASCIICharArray(),
+                                         m_dxBuildOptions.m_buildOptions.toStdString(),
+                                         m_dxBuildOptions, isaFileName.asASCIICharArray(), binFileName.asASCIICharArray(), "",
+                                         currentStatsFilePath.asString().asASCIICharArray(), dxAsmFilePath.asString().asASCIICharArray(),
+                                         device, sourceCodeFullPathName, isIntrinsicsEnabled, m_shouldBeCanceled, cliOutput);
+
+                // Rename the DX ASM file to align with the front-end's expected file name.
+                osFilePath fixedDxAsmFilePath(dxAsmFilePath);
+                dxAsmFilePath.getFileName(originalDxAsmFileName);
+                fixedDxAsmFileName.makeEmpty();
+                fixedDxAsmFileName << entryPoint;
+                fixedDxAsmFileName << L"_" << originalDxAsmFileName;
+                fixedDxAsmFilePath.setFileName(fixedDxAsmFileName);
+                gtString deviceName;
+                deviceName.fromASCIIString(device.c_str());
+                deviceName << L"_";
+                fixedDxAsmFileName.replace(deviceName, L"");
+                fixedDxAsmFileName.prepend(deviceName);
+                dxAsmFilePath.setFileName(fixedDxAsmFileName);
+                fixedDxAsmFilePath.Rename(dxAsmFilePath.asString());
+            },
+            [&](const std::string & device, const std::string & cliOutput)
+            {
+                // Handle the statistics file.
+                osFilePath currentStatsFilePath = GenerateDXStatsFName(pCurrentFile, statisticsFileName, device);
+                gtString statsFileName;
+                currentStatsFilePath.getFileName(statsFileName);
+                statsFileName.prepend(L"_").prepend(entryPoint);
+                currentStatsFilePath.setFileName(statsFileName);
+                statisticsFiles.push_back(currentStatsFilePath.asString());
+
+                // Notify the user that the build was done for the current device.
+                std::stringstream buildMsg;
+                buildMsg << std::endl << currBuildNumber++ << "> " << device << ": ";
+                backendMessageCallback(buildMsg.str());
+                m_owner.triggerMessageReady();
 
-                    // Inform the user.
-                    backendMessageCallback(cliOutput);
-                    m_owner.triggerMessageReady();
+                // Inform the user.
+                backendMessageCallback(cliOutput);
+                m_owner.triggerMessageReady();
 
-                    if (cliOutput.find(KA_CLI_STR_STATUS_SUCCESS) != string::npos)
-                    {
-                        // We have another successful build.
-                        numOfSuccessfulBuilds++;
+                if (cliOutput.find(KA_CLI_STR_STATUS_SUCCESS) != string::npos)
+                {
+                    // We have another successful build.
+                    numOfSuccessfulBuilds++;
 
-                        isAnyDeviceBuildSuccessful = true;
-                    }
+                    isAnyDeviceBuildSuccessful = true;
+                }
 
-                    const size_t MIN_OUTPUT_LEN = 3;
+                const size_t MIN_OUTPUT_LEN = 3;
 
-                    if (!(cliOutput.size() < MIN_OUTPUT_LEN && m_shouldBeCanceled))
-                    {
-                        ++numOfBuildAttempts;
-                    }
+                if (!(cliOutput.size() < MIN_OUTPUT_LEN && m_shouldBeCanceled))
+                {
+                    ++numOfBuildAttempts;
                 }
-            }
+            });
 
             if (isAnyDeviceBuildSuccessful)
             {
@@ -2035,6 +2060,92 @@ osFilePath kaBackendManager::BuildThread::GenerateDXStatsFName(kaSourceFile* pCu
 
 #endif
 
+//-----------------------------------------------------------------------------
+void kaBackendManager::BuildThread::RunDeviceSessions(const std::set<std::string>& devices,
+                                                      const std::function<void(const std::string& device, std::string& cliOutput)>& launchSession,
+                                                      const std::function<void(const std::string& device, const std::string& cliOutput)>& handleSessionResult)
+{
+    // The state of a single device session.
+    struct DeviceSession
+    {
+        std::string m_device;
+        std::string m_cliOutput;
+        bool m_isLaunched = false;
+        bool m_isEnded = false;
+    };
+
+    std::vector<DeviceSession> sessions(devices.size());
+    size_t sessionIndex = 0;
+
+    for (const std::string& device : devices)
+    {
+        sessions[sessionIndex++].m_device = device;
+    }
+
+    std::mutex sessionsMutex;
+    std::condition_variable sessionEndedCondition;
+    std::atomic<size_t> nextSessionIndex(0);
+
+    // Each worker takes the next device until all the devices were taken. Once the build is canceled,
+    // the remaining devices are ended without being launched, so that the build thread does not wait for them.
+    auto workerFunc = [&]()
+    {
+        for (size_t i = nextSessionIndex++; i < sessions.size(); i = nextSessionIndex++)
+        {
+            std::string cliOutput;
+            const bool shouldLaunch = !m_shouldBeCanceled;
+
+            if (shouldLaunch)
+            {
+                launchSession(sessions[i].m_device, cliOutput);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(sessionsMutex);
+                sessions[i].m_cliOutput.swap(cliOutput);
+                sessions[i].m_isLaunched = shouldLaunch;
+                sessions[i].m_isEnded = true;
+            }
+
+            sessionEndedCondition.notify_all();
+        }
+    };
+
+    const size_t maxWorkersCount = m_owner.GetMaxParallelDeviceBuilds();
+    const size_t workersCount = (sessions.size() < maxWorkersCount) ? sessions.size() : maxWorkersCount;
+    std::vector<std::thread> workers;
+    workers.reserve(workersCount);
+
+    for (size_t i = 0; i < workersCount; ++i)
+    {
+        workers.push_back(std::thread(workerFunc));
+    }
+
+    // Replay the session results in device order, so that the build output does not depend on the sessions timing.
+    for (DeviceSession& session : sessions)
+    {
+        std::string cliOutput;
+        bool isLaunched = false;
+
+        {
+            std::unique_lock<std::mutex> lock(sessionsMutex);
+            sessionEndedCondition.wait(lock, [&session]() { return session.m_isEnded; });
+            cliOutput.swap(session.m_cliOutput);
+            isLaunched = session.m_isLaunched;
+        }
+
+        if (isLaunched)
+        {
+            handleSessionResult(session.m_device, cliOutput);
+        }
+    }
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
 //-----------------------------------------------------------------------------
 void kaBackendManager::BuildThread::run()
 {
@@ -2536,6 +2647,20 @@ bool kaBackendManager::IsBuildSucceded() const
     return m_pBoost->m_pBuildThread->m_buildSucceded;
 }
 
+unsigned int kaBackendManager::GetMaxParallelDeviceBuilds() const
+{
+    unsigned int result = m_maxParallelDeviceBuilds;
+
+    if (result == 0)
+    {
+        // Each device build is a CLI process, so use all the CPU cores.
+        const int idealThreadCount = QThread::idealThreadCount();
+        result = (idealThreadCount > 0) ? static_cast<unsigned int>(idealThreadCount) : 1;
+    }
+
+    return result;
+}
+
 gtVector<int> kaBackendManager::GetLastBuildProgramFileIds() const
 {
     gtVector<int> result;
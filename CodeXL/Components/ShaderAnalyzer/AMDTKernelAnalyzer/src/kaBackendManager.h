@@ -15,6 +15,8 @@
 #ifndef _BACKEND_MANAGER_H_
 #define _BACKEND_MANAGER_H_
 
+#include <atomic>
+#include <functional>
 #include <list>
 #include <memory>
 #include <set>
@@ -44,6 +46,7 @@
 #include <AMDTKernelAnalyzer/Include/kaAMDTKernelAnalyzerDLLBuild.h>
 #include <AMDTKernelAnalyzer/src/kaDataTypes.h>
 #include <AMDTKernelAnalyzer/src/kaProgram.h>
+#include <AMDTKernelAnalyzer/src/kaBuildCache.h>
 
 // Backend:
 #include <AMDTBackEnd/Include/beBackend.h>
@@ -290,6 +293,19 @@ public:
     /// Checks if current build has been succeeded, i.e. zero failed files.
     /// \retval bool true if succeeded
     bool IsBuildSucceded() const;
+
+    /// Sets the maximal number of device builds that run concurrently.
+    /// \param[in] maxParallelDeviceBuilds the number of builds, or 0 to use the number of CPU cores
+    void SetMaxParallelDeviceBuilds(unsigned int maxParallelDeviceBuilds) { m_maxParallelDeviceBuilds = maxParallelDeviceBuilds; }
+
+    /// Gets the maximal number of device builds that run concurrently.
+    /// \retval unsigned int the number of builds (at least 1)
+    unsigned int GetMaxParallelDeviceBuilds() const;
+
+    /// Gets the cache of the device build outputs.
+    /// \retval kaBuildCache& the build cache
+    kaBuildCache& GetBuildCache() { return *m_pBuildCache; }
+
     gtVector<int> GetLastBuildProgramFileIds() const;
     gtString GetLastBuildProgramName() const;
 
@@ -429,6 +445,16 @@ private:
         void AggregateOpenCLStatistics(kaSourceFile* pCurrentFile, const std::set<std::string>& devices, const gtString& analysisFileName) const;
         osFilePath GenerateDXStatsFName(kaSourceFile* pCurrentFile, const gtString& statisticsFileName, const std::string& device) const;
 
+        /// Runs a build session for each device on a bounded pool of worker threads.
+        /// The session results are handled on the build thread in device order, each one as soon as it and all the sessions before it ended.
+        /// Devices that were not launched because the build was canceled are not handled.
+        /// \param[in] devices             the devices to build for
+        /// \param[in] launchSession       launches the session of a single device and gets its CLI output. Called on the worker threads
+        /// \param[in] handleSessionResult handles the CLI output of a single device session. Called on the build thread
+        void RunDeviceSessions(const std::set<std::string>& devices,
+                               const std::function<void(const std::string& device, std::string& cliOutput)>& launchSession,
+                               const std::function<void(const std::string& device, const std::string& cliOutput)>& handleSessionResult);
+
 
         //Members
     public:
@@ -471,7 +497,7 @@ private:
         std::string m_kernelName;
 
         /// cancellation flag set from kaBackendManager
-        bool m_shouldBeCanceled;
+        std::atomic<bool> m_shouldBeCanceled;
         bool m_buildSucceded = false;
 
         /// GL/VK shaders structure
@@ -546,6 +572,12 @@ private:
     bool m_buildCompleted = true;
     unique_ptr<std::thread> m_executionThread = nullptr;
     bool m_stopExecutionThread = false;
+
+    /// The maximal number of device builds that run concurrently, or 0 to use the number of CPU cores
+    std::atomic<unsigned int> m_maxParallelDeviceBuilds;
+
+    /// The cache of the device build outputs
+    std::unique_ptr<kaBuildCache> m_pBuildCache;
     //-----------------------------------------------------------------------------
     /// General setup for a build
     /// \param[in] sourceCode   A source code for a build
@@ -0,0 +1,401 @@
+//------------------------------ kaBuildCache.cpp ------------------------------
+
+// C++:
+#include <set>
+#include <sstream>
+
+// Qt:
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+// Local:
+#include <AMDTKernelAnalyzer/src/kaBuildCache.h>
+
+// The name of the file that holds the CLI output in each cache entry.
+static const char* const KA_BUILD_CACHE_CLI_OUTPUT_FILE_NAME = "cli_output.txt";
+
+// The suffix of an entry directory while the entry is being written.
+static const char* const KA_BUILD_CACHE_TEMP_ENTRY_SUFFIX = ".tmp";
+
+// The default maximal size of the cache entries.
+static const qint64 KA_BUILD_CACHE_DEFAULT_MAX_SIZE = 256 * 1024 * 1024;
+
+// The maximal depth of nested include files that are hashed with the source.
+static const int KA_BUILD_CACHE_MAX_INCLUDE_DEPTH = 16;
+
+// *** INTERNALLY-LINKED AUXILIARY FUNCTIONS - BEGIN ***
+
+// Gets the include directories, passed with -I, from the build options.
+static void GetIncludeDirectories(const std::string& buildOptions, QStringList& includeDirectories)
+{
+    std::istringstream optionsStream(buildOptions);
+    std::string option;
+    bool isIncludeDirectoryNext = false;
+
+    while (optionsStream >> option)
+    {
+        QString includeDirectory;
+
+        if (isIncludeDirectoryNext)
+        {
+            includeDirectory = QString::fromStdString(option);
+            isIncludeDirectoryNext = false;
+        }
+        else if (option == "-I")
+        {
+            isIncludeDirectoryNext = true;
+        }
+        else if (option.compare(0, 2, "-I") == 0)
+        {
+            includeDirectory = QString::fromStdString(option.substr(2));
+        }
+
+        includeDirectory.remove('"');
+
+        if (!includeDirectory.isEmpty())
+        {
+            includeDirectories << includeDirectory;
+        }
+    }
+}
+
+// Adds a source file and the local files it includes (#include "...") to the hash.
+// Files that can not be found are skipped: the build fails the same way whether it is cached or not.
+static bool HashSourceFile(const QString& filePath, const QStringList& includeDirectories, int depth,
+                           std::set<QString>& hashedFiles, QCryptographicHash& hash)
+{
+    QFile sourceFile(filePath);
+    bool ret = sourceFile.open(QIODevice::ReadOnly);
+
+    if (ret)
+    {
+        const QByteArray sourceText = sourceFile.readAll();
+        hash.addData(filePath.toUtf8());
+        hash.addData(sourceText);
+
+        if (depth < KA_BUILD_CACHE_MAX_INCLUDE_DEPTH)
+        {
+            const QString sourceDirectory = QFileInfo(filePath).absolutePath();
+
+            for (const QByteArray& line : sourceText.split('\n'))
+            {
+                const QByteArray trimmedLine = line.trimmed();
+
+                if (trimmedLine.startsWith('#') && trimmedLine.mid(1).trimmed().startsWith("include"))
+                {
+                    // Only local includes are followed, system headers belong to the CLI version.
+                    const int nameStart = trimmedLine.indexOf('"');
+                    const int nameEnd = (nameStart >= 0) ? trimmedLine.indexOf('"', nameStart + 1) : -1;
+
+                    if (nameEnd > nameStart)
+                    {
+                        const QString includeName = QString::fromUtf8(trimmedLine.mid(nameStart + 1, nameEnd - nameStart - 1));
+                        QStringList searchDirectories(sourceDirectory);
+                        searchDirectories << includeDirectories;
+
+                        for (const QString& searchDirectory : searchDirectories)
+                        {
+                            const QString includePath = QFileInfo(QDir(searchDirectory), includeName).absoluteFilePath();
+
+                            if (QFileInfo(includePath).isFile())
+                            {
+                                if (hashedFiles.insert(includePath).second)
+                                {
+                                    HashSourceFile(includePath, includeDirectories, depth + 1, hashedFiles, hash);
+                                }
+
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Gets the total size of the files in a directory.
+static qint64 GetDirectorySize(const QString& directoryPath)
+{
+    qint64 ret = 0;
+
+    for (const QFileInfo& fileInfo : QDir(directoryPath).entryInfoList(QDir::Files))
+    {
+        ret += fileInfo.size();
+    }
+
+    return ret;
+}
+
+// Writes the CLI output file of an entry. This also marks the entry as used now.
+static bool WriteCliOutputFile(const QString& entryDirectory, const std::string& cliOutput)
+{
+    QFile cliOutputFile(QDir(entryDirectory).filePath(KA_BUILD_CACHE_CLI_OUTPUT_FILE_NAME));
+    bool ret = cliOutputFile.open(QIODevice::WriteOnly | QIODevice::Truncate);
+
+    if (ret)
+    {
+        ret = (cliOutputFile.write(cliOutput.data(), cliOutput.size()) == static_cast<qint64>(cliOutput.size()));
+    }
+
+    return ret;
+}
+
+// *** INTERNALLY-LINKED AUXILIARY FUNCTIONS - END ***
+
+kaBuildCache::kaBuildCache(const QString& cacheDirectory) : m_cacheDirectory(cacheDirectory), m_maxSizeInBytes(KA_BUILD_CACHE_DEFAULT_MAX_SIZE),
+    m_isIndexLoaded(false), m_sizeInBytes(0), m_hits(0), m_misses(0)
+{
+}
+
+void kaBuildCache::SetMaxSizeInBytes(qint64 maxSizeInBytes)
+{
+    QMutexLocker lock(&m_mutex);
+    m_maxSizeInBytes = maxSizeInBytes;
+
+    if (m_isIndexLoaded)
+    {
+        EvictEntries();
+    }
+}
+
+QByteArray kaBuildCache::ComputeKey(const QString& sourceFilePath, const std::string& buildOptions, const std::string& device, const std::string& backendVersion)
+{
+    QByteArray ret;
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    QStringList includeDirectories;
+    GetIncludeDirectories(buildOptions, includeDirectories);
+    std::set<QString> hashedFiles;
+
+    if (HashSourceFile(QFileInfo(sourceFilePath).absoluteFilePath(), includeDirectories, 0, hashedFiles, hash))
+    {
+        // Separate the fields, so that moving text between them changes the key.
+        hash.addData("\0", 1);
+        hash.addData(buildOptions.data(), static_cast<int>(buildOptions.size()));
+        hash.addData("\0", 1);
+        hash.addData(device.data(), static_cast<int>(device.size()));
+        hash.addData("\0", 1);
+        hash.addData(backendVersion.data(), static_cast<int>(backendVersion.size()));
+        ret = hash.result().toHex();
+    }
+
+    return ret;
+}
+
+bool kaBuildCache::Restore(const QByteArray& key, const QString& outputDirectory, std::string& cliOutput)
+{
+    bool ret = false;
+    QMutexLocker lock(&m_mutex);
+
+    if (!key.isEmpty() && m_maxSizeInBytes > 0)
+    {
+        LoadIndex();
+        const QString entryName = QString::fromLatin1(key);
+        auto entryIter = m_entries.find(entryName);
+
+        if (entryIter != m_entries.end())
+        {
+            const QDir entryDir(EntryDirectory(entryName));
+            QFile cliOutputFile(entryDir.filePath(KA_BUILD_CACHE_CLI_OUTPUT_FILE_NAME));
+            ret = cliOutputFile.open(QIODevice::ReadOnly);
+
+            if (ret)
+            {
+                const QByteArray cachedCliOutput = cliOutputFile.readAll();
+                cliOutputFile.close();
+                cliOutput.assign(cachedCliOutput.constData(), cachedCliOutput.size());
+
+                for (const QFileInfo& fileInfo : entryDir.entryInfoList(QDir::Files))
+                {
+                    if (ret && fileInfo.fileName() != KA_BUILD_CACHE_CLI_OUTPUT_FILE_NAME)
+                    {
+                        const QString outputFilePath = QDir(outputDirectory).filePath(fileInfo.fileName());
+                        QFile::remove(outputFilePath);
+                        ret = QFile::copy(fileInfo.absoluteFilePath(), outputFilePath);
+                    }
+                }
+            }
+
+            if (ret)
+            {
+                WriteCliOutputFile(entryDir.absolutePath(), cliOutput);
+                entryIter->second.m_lastUseTime = QDateTime::currentMSecsSinceEpoch();
+            }
+            else
+            {
+                // The entry is broken (e.g. deleted by the user), so it is dropped.
+                cliOutput.clear();
+                m_sizeInBytes -= entryIter->second.m_sizeInBytes;
+                m_entries.erase(entryIter);
+                QDir(entryDir).removeRecursively();
+            }
+        }
+
+        if (ret)
+        {
+            ++m_hits;
+        }
+        else
+        {
+            ++m_misses;
+        }
+    }
+
+    return ret;
+}
+
+bool kaBuildCache::Store(const QByteArray& key, const QStringList& outputFiles, const std::string& cliOutput)
+{
+    bool ret = false;
+    QMutexLocker lock(&m_mutex);
+
+    if (!key.isEmpty() && !outputFiles.isEmpty() && m_maxSizeInBytes > 0)
+    {
+        LoadIndex();
+        const QString entryName = QString::fromLatin1(key);
+
+        // Write the entry into a temporary directory, so that a partially written entry is never restored.
+        const QString entryDirPath = EntryDirectory(entryName);
+        const QString tempEntryDirPath = entryDirPath + KA_BUILD_CACHE_TEMP_ENTRY_SUFFIX;
+        QDir tempEntryDir(tempEntryDirPath);
+        tempEntryDir.removeRecursively();
+        ret = QDir().mkpath(tempEntryDirPath);
+
+        for (const QString& outputFile : outputFiles)
+        {
+            if (ret)
+            {
+                ret = QFile::copy(outputFile, tempEntryDir.filePath(QFileInfo(outputFile).fileName()));
+            }
+        }
+
+        ret = ret && WriteCliOutputFile(tempEntryDirPath, cliOutput);
+
+        if (ret)
+        {
+            auto entryIter = m_entries.find(entryName);
+
+            if (entryIter != m_entries.end())
+            {
+                m_sizeInBytes -= entryIter->second.m_sizeInBytes;
+                m_entries.erase(entryIter);
+            }
+
+            QDir(entryDirPath).removeRecursively();
+            ret = QDir().rename(tempEntryDirPath, entryDirPath);
+        }
+
+        if (ret)
+        {
+            Entry& entry = m_entries[entryName];
+            entry.m_sizeInBytes = GetDirectorySize(entryDirPath);
+            entry.m_lastUseTime = QDateTime::currentMSecsSinceEpoch();
+            m_sizeInBytes += entry.m_sizeInBytes;
+            EvictEntries();
+        }
+        else
+        {
+            tempEntryDir.removeRecursively();
+        }
+    }
+
+    return ret;
+}
+
+void kaBuildCache::GetDeviceOutputFiles(const QString& outputDirectory, const std::string& device, const QString& sourceFileName, qint64 buildStartTime, QStringList& outputFiles)
+{
+    // The CLI names the output files <device>_<kernel>_<source file name>.<extension>.
+    const QString devicePrefix = QString::fromStdString(device) + "_";
+
+    // File times may have a resolution of a second.
+    const qint64 minModificationTime = buildStartTime - (buildStartTime % 1000);
+
+    for (const QFileInfo& fileInfo : QDir(outputDirectory).entryInfoList(QDir::Files))
+    {
+        if (fileInfo.fileName().startsWith(devicePrefix) && fileInfo.completeBaseName().endsWith(sourceFileName) &&
+            fileInfo.lastModified().toMSecsSinceEpoch() >= minModificationTime)
+        {
+            outputFiles << fileInfo.absoluteFilePath();
+        }
+    }
+}
+
+kaBuildCache::Statistics kaBuildCache::GetStatistics()
+{
+    QMutexLocker lock(&m_mutex);
+    LoadIndex();
+
+    Statistics ret;
+    ret.m_hits = m_hits;
+    ret.m_misses = m_misses;
+    ret.m_sizeInBytes = m_sizeInBytes;
+    ret.m_entriesCount = static_cast<unsigned int>(m_entries.size());
+    return ret;
+}
+
+void kaBuildCache::ResetStatistics()
+{
+    QMutexLocker lock(&m_mutex);
+    m_hits = 0;
+    m_misses = 0;
+}
+
+void kaBuildCache::LoadIndex()
+{
+    if (!m_isIndexLoaded)
+    {
+        m_isIndexLoaded = true;
+        QDir cacheDir(m_cacheDirectory);
+
+        for (const QFileInfo& entryInfo : cacheDir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot))
+        {
+            const QFileInfo cliOutputInfo(QDir(entryInfo.absoluteFilePath()).filePath(KA_BUILD_CACHE_CLI_OUTPUT_FILE_NAME));
+
+            if (entryInfo.fileName().endsWith(KA_BUILD_CACHE_TEMP_ENTRY_SUFFIX) || !cliOutputInfo.isFile())
+            {
+                // Left over from an interrupted store.
+                QDir(entryInfo.absoluteFilePath()).removeRecursively();
+            }
+            else
+            {
+                Entry& entry = m_entries[entryInfo.fileName()];
+                entry.m_sizeInBytes = GetDirectorySize(entryInfo.absoluteFilePath());
+                entry.m_lastUseTime = cliOutputInfo.lastModified().toMSecsSinceEpoch();
+                m_sizeInBytes += entry.m_sizeInBytes;
+            }
+        }
+
+        EvictEntries();
+    }
+}
+
+void kaBuildCache::EvictEntries()
+{
+    while (m_sizeInBytes > m_maxSizeInBytes && !m_entries.empty())
+    {
+        auto lruEntryIter = m_entries.begin();
+
+        for (auto entryIter = m_entries.begin(); entryIter != m_entries.end(); ++entryIter)
+        {
+            if (entryIter->second.m_lastUseTime < lruEntryIter->second.m_lastUseTime)
+            {
+                lruEntryIter = entryIter;
+            }
+        }
+
+        QDir(EntryDirectory(lruEntryIter->first)).removeRecursively();
+        m_sizeInBytes -= lruEntryIter->second.m_sizeInBytes;
+        m_entries.erase(lruEntryIter);
+    }
+}
+
+QString kaBuildCache::EntryDirectory(const QString& entryName) const
+{
+    return QDir(m_cacheDirectory).filePath(entryName);
+}
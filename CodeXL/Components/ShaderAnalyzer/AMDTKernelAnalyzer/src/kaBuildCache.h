@@ -0,0 +1,109 @@
+//------------------------------ kaBuildCache.h ------------------------------
+
+#ifndef __KABUILDCACHE_H
+#define __KABUILDCACHE_H
+
+// C++:
+#include <map>
+#include <string>
+
+// Qt:
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+// ----------------------------------------------------------------------------------
+// Class Name:              kaBuildCache
+// General Description:     A persistent, content addressed cache of device build outputs.
+//                          Each entry holds the output files (ISA, IL, statistics, analysis, binary) and the CLI output
+//                          of a single device build, and is keyed by a hash of everything the build depends on: the source
+//                          and the files it includes, the build options, the device and the CLI version.
+//                          The cache size is bounded, and the least recently used entries are evicted first.
+//                          The cache is used by the device build worker threads, so all its public functions are thread safe.
+// ----------------------------------------------------------------------------------
+class kaBuildCache
+{
+public:
+    /// The statistics of the cache since the last call to ResetStatistics
+    struct Statistics
+    {
+        unsigned int m_hits = 0;        ///< the number of builds restored from the cache
+        unsigned int m_misses = 0;      ///< the number of builds that were not in the cache
+        qint64 m_sizeInBytes = 0;       ///< the total size of the cache entries
+        unsigned int m_entriesCount = 0; ///< the number of cache entries
+    };
+
+    /// Constructor
+    /// \param[in] cacheDirectory the directory that holds the cache entries
+    explicit kaBuildCache(const QString& cacheDirectory);
+
+    /// Sets the maximal total size of the cache entries. Entries are evicted when the cache grows beyond it
+    /// \param[in] maxSizeInBytes the maximal size, 0 disables the cache
+    void SetMaxSizeInBytes(qint64 maxSizeInBytes);
+
+    /// Computes the cache key of a device build
+    /// \param[in] sourceFilePath the full path of the built source file
+    /// \param[in] buildOptions   the compiler build options
+    /// \param[in] device         the device name
+    /// \param[in] backendVersion identifies the version of the CLI that builds the source
+    /// \return the key, or an empty key if the source file could not be read
+    static QByteArray ComputeKey(const QString& sourceFilePath, const std::string& buildOptions, const std::string& device, const std::string& backendVersion);
+
+    /// Restores the output files of a cached build into the output directory
+    /// \param[in]  key             the build key
+    /// \param[in]  outputDirectory the build output directory
+    /// \param[out] cliOutput       the CLI output of the cached build
+    /// \return true iff the build was found in the cache and all its files were restored
+    bool Restore(const QByteArray& key, const QString& outputDirectory, std::string& cliOutput);
+
+    /// Stores the output files of a successful build. Least recently used entries are evicted if the cache becomes too large
+    /// \param[in] key         the build key
+    /// \param[in] outputFiles the full paths of the build output files
+    /// \param[in] cliOutput   the CLI output of the build
+    /// \return true iff the entry was stored
+    bool Store(const QByteArray& key, const QStringList& outputFiles, const std::string& cliOutput);
+
+    /// Lists the output files of a device build, which were written since the build started
+    /// \param[in]  outputDirectory the build output directory
+    /// \param[in]  device          the device name
+    /// \param[in]  sourceFileName  the source file name, which ends all the output file names of the source
+    /// \param[in]  buildStartTime  the build start time (milliseconds since epoch)
+    /// \param[out] outputFiles     the full paths of the output files
+    static void GetDeviceOutputFiles(const QString& outputDirectory, const std::string& device, const QString& sourceFileName, qint64 buildStartTime, QStringList& outputFiles);
+
+    /// Gets the cache statistics
+    Statistics GetStatistics();
+
+    /// Resets the hits and misses counters
+    void ResetStatistics();
+
+private:
+    /// A cache entry
+    struct Entry
+    {
+        qint64 m_sizeInBytes = 0;   ///< the total size of the entry files
+        qint64 m_lastUseTime = 0;   ///< the time the entry was last stored or restored (milliseconds since epoch)
+    };
+
+    /// Loads the entries index from the cache directory, if it was not loaded yet. Must be called with m_mutex locked
+    void LoadIndex();
+
+    /// Evicts the least recently used entries until the cache size is within bounds. Must be called with m_mutex locked
+    void EvictEntries();
+
+    /// Gets the directory of a cache entry
+    QString EntryDirectory(const QString& entryName) const;
+
+    QString m_cacheDirectory;               ///< the directory that holds the cache entries
+    qint64 m_maxSizeInBytes;                ///< the maximal total size of the cache entries
+
+    QMutex m_mutex;                         ///< protects the members below
+    bool m_isIndexLoaded;                   ///< true iff m_entries was loaded from the cache directory
+    std::map<QString, Entry> m_entries;     ///< the cache entries, by their hexadecimal key
+    qint64 m_sizeInBytes;                   ///< the total size of the cache entries
+    unsigned int m_hits;                    ///< the number of builds restored from the cache
+    unsigned int m_misses;                  ///< the number of builds that were not in the cache
+};
+
+#endif // __KABUILDCACHE_H
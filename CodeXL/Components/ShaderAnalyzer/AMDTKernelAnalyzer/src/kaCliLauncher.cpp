@@ -1,11 +1,17 @@
 //------------------------------ kaCliLauncher.cpp ------------------------------
 
 // C++.
+#include <algorithm>
+#include <atomic>
 #include <string>
 #include <set>
 #include <sstream>
 #include <stdint.h>
 
+// Qt.
+#include <QDateTime>
+#include <QFileInfo>
+
 // Infra.
 #include <AMDTOSWrappers/Include/osThread.h>
 #include <AMDTOSWrappers/Include/osFilePath.h>
@@ -232,14 +238,8 @@ static std::string GetCliExecutableName(const AnalyzerBuildArchitecture& bitness
     const gtString OS_PATH_SEPRATOR(osFilePath::osPathSeparator);
     bool areWrappingQuotesRequired = false;
 
-    // Get the binary directory.
-    static gtString s_cxlBinDir;
-
-    if (s_cxlBinDir.isEmpty())
-    {
-        osFilePath cxlBinPath(osFilePath::OS_CODEXL_BINARIES_PATH);
-        s_cxlBinDir = cxlBinPath.fileDirectoryAsString();
-    }
+    // Get the binary directory (device builds run in parallel, so it is initialized exactly once).
+    static const gtString s_cxlBinDir = osFilePath(osFilePath::OS_CODEXL_BINARIES_PATH).fileDirectoryAsString();
 
     // If the path contains space characters then wrapping quote characters are required at the beginning and the end of the complete Cli executable path
     if (s_cxlBinDir.find(L' ') != -1)
@@ -424,24 +424,24 @@ static std::string GenerateCLICommandForMultipleDevices(AnalyzerBuildArchitectur
 }
 
 
-static bool ExecAndGrabOutput(const char* cmd, const bool& shouldBeCancelled, std::string& cmdOutput)
+// osExecAndGrabOutput polls a bool cancel flag while the CLI runs, and kills the CLI once it is set.
+// The build cancel flag is set from the UI thread, so it is an atomic which is passed to the OS wrapper as its value storage:
+static_assert(sizeof(std::atomic<bool>) == sizeof(bool) && ATOMIC_BOOL_LOCK_FREE == 2, "std::atomic<bool> must be a lock-free bool");
+
+static bool ExecAndGrabOutput(const char* cmd, const std::atomic<bool>& shouldBeCancelled, std::string& cmdOutput)
 {
     bool ret = true;
     bool isBuildCancelled = false;
-    static bool isFirstCall = true;
-    if (!isFirstCall)
+    static std::atomic<bool> isFirstCall(true);
+    if (!isFirstCall.exchange(false))
     {
         isBuildCancelled = kaBackendManager::instance().IsBuildCancelled();
     }
-    else
-    {
-        isFirstCall = false;
-    }
 
     if (!isBuildCancelled)
     {
         gtString cmdOutputAsGtStr;
-        ret = osExecAndGrabOutput(cmd, shouldBeCancelled, cmdOutputAsGtStr);
+        ret = osExecAndGrabOutput(cmd, reinterpret_cast<const bool&>(shouldBeCancelled), cmdOutputAsGtStr);
 
         if (ret && !cmdOutputAsGtStr.isEmpty())
         {
@@ -457,7 +457,7 @@ static bool ExecAndGrabOutput(const char* cmd, const bool& shouldBeCancelled, st
 bool LaunchOpenGLSession(AnalyzerBuildArchitecture bitness, const std::string& shaderType,
                          const std::string& baseISAFilename, const std::string& baseILFilename,
                          const std::string& baseAnalysFilename, const std::set<std::string>& SelectedDevices,
-                         const std::string& sourceCodeFullPathName, const bool& shouldBeCancelled, std::string& cliOutput)
+                         const std::string& sourceCodeFullPathName, const std::atomic<bool>& shouldBeCancelled, std::string& cliOutput)
 {
     bool retVal = false;
     std::string GLShaderOptions = GenerateGLShaderOptions(shaderType);
@@ -477,7 +477,7 @@ bool LaunchOpenGLSession(AnalyzerBuildArchitecture bitness, const std::string& s
 bool LaunchOpenGLSessionForDevice(AnalyzerBuildArchitecture bitness, const std::string& shaderType,
                                   const std::string& baseISAFilename, const std::string& baseILFilename,
                                   const std::string& baseAnalysFilename, const std::string& SelectedDevice,
-                                  const std::string& sourceCodeFullPathName, const bool& shouldBeCancelled, std::string& cliOutput)
+                                  const std::string& sourceCodeFullPathName, const std::atomic<bool>& shouldBeCancelled, std::string& cliOutput)
 {
     bool retVal = false;
     std::string GLShaderOptions = GenerateGLShaderOptions(shaderType);
@@ -590,7 +590,7 @@ bool LaunchDXSessionForDevice(AnalyzerBuildArchitecture& bitness,
                               const std::string& selectedDevice,
                               const std::string& sourceCodeFullPathName,
                               bool isIntrinsicsEnabled,
-                              const bool& shouldBeCanceled,
+                              const std::atomic<bool>& shouldBeCanceled,
                               std::string& cliOutput)
 {
     GT_UNREFERENCED_PARAMETER(baseILFilename);
@@ -724,7 +724,7 @@ bool LaunchOpenCLSession(AnalyzerBuildArchitecture bitness,
                          const std::string& baseAnalysFilename,
                          const std::string& binaryFilename,
                          const std::set<std::string>& SelectedDevices,
-                         const std::string& sourceCodeFullPathName, const bool& shouldBeCancelled,
+                         const std::string& sourceCodeFullPathName, const std::atomic<bool>& shouldBeCancelled,
                          std::string& cliOutput)
 {
     bool retVal = false;
@@ -753,7 +753,7 @@ bool LaunchOpenCLSessionForDevice(AnalyzerBuildArchitecture bitness,
                                   const std::string& Device,
                                   const std::string& sourceCodeFullPathName,
                                   const std::string& buildOptions,
-                                  const bool& shouldBeCancelled,
+                                  const std::atomic<bool>& shouldBeCancelled,
                                   std::string& cliOutput)
 {
     bool retVal = false;
@@ -774,7 +774,7 @@ bool LaunchOpenCLSessionForDevice(AnalyzerBuildArchitecture bitness,
 
 bool LaunchVulkanSession(AnalyzerBuildArchitecture bitness, const kaPipelineShaders& inputShaders, const std::string& baseISAFilename,
                          const std::string& baseILFilename, const std::string& baseAnalysFilename, const std::string& binaryFilename,
-                         const std::set<std::string>& selectedDevices, const bool& shouldCancel, std::string& cliOutput)
+                         const std::set<std::string>& selectedDevices, const std::atomic<bool>& shouldCancel, std::string& cliOutput)
 {
     // TODO: implement this function.
 
@@ -793,7 +793,7 @@ bool LaunchVulkanSession(AnalyzerBuildArchitecture bitness, const kaPipelineShad
 bool LaunchRenderSessionForDevice(const BuildType buildType, AnalyzerBuildArchitecture bitness, const kaPipelineShaders& inputShaders,
                                   const std::string& baseISAFilename, const std::string& baseILFilename,
                                   const std::string& baseStatisticsFilename, const std::string& binaryFilename,
-                                  const std::string& device, const bool& shouldCancel, std::string& cliOutput)
+                                  const std::string& device, const std::atomic<bool>& shouldCancel, std::string& cliOutput)
 {
     bool retVal = false;
 
@@ -814,7 +814,7 @@ bool LaunchRenderSessionForDevice(const BuildType buildType, AnalyzerBuildArchit
 bool GetOpenCLDevices(std::vector<std::string>& devices)
 {
     bool ret = false;
-    bool shouldCancel = false;
+    std::atomic<bool> shouldCancel(false);
     devices.clear();
     std::stringstream commandLine;
     commandLine << GetCliExecutableName(AnalyzerBuildArchitecture::kaBuildArch32_bit).c_str();
@@ -836,4 +836,24 @@ bool GetOpenCLDevices(std::vector<std::string>& devices)
     return ret;
 }
 
+std::string GetCliVersionStamp(AnalyzerBuildArchitecture bitness)
+{
+    std::string ret;
+
+    // Remove the wrapping quotes, if the CLI executable path contains spaces.
+    std::string cliExecutablePath = GetCliExecutableName(bitness);
+    cliExecutablePath.erase(std::remove(cliExecutablePath.begin(), cliExecutablePath.end(), '"'), cliExecutablePath.end());
+
+    QFileInfo cliExecutableInfo(QString::fromStdString(cliExecutablePath));
+
+    if (cliExecutableInfo.isFile())
+    {
+        std::stringstream versionStamp;
+        versionStamp << cliExecutablePath << ";" << cliExecutableInfo.size() << ";" << cliExecutableInfo.lastModified().toMSecsSinceEpoch();
+        ret = versionStamp.str();
+    }
+
+    return ret;
+}
+
 
@@ -1,6 +1,7 @@
 
 #ifndef __kaCliLauncher_h
 #define __kaCliLauncher_h
+#include <atomic>
 #include <AMDTBackEnd/Include/beProgramBuilderOpenCL.h>
 #if _WIN32
     #include <AMDTBackEnd/Include//beProgramBuilderDX.h>
@@ -27,7 +28,7 @@ bool LaunchOpenCLSession(AnalyzerBuildArchitecture bitness,
                          const std::string& binaryFilename,
                          const std::set<std::string>& SelectedDevices,
                          const std::string& sourceCodeFullPathName,
-                         const bool& shouldBeCancelled,
+                         const std::atomic<bool>& shouldBeCancelled,
                          std::string& cliOutput);
 //-----------------------------------------------------------------------------
 ////-----------------------------------------------------------------------------
@@ -51,7 +52,7 @@ bool LaunchOpenCLSessionForDevice(AnalyzerBuildArchitecture bitness,
                                   const std::string& Device,
                                   const std::string& sourceCodeFullPathName,
                                   const std::string& buildOptions,
-                                  const bool& shouldBeCancelled,
+                                  const std::atomic<bool>& shouldBeCancelled,
                                   std::string& cliOutput);
 
 //-----------------------------------------------------------------------------
@@ -69,7 +70,7 @@ bool LaunchOpenCLSessionForDevice(AnalyzerBuildArchitecture bitness,
 bool LaunchOpenGLSession(AnalyzerBuildArchitecture bitness, const std::string& shaderType,
                          const std::string& baseISAFilename, const std::string& baseILFilename,
                          const std::string& baseAnalysFilename, const std::set<std::string>& SelectedDevices,
-                         const std::string& sourceCodeFullPathName, const bool& shouldBeCancelled, std::string& cliOutput);
+                         const std::string& sourceCodeFullPathName, const std::atomic<bool>& shouldBeCancelled, std::string& cliOutput);
 
 ////-----------------------------------------------------------------------------
 ///// \brief Name: LaunchOpenGLSessionForDevice
@@ -90,7 +91,7 @@ bool LaunchOpenGLSessionForDevice(AnalyzerBuildArchitecture bitness,
                                   const std::string& baseAnalysFilename,
                                   const std::string& SelectedDevice,
                                   const std::string& sourceCodeFullPathName,
-                                  const bool& shouldBeCanceled,
+                                  const std::atomic<bool>& shouldBeCanceled,
                                   std::string& cliOutput);
 
 //-----------------------------------------------------------------------------
@@ -114,7 +115,7 @@ bool LaunchVulkanSession(AnalyzerBuildArchitecture bitness,
                          const std::string& baseAnalysFilename,
                          const std::string& binaryFilename,
                          const std::set<std::string>& selectedDevices,
-                         const bool& shouldBeCancelled,
+                         const std::atomic<bool>& shouldBeCancelled,
                          std::string& cliOutput);
 
 //-----------------------------------------------------------------------------
@@ -138,7 +139,7 @@ bool LaunchRenderSessionForDevice(const BuildType buildType,
                                   const std::string& baseStatisticsFilename,
                                   const std::string& binaryFilename,
                                   const std::string& device,
-                                  const bool& shouldCancel,
+                                  const std::atomic<bool>& shouldCancel,
                                   std::string& cliOutput);
 
 
@@ -149,6 +150,15 @@ bool LaunchRenderSessionForDevice(const BuildType buildType,
 ///
 bool GetOpenCLDevices(std::vector<std::string>& devices);
 
+///-----------------------------------------------------------------------------
+/// \brief Name: GetCliVersionStamp
+/// \brief Description: Gets a string that changes whenever the CLI executable is replaced,
+///                     made of the executable path, size and modification time.
+/// \param[in] bitness   ba32-bit or ba64-bit Build Architecture
+/// \return the version stamp, or an empty string if the CLI executable was not found.
+///
+std::string GetCliVersionStamp(AnalyzerBuildArchitecture bitness);
+
 #if _WIN32
 struct DXAdditionalBuildOptions;
 
@@ -181,7 +191,7 @@ bool LaunchDXSessionForDevice(AnalyzerBuildArchitecture& bitness,
                               const std::string& selectedDevice,
                               const std::string& sourceCodeFullPathName,
                               bool isIntrinsicsEnabled,
-                              const bool& shouldBeCanceled,
+                              const std::atomic<bool>& shouldBeCanceled,
                               std::string& cliOutput);
 
 
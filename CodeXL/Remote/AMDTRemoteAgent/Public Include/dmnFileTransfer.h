@@ -0,0 +1,527 @@
+//==================================================================================
+// Copyright (c) 2016 , Advanced Micro Devices, Inc.  All rights reserved.
+//
+/// \author AMD Developer Tools Team
+/// \file dmnFileTransfer.h
+///
+//==================================================================================
+
+#ifndef __dmnFileTransfer_h
+#define __dmnFileTransfer_h
+
+// C++.
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <new>
+#include <sstream>
+
+// Infra.
+#include <AMDTBaseTools/Include/gtAssert.h>
+#include <AMDTBaseTools/Include/gtVector.h>
+#include <AMDTOSWrappers/Include/osChannel.h>
+#include <AMDTOSWrappers/Include/osFile.h>
+#include <AMDTOSWrappers/Include/osFilePath.h>
+#include <AMDTOSWrappers/Include/osDebugLog.h>
+
+// Local.
+#include <AMDTRemoteAgent/Public Include/dmnDefinitions.h>
+
+// Required by zlib to link properly.
+#if AMDT_BUILD_TARGET == AMDT_WINDOWS_OS
+    #ifndef ZLIB_WINAPI
+        #define ZLIB_WINAPI
+    #endif
+#endif
+
+#include <zlib.h>
+
+// *****************
+// CONSTANTS - BEGIN
+// *****************
+
+// The maximal amount of file data carried by a single transfer chunk.
+const gtUInt32 DMN_FILE_TRANSFER_CHUNK_SIZE = 1024 * 1024;
+
+// Suffixes of the files that hold a partially received file, and the identity of the file being received.
+const gtString DMN_PARTIAL_FILE_SUFFIX = L".part";
+const gtString DMN_PARTIAL_FILE_INFO_SUFFIX = L".partinfo";
+
+// ***************
+// CONSTANTS - END
+// ***************
+
+// Transfers files between the remote agent and the remote client, in both directions.
+//
+// The file is streamed in chunks of up to DMN_FILE_TRANSFER_CHUNK_SIZE bytes, so neither side
+// holds more than a couple of chunks in memory. Each chunk is deflated on its own (and sent
+// as-is when deflating does not make it smaller), and carries the adler32 checksum of its data.
+//
+// Protocol (S - sender, R - receiver):
+//  S -> R: gtInt32 status - dosSuccess iff the file was opened. Nothing else is sent on failure.
+//  S -> R: gtUInt64 file size, gtUInt64 file modification time.
+//  R -> S: gtUInt64 requested offset - the amount of data R already has from a previous transfer.
+//  S -> R: gtUInt64 offset - the requested offset if S can resume from it, 0 otherwise.
+//  S -> R: chunks: gtUInt32 data size, gtUInt32 payload size, gtUInt32 checksum, payload.
+//          The payload is deflated iff its size is smaller than the data size. A chunk with no data ends the file.
+//  S -> R: gtInt32 status - dosSuccess iff the whole file was read.
+//  R -> S: gtInt32 status - dosSuccess iff the whole file was received.
+//
+// A receiver writing to disk keeps the verified data of a failed transfer, so that transferring
+// the same file again (e.g. after a dropped connection) resumes from where the failed transfer stopped.
+class dmnFileTransfer
+{
+public:
+    // Sends a file over the channel. Must be matched by ReceiveFile or ReceiveFileData on the other side.
+    // isBinary - false iff the file should be read in text mode. Text files are always sent from their beginning.
+    static bool SendFile(osChannel& channel, const osFilePath& filePath, bool isCompressionRequired = true, bool isBinary = true)
+    {
+        bool ret = false;
+
+        // Open the file at its end, to get its size.
+        std::ifstream file(FileName(filePath), (isBinary ? (std::ios::binary | std::ios::ate) : std::ios::ate));
+        bool isFileOpen = file.is_open();
+
+        gtInt32 openStatus = isFileOpen ? dosSuccess : dosFailure;
+        channel << openStatus;
+
+        GT_IF_WITH_ASSERT(isFileOpen)
+        {
+            gtUInt64 fileSize = static_cast<gtUInt64>(file.tellg());
+            gtUInt64 modificationTime = 0;
+            GetModificationTime(filePath, modificationTime);
+            channel << fileSize;
+            channel << modificationTime;
+
+            // Resume from the offset the receiver asked for, if we can.
+            gtUInt64 offset = 0;
+            channel >> offset;
+
+            if (!isBinary || (offset > fileSize))
+            {
+                offset = 0;
+            }
+
+            channel << offset;
+            file.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+
+            // Deflate each chunk on its own, so that every chunk can be verified and inflated on its own.
+            z_stream deflateStream = {};
+            bool isDeflateInitialized = isCompressionRequired && (deflateInit(&deflateStream, Z_DEFAULT_COMPRESSION) == Z_OK);
+            GT_ASSERT_EX(isDeflateInitialized || !isCompressionRequired, L"DMN: Failed to initialize file transfer compression.");
+
+            gtVector<gtByte> dataBuffer(DMN_FILE_TRANSFER_CHUNK_SIZE);
+            gtVector<gtByte> payloadBuffer(isDeflateInitialized ? compressBound(DMN_FILE_TRANSFER_CHUNK_SIZE) : 0);
+
+            bool isReadOk = true;
+            bool isWriteOk = true;
+
+            while (isReadOk && isWriteOk && !file.eof())
+            {
+                file.read(&dataBuffer[0], DMN_FILE_TRANSFER_CHUNK_SIZE);
+                gtUInt32 dataSize = static_cast<gtUInt32>(file.gcount());
+                isReadOk = !file.bad();
+
+                if (isReadOk && (0 < dataSize))
+                {
+                    const gtByte* pPayload = &dataBuffer[0];
+                    gtUInt32 payloadSize = dataSize;
+
+                    if (isDeflateInitialized)
+                    {
+                        deflateReset(&deflateStream);
+                        deflateStream.next_in = reinterpret_cast<Bytef*>(&dataBuffer[0]);
+                        deflateStream.avail_in = dataSize;
+                        deflateStream.next_out = reinterpret_cast<Bytef*>(&payloadBuffer[0]);
+                        deflateStream.avail_out = static_cast<uInt>(payloadBuffer.size());
+
+                        if ((deflate(&deflateStream, Z_FINISH) == Z_STREAM_END) && (deflateStream.total_out < dataSize))
+                        {
+                            pPayload = &payloadBuffer[0];
+                            payloadSize = static_cast<gtUInt32>(deflateStream.total_out);
+                        }
+                    }
+
+                    gtUInt32 checksum = static_cast<gtUInt32>(adler32(adler32(0L, Z_NULL, 0), reinterpret_cast<const Bytef*>(&dataBuffer[0]), dataSize));
+                    channel << dataSize;
+                    channel << payloadSize;
+                    channel << checksum;
+                    isWriteOk = channel.write(pPayload, payloadSize);
+                }
+            }
+
+            if (isDeflateInitialized)
+            {
+                deflateEnd(&deflateStream);
+            }
+
+            GT_IF_WITH_ASSERT(isWriteOk)
+            {
+                // End the file, and report whether all of it was read.
+                gtUInt32 endOfFileMarker = 0;
+                channel << endOfFileMarker;
+                channel << endOfFileMarker;
+                channel << endOfFileMarker;
+
+                gtInt32 sendStatus = isReadOk ? dosSuccess : dosFailure;
+                channel << sendStatus;
+
+                gtInt32 receiveStatus = dosFailure;
+                channel >> receiveStatus;
+                ret = isReadOk && (receiveStatus == dosSuccess);
+            }
+        }
+
+        return ret;
+    }
+
+    // Receives a file sent by SendFile and writes it to disk. If a previous transfer of the same file
+    // into the same target failed, the transfer resumes after the data that was already received.
+    static bool ReceiveFile(osChannel& channel, const osFilePath& targetFilePath)
+    {
+        bool ret = false;
+
+        gtInt32 openStatus = dosFailure;
+        channel >> openStatus;
+
+        if (openStatus == dosSuccess)
+        {
+            gtUInt64 fileSize = 0;
+            gtUInt64 modificationTime = 0;
+            channel >> fileSize;
+            channel >> modificationTime;
+
+            gtString partialFilePathStr = targetFilePath.asString();
+            partialFilePathStr.append(DMN_PARTIAL_FILE_SUFFIX);
+            osFilePath partialFilePath(partialFilePathStr);
+
+            gtString partialFileInfoPathStr = targetFilePath.asString();
+            partialFileInfoPathStr.append(DMN_PARTIAL_FILE_INFO_SUFFIX);
+            osFilePath partialFileInfoPath(partialFileInfoPathStr);
+
+            // Resume only if the partial file was received from the same version of the file.
+            gtUInt64 requestedOffset = 0;
+            gtUInt64 partialFileSize = 0;
+            gtUInt64 partialFileModificationTime = 0;
+            std::ifstream partialFileInfo(FileName(partialFileInfoPath));
+
+            if ((partialFileInfo >> partialFileSize >> partialFileModificationTime) &&
+                (partialFileSize == fileSize) && (partialFileModificationTime == modificationTime))
+            {
+                std::ifstream partialFile(FileName(partialFilePath), std::ios::binary | std::ios::ate);
+
+                if (partialFile.is_open())
+                {
+                    requestedOffset = static_cast<gtUInt64>(partialFile.tellg());
+                }
+            }
+
+            partialFileInfo.close();
+
+            channel << requestedOffset;
+
+            gtUInt64 offset = 0;
+            channel >> offset;
+
+            bool isResumed = (offset == requestedOffset) && (0 < offset);
+
+            if (!isResumed)
+            {
+                // Record the identity of the file we start receiving.
+                std::ofstream newPartialFileInfo(FileName(partialFileInfoPath), std::ios::trunc);
+                newPartialFileInfo << fileSize << " " << modificationTime << std::endl;
+            }
+            else
+            {
+                std::wstringstream msgStream;
+                msgStream << L"DMN: Resuming a file transfer at offset " << offset << L": " << targetFilePath.asString().asCharArray();
+                OS_OUTPUT_DEBUG_LOG(msgStream.str().c_str(), OS_DEBUG_LOG_INFO);
+            }
+
+            std::ofstream partialFile(FileName(partialFilePath), std::ios::binary | (isResumed ? std::ios::app : std::ios::trunc));
+            bool isWriteOk = partialFile.is_open();
+            GT_ASSERT_EX(isWriteOk, L"DMN: Failed to create the file for a received file.");
+
+            bool isReceived = ReceiveChunks(channel, [&](const gtByte* pData, gtUInt32 dataSize) -> bool
+            {
+                if (isWriteOk)
+                {
+                    // Flush each chunk, so that a failed transfer keeps all the verified data.
+                    partialFile.write(pData, dataSize);
+                    partialFile.flush();
+                    isWriteOk = !partialFile.fail();
+                }
+
+                return isWriteOk;
+            });
+
+            partialFile.close();
+
+            if (isReceived && isWriteOk)
+            {
+                // Replace the target file with the received file.
+                if (targetFilePath.exists())
+                {
+                    osFile targetFile(targetFilePath);
+                    targetFile.deleteFile();
+                }
+
+                ret = partialFilePath.Rename(targetFilePath.asString());
+                GT_ASSERT_EX(ret, L"DMN: Failed to rename a received file.");
+
+                osFile partialFileInfoFile(partialFileInfoPath);
+                partialFileInfoFile.deleteFile();
+            }
+
+            if (isReceived)
+            {
+                gtInt32 receiveStatus = ret ? dosSuccess : dosFailure;
+                channel << receiveStatus;
+            }
+        }
+
+        return ret;
+    }
+
+    // Receives a file sent by SendFile into memory.
+    static bool ReceiveFileData(osChannel& channel, gtVector<gtByte>& data)
+    {
+        data.clear();
+
+        bool ret = ReceiveFileIntoMemory(channel, [&](gtUInt64 fileSize) -> bool
+        {
+            data.reserve(static_cast<size_t>(fileSize));
+            return true;
+        },
+        [&](const gtByte* pData, gtUInt32 dataSize) -> bool
+        {
+            data.insert(data.end(), pData, pData + dataSize);
+            return true;
+        });
+
+        if (!ret)
+        {
+            data.clear();
+        }
+
+        return ret;
+    }
+
+    // Receives a file sent by SendFile into a buffer allocated with new[], which is then owned by the caller.
+    // Used for data which is kept in a raw buffer (e.g. frame images), so that it is not copied after it is received.
+    static bool ReceiveFileData(osChannel& channel, unsigned char*& pBuffer, unsigned long& bufferSize)
+    {
+        pBuffer = nullptr;
+        bufferSize = 0;
+        gtUInt64 bufferCapacity = 0;
+
+        bool ret = ReceiveFileIntoMemory(channel, [&](gtUInt64 fileSize) -> bool
+        {
+            // Text files may shrink when they are read, so the file size is the most data we can receive.
+            bool isSizeValid = (fileSize <= static_cast<gtUInt64>(std::numeric_limits<size_t>::max()));
+
+            if (isSizeValid)
+            {
+                pBuffer = new (std::nothrow) unsigned char[static_cast<size_t>(fileSize)];
+                bufferCapacity = fileSize;
+            }
+
+            return (pBuffer != nullptr);
+        },
+        [&](const gtByte* pData, gtUInt32 dataSize) -> bool
+        {
+            bool isInBuffer = (dataSize <= bufferCapacity - bufferSize);
+
+            if (isInBuffer)
+            {
+                memcpy(pBuffer + bufferSize, pData, dataSize);
+                bufferSize += dataSize;
+            }
+
+            return isInBuffer;
+        });
+
+        if (!ret)
+        {
+            delete[] pBuffer;
+            pBuffer = nullptr;
+            bufferSize = 0;
+        }
+
+        return ret;
+    }
+
+private:
+    // Receives a file sent by SendFile from its beginning. The receiver is told the file size before the data is passed to the consumer.
+    static bool ReceiveFileIntoMemory(osChannel& channel, const std::function<bool(gtUInt64)>& prepareForFile,
+                                      const std::function<bool(const gtByte*, gtUInt32)>& consumeData)
+    {
+        bool ret = false;
+
+        gtInt32 openStatus = dosFailure;
+        channel >> openStatus;
+
+        if (openStatus == dosSuccess)
+        {
+            gtUInt64 fileSize = 0;
+            gtUInt64 modificationTime = 0;
+            channel >> fileSize;
+            channel >> modificationTime;
+
+            // Always receive the whole file.
+            gtUInt64 offset = 0;
+            channel << offset;
+            channel >> offset;
+
+            bool isOffsetValid = (offset == 0);
+            GT_ASSERT(isOffsetValid);
+
+            bool isPrepared = isOffsetValid && prepareForFile(fileSize);
+            GT_ASSERT_EX(isPrepared || !isOffsetValid, L"DMN: Failed to allocate the memory for a received file.");
+
+            bool isReceived = ReceiveChunks(channel, [&](const gtByte* pData, gtUInt32 dataSize) -> bool
+            {
+                return isPrepared && consumeData(pData, dataSize);
+            });
+
+            if (isReceived)
+            {
+                ret = isPrepared;
+                gtInt32 receiveStatus = ret ? dosSuccess : dosFailure;
+                channel << receiveStatus;
+            }
+        }
+
+        return ret;
+    }
+
+    // Receives the file chunks and the sender status, and passes the verified data of each chunk to the consumer.
+    // Once a chunk cannot be verified or consumed, the remaining chunks are still read (to keep the channel in sync)
+    // but are not consumed. Returns true iff all the chunks were verified and consumed and the sender read the whole file,
+    // in which case the caller sends the final status. Otherwise, the final failure status is sent here, unless the channel is out of sync.
+    static bool ReceiveChunks(osChannel& channel, const std::function<bool(const gtByte*, gtUInt32)>& consumeData)
+    {
+        bool isInSync = true;
+        bool isDataOk = true;
+
+        z_stream inflateStream = {};
+        bool isInflateInitialized = (inflateInit(&inflateStream) == Z_OK);
+        GT_ASSERT_EX(isInflateInitialized, L"DMN: Failed to initialize file transfer decompression.");
+
+        gtVector<gtByte> payloadBuffer(DMN_FILE_TRANSFER_CHUNK_SIZE);
+        gtVector<gtByte> dataBuffer(DMN_FILE_TRANSFER_CHUNK_SIZE);
+
+        bool isEndOfFile = false;
+
+        while (isInSync && !isEndOfFile)
+        {
+            gtUInt32 dataSize = 0;
+            gtUInt32 payloadSize = 0;
+            gtUInt32 checksum = 0;
+            channel >> dataSize;
+            channel >> payloadSize;
+            channel >> checksum;
+
+            isEndOfFile = (dataSize == 0);
+
+            if (!isEndOfFile)
+            {
+                // A compressed payload is always smaller than its data.
+                isInSync = (dataSize <= DMN_FILE_TRANSFER_CHUNK_SIZE) && (payloadSize <= dataSize) && (0 < payloadSize);
+                GT_ASSERT_EX(isInSync, L"DMN: Received an invalid file transfer chunk.");
+
+                if (isInSync)
+                {
+                    isInSync = channel.read(&payloadBuffer[0], payloadSize);
+                    GT_ASSERT_EX(isInSync, L"DMN: Failed to receive a file transfer chunk.");
+                }
+
+                if (isInSync && isDataOk)
+                {
+                    const gtByte* pData = &payloadBuffer[0];
+
+                    if (payloadSize < dataSize)
+                    {
+                        isDataOk = isInflateInitialized;
+
+                        if (isDataOk)
+                        {
+                            inflateReset(&inflateStream);
+                            inflateStream.next_in = reinterpret_cast<Bytef*>(&payloadBuffer[0]);
+                            inflateStream.avail_in = payloadSize;
+                            inflateStream.next_out = reinterpret_cast<Bytef*>(&dataBuffer[0]);
+                            inflateStream.avail_out = dataSize;
+                            isDataOk = (inflate(&inflateStream, Z_FINISH) == Z_STREAM_END) && (inflateStream.total_out == dataSize);
+                            pData = &dataBuffer[0];
+                        }
+                    }
+
+                    if (isDataOk)
+                    {
+                        gtUInt32 dataChecksum = static_cast<gtUInt32>(adler32(adler32(0L, Z_NULL, 0), reinterpret_cast<const Bytef*>(pData), dataSize));
+                        isDataOk = (dataChecksum == checksum);
+                    }
+
+                    GT_ASSERT_EX(isDataOk, L"DMN: A received file transfer chunk is corrupted.");
+
+                    if (isDataOk)
+                    {
+                        isDataOk = consumeData(pData, dataSize);
+                    }
+                }
+            }
+        }
+
+        if (isInflateInitialized)
+        {
+            inflateEnd(&inflateStream);
+        }
+
+        bool ret = false;
+
+        if (isInSync)
+        {
+            gtInt32 sendStatus = dosFailure;
+            channel >> sendStatus;
+            ret = isDataOk && (sendStatus == dosSuccess);
+
+            if (!ret)
+            {
+                // The final status must still be sent, so report the failure.
+                gtInt32 receiveStatus = dosFailure;
+                channel << receiveStatus;
+            }
+        }
+
+        return ret;
+    }
+
+#if AMDT_BUILD_TARGET == AMDT_WINDOWS_OS
+    // On Windows we have unicode file names.
+    static const wchar_t* FileName(const osFilePath& filePath)
+    {
+        return filePath.asString().asCharArray();
+    }
+#else
+    static const char* FileName(const osFilePath& filePath)
+    {
+        return filePath.asString().asASCIICharArray();
+    }
+#endif
+
+    static bool GetModificationTime(const osFilePath& filePath, gtUInt64& modificationTime)
+    {
+        osStatStructure fileInfo;
+        bool ret = (0 == osWStat(filePath.asString(), fileInfo));
+
+        if (ret)
+        {
+            modificationTime = static_cast<gtUInt64>(fileInfo.st_mtime);
+        }
+
+        return ret;
+    }
+};
+
+#endif // __dmnFileTransfer_h
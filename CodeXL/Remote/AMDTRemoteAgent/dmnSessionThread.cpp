@@ -27,13 +27,6 @@
 #include <AMDTOSWrappers/Include/osStringConstants.h>
 #include <AMDTOSAPIWrappers/Include/oaDriver.h>
 
-#if AMDT_BUILD_TARGET == AMDT_WINDOWS_OS
-    #define ZLIB_WINAPI
-#endif
-
-// For file compression proxy.
-#include <zlib.h>
-
 
 // C++.
 #include <sstream>
@@ -44,6 +37,7 @@
 #include <AMDTRemoteAgent/dmnSessionThread.h>
 #include <AMDTRemoteAgent/dmnConnectionWatcherThread.h>
 #include <AMDTRemoteAgent/Public Include/dmnStringConstants.h>
+#include <AMDTRemoteAgent/Public Include/dmnFileTransfer.h>
 #include <AMDTRemoteClient/Include/RemoteClientDataTypes.h>
 
 // CodeXL Infrastructure.
@@ -59,7 +53,6 @@
 #include <AMDTOSWrappers/Include/osProductVersion.h>
 #include <AMDTOSWrappers/Include/osModule.h>
 #include <AMDTOSWrappers/Include/osTCPSocket.h>
-#include <AMDTOSWrappers/Include/osRawMemoryBuffer.h>
 #include <AMDTOSWrappers/Include/osDebugLog.h>
 #include <AMDTOSWrappers/Include/osFile.h>
 #include <AMDTOSWrappers/Include/osTime.h>
@@ -69,7 +62,6 @@
 const unsigned int OPCODE_BUFFER_SIZE = sizeof(gtInt32);
 const int LOOP_SLEEP_INTERVAL_MS = 100;
 const int FS_REFRESH_INTERVAL_MS = 1000;
-const gtString COMPRESSED_FILE_SUFFIX = L"_zipped";
 
 #define GRAPHIC_SERVER_SHUTDOWN_MAX_WAIT_MS 5000
 
@@ -158,124 +150,6 @@ static bool FillPathBuffers(REMOTE_OPERATION_MODE mode, bool is64BitTarget, osFi
 
 
 
-static bool CompressFile(const osFilePath& fileToCompress, osFilePath& compressedFileBuffer)
-{
-    osFilePath compressedFilePath = fileToCompress;
-    gtString compressedFileName;
-    bool ret = fileToCompress.getFileName(compressedFileName);
-    GT_IF_WITH_ASSERT(ret)
-    {
-        compressedFileName.append(COMPRESSED_FILE_SUFFIX);
-        compressedFilePath.setFileName(compressedFileName);
-
-        // First load the original file.
-        osFile src(fileToCompress);
-        ret = src.open(osChannel::OS_BINARY_CHANNEL);
-        GT_ASSERT_EX(ret, L"DMN: Failed to open the file to compress.");
-
-        if (ret)
-        {
-            unsigned long fileSize = 0;
-            ret = src.getSize(fileSize);
-            GT_ASSERT_EX(ret, L"DMN: Failed to the size of the file to compress.");
-
-            if (ret)
-            {
-                gtByte* buffer = new(std::nothrow) gtByte[fileSize]();
-
-                gtSize_t amountRead = 0;
-                ret = src.readAvailableData(buffer, fileSize, amountRead);
-                GT_ASSERT_EX(ret, L"DMN: Unable to read the data of the file to compress.");
-                src.close();
-
-                if (ret)
-                {
-                    // Now compress it.
-                    unsigned long sizeDataCompressed  = amountRead + (amountRead / 10) + 12;
-                    gtByte* dstBuffer = new(std::nothrow) gtByte[sizeDataCompressed]();
-
-                    int res = compress((unsigned char*)dstBuffer, &sizeDataCompressed, (unsigned char*)buffer, amountRead);
-                    ret = (res == Z_OK);
-                    GT_ASSERT_EX(ret, L"DMN: Failed to compress file on compression proxy.");
-
-                    if (ret)
-                    {
-                        // Now let's save the compressed file.
-                        osFile compressedFile;
-                        compressedFile.open(compressedFilePath, osChannel::OS_BINARY_CHANNEL, osFile::OS_OPEN_TO_WRITE);
-                        compressedFile.write(dstBuffer, sizeDataCompressed);
-                        compressedFile.close();
-
-                        // Assign the buffer, since we succeeded.
-                        compressedFileBuffer = compressedFilePath;
-                    }
-
-                    // Clean.
-                    delete[] dstBuffer;
-                    delete[] buffer;
-                }
-            }
-        }
-    }
-    return ret;
-}
-
-
-
-static bool TransferFile(const osFilePath& filePath, osChannel* channel, bool isCompressionRequired = true)
-{
-    bool isOk = true;
-    osFilePath filePathToUse;
-
-    if (isCompressionRequired)
-    {
-        // Save the original file size.
-        // In case compression is required, we need to send it to the remote client.
-        // This represents the upper bound of the size of the decompressed file (after decompression).
-        unsigned long originalFileSize = 0;
-        osFile fileToSend(filePath);
-        isOk = fileToSend.getSize(originalFileSize) && (originalFileSize > 0);
-        GT_ASSERT_EX(isOk, L"DMN: Failed to extract the size of the original file.");
-
-        isOk = CompressFile(filePath, filePathToUse);
-        GT_ASSERT_EX(isOk, L"DMN: Failed to compress flie on file transfer.");
-
-        // First send the original size.
-        gtInt32 fileSizeToSend = static_cast<gtInt32>(originalFileSize);
-        (*channel) << fileSizeToSend;
-
-        // Verify.
-        gtInt32 opStatus = dosFailure;
-        (*channel) >> opStatus;
-        isOk = (opStatus == dosSuccess);
-        GT_ASSERT_EX(isOk, L"DMN: Failed to receive ack for file size of tranferred file.");
-    }
-    else
-    {
-        filePathToUse = filePath;
-    }
-
-    if (isOk)
-    {
-        osRawMemoryBuffer buffer;
-        isOk = buffer.fromFile(filePathToUse);
-        GT_IF_WITH_ASSERT(isOk && channel != NULL)
-        {
-            isOk = buffer.writeSelfIntoChannel(*channel);
-        }
-    }
-
-    return isOk;
-}
-
-static bool TransferFile(const gtString& fileName, osChannel* channel,  bool isCompressionRequired = true)
-{
-    osFilePath filePath(fileName);
-    return TransferFile(filePath, channel, isCompressionRequired);
-}
-
-
-
 static void ReportSuccess(osChannel* pTargetChannel)
 {
     GT_IF_WITH_ASSERT(pTargetChannel != NULL)
@@ -726,61 +600,54 @@ static bool ReceiveRemoteFile(osChannel* pChannel, osDirectory& localTargetDir)
             gtString fixedExpectedFileName;
             FixTokenizedPathString(expectedFileName, fixedExpectedFileName);
 
+            osFilePath outputFilePath(fixedExpectedFileName);
 
-            // Receive the file.
-            osRawMemoryBuffer tmpBuffer;
-            ret = tmpBuffer.readSelfFromChannel(*pChannel);
+            // Get the directory from the file path.
+            gtString fileNameNoPath;
+            outputFilePath.getFileNameAndExtension(fileNameNoPath);
 
-            // Send ack.
-            ReportResult(ret, pChannel);
+            gtString dirToCreateStr;
 
-            GT_IF_WITH_ASSERT(ret)
-            {
-                osFilePath outputFilePath(fixedExpectedFileName);
+            outputFilePath.clearFileExtension();
+            outputFilePath.clearFileName();
 
-                // Get the directory from the file path.
-                gtString fileNameNoPath;
-                outputFilePath.getFileNameAndExtension(fileNameNoPath);
+            // Set local dir.
+            localTargetDir = outputFilePath;
 
-                gtString dirToCreateStr;
-
-                outputFilePath.clearFileExtension();
-                outputFilePath.clearFileName();
-
-                // Set local dir.
-                localTargetDir = outputFilePath;
+            if (!outputFilePath.exists())
+            {
+                osDirectory dirToCreate;
+                ret = outputFilePath.getFileDirectory(dirToCreate);
+                GT_ASSERT_EX(ret, L"Failed getting file directory for rcprof files.");
 
-                if (!outputFilePath.exists())
+                if (ret)
                 {
-                    osDirectory dirToCreate;
-                    ret = outputFilePath.getFileDirectory(dirToCreate);
-                    GT_ASSERT_EX(ret, L"Failed getting file directory for rcprof files.");
-
-                    if (ret)
-                    {
-                        dirToCreateStr = dirToCreate.directoryPath().asString();
-                        dmnUtils::CreateDirHierarchy(dirToCreateStr);
-                    }
+                    dirToCreateStr = dirToCreate.directoryPath().asString();
+                    dmnUtils::CreateDirHierarchy(dirToCreateStr);
                 }
+            }
 
-                outputFilePath.setFileName(fileNameNoPath);
+            outputFilePath.setFileName(fileNameNoPath);
 
-                ret = tmpBuffer.toFile(outputFilePath);
-                GT_ASSERT_EX(ret, L"DMN: Failed saving file to disk for rcprof.");
+            // Receive the file (resuming a previously interrupted transfer of it, if any).
+            ret = dmnFileTransfer::ReceiveFile(*pChannel, outputFilePath);
+            GT_ASSERT_EX(ret, L"DMN: Failed receiving file to disk for rcprof.");
 
-                // Trace the status.
-                std::wstringstream msgStream;
-                msgStream << L"DMN: Trying to receive the following file: " << fixedExpectedFileName.asCharArray();
-                GT_IF_WITH_ASSERT(ret)
-                {
-                    msgStream << L"-> " << L"Successfully received and written to disk.";
-                    dmnUtils::LogMessage(msgStream.str(), OS_DEBUG_LOG_DEBUG);
-                }
-                else
-                {
-                    msgStream << L"-> " << L"Failure on receiving file.";
-                    dmnUtils::LogMessage(msgStream.str(), OS_DEBUG_LOG_ERROR);
-                }
+            // Send ack.
+            ReportResult(ret, pChannel);
+
+            // Trace the status.
+            std::wstringstream msgStream;
+            msgStream << L"DMN: Trying to receive the following file: " << fixedExpectedFileName.asCharArray();
+            GT_IF_WITH_ASSERT(ret)
+            {
+                msgStream << L"-> " << L"Successfully received and written to disk.";
+                dmnUtils::LogMessage(msgStream.str(), OS_DEBUG_LOG_DEBUG);
+            }
+            else
+            {
+                msgStream << L"-> " << L"Failure on receiving file.";
+                dmnUtils::LogMessage(msgStream.str(), OS_DEBUG_LOG_ERROR);
             }
         }
     }
@@ -1348,15 +1215,6 @@ void dmnSessionThread::LaunchProfiler(bool& isTerminationRequired)
                                 (*iter).getFileName(sprofOutfileName);
                                 (*iter).getFileExtension(sprofOutfileExtension);
 
-                                // Currently compressed by default.
-                                // const bool isCompressed = true;
-
-                                // if (isCompressed)
-                                {
-                                    // Concatenate the compressed file suffix.
-                                    sprofOutfileName.append(COMPRESSED_FILE_SUFFIX);
-                                }
-
                                 if (!sprofOutfileExtension.isEmpty())
                                 {
                                     sprofOutfileExtension.prepend(L'.');
@@ -1366,8 +1224,8 @@ void dmnSessionThread::LaunchProfiler(bool& isTerminationRequired)
                                 isOk = m_pConnHandler->writeString(sprofOutfileName);
                                 GT_ASSERT_EX(isOk, L"DMN: Failed transferring rcprof file name to the client.");
 
-                                // Transfer the file.
-                                TransferFile(*iter, m_pConnHandler);
+                                // Transfer the file (compressed chunk by chunk).
+                                dmnFileTransfer::SendFile(*m_pConnHandler, *iter);
 
                                 // Verify.
                                 opStatus = dosFailure;
@@ -1663,52 +1521,15 @@ bool dmnSessionThread::SendFrameAnalysisFileData(const osFilePath& filePath)
             // Send the isBinary flag to CodeXL client
             (*m_pConnHandler) << isBinary;
 
-            gtVector<gtByte> pBuffer;
-            gtUInt32 fileSize;
-            retVal = ReadFile(filePath, isBinary, pBuffer, fileSize);
-            GT_IF_WITH_ASSERT(retVal)
-            {
-                // Write the file size to the CodeXL client
-                (*m_pConnHandler) << fileSize;
-
-                if (0 < fileSize)
-                {
-                    // Send the binary file content
-                    retVal = m_pConnHandler->write(&pBuffer[0], fileSize);
-                    GT_ASSERT(retVal);
-                }
-            }
+            // Send the file content
+            retVal = dmnFileTransfer::SendFile(*m_pConnHandler, filePath, true, isBinary);
+            GT_ASSERT(retVal);
         }
     }
 
     return retVal;
 }
 
-bool dmnSessionThread::ReadFile(const osFilePath& filePath, const bool isBinary, gtVector<gtByte>& pBuffer, gtUInt32& fileSize) const
-{
-    // Read the file size
-#if AMDT_BUILD_TARGET == AMDT_WINDOWS_OS //on windows we have unicode file names
-    const wchar_t*   fname = filePath.asString().asCharArray();
-#else
-    const char* fname = filePath.asString().asASCIICharArray();
-#endif
-    std::ifstream file(fname, (isBinary ? (std::ios::binary | std::ios::ate) : std::ios::ate));
-    fileSize = static_cast<unsigned long>(file.tellg());
-    file.seekg(0, std::ios::beg);
-
-    // Allocate a buffer and read the file content into it
-    pBuffer.resize(fileSize);
-
-    bool retVal = true;
-
-    if (0 < fileSize)
-    {
-        retVal = file.read(&(pBuffer[0]), fileSize) ? true : false;
-    }
-
-    return retVal;
-}
-
 void dmnSessionThread::CleanupProcessLeftOvers(const REMOTE_OPERATION_MODE mode) const
 {
 #if AMDT_BUILD_TARGET == AMDT_LINUX_OS
@@ -2173,7 +1994,7 @@ bool dmnSessionThread::GetRemoteFile()
         dmnUtils::LogMessage(stream.str(), OS_DEBUG_LOG_DEBUG);
 
 
-        isOk = TransferFile(fileName, m_pConnHandler, false);
+        isOk = dmnFileTransfer::SendFile(*m_pConnHandler, fileToGet);
         GT_ASSERT_EX(isOk, L"DMN: Transferring a file to the client.");
 
         // Respond.
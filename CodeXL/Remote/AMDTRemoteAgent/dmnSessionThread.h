@@ -73,8 +73,6 @@ private:
     /// \return true iff the file data was sent successfully
     bool SendFrameAnalysisFileData(const osFilePath& filePath);
 
-    bool ReadFile(const osFilePath& filePath, const bool isBinary, gtVector<gtByte>& pBuffer, gtUInt32& fileSize) const;
-
     typedef std::function<bool(osFilePath)> FilePathFilter;
     bool CreateCapturedFramesInfoFile(const gtString& projectName, const  FilePathFilter& sessionFilterFunc, const FilePathFilter& frameFilterFunc);
     void BuildFrameCaptureInfoNode(const gtList<osFilePath>& framesFiles, TiXmlElement* frameElement) const;
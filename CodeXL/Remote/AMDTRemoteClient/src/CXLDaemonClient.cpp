@@ -12,6 +12,7 @@
 
 // Remote agent definitions.
 #include <AMDTRemoteAgent/Public Include/dmnStringConstants.h>
+#include <AMDTRemoteAgent/Public Include/dmnFileTransfer.h>
 
 // Infra.
 #include <AMDTOSWrappers/Include/osMutex.h>
@@ -29,13 +30,7 @@
 // C++.
 #include <sstream>
 #include <algorithm>
-
-// Required by zlib to link properly.
-#if AMDT_BUILD_TARGET == AMDT_WINDOWS_OS
-    #define ZLIB_WINAPI
-#endif
-
-#include <zlib.h>
+#include <cstring>
 
 
 #define PLATFORM_LINUX L"Linux"
@@ -368,22 +363,18 @@ public:
 
                         if (ret)
                         {
-                            osRawMemoryBuffer tmpBuffer;
-                            ret = tmpBuffer.readSelfFromChannel(m_tcpClient);
+                            // Receive the file (resuming a previously interrupted transfer of it, if any).
+                            osFilePath outputFilePath(localTargetFileName);
+                            ret = dmnFileTransfer::ReceiveFile(m_tcpClient, outputFilePath);
+
                             GT_IF_WITH_ASSERT(ret)
                             {
-                                osFilePath outputFilePath(localTargetFileName);
-                                ret = tmpBuffer.toFile(outputFilePath);
+                                OS_OUTPUT_DEBUG_LOG(L"DMN Client: A file was successfully received and written to disk.", OS_DEBUG_LOG_INFO);
 
-                                GT_IF_WITH_ASSERT(ret)
-                                {
-                                    OS_OUTPUT_DEBUG_LOG(L"DMN Client: A file was successfully received and written to disk.", OS_DEBUG_LOG_INFO);
-
-                                    // Receive ack.
-                                    m_tcpClient >> opStatus;
-                                    ret = (opStatus == dosSuccess);
-                                    GT_ASSERT_EX(ret, L"On file transfer file successfully sent ACK.");
-                                }
+                                // Receive ack.
+                                m_tcpClient >> opStatus;
+                                ret = (opStatus == dosSuccess);
+                                GT_ASSERT_EX(ret, L"On file transfer file successfully sent ACK.");
                             }
                         }
                     }
@@ -426,12 +417,8 @@ public:
                     // Send the file.
                     opStatus = dosFailure;
                     osFilePath filePath(remoteFileName);
-                    osRawMemoryBuffer buffer;
-                    ret = buffer.fromFile(filePath);
-                    GT_IF_WITH_ASSERT(ret)
-                    {
-                        ret = buffer.writeSelfIntoChannel(m_tcpClient);
-                    }
+                    ret = dmnFileTransfer::SendFile(m_tcpClient, filePath);
+                    GT_ASSERT_EX(ret, L"On file transfer (sending) - file content.");
 
                     // Verify.
                     m_tcpClient >> opStatus;
@@ -511,79 +498,7 @@ public:
         return ret;
     }
 
-    bool DecompressFile(const osFilePath& originalFile, gtInt32 originalFileSize)
-    {
-        bool ret = false;
-
-        // First read compressed file.
-        osFile compressedFile(originalFile);
-        ret = compressedFile.open(osChannel::OS_BINARY_CHANNEL);
-        GT_ASSERT_EX(ret, L"DMN CLIENT: Failed to open received compressed file.");
-
-        if (ret)
-        {
-            unsigned long compressedFileSize = 0;
-            ret = compressedFile.getSize(compressedFileSize);
-            GT_ASSERT_EX(ret, L"DMN CLIENT: Failed to get compressed file's size.");
-
-            if (ret)
-            {
-                gtByte* dcmpBuffer = new(std::nothrow) gtByte[compressedFileSize];
-
-                gtSize_t dcmpAmountRead = 0;
-                compressedFile.readAvailableData(dcmpBuffer, compressedFileSize, dcmpAmountRead);
-
-                // Close and delete the compressed file.
-                compressedFile.close();
-                GT_ASSERT_EX(compressedFile.deleteFile(), L"Deleting compressed file.");
-
-                // IMPORTANT: Note that we are using the ORIGINAL data size.
-                gtByte* restoredFileBuffer = new(std::nothrow) gtByte[originalFileSize];
-
-                unsigned long _originalFileSize = originalFileSize;
-                int res = uncompress((unsigned char*)restoredFileBuffer,
-                                     &_originalFileSize, (unsigned char*)dcmpBuffer, dcmpAmountRead);
-                ret = (res == Z_OK);
-                GT_ASSERT_EX(ret, L"DMN CLIENT: Failed to decompress file on compression proxy.");
-
-                if (ret)
-                {
-                    // Now save it to disk so that we would be able to verify the correctness.
-                    osFilePath restoredFilePath = originalFile;
-                    gtString restoredFileName;
-                    originalFile.getFileName(restoredFileName);
-
-                    ret = (-1 != restoredFileName.find(L"_zipped") &&
-                           -1 != restoredFileName.replace(0, restoredFileName.length() - 1, L"_zipped", L""));
-                    GT_ASSERT_EX(ret, L"DMN CLIENT: Invalid compressed file name.");
-
-                    if (ret)
-                    {
-                        restoredFilePath.setFileName(restoredFileName);
-                        osFile restoredFile;
-                        ret = restoredFile.open(restoredFilePath, osChannel::OS_BINARY_CHANNEL, osFile::OS_OPEN_TO_WRITE);
-                        GT_ASSERT_EX(ret, L"DMN CLIENT: Failed to create decompressed file on disk.");
-
-                        if (ret)
-                        {
-                            ret = restoredFile.write(restoredFileBuffer, _originalFileSize);
-                            GT_ASSERT_EX(ret, L"DMN CLIENT: Failed to write decompressed file to disk.");
-                            restoredFile.close();
-                        }
-                    }
-                }
-
-                // Clean.
-                delete[] restoredFileBuffer;
-                delete[] dcmpBuffer;
-            }
-        }
-
-        return ret;
-    }
-
-
-    bool ReceiveRemoteFile(const gtString& whereToSave, bool isCompressed = true)
+    bool ReceiveRemoteFile(const gtString& whereToSave)
     {
         bool ret = false;
         OS_DEBUG_LOG_TRACER_WITH_RETVAL(ret);
@@ -592,40 +507,18 @@ public:
         ret = m_tcpClient.readString(sprofOutFileName);
         GT_ASSERT_EX(ret, L"DMN Client: Failed reading rcprof output file name.");
 
-        // Now get the original file size.
-        gtInt32 originalFileSize = 0;
-        m_tcpClient >> originalFileSize;
-        ret = (originalFileSize > 0);
-
-        // Report back.
-        gtInt32 report = (ret) ? dosSuccess : dosFailure;
-        m_tcpClient << report;
-
         if (ret)
         {
-            // Now read the file.
-            osRawMemoryBuffer tmpBuffer;
-            ret = tmpBuffer.readSelfFromChannel(m_tcpClient);
+            // Receive the file. It is decompressed chunk by chunk while it is received.
+            osFilePath outputFilePath;
+            outputFilePath.setFileDirectory(whereToSave);
+            outputFilePath.setFileName(sprofOutFileName);
+            ret = dmnFileTransfer::ReceiveFile(m_tcpClient, outputFilePath);
+            GT_ASSERT_EX(ret, L"DMN Client: Failed to receive rcprof output file.");
 
             // Report back whether the file was successfully received.
-            report = (ret) ? dosSuccess : dosFailure;
+            gtInt32 report = (ret) ? dosSuccess : dosFailure;
             m_tcpClient << report;
-
-            GT_IF_WITH_ASSERT(ret)
-            {
-                osFilePath outputFilePath;
-                outputFilePath.setFileDirectory(whereToSave);
-                outputFilePath.setFileName(sprofOutFileName);
-                ret = tmpBuffer.toFile(outputFilePath);
-                GT_ASSERT_EX(ret, L"DMN Client: Failed to receive rcprof output file.");
-
-                // Now check if we need to decompress the file.
-                if (isCompressed)
-                {
-                    ret = DecompressFile(outputFilePath, originalFileSize);
-                    GT_ASSERT_EX(ret, L"DMN Client: Failed to decompress received file..");
-                }
-            }
         }
 
         return ret;
@@ -1352,85 +1245,57 @@ public:
             gtString extension;
             m_tcpClient >> extension;
             m_tcpClient >> isBinary;
-            gtUInt32 dataSize = 0;
-            if (isBinary)
-            {
-                gtByte* pBuffer = nullptr;
 
-                // Read the data size from the remote agent
-                m_tcpClient >> dataSize;
+            message.makeEmpty();
+            message.appendFormattedString(L"ReadFrameFilesData: Reading %ls file. %ls ", (isBinary ? L"binary" : L"text"), extension.asCharArray());
+            OS_OUTPUT_DEBUG_LOG(message.asCharArray(), OS_DEBUG_LOG_DEBUG);
 
-                message.makeEmpty();
-                message.appendFormattedString(L"ReadFrameFilesData: Reading binary file. dataSize: %d ", (int)dataSize);
-                OS_OUTPUT_DEBUG_LOG(message.asCharArray(), OS_DEBUG_LOG_DEBUG);
+            // Frame images are received straight into the frame buffer, the other files are strings.
+            bool isImage = isBinary && (extension.compareNoCase(FRAME_IMAGE_FILE_EXT) == 0);
+            gtVector<gtByte> fileData;
+            bool rc = false;
 
-
-                // Read the data size from the remote agent
-                pBuffer = new gtByte[dataSize]();
-                bool rc = m_tcpClient.read((gtByte*)pBuffer, dataSize);
-
-                if (rc)
-                {
-                    if (extension.compareNoCase(FRAME_IMAGE_FILE_EXT) == 0)
-                    {
-                        frameData.m_pImageBuffer = reinterpret_cast<unsigned char*>(pBuffer);
-                        frameData.m_imageSize = dataSize;
-                    }
-                    else
-                    {
-                        gtString msg(L"Unsupported file format sent from the remote agent: ");
-                        msg.append(extension);
-                        GT_ASSERT_EX(false, msg.asCharArray());
-                        retVal = false;
-                    }
-                }
-                else
-                {
-                    gtString msg;
-                    msg.appendFormattedString(L"Failed to read binary file sent from remote agent. File size = %d. File extension = ", dataSize);
-                    msg.append(extension);
-                    GT_ASSERT_EX(false, msg.asCharArray());
-                    // Reading the binary file content failed. This invalidates the communication protocol so we have
-                    // to close the TCP connection to avoid losing sync with the remote agent communication stage
-                    m_tcpClient.close();
-                    retVal = false;
-                    break;
-                }
+            if (isImage)
+            {
+                delete[] frameData.m_pImageBuffer;
+                frameData.m_pImageBuffer = nullptr;
+                frameData.m_imageSize = 0;
+                rc = dmnFileTransfer::ReceiveFileData(m_tcpClient, frameData.m_pImageBuffer, frameData.m_imageSize);
             }
             else
             {
-                message.makeEmpty();
-                message.appendFormattedString(L"ReadFrameFilesData: Reading text file. %ls ", extension.asCharArray());
-                OS_OUTPUT_DEBUG_LOG(message.asCharArray(), OS_DEBUG_LOG_DEBUG);
-
-                if (extension.compareNoCase(FRAME_DESCRITPION_FILE_EXT) == 0)
-                {
-                    // Read the frame info XML string from the remote agent
-                    // Read the data size from the remote agent
-                    m_tcpClient >> dataSize;
-                    gtByte* pBuffer = new gtByte[dataSize+1]();
-                    bool rc = m_tcpClient.read((gtByte*)pBuffer, dataSize);
-                    GT_ASSERT(rc == true);
-                    frameData.m_frameInfoXML = pBuffer;
-                    delete [] pBuffer;
-                }
-                else if (extension.compareNoCase(FRAME_TRACE_FILE_EXT) == 0)
-                {
-                    m_tcpClient >> frameData.m_frameTrace;
-                }
-                else
-                {
-                    gtString msg(L"Unsupported file format sent from the remote agent: ");
-                    msg.append(extension);
-                    GT_ASSERT_EX(false, msg.asCharArray());
-
-                    // Read into a temp string (avoid breaking the protocol)
-                    gtASCIIString tempStr;
-                    m_tcpClient >> tempStr;
+                rc = dmnFileTransfer::ReceiveFileData(m_tcpClient, fileData);
+            }
 
-                    retVal = false;
+            if (!rc)
+            {
+                gtString msg(L"Failed to read a file sent from remote agent. File extension = ");
+                msg.append(extension);
+                GT_ASSERT_EX(false, msg.asCharArray());
+                // Reading the file content failed. This might invalidate the communication protocol so we have
+                // to close the TCP connection to avoid losing sync with the remote agent communication stage
+                m_tcpClient.close();
+                retVal = false;
+                break;
+            }
 
-                }
+            if (!isBinary && (extension.compareNoCase(FRAME_DESCRITPION_FILE_EXT) == 0))
+            {
+                // Read the frame info XML string from the remote agent
+                fileData.push_back('\0');
+                frameData.m_frameInfoXML = &fileData[0];
+            }
+            else if (!isBinary && (extension.compareNoCase(FRAME_TRACE_FILE_EXT) == 0))
+            {
+                fileData.push_back('\0');
+                frameData.m_frameTrace = &fileData[0];
+            }
+            else if (!isImage)
+            {
+                gtString msg(L"Unsupported file format sent from the remote agent: ");
+                msg.append(extension);
+                GT_ASSERT_EX(false, msg.asCharArray());
+                retVal = false;
             }
         }
 
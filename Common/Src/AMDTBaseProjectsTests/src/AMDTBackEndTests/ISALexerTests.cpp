@@ -0,0 +1,390 @@
+#pragma warning(disable : 4996)
+#pragma warning(disable : 4100)
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <boost/regex.hpp>
+#include <gtest/gtest.h>
+#include <AMDTBackEnd/Emulator/Parser/ISALexer.h>
+
+// The SI, CI and VI disassemblies of the corpus, in the ISACorpus folder next to this file:
+static const char* s_isaCorpusFiles[] =
+{
+    "SI_Tahiti_VectorAdd.isa",
+    "CI_Hawaii_Reduce.isa",
+    "VI_Fiji_Histogram.isa",
+    "VI_Tonga_VulkanCompute.isa"
+};
+
+static const int NO_LABEL = -1;
+
+static std::string ReadCorpusFile(const char* pFileName)
+{
+    std::string filePath(__FILE__);
+    filePath = filePath.substr(0, filePath.find_last_of("/\\") + 1) + "ISACorpus/" + pFileName;
+
+    std::ifstream file(filePath.c_str(), std::ios::in | std::ios::binary);
+    std::stringstream fileContent;
+    fileContent << file.rdbuf();
+    return fileContent.str();
+}
+
+// The line matching of ParserISA before the lexer: the regular expressions of ParseToVector and ParseForSize,
+// and the stream based hex and label parsing.
+struct RegexIsaParser
+{
+    RegexIsaParser() :
+        m_inst32_48Ex("([[:print:]]*// [[:print:]]{12}: )([[:print:]]{8})"),
+        m_inst64_48Ex("([[:print:]]*// [[:print:]]{12}: )([[:print:]]{8})( )([[:print:]]{8})"),
+        m_inst32Ex("([[:print:]]*// [[:print:]]{8}: )([[:print:]]{8})"),
+        m_inst64Ex("([[:print:]]*// [[:print:]]{8}: )([[:print:]]{8})( )([[:print:]]{8})"),
+        m_vgprsEx("([[:blank:]]*NumVgprs[[:blank:]]*=[[:blank:]]*)([[:digit:]]*)"),
+        m_sgprsEx("([[:blank:]]*NumSgprs[[:blank:]]*=[[:blank:]]*)([[:digit:]]*)"),
+        m_codeLenInByteEx("([[:blank:]]*codeLenInByte[[:blank:]]*=[[:blank:]]*)([[:digit:]]*)"),
+        m_codeLenInByteNI("([[:blank:]]*CodeLen[[:blank:]]*=[[:blank:]]*)([[:digit:]]*)"),
+        m_instAnnotation("//[[:blank:]]*[[:xdigit:]]{12}:[[:blank:]]*([[:xdigit:]]{8})([[:blank:]]+[[:xdigit:]]{8}){0,1}")
+    {
+    }
+
+    template <typename T>
+    static T ReadHex(const std::string& text)
+    {
+        std::stringstream instStream;
+        T value = 0;
+        instStream << std::hex << text;
+        instStream >> value;
+        return value;
+    }
+
+    // Throws std::out_of_range for a line which is shorter than its label prefix.
+    static int GetLabel(const std::string& sISALine)
+    {
+        int iRet = NO_LABEL;
+        int iLocation = (int)sISALine.find("label");
+        const int HSAIL_ISA_OFFSET = 2;
+        int offset = 0;
+
+        if (iLocation == HSAIL_ISA_OFFSET)
+        {
+            offset = HSAIL_ISA_OFFSET;
+        }
+
+        if (iLocation == 0 || iLocation == HSAIL_ISA_OFFSET)
+        {
+            std::string labelText(sISALine.substr(6 + offset, sISALine.length() - 7));
+            iRet = ReadHex<int>(labelText);
+        }
+
+        return iRet;
+    }
+
+    static int GetGotoLabel(const std::string& sISALine)
+    {
+        int iRet = NO_LABEL;
+        size_t iLocation = (int)sISALine.find("label_");
+
+        if (iLocation != std::string::npos)
+        {
+            std::string labelText(sISALine.substr(iLocation + 6, 4));
+            iRet = ReadHex<int>(labelText);
+        }
+
+        return iRet;
+    }
+
+    boost::regex m_inst32_48Ex;
+    boost::regex m_inst64_48Ex;
+    boost::regex m_inst32Ex;
+    boost::regex m_inst64Ex;
+    boost::regex m_vgprsEx;
+    boost::regex m_sgprsEx;
+    boost::regex m_codeLenInByteEx;
+    boost::regex m_codeLenInByteNI;
+    boost::regex m_instAnnotation;
+};
+
+static void ExpectSameInstructionAnnotation(const std::string& isaLine, const boost::regex& instEx, size_t offsetLength, bool is64Bit)
+{
+    boost::smatch matchInst;
+    bool isRegexMatch = boost::regex_search(isaLine, matchInst, instEx);
+
+    const char* pLow = nullptr;
+    const char* pHigh = nullptr;
+    bool isLexerMatch = ISALexer::FindInstructionAnnotation(isaLine.data(), isaLine.data() + isaLine.size(), offsetLength, is64Bit, pLow, pHigh);
+    ASSERT_EQ(isRegexMatch, isLexerMatch) << isaLine;
+
+    if (isRegexMatch)
+    {
+        std::string instTextLow(matchInst[2].first, matchInst[2].second);
+        EXPECT_EQ(matchInst[2].first - isaLine.begin(), pLow - isaLine.data()) << isaLine;
+        EXPECT_EQ(RegexIsaParser::ReadHex<uint32_t>(instTextLow), static_cast<uint32_t>(ISALexer::ReadHexNumber(pLow, pLow + 8))) << isaLine;
+
+        if (is64Bit)
+        {
+            std::string instTextHigh(matchInst[4].first, matchInst[4].second);
+            EXPECT_EQ(matchInst[4].first - isaLine.begin(), pHigh - isaLine.data()) << isaLine;
+
+            char inst64Text[16];
+            memcpy(inst64Text, pHigh, 8);
+            memcpy(inst64Text + 8, pLow, 8);
+            EXPECT_EQ(RegexIsaParser::ReadHex<uint64_t>(instTextHigh + instTextLow), ISALexer::ReadHexNumber(inst64Text, inst64Text + sizeof(inst64Text))) << isaLine;
+        }
+    }
+}
+
+static void ExpectSameNumericAssignment(const std::string& isaLine, const boost::regex& assignmentEx, const char* pKey)
+{
+    boost::smatch matchInst;
+    bool isRegexMatch = boost::regex_search(isaLine, matchInst, assignmentEx);
+
+    unsigned int value = 0;
+    bool isLexerMatch = ISALexer::FindNumericAssignment(isaLine.data(), isaLine.data() + isaLine.size(), pKey, strlen(pKey), value);
+    ASSERT_EQ(isRegexMatch, isLexerMatch) << isaLine;
+
+    if (isRegexMatch)
+    {
+        std::string valueText(matchInst[2].first, matchInst[2].second);
+        EXPECT_EQ((unsigned int)atoi(valueText.c_str()), value) << isaLine;
+    }
+}
+
+// Runs all the matchers of the regex parser and of the lexer on an ISA line, and compares their results.
+static void ExpectSameLineMatches(const RegexIsaParser& regexParser, const std::string& isaLine)
+{
+    const char* pLineBegin = isaLine.data();
+    const char* pLineEnd = pLineBegin + isaLine.size();
+
+    ExpectSameInstructionAnnotation(isaLine, regexParser.m_inst64Ex, ISALexer::INST_OFFSET_LENGTH, true);
+    ExpectSameInstructionAnnotation(isaLine, regexParser.m_inst64_48Ex, ISALexer::INST_OFFSET_LENGTH_48, true);
+    ExpectSameInstructionAnnotation(isaLine, regexParser.m_inst32Ex, ISALexer::INST_OFFSET_LENGTH, false);
+    ExpectSameInstructionAnnotation(isaLine, regexParser.m_inst32_48Ex, ISALexer::INST_OFFSET_LENGTH_48, false);
+
+    ExpectSameNumericAssignment(isaLine, regexParser.m_vgprsEx, "NumVgprs");
+    ExpectSameNumericAssignment(isaLine, regexParser.m_sgprsEx, "NumSgprs");
+    ExpectSameNumericAssignment(isaLine, regexParser.m_codeLenInByteEx, "codeLenInByte");
+    ExpectSameNumericAssignment(isaLine, regexParser.m_codeLenInByteNI, "CodeLen");
+
+    boost::smatch matchInst;
+    bool is64BitInst = false;
+    bool isRegexSizeMatch = boost::regex_search(isaLine, matchInst, regexParser.m_instAnnotation);
+    ASSERT_EQ(isRegexSizeMatch, ISALexer::FindInstructionSizeAnnotation(pLineBegin, pLineEnd, is64BitInst)) << isaLine;
+
+    if (isRegexSizeMatch)
+    {
+        EXPECT_EQ(matchInst[(int)matchInst.size() - 1].matched, is64BitInst) << isaLine;
+    }
+
+    // The old label parsing throws on lines which are shorter than their label prefix. The lexer reads no digits from these.
+    int regexLabel = NO_LABEL;
+    bool isRegexLabelValid = true;
+
+    try
+    {
+        regexLabel = RegexIsaParser::GetLabel(isaLine);
+    }
+    catch (const std::out_of_range&)
+    {
+        isRegexLabelValid = false;
+    }
+
+    int lexerLabel = NO_LABEL;
+
+    if (!ISALexer::GetLabel(pLineBegin, pLineEnd, lexerLabel))
+    {
+        lexerLabel = NO_LABEL;
+    }
+
+    if (isRegexLabelValid)
+    {
+        EXPECT_EQ(regexLabel, lexerLabel) << isaLine;
+    }
+
+    int lexerGotoLabel = NO_LABEL;
+
+    if (!ISALexer::GetGotoLabel(pLineBegin, pLineEnd, lexerGotoLabel))
+    {
+        lexerGotoLabel = NO_LABEL;
+    }
+
+    EXPECT_EQ(RegexIsaParser::GetGotoLabel(isaLine), lexerGotoLabel) << isaLine;
+
+    // The section markers and the comment test of ParseToVector:
+    static const char* markers[] = { "Disassembly --------------------", "; ----------------- CS Data ------------------------", "end", "shader ", "asic(", "//" };
+
+    for (size_t i = 0; i < sizeof(markers) / sizeof(markers[0]); i++)
+    {
+        const char* pFound = ISALexer::FindText(pLineBegin, pLineEnd, markers[i], strlen(markers[i]));
+        size_t regexFound = isaLine.find(markers[i]);
+        EXPECT_EQ(regexFound == std::string::npos, pFound == nullptr) << isaLine;
+
+        if (pFound != nullptr)
+        {
+            EXPECT_EQ(regexFound, (size_t)(pFound - pLineBegin)) << isaLine;
+        }
+    }
+}
+
+// Splits the ISA with getline, as the regex parser did, and checks that the lexer splits it to the same lines.
+static std::vector<std::string> SplitIsaLines(const std::string& isa)
+{
+    std::vector<std::string> isaLines;
+    std::istringstream isaStream(isa);
+    std::string isaLine;
+
+    while (getline(isaStream, isaLine))
+    {
+        isaLines.push_back(isaLine);
+    }
+
+    const char* pIsaPos = isa.data();
+    const char* pIsaEnd = pIsaPos + isa.size();
+    const char* pLineBegin = nullptr;
+    const char* pLineEnd = nullptr;
+    size_t lineIndex = 0;
+
+    while (ISALexer::GetNextLine(pIsaPos, pIsaEnd, pLineBegin, pLineEnd))
+    {
+        EXPECT_LT(lineIndex, isaLines.size());
+
+        if (lineIndex < isaLines.size())
+        {
+            EXPECT_EQ(isaLines[lineIndex], std::string(pLineBegin, pLineEnd));
+        }
+
+        lineIndex++;
+    }
+
+    EXPECT_EQ(isaLines.size(), lineIndex);
+
+    return isaLines;
+}
+
+// Applies a few random edits to an ISA line: the inserted characters are the ones the matchers look for.
+static std::string MutateIsaLine(const std::string& isaLine)
+{
+    static const char insertedChars[] = "/ :\t0123456789aAfFgx=-+_\r\x7f\x80";
+    std::string mutatedLine = isaLine;
+    int editsCount = 1 + rand() % 3;
+
+    for (int i = 0; i < editsCount; i++)
+    {
+        size_t pos = mutatedLine.empty() ? 0 : (rand() % (mutatedLine.size() + 1));
+        int edit = rand() % 4;
+
+        if (edit == 0 && pos < mutatedLine.size())
+        {
+            mutatedLine.erase(pos, 1);
+        }
+        else if (edit == 1 && pos < mutatedLine.size())
+        {
+            mutatedLine[pos] = insertedChars[rand() % (sizeof(insertedChars) - 1)];
+        }
+        else if (edit == 2 && !mutatedLine.empty())
+        {
+            // Duplicate a part of the line, e.g. to have several annotations in it.
+            size_t copyPos = rand() % mutatedLine.size();
+            mutatedLine.insert(pos, mutatedLine.substr(copyPos, 1 + rand() % 24));
+        }
+        else
+        {
+            mutatedLine.insert(pos, 1, insertedChars[rand() % (sizeof(insertedChars) - 1)]);
+        }
+    }
+
+    return mutatedLine;
+}
+
+TEST(ISALexer, CorpusLinesMatchRegexParser)
+{
+    RegexIsaParser regexParser;
+
+    for (size_t fileIndex = 0; fileIndex < sizeof(s_isaCorpusFiles) / sizeof(s_isaCorpusFiles[0]); fileIndex++)
+    {
+        std::string isa = ReadCorpusFile(s_isaCorpusFiles[fileIndex]);
+        ASSERT_FALSE(isa.empty()) << s_isaCorpusFiles[fileIndex];
+
+        std::vector<std::string> isaLines = SplitIsaLines(isa);
+        int instructionsCount = 0;
+
+        for (size_t i = 0; i < isaLines.size(); i++)
+        {
+            ExpectSameLineMatches(regexParser, isaLines[i]);
+
+            bool is64BitInst = false;
+
+            if (ISALexer::FindInstructionSizeAnnotation(isaLines[i].data(), isaLines[i].data() + isaLines[i].size(), is64BitInst) ||
+                boost::regex_search(isaLines[i], regexParser.m_inst32Ex))
+            {
+                instructionsCount++;
+            }
+        }
+
+        // Make sure the corpus file was read, and that its instructions were recognized:
+        EXPECT_LT(20, instructionsCount) << s_isaCorpusFiles[fileIndex];
+    }
+}
+
+TEST(ISALexer, CorpusWithWindowsLineEndsMatchesRegexParser)
+{
+    RegexIsaParser regexParser;
+
+    for (size_t fileIndex = 0; fileIndex < sizeof(s_isaCorpusFiles) / sizeof(s_isaCorpusFiles[0]); fileIndex++)
+    {
+        std::string isa = ReadCorpusFile(s_isaCorpusFiles[fileIndex]);
+        std::string crlfIsa;
+
+        for (size_t i = 0; i < isa.size(); i++)
+        {
+            if (isa[i] == '\n' && (i == 0 || isa[i - 1] != '\r'))
+            {
+                crlfIsa += '\r';
+            }
+
+            crlfIsa += isa[i];
+        }
+
+        std::vector<std::string> isaLines = SplitIsaLines(crlfIsa);
+
+        for (size_t i = 0; i < isaLines.size(); i++)
+        {
+            ExpectSameLineMatches(regexParser, isaLines[i]);
+        }
+    }
+}
+
+TEST(ISALexer, MutatedCorpusLinesMatchRegexParser)
+{
+    RegexIsaParser regexParser;
+    srand(1);
+
+    for (size_t fileIndex = 0; fileIndex < sizeof(s_isaCorpusFiles) / sizeof(s_isaCorpusFiles[0]); fileIndex++)
+    {
+        std::vector<std::string> isaLines = SplitIsaLines(ReadCorpusFile(s_isaCorpusFiles[fileIndex]));
+
+        for (size_t i = 0; i < isaLines.size(); i++)
+        {
+            for (int j = 0; j < 20; j++)
+            {
+                ExpectSameLineMatches(regexParser, MutateIsaLine(isaLines[i]));
+            }
+        }
+    }
+}
+
+TEST(ISALexer, ReadHexNumberMatchesStream)
+{
+    static const char* hexTexts[] = { "", " ", "0", "7", "BF810000", "bf810000", "  1a2B", "0x1F", "0X", "0xg", "12g4", "+5", "-5", "-", "label", "00000000FFFFFFFF" };
+
+    for (size_t i = 0; i < sizeof(hexTexts) / sizeof(hexTexts[0]); i++)
+    {
+        std::string hexText(hexTexts[i]);
+        EXPECT_EQ(RegexIsaParser::ReadHex<uint64_t>(hexText), ISALexer::ReadHexNumber(hexText.data(), hexText.data() + hexText.size())) << hexText;
+        EXPECT_EQ(RegexIsaParser::ReadHex<uint32_t>(hexText), static_cast<uint32_t>(ISALexer::ReadHexNumber(hexText.data(), hexText.data() + hexText.size()))) << hexText;
+    }
+}
@@ -0,0 +1,215 @@
+#pragma warning(disable : 4996)
+#pragma warning(disable : 4100)
+
+
+#include <stdlib.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <AMDTBackEnd/Emulator/Parser/SOP1Instruction.h>
+#include <AMDTBackEnd/Emulator/Parser/SOPPInstruction.h>
+#include <AMDTBackEnd/Emulator/Scheduler/UTDPScheduler.h>
+
+// The branch unit predictions are shuffled with rand(), so both schedulers are created with the same seed:
+static const unsigned int s_branchPredictionSeed = 7;
+static const double s_branchRate = 0.5;
+
+// A kernel with vector, scalar and SI / VI branch instructions:
+class UTDPSchedulerTestKernel
+{
+public:
+    UTDPSchedulerTestKernel()
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            m_instructions.push_back(new Instruction(32, Instruction::VectorALU, Instruction::InstructionSet_VOP2));
+            m_instructions.push_back(new Instruction(32, Instruction::ScalarALU, Instruction::InstructionSet_SOP2));
+            m_instructions.push_back(new SISOPPInstruction(4, SISOPPInstruction::S_CBRANCH_SCC0, NO_LABEL, NO_LABEL));
+            m_instructions.push_back(new Instruction(64, Instruction::VectorMemoryRead, Instruction::InstructionSet_MUBUF));
+            m_instructions.push_back(new VISOPPInstruction(2, VISOPPInstruction::s_branch, NO_LABEL, NO_LABEL));
+            m_instructions.push_back(new SISOP1Instruction(SOP1Instruction::SSRC(0), SISOP1Instruction::S_SETPC_B64, SOP1Instruction::SDST(0), 0, 0, NO_LABEL, NO_LABEL));
+            m_instructions.push_back(new Instruction(32, Instruction::ScalarMemoryRead, Instruction::InstructionSet_SMRD));
+        }
+
+        m_instructions.push_back(new SISOPPInstruction(0, SISOPPInstruction::S_ENDPGM, NO_LABEL, NO_LABEL));
+    }
+
+    ~UTDPSchedulerTestKernel()
+    {
+        for (Instruction* pInstruction : m_instructions)
+        {
+            delete pInstruction;
+        }
+    }
+
+    std::vector<Instruction*> m_instructions;
+};
+
+// Schedules the work groups as UTDPScheduler::Schedule used to: every work group is instantiated,
+// and each pass executes an instruction from each wavefront of each work group.
+static size_t ScheduleWorkGroupsOneByOne(const std::vector<Instruction*>& instructions, const UTDPScheduler::DeviceDescription& device,
+                                         const std::vector<size_t>& globalWorkSize, const std::vector<size_t>& localWorkSize)
+{
+    size_t workGroupSize = 1;
+    size_t globalTotalWorkSize = 1;
+
+    for (size_t dim = 0; dim < globalWorkSize.size(); dim++)
+    {
+        workGroupSize *= localWorkSize[dim];
+        globalTotalWorkSize *= globalWorkSize[dim];
+    }
+
+    size_t workGroupNum = globalTotalWorkSize / workGroupSize;
+    size_t waveFrontNum = workGroupSize / device.m_waveFrontSize + workGroupSize % device.m_waveFrontSize;
+
+    srand(s_branchPredictionSeed);
+    std::vector<CUScheduler> cuSchedulers(device.m_numCU, CUScheduler(s_branchRate, &instructions));
+    std::vector<WorkGroup> workGroups(workGroupNum, WorkGroup(waveFrontNum, &instructions));
+    bool isScheduleProgress = true;
+
+    while (isScheduleProgress)
+    {
+        isScheduleProgress = false;
+
+        for (size_t workGroup = 0; workGroup < workGroupNum; workGroup++)
+        {
+            bool isWorkGroupScheduleProgress = false;
+            cuSchedulers[workGroup % device.m_numCU].ScheduleWG(workGroups[workGroup], isWorkGroupScheduleProgress);
+            isScheduleProgress |= isWorkGroupScheduleProgress;
+        }
+    }
+
+    size_t exeClkNum = 0;
+
+    for (const CUScheduler& cuScheduler : cuSchedulers)
+    {
+        exeClkNum = std::max(exeClkNum, cuScheduler.GetClkNum());
+    }
+
+    return exeClkNum;
+}
+
+static size_t Schedule(const std::vector<Instruction*>& instructions, const UTDPScheduler::DeviceDescription& device,
+                       const std::vector<size_t>& globalWorkSize, const std::vector<size_t>& localWorkSize, size_t threadNum)
+{
+    srand(s_branchPredictionSeed);
+    UTDPScheduler scheduler(instructions, device, globalWorkSize.size(), globalWorkSize, localWorkSize, s_branchRate);
+    scheduler.SetThreadNum(threadNum);
+
+    size_t exeClkNum = 0;
+    EXPECT_EQ(UTDPScheduler::Status_ScheduleSuccess, scheduler.Schedule(exeClkNum));
+    return exeClkNum;
+}
+
+static UTDPScheduler::DeviceDescription MakeDevice(size_t numCU)
+{
+    UTDPScheduler::DeviceDescription device;
+    device.m_name = "TestDevice";
+    device.m_numCU = numCU;
+    device.m_waveFrontSize = 64;
+    device.m_maxWorkGoupSize = 256;
+    device.m_clk = 1;
+    return device;
+}
+
+TEST(UTDPScheduler, ScheduleMatchesWorkGroupsOneByOne)
+{
+    UTDPSchedulerTestKernel kernel;
+
+    // Fewer work groups than compute units, a number of work groups which is not divisible by the number of
+    // compute units, and work groups which do not fill whole wavefronts:
+    static const size_t numCUs[] = { 1, 10, 32 };
+    static const size_t globalWorkSizes[] = { 64, 960, 4096, 6400 };
+    static const size_t localWorkSizes[] = { 64, 96, 256 };
+    static const size_t threadNums[] = { 1, 4, 0 };
+
+    for (size_t numCU : numCUs)
+    {
+        UTDPScheduler::DeviceDescription device = MakeDevice(numCU);
+
+        for (size_t globalWorkSize : globalWorkSizes)
+        {
+            for (size_t localWorkSize : localWorkSizes)
+            {
+                if (globalWorkSize % localWorkSize == 0)
+                {
+                    std::vector<size_t> global(1, globalWorkSize);
+                    std::vector<size_t> local(1, localWorkSize);
+                    size_t expectedClkNum = ScheduleWorkGroupsOneByOne(kernel.m_instructions, device, global, local);
+
+                    for (size_t threadNum : threadNums)
+                    {
+                        EXPECT_EQ(expectedClkNum, Schedule(kernel.m_instructions, device, global, local, threadNum))
+                                << numCU << " CUs, global " << globalWorkSize << ", local " << localWorkSize << ", " << threadNum << " threads";
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(UTDPScheduler, ScheduleMatchesWorkGroupsOneByOneIn2D)
+{
+    UTDPSchedulerTestKernel kernel;
+    UTDPScheduler::DeviceDescription device = MakeDevice(10);
+    std::vector<size_t> global = { 160, 48 };
+    std::vector<size_t> local = { 16, 8 };
+
+    EXPECT_EQ(ScheduleWorkGroupsOneByOne(kernel.m_instructions, device, global, local), Schedule(kernel.m_instructions, device, global, local, 0));
+}
+
+TEST(UTDPScheduler, ScheduleRejectsInvalidWorkSizes)
+{
+    UTDPSchedulerTestKernel kernel;
+    UTDPScheduler::DeviceDescription device = MakeDevice(10);
+    size_t exeClkNum = 0;
+
+    UTDPScheduler tooLargeWorkGroup(kernel.m_instructions, device, 1, std::vector<size_t>(1, 1024), std::vector<size_t>(1, 512), s_branchRate);
+    EXPECT_EQ(UTDPScheduler::Status_ScheduleInvalidWorkGroupSize, tooLargeWorkGroup.Schedule(exeClkNum));
+
+    UTDPScheduler unevenWorkGroups(kernel.m_instructions, device, 1, std::vector<size_t>(1, 100), std::vector<size_t>(1, 64), s_branchRate);
+    EXPECT_EQ(UTDPScheduler::Status_ScheduleInvalidWorkGroupSize, unevenWorkGroups.Schedule(exeClkNum));
+}
+
+TEST(UTDPScheduler, DevicesFileMatchesBuiltInDevices)
+{
+    // The devices file which is installed next to the binaries:
+    std::string filePath(__FILE__);
+    filePath = filePath.substr(0, filePath.find_last_of("/\\") + 1) + "../../../../../CodeXL/Components/ShaderAnalyzer/AMDTBackEnd/Emulator/Scheduler/EmulatorDevices.txt";
+
+    std::vector<UTDPScheduler::DeviceDescription> devices;
+    ASSERT_TRUE(UTDPScheduler::LoadDeviceDescriptions(filePath, devices)) << filePath;
+    EXPECT_EQ(9u, devices.size());
+
+    static const UTDPScheduler::DeviceType builtInDeviceTypes[] = { UTDPScheduler::Tahiti, UTDPScheduler::CapeVerde, UTDPScheduler::Pitcrain };
+
+    for (UTDPScheduler::DeviceType deviceType : builtInDeviceTypes)
+    {
+        UTDPScheduler::DeviceDescription builtInDevice;
+        UTDPScheduler::GetBuiltInDeviceDescription(deviceType, builtInDevice);
+
+        UTDPScheduler::DeviceDescription fileDevice;
+        ASSERT_TRUE(UTDPScheduler::FindDeviceDescription(devices, builtInDevice.m_name, fileDevice)) << builtInDevice.m_name;
+        EXPECT_EQ(builtInDevice.m_numCU, fileDevice.m_numCU);
+        EXPECT_EQ(builtInDevice.m_waveFrontSize, fileDevice.m_waveFrontSize);
+        EXPECT_EQ(builtInDevice.m_maxWorkGoupSize, fileDevice.m_maxWorkGoupSize);
+        EXPECT_EQ(builtInDevice.m_clk, fileDevice.m_clk);
+    }
+
+    // Device names are case insensitive:
+    UTDPScheduler::DeviceDescription fiji;
+    ASSERT_TRUE(UTDPScheduler::FindDeviceDescription(devices, "fiji", fiji));
+    EXPECT_EQ(64u, fiji.m_numCU);
+}
+
+TEST(UTDPScheduler, GetDeviceDescriptionFallsBackToBuiltInDevices)
+{
+    // The built-in devices are found whether or not the devices file is installed next to the test:
+    UTDPScheduler::DeviceDescription pitcairn;
+    ASSERT_TRUE(UTDPScheduler::GetDeviceDescription("Pitcairn", pitcairn));
+    EXPECT_EQ(UTDPScheduler::NumCUPitcrain, pitcairn.m_numCU);
+
+    UTDPScheduler::DeviceDescription unknownDevice;
+    EXPECT_FALSE(UTDPScheduler::GetDeviceDescription("NoSuchDevice", unknownDevice));
+}
@@ -0,0 +1,322 @@
+#pragma warning(disable : 4996)
+#pragma warning(disable : 4100)
+
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <gtest/gtest.h>
+#include <AMDTGpuProfiling/gpTraceSearch.h>
+
+/// An in memory column store, laid out as the trace table column store
+class TestTraceSearchStore : public gpTraceSearchStore
+{
+public:
+    void AddRow(const char* name, const char* arguments, quint64 startTime, quint64 endTime)
+    {
+        quint32 nameId = 0;
+
+        while ((nameId < m_names.size()) && (m_names[nameId] != QString(name)))
+        {
+            nameId++;
+        }
+
+        if (nameId == m_names.size())
+        {
+            m_names.push_back(QString(name));
+        }
+
+        m_nameIds.push_back(nameId);
+        m_argumentsOffsets.push_back(m_arguments.size());
+        m_argumentsLengths.push_back(static_cast<quint32>(strlen(arguments)));
+        m_arguments.append(arguments);
+        m_startTimes.push_back(startTime);
+        m_endTimes.push_back(endTime);
+    }
+
+    virtual quint32 GetRowCount() const override { return static_cast<quint32>(m_nameIds.size()); }
+    virtual quint32 GetNameId(quint32 row) const override { return m_nameIds[row]; }
+    virtual quint32 GetInternedStringsCount() const override { return static_cast<quint32>(m_names.size()); }
+    virtual const QString& GetInternedString(quint32 id) const override { return m_names[id]; }
+    virtual const char* GetArgumentsChars() const override { return m_arguments.data(); }
+    virtual quint64 GetArgumentsOffset(quint32 row) const override { return m_argumentsOffsets[row]; }
+    virtual quint32 GetArgumentsLength(quint32 row) const override { return m_argumentsLengths[row]; }
+    virtual quint64 GetStartTime(quint32 row) const override { return m_startTimes[row]; }
+    virtual quint64 GetEndTime(quint32 row) const override { return m_endTimes[row]; }
+
+private:
+    std::vector<QString> m_names;
+    std::vector<quint32> m_nameIds;
+    std::string m_arguments;
+    std::vector<quint64> m_argumentsOffsets;
+    std::vector<quint32> m_argumentsLengths;
+    std::vector<quint64> m_startTimes;
+    std::vector<quint64> m_endTimes;
+};
+
+static bool ParseQuery(const char* queryText, bool matchCase, bool isRegex, gpTraceSearchQuery& query)
+{
+    QString errorMessage;
+    bool retVal = query.Parse(QString(queryText), matchCase, isRegex, errorMessage);
+    return retVal && errorMessage.isEmpty();
+}
+
+static std::vector<quint32> FindRows(const gpTraceSearchTableIndex& index, const char* queryText, bool matchCase = false, bool isRegex = false)
+{
+    std::vector<quint32> rows;
+    gpTraceSearchQuery query;
+
+    if (ParseQuery(queryText, matchCase, isRegex, query))
+    {
+        std::atomic<unsigned int> searchGeneration(1);
+        index.Find(query, searchGeneration, 1, rows);
+    }
+
+    return rows;
+}
+
+TEST(gpTraceSearchQuery, ParsesFieldTerms)
+{
+    gpTraceSearchQuery query;
+    ASSERT_TRUE(ParseQuery("clFinish API:clEnqueue arg:0x1000 thread:42 \"size = 8\" arg:\"index = 1\"", true, false, query));
+    EXPECT_TRUE(query.IsMatchCase());
+    EXPECT_FALSE(query.IsRegex());
+
+    const std::vector<gpTraceSearchTerm>& terms = query.GetTerms();
+    ASSERT_EQ(6u, terms.size());
+    EXPECT_EQ(GP_TRACE_SEARCH_FIELD_ANY, terms[0].m_field);
+    EXPECT_TRUE(terms[0].m_text == QString("clFinish"));
+    EXPECT_EQ(GP_TRACE_SEARCH_FIELD_API, terms[1].m_field);
+    EXPECT_TRUE(terms[1].m_text == QString("clEnqueue"));
+    EXPECT_EQ(GP_TRACE_SEARCH_FIELD_ARGUMENT, terms[2].m_field);
+    EXPECT_TRUE(terms[2].m_text == QString("0x1000"));
+    EXPECT_EQ(GP_TRACE_SEARCH_FIELD_THREAD, terms[3].m_field);
+    EXPECT_TRUE(terms[3].m_text == QString("42"));
+    EXPECT_EQ(GP_TRACE_SEARCH_FIELD_ANY, terms[4].m_field);
+    EXPECT_TRUE(terms[4].m_text == QString("size = 8"));
+    EXPECT_EQ(GP_TRACE_SEARCH_FIELD_ARGUMENT, terms[5].m_field);
+    EXPECT_TRUE(terms[5].m_text == QString("index = 1"));
+}
+
+TEST(gpTraceSearchQuery, ParsesDurations)
+{
+    gpTraceSearchQuery query;
+    ASSERT_TRUE(ParseQuery("dur:1ms..2ms dur:>5us dur:<10 dur:3s", false, false, query));
+
+    const std::vector<gpTraceSearchTerm>& terms = query.GetTerms();
+    ASSERT_EQ(4u, terms.size());
+
+    EXPECT_EQ(GP_TRACE_SEARCH_FIELD_DURATION, terms[0].m_field);
+    EXPECT_EQ(1000000u, terms[0].m_minDuration);
+    EXPECT_EQ(2000000u, terms[0].m_maxDuration);
+
+    EXPECT_EQ(5000u, terms[1].m_minDuration);
+    EXPECT_EQ(std::numeric_limits<quint64>::max(), terms[1].m_maxDuration);
+
+    EXPECT_EQ(0u, terms[2].m_minDuration);
+    EXPECT_EQ(10u, terms[2].m_maxDuration);
+
+    // A single duration is a minimum:
+    EXPECT_EQ(3000000000u, terms[3].m_minDuration);
+    EXPECT_EQ(std::numeric_limits<quint64>::max(), terms[3].m_maxDuration);
+}
+
+TEST(gpTraceSearchQuery, RejectsInvalidTerms)
+{
+    gpTraceSearchQuery query;
+    QString errorMessage;
+
+    EXPECT_FALSE(query.Parse(QString("clFinish dur:abc"), false, false, errorMessage));
+    EXPECT_FALSE(errorMessage.isEmpty());
+    EXPECT_TRUE(query.IsEmpty());
+
+    EXPECT_FALSE(query.Parse(QString("dur:5..1"), false, false, errorMessage));
+    EXPECT_FALSE(errorMessage.isEmpty());
+
+    EXPECT_FALSE(query.Parse(QString("arg:(0x"), false, true, errorMessage));
+    EXPECT_FALSE(errorMessage.isEmpty());
+
+    // The same text is valid when it is not a regular expression:
+    EXPECT_TRUE(query.Parse(QString("arg:(0x"), false, false, errorMessage));
+    EXPECT_TRUE(errorMessage.isEmpty());
+    EXPECT_EQ(1u, query.GetTerms().size());
+}
+
+TEST(gpTraceSearchQuery, IgnoresFieldsWithoutValues)
+{
+    // Field prefixes which are not followed by a value are ignored while they are typed:
+    gpTraceSearchQuery query;
+    ASSERT_TRUE(ParseQuery("api: arg: dur: clFinish", false, false, query));
+    ASSERT_EQ(1u, query.GetTerms().size());
+    EXPECT_EQ(GP_TRACE_SEARCH_FIELD_ANY, query.GetTerms()[0].m_field);
+
+    ASSERT_TRUE(ParseQuery("   ", false, false, query));
+    EXPECT_TRUE(query.IsEmpty());
+}
+
+class gpTraceSearchTableIndexTest : public testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        m_store.AddRow("clCreateBuffer", "context = 0x1000, flags = CL_MEM_READ_ONLY, size = 256", 0, 100);
+        m_store.AddRow("clSetKernelArg", "kernel = 0x2000, index = 0, size = 8, value = 0x1000", 100, 150);
+        m_store.AddRow("clEnqueueNDRangeKernel", "queue = 0x3000, kernel = 0x2000, dim = 2", 200, 1200);
+        m_store.AddRow("clFinish", "queue = 0x3000", 1300, 5300);
+        m_store.AddRow("clSetKernelArg", "kernel = 0x2000, index = 1, size = 4, value = 0x10", 5400, 5410);
+
+        gpTraceSearchTable table;
+        table.m_pStore = &m_store;
+        table.m_threadId = 42;
+
+        std::atomic<bool> isStopRequested(false);
+        ASSERT_TRUE(m_index.Build(table, isStopRequested));
+    }
+
+    TestTraceSearchStore m_store;
+    gpTraceSearchTableIndex m_index;
+};
+
+TEST_F(gpTraceSearchTableIndexTest, FindsArgumentValuesByPrefix)
+{
+    EXPECT_EQ(std::vector<quint32>({ 0, 1, 4 }), FindRows(m_index, "arg:0x10"));
+    EXPECT_EQ(std::vector<quint32>({ 0, 1 }), FindRows(m_index, "arg:0x100"));
+    EXPECT_EQ(std::vector<quint32>({ 1, 2, 4 }), FindRows(m_index, "arg:0x2"));
+
+    // Values are matched from their start:
+    EXPECT_TRUE(FindRows(m_index, "arg:1000").empty());
+}
+
+TEST_F(gpTraceSearchTableIndexTest, FindsArgumentValuesCase)
+{
+    EXPECT_EQ(std::vector<quint32>({ 0 }), FindRows(m_index, "arg:cl_mem"));
+    EXPECT_TRUE(FindRows(m_index, "arg:cl_mem", true).empty());
+    EXPECT_EQ(std::vector<quint32>({ 0 }), FindRows(m_index, "arg:CL_MEM", true));
+}
+
+TEST_F(gpTraceSearchTableIndexTest, FindsArgumentsTextWithSeparators)
+{
+    EXPECT_EQ(std::vector<quint32>({ 4 }), FindRows(m_index, "arg:\"index = 1\""));
+    EXPECT_EQ(std::vector<quint32>({ 1, 4 }), FindRows(m_index, "arg:\"kernel = 0x2000, index\""));
+    EXPECT_EQ(std::vector<quint32>({ 1 }), FindRows(m_index, "arg:\"size = 8\""));
+    EXPECT_EQ(std::vector<quint32>({ 2, 3 }), FindRows(m_index, "arg:\"= 0x3000\""));
+
+    // The first value of the text must be a whole value:
+    EXPECT_TRUE(FindRows(m_index, "arg:\"ernel = 0x2000\"").empty());
+
+    // A text of separators only is scanned:
+    EXPECT_EQ(std::vector<quint32>({ 0, 1, 2, 4 }), FindRows(m_index, "arg:\",\""));
+}
+
+TEST_F(gpTraceSearchTableIndexTest, FindsNamesAndArguments)
+{
+    // Plain text matches the names that contain it, and the argument values that start with it:
+    EXPECT_EQ(std::vector<quint32>({ 2, 3 }), FindRows(m_index, "queue"));
+    EXPECT_EQ(std::vector<quint32>({ 3 }), FindRows(m_index, "finish"));
+    EXPECT_EQ(std::vector<quint32>({ 1, 4 }), FindRows(m_index, "api:clSetKernelArg"));
+
+    // The terms of a query are intersected:
+    EXPECT_EQ(std::vector<quint32>({ 1, 4 }), FindRows(m_index, "api:clSetKernelArg arg:0x10"));
+    EXPECT_TRUE(FindRows(m_index, "api:clFinish arg:0x2000").empty());
+}
+
+TEST_F(gpTraceSearchTableIndexTest, FindsDurationsAndThreads)
+{
+    EXPECT_EQ(std::vector<quint32>({ 2, 3 }), FindRows(m_index, "dur:>1us"));
+    EXPECT_EQ(std::vector<quint32>({ 0, 1, 4 }), FindRows(m_index, "dur:<100"));
+    EXPECT_EQ(std::vector<quint32>({ 0, 1, 2 }), FindRows(m_index, "dur:50..1000"));
+
+    EXPECT_EQ(std::vector<quint32>({ 0, 1, 2, 3, 4 }), FindRows(m_index, "thread:42"));
+    EXPECT_TRUE(FindRows(m_index, "thread:7").empty());
+    EXPECT_EQ(std::vector<quint32>({ 3 }), FindRows(m_index, "thread:42 dur:>2us"));
+}
+
+TEST_F(gpTraceSearchTableIndexTest, FindsRegularExpressions)
+{
+    EXPECT_EQ(std::vector<quint32>({ 1, 2, 3, 4 }), FindRows(m_index, "arg:^0x[23]", false, true));
+    EXPECT_EQ(std::vector<quint32>({ 1, 2, 4 }), FindRows(m_index, "api:Kernel", false, true));
+    EXPECT_TRUE(FindRows(m_index, "api:kernel", true, true).empty());
+}
+
+TEST_F(gpTraceSearchTableIndexTest, StopsSearchOfReplacedQuery)
+{
+    gpTraceSearchQuery query;
+    ASSERT_TRUE(ParseQuery("arg:0x10", false, false, query));
+
+    std::vector<quint32> rows;
+    std::atomic<unsigned int> searchGeneration(2);
+    m_index.Find(query, searchGeneration, 1, rows);
+    EXPECT_TRUE(rows.empty());
+}
+
+TEST(gpTraceSearchTableIndex, StopsBuilding)
+{
+    TestTraceSearchStore store;
+    store.AddRow("clFinish", "queue = 0x3000", 0, 10);
+
+    gpTraceSearchTable table;
+    table.m_pStore = &store;
+    table.m_threadId = 1;
+
+    gpTraceSearchTableIndex index;
+    std::atomic<bool> isStopRequested(true);
+    EXPECT_FALSE(index.Build(table, isStopRequested));
+}
+
+TEST(gpTraceSearchTableIndex, FindsPrefixesOfManyValues)
+{
+    // Enough distinct values, in both cases, for the prefix lookup to cover many adjacent values. The rows are compared
+    // against a check of each row:
+    static const quint32 amountOfRows = 1000;
+    TestTraceSearchStore store;
+    std::vector<std::string> values;
+
+    for (quint32 i = 0; i < amountOfRows; i++)
+    {
+        char value[32];
+        sprintf(value, ((i % 3) == 0) ? "0x%X" : "0x%x", i * 37);
+        values.push_back(value);
+
+        std::string arguments = std::string("handle = ") + value;
+        store.AddRow("clReleaseMemObject", arguments.c_str(), i, i + 1);
+    }
+
+    gpTraceSearchTable table;
+    table.m_pStore = &store;
+    table.m_threadId = 1;
+
+    gpTraceSearchTableIndex index;
+    std::atomic<bool> isStopRequested(false);
+    ASSERT_TRUE(index.Build(table, isStopRequested));
+
+    const char* prefixes[] = { "0x1", "0x1a", "0x1A", "0xf", "0x25", "0x", "0xabc", "0x9999" };
+
+    for (const char* prefix : prefixes)
+    {
+        for (int matchCase = 0; matchCase < 2; matchCase++)
+        {
+            std::vector<quint32> expectedRows;
+            std::string prefixText(prefix);
+
+            for (quint32 row = 0; row < amountOfRows; row++)
+            {
+                const std::string& value = values[row];
+                bool isMatch = value.size() >= prefixText.size();
+
+                for (size_t i = 0; isMatch && (i < prefixText.size()); i++)
+                {
+                    isMatch = (matchCase != 0) ? (value[i] == prefixText[i]) : (tolower(value[i]) == tolower(prefixText[i]));
+                }
+
+                if (isMatch)
+                {
+                    expectedRows.push_back(row);
+                }
+            }
+
+            std::string queryText = std::string("arg:") + prefix;
+            EXPECT_EQ(expectedRows, FindRows(index, queryText.c_str(), matchCase != 0)) << queryText << " matchCase " << matchCase;
+        }
+    }
+}
@@ -0,0 +1,385 @@
+#pragma warning(disable : 4996)
+#pragma warning(disable : 4100)
+
+
+#include <gtest/gtest.h>
+#include <HSAFunctionDefs.h>
+#include <AMDTGpuProfiling/CLAPIDefs.h>
+#include <AMDTGpuProfiling/gpTraceSummarizer.h>
+#include <AMDTGpuProfiling/gpStringConstants.h>
+
+static const quint64 s_THREAD_ID = 100;
+static const char* s_DEVICE_NAME = "Fiji";
+static const unsigned int s_CONTEXT_ID = 1;
+
+static void AddCLCall(gpTraceSummarizer& summarizer, unsigned int sequenceId, CL_FUNC_TYPE apiId, quint64 startTime, quint64 endTime, const char* argList, const char* retString, unsigned int apiType = 0)
+{
+    gpTraceIndexRecord record;
+    record.m_type = GP_TRACE_INDEX_RECORD_CL_API;
+    record.m_clApi.m_apiId = apiId;
+    record.m_clApi.m_apiType = apiType;
+    record.m_clApi.m_hasEnqueueInfo = false;
+    record.m_clApi.m_hasKernelInfo = false;
+    record.m_clApi.m_hasMemoryInfo = false;
+    record.m_clApi.m_hasDataEnqueueInfo = false;
+    record.m_clApi.m_api.m_threadId = s_THREAD_ID;
+    record.m_clApi.m_api.m_sequenceId = sequenceId;
+    record.m_clApi.m_api.m_startTime = startTime;
+    record.m_clApi.m_api.m_endTime = endTime;
+    record.m_clApi.m_api.m_argList = argList;
+    record.m_clApi.m_api.m_retString = retString;
+    summarizer.AddRecord(record);
+}
+
+static void AddCLKernel(gpTraceSummarizer& summarizer, unsigned int sequenceId, quint64 startTime, quint64 endTime, const char* kernelName, const char* localWorkSize, quint64 runningTime, quint64 completeTime)
+{
+    gpTraceIndexRecord record;
+    record.m_type = GP_TRACE_INDEX_RECORD_CL_API;
+    record.m_clApi.m_apiId = CL_FUNC_TYPE_clEnqueueNDRangeKernel;
+    record.m_clApi.m_apiType = CL_ENQUEUE_KERNEL;
+    record.m_clApi.m_hasEnqueueInfo = true;
+    record.m_clApi.m_commandTypeString = "CL_COMMAND_NDRANGE_KERNEL";
+    record.m_clApi.m_runningTime = runningTime;
+    record.m_clApi.m_completeTime = completeTime;
+    record.m_clApi.m_contextId = s_CONTEXT_ID;
+    record.m_clApi.m_deviceName = s_DEVICE_NAME;
+    record.m_clApi.m_hasKernelInfo = true;
+    record.m_clApi.m_kernelName = kernelName;
+    record.m_clApi.m_globalWorkSize = "{1024,1,1}";
+    record.m_clApi.m_localWorkSize = localWorkSize;
+    record.m_clApi.m_hasMemoryInfo = false;
+    record.m_clApi.m_hasDataEnqueueInfo = false;
+    record.m_clApi.m_api.m_threadId = s_THREAD_ID;
+    record.m_clApi.m_api.m_sequenceId = sequenceId;
+    record.m_clApi.m_api.m_startTime = startTime;
+    record.m_clApi.m_api.m_endTime = endTime;
+    record.m_clApi.m_api.m_argList = "0x100;0x400;1;NULL;{1024,1,1};NULL;0;NULL;NULL";
+    record.m_clApi.m_api.m_retString = "CL_SUCCESS";
+    summarizer.AddRecord(record);
+}
+
+static void AddCLTransfer(gpTraceSummarizer& summarizer, unsigned int sequenceId, CL_FUNC_TYPE apiId, quint64 startTime, quint64 endTime, const char* argList, quint64 size, quint64 runningTime, quint64 completeTime)
+{
+    gpTraceIndexRecord record;
+    record.m_type = GP_TRACE_INDEX_RECORD_CL_API;
+    record.m_clApi.m_apiId = apiId;
+    record.m_clApi.m_apiType = CL_ENQUEUE_MEM;
+    record.m_clApi.m_hasEnqueueInfo = true;
+    record.m_clApi.m_commandTypeString = (CL_FUNC_TYPE_clEnqueueReadBuffer == apiId) ? "CL_COMMAND_READ_BUFFER" : "CL_COMMAND_WRITE_BUFFER";
+    record.m_clApi.m_runningTime = runningTime;
+    record.m_clApi.m_completeTime = completeTime;
+    record.m_clApi.m_contextId = s_CONTEXT_ID;
+    record.m_clApi.m_deviceName = s_DEVICE_NAME;
+    record.m_clApi.m_hasKernelInfo = false;
+    record.m_clApi.m_hasMemoryInfo = true;
+    record.m_clApi.m_memoryTransferSize = size;
+    record.m_clApi.m_hasDataEnqueueInfo = false;
+    record.m_clApi.m_api.m_threadId = s_THREAD_ID;
+    record.m_clApi.m_api.m_sequenceId = sequenceId;
+    record.m_clApi.m_api.m_startTime = startTime;
+    record.m_clApi.m_api.m_endTime = endTime;
+    record.m_clApi.m_api.m_argList = argList;
+    record.m_clApi.m_api.m_retString = "CL_SUCCESS";
+    summarizer.AddRecord(record);
+}
+
+static const gpTraceSummaryRow* FindRow(const gpTraceSummaryPage& page, const char* firstCellText)
+{
+    const gpTraceSummaryRow* pRetVal = nullptr;
+
+    for (const gpTraceSummaryRow& row : page.m_rows)
+    {
+        if (row.m_cells[0].toString() == QString(firstCellText))
+        {
+            pRetVal = &row;
+            break;
+        }
+    }
+
+    return pRetVal;
+}
+
+static void ExpectMessage(const gpTraceSummaryPage& page, size_t rowIndex, const char* type, unsigned int sequenceId, const char* apiName, const char* messagePart)
+{
+    ASSERT_LT(rowIndex, page.m_rows.size());
+
+    const gpTraceSummaryRow& row = page.m_rows[rowIndex];
+    EXPECT_TRUE(row.m_cells[0].toString() == QString(type)) << "row " << rowIndex;
+    EXPECT_EQ(s_THREAD_ID, row.m_cells[1].toULongLong()) << "row " << rowIndex;
+    EXPECT_EQ(sequenceId, row.m_cells[2].toULongLong()) << "row " << rowIndex;
+    EXPECT_TRUE(row.m_cells[3].toString() == QString(apiName)) << "row " << rowIndex;
+    EXPECT_TRUE(row.m_cells[4].toString().contains(QString(messagePart))) << "row " << rowIndex << ": " << row.m_cells[4].toString().toStdString();
+    EXPECT_EQ(s_THREAD_ID, row.m_threadId) << "row " << rowIndex;
+    EXPECT_EQ(sequenceId, row.m_sequenceId) << "row " << rowIndex;
+    EXPECT_EQ(AnalyzerHTMLViewType_Trace, row.m_linkViewType) << "row " << rowIndex;
+}
+
+class gpTraceSummarizerTest : public testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        // A command queue, and two buffers. The first buffer is in host-visible device memory, and is never released:
+        AddCLCall(m_summarizer, 0, CL_FUNC_TYPE_clCreateCommandQueue, 0, 10, "0x10;0x20;0;CL_SUCCESS", "0x100");
+        AddCLCall(m_summarizer, 1, CL_FUNC_TYPE_clCreateBuffer, 10, 20, "0x10;CL_MEM_READ_WRITE|CL_MEM_USE_PERSISTENT_MEM_AMD;8192;NULL;CL_SUCCESS", "0x200");
+        AddCLCall(m_summarizer, 2, CL_FUNC_TYPE_clCreateBuffer, 20, 30, "0x10;CL_MEM_READ_ONLY;64;NULL;CL_SUCCESS", "0x300");
+
+        // A small blocking write, followed by a clFinish of the idle queue:
+        AddCLTransfer(m_summarizer, 3, CL_FUNC_TYPE_clEnqueueWriteBuffer, 30, 50, "0x100;0x300;CL_TRUE;0;64;0x5000;0;NULL;NULL", 64, 40, 45);
+        AddCLCall(m_summarizer, 4, CL_FUNC_TYPE_clFinish, 50, 55, "0x100", "CL_SUCCESS");
+
+        // Three dispatches: one with a work-group size which is not a multiple of the wavefront size, and one with a work-group
+        // size chosen by the runtime, and a clFinish which waits for them:
+        AddCLKernel(m_summarizer, 5, 60, 70, "vecAdd", "{60,1,1}", 100, 400);
+        AddCLKernel(m_summarizer, 6, 70, 80, "vecAdd", "NULL", 400, 500);
+        AddCLKernel(m_summarizer, 7, 80, 90, "reduce", "{64,1,1}", 500, 1500);
+        AddCLCall(m_summarizer, 8, CL_FUNC_TYPE_clFinish, 90, 1500, "0x100", "CL_SUCCESS");
+
+        // A read back of the host-visible device memory, a deprecated API and a failed API:
+        AddCLTransfer(m_summarizer, 9, CL_FUNC_TYPE_clEnqueueReadBuffer, 1500, 1510, "0x100;0x200;CL_FALSE;0;8192;0x6000;0;NULL;NULL", 8192, 1600, 1700);
+        AddCLCall(m_summarizer, 10, CL_FUNC_TYPE_clEnqueueMarker, 1510, 1520, "0x100;0x7000", "CL_SUCCESS", CL_ENQUEUE_BASE_API);
+        AddCLCall(m_summarizer, 11, CL_FUNC_TYPE_clSetKernelArg, 1520, 1525, "0x400;7;4;0x8000", "CL_INVALID_ARG_INDEX");
+
+        // The second buffer and the queue are released. The queue is retained once, so it is released twice:
+        AddCLCall(m_summarizer, 12, CL_FUNC_TYPE_clReleaseMemObject, 1530, 1535, "0x300", "CL_SUCCESS");
+        AddCLCall(m_summarizer, 13, CL_FUNC_TYPE_clRetainCommandQueue, 1535, 1540, "0x100", "CL_SUCCESS");
+        AddCLCall(m_summarizer, 14, CL_FUNC_TYPE_clReleaseCommandQueue, 1540, 1545, "0x100", "CL_SUCCESS");
+        AddCLCall(m_summarizer, 15, CL_FUNC_TYPE_clReleaseCommandQueue, 1545, 1550, "0x100", "CL_SUCCESS");
+
+        // An object which was not created by the trace calls is not tracked:
+        AddCLCall(m_summarizer, 16, CL_FUNC_TYPE_clReleaseMemObject, 1550, 1560, "0x999", "CL_SUCCESS");
+    }
+
+    gpTraceSummarizer m_summarizer;
+};
+
+TEST_F(gpTraceSummarizerTest, SummarizesAPIs)
+{
+    ASSERT_FALSE(m_summarizer.IsEmpty());
+    EXPECT_FALSE(m_summarizer.IsHSA());
+    EXPECT_EQ(0u, m_summarizer.GetStartTime());
+    EXPECT_EQ(1700u, m_summarizer.GetEndTime());
+
+    gpTraceSummary summary;
+    m_summarizer.Summarize(m_summarizer.GetStartTime(), m_summarizer.GetEndTime(), summary);
+
+    const gpTraceSummaryPage& page = summary.m_pages[GP_TRACE_SUMMARY_PAGE_API];
+    EXPECT_EQ(GP_TRACE_SUMMARY_PAGE_API, page.m_type);
+    ASSERT_EQ(7, page.m_columnNames.size());
+    EXPECT_EQ(11u, page.m_rows.size());
+
+    // API name, calls, total, % of time, average, max and min times:
+    const gpTraceSummaryRow* pFinishRow = FindRow(page, "clFinish");
+    ASSERT_TRUE(pFinishRow != nullptr);
+    EXPECT_EQ(2u, pFinishRow->m_cells[1].toULongLong());
+    EXPECT_DOUBLE_EQ(0.001415, pFinishRow->m_cells[2].toDouble());
+    EXPECT_DOUBLE_EQ(100.0 * 1415 / 1550, pFinishRow->m_cells[3].toDouble());
+    EXPECT_DOUBLE_EQ(0.000707, pFinishRow->m_cells[4].toDouble());
+    EXPECT_DOUBLE_EQ(0.00141, pFinishRow->m_cells[5].toDouble());
+    EXPECT_DOUBLE_EQ(0.000005, pFinishRow->m_cells[6].toDouble());
+
+    const gpTraceSummaryRow* pKernelRow = FindRow(page, "clEnqueueNDRangeKernel");
+    ASSERT_TRUE(pKernelRow != nullptr);
+    EXPECT_EQ(3u, pKernelRow->m_cells[1].toULongLong());
+    EXPECT_DOUBLE_EQ(0.00003, pKernelRow->m_cells[2].toDouble());
+
+    const gpTraceSummaryRow* pReleaseQueueRow = FindRow(page, "clReleaseCommandQueue");
+    ASSERT_TRUE(pReleaseQueueRow != nullptr);
+    EXPECT_EQ(2u, pReleaseQueueRow->m_cells[1].toULongLong());
+}
+
+TEST_F(gpTraceSummarizerTest, SummarizesKernelsAndContexts)
+{
+    gpTraceSummary summary;
+    m_summarizer.Summarize(m_summarizer.GetStartTime(), m_summarizer.GetEndTime(), summary);
+
+    // The kernels, by total time:
+    const gpTraceSummaryPage& kernelPage = summary.m_pages[GP_TRACE_SUMMARY_PAGE_KERNEL];
+    ASSERT_EQ(8, kernelPage.m_columnNames.size());
+    ASSERT_EQ(2u, kernelPage.m_rows.size());
+
+    const QVariantList& reduceCells = kernelPage.m_rows[0].m_cells;
+    EXPECT_TRUE(reduceCells[0].toString() == QString("reduce"));
+    EXPECT_TRUE(reduceCells[1].toString() == QString(s_DEVICE_NAME));
+    EXPECT_EQ(1u, reduceCells[2].toULongLong());
+    EXPECT_DOUBLE_EQ(0.001, reduceCells[3].toDouble());
+    EXPECT_DOUBLE_EQ(100.0 * 1000 / 1400, reduceCells[4].toDouble());
+
+    const QVariantList& vecAddCells = kernelPage.m_rows[1].m_cells;
+    EXPECT_TRUE(vecAddCells[0].toString() == QString("vecAdd"));
+    EXPECT_EQ(2u, vecAddCells[2].toULongLong());
+    EXPECT_DOUBLE_EQ(0.0004, vecAddCells[3].toDouble());
+    EXPECT_DOUBLE_EQ(0.0002, vecAddCells[5].toDouble());
+    EXPECT_DOUBLE_EQ(0.0003, vecAddCells[6].toDouble());
+    EXPECT_DOUBLE_EQ(0.0001, vecAddCells[7].toDouble());
+
+    // The context, with its dispatches and transfers:
+    const gpTraceSummaryPage& contextPage = summary.m_pages[GP_TRACE_SUMMARY_PAGE_CONTEXT];
+    ASSERT_EQ(1u, contextPage.m_rows.size());
+
+    const QVariantList& contextCells = contextPage.m_rows[0].m_cells;
+    EXPECT_EQ(s_CONTEXT_ID, contextCells[0].toULongLong());
+    EXPECT_TRUE(contextCells[1].toString() == QString(s_DEVICE_NAME));
+    EXPECT_EQ(3u, contextCells[2].toULongLong());
+    EXPECT_DOUBLE_EQ(0.0014, contextCells[3].toDouble());
+    EXPECT_EQ(2u, contextCells[4].toULongLong());
+    EXPECT_DOUBLE_EQ(0.000105, contextCells[5].toDouble());
+    EXPECT_DOUBLE_EQ((64 + 8192) / 1024.0, contextCells[6].toDouble());
+    EXPECT_EQ(0u, contextCells[7].toULongLong());
+}
+
+TEST_F(gpTraceSummarizerTest, SummarizesTopCommands)
+{
+    gpTraceSummary summary;
+    m_summarizer.Summarize(m_summarizer.GetStartTime(), m_summarizer.GetEndTime(), summary);
+
+    // The dispatches, longest first, linked to their enqueue calls:
+    const gpTraceSummaryPage& topKernelsPage = summary.m_pages[GP_TRACE_SUMMARY_PAGE_TOP_KERNELS];
+    ASSERT_EQ(3u, topKernelsPage.m_rows.size());
+
+    const unsigned int expectedKernelSequenceIds[] = { 7, 5, 6 };
+    const double expectedKernelTimes[] = { 0.001, 0.0003, 0.0001 };
+
+    for (size_t i = 0; i < topKernelsPage.m_rows.size(); i++)
+    {
+        const gpTraceSummaryRow& row = topKernelsPage.m_rows[i];
+        EXPECT_EQ(expectedKernelSequenceIds[i], row.m_sequenceId) << "row " << i;
+        EXPECT_EQ(s_THREAD_ID, row.m_threadId) << "row " << i;
+        EXPECT_EQ(AnalyzerHTMLViewType_TimelineDevice, row.m_linkViewType) << "row " << i;
+        EXPECT_EQ(expectedKernelSequenceIds[i], row.m_cells[3].toULongLong()) << "row " << i;
+        EXPECT_TRUE(row.m_cells[4].toString() == QString("{1024,1,1}")) << "row " << i;
+        EXPECT_DOUBLE_EQ(expectedKernelTimes[i], row.m_cells[6].toDouble()) << "row " << i;
+    }
+
+    // The transfers, longest first, with their size in KB and rate in GB/s:
+    const gpTraceSummaryPage& topTransfersPage = summary.m_pages[GP_TRACE_SUMMARY_PAGE_TOP_DATA_TRANSFERS];
+    ASSERT_EQ(2u, topTransfersPage.m_rows.size());
+
+    const QVariantList& readCells = topTransfersPage.m_rows[0].m_cells;
+    EXPECT_EQ(9u, topTransfersPage.m_rows[0].m_sequenceId);
+    EXPECT_TRUE(readCells[0].toString() == QString("CL_COMMAND_READ_BUFFER"));
+    EXPECT_DOUBLE_EQ(8.0, readCells[4].toDouble());
+    EXPECT_DOUBLE_EQ(0.0001, readCells[5].toDouble());
+    EXPECT_DOUBLE_EQ(81.92, readCells[6].toDouble());
+
+    EXPECT_EQ(3u, topTransfersPage.m_rows[1].m_sequenceId);
+}
+
+TEST_F(gpTraceSummarizerTest, SummarizesBestPractices)
+{
+    gpTraceSummary summary;
+    m_summarizer.Summarize(m_summarizer.GetStartTime(), m_summarizer.GetEndTime(), summary);
+
+    // The messages about the calls, in call order, followed by the leaked objects:
+    const gpTraceSummaryPage& page = summary.m_pages[GP_TRACE_SUMMARY_PAGE_BEST_PRACTICES];
+    ASSERT_EQ(5, page.m_columnNames.size());
+    ASSERT_EQ(9u, page.m_rows.size());
+
+    ExpectMessage(page, 0, GPU_STR_TraceSummaryWarning, 3, "clEnqueueWriteBuffer", "blocks the host");
+    ExpectMessage(page, 1, GPU_STR_TraceSummaryWarning, 3, "clEnqueueWriteBuffer", "transfers only 64 bytes");
+    ExpectMessage(page, 2, GPU_STR_TraceSummaryWarning, 4, "clFinish", "command queue 0x100");
+    ExpectMessage(page, 3, GPU_STR_TraceSummaryWarning, 5, "clEnqueueNDRangeKernel", "kernel vecAdd (60)");
+    ExpectMessage(page, 4, GPU_STR_TraceSummaryWarning, 6, "clEnqueueNDRangeKernel", "chosen by the runtime");
+    ExpectMessage(page, 5, GPU_STR_TraceSummaryWarning, 9, "clEnqueueReadBuffer", "reads buffer 0x200");
+    ExpectMessage(page, 6, GPU_STR_TraceSummaryWarning, 10, "clEnqueueMarker", "deprecated");
+    ExpectMessage(page, 7, GPU_STR_TraceSummaryError, 11, "clSetKernelArg", "CL_INVALID_ARG_INDEX");
+    ExpectMessage(page, 8, GPU_STR_TraceSummaryWarning, 1, "clCreateBuffer", "0x200 created by clCreateBuffer is never released");
+}
+
+TEST_F(gpTraceSummarizerTest, SummarizesSelectedRange)
+{
+    // The calls which overlap the range, and the commands which run in it:
+    gpTraceSummary summary;
+    m_summarizer.Summarize(0, 55, summary);
+
+    EXPECT_EQ(0u, summary.m_startTime);
+    EXPECT_EQ(55u, summary.m_endTime);
+    EXPECT_EQ(4u, summary.m_pages[GP_TRACE_SUMMARY_PAGE_API].m_rows.size());
+    EXPECT_TRUE(FindRow(summary.m_pages[GP_TRACE_SUMMARY_PAGE_API], "clEnqueueNDRangeKernel") == nullptr);
+    EXPECT_TRUE(summary.m_pages[GP_TRACE_SUMMARY_PAGE_KERNEL].m_rows.empty());
+    EXPECT_TRUE(summary.m_pages[GP_TRACE_SUMMARY_PAGE_TOP_KERNELS].m_rows.empty());
+    ASSERT_EQ(1u, summary.m_pages[GP_TRACE_SUMMARY_PAGE_TOP_DATA_TRANSFERS].m_rows.size());
+    EXPECT_EQ(3u, summary.m_pages[GP_TRACE_SUMMARY_PAGE_TOP_DATA_TRANSFERS].m_rows[0].m_sequenceId);
+
+    // A leaked object is reported with the range of the call which created it:
+    const gpTraceSummaryPage& page = summary.m_pages[GP_TRACE_SUMMARY_PAGE_BEST_PRACTICES];
+    ASSERT_EQ(4u, page.m_rows.size());
+    ExpectMessage(page, 0, GPU_STR_TraceSummaryWarning, 3, "clEnqueueWriteBuffer", "blocks the host");
+    ExpectMessage(page, 1, GPU_STR_TraceSummaryWarning, 3, "clEnqueueWriteBuffer", "transfers only 64 bytes");
+    ExpectMessage(page, 2, GPU_STR_TraceSummaryWarning, 4, "clFinish", "command queue 0x100");
+    ExpectMessage(page, 3, GPU_STR_TraceSummaryWarning, 1, "clCreateBuffer", "never released");
+}
+
+TEST(gpTraceSummarizer, KeepsLongestTopCommands)
+{
+    // More dispatches than the top kernels rows, with durations that are not ordered:
+    static const unsigned int amountOfKernels = 3 * gpTraceSummarizer::ms_TOP_ROWS_COUNT;
+    gpTraceSummarizer summarizer;
+
+    for (unsigned int i = 0; i < amountOfKernels; i++)
+    {
+        quint64 duration = 100 + ((i * 7) % amountOfKernels) * 10;
+        AddCLKernel(summarizer, i, i * 10, i * 10 + 5, "vecAdd", "{64,1,1}", 10000 + i * 1000, 10000 + i * 1000 + duration);
+    }
+
+    gpTraceSummary summary;
+    summarizer.Summarize(summarizer.GetStartTime(), summarizer.GetEndTime(), summary);
+
+    const gpTraceSummaryPage& topKernelsPage = summary.m_pages[GP_TRACE_SUMMARY_PAGE_TOP_KERNELS];
+    ASSERT_EQ(gpTraceSummarizer::ms_TOP_ROWS_COUNT, topKernelsPage.m_rows.size());
+
+    for (unsigned int i = 0; i < gpTraceSummarizer::ms_TOP_ROWS_COUNT; i++)
+    {
+        quint64 expectedDuration = 100 + (amountOfKernels - 1 - i) * 10;
+        EXPECT_DOUBLE_EQ(expectedDuration / 1000000.0, topKernelsPage.m_rows[i].m_cells[6].toDouble()) << "row " << i;
+    }
+
+    ASSERT_EQ(1u, summary.m_pages[GP_TRACE_SUMMARY_PAGE_KERNEL].m_rows.size());
+    EXPECT_EQ(amountOfKernels, summary.m_pages[GP_TRACE_SUMMARY_PAGE_KERNEL].m_rows[0].m_cells[2].toULongLong());
+    EXPECT_TRUE(summary.m_pages[GP_TRACE_SUMMARY_PAGE_BEST_PRACTICES].m_rows.empty());
+}
+
+TEST(gpTraceSummarizer, SummarizesHSADispatchesByQueue)
+{
+    gpTraceSummarizer summarizer;
+
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        gpTraceIndexRecord record;
+        record.m_type = GP_TRACE_INDEX_RECORD_HSA_API;
+        record.m_hsaApi.m_apiId = HSA_API_Type_Non_API_Dispatch;
+        record.m_hsaApi.m_isApi = false;
+        record.m_hsaApi.m_hasDispatchInfo = true;
+        record.m_hsaApi.m_kernelName = "copy";
+        record.m_hsaApi.m_deviceName = s_DEVICE_NAME;
+        record.m_hsaApi.m_queueIndex = i % 2;
+        record.m_hsaApi.m_globalWorkSize = "{256,1,1}";
+        record.m_hsaApi.m_localWorkSize = "{64,1,1}";
+        record.m_hsaApi.m_api.m_threadId = s_THREAD_ID;
+        record.m_hsaApi.m_api.m_sequenceId = i;
+        record.m_hsaApi.m_api.m_startTime = i * 100;
+        record.m_hsaApi.m_api.m_endTime = i * 100 + 50;
+        summarizer.AddRecord(record);
+    }
+
+    ASSERT_FALSE(summarizer.IsEmpty());
+    EXPECT_TRUE(summarizer.IsHSA());
+
+    gpTraceSummary summary;
+    summarizer.Summarize(summarizer.GetStartTime(), summarizer.GetEndTime(), summary);
+
+    EXPECT_TRUE(summary.m_pages[GP_TRACE_SUMMARY_PAGE_API].m_rows.empty());
+
+    const gpTraceSummaryPage& contextPage = summary.m_pages[GP_TRACE_SUMMARY_PAGE_CONTEXT];
+    ASSERT_EQ(2u, contextPage.m_rows.size());
+    EXPECT_TRUE(contextPage.m_columnNames[0] == QString(GPU_STR_TraceSummaryColumnQueue));
+    EXPECT_EQ(0u, contextPage.m_rows[0].m_cells[0].toULongLong());
+    EXPECT_EQ(2u, contextPage.m_rows[0].m_cells[2].toULongLong());
+    EXPECT_EQ(1u, contextPage.m_rows[1].m_cells[0].toULongLong());
+    EXPECT_EQ(1u, contextPage.m_rows[1].m_cells[2].toULongLong());
+
+    // HSA dispatches have no host API:
+    const gpTraceSummaryPage& topKernelsPage = summary.m_pages[GP_TRACE_SUMMARY_PAGE_TOP_KERNELS];
+    ASSERT_EQ(3u, topKernelsPage.m_rows.size());
+    EXPECT_EQ(AnalyzerHTMLViewType_TimelineDeviceNoAPI, topKernelsPage.m_rows[0].m_linkViewType);
+}
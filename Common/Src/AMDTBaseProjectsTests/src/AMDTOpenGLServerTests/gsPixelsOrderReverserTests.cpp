@@ -0,0 +1,119 @@
+#pragma warning(disable : 4996)
+#pragma warning(disable : 4100)
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <gtest/gtest.h>
+#include <src/gsPixelsOrderReverser.h>
+
+// The pixel sizes of the texel formats (1 to 16 bytes), and a size that has no dedicated implementation:
+static const size_t s_pixelSizes[] = { 1, 2, 3, 4, 5, 6, 8, 12, 16 };
+
+// Odd and even page widths, around the SSE2 and AVX2 vector sizes:
+static const size_t s_amountsOfPixels[] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 255, 1023 };
+
+static void FillRandomPixels(std::vector<gtByte>& pixels, size_t size)
+{
+    pixels.resize(size);
+
+    for (size_t i = 0; i < size; i++)
+    {
+        pixels[i] = (gtByte)(rand() & 0xFF);
+    }
+}
+
+// Reverses the pixels by copying them one by one into a second buffer, as mirrorFlipTexture used to:
+static std::vector<gtByte> CopyReversedPixels(const gtByte* pPixels, size_t amountOfPixels, size_t pixelSize)
+{
+    std::vector<gtByte> reversedPixels(amountOfPixels * pixelSize);
+
+    for (size_t i = 0; i < amountOfPixels; i++)
+    {
+        memcpy(&reversedPixels[i * pixelSize], pPixels + ((amountOfPixels - 1 - i) * pixelSize), pixelSize);
+    }
+
+    return reversedPixels;
+}
+
+// Checks an implementation against the copy loop, on a buffer starting at an unaligned offset:
+static void CheckImplementation(gsPixelsOrderReverser::Implementation implementation)
+{
+    srand(1);
+
+    for (size_t sizeIndex = 0; sizeIndex < sizeof(s_pixelSizes) / sizeof(s_pixelSizes[0]); sizeIndex++)
+    {
+        for (size_t amountIndex = 0; amountIndex < sizeof(s_amountsOfPixels) / sizeof(s_amountsOfPixels[0]); amountIndex++)
+        {
+            const size_t pixelSize = s_pixelSizes[sizeIndex];
+            const size_t amountOfPixels = s_amountsOfPixels[amountIndex];
+            const size_t offset = 1;
+
+            std::vector<gtByte> buffer;
+            FillRandomPixels(buffer, offset + (amountOfPixels * pixelSize) + 1);
+            std::vector<gtByte> originalBuffer = buffer;
+            std::vector<gtByte> expectedPixels = CopyReversedPixels(&originalBuffer[offset], amountOfPixels, pixelSize);
+
+            ASSERT_TRUE(gsPixelsOrderReverser::reversePixelsOrder(&buffer[offset], amountOfPixels, pixelSize, implementation));
+
+            // The pixels are reversed, and the bytes around them are untouched:
+            EXPECT_EQ(originalBuffer[0], buffer[0]);
+            EXPECT_EQ(originalBuffer[buffer.size() - 1], buffer[buffer.size() - 1]);
+            EXPECT_TRUE(std::equal(expectedPixels.begin(), expectedPixels.end(), buffer.begin() + offset)) << "pixel size " << pixelSize << ", " << amountOfPixels << " pixels";
+        }
+    }
+}
+
+TEST(gsPixelsOrderReverser, ScalarMatchesCopyLoop)
+{
+    CheckImplementation(gsPixelsOrderReverser::GS_PIXELS_REVERSAL_SCALAR);
+}
+
+TEST(gsPixelsOrderReverser, SSE2MatchesCopyLoop)
+{
+    if (gsPixelsOrderReverser::isImplementationAvailable(gsPixelsOrderReverser::GS_PIXELS_REVERSAL_SSE2))
+    {
+        CheckImplementation(gsPixelsOrderReverser::GS_PIXELS_REVERSAL_SSE2);
+    }
+}
+
+TEST(gsPixelsOrderReverser, AVX2MatchesCopyLoop)
+{
+    if (gsPixelsOrderReverser::isImplementationAvailable(gsPixelsOrderReverser::GS_PIXELS_REVERSAL_AVX2))
+    {
+        CheckImplementation(gsPixelsOrderReverser::GS_PIXELS_REVERSAL_AVX2);
+    }
+}
+
+TEST(gsPixelsOrderReverser, VectorImplementationsMatchScalarOnPages)
+{
+    static const gsPixelsOrderReverser::Implementation implementations[] = { gsPixelsOrderReverser::GS_PIXELS_REVERSAL_SSE2, gsPixelsOrderReverser::GS_PIXELS_REVERSAL_AVX2 };
+    const size_t pageHeight = 37;
+
+    srand(2);
+
+    // Whole pages of odd and even widths, for the pixel sizes that have vector implementations:
+    for (size_t width = 61; width <= 64; width++)
+    {
+        for (size_t pixelSize = 4; pixelSize <= 8; pixelSize += 4)
+        {
+            const size_t amountOfPixels = width * pageHeight;
+            std::vector<gtByte> originalPixels;
+            FillRandomPixels(originalPixels, amountOfPixels * pixelSize);
+
+            std::vector<gtByte> scalarPixels = originalPixels;
+            ASSERT_TRUE(gsPixelsOrderReverser::reversePixelsOrder(&scalarPixels[0], amountOfPixels, pixelSize, gsPixelsOrderReverser::GS_PIXELS_REVERSAL_SCALAR));
+
+            for (size_t i = 0; i < sizeof(implementations) / sizeof(implementations[0]); i++)
+            {
+                std::vector<gtByte> vectorPixels = originalPixels;
+
+                if (gsPixelsOrderReverser::reversePixelsOrder(&vectorPixels[0], amountOfPixels, pixelSize, implementations[i]))
+                {
+                    EXPECT_TRUE(vectorPixels == scalarPixels) << "width " << width << ", pixel size " << pixelSize;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,316 @@
+#pragma warning(disable : 4996)
+#pragma warning(disable : 4100)
+
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <AMDTOSWrappers/Include/osChannel.h>
+#include <AMDTOSWrappers/Include/osFile.h>
+#include <AMDTOSWrappers/Include/osFilePath.h>
+#include <AMDTRemoteAgent/Public Include/dmnFileTransfer.h>
+
+// One direction of an in-memory connection. Once the pipe is closed, the data that was already written
+// can still be read, and then every read fails - like a dropped TCP connection.
+class dmnTestPipe
+{
+public:
+    bool Write(const gtByte* pData, size_t dataSize)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        bool ret = !m_isClosed;
+
+        if (ret)
+        {
+            // Drop the connection in the middle of the data once the drop offset is reached.
+            size_t writtenSize = dataSize;
+
+            if (m_writtenSize + dataSize > m_dropOffset)
+            {
+                writtenSize = m_dropOffset - m_writtenSize;
+                m_isClosed = true;
+                ret = false;
+            }
+
+            for (size_t i = 0; i < writtenSize; i++)
+            {
+                // Corrupt a single byte in the data, without breaking the connection.
+                gtByte byte = pData[i];
+
+                if (m_writtenSize + i == m_corruptOffset)
+                {
+                    byte = static_cast<gtByte>(~byte);
+                }
+
+                m_data.push_back(byte);
+            }
+
+            m_writtenSize += writtenSize;
+        }
+
+        m_condition.notify_all();
+        return ret;
+    }
+
+    bool Read(gtByte* pData, size_t dataSize)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [&]() { return (dataSize <= m_data.size()) || m_isClosed; });
+        bool ret = (dataSize <= m_data.size());
+
+        if (ret)
+        {
+            std::copy(m_data.begin(), m_data.begin() + dataSize, pData);
+            m_data.erase(m_data.begin(), m_data.begin() + dataSize);
+        }
+
+        return ret;
+    }
+
+    void Close()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isClosed = true;
+        m_condition.notify_all();
+    }
+
+    size_t WrittenSize()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_writtenSize;
+    }
+
+    size_t m_dropOffset = SIZE_MAX;
+    size_t m_corruptOffset = SIZE_MAX;
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<gtByte> m_data;
+    size_t m_writtenSize = 0;
+    bool m_isClosed = false;
+};
+
+// One end of an in-memory connection.
+class dmnTestChannel : public osChannel
+{
+public:
+    dmnTestChannel(dmnTestPipe& readPipe, dmnTestPipe& writePipe) : m_readPipe(readPipe), m_writePipe(writePipe) {}
+
+    virtual osChannelType channelType() const { return OS_BINARY_CHANNEL; }
+
+    virtual bool write(const gtByte* pDataBuffer, gtSize_t dataSize)
+    {
+        bool ret = m_writePipe.Write(pDataBuffer, dataSize);
+
+        if (!ret)
+        {
+            // A dropped connection is dropped in both directions.
+            m_readPipe.Close();
+        }
+
+        return ret;
+    }
+
+    virtual bool read(gtByte* pDataBuffer, gtSize_t dataSize) { return m_readPipe.Read(pDataBuffer, dataSize); }
+
+private:
+    dmnTestPipe& m_readPipe;
+    dmnTestPipe& m_writePipe;
+};
+
+// The sizes of the data which precedes the chunks, and of the header of each chunk:
+static const size_t s_transferHeaderSize = sizeof(gtInt32) + 3 * sizeof(gtUInt64);
+static const size_t s_chunkHeaderSize = 3 * sizeof(gtUInt32);
+
+static osFilePath MakeTestFilePath(const wchar_t* fileName)
+{
+    osFilePath filePath(osFilePath::OS_TEMP_DIRECTORY);
+    filePath.setFileName(fileName);
+    filePath.setFileExtension(L"bin");
+    return filePath;
+}
+
+static void DeleteTestFile(const osFilePath& filePath)
+{
+    if (filePath.exists())
+    {
+        osFile file(filePath);
+        file.deleteFile();
+    }
+}
+
+static osFilePath PartialFilePath(const osFilePath& targetFilePath, const gtString& suffix)
+{
+    gtString partialFilePathStr = targetFilePath.asString();
+    partialFilePathStr.append(suffix);
+    return osFilePath(partialFilePathStr);
+}
+
+static std::vector<gtByte> ReadTestFile(const osFilePath& filePath)
+{
+    std::ifstream file(filePath.asString().asASCIICharArray(), std::ios::binary);
+    return std::vector<gtByte>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Writes a file which does not compress, so that the chunks are sent as-is and their offsets in the connection are known.
+static std::vector<gtByte> WriteTestFile(const osFilePath& filePath, size_t fileSize)
+{
+    std::vector<gtByte> data(fileSize);
+    unsigned int seed = 12345;
+
+    for (gtByte& byte : data)
+    {
+        seed = seed * 1103515245 + 12345;
+        byte = static_cast<gtByte>(seed >> 16);
+    }
+
+    std::ofstream file(filePath.asString().asASCIICharArray(), std::ios::binary | std::ios::trunc);
+    file.write(&data[0], data.size());
+    return data;
+}
+
+class dmnFileTransferTest : public ::testing::Test
+{
+protected:
+    dmnFileTransferTest() :
+        m_sourceFilePath(MakeTestFilePath(L"dmnFileTransferTestsSource")),
+        m_targetFilePath(MakeTestFilePath(L"dmnFileTransferTestsTarget"))
+    {
+    }
+
+    virtual void SetUp() { DeleteTestFiles(); }
+    virtual void TearDown() { DeleteTestFiles(); }
+
+    void DeleteTestFiles()
+    {
+        DeleteTestFile(m_sourceFilePath);
+        DeleteTestFile(m_targetFilePath);
+        DeleteTestFile(PartialFilePath(m_targetFilePath, DMN_PARTIAL_FILE_SUFFIX));
+        DeleteTestFile(PartialFilePath(m_targetFilePath, DMN_PARTIAL_FILE_INFO_SUFFIX));
+    }
+
+    // Sends the source file from another thread, and receives it into the target file.
+    void TransferFile(dmnTestPipe& senderPipe, dmnTestPipe& receiverPipe, bool& isSent, bool& isReceived)
+    {
+        dmnTestChannel senderChannel(receiverPipe, senderPipe);
+        dmnTestChannel receiverChannel(senderPipe, receiverPipe);
+
+        std::thread senderThread([&]() { isSent = dmnFileTransfer::SendFile(senderChannel, m_sourceFilePath); });
+        isReceived = dmnFileTransfer::ReceiveFile(receiverChannel, m_targetFilePath);
+        senderThread.join();
+    }
+
+    osFilePath m_sourceFilePath;
+    osFilePath m_targetFilePath;
+};
+
+TEST_F(dmnFileTransferTest, ReceiveFileMatchesSentFile)
+{
+    std::vector<gtByte> sourceData = WriteTestFile(m_sourceFilePath, 2 * DMN_FILE_TRANSFER_CHUNK_SIZE + 1000);
+
+    dmnTestPipe senderPipe;
+    dmnTestPipe receiverPipe;
+    bool isSent = false;
+    bool isReceived = false;
+    TransferFile(senderPipe, receiverPipe, isSent, isReceived);
+
+    EXPECT_TRUE(isSent);
+    EXPECT_TRUE(isReceived);
+    EXPECT_TRUE(sourceData == ReadTestFile(m_targetFilePath));
+    EXPECT_FALSE(PartialFilePath(m_targetFilePath, DMN_PARTIAL_FILE_SUFFIX).exists());
+    EXPECT_FALSE(PartialFilePath(m_targetFilePath, DMN_PARTIAL_FILE_INFO_SUFFIX).exists());
+}
+
+TEST_F(dmnFileTransferTest, ReceiveFileResumesAfterDroppedChunk)
+{
+    std::vector<gtByte> sourceData = WriteTestFile(m_sourceFilePath, 3 * DMN_FILE_TRANSFER_CHUNK_SIZE + 1000);
+
+    // Drop the connection in the middle of the third chunk:
+    dmnTestPipe droppedSenderPipe;
+    dmnTestPipe droppedReceiverPipe;
+    droppedSenderPipe.m_dropOffset = s_transferHeaderSize + 2 * (s_chunkHeaderSize + DMN_FILE_TRANSFER_CHUNK_SIZE) + s_chunkHeaderSize + 100;
+    bool isSent = true;
+    bool isReceived = true;
+    TransferFile(droppedSenderPipe, droppedReceiverPipe, isSent, isReceived);
+
+    EXPECT_FALSE(isSent);
+    EXPECT_FALSE(isReceived);
+    EXPECT_FALSE(m_targetFilePath.exists());
+
+    // Only the verified chunks are kept:
+    std::vector<gtByte> partialData = ReadTestFile(PartialFilePath(m_targetFilePath, DMN_PARTIAL_FILE_SUFFIX));
+    ASSERT_EQ(2 * DMN_FILE_TRANSFER_CHUNK_SIZE, partialData.size());
+    EXPECT_TRUE(std::equal(partialData.begin(), partialData.end(), sourceData.begin()));
+
+    // Transferring the file again sends only the chunks which were not received:
+    dmnTestPipe senderPipe;
+    dmnTestPipe receiverPipe;
+    TransferFile(senderPipe, receiverPipe, isSent, isReceived);
+
+    EXPECT_TRUE(isSent);
+    EXPECT_TRUE(isReceived);
+    EXPECT_TRUE(sourceData == ReadTestFile(m_targetFilePath));
+    EXPECT_GT(2 * DMN_FILE_TRANSFER_CHUNK_SIZE, senderPipe.WrittenSize());
+    EXPECT_FALSE(PartialFilePath(m_targetFilePath, DMN_PARTIAL_FILE_SUFFIX).exists());
+}
+
+TEST_F(dmnFileTransferTest, ReceiveFileRejectsChecksumMismatch)
+{
+    std::vector<gtByte> sourceData = WriteTestFile(m_sourceFilePath, 3 * DMN_FILE_TRANSFER_CHUNK_SIZE);
+
+    // Corrupt a byte in the second chunk:
+    dmnTestPipe senderPipe;
+    dmnTestPipe receiverPipe;
+    senderPipe.m_corruptOffset = s_transferHeaderSize + (s_chunkHeaderSize + DMN_FILE_TRANSFER_CHUNK_SIZE) + s_chunkHeaderSize + 100;
+    bool isSent = true;
+    bool isReceived = true;
+    TransferFile(senderPipe, receiverPipe, isSent, isReceived);
+
+    EXPECT_FALSE(isSent);
+    EXPECT_FALSE(isReceived);
+    EXPECT_FALSE(m_targetFilePath.exists());
+
+    // The corrupted chunk and the chunks after it are not written:
+    std::vector<gtByte> partialData = ReadTestFile(PartialFilePath(m_targetFilePath, DMN_PARTIAL_FILE_SUFFIX));
+    ASSERT_EQ(DMN_FILE_TRANSFER_CHUNK_SIZE, partialData.size());
+    EXPECT_TRUE(std::equal(partialData.begin(), partialData.end(), sourceData.begin()));
+
+    // The connection is still in sync, so the file can be transferred again over it:
+    senderPipe.m_corruptOffset = SIZE_MAX;
+    TransferFile(senderPipe, receiverPipe, isSent, isReceived);
+
+    EXPECT_TRUE(isSent);
+    EXPECT_TRUE(isReceived);
+    EXPECT_TRUE(sourceData == ReadTestFile(m_targetFilePath));
+}
+
+TEST_F(dmnFileTransferTest, ReceiveFileDataIntoBuffer)
+{
+    std::vector<gtByte> sourceData = WriteTestFile(m_sourceFilePath, DMN_FILE_TRANSFER_CHUNK_SIZE + 1000);
+
+    dmnTestPipe senderPipe;
+    dmnTestPipe receiverPipe;
+    dmnTestChannel senderChannel(receiverPipe, senderPipe);
+    dmnTestChannel receiverChannel(senderPipe, receiverPipe);
+
+    bool isSent = false;
+    std::thread senderThread([&]() { isSent = dmnFileTransfer::SendFile(senderChannel, m_sourceFilePath); });
+    unsigned char* pBuffer = nullptr;
+    unsigned long bufferSize = 0;
+    bool isReceived = dmnFileTransfer::ReceiveFileData(receiverChannel, pBuffer, bufferSize);
+    senderThread.join();
+
+    EXPECT_TRUE(isSent);
+    ASSERT_TRUE(isReceived);
+    ASSERT_EQ(sourceData.size(), bufferSize);
+    EXPECT_TRUE(std::equal(sourceData.begin(), sourceData.end(), reinterpret_cast<gtByte*>(pBuffer)));
+    delete[] pBuffer;
+}
@@ -0,0 +1,161 @@
+#pragma warning(disable : 4996)
+#pragma warning(disable : 4100)
+
+
+#include <gtest/gtest.h>
+#include <AMDTServerUtilities/Include/suEnumeratorsUsageTable.h>
+
+static void ExpectEnumeratorUsage(const suEnumeratorsUsageTable& table, int enumeratorIndex, GLenum enumValue, osTransferableObjectType enumType, gtUInt64 amountOfTimesUsed)
+{
+    ASSERT_LT(enumeratorIndex, table.amountOfEnumerators());
+
+    const apEnumeratorUsageStatistics& totalUsage = table.enumeratorTotalUsage(enumeratorIndex);
+    EXPECT_EQ(enumValue, totalUsage._enum) << "enumerator " << enumeratorIndex;
+    EXPECT_EQ(enumType, totalUsage._enumType) << "enumerator " << enumeratorIndex;
+    EXPECT_EQ(amountOfTimesUsed, totalUsage._amountOfTimesUsed) << "enumerator " << enumeratorIndex;
+    EXPECT_EQ(0u, totalUsage._amountOfRedundantTimesUsed) << "enumerator " << enumeratorIndex;
+}
+
+TEST(suEnumeratorsUsageTable, CountsEnumeratorsInFirstUseOrder)
+{
+    suEnumeratorsUsageTable table;
+    EXPECT_EQ(0, table.amountOfEnumerators());
+
+    // glDrawArrays(GL_TRIANGLES) x 3, glBindTexture(GL_TEXTURE_2D) x 2, glEnable(GL_BLEND), glDrawArrays(GL_TRIANGLES):
+    table.addEnumeratorUsage(GL_TRIANGLES, OS_TOBJ_ID_GL_PRIMITIVE_TYPE_PARAMETER);
+    table.addEnumeratorUsage(GL_TRIANGLES, OS_TOBJ_ID_GL_PRIMITIVE_TYPE_PARAMETER);
+    table.addEnumeratorUsage(GL_TRIANGLES, OS_TOBJ_ID_GL_PRIMITIVE_TYPE_PARAMETER);
+    table.addEnumeratorUsage(GL_TEXTURE_2D, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+    table.addEnumeratorUsage(GL_TEXTURE_2D, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+    table.addEnumeratorUsage(GL_BLEND, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+    table.addEnumeratorUsage(GL_TRIANGLES, OS_TOBJ_ID_GL_PRIMITIVE_TYPE_PARAMETER);
+
+    ASSERT_EQ(3, table.amountOfEnumerators());
+    ExpectEnumeratorUsage(table, 0, GL_TRIANGLES, OS_TOBJ_ID_GL_PRIMITIVE_TYPE_PARAMETER, 4);
+    ExpectEnumeratorUsage(table, 1, GL_TEXTURE_2D, OS_TOBJ_ID_GL_ENUM_PARAMETER, 2);
+    ExpectEnumeratorUsage(table, 2, GL_BLEND, OS_TOBJ_ID_GL_ENUM_PARAMETER, 1);
+}
+
+TEST(suEnumeratorsUsageTable, TotalsIncludeFullFramesAndCurrentFrame)
+{
+    suEnumeratorsUsageTable table;
+
+    // Frame 1. The first usage of an enumerator is logged both in the full frames and in the current frame
+    // counters (as the per-function enumerator vectors did), so it is counted twice once its frame ends:
+    table.addEnumeratorUsage(GL_TEXTURE_2D, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+    table.addEnumeratorUsage(GL_TEXTURE_2D, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+    table.addEnumeratorUsage(GL_BLEND, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+
+    ASSERT_EQ(2, table.amountOfEnumerators());
+    ExpectEnumeratorUsage(table, 0, GL_TEXTURE_2D, OS_TOBJ_ID_GL_ENUM_PARAMETER, 2);
+    ExpectEnumeratorUsage(table, 1, GL_BLEND, OS_TOBJ_ID_GL_ENUM_PARAMETER, 1);
+
+    table.onFrameEnded();
+
+    ASSERT_EQ(2, table.amountOfEnumerators());
+    ExpectEnumeratorUsage(table, 0, GL_TEXTURE_2D, OS_TOBJ_ID_GL_ENUM_PARAMETER, 3);
+    ExpectEnumeratorUsage(table, 1, GL_BLEND, OS_TOBJ_ID_GL_ENUM_PARAMETER, 2);
+
+    // Frame 2, which does not use GL_BLEND, in progress:
+    table.addEnumeratorUsage(GL_TEXTURE_2D, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+    table.addEnumeratorUsage(GL_DEPTH_TEST, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+    table.addEnumeratorUsage(GL_DEPTH_TEST, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+    table.addEnumeratorUsage(GL_DEPTH_TEST, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+
+    ASSERT_EQ(3, table.amountOfEnumerators());
+    ExpectEnumeratorUsage(table, 0, GL_TEXTURE_2D, OS_TOBJ_ID_GL_ENUM_PARAMETER, 4);
+    ExpectEnumeratorUsage(table, 1, GL_BLEND, OS_TOBJ_ID_GL_ENUM_PARAMETER, 2);
+    ExpectEnumeratorUsage(table, 2, GL_DEPTH_TEST, OS_TOBJ_ID_GL_ENUM_PARAMETER, 3);
+
+    // Ending frame 2 accumulates the first usage of GL_DEPTH_TEST, and an empty frame 3 does not change the totals:
+    table.onFrameEnded();
+
+    ASSERT_EQ(3, table.amountOfEnumerators());
+    ExpectEnumeratorUsage(table, 0, GL_TEXTURE_2D, OS_TOBJ_ID_GL_ENUM_PARAMETER, 4);
+    ExpectEnumeratorUsage(table, 1, GL_BLEND, OS_TOBJ_ID_GL_ENUM_PARAMETER, 2);
+    ExpectEnumeratorUsage(table, 2, GL_DEPTH_TEST, OS_TOBJ_ID_GL_ENUM_PARAMETER, 4);
+
+    table.onFrameEnded();
+
+    ASSERT_EQ(3, table.amountOfEnumerators());
+    ExpectEnumeratorUsage(table, 0, GL_TEXTURE_2D, OS_TOBJ_ID_GL_ENUM_PARAMETER, 4);
+    ExpectEnumeratorUsage(table, 1, GL_BLEND, OS_TOBJ_ID_GL_ENUM_PARAMETER, 2);
+    ExpectEnumeratorUsage(table, 2, GL_DEPTH_TEST, OS_TOBJ_ID_GL_ENUM_PARAMETER, 4);
+}
+
+TEST(suEnumeratorsUsageTable, ClearKeepsEnumeratorsOrder)
+{
+    suEnumeratorsUsageTable table;
+    table.addEnumeratorUsage(GL_TEXTURE_2D, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+    table.onFrameEnded();
+    table.addEnumeratorUsage(GL_BLEND, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+    table.addEnumeratorUsage(GL_DEPTH_TEST, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+
+    // Clear in the middle of a frame:
+    table.clear();
+
+    ASSERT_EQ(3, table.amountOfEnumerators());
+    ExpectEnumeratorUsage(table, 0, GL_TEXTURE_2D, OS_TOBJ_ID_GL_ENUM_PARAMETER, 0);
+    ExpectEnumeratorUsage(table, 1, GL_BLEND, OS_TOBJ_ID_GL_ENUM_PARAMETER, 0);
+    ExpectEnumeratorUsage(table, 2, GL_DEPTH_TEST, OS_TOBJ_ID_GL_ENUM_PARAMETER, 0);
+
+    // Usage that was counted before the clear is not accumulated when the frame ends, and usage after the
+    // clear is not a first usage:
+    table.addEnumeratorUsage(GL_BLEND, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+    table.addEnumeratorUsage(GL_BLEND, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+    table.onFrameEnded();
+    table.addEnumeratorUsage(GL_TEXTURE_2D, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+
+    ASSERT_EQ(3, table.amountOfEnumerators());
+    ExpectEnumeratorUsage(table, 0, GL_TEXTURE_2D, OS_TOBJ_ID_GL_ENUM_PARAMETER, 1);
+    ExpectEnumeratorUsage(table, 1, GL_BLEND, OS_TOBJ_ID_GL_ENUM_PARAMETER, 2);
+    ExpectEnumeratorUsage(table, 2, GL_DEPTH_TEST, OS_TOBJ_ID_GL_ENUM_PARAMETER, 0);
+}
+
+TEST(suEnumeratorsUsageTable, SeparatesEqualValuesOfDifferentTypes)
+{
+    // GL_POINTS (a primitive type) and GL_NONE (an enum) have the same value:
+    suEnumeratorsUsageTable table;
+    table.addEnumeratorUsage(GL_POINTS, OS_TOBJ_ID_GL_PRIMITIVE_TYPE_PARAMETER);
+    table.addEnumeratorUsage(GL_NONE, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+    table.addEnumeratorUsage(GL_NONE, OS_TOBJ_ID_GL_ENUM_PARAMETER);
+
+    ASSERT_EQ(2, table.amountOfEnumerators());
+    ExpectEnumeratorUsage(table, 0, GL_POINTS, OS_TOBJ_ID_GL_PRIMITIVE_TYPE_PARAMETER, 1);
+    ExpectEnumeratorUsage(table, 1, GL_NONE, OS_TOBJ_ID_GL_ENUM_PARAMETER, 2);
+}
+
+TEST(suEnumeratorsUsageTable, CountsManyEnumeratorsAcrossFrames)
+{
+    // Enough enumerators to grow the hash table several times. Enumerator i is used (i % 7) + 1 times,
+    // first in increasing order and then in decreasing order, with a frame ending every 100 usages.
+    // The frame of each first usage ends, so each first usage is counted twice:
+    static const int amountOfEnumerators = 1000;
+    suEnumeratorsUsageTable table;
+    int amountOfUsages = 0;
+
+    for (int pass = 0; pass < 7; pass++)
+    {
+        for (int i = 0; i < amountOfEnumerators; i++)
+        {
+            int enumeratorIndex = ((pass % 2) == 0) ? i : (amountOfEnumerators - 1 - i);
+
+            if (pass <= (enumeratorIndex % 7))
+            {
+                table.addEnumeratorUsage((GLenum)(0x8000 + enumeratorIndex), OS_TOBJ_ID_GL_ENUM_PARAMETER);
+
+                if ((++amountOfUsages % 100) == 0)
+                {
+                    table.onFrameEnded();
+                }
+            }
+        }
+    }
+
+    ASSERT_EQ(amountOfEnumerators, table.amountOfEnumerators());
+
+    for (int i = 0; i < amountOfEnumerators; i++)
+    {
+        ExpectEnumeratorUsage(table, i, (GLenum)(0x8000 + i), OS_TOBJ_ID_GL_ENUM_PARAMETER, (gtUInt64)((i % 7) + 2));
+    }
+}